@@ -3,8 +3,10 @@
  *  \ingroup algorithms
  *
  *  This file contains the lowest-level core API for
- *  compression and decompression. It operates on raw
- *  byte buffers.
+ *  compression and decompression. gblCompress() and
+ *  gblDecompress() operate on whole raw byte buffers,
+ *  while GblCompressor and GblDecompressor process
+ *  LZ4 frames incrementally, as data becomes available.
  *
  *  \note
  *  The underlying compression library and algorithm
@@ -16,10 +18,28 @@
 #ifndef GIMBAL_COMPRESSION_H
 #define GIMBAL_COMPRESSION_H
 
-#include "../core/gimbal_decls.h"
+#include "../core/gimbal_result.h"
+
+//! Default compression level for GblCompressor, selecting fast LZ4 compression
+#define GBL_COMPRESSOR_LEVEL_DEFAULT    0
+//! Lowest compression level for GblCompressor which selects LZ4HC (high compression) mode
+#define GBL_COMPRESSOR_LEVEL_HC         3
+//! Highest compression level for GblCompressor, which is the slowest and compresses the best
+#define GBL_COMPRESSOR_LEVEL_MAX        12
+//! Default window (maximum block) size for GblCompressor, in bytes
+#define GBL_COMPRESSOR_WINDOW_DEFAULT   (64 * 1024)
+
+#define GBL_SELF_TYPE GblCompressor
 
 GBL_DECLS_BEGIN
 
+GBL_FORWARD_DECLARE_STRUCT(GblContext);
+GBL_FORWARD_DECLARE_STRUCT(GblByteArray);
+GBL_FORWARD_DECLARE_STRUCT(GblStringBuffer);
+
+//! Sink function invoked by GblCompressor and GblDecompressor with each chunk of output data
+typedef GBL_RESULT (*GblCompressorWriteFn)(void* pUserdata, const void* pData, size_t size);
+
 //! Compresses the source buffer into the sized destination buffer, returning its actual compressed size
 GBL_EXPORT int gblCompress(const void* pSrc,
                            void*       pDst,
@@ -33,6 +53,218 @@ GBL_EXPORT int gblDecompress(const void* pSrc,
                              size_t      srcSize,
                              size_t      dstCapacity) GBL_NOEXCEPT;
 
+/*! Streaming LZ4 frame compressor
+ *
+ *  GblCompressor incrementally compresses data into the standard
+ *  LZ4 frame format, so that a stream of unknown length can be
+ *  compressed as it is produced, rather than having to be
+ *  buffered in memory first. Each call to GblCompressor_update()
+ *  passes along any completed compressed blocks to the sink, which
+ *  is either a custom GblCompressorWriteFn, a GblByteArray, or a
+ *  GblStringBuffer. The frame is terminated by
+ *  GblCompressor_finish(), after which the next update begins a
+ *  new frame.
+ *
+ *  The compression level selects between the fast LZ4 algorithm
+ *  (levels below GBL_COMPRESSOR_LEVEL_HC, with negative levels
+ *  trading ratio for speed) and LZ4HC (levels up to
+ *  GBL_COMPRESSOR_LEVEL_MAX). The window size bounds the block
+ *  size, and with it the working set of both the compressor and
+ *  decompressor; it is rounded up to 64KB, 256KB, 1MB, or 4MB.
+ *
+ *  A dictionary of data similar to what is being compressed may
+ *  be preloaded with GblCompressor_loadDictionary(), which
+ *  greatly improves the compression of small messages. The same
+ *  dictionary must then be given to the GblDecompressor.
+ *
+ *  \sa GblDecompressor
+ */
+typedef struct GblCompressor {
+    GBL_PRIVATE_BEGIN
+        GblContext*          pCtx;
+        void*                pLz4;        // LZ4F_cctx*
+        void*                pDict;       // LZ4F_CDict*
+        GblCompressorWriteFn pFnWrite;
+        void*                pSink;
+        void*                pBuffer;
+        size_t               bufferSize;
+        size_t               windowSize;
+        size_t               bytesIn;
+        size_t               bytesOut;
+        int                  level;
+        GblBool              inFrame;
+    GBL_PRIVATE_END
+} GblCompressor;
+
+/*! \name  Lifetime
+ *  \brief Methods for constructing and destructing a GblCompressor
+ *  \relatesalso GblCompressor
+ *  @{
+ */
+//! Constructs the compressor with the given level (0: default), window size (0: default), and context
+GBL_EXPORT GBL_RESULT GblCompressor_construct (GBL_SELF,
+                                               int         level/*=GBL_COMPRESSOR_LEVEL_DEFAULT*/,
+                                               size_t      windowSize/*=GBL_COMPRESSOR_WINDOW_DEFAULT*/,
+                                               GblContext* pCtx/*=NULL*/)                GBL_NOEXCEPT;
+//! Destructs the compressor, discarding any unfinished frame
+GBL_EXPORT GBL_RESULT GblCompressor_destruct  (GBL_SELF)                                 GBL_NOEXCEPT;
+//! @}
+
+/*! \name  Configuration
+ *  \brief Methods for setting up a GblCompressor before compressing
+ *  \relatesalso GblCompressor
+ *  @{
+ */
+//! Sets the given function as the sink which receives each chunk of compressed data
+GBL_EXPORT GBL_RESULT GblCompressor_setSink             (GBL_SELF,
+                                                         GblCompressorWriteFn pFnWrite,
+                                                         void*                pUserdata) GBL_NOEXCEPT;
+//! Sets the given GblByteArray as the sink, appending all compressed data to it
+GBL_EXPORT GBL_RESULT GblCompressor_setByteArraySink    (GBL_SELF,
+                                                         GblByteArray*        pArray)    GBL_NOEXCEPT;
+//! Sets the given GblStringBuffer as the sink, appending all compressed data to it
+GBL_EXPORT GBL_RESULT GblCompressor_setStringBufferSink (GBL_SELF,
+                                                         GblStringBuffer*     pBuffer)   GBL_NOEXCEPT;
+//! Preloads the given dictionary (only the last 64KB are used), taking effect with the next frame
+GBL_EXPORT GBL_RESULT GblCompressor_loadDictionary      (GBL_SELF,
+                                                         const void*          pData,
+                                                         size_t               size)      GBL_NOEXCEPT;
+//! @}
+
+/*! \name  Compression
+ *  \brief Methods for feeding data through a GblCompressor
+ *  \relatesalso GblCompressor
+ *  @{
+ */
+//! Compresses the given data, beginning a new frame if necessary and writing any completed blocks to the sink
+GBL_EXPORT GBL_RESULT GblCompressor_update (GBL_SELF, const void* pData, size_t size) GBL_NOEXCEPT;
+//! Compresses and writes out any data which is still buffered, without ending the frame
+GBL_EXPORT GBL_RESULT GblCompressor_flush  (GBL_SELF)                                 GBL_NOEXCEPT;
+//! Ends the current frame, writing its remaining data, end mark and checksum to the sink
+GBL_EXPORT GBL_RESULT GblCompressor_finish (GBL_SELF)                                 GBL_NOEXCEPT;
+//! @}
+
+/*! \name  Accessors
+ *  \brief Methods for querying the state of a GblCompressor
+ *  \relatesalso GblCompressor
+ *  @{
+ */
+//! Returns the compression level of the given compressor
+GBL_EXPORT int     GblCompressor_level      (GBL_CSELF) GBL_NOEXCEPT;
+//! Returns the window (maximum block) size of the given compressor, after rounding
+GBL_EXPORT size_t  GblCompressor_windowSize (GBL_CSELF) GBL_NOEXCEPT;
+//! Returns the total number of uncompressed bytes given to the compressor
+GBL_EXPORT size_t  GblCompressor_bytesIn    (GBL_CSELF) GBL_NOEXCEPT;
+//! Returns the total number of compressed bytes written to the sink
+GBL_EXPORT size_t  GblCompressor_bytesOut   (GBL_CSELF) GBL_NOEXCEPT;
+//! Returns GBL_TRUE if a frame has been started and not yet finished
+GBL_EXPORT GblBool GblCompressor_inFrame    (GBL_CSELF) GBL_NOEXCEPT;
+//! @}
+
+#undef  GBL_SELF_TYPE
+#define GBL_SELF_TYPE GblDecompressor
+
+/*! Streaming LZ4 frame decompressor
+ *
+ *  GblDecompressor is the counterpart of GblCompressor,
+ *  accepting compressed LZ4 frames in arbitrarily-sized pieces
+ *  and writing the decompressed data to its sink as each block
+ *  is completed. Multiple frames may be given back-to-back.
+ *
+ *  \sa GblCompressor
+ */
+typedef struct GblDecompressor {
+    GBL_PRIVATE_BEGIN
+        GblContext*          pCtx;
+        void*                pLz4;        // LZ4F_dctx*
+        void*                pDict;
+        size_t               dictSize;
+        GblCompressorWriteFn pFnWrite;
+        void*                pSink;
+        void*                pBuffer;
+        size_t               bufferSize;
+        size_t               bytesIn;
+        size_t               bytesOut;
+        GblBool              inFrame;
+    GBL_PRIVATE_END
+} GblDecompressor;
+
+/*! \name  Lifetime
+ *  \brief Methods for constructing and destructing a GblDecompressor
+ *  \relatesalso GblDecompressor
+ *  @{
+ */
+//! Constructs the decompressor with the given context
+GBL_EXPORT GBL_RESULT GblDecompressor_construct (GBL_SELF, GblContext* pCtx/*=NULL*/) GBL_NOEXCEPT;
+//! Destructs the decompressor
+GBL_EXPORT GBL_RESULT GblDecompressor_destruct  (GBL_SELF)                            GBL_NOEXCEPT;
+//! @}
+
+/*! \name  Configuration
+ *  \brief Methods for setting up a GblDecompressor before decompressing
+ *  \relatesalso GblDecompressor
+ *  @{
+ */
+//! Sets the given function as the sink which receives each chunk of decompressed data
+GBL_EXPORT GBL_RESULT GblDecompressor_setSink             (GBL_SELF,
+                                                           GblCompressorWriteFn pFnWrite,
+                                                           void*                pUserdata) GBL_NOEXCEPT;
+//! Sets the given GblByteArray as the sink, appending all decompressed data to it
+GBL_EXPORT GBL_RESULT GblDecompressor_setByteArraySink    (GBL_SELF,
+                                                           GblByteArray*        pArray)    GBL_NOEXCEPT;
+//! Sets the given GblStringBuffer as the sink, appending all decompressed data to it
+GBL_EXPORT GBL_RESULT GblDecompressor_setStringBufferSink (GBL_SELF,
+                                                           GblStringBuffer*     pBuffer)   GBL_NOEXCEPT;
+//! Sets the dictionary the frames were compressed with, taking effect with the next frame
+GBL_EXPORT GBL_RESULT GblDecompressor_loadDictionary      (GBL_SELF,
+                                                           const void*          pData,
+                                                           size_t               size)      GBL_NOEXCEPT;
+//! @}
+
+/*! \name  Decompression
+ *  \brief Methods for feeding data through a GblDecompressor
+ *  \relatesalso GblDecompressor
+ *  @{
+ */
+//! Decompresses the given piece of a compressed stream, writing any completed blocks to the sink
+GBL_EXPORT GBL_RESULT GblDecompressor_update (GBL_SELF, const void* pData, size_t size) GBL_NOEXCEPT;
+//! Returns an error if the stream ended in the middle of a frame, then resets the decompressor
+GBL_EXPORT GBL_RESULT GblDecompressor_finish (GBL_SELF)                                 GBL_NOEXCEPT;
+//! @}
+
+/*! \name  Accessors
+ *  \brief Methods for querying the state of a GblDecompressor
+ *  \relatesalso GblDecompressor
+ *  @{
+ */
+//! Returns the total number of compressed bytes given to the decompressor
+GBL_EXPORT size_t  GblDecompressor_bytesIn  (GBL_CSELF) GBL_NOEXCEPT;
+//! Returns the total number of decompressed bytes written to the sink
+GBL_EXPORT size_t  GblDecompressor_bytesOut (GBL_CSELF) GBL_NOEXCEPT;
+//! Returns GBL_TRUE if the decompressor is in the middle of a frame
+GBL_EXPORT GblBool GblDecompressor_inFrame  (GBL_CSELF) GBL_NOEXCEPT;
+//! @}
+
 GBL_DECLS_END
 
+//! \cond
+#define GblCompressor_construct(...) \
+    GBL_VA_OVERLOAD_CALL_ARGC(GblCompressor_construct, __VA_ARGS__)
+#define GblCompressor_construct_1(self) \
+    GblCompressor_construct_2(self, GBL_COMPRESSOR_LEVEL_DEFAULT)
+#define GblCompressor_construct_2(self, level) \
+    GblCompressor_construct_3(self, level, GBL_COMPRESSOR_WINDOW_DEFAULT)
+#define GblCompressor_construct_3(self, level, window) \
+    GblCompressor_construct_4(self, level, window, GBL_NULL)
+#define GblCompressor_construct_4(self, level, window, ctx) \
+    ((GblCompressor_construct)(self, level, window, ctx))
+
+#define GblDecompressor_construct(...) \
+    GblDecompressor_constructDefault_(__VA_ARGS__, GBL_NULL)
+#define GblDecompressor_constructDefault_(self, ctx, ...) \
+    (GblDecompressor_construct)(self, ctx)
+//! \endcond
+
+#undef GBL_SELF_TYPE
+
 #endif // GIMBAL_COMPRESSION_H
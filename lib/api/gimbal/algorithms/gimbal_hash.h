@@ -8,6 +8,13 @@
  *  buffers of data or primitive types of specific
  *  sizes.
  *
+ *  The CRC-32 and CRC-32C checksums select an implementation at
+ *  runtime, based on the instructions supported by the CPU:
+ *  carry-less multiplication (PCLMULQDQ) folding or the SSE4.2
+ *  \c crc32 instruction on x86, the ARMv8 CRC extension on
+ *  AArch64, and a portable slicing-by-8 table lookup everywhere
+ *  else. All implementations produce identical results.
+ *
  *  \author     2023 Falco Girgis
  *  \copyright  MIT License
  */
@@ -29,6 +36,9 @@
 
 GBL_DECLS_BEGIN
 
+//! Function signature shared by every generic buffer hashing algorithm, such as gblHashFnv1()
+typedef GblHash (*GblHashFn)(const void* pData, size_t size);
+
 /*! \name Fixed data sizes
  *  \brief Methods for calculating the hash of primitive types
  *  @{
@@ -46,6 +56,10 @@ GBL_EXPORT GblHash  gblHash16Bit   (uint16_t value) GBL_NOEXCEPT;
 GBL_EXPORT uint16_t gblHashCrc16BitPartial (const void* pData,
                                             size_t      size,
                                             uint16_t*   pPartial) GBL_NOEXCEPT;
+//! Calculates the CRC-32 of a given buffer continuing the checksum returned by a previous iteration (or taking NULL for none)
+GBL_EXPORT uint32_t gblHashCrcPartial      (const void* pData,
+                                            size_t      size,
+                                            uint32_t*   pPartial) GBL_NOEXCEPT;
 //! @}
 
 /*! \name  Arbitrarily-sized data
@@ -61,20 +75,45 @@ GBL_EXPORT GblHash  gblHashMurmur    (const void* pData, size_t size) GBL_NOEXCE
 GBL_EXPORT GblHash  gblHashFnv1      (const void* pData, size_t size) GBL_NOEXCEPT;
 //! Returns the hash of the given data buffer, calculated using the xxHash algorithm
 GBL_EXPORT GblHash  gblHashXx        (const void* pData, size_t size) GBL_NOEXCEPT;
+//! Returns the 64-bit hash of the given data buffer, calculated using the XXH3 algorithm
+GBL_EXPORT uint64_t gblHashXx3_64    (const void* pData, size_t size) GBL_NOEXCEPT;
 //! Returns the hash of the given data buffer, calculated using the SuperFastHash algorithm
 GBL_EXPORT GblHash  gblHashSuperFast (const void* pData, size_t size) GBL_NOEXCEPT;
 //! Returns the hash of the given data buffer, calculated using the Pearson hashing algorithm
 GBL_EXPORT GblHash  gblHashPearson   (const void* pData, size_t size) GBL_NOEXCEPT;
 //! Returns the hash of the given data buffer, calculated using the Jenkins hashing algorithm
 GBL_EXPORT GblHash  gblHashJenkins   (const void* pData, size_t size) GBL_NOEXCEPT;
-//! Returns the CRC value of the given data buffer
+//! Returns the CRC-32 (IEEE 802.3) checksum of the given data buffer
 GBL_EXPORT GblHash  gblHashCrc       (const void* pData, size_t size) GBL_NOEXCEPT;
+//! Returns the CRC-32C (Castagnoli) checksum of the given data buffer
+GBL_EXPORT GblHash  gblHashCrc32c    (const void* pData, size_t size) GBL_NOEXCEPT;
 //! Returns the SHA1 hash calculated for the given data buffer
 GBL_EXPORT GblHash  gblHashSha1      (const void* pData, size_t size) GBL_NOEXCEPT;
 //! Returns the MD5 hash calculated for the given data buffer
 GBL_EXPORT GblHash  gblHashMd5       (const void* pData, size_t size) GBL_NOEXCEPT;
 //! @}
 
+/*! \name  Batches
+ *  \brief Methods for calculating the hashes of many keys at once
+ *  \ingroup hashing
+ *  @{
+ */
+/*! Calculates the hashes of \p count keys of \p keySize bytes each, which are \p stride bytes apart
+ *
+ *  Writes the same value to each element of \p pHashes as calling \p pFnHash on the
+ *  corresponding key would, using gblHash when \p pFnHash is NULL and \p keySize as the
+ *  stride when \p stride is 0. When given gblHashFnv1() or gblHashCrc32c(), the keys are
+ *  hashed in interleaved groups, so that the latency of each step is hidden behind the
+ *  work on the other keys, which makes it well-suited for bulk inserts into hash tables.
+ */
+GBL_EXPORT void     gblHashMany      (GblHashFn   pFnHash,
+                                      const void* pKeys,
+                                      size_t      keySize,
+                                      size_t      stride,
+                                      size_t      count,
+                                      GblHash*    pHashes)        GBL_NOEXCEPT;
+//! @}
+
 GBL_DECLS_END
 
 #endif // GIMBAL_HASH_H
@@ -8,6 +8,14 @@
  *  output (integer, float, bool, string, etc) as well
  *  as a variety of random number distributions.
  *
+ *  Every thread owns its own generator state, so
+ *  random numbers may be generated from any number of
+ *  threads at once without locking or contention. The
+ *  default generator is xoshiro256**, whose state is
+ *  exposed as GblRandState, for creating independent
+ *  and reproducible streams to hand out to parallel
+ *  workers.
+ *
  *  \note
  *  gblRandLehmer() and the various statistical disbributions
  *  are based on:
@@ -15,9 +23,6 @@
  *  Steve Park and Keith Miller
  *  Communications of the ACM, October 1988
  *
- *  \todo
- *  - Changing channels to swap between seeds
- *
  *  \author 1998 Steve Park
  *  \author 1998 Keith Miller
  *  \author 2023 Falco Girgis
@@ -27,18 +32,37 @@
 
 #include "../core/gimbal_decls.h"
 
-#define GBL_SEED_COUNT  2 //!< Number of different seeds maintained
+#define GBL_SEED_COUNT          2                       //!< Number of different seeds maintained
+#define GBL_RAND_SEED_DEFAULT   UINT64_C(0x9e3779b97f4a7c15) //!< Seed of the first stream handed out to a thread
 
 #ifndef GBL_RAND_GENERATOR_DEFAULT
 //! Default random number generator backing gblRand()
-#   define GBL_RAND_GENERATOR_DEFAULT gblRandLehmer
+#   define GBL_RAND_GENERATOR_DEFAULT gblRandXoshiro
 #endif
 
+#define GBL_SELF_TYPE GblRandState
+
 GBL_DECLS_BEGIN
 
 //! Function prototype for a custom random generator to be set with gblSetRand()
 typedef int (*GblRandomGeneratorFn)(void);
 
+/*! State of a xoshiro256** pseudorandom number generator
+ *
+ *  GblRandState is a single stream of random numbers, with a
+ *  period of 2^256 - 1. Streams can be jumped ahead by 2^128 or
+ *  2^192 numbers, which is used to split one seeded stream into
+ *  many non-overlapping ones, so that parallel workers each get
+ *  their own deterministic sequence.
+ *
+ *  Each thread is given its own stream on first use, split from
+ *  a state seeded with GBL_RAND_SEED_DEFAULT, which can be
+ *  replaced with gblRandSetState().
+ */
+typedef struct GblRandState {
+    uint64_t s[4];
+} GblRandState;
+
 /*! \defgroup random Random
  *  \ingroup algorithms
  *  \brief Random number generators and utilities
@@ -56,6 +80,30 @@ GBL_EXPORT void     gblSeedRand (uint8_t index, uint64_t seed) GBL_NOEXCEPT;
 GBL_EXPORT int      gblRand     (void)                         GBL_NOEXCEPT;
 //! Sets the current random number generator to \p pFnGen, which drives gblRand()
 GBL_EXPORT void     gblSetRand  (GblRandomGeneratorFn pFnGen)  GBL_NOEXCEPT;
+//! Returns a random 64-bit number from the calling thread's stream
+GBL_EXPORT uint64_t gblRand64   (void)                         GBL_NOEXCEPT;
+//! @}
+
+/*! \name Streams
+ *  \brief Methods for managing independent random number streams
+ *  @{
+ */
+//! Returns the calling thread's random number stream
+GBL_EXPORT GblRandState* gblRandState    (void)                       GBL_NOEXCEPT;
+//! Replaces the calling thread's random number stream with a copy of \p pState
+GBL_EXPORT void          gblRandSetState (const GblRandState* pState) GBL_NOEXCEPT;
+//! Initializes the given stream from a 64-bit seed, expanding it with SplitMix64
+GBL_EXPORT void          GblRandState_seed     (GBL_SELF, uint64_t seed)       GBL_NOEXCEPT;
+//! Returns the next 64-bit random number from the given stream
+GBL_EXPORT uint64_t      GblRandState_next     (GBL_SELF)                      GBL_NOEXCEPT;
+//! Advances the given stream by 2^128 numbers
+GBL_EXPORT void          GblRandState_jump     (GBL_SELF)                      GBL_NOEXCEPT;
+//! Advances the given stream by 2^192 numbers
+GBL_EXPORT void          GblRandState_longJump (GBL_SELF)                      GBL_NOEXCEPT;
+//! Fills \p pStreams with \p count non-overlapping streams, each 2^128 apart, advancing the given stream past them
+GBL_EXPORT void          GblRandState_split    (GBL_SELF,
+                                                size_t        count,
+                                                GblRandState* pStreams)        GBL_NOEXCEPT;
 //! @}
 
 /*! \name Generators
@@ -65,7 +113,9 @@ GBL_EXPORT void     gblSetRand  (GblRandomGeneratorFn pFnGen)  GBL_NOEXCEPT;
 //! The builtin rand() generator from the C standard library
 GBL_EXPORT int gblRandLibC   (void) GBL_NOEXCEPT;
 //! Lehmer linear congruential random number generator
-GBL_EXPORT int gblRandLehmer (void) GBL_NOEXCEPT;
+GBL_EXPORT int gblRandLehmer  (void) GBL_NOEXCEPT;
+//! xoshiro256** random number generator, driven by the calling thread's GblRandState
+GBL_EXPORT int gblRandXoshiro (void) GBL_NOEXCEPT;
 //! @}
 
 /*! \name Utilities
@@ -76,7 +126,7 @@ GBL_EXPORT int gblRandLehmer (void) GBL_NOEXCEPT;
 GBL_EXPORT GblBool gblRandBool   (void)                           GBL_NOEXCEPT;
 //! Generates a random single-precision float from FLT_MIN to FLT_MAX.
 GBL_EXPORT float   gblRandf      (void)                           GBL_NOEXCEPT;
-//! Fills in the given buffer with random bytes using the current generator
+//! Fills in the given buffer with random bytes, generated 256 bits at a time from the calling thread's streams
 GBL_EXPORT void    gblRandBuffer (void* pData, size_t size)       GBL_NOEXCEPT;
 //! Fills in buffer with a sized random word (optionally generated using a list of characters)
 GBL_EXPORT int     gblRandString (char*       pBuffer,
@@ -123,6 +173,16 @@ GBL_EXPORT float gblRandChisquare   (int n)            GBL_NOEXCEPT;
 GBL_EXPORT float gblRandStudent     (int n)            GBL_NOEXCEPT;
 //! @}
 
+/*! \name Batch Distributions
+ *  \brief Methods filling whole arrays with samples from the calling thread's streams
+ *  @{
+ */
+//! Fills \p pValues with \p count floats over a Uniform distribution in the range [a, b)
+GBL_EXPORT void gblRandUniformN (float* pValues, size_t count, float a, float b) GBL_NOEXCEPT;
+//! Fills \p pValues with \p count floats over a Normal distribution with mean \p m and standard deviation \p s
+GBL_EXPORT void gblRandNormalN  (float* pValues, size_t count, float m, float s) GBL_NOEXCEPT;
+//! @}
+
 GBL_DECLS_END
 
 //! \cond
@@ -134,4 +194,6 @@ GBL_DECLS_END
     (gblRandString)(buffer, min, max, chars)
 //! \endcond
 
+#undef GBL_SELF_TYPE
+
 #endif // GIMBAL_RANDOM_H
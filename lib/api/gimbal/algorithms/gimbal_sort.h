@@ -8,8 +8,10 @@
  *  operate on an array of data, accepting a custom
  *  comparator callback.
  *
- *  \todo
- *      - gblSortRadix()
+ *  gblSort() is the general-purpose entry point. The remaining
+ *  comparison sorts are mostly of academic interest, while
+ *  gblSortRadix(), gblSortMergeBuffer(), and gblSortParallel()
+ *  cover integer keys, stability, and multiple cores respectively.
  *
  *  \author     2023 Falco Girgis
  *  \copyright  MIT License
@@ -19,37 +21,95 @@
 #define GIMBAL_SORT_H
 
 #include "../core/gimbal_decls.h"
+#include "../core/gimbal_result.h"
+#include <string.h>
+
+//! Number of elements below which gblSortParallel() doesn't bother splitting up the work
+#define GBL_SORT_PARALLEL_GRAIN     16384
 
 GBL_DECLS_BEGIN
 
+GBL_FORWARD_DECLARE_STRUCT(GblMainLoop);
+
 //! Function taking two elements and returning their numeric difference as an integer
 typedef int  (*GblSortComparatorFn) (const void*, const void*);
 //! Generic function pointer type for containing one of the array sorting algorithms
 typedef void (*GblSortFn)           (void*, size_t, size_t, GblSortComparatorFn);
+//! Function returning the radix key of an element, which must order the same way as an unsigned integer
+typedef uint64_t (*GblSortKeyFn)    (const void*);
 
 /*! \defgroup sorting Sorting
  *  \ingroup algorithms
  *  \brief Collection of sorting algorithms
  * @{
  */
+/*! Sorts the given array with \p count \p elemSize elements in place, using \p pFnCmp to compare them
+ *
+ *  Pattern-defeating quicksort: an introsort which uses ninther pivot
+ *  selection, switches to insertion sort for small partitions, detects
+ *  already sorted runs and swathes of equal elements, and falls back to
+ *  heap sort after too many unbalanced partitions, so it is O(n log n)
+ *  in the worst case. Swapping is specialized for 4, 8, and 16 byte
+ *  elements. The sort is not stable.
+ */
+GBL_EXPORT void gblSort          (void* pArray, size_t count, size_t elemSize, GblSortComparatorFn pFnCmp) GBL_NOEXCEPT;
 //! Performs a Selection Sort over the given array with \p count \p elemSize elements, using \p pFnCmp to compare them
 GBL_EXPORT void gblSortSelection (void* pArray, size_t count, size_t elemSize, GblSortComparatorFn pFnCmp) GBL_NOEXCEPT;
-//! Performs a Quick Sort over the given array with \p count \p elemSize elements, using \p pFnCmp to compare them
+//! Performs a Quick Sort over the given array with \p count \p elemSize elements, using \p pFnCmp to compare them, same as gblSort()
 GBL_EXPORT void gblSortQuick     (void* pArray, size_t count, size_t elemSize, GblSortComparatorFn pFnCmp) GBL_NOEXCEPT;
 //! Performs an Insertion Sort over the given array with \p count \p elemSize elements, using \p pFnCmp to compare them
 GBL_EXPORT void gblSortInsertion (void* pArray, size_t count, size_t elemSize, GblSortComparatorFn pFnCmp) GBL_NOEXCEPT;
 //! Performs a Shell Sort over the given array with \p count \p elemSize elements, using \p pFnCmp to compare them
 GBL_EXPORT void gblSortShell     (void* pArray, size_t count, size_t elemSize, GblSortComparatorFn pFnCmp) GBL_NOEXCEPT;
-//! Performs a Merge Sort over the given array with \p count \p elemSize elements, using \p pFnCmp to compare them
+//! Performs a stable Merge Sort over the given array with \p count \p elemSize elements, using \p pFnCmp to compare them
 GBL_EXPORT void gblSortMerge     (void* pArray, size_t count, size_t elemSize, GblSortComparatorFn pFnCmp) GBL_NOEXCEPT;
+//! Performs a stable Merge Sort like gblSortMerge(), using \p pBuffer, of at least \p count elements, as scratch space rather than allocating
+GBL_EXPORT void gblSortMergeBuffer
+                                 (void* pArray, size_t count, size_t elemSize, GblSortComparatorFn pFnCmp,
+                                  void* pBuffer)                                                           GBL_NOEXCEPT;
 //! Performs a Comb Sort over the given array with \p count \p elemSize elements, using \p pFnCmp to compare them
 GBL_EXPORT void gblSortComb      (void* pArray, size_t count, size_t elemSize, GblSortComparatorFn pFnCmp) GBL_NOEXCEPT;
 //! Performs a Bubble Sort over the given array with \p count \p elemSize elements, using \p pFnCmp to compare them
 GBL_EXPORT void gblSortBubble    (void* pArray, size_t count, size_t elemSize, GblSortComparatorFn pFnCmp) GBL_NOEXCEPT;
 //! Performs a Heap Sort over the given array with \p count \p elemSize elements, using \p pFnCmp to compare them
 GBL_EXPORT void gblSortHeap      (void* pArray, size_t count, size_t elemSize, GblSortComparatorFn pFnCmp) GBL_NOEXCEPT;
+
+/*! Performs a stable LSD Radix Sort over the given array with \p count \p elemSize elements, ordered by their \p pFnKey keys
+ *
+ *  Each key is extracted once, then the keys and elements are scattered
+ *  one byte at a time, skipping any byte which is the same for every key.
+ *  Use gblSortRadixKeyInt() or gblSortRadixKeyFloat() to turn signed or
+ *  floating-point values into keys. Needs scratch space for a second copy
+ *  of the array and two keys per element.
+ */
+GBL_EXPORT GBL_RESULT gblSortRadix
+                                 (void* pArray, size_t count, size_t elemSize, GblSortKeyFn pFnKey)        GBL_NOEXCEPT;
+
+/*! Sorts the given array like gblSort(), splitting the work over the worker threads of \p pLoop
+ *
+ *  The array is cut into a power-of-two number of chunks, which are
+ *  sorted by separate tasks, then merged pairwise into scratch space,
+ *  with the last few merges themselves split up by co-ranking so that
+ *  every worker stays busy. Without a loop or with fewer than
+ *  GBL_SORT_PARALLEL_GRAIN elements per chunk, it is just gblSort().
+ */
+GBL_EXPORT GBL_RESULT gblSortParallel
+                                 (void* pArray, size_t count, size_t elemSize, GblSortComparatorFn pFnCmp,
+                                  GblMainLoop* pLoop)                                                      GBL_NOEXCEPT;
 //! @}
 
+//! Maps a signed integer to a gblSortRadix() key with the same ordering
+GBL_INLINE uint64_t gblSortRadixKeyInt(int64_t value) GBL_NOEXCEPT {
+    return (uint64_t)value ^ UINT64_C(0x8000000000000000);
+}
+
+//! Maps a floating-point value to a gblSortRadix() key with the same ordering, with negative zero before zero
+GBL_INLINE uint64_t gblSortRadixKeyFloat(double value) GBL_NOEXCEPT {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & UINT64_C(0x8000000000000000))? ~bits : bits | UINT64_C(0x8000000000000000);
+}
+
 //! Performs a Binary Search over the given array, from index \p l to index \p r, returning its position
 GBL_EXPORT size_t gblSearchBinary (void* pSrc, size_t elemSize, int l, int r, void* pDst, GblSortComparatorFn pFnCmp) GBL_NOEXCEPT;
 
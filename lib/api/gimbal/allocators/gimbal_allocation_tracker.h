@@ -12,6 +12,8 @@
 #include "../core/gimbal_typedefs.h"
 #include "gimbal/core/gimbal_stack_frame.h"
 
+#define GBL_ALLOCATION_TRACKER_SAMPLE_INTERVAL_DEFAULT  (512 * 1024) //!< Suggested mean number of bytes between samples, for GblAllocationTracker_create()
+
 #define GBL_SELF_TYPE GblAllocationTracker
 
 GBL_DECLS_BEGIN
@@ -27,7 +29,38 @@ typedef struct GblAllocationCounters {
     ptrdiff_t allocsActive;     //!< Current number of allocations active
 } GblAllocationCounters;
 
-//! Structure used for tracking allocation events and statistics
+//! Allocation counters aggregated for a single call site
+typedef struct GblAllocationSite {
+    GblSourceLocation     location; //!< Source location the allocations were requested from
+    GblAllocationCounters counters; //!< Counters for allocations requested from GblAllocationSite::location
+} GblAllocationSite;
+
+//! Heap profile snapshot, holding both the overall counters and those of every call site
+typedef struct GblAllocationProfile {
+    GblAllocationCounters counters;  //!< Overall counters at the time of the snapshot
+    size_t                siteCount; //!< Number of entries in GblAllocationProfile::pSites
+    GblAllocationSite*    pSites;    //!< Per-site counters, sorted by descending active bytes
+} GblAllocationProfile;
+
+/*! Structure used for tracking allocation events and statistics
+ *
+ *  By default, every allocation is recorded, which is exact but costs a
+ *  hash table insertion and removal per allocation. When created with a
+ *  sample interval, only allocations which cross a randomly chosen byte
+ *  boundary, on average once every interval bytes, are recorded, with
+ *  each sample weighted to stand in for the allocations it skipped over.
+ *  Unsampled allocations only bump a few counters, which is cheap enough
+ *  to leave enabled in production builds.
+ *
+ *  Either way, recorded allocations are aggregated by call site, which can
+ *  be captured as a GblAllocationProfile and diffed against a later one,
+ *  the same way as GblAllocationCounters.
+ *
+ *  \note
+ *  When sampling, event counts, GblAllocationCounters::allocsActive and
+ *  the maximums of single allocations and active allocations are exact,
+ *  while every byte count and all per-site counters are estimates.
+ */
 typedef struct GblAllocationTracker {
     size_t                maxAllocations;    //!< Maximum number of active allocations
     size_t                maxBytes;          //!< Maximum number of allocated bytes
@@ -40,10 +73,13 @@ typedef struct GblAllocationTracker {
  *  \relatesalso GblAllocationTracker
  *  @{
  */
-//! Creates a GblAllocationTracker and returns a pointer to it
-GBL_EXPORT GBL_SELF_TYPE* GblAllocationTracker_create  (GblContext* pCtx) GBL_NOEXCEPT;
+//! Creates a GblAllocationTracker, sampling once every \p sampleInterval bytes on average or recording everything when 0 (default)
+GBL_EXPORT GBL_SELF_TYPE* GblAllocationTracker_create         (GblContext* pCtx,
+                                                               size_t      sampleInterval/*=0*/) GBL_NOEXCEPT;
 //! Destroys the given GblAllocation tracker, returning the result
-GBL_EXPORT GBL_RESULT     GblAllocationTracker_destroy (GBL_SELF)         GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT     GblAllocationTracker_destroy        (GBL_SELF)                         GBL_NOEXCEPT;
+//! Returns the mean number of bytes between samples of the given tracker, or 0 if it records every allocation
+GBL_EXPORT size_t         GblAllocationTracker_sampleInterval (GBL_CSELF)                        GBL_NOEXCEPT;
 //! @}
 
 /*! \name Allocation Events
@@ -76,10 +112,9 @@ GBL_EXPORT GBL_RESULT GblAllocationTracker_freeEvent    (GBL_SELF,
  *  \relatesalso GblAllocationTracker
  *  @{
  */
-//! Returns GBL_TRUE if the given pointer points to an active, tracked allocation
+//! Returns GBL_TRUE if the given pointer points to an active, tracked allocation (only sampled allocations, when sampling)
 GBL_EXPORT GblBool    GblAllocationTracker_validatePointer (GBL_CSELF, const void* pPtr) GBL_NOEXCEPT;
-//! Dumps all of the active allocations and their context information to the log
-
+//! Dumps all of the active allocations and their context information to the log (only sampled allocations, when sampling)
 GBL_EXPORT GBL_RESULT GblAllocationTracker_logActive       (GBL_CSELF)                   GBL_NOEXCEPT;
 //! @}
 
@@ -96,8 +131,40 @@ GBL_EXPORT void GblAllocationTracker_diffCounters    (GBL_CSELF,
                                                       const GblAllocationCounters* pSrc,
                                                       GblAllocationCounters*       pDst) GBL_NOEXCEPT;
 //! @}
+
+/*! \name Heap Profiling
+ *  \brief Methods for snapshotting and comparing per-site counters
+ *  \relatesalso GblAllocationTracker
+ *  @{
+ */
+//! Saves the current counters, along with those of every call site, to the given profile, which must be released later
+GBL_EXPORT GBL_RESULT GblAllocationTracker_captureProfile (GBL_CSELF,
+                                                           GblAllocationProfile* pProfile)     GBL_NOEXCEPT;
+//! Takes the difference between the current counters of every call site and those in \p pSrc, storing a new profile in \p pDst
+GBL_EXPORT GBL_RESULT GblAllocationTracker_diffProfile    (GBL_CSELF,
+                                                           const GblAllocationProfile* pSrc,
+                                                           GblAllocationProfile*       pDst)  GBL_NOEXCEPT;
+//! Releases the sites held by a profile returned from GblAllocationTracker_captureProfile() or GblAllocationTracker_diffProfile()
+GBL_EXPORT GBL_RESULT GblAllocationTracker_releaseProfile (GBL_CSELF,
+                                                           GblAllocationProfile* pProfile)     GBL_NOEXCEPT;
+//! Dumps the counters of the given profile and its first \p maxSites call sites (or all of them when 0) to the log
+GBL_EXPORT GBL_RESULT GblAllocationTracker_logProfile     (GBL_CSELF,
+                                                           const GblAllocationProfile* pProfile,
+                                                           size_t                      maxSites) GBL_NOEXCEPT;
+//! @}
+
 GBL_DECLS_END
 
+#define GblAllocationTracker_create(...) GblAllocationTracker_createDefault_(__VA_ARGS__)
+
+// ===== IMPL =====
+///\cond
+#define GblAllocationTracker_createDefault_(...) \
+    GblAllocationTracker_createDefault__(__VA_ARGS__, 0)
+#define GblAllocationTracker_createDefault__(ctx, interval, ...) \
+    (GblAllocationTracker_create)(ctx, interval)
+///\endcond
+
 #undef GBL_SELF_TYPE
 
 #endif // GIMBAL_ALLOCATION_TRACKER_H
@@ -23,12 +23,22 @@
 #define GBL_ARENA_ALLOCATOR_GET_CLASS(self) (GBL_CLASSOF(GblArenaAllocator, self))     //!< Get a GblArenaAllocatorClass from a GblInstance
 //! @}
 
+#define GBL_ARENA_ALLOCATOR_MMAP_THRESHOLD  (1024 * 1024)     //!< Size from which pages are mapped directly with GBL_ARENA_ALLOCATOR_FLAG_MMAP
+#define GBL_ARENA_ALLOCATOR_HUGE_PAGE_SIZE  (2 * 1024 * 1024) //!< Size from which mapped pages are hinted to be backed by huge pages
+#define GBL_THREAD_ARENA_PAGE_SIZE          65536             //!< Page size of each thread's GblThreadArena
+#define GBL_THREAD_ARENA_WARM_PAGES         4                 //!< Pages each thread's GblThreadArena keeps between resets
+
 #define GBL_SELF_TYPE GblArenaAllocator
 
 GBL_DECLS_BEGIN
 
 GBL_FORWARD_DECLARE_STRUCT(GblContext);
 
+//! Flags for configuring a GblArenaAllocator upon construction
+GBL_DECLARE_ENUM(GBL_ARENA_ALLOCATOR_FLAG) {
+    GBL_ARENA_ALLOCATOR_FLAG_MMAP = 0x1 //!< Maps pages of at least GBL_ARENA_ALLOCATOR_MMAP_THRESHOLD bytes directly from the OS (Linux only)
+};
+
 /*! \brief Represents a single arena allocation page
  *
  *  GblArenaAllocatorPage is the meta data header and
@@ -87,6 +97,37 @@ GBL_CLASS_DERIVE_EMPTY(GblArenaAllocator, GblObject, GblIAllocator);
  *  to set the GblArenaAllocatorPage::staticAlloc flag to
  *  ensure the allocator does not attempt to free it!
  *
+ *  Requests which are larger than a page are each given a
+ *  dedicated page of their own, which is kept aside from the
+ *  regular pages, so the active page isn't abandoned.
+ *
+ *  \note
+ *  Only the active page at the front of the list is ever
+ *  allocated from. Once a request doesn't fit within it, a new
+ *  page takes its place, and whatever room was left over on the
+ *  old one, or on any other page behind it, such as a second
+ *  static page, isn't used again until the arena is freed with
+ *  GblArenaAllocator_freeAll() or rewound with
+ *  GblArenaAllocator_loadState(). This keeps allocating O(1) and
+ *  saved states valid, at the cost of some fragmentation, which is
+ *  reported by GblArenaAllocator_fragmentedBytes().
+ *
+ *  Rather than returning every page to the context, freeing
+ *  the arena can keep a number of pages "warm" for reuse, set
+ *  with GblArenaAllocator_setWarmPages(). This makes repeatedly
+ *  filling and freeing an arena, such as once per frame or per
+ *  request, nearly free after the first time.
+ *
+ *  When constructed with GBL_ARENA_ALLOCATOR_FLAG_MMAP, pages of
+ *  at least GBL_ARENA_ALLOCATOR_MMAP_THRESHOLD bytes are mapped
+ *  directly from the OS instead, with those of at least
+ *  GBL_ARENA_ALLOCATOR_HUGE_PAGE_SIZE hinted to be backed by
+ *  huge pages, bypassing the context entirely.
+ *
+ *  \note
+ *  An arena is not thread-safe. Use GblThreadArena_current()
+ *  for scratch memory which is private to the calling thread.
+ *
  *  \sa GblArenaAllocatorPage, GblPoolAllocator
  */
 GBL_INSTANCE_DERIVE(GblArenaAllocator, GblObject)
@@ -98,6 +139,11 @@ GBL_INSTANCE_DERIVE(GblArenaAllocator, GblObject)
     size_t      pageSize;                   ///< Default page size for all new pages
     size_t      pageAlign;                  ///< Alignment of each page, also maximum requestable alignment
     size_t      allocCount;                 ///< Total # of allocations across all pages
+    GblArenaAllocatorPage* pLargePages;     ///< Dedicated pages for requests larger than pageSize
+    GblArenaAllocatorPage* pWarmPages;      ///< Freed pages kept for reuse
+    size_t      warmPageCount;              ///< Number of pages held within pWarmPages
+    size_t      warmPageLimit;              ///< Maximum number of pages to keep warm
+    GblFlags    flags;                      ///< GBL_ARENA_ALLOCATOR_FLAG values given upon construction
 GBL_INSTANCE_END
 
 /*! \brief Represents the current state of a GblArenaAllocator
@@ -117,6 +163,7 @@ GBL_INSTANCE_END
 typedef struct GblArenaAllocatorState {
     GblArenaAllocatorPage* pActivePage;
     size_t                 bytesUsed;
+    GblArenaAllocatorPage* pLargePage;
 } GblArenaAllocatorState;
 
 GBL_EXPORT GblType    GblArenaAllocator_type            (void)                                           GBL_NOEXCEPT;
@@ -126,11 +173,18 @@ GBL_EXPORT GBL_RESULT GblArenaAllocator_construct       (GBL_SELF,
                                                          size_t                 pageSize,
                                                          size_t                 pageAlign,
                                                          GblArenaAllocatorPage* pInitialPage,
-                                                         GblContext*            pCtx)                    GBL_NOEXCEPT;
+                                                         GblContext*            pCtx,
+                                                         GblFlags               flags)                   GBL_NOEXCEPT;
 
 GBL_EXPORT GBL_RESULT GblArenaAllocator_destruct        (GBL_SELF)                                       GBL_NOEXCEPT;
 
 GBL_EXPORT size_t     GblArenaAllocator_pageCount       (GBL_CSELF)                                      GBL_NOEXCEPT;
+//! Returns the number of dedicated pages holding requests larger than GblArenaAllocator::pageSize
+GBL_EXPORT size_t     GblArenaAllocator_largePageCount  (GBL_CSELF)                                      GBL_NOEXCEPT;
+//! Returns the number of freed pages currently being kept warm for reuse
+GBL_EXPORT size_t     GblArenaAllocator_warmPageCount   (GBL_CSELF)                                      GBL_NOEXCEPT;
+//! Sets the maximum number of pages kept warm when freed, returning any beyond it to the context
+GBL_EXPORT GBL_RESULT GblArenaAllocator_setWarmPages    (GBL_SELF, size_t count)                         GBL_NOEXCEPT;
 GBL_EXPORT size_t     GblArenaAllocator_bytesUsed       (GBL_CSELF)                                      GBL_NOEXCEPT;
 GBL_EXPORT size_t     GblArenaAllocator_bytesAvailable  (GBL_CSELF)                                      GBL_NOEXCEPT;
 
@@ -144,21 +198,52 @@ GBL_EXPORT GBL_RESULT GblArenaAllocator_loadState       (GBL_SELF, const GblAren
 GBL_EXPORT void*      GblArenaAllocator_alloc           (GBL_SELF, size_t size, size_t alignment)        GBL_NOEXCEPT;
 GBL_EXPORT GBL_RESULT GblArenaAllocator_freeAll         (GBL_SELF)                                       GBL_NOEXCEPT;
 
+/*! \name  Thread Arenas
+ *  \brief Scratch arena private to each thread (and so to each GblThread)
+ *
+ *  Each thread lazily creates its own GblArenaAllocator upon first use,
+ *  with GBL_THREAD_ARENA_PAGE_SIZE pages and up to
+ *  GBL_THREAD_ARENA_WARM_PAGES of them kept warm between resets, which is
+ *  destroyed automatically when the thread exits.
+ *  @{
+ */
+//! Returns the calling thread's arena, creating it if necessary
+GBL_EXPORT GblArenaAllocator* GblThreadArena_current (void)                      GBL_NOEXCEPT;
+//! Allocates \p size bytes aligned to \p align (or the default) from the calling thread's arena
+GBL_EXPORT void*              GblThreadArena_alloc   (size_t size, size_t align) GBL_NOEXCEPT;
+//! Frees everything allocated from the calling thread's arena since the last reset, keeping its warm pages
+GBL_EXPORT GBL_RESULT         GblThreadArena_reset   (void)                      GBL_NOEXCEPT;
+//! Destroys the calling thread's arena, returning all of its pages, if it had one
+GBL_EXPORT GBL_RESULT         GblThreadArena_release (void)                      GBL_NOEXCEPT;
+//! @}
+
 // ===== Macro overloads =====
-#define GblArenaAllocator_construct(...)    GblArenaAllocator_constructDefault_(__VA_ARGS__)
+#define GblArenaAllocator_construct(...)    GBL_VA_OVERLOAD_CALL_ARGC(GblArenaAllocator_constructDefault_, __VA_ARGS__)
 #define GblArenaAllocator_alloc(...)        GblArenaAllocator_allocDefault_(__VA_ARGS__)
+#define GblThreadArena_alloc(...)           GblThreadArena_allocDefault_(__VA_ARGS__)
 
 // ===== IMPL =====
 ///\cond
-#define GblArenaAllocator_constructDefault_(...) \
-    GblArenaAllocator_constructDefault__(__VA_ARGS__, 16, GBL_NULL, GBL_NULL)
-#define GblArenaAllocator_constructDefault__(self, size, align, initial, ctx, ...) \
-    (GblArenaAllocator_construct)(self, size, align, initial, ctx)
+#define GblArenaAllocator_constructDefault__2(self, size) \
+    GblArenaAllocator_constructDefault__3(self, size, 16)
+#define GblArenaAllocator_constructDefault__3(self, size, align) \
+    GblArenaAllocator_constructDefault__4(self, size, align, GBL_NULL)
+#define GblArenaAllocator_constructDefault__4(self, size, align, initial) \
+    GblArenaAllocator_constructDefault__5(self, size, align, initial, GBL_NULL)
+#define GblArenaAllocator_constructDefault__5(self, size, align, initial, ctx) \
+    GblArenaAllocator_constructDefault__6(self, size, align, initial, ctx, 0)
+#define GblArenaAllocator_constructDefault__6(self, size, align, initial, ctx, flags) \
+    (GblArenaAllocator_construct)(self, size, align, initial, ctx, flags)
 
 #define GblArenaAllocator_allocDefault_(...) \
     GblArenaAllocator_allocDefault__(__VA_ARGS__, 0)
 #define GblArenaAllocator_allocDefault__(self, size, align, ...) \
     (GblArenaAllocator_alloc)(self, size, align)
+
+#define GblThreadArena_allocDefault_(...) \
+    GblThreadArena_allocDefault__(__VA_ARGS__, 0)
+#define GblThreadArena_allocDefault__(size, align, ...) \
+    (GblThreadArena_alloc)(size, align)
 ///\endcond
 GBL_DECLS_END
 
@@ -13,10 +13,19 @@
 
 #include "gimbal_arena_allocator.h"
 
+#define GBL_POOL_ALLOCATOR_MAGAZINE_SIZE  32  //!< Free entries cached per thread by a concurrent GblPoolAllocator, half of which move at a time
+
 #define GBL_SELF_TYPE GblPoolAllocator
 
 GBL_DECLS_BEGIN
 
+GBL_FORWARD_DECLARE_STRUCT(GblPoolAllocatorSync_);
+
+//! Flags for configuring a GblPoolAllocator upon construction
+typedef enum GBL_POOL_ALLOCATOR_FLAG {
+    GBL_POOL_ALLOCATOR_FLAG_CONCURRENT = 0x1   //!< Allows entries to be allocated and deleted from any thread
+} GBL_POOL_ALLOCATOR_FLAG;
+
 /*! \brief Pool allocator for ultra-fast fixed-size allocations
  *
  *  GblPoolAllocator is a custsom allocator providing
@@ -36,6 +45,24 @@ GBL_DECLS_BEGIN
  *
  *  The allocator also supports enforcing custom alignment
  *  constraints on each requested allocation.
+ *
+ *  By default, a pool allocator may only be used by one thread
+ *  at a time. When constructed with
+ *  GBL_POOL_ALLOCATOR_FLAG_CONCURRENT, each thread instead keeps
+ *  a small "magazine" of free entries, which it refills from and
+ *  spills over to a lock-free stack shared between threads, half
+ *  of GBL_POOL_ALLOCATOR_MAGAZINE_SIZE at a time. Only growing
+ *  the arena itself takes a lock. Entries may be deleted from a
+ *  different thread than the one which allocated them.
+ *
+ *  Pages whose entries have all been deleted can be given back
+ *  with GblPoolAllocator_reclaim().
+ *
+ *  \note
+ *  In concurrent mode, GblPoolAllocator::freeList and
+ *  GblPoolAllocator::activeEntries are unused, so use
+ *  GblPoolAllocator_freeListSize() and
+ *  GblPoolAllocator_activeCount() instead.
  *  \ingroup allocators
  *  \sa GblArenaAllocator
  */
@@ -45,6 +72,9 @@ typedef struct GblPoolAllocator {
     size_t            entrySize;        //!< Base struct size of each entry
     size_t            entryAlign;       //!< Alignment requirement for each entry
     size_t            activeEntries;    //!< Number of allocated, used entries
+    size_t            freeCount;        //!< Number of entries within the free list
+    GblFlags          flags;            //!< GBL_POOL_ALLOCATOR_FLAG values given upon construction
+    GblPoolAllocatorSync_* pSync;       //!< Shared state for GBL_POOL_ALLOCATOR_FLAG_CONCURRENT
 } GblPoolAllocator;
 
 // ===== Public methods =====
@@ -53,25 +83,53 @@ GBL_EXPORT GBL_RESULT GblPoolAllocator_construct    (GBL_SELF,
                                                      size_t                 entriesPerPage,
                                                      size_t                 entryAlign,
                                                      GblArenaAllocatorPage* pInitialPage,
-                                                     GblContext*            pCtx)           GBL_NOEXCEPT;
+                                                     GblContext*            pCtx,
+                                                     GblFlags               flags)          GBL_NOEXCEPT;
 
 GBL_EXPORT GBL_RESULT GblPoolAllocator_destruct     (GBL_SELF)                              GBL_NOEXCEPT;
 
+//! Returns the number of deleted entries available for reuse, including those cached by each thread, without walking them
 GBL_EXPORT size_t     GblPoolAllocator_freeListSize (GBL_CSELF)                             GBL_NOEXCEPT;
+//! Returns the number of entries which have been allocated and not yet deleted
+GBL_EXPORT size_t     GblPoolAllocator_activeCount  (GBL_CSELF)                             GBL_NOEXCEPT;
 
 GBL_EXPORT void*      GblPoolAllocator_new          (GBL_SELF)                              GBL_NOEXCEPT;
 GBL_EXPORT GBL_RESULT GblPoolAllocator_delete       (GBL_SELF, void* pEntry)                GBL_NOEXCEPT;
 
+//! Allocates up to \p count entries into \p ppEntries, returning how many were allocated before running out of memory
+GBL_EXPORT size_t     GblPoolAllocator_newN         (GBL_SELF,
+                                                     void** ppEntries,
+                                                     size_t count)                          GBL_NOEXCEPT;
+//! Deletes \p count entries from \p ppEntries at once, which may have come from separate calls to GblPoolAllocator_new()
+GBL_EXPORT GBL_RESULT GblPoolAllocator_deleteN      (GBL_SELF,
+                                                     void* const* ppEntries,
+                                                     size_t       count)                    GBL_NOEXCEPT;
+
+/*! Gives back every page whose entries have all been deleted, storing how many were in \p pPages (optional)
+ *
+ *  Heap pages are freed to the arena's context, while the active page and
+ *  any static pages are kept and rewound instead. In concurrent mode, the
+ *  magazines of every thread are drained first, so no other thread may be
+ *  using the allocator while it runs.
+ */
+GBL_EXPORT GBL_RESULT GblPoolAllocator_reclaim      (GBL_SELF, size_t* pPages)              GBL_NOEXCEPT;
+
 // ===== Macro Overloads =====
-#define GblPoolAllocator_construct(...)     GblPoolAllocator_constructDefault_(__VA_ARGS__)
+#define GblPoolAllocator_construct(...)     GBL_VA_OVERLOAD_CALL_ARGC(GblPoolAllocator_constructDefault_, __VA_ARGS__)
 
 // ===== IMPL =====
 
 ///\cond
-#define GblPoolAllocator_constructDefault_(...) \
-    GblPoolAllocator_constructDefault__(__VA_ARGS__, 0, GBL_NULL, GBL_NULL)
-#define GblPoolAllocator_constructDefault__(self, size, perPage, align, initial, ctx, ...) \
-    (GblPoolAllocator_construct)(self, size, perPage, align, initial, ctx)
+#define GblPoolAllocator_constructDefault__3(self, size, perPage) \
+    GblPoolAllocator_constructDefault__4(self, size, perPage, 0)
+#define GblPoolAllocator_constructDefault__4(self, size, perPage, align) \
+    GblPoolAllocator_constructDefault__5(self, size, perPage, align, GBL_NULL)
+#define GblPoolAllocator_constructDefault__5(self, size, perPage, align, initial) \
+    GblPoolAllocator_constructDefault__6(self, size, perPage, align, initial, GBL_NULL)
+#define GblPoolAllocator_constructDefault__6(self, size, perPage, align, initial, ctx) \
+    GblPoolAllocator_constructDefault__7(self, size, perPage, align, initial, ctx, 0)
+#define GblPoolAllocator_constructDefault__7(self, size, perPage, align, initial, ctx, flags) \
+    (GblPoolAllocator_construct)(self, size, perPage, align, initial, ctx, flags)
 ///\endcond
 GBL_DECLS_END
 
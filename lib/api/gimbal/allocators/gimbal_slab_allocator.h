@@ -0,0 +1,151 @@
+/*! \file
+ *  \brief GblSlabAllocator size-class slab allocator and API
+ *  \ingroup allocators
+ *  \copydoc GblSlabAllocator
+ *
+ *  \author 2023 Falco Girgis
+ *  \copyright MIT License
+ */
+
+#ifndef GIMBAL_SLAB_ALLOCATOR_H
+#define GIMBAL_SLAB_ALLOCATOR_H
+
+#include "../meta/instances/gimbal_object.h"
+#include "../meta/ifaces/gimbal_iallocator.h"
+
+/*! \name Type System
+ *  \brief Type UUID and cast operators
+ *  @{
+ */
+#define GBL_SLAB_ALLOCATOR_TYPE             (GBL_TYPEID(GblSlabAllocator))            //!< Type UUID for GblSlabAllocator
+#define GBL_SLAB_ALLOCATOR(self)            (GBL_CAST(GblSlabAllocator, self))        //!< Casts a GblInstance to GblSlabAllocator
+#define GBL_SLAB_ALLOCATOR_CLASS(klass)     (GBL_CLASS_CAST(GblSlabAllocator, klass)) //!< Casts a GblClass to GblSlabAllocatorClass
+#define GBL_SLAB_ALLOCATOR_GET_CLASS(self)  (GBL_CLASSOF(GblSlabAllocator, self))     //!< Gets a GblSlabAllocatorClass from a GblInstance
+//! @}
+
+#define GBL_SLAB_ALLOCATOR_SLAB_SIZE        65536   //!< Size and alignment of each slab, which is split into entries of one size class
+#define GBL_SLAB_ALLOCATOR_CLASS_COUNT      32      //!< Number of segregated size classes
+#define GBL_SLAB_ALLOCATOR_CLASS_SIZE_MAX   8192    //!< Largest size class, above which allocations fall back to the system allocator
+#define GBL_SLAB_ALLOCATOR_ALIGN_MAX        64      //!< Largest alignment served from a size class, above which allocations fall back to the system allocator
+
+#define GBL_SELF_TYPE GblSlabAllocator
+
+GBL_DECLS_BEGIN
+
+GBL_FORWARD_DECLARE_STRUCT(GblSlabAllocatorCentral_);
+
+//! Flags for configuring a GblSlabAllocator upon creation
+typedef enum GBL_SLAB_ALLOCATOR_FLAG {
+    GBL_SLAB_ALLOCATOR_FLAG_STATS = 0x1   //!< Counts allocations, frees and active bytes, for GblSlabAllocator_stats()
+} GBL_SLAB_ALLOCATOR_FLAG;
+
+//! Statistics gathered by a GblSlabAllocator
+typedef struct GblSlabAllocatorStats {
+    size_t allocs;      //!< Number of allocations served from a size class (with GBL_SLAB_ALLOCATOR_FLAG_STATS)
+    size_t frees;       //!< Number of size class allocations which have been freed (with GBL_SLAB_ALLOCATOR_FLAG_STATS)
+    size_t largeAllocs; //!< Number of allocations passed on to the system allocator (with GBL_SLAB_ALLOCATOR_FLAG_STATS)
+    size_t largeFrees;  //!< Number of frees passed on to the system allocator (with GBL_SLAB_ALLOCATOR_FLAG_STATS)
+    size_t bytesActive; //!< Bytes held by live size class allocations, rounded up to their class (with GBL_SLAB_ALLOCATOR_FLAG_STATS)
+    size_t slabs;       //!< Number of slabs currently reserved from the system
+    size_t refills;     //!< Number of batches moved from the central lists into thread caches
+    size_t flushes;     //!< Number of batches returned from thread caches to the central lists
+} GblSlabAllocatorStats;
+
+/*! \struct  GblSlabAllocatorClass
+ *  \extends GblObjectClass
+ *  \implements GblIAllocatorClass
+ *  \brief   GblClass VTable structure for GblSlabAllocator
+ *
+ *  No public members.
+ *
+ *  \sa GblSlabAllocator
+ */
+GBL_CLASS_DERIVE_EMPTY(GblSlabAllocator, GblObject, GblIAllocator)
+
+/*! \struct  GblSlabAllocator
+ *  \extends GblObject
+ *  \implements GblIAllocator
+ *  \ingroup allocators
+ *  \brief   General-purpose allocator with segregated size classes and thread caches
+ *
+ *  GblSlabAllocator is a GblIAllocator for arbitrary allocations, which
+ *  rounds each request up to one of GBL_SLAB_ALLOCATOR_CLASS_COUNT size
+ *  classes, spaced 16 bytes apart up to 128 bytes, then four per doubling
+ *  up to GBL_SLAB_ALLOCATOR_CLASS_SIZE_MAX. Each class carves entries out
+ *  of its own slabs, which are reserved from the system
+ *  GBL_SLAB_ALLOCATOR_SLAB_SIZE bytes at a time.
+ *
+ *  Every thread has its own cache of free entries for each class, so the
+ *  common case of allocating or freeing never takes a lock. Caches are
+ *  refilled from, and return their surplus to, the central lists of each
+ *  class in batches, which is also where slabs are released once all of
+ *  their entries are free again. A thread's cache is returned
+ *  automatically when it exits.
+ *
+ *  Larger or more strictly aligned requests, along with any pointer that
+ *  didn't come from a slab, are passed on to GblIAllocator_parent(),
+ *  skipping over a GblContext the allocator has been plugged into, or to
+ *  the system allocator when there isn't one, just as a root GblContext
+ *  would. A GblSlabAllocator can therefore be plugged into a GblContext
+ *  which already has live allocations with GblContext_setAllocator(),
+ *  after which every GBL_CTX_MALLOC() made through the context is served
+ *  from it, so long as its parent doesn't change while those are live.
+ *
+ *  \note
+ *  A GblSlabAllocator must outlive every allocation made from it, along
+ *  with any GblContext it has been plugged into, and must not be
+ *  destroyed while other threads are still using it.
+ *
+ *  \sa GblSlabAllocatorClass, GblContext_setAllocator()
+ */
+GBL_INSTANCE_DERIVE(GblSlabAllocator, GblObject)
+    GBL_PRIVATE_BEGIN
+        GblFlags                  flags;
+        GblSlabAllocatorCentral_* pCentral;
+    GBL_PRIVATE_END
+GBL_INSTANCE_END
+
+//! Returns the GblType UUID associated with GblSlabAllocator
+GBL_EXPORT GblType GblSlabAllocator_type (void) GBL_NOEXCEPT;
+
+/*! \name Lifetime Management
+ *  \brief Methods for managing GblSlabAllocator lifetime
+ *  \relatesalso GblSlabAllocator
+ *  @{
+ */
+//! Creates a GblSlabAllocator configured with the given GBL_SLAB_ALLOCATOR_FLAG values, returning a pointer to it
+GBL_EXPORT GblSlabAllocator* GblSlabAllocator_create (GblFlags flags) GBL_NOEXCEPT;
+//! Returns a new reference to the given GblSlabAllocator, incrementing its refcount
+GBL_EXPORT GblSlabAllocator* GblSlabAllocator_ref    (GBL_SELF)       GBL_NOEXCEPT;
+//! Releases a reference to the given GblSlabAllocator, destroying it along with its slabs upon hitting zero
+GBL_EXPORT GblRefCount       GblSlabAllocator_unref  (GBL_SELF)       GBL_NOEXCEPT;
+//! @}
+
+/*! \name Accessors
+ *  \brief Methods for querying a GblSlabAllocator
+ *  \relatesalso GblSlabAllocator
+ *  @{
+ */
+//! Returns the GBL_SLAB_ALLOCATOR_FLAG values the given allocator was created with
+GBL_EXPORT GblFlags   GblSlabAllocator_flags     (GBL_CSELF)                        GBL_NOEXCEPT;
+//! Fills in \p pStats with the given allocator's statistics, summed over all threads
+GBL_EXPORT GBL_RESULT GblSlabAllocator_stats     (GBL_CSELF,
+                                                  GblSlabAllocatorStats* pStats)    GBL_NOEXCEPT;
+//! Returns the size class a request of \p size bytes is rounded up to, or 0 if it's too large for one
+GBL_EXPORT size_t     GblSlabAllocator_classSize (size_t size)                      GBL_NOEXCEPT;
+//! @}
+
+/*! \name Thread Caches
+ *  \brief Methods for managing the calling thread's cache
+ *  \relatesalso GblSlabAllocator
+ *  @{
+ */
+//! Returns every entry held by the calling thread's cache to the central lists, releasing any emptied slabs
+GBL_EXPORT GBL_RESULT GblSlabAllocator_flushCache (GBL_SELF) GBL_NOEXCEPT;
+//! @}
+
+GBL_DECLS_END
+
+#undef GBL_SELF_TYPE
+
+#endif // GIMBAL_SLAB_ALLOCATOR_H
@@ -10,17 +10,52 @@
 
 #include "gimbal_array_list.h"
 
+//! Number of children per node used by a GblArrayHeap when constructed with an arity of 0
+#define GBL_ARRAY_HEAP_ARITY_DEFAULT    4
+//! Value of a GblArrayHeapHandle which does not refer to any entry
+#define GBL_ARRAY_HEAP_HANDLE_INVALID   UINT32_MAX
+
 #define GBL_SELF_TYPE GblArrayHeap
 
 GBL_DECLS_BEGIN
 
-typedef int (*GblArrayHeapCmpFn)(const void* pEntry1, const void* pEntry2);
+GBL_FORWARD_DECLARE_STRUCT(GblArrayHeapTracker_);
+
+typedef int      (*GblArrayHeapCmpFn)(const void* pEntry1, const void* pEntry2);
+typedef uint32_t   GblArrayHeapHandle;  //!< Stable reference to an entry, regardless of where it moves within the heap
 
+//! Built-in integer priority key, compared inline rather than through a GblArrayHeapCmpFn
+GBL_DECLARE_ENUM(GBL_ARRAY_HEAP_KEY) {
+    GBL_ARRAY_HEAP_KEY_NONE,        //!< Entries are ordered by the GblArrayHeapCmpFn
+    GBL_ARRAY_HEAP_KEY_INT64_MIN,   //!< Entry with the lowest int64_t key is on top
+    GBL_ARRAY_HEAP_KEY_INT64_MAX,   //!< Entry with the highest int64_t key is on top
+    GBL_ARRAY_HEAP_KEY_UINT64_MIN,  //!< Entry with the lowest uint64_t key is on top
+    GBL_ARRAY_HEAP_KEY_UINT64_MAX,  //!< Entry with the highest uint64_t key is on top
+    GBL_ARRAY_HEAP_KEY_COUNT
+};
 
-/*! \brief Array-based binary heap implementing priority queue
+/*! \brief Array-based d-ary heap implementing priority queue
  *
  *  GblArrayHeap is a dynamic array-backed (GblArrayList)
- *  binary heap, providing a priority queue implementation.
+ *  d-ary heap, providing a priority queue implementation.
+ *  The entry for which the comparator returns the greatest
+ *  value is kept on top.
+ *
+ *  Each node has a configurable number of children (the arity),
+ *  which defaults to GBL_ARRAY_HEAP_ARITY_DEFAULT. A 4-ary heap is
+ *  half as tall as a binary heap, and the children being compared
+ *  against one another when sifting down tend to share a cache line.
+ *
+ *  When constructed with GblArrayHeap_constructKeyed(), entries are
+ *  ordered by an integer key at a fixed offset within each entry,
+ *  which is compared inline without any indirect function calls.
+ *
+ *  Pushing an entry with a GblArrayHeapHandle output argument turns
+ *  on handle tracking, after which every entry has a handle which
+ *  remains valid until it is popped or removed. The handle can then be
+ *  used to look the entry up, to change its priority with
+ *  GblArrayHeap_update(), or to remove it with GblArrayHeap_remove(),
+ *  all in O(log n).
  *
  *  \note
  *  As GblArrayMap is backed by GblArrayList, it also can be
@@ -30,49 +65,78 @@ typedef int (*GblArrayHeapCmpFn)(const void* pEntry1, const void* pEntry2);
  *  \sa GblArrayList
  *  \ingroup containers
  */
-typedef struct GblArrayHeap {           // Size (32-bit / 64-bit)
+typedef struct GblArrayHeap {               // Size (32-bit / 64-bit)
     GBL_PRIVATE_BEGIN
-        GblArrayHeapCmpFn   pFnCmp;     // 4/8      bytes
-        GblArrayList        list;       // 20/36    bytes
+        GblArrayHeapCmpFn     pFnCmp;       // 4/8      bytes
+        GblArrayHeapTracker_* pTracker;     // 4/8      bytes
+        uint32_t              keyOffset;    // 4        bytes
+        uint8_t               keyType;      // 1        bytes
+        uint8_t               arity;        // 1        bytes
+        GblArrayList          list;         // 20/40    bytes
     GBL_PRIVATE_END
-} GblArrayHeap;                         // 24/42    total
+} GblArrayHeap;                             // 36/64    total
 
 // ===== Public Methods ======
-GBL_EXPORT GBL_RESULT  GblArrayHeap_construct   (GBL_SELF,
-                                                 size_t            elemSize,
-                                                 GblArrayHeapCmpFn pFnCmp,
-                                                 size_t            structSize,
-                                                 GblContext*       pCtx)              GBL_NOEXCEPT;
-
-GBL_EXPORT GBL_RESULT  GblArrayHeap_acquire     (GBL_SELF,
-                                                 void*   pData,
-                                                 size_t  size,
-                                                 size_t  capacity)                    GBL_NOEXCEPT;
-
-GBL_EXPORT GBL_RESULT  GblArrayHeap_release     (GBL_SELF,
-                                                 void**   ppData,
-                                                 size_t * pSize,
-                                                 size_t * pCapacity)                  GBL_NOEXCEPT;
-
-GBL_EXPORT GBL_RESULT  GblArrayHeap_destruct    (GBL_SELF)                            GBL_NOEXCEPT;
-GBL_EXPORT GBL_RESULT  GblArrayHeap_copy        (GBL_SELF, const GBL_SELF_TYPE* pRhs) GBL_NOEXCEPT;
-GBL_EXPORT GBL_RESULT  GblArrayHeap_move        (GBL_SELF, GBL_SELF_TYPE* pRhs)       GBL_NOEXCEPT;
-
-GBL_EXPORT GblContext* GblArrayHeap_context     (GBL_CSELF)                           GBL_NOEXCEPT;
-GBL_EXPORT size_t      GblArrayHeap_elementSize (GBL_CSELF)                           GBL_NOEXCEPT;
-GBL_EXPORT size_t      GblArrayHeap_size        (GBL_CSELF)                           GBL_NOEXCEPT;
-GBL_EXPORT size_t      GblArrayHeap_capacity    (GBL_CSELF)                           GBL_NOEXCEPT;
-GBL_EXPORT GblBool     GblArrayHeap_empty       (GBL_CSELF)                           GBL_NOEXCEPT;
-GBL_EXPORT GblBool     GblArrayHeap_stack       (GBL_CSELF)                           GBL_NOEXCEPT;
-GBL_EXPORT void*       GblArrayHeap_data        (GBL_CSELF)                           GBL_NOEXCEPT;
-
-GBL_EXPORT void*       GblArrayHeap_peek        (GBL_CSELF)                           GBL_NOEXCEPT;
-GBL_EXPORT GBL_RESULT  GblArrayHeap_pop         (GBL_SELF, void* pEntryOut)           GBL_NOEXCEPT;
-GBL_EXPORT GBL_RESULT  GblArrayHeap_push        (GBL_SELF, const void* pEntry)        GBL_NOEXCEPT;
-
-GBL_EXPORT GBL_RESULT  GblArrayHeap_clear       (GBL_SELF)                            GBL_NOEXCEPT;
-GBL_EXPORT GBL_RESULT  GblArrayHeap_reserve     (GBL_SELF, size_t  capacity)          GBL_NOEXCEPT;
-GBL_EXPORT GBL_RESULT  GblArrayHeap_shrinkToFit (GBL_SELF)                            GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT  GblArrayHeap_construct      (GBL_SELF,
+                                                    size_t            elemSize,
+                                                    GblArrayHeapCmpFn pFnCmp,
+                                                    size_t            structSize,
+                                                    GblContext*       pCtx,
+                                                    size_t            arity)             GBL_NOEXCEPT;
+
+GBL_EXPORT GBL_RESULT  GblArrayHeap_constructKeyed (GBL_SELF,
+                                                    size_t             elemSize,
+                                                    size_t             keyOffset,
+                                                    GBL_ARRAY_HEAP_KEY keyType,
+                                                    size_t             structSize,
+                                                    GblContext*        pCtx,
+                                                    size_t             arity)            GBL_NOEXCEPT;
+
+GBL_EXPORT GBL_RESULT  GblArrayHeap_acquire        (GBL_SELF,
+                                                    void*   pData,
+                                                    size_t  size,
+                                                    size_t  capacity)                    GBL_NOEXCEPT;
+
+GBL_EXPORT GBL_RESULT  GblArrayHeap_release        (GBL_SELF,
+                                                    void**   ppData,
+                                                    size_t * pSize,
+                                                    size_t * pCapacity)                  GBL_NOEXCEPT;
+
+GBL_EXPORT GBL_RESULT  GblArrayHeap_destruct       (GBL_SELF)                            GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT  GblArrayHeap_copy           (GBL_SELF, const GBL_SELF_TYPE* pRhs) GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT  GblArrayHeap_move           (GBL_SELF, GBL_SELF_TYPE* pRhs)       GBL_NOEXCEPT;
+
+GBL_EXPORT GblContext* GblArrayHeap_context        (GBL_CSELF)                           GBL_NOEXCEPT;
+GBL_EXPORT size_t      GblArrayHeap_elementSize    (GBL_CSELF)                           GBL_NOEXCEPT;
+GBL_EXPORT size_t      GblArrayHeap_arity          (GBL_CSELF)                           GBL_NOEXCEPT;
+GBL_EXPORT size_t      GblArrayHeap_size           (GBL_CSELF)                           GBL_NOEXCEPT;
+GBL_EXPORT size_t      GblArrayHeap_capacity       (GBL_CSELF)                           GBL_NOEXCEPT;
+GBL_EXPORT GblBool     GblArrayHeap_empty          (GBL_CSELF)                           GBL_NOEXCEPT;
+GBL_EXPORT GblBool     GblArrayHeap_stack          (GBL_CSELF)                           GBL_NOEXCEPT;
+GBL_EXPORT GblBool     GblArrayHeap_tracking       (GBL_CSELF)                           GBL_NOEXCEPT;
+GBL_EXPORT void*       GblArrayHeap_data           (GBL_CSELF)                           GBL_NOEXCEPT;
+
+GBL_EXPORT void*       GblArrayHeap_peek           (GBL_CSELF)                           GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT  GblArrayHeap_pop            (GBL_SELF, void* pEntryOut)           GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT  GblArrayHeap_push           (GBL_SELF,
+                                                    const void*         pEntry,
+                                                    GblArrayHeapHandle* pHandle/*=NULL*/) GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT  GblArrayHeap_pushN          (GBL_SELF,
+                                                    const void*         pEntries,
+                                                    size_t              count,
+                                                    GblArrayHeapHandle* pHandles/*=NULL*/) GBL_NOEXCEPT; //heapifies when doubling the size
+
+GBL_EXPORT void*       GblArrayHeap_at             (GBL_CSELF, GblArrayHeapHandle handle) GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT  GblArrayHeap_update         (GBL_SELF,
+                                                    GblArrayHeapHandle handle,
+                                                    const void*        pEntry)           GBL_NOEXCEPT; //decrease or increase key
+GBL_EXPORT GBL_RESULT  GblArrayHeap_remove         (GBL_SELF,
+                                                    GblArrayHeapHandle handle,
+                                                    void*              pEntryOut)        GBL_NOEXCEPT;
+
+GBL_EXPORT GBL_RESULT  GblArrayHeap_clear          (GBL_SELF)                            GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT  GblArrayHeap_reserve        (GBL_SELF, size_t  capacity)          GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT  GblArrayHeap_shrinkToFit    (GBL_SELF)                            GBL_NOEXCEPT;
 
 GBL_DECLS_END
 
@@ -80,9 +144,26 @@ GBL_DECLS_END
 #define GblArrayHeap_construct(...) \
     GblArrayHeap_constructDefault_(__VA_ARGS__)
 #define GblArrayHeap_constructDefault_(...) \
-    GblArrayHeap_constructDefault__(__VA_ARGS__, sizeof(GblArrayHeap), GBL_NULL)
-#define GblArrayHeap_constructDefault__(self, elemSize, cmp, structSize, ctx, ...) \
-    (GblArrayHeap_construct)(self, elemSize, cmp, structSize, ctx)
+    GblArrayHeap_constructDefault__(__VA_ARGS__, sizeof(GblArrayHeap), GBL_NULL, 0)
+#define GblArrayHeap_constructDefault__(self, elemSize, cmp, structSize, ctx, arity, ...) \
+    (GblArrayHeap_construct)(self, elemSize, cmp, structSize, ctx, arity)
+
+#define GblArrayHeap_constructKeyed(...) \
+    GblArrayHeap_constructKeyedDefault_(__VA_ARGS__)
+#define GblArrayHeap_constructKeyedDefault_(...) \
+    GblArrayHeap_constructKeyedDefault__(__VA_ARGS__, sizeof(GblArrayHeap), GBL_NULL, 0)
+#define GblArrayHeap_constructKeyedDefault__(self, elemSize, keyOffset, keyType, structSize, ctx, arity, ...) \
+    (GblArrayHeap_constructKeyed)(self, elemSize, keyOffset, keyType, structSize, ctx, arity)
+
+#define GblArrayHeap_push(...) \
+    GblArrayHeap_pushDefault_(__VA_ARGS__, GBL_NULL)
+#define GblArrayHeap_pushDefault_(self, entry, handle, ...) \
+    (GblArrayHeap_push)(self, entry, handle)
+
+#define GblArrayHeap_pushN(...) \
+    GblArrayHeap_pushNDefault_(__VA_ARGS__, GBL_NULL)
+#define GblArrayHeap_pushNDefault_(self, entries, count, handles, ...) \
+    (GblArrayHeap_pushN)(self, entries, count, handles)
 //! \endcond
 
 #undef GBL_SELF_TYPE
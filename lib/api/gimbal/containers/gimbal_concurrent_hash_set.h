@@ -0,0 +1,159 @@
+/*! \file
+ *  \brief GblConcurrentHashSet thread-safe, lock-striped hash set
+ *  \ingroup containers
+ *
+ *  This file contains the API for GblConcurrentHashSet, a hash set
+ *  which may be read from and written to by any number of threads
+ *  simultaneously, without any external synchronization.
+ *
+ *  \author 2023 Falco Girgis
+ *  \copyright MIT License
+ */
+
+#ifndef GIMBAL_CONCURRENT_HASH_SET_H
+#define GIMBAL_CONCURRENT_HASH_SET_H
+
+#include "gimbal_hash_set.h"
+
+//! Number of shards used by a GblConcurrentHashSet when constructed with a shard count of 0
+#define GBL_CONCURRENT_HASH_SET_SHARD_COUNT_DEFAULT     16
+
+#define GBL_SELF_TYPE GblConcurrentHashSet
+
+GBL_DECLS_BEGIN
+
+GBL_FORWARD_DECLARE_STRUCT(GblConcurrentHashSet);
+GBL_FORWARD_DECLARE_STRUCT(GblConcurrentHashSetShard_);
+
+typedef GblHash (*GblConcurrentHashSetHashFn)(GBL_CSELF, const void*);              //!< User-defined hasher function, hashing an entry
+typedef GblBool (*GblConcurrentHashSetCmpFn) (GBL_CSELF, const void*, const void*); //!< User-defined comparator function, comparing two entries
+typedef void    (*GblConcurrentHashSetDtorFn)(GBL_CSELF, void*);                    //!< User-defined destructor function, destroying an entry
+typedef GblBool (*GblConcurrentHashSetIterFn)(GBL_CSELF, void*, void*);             //!< User-defined visitor function for an entry
+
+/*! Thread-safe hash set, which is split into independently locked shards
+ *
+ *  GblConcurrentHashSet mirrors the GblHashSet API, but can be shared between
+ *  threads without any external locking. Entries are distributed among a
+ *  power-of-two number of shards by their hash, each of which is a
+ *  GblHashSet using GBL_HASH_SET_LAYOUT_GROUPED, guarded by its own
+ *  readers-writer spin lock. Any number of threads may look entries up
+ *  within a shard at once, and writers only ever contend with other
+ *  threads accessing the same shard. A shard grows or shrinks while only
+ *  holding its own lock, so resizing never stalls the rest of the set.
+ *
+ *  Since another thread may move or remove an entry as soon as a lock is
+ *  released, the API never returns pointers to entries. They are copied in
+ *  and out instead, with GblConcurrentHashSet_visit() for modifying an
+ *  entry in place and GblConcurrentHashSet_foreach() replacing iterators.
+ *
+ *  \note
+ *  The user-defined callbacks are invoked with a shard lock held, so they
+ *  must not call back into the same set.
+ *
+ *  \sa GblHashSet
+ *  \ingroup containers
+ */
+typedef struct GblConcurrentHashSet {
+    GBL_PRIVATE_BEGIN
+        GblContext*                 pCtx;
+        size_t                      entrySize;
+        GblConcurrentHashSetHashFn  pFnHash;
+        GblConcurrentHashSetCmpFn   pFnCompare;
+        GblConcurrentHashSetDtorFn  pFnDestruct;
+        void*                       pUserdata;
+        size_t                      shardMask;
+        GblConcurrentHashSetShard_* pShards;
+    GBL_PRIVATE_END
+} GblConcurrentHashSet;
+
+GBL_EXPORT GBL_RESULT  GblConcurrentHashSet_construct_9   (GBL_SELF,
+                                                           size_t                     entrySize,
+                                                           GblConcurrentHashSetHashFn pFnHash,
+                                                           GblConcurrentHashSetCmpFn  pFnCompare,
+                                                           GblConcurrentHashSetDtorFn pFnDestruct,
+                                                           size_t                     capacity,
+                                                           GblContext*                pCtx,
+                                                           void*                      pUserdata,
+                                                           size_t                     shardCount)  GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT  GblConcurrentHashSet_construct_8   (GBL_SELF,
+                                                           size_t                     entrySize,
+                                                           GblConcurrentHashSetHashFn pFnHash,
+                                                           GblConcurrentHashSetCmpFn  pFnCompare,
+                                                           GblConcurrentHashSetDtorFn pFnDestruct,
+                                                           size_t                     capacity,
+                                                           GblContext*                pCtx,
+                                                           void*                      pUserdata)   GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT  GblConcurrentHashSet_construct_7   (GBL_SELF,
+                                                           size_t                     entrySize,
+                                                           GblConcurrentHashSetHashFn pFnHash,
+                                                           GblConcurrentHashSetCmpFn  pFnCompare,
+                                                           GblConcurrentHashSetDtorFn pFnDestruct,
+                                                           size_t                     capacity,
+                                                           GblContext*                pCtx)        GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT  GblConcurrentHashSet_construct_6   (GBL_SELF,
+                                                           size_t                     entrySize,
+                                                           GblConcurrentHashSetHashFn pFnHash,
+                                                           GblConcurrentHashSetCmpFn  pFnCompare,
+                                                           GblConcurrentHashSetDtorFn pFnDestruct,
+                                                           size_t                     capacity)    GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT  GblConcurrentHashSet_construct_5   (GBL_SELF,
+                                                           size_t                     entrySize,
+                                                           GblConcurrentHashSetHashFn pFnHash,
+                                                           GblConcurrentHashSetCmpFn  pFnCompare,
+                                                           GblConcurrentHashSetDtorFn pFnDestruct) GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT  GblConcurrentHashSet_construct_4   (GBL_SELF,
+                                                           size_t                     entrySize,
+                                                           GblConcurrentHashSetHashFn pFnHash,
+                                                           GblConcurrentHashSetCmpFn  pFnCompare)  GBL_NOEXCEPT;
+#define                GblConcurrentHashSet_construct(...) \
+        GBL_VA_OVERLOAD_CALL_ARGC(GblConcurrentHashSet_construct, __VA_ARGS__)
+
+GBL_EXPORT GBL_RESULT  GblConcurrentHashSet_destruct      (GBL_SELF)                              GBL_NOEXCEPT;
+
+GBL_EXPORT size_t      GblConcurrentHashSet_size          (GBL_CSELF)                             GBL_NOEXCEPT; //approximate while being written to
+GBL_EXPORT GblBool     GblConcurrentHashSet_empty         (GBL_CSELF)                             GBL_NOEXCEPT;
+GBL_EXPORT size_t      GblConcurrentHashSet_shardCount    (GBL_CSELF)                             GBL_NOEXCEPT;
+GBL_EXPORT GblContext* GblConcurrentHashSet_context       (GBL_CSELF)                             GBL_NOEXCEPT;
+GBL_EXPORT void*       GblConcurrentHashSet_userdata      (GBL_CSELF)                             GBL_NOEXCEPT;
+
+GBL_EXPORT GblBool     GblConcurrentHashSet_get           (GBL_CSELF,
+                                                           const void* pKey,
+                                                           void*       pEntry)                    GBL_NOEXCEPT; //copies out entry, if found
+GBL_EXPORT GblBool     GblConcurrentHashSet_contains      (GBL_CSELF, const void* pKey)           GBL_NOEXCEPT; //true if entry exists
+GBL_EXPORT size_t      GblConcurrentHashSet_count         (GBL_CSELF, const void* pKey)           GBL_NOEXCEPT; //# of matching entries (0 or 1)
+
+GBL_EXPORT GblBool     GblConcurrentHashSet_set           (GBL_SELF,
+                                                           const void* pEntry,
+                                                           void*       pPrevEntry/*=NULL*/)       GBL_NOEXCEPT; //raw set, copies out existing item w/o deleting
+GBL_EXPORT GblBool     GblConcurrentHashSet_insert        (GBL_SELF, const void* pEntry)          GBL_NOEXCEPT; //false if already exists
+GBL_EXPORT void        GblConcurrentHashSet_insertOrAssign(GBL_SELF, const void* pEntry)          GBL_NOEXCEPT; //deletes any overwritten value
+GBL_EXPORT GblBool     GblConcurrentHashSet_visit         (GBL_SELF,
+                                                           const void*                pKey,
+                                                           GblConcurrentHashSetIterFn pFnVisit,
+                                                           void*                      pUdata)     GBL_NOEXCEPT; //exclusive, in-place access to an entry
+
+GBL_EXPORT GblBool     GblConcurrentHashSet_erase         (GBL_SELF, const void* pKey)            GBL_NOEXCEPT; //deletes entry, not found is fine
+GBL_EXPORT GblBool     GblConcurrentHashSet_extract       (GBL_SELF,
+                                                           const void* pKey,
+                                                           void*       pEntry)                    GBL_NOEXCEPT; //removes and copies out entry, no deletion
+GBL_EXPORT void        GblConcurrentHashSet_clear         (GBL_SELF)                              GBL_NOEXCEPT; //deletes entries
+
+GBL_EXPORT GblBool     GblConcurrentHashSet_foreach       (GBL_CSELF,
+                                                           GblConcurrentHashSetIterFn pFnIter,
+                                                           void*                      pUdata)     GBL_NOEXCEPT; //iterates one shard at a time
+
+#define GblConcurrentHashSet_set(...) \
+        GBL_VA_OVERLOAD_CALL_ARGC(GblConcurrentHashSet_set_, __VA_ARGS__)
+
+GBL_DECLS_END
+
+///\cond
+#define GblConcurrentHashSet_set__3(self, entry, prev) \
+    ((GblConcurrentHashSet_set)(self, entry, prev))
+#define GblConcurrentHashSet_set__2(self, entry) \
+    (GblConcurrentHashSet_set__3(self, entry, GBL_NULL))
+///\endcond
+
+#undef GBL_SELF_TYPE
+
+#endif // GIMBAL_CONCURRENT_HASH_SET_H
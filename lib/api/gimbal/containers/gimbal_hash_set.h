@@ -23,12 +23,25 @@ typedef GblBool (*GblHashSetCmpFn) (GBL_CSELF, const void*, const void*); //!< U
 typedef void    (*GblHashSetDtorFn)(GBL_CSELF, void*);                    //!< User-defined destructor function, destroying an entry
 typedef GblBool (*GblHashSetIterFn)(GBL_CSELF, void*, void*);             //!< User-defined iterator function for traversal
 
+//! Storage layouts which may be selected when constructing a GblHashSet
+GBL_DECLARE_ENUM(GBL_HASH_SET_LAYOUT) {
+    GBL_HASH_SET_LAYOUT_ROBIN_HOOD, //!< Robin Hood probing over buckets which store each entry's hash inline (default)
+    GBL_HASH_SET_LAYOUT_GROUPED     //!< Swiss table-style probing over 1-byte control tags, 16 at a time, with densely stored entries
+};
+
 /*! Hash-table based abstract associative container with C++-style STL std::unoredered_set API
  *
  *  GblHashSet uses open-addressing ans is implemented using a Robin Hood hashing algorithm.
  *  Using it requires providing a custom hasher function (which typically uses one of
  *  the libGimbal hashing algorithms such as gblHashMurmur()) as well as a custom comparator function.
  *
+ *  Alternatively, a GblHashSet may be constructed with GBL_HASH_SET_LAYOUT_GROUPED, which
+ *  keeps a separate array of 1-byte control tags (7 bits of each entry's hash) and probes
+ *  them a group of 16 at a time, using SSE2 or NEON when available. Entries are then stored
+ *  densely, without any per-bucket header, which is considerably friendlier to the cache for
+ *  large tables, larger entries, and lookups which miss. The API and iterator semantics are
+ *  identical for both layouts, with GblHashSet_bucketSize() simply returning the entry size.
+ *
  *  \note
  *  Performance is pretty darn good. Read speed is faster than both C++'s std::unordered_pSelf and
  *  Qt's QHash (despite being runtime polymorphic with C function pointers) while write speed
@@ -51,6 +64,9 @@ typedef struct GblHashSet {
         void*              pBuckets;
         void*              pSpare;
         void*              pUserdata;
+        uint8_t*           pCtrl;       // GBL_HASH_SET_LAYOUT_GROUPED control tags
+        size_t             growthLeft;  // GBL_HASH_SET_LAYOUT_GROUPED empty buckets left before a rehash
+        GBL_HASH_SET_LAYOUT layout;
     GBL_PRIVATE_END
 } GblHashSet;
 
@@ -64,6 +80,15 @@ typedef struct GblHashSetIter {
     GBL_PRIVATE_END
 } GblHashSetIter;
 
+GBL_EXPORT GBL_RESULT        GblHashSet_construct_9   (GBL_SELF,
+                                                       size_t              entrySize,
+                                                       GblHashSetHashFn    pFnHash,
+                                                       GblHashSetCmpFn     pFnCompare,
+                                                       GblHashSetDtorFn    pFnDestruct,
+                                                       size_t              capacity,
+                                                       GblContext*         pCtx,
+                                                       void*               pUserdata,
+                                                       GBL_HASH_SET_LAYOUT layout)      GBL_NOEXCEPT;
 GBL_EXPORT GBL_RESULT        GblHashSet_construct_8   (GBL_SELF,
                                                        size_t             entrySize,
                                                        GblHashSetHashFn   pFnHash,
@@ -115,6 +140,7 @@ GBL_EXPORT size_t            GblHashSet_bucketSize    (GBL_CSELF)
 GBL_EXPORT GblContext*       GblHashSet_context       (GBL_CSELF)                       GBL_NOEXCEPT;
 GBL_EXPORT GblBool           GblHashSet_empty         (GBL_CSELF)                       GBL_NOEXCEPT;
 GBL_EXPORT void*             GblHashSet_userdata      (GBL_CSELF)                       GBL_NOEXCEPT;
+GBL_EXPORT GBL_HASH_SET_LAYOUT GblHashSet_layout      (GBL_CSELF)                       GBL_NOEXCEPT;
 
 GBL_EXPORT void*             GblHashSet_get           (GBL_CSELF, const void* pKey)     GBL_NOEXCEPT; //raw get, no error
 GBL_EXPORT void*             GblHashSet_at            (GBL_CSELF, const void* pKey)     GBL_NOEXCEPT; //throws range error
@@ -20,8 +20,18 @@
 
 #define GBL_SELF_TYPE GblRingBuffer
 
+//! Threading mode of a GblRingBuffer, specified at construction-time
+GBL_DECLARE_ENUM(GBL_RING_BUFFER_MODE) {
+    GBL_RING_BUFFER_MODE_DEFAULT  = 0x0, //!< Single-threaded, overwrites the oldest values when full
+    GBL_RING_BUFFER_MODE_SPSC     = 0x1, //!< Lock-free, for a single producer and a single consumer thread
+    GBL_RING_BUFFER_MODE_MPMC     = 0x2, //!< Lock-free, for any number of producer and consumer threads
+    GBL_RING_BUFFER_MODE_BLOCKING = 0x4  //!< Flag for SPSC or MPMC which lets the wait functions sleep rather than spin
+};
+
 GBL_DECLS_BEGIN
 
+GBL_FORWARD_DECLARE_STRUCT(GblRingBufferSync_);
+
 /*! \brief Contiguous, array-based circular/ring buffer with queue semantics
  *
  *  GblRingBuffer is a generic container of fixed capacity,
@@ -46,19 +56,38 @@ GBL_DECLS_BEGIN
  *  buffers in memory, where a producer is pushing new entries while a
  *  consumer pops them.
  *
+ *  When constructed with a concurrent GBL_RING_BUFFER_MODE, the buffer
+ *  may be shared between producer and consumer threads without any
+ *  external locking. In these modes, the capacity is rounded up to the
+ *  next power-of-two, and a full buffer rejects new values rather than
+ *  overwriting the oldest ones. Since a slot may be reused as soon as it
+ *  has been popped, values are copied in and out with
+ *  GblRingBuffer_tryPushBack(), GblRingBuffer_tryPopFront() and their
+ *  bulk and blocking counterparts rather than by pointer.
+ *
  *  \ingroup containers
  *  \sa GblDeque, GblArrayList
  */
 typedef struct GblRingBuffer {      // Size (32/64-bit)
     GBL_PRIVATE_BEGIN
-        GblContext* pCtx;           // 4/8      bytes
-        uint8_t*    pData;          // 4/8      bytes
-        size_t      size;           // 4/8      bytes
-        size_t      capacity;       // 4/8      bytes
-        size_t      frontPos;       // 4/8      bytes
-        uint16_t    elementSize;    // 2        bytes
+        GblContext*         pCtx;        // 4/8      bytes
+        uint8_t*            pData;       // 4/8      bytes
+        size_t              size;        // 4/8      bytes
+        size_t              capacity;    // 4/8      bytes
+        size_t              frontPos;    // 4/8      bytes
+        uint16_t            elementSize; // 2        bytes
+        uint8_t             mode;        // 1        byte
+        GblRingBufferSync_* pSync;       // 4/8      bytes
     GBL_PRIVATE_END
-} GblRingBuffer;                    // 22/42    total
+} GblRingBuffer;                         // 27/51    total
+
+GBL_EXPORT GBL_RESULT  GblRingBuffer_construct_7(GBL_SELF,
+                                                 uint16_t             elementSize,
+                                                 size_t               capacity,
+                                                 size_t               initialSize,
+                                                 const void*          pInitialData,
+                                                 GblContext*          pCtx,
+                                                 GBL_RING_BUFFER_MODE mode)                   GBL_NOEXCEPT;
 
 GBL_EXPORT GBL_RESULT  GblRingBuffer_construct_6(GBL_SELF,
                                                  uint16_t    elementSize,
@@ -94,6 +123,8 @@ GBL_EXPORT GblContext* GblRingBuffer_context     (GBL_CSELF)
 GBL_EXPORT size_t      GblRingBuffer_capacity    (GBL_CSELF)                                  GBL_NOEXCEPT;
 GBL_EXPORT size_t      GblRingBuffer_size        (GBL_CSELF)                                  GBL_NOEXCEPT;
 GBL_EXPORT size_t      GblRingBuffer_elementSize (GBL_CSELF)                                  GBL_NOEXCEPT;
+GBL_EXPORT GBL_RING_BUFFER_MODE
+                       GblRingBuffer_mode        (GBL_CSELF)                                  GBL_NOEXCEPT;
 
 GBL_EXPORT GblBool     GblRingBuffer_empty       (GBL_CSELF)                                  GBL_NOEXCEPT;
 GBL_EXPORT GblBool     GblRingBuffer_full        (GBL_CSELF)                                  GBL_NOEXCEPT;
@@ -108,6 +139,13 @@ GBL_EXPORT void*       GblRingBuffer_emplaceBack (GBL_SELF)
 GBL_EXPORT void*       GblRingBuffer_popFront    (GBL_SELF)                                   GBL_NOEXCEPT;
 GBL_EXPORT void        GblRingBuffer_clear       (GBL_SELF)                                   GBL_NOEXCEPT;
 
+GBL_EXPORT GblBool     GblRingBuffer_tryPushBack (GBL_SELF, const void* pData)                GBL_NOEXCEPT; //false if full
+GBL_EXPORT GblBool     GblRingBuffer_tryPopFront (GBL_SELF, void* pData)                      GBL_NOEXCEPT; //false if empty, pData may be NULL
+GBL_EXPORT size_t      GblRingBuffer_pushBackN   (GBL_SELF, const void* pData, size_t count)  GBL_NOEXCEPT; //returns # pushed
+GBL_EXPORT size_t      GblRingBuffer_popFrontN   (GBL_SELF, void* pData, size_t count)        GBL_NOEXCEPT; //returns # popped, pData may be NULL
+GBL_EXPORT GBL_RESULT  GblRingBuffer_waitPushBack(GBL_SELF, const void* pData)                GBL_NOEXCEPT; //blocks while full
+GBL_EXPORT GBL_RESULT  GblRingBuffer_waitPopFront(GBL_SELF, void* pData)                      GBL_NOEXCEPT; //blocks while empty
+
 GBL_DECLS_END
 
 #undef GBL_SELF_TYPE
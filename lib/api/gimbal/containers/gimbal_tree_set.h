@@ -12,6 +12,9 @@
 #include <time.h>
 #include "../core/gimbal_ctx.h"
 
+//! Maximum height of a GblTreeSet which can be traversed with a GblTreeSetCursor
+#define GBL_TREE_SET_CURSOR_DEPTH   32
+
 #define GBL_SELF_TYPE GblTreeSet
 
 GBL_DECLS_BEGIN
@@ -27,6 +30,7 @@ typedef struct GblTreeSetNode {
     GblBool                 leaf;
     uint8_t                 padding[sizeof(void*)-3];
     void*                   pEntries;
+    size_t*                 pCounts;    // # of entries within each child's subtree, NULL for leaves
     struct GblTreeSetNode*  pChildren[1];
 } GblTreeSetNode;
 
@@ -44,6 +48,12 @@ typedef struct GblTreeSetPool {
  } GblTreeSetPool;
 
 /*! \brief Binary tree based abstract associative container with C++-style STL API
+ *
+ *  Each branch node also tracks the number of entries beneath each of its
+ *  children, which lets GblTreeSet_select() and GblTreeSet_rank() find an
+ *  entry by its sorted position or count the entries before a key in
+ *  O(log N), without visiting the entries in between.
+ *
  *  \ingroup containers
  */
 typedef struct GblTreeSet {
@@ -70,6 +80,25 @@ typedef struct GblTreeSetIterator {
     uint16_t            index;
 } GblTreeSetIterator;
 
+/*! \brief Cursor for traversing an ordered range of a GblTreeSet
+ *
+ *  A GblTreeSetCursor is positioned with GblTreeSet_range(), then stepped
+ *  through the range one entry at a time with GblTreeSetCursor_next(), or
+ *  a contiguous run of entries at a time with GblTreeSetCursor_span().
+ *  It is invalidated by any modification to its GblTreeSet.
+ */
+typedef struct GblTreeSetCursor {
+    GBL_PRIVATE_BEGIN
+        const GblTreeSet*   pSet;
+        const void*         pUpper;
+        size_t              depth;
+        struct {
+            GblTreeSetNode* pNode;
+            size_t          index;
+        }                   stack[GBL_TREE_SET_CURSOR_DEPTH];
+    GBL_PRIVATE_END
+} GblTreeSetCursor;
+
 
 GBL_EXPORT GBL_RESULT   GblTreeSet_construct_7  (GBL_SELF,
                                                  size_t                    entrySize,
@@ -100,6 +129,9 @@ GBL_EXPORT GBL_RESULT   GblTreeSet_construct_3  (GBL_SELF,
                                                   GBL_VA_OVERLOAD_CALL_ARGC(GblTreeSet_construct, __VA_ARGS__)
 
 GBL_EXPORT GBL_RESULT   GblTreeSet_destruct     (GBL_SELF)                              GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT   GblTreeSet_load         (GBL_SELF,
+                                                 const void* pEntries,
+                                                 size_t      count)                     GBL_NOEXCEPT; //replaces contents with strictly ascending entries in O(N)
 
 GBL_EXPORT size_t       GblTreeSet_size         (GBL_CSELF)                             GBL_NOEXCEPT;
 GBL_EXPORT size_t       GblTreeSet_height       (GBL_CSELF)                             GBL_NOEXCEPT;
@@ -117,6 +149,11 @@ GBL_EXPORT void*        GblTreeSet_atHint       (GBL_CSELF,
                                                  uint64_t* pHint)                       GBL_NOEXCEPT;
 GBL_EXPORT GblBool      GblTreeSet_contains     (GBL_CSELF, const void* pKey)           GBL_NOEXCEPT;
 GBL_EXPORT size_t       GblTreeSet_count        (GBL_CSELF, const void* pKey)           GBL_NOEXCEPT;
+GBL_EXPORT size_t       GblTreeSet_countRange   (GBL_CSELF,
+                                                 const void* pLower,
+                                                 const void* pUpper)                    GBL_NOEXCEPT; //# of entries within [lower, upper], NULL is unbounded
+GBL_EXPORT size_t       GblTreeSet_rank         (GBL_CSELF, const void* pKey)           GBL_NOEXCEPT; //# of entries less than key
+GBL_EXPORT void*        GblTreeSet_select       (GBL_CSELF, size_t index)               GBL_NOEXCEPT; //entry at the given sorted position
 //GBL_EXPORT ???        GblTreeSet_find         (GBL_CSELF, const void* pKey)               GBL_NOEXCEPT;
 
 GBL_EXPORT void*        GblTreeSet_set          (GBL_SELF, const void* pEntry)          GBL_NOEXCEPT;
@@ -134,10 +171,24 @@ GBL_EXPORT void*        GblTreeSet_popMin       (GBL_SELF)
 GBL_EXPORT void*        GblTreeSet_min          (GBL_CSELF)                             GBL_NOEXCEPT;
 GBL_EXPORT void*        GblTreeSet_max          (GBL_CSELF)                             GBL_NOEXCEPT;
 
+GBL_EXPORT void*        GblTreeSet_range        (GBL_CSELF,
+                                                 GblTreeSetCursor* pCursor,
+                                                 const void*       pLower,
+                                                 const void*       pUpper)              GBL_NOEXCEPT; //positions cursor on first entry in [lower, upper]
+
 GBL_EXPORT GblBool      GblTreeSet_erase        (GBL_SELF,  const void* pKey)           GBL_NOEXCEPT;
 GBL_EXPORT void*        GblTreeSet_extract      (GBL_SELF,  const void* pKey)           GBL_NOEXCEPT;
+GBL_EXPORT size_t       GblTreeSet_eraseRange   (GBL_SELF,
+                                                 const void* pLower,
+                                                 const void* pUpper)                    GBL_NOEXCEPT; //deletes entries within [lower, upper], returns #
 GBL_EXPORT void         GblTreeSet_clear        (GBL_SELF)                              GBL_NOEXCEPT;
 
+GBL_EXPORT void*        GblTreeSetCursor_entry  (const GblTreeSetCursor* pSelf)         GBL_NOEXCEPT; //NULL once past the range
+GBL_EXPORT GblBool      GblTreeSetCursor_valid  (const GblTreeSetCursor* pSelf)         GBL_NOEXCEPT;
+GBL_EXPORT void*        GblTreeSetCursor_next   (GblTreeSetCursor* pSelf)               GBL_NOEXCEPT; //advances, returns new entry
+GBL_EXPORT void*        GblTreeSetCursor_span   (GblTreeSetCursor* pSelf,
+                                                 size_t*           pCount)              GBL_NOEXCEPT; //returns contiguous run of entries, advances past it
+
 GBL_DECLS_END
 
 #undef GBL_SELF_TYPE
@@ -24,9 +24,11 @@ GBL_DECLS_BEGIN
 #define GBL_CTX_FRAME()         (GblThd_current()->pStackFrameTop)
 #define GBL_CTX_CONTEXT()       GBL_CTX_FRAME()->pContext
 #define GBL_CTX_OBJECT()        GBL_CTX_FRAME()->pObject
-#define GBL_CTX_RECORD()        (GBL_CTX_FRAME_NAME)->record
-#define GBL_CTX_RESULT()        (GBL_CTX_FRAME_NAME)->record.result
-#define GBL_CTX_SOURCE()        (GBL_CTX_FRAME_NAME)->record.srcLocation
+#define GBL_CTX_RECORD()        (*GblStackFrame_record(GBL_CTX_FRAME_NAME,                                   \
+                                                       (GBL_CTX_FRAME_NAME)->pRecord? GBL_NULL :           \
+                                                       (GblCallRecord*)GBL_ALLOCA(sizeof(GblCallRecord))))
+#define GBL_CTX_RESULT()        (GBL_CTX_FRAME_NAME)->result
+#define GBL_CTX_SOURCE()        (GBL_CTX_FRAME_NAME)->srcLocation
 #define GBL_CTX_LAST_RECORD()   (GblThd_current()->callRecord)
 #define GBL_CTX_LAST_RESULT()   (GBL_CTX_LAST_RECORD().result)
 
@@ -231,9 +233,13 @@ GBL_MAYBE_UNUSED GBL_INLINE GBL_RESULT GBL_ERRNO_RESULT(int ernum) {
 
 // ============== GBL EXT USERMETHODS ==========
 
+// Leaf frames only look up their context once something needs it
+#define GBL_CTX_EXT_CONTEXT_()                                                  \
+    GblStackFrame_context(GBL_CTX_FRAME_NAME)
+
 #define GBL_CTX_EXT(prefix, ...)                                                \
     GBL_STMT_START {                                                            \
-        const GBL_RESULT localResult = GblContext_##prefix(GBL_CTX_CONTEXT(),   \
+        const GBL_RESULT localResult = GblContext_##prefix(GBL_CTX_EXT_CONTEXT_(), \
                                                            GBL_CTX_FRAME_NAME,  \
                                                            ##__VA_ARGS__);      \
         GBL_ASSERT(!(GBL_CONFIG_ASSERT_ERROR_ENABLED &&                         \
@@ -322,7 +328,7 @@ GBL_MAYBE_UNUSED GBL_CTX_INLINE(REALLOC, void*, void* pData, size_t  newSize, si
         GblThd_logPush(NULL);                                       \
         GBL_CTX_EXT(logPush_);                                      \
         GBL_CTX_SOURCE_POP();                                       \
-        ++GBL_CTX_FRAME()->stackDepth;                              \
+        ++GBL_CTX_FRAME_NAME->stackDepth;                           \
     } GBL_STMT_END
 
 #define GBL_CTX_PUSH()                                                              \
@@ -346,7 +352,7 @@ GBL_MAYBE_UNUSED GBL_CTX_INLINE(REALLOC, void*, void* pData, size_t  newSize, si
 #define GBL_CTX_POP_2(srcLoc, count)                                    \
         GblThd_logPop(NULL, count);                                  \
         GBL_CTX_SOURCE_SCOPED(GBL_CTX_EXT, srcLoc, logPop_, count);     \
-        GBL_CTX_FRAME()->stackDepth -= count;
+        GBL_CTX_FRAME_NAME->stackDepth -= count;
 
 #define GBL_CTX_POP_1(srcLoc) \
     GBL_CTX_POP_2(srcLoc, 1)
@@ -473,7 +479,7 @@ GBL_MAYBE_UNUSED GBL_CTX_INLINE(LOG, GBL_RESULT, GblFlags level, const char* pFm
 #define GBL_CTX_RECORD_LAST_RECORD_(prefix, record)                                     \
     GBL_STMT_START {                                                                    \
         if(GBL_RESULT_##prefix(record->result)) {                                       \
-            GblContext_callRecordSet_(GBL_CTX_CONTEXT(), GBL_CTX_FRAME_NAME, record);   \
+            GblContext_callRecordSet_(GBL_CTX_EXT_CONTEXT_(), GBL_CTX_FRAME_NAME, record); \
             GblThd_setCallRecord(NULL, record);                                      \
         }                                                                               \
     } GBL_STMT_END
@@ -505,8 +511,11 @@ GBL_MAYBE_UNUSED GBL_CTX_INLINE(LOG, GBL_RESULT, GblFlags level, const char* pFm
 #define GBL_CTX_RECORD_SET_N(file, func, line,  result, ...)                                \
     GBL_STMT_START {                                                                        \
         GBL_CTX_SOURCE_LOC_PUSH(GBL_SRC_LOC(GBL_SRC_FILE, GBL_SRC_FN, GBL_SRC_LN));         \
-        GblCallRecord_construct(&GBL_CTX_RECORD(), result, GBL_CTX_SOURCE(), __VA_ARGS__);  \
-        GBL_CTX_RECORD_HANDLER(&GBL_CTX_RECORD());                                          \
+        const GBL_RESULT     code_    = (result);                                           \
+        GblCallRecord* const pRecord_ = &GBL_CTX_RECORD();                                  \
+        GblCallRecord_construct(pRecord_, code_, GBL_CTX_SOURCE(), __VA_ARGS__);            \
+        GBL_CTX_RESULT() = code_;                                                           \
+        GBL_CTX_RECORD_HANDLER(pRecord_);                                                   \
         GBL_CTX_SOURCE_POP();                                                               \
     } GBL_STMT_END
 
@@ -575,11 +584,38 @@ GBL_MAYBE_UNUSED GBL_CTX_INLINE(LOG, GBL_RESULT, GblFlags level, const char* pFm
 
 #define GBL_CTX_END()               \
         GBL_CTX_END_BLOCK();        \
-        return GBL_CTX_FRAME_NAME->record.result
+        return GBL_CTX_FRAME_NAME->result
 
 #define GBL_CTX_END_EMPTY()         \
         GBL_LABEL_EMPTY(GBL_CTX_END_LABEL)
 
+/* Leaf frames, for hot functions which only need to propagate a GBL_RESULT.
+   The frame lives in the function's own stack and is never pushed onto the
+   thread's frame stack, so it costs no TLS access. Its context is only
+   looked up once allocating or logging needs it, resolving to the same one
+   GBL_CTX_BEGIN() would, and unlike GBL_CTX_BEGIN(), entering a leaf does
+   not clear the thread's pending call record. Disabling
+   GBL_CONFIG_CTX_LEAF_FRAMES turns them back into regular frames. */
+#if GBL_CONFIG_CTX_LEAF_FRAMES
+#   define GBL_CTX_BEGIN_LEAF(pObject)                                      \
+        GblStackFrame gblApiLeafFrame_;                                     \
+        GBL_CTX_FRAME_DECLARE = &gblApiLeafFrame_;                          \
+        GblStackFrame_constructLeaf(GBL_CTX_FRAME_NAME, (GblObject*)pObject)
+
+#   define GBL_CTX_END_LEAF_BLOCK()                                         \
+        goto GBL_CTX_END_LABEL;                                             \
+        GBL_LABEL_EMPTY(GBL_CTX_END_LABEL);                                 \
+            if(GBL_CTX_FRAME_NAME->stackDepth)                              \
+                GBL_CTX_POP(GBL_CTX_FRAME_NAME->stackDepth)
+#else
+#   define GBL_CTX_BEGIN_LEAF(pObject)  GBL_CTX_BEGIN(pObject)
+#   define GBL_CTX_END_LEAF_BLOCK()     GBL_CTX_END_BLOCK()
+#endif
+
+#define GBL_CTX_END_LEAF()          \
+        GBL_CTX_END_LEAF_BLOCK();   \
+        return GBL_CTX_FRAME_NAME->result
+
 #define GBL_CTX_BLOCK_6(file, func, line, hHandle, frame, block)       \
     GBL_CTX_BEGIN_FRAME(file, func, line, hHandle, frame);             \
     block;                                                             \
@@ -6,6 +6,14 @@
  *  managing custom logger types as well as the utility
  *  macros for actually using the log system.
  *
+ *  By default, every message is dispatched to every registered logger
+ *  synchronously, from the calling thread. For chatty, multithreaded
+ *  programs, GblLogger_startAsync() switches to a mode where each thread
+ *  only formats its message into its own lock-free ring buffer, while a
+ *  background thread drains all of the buffers in batches, dispatching
+ *  the messages to the registered loggers and flushing the output once per
+ *  batch rather than once per message.
+ *
  *  \todo
  *      - migrate away from GblThd and towards GblThread
  *      - Spam filter: deduplicate messages within a certain interval
@@ -79,6 +87,20 @@ GBL_DECLARE_FLAGS(GBL_LOG_FLAGS) {
     GBL_LOG_USER      = 0x40    //!< Denotess the first flag which can be used for arbitrary userdata
 };
 
+//! Policy for what to do when a thread's asynchronous log buffer is full
+GBL_DECLARE_ENUM(GBL_LOG_OVERFLOW) {
+    GBL_LOG_OVERFLOW_DROP,  //!< Discards the message, counting it in GblLogger_asyncDropped()
+    GBL_LOG_OVERFLOW_BLOCK  //!< Waits for the background thread to make room for the message
+};
+
+//! Configuration for asynchronous logging (see \ref GblLogger_startAsync())
+typedef struct GblLoggerAsyncConfig {
+    size_t           bufferSize;  //!< Bytes per thread buffer, rounded to a power of 2 (applies to newly logging threads)
+    uint32_t         flushMs;     //!< Longest a message may wait before being drained (0 waits for flush, full, or flushFlags)
+    GblFlags         flushFlags;  //!< Combination of GBL_LOG_FLAGS which wake the background thread immediately
+    GBL_LOG_OVERFLOW overflow;    //!< What to do when a thread's buffer is full
+} GblLoggerAsyncConfig;
+
 /*! \struct  GblLoggerClass
  *  \extends GblObjectClass
  *  \brief   GblClass vtable for GblLogger
@@ -168,6 +190,15 @@ GBL_EXPORT GBL_RESULT   GblLogger_writeVa          (const char*   pFile,
                                                     GBL_LOG_FLAGS flags,
                                                     const char*   pFmt,
                                                     va_list       varArgs)    GBL_NOEXCEPT;
+
+GBL_EXPORT GBL_RESULT   GblLogger_startAsync       (const GblLoggerAsyncConfig*
+                                                                pConfig/*=NULL*/) GBL_NOEXCEPT;
+
+GBL_EXPORT GBL_RESULT   GblLogger_stopAsync        (void)                     GBL_NOEXCEPT;
+GBL_EXPORT GblBool      GblLogger_isAsync          (void)                     GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT   GblLogger_flush            (void)                     GBL_NOEXCEPT;
+GBL_EXPORT size_t       GblLogger_asyncDropped     (void)                     GBL_NOEXCEPT;
+
 // ===== Instance Methods =====
 GBL_EXPORT GblLogger*   GblLogger_create           (GblType         derived,
                                                     size_t          allocSize,
@@ -205,6 +236,42 @@ GBL_DECLS_END
 
 #undef GBL_SELF_TYPE
 
+/*!
+    \fn GblLogger_startAsync(const GblLoggerAsyncConfig* pConfig)
+    \details
+        Switches the logging system into asynchronous mode, spawning a
+        background thread which drains per-thread message buffers. From then
+        on, GblLogger_write() only formats the message into the calling
+        thread's buffer, without locking or touching stdio. Messages keep
+        their per-thread order, but messages from different threads are only
+        ordered relative to one another per batch.
+    \note
+        Loggers receive the already-formatted message, so their pFnWrite()
+        is passed "%s" as its format string. The GblThd pointer they receive
+        may refer to a thread which has since exited.
+    \param pConfig configuration or NULL for defaults (4KB buffers, 100ms
+                   flush interval, immediate flush on errors, dropping when full)
+    \returns result code
+
+    \fn GblLogger_stopAsync(void)
+    \details
+        Returns the logging system to synchronous mode, waiting for any
+        messages in flight, draining all buffers, and joining the background
+        thread.
+    \returns result code
+
+    \fn GblLogger_flush(void)
+    \details
+        Blocks until every message that was buffered at the time of the call
+        has been dispatched to the registered loggers. Does nothing but flush
+        stdio when the logging system isn't asynchronous.
+    \returns result code
+
+    \fn GblLogger_asyncDropped(void)
+    \returns total number of messages discarded due to full buffers with
+              the GBL_LOG_OVERFLOW_DROP policy
+*/
+
 // Helper macro for GBL_LOG_XXX_PUSH
 #define GBL_LOG_MAKE_PUSH_(domain, level_macro, ...)    \
     GBL_STMT_START {                                    \
@@ -1,8 +1,27 @@
 /*! \file
- *  \brief GblMainLoop task scheduler priority queue
+ *  \brief GblMainLoop work-stealing task scheduler and event loop
  *  \ingroup core
- *  \todo
- *   - implement me
+ *
+ *  This file contains the API for GblMainLoop, which schedules GblTask
+ *  objects over a pool of worker threads while dispatching timers, idle
+ *  callbacks, and queued signal emissions on the thread running it.
+ *
+ *  Each worker owns one Chase-Lev deque per priority level. A worker
+ *  pushes and pops the tasks it spawns at the bottom of its own deques,
+ *  so related work stays hot in its cache, while idle workers steal
+ *  from the top of the others'. Tasks enqueued from any other thread
+ *  go into a shared injection queue. Higher priority levels are always
+ *  drained first, and the idle levels only run when nothing else is
+ *  queued.
+ *
+ *  A loop created without any workers runs its tasks on whichever
+ *  thread calls GblMainLoop_iteration(), GblMainLoop_exec(), or waits
+ *  on a task, which makes it a plain single-threaded event loop.
+ *
+ *  \note
+ *  While a task is queued, the loop holds a reference to it. Those
+ *  references are only released by threads outside of the worker pool:
+ *  the thread iterating the loop, or one waiting on its tasks.
  *
  *   \author    2023 Falco Girgis
  *   \copyright MIT License
@@ -13,7 +32,17 @@
 
 #include "../meta/instances/gimbal_object.h"
 #include "../meta/signals/gimbal_signal.h"
-#include "../containers/gimbal_linked_list.h"
+#include "gimbal_task.h"
+
+/*! \name Type System
+ *  \brief Type UUID and cast operators
+ *  @{
+ */
+#define GBL_MAIN_LOOP_TYPE              (GBL_TYPEID(GblMainLoop))            //!< Type UUID for GblMainLoop
+#define GBL_MAIN_LOOP(self)             (GBL_CAST(GblMainLoop, self))        //!< Function-style GblInstance cast
+#define GBL_MAIN_LOOP_CLASS(klass)      (GBL_CLASS_CAST(GblMainLoop, klass)) //!< Function-style GblClass cast
+#define GBL_MAIN_LOOP_GET_CLASS(self)   (GBL_CLASSOF(GblMainLoop, self))     //!< Get GblMainLoopClass from GblInstance
+//! @}
 
 #define GBL_SELF_TYPE GblMainLoop
 
@@ -22,67 +51,129 @@ GBL_DECLS_BEGIN
 GBL_FORWARD_DECLARE_STRUCT(GblTask);
 GBL_FORWARD_DECLARE_STRUCT(GblMainLoop);
 
-//! Enumeration for
+//! Callback type for timer and idle sources, returning GBL_FALSE removes the source
+typedef GblBool (*GblMainLoopFn)(GBL_SELF, void* pUserdata);
+
+//! Priority levels which a task's GblPriority is clamped to, from lowest to highest
 typedef enum GBL_PRIORITY_LEVEL {
-    GBL_PRIORITY_IDLE,
-    GBL_PRIORITY_HIGH_IDLE,
-    GBL_PRIORITY_LOW,
-    GBL_PRIORITY_DEFAULT,
-    GBL_PRIORITY_HIGH,
-    GBL_PRIORITY_COUNT
+    GBL_PRIORITY_IDLE,      //!< Only runs when nothing else is queued
+    GBL_PRIORITY_HIGH_IDLE, //!< Runs before GBL_PRIORITY_IDLE, when nothing else is queued
+    GBL_PRIORITY_LOW,       //!< Below default
+    GBL_PRIORITY_DEFAULT,   //!< Priority given to new tasks
+    GBL_PRIORITY_HIGH,      //!< Runs before everything else
+    GBL_PRIORITY_COUNT      //!< Number of priority levels
 } GBL_PRIORITY_LEVEL;
 
 /*! \struct  GblMainLoopClass
  *  \extends GblObjectClass
  *  \brief   GblClass VTable structure for GblMainLoop
  *
- *  WIP
+ *  pFnEnqueueTask and pFnCancelTask are invoked from the calling
+ *  thread, pFnExecTask from whichever thread picked the task up,
+ *  and pFnExecIdle from the thread iterating the loop.
  *
  *  \sa GblMainLoop
  */
 GBL_CLASS_DERIVE(GblMainLoop, GblObject)
+    //! Takes a reference to the task and schedules it once its prerequisites are done
     GBL_RESULT (*pFnEnqueueTask)(GBL_SELF, GblTask* pTask);
+    //! Runs a task which has been dequeued, default checks for cancellation and timeout before running it
     GBL_RESULT (*pFnExecTask)   (GBL_SELF, GblTask* pTask);
+    //! Cancels a task which belongs to the loop, default calls GblTask_cancel()
     GBL_RESULT (*pFnCancelTask) (GBL_SELF, GblTask* pTask);
+    //! Called when an iteration had nothing to do, default runs the idle sources and emits "execIdle"
     GBL_RESULT (*pFnExecIdle)   (GBL_SELF);
 GBL_CLASS_END
 
-// Needs a context with queue
 /*! \struct  GblMainLoop
  *  \extends GblObject
- *  \brief   Sequentially executing priority queue of GblTask objects
+ *  \ingroup core
+ *  \brief   Work-stealing task scheduler with timers and idle callbacks
  *
- *  WIP
+ *  No public members.
  *
- *  \sa GblMainLoopClass
+ *  \sa GblMainLoopClass, GblTask
  */
-GBL_INSTANCE_DERIVE(GblMainLoop, GblObject)
-    union {
-        GblTask*           pHead;
-        GblLinkedListNode  listNode;
-    }                  taskQueue[GBL_PRIORITY_COUNT];
-    size_t             taskCount;
-    uint32_t           taskBitMap;
-    GblTask*           pActiveTask;
-    GBL_PRIORITY_LEVEL prevTaskPriority;
-GBL_INSTANCE_END
+GBL_INSTANCE_DERIVE_EMPTY(GblMainLoop, GblObject);
+
+//! \cond
+GBL_PROPERTIES(GblMainLoop,
+    (workerCount, GBL_GENERIC, (READ, CONSTRUCT), GBL_SIZE_TYPE),
+    (depth,       GBL_GENERIC, (READ           ), GBL_SIZE_TYPE),
+    (running,     GBL_GENERIC, (READ           ), GBL_BOOL_TYPE)
+)
 
 GBL_SIGNALS(GblMainLoop,
-    (execIdle,     GBL_INSTANCE_TYPE),
-    (taskEnqueued, GBL_INSTANCE_TYPE, GBL_INSTANCE_TYPE)
+    (execIdle,     (GBL_INSTANCE_TYPE, pReceiver)),
+    (taskEnqueued, (GBL_INSTANCE_TYPE, pReceiver), (GBL_POINTER_TYPE, pTask))
 )
+//! \endcond
+
+//! Returns the GblType UUID associated with GblMainLoop
+GBL_EXPORT GblType      GblMainLoop_type        (void)                      GBL_NOEXCEPT;
+
+/*! \name  Lifetime
+ *  \brief Methods for creating and destroying a loop
+ *  \relatesalso GblMainLoop
+ *  @{
+ */
+//! Creates a loop with \p workerCount worker threads, or none, running everything on the loop's own thread
+GBL_EXPORT GblMainLoop* GblMainLoop_create      (size_t workerCount)        GBL_NOEXCEPT;
+//! Returns a new reference to an existing loop, incrementing its reference count by 1
+GBL_EXPORT GblMainLoop* GblMainLoop_ref         (GBL_CSELF)                 GBL_NOEXCEPT;
+//! Decrements the reference count of a loop, stopping its workers and destroying it if it's the last one
+GBL_EXPORT GblRefCount  GblMainLoop_unref       (GBL_SELF)                  GBL_NOEXCEPT;
+//! @}
 
-GBL_EXPORT GblType    GblMainLoop_type    (void) GBL_NOEXCEPT;
+/*! \name  Tasks
+ *  \brief Methods for scheduling and waiting on GblTask instances
+ *  \relatesalso GblMainLoop
+ *  @{
+ */
+//! Schedules \p pTask to be executed by the loop, once everything it was chained after is done
+GBL_EXPORT GBL_RESULT   GblMainLoop_enqueue     (GBL_SELF, GblTask* pTask)  GBL_NOEXCEPT;
+//! Cancels \p pTask, which must have been enqueued on the given loop
+GBL_EXPORT GBL_RESULT   GblMainLoop_cancel      (GBL_SELF, GblTask* pTask)  GBL_NOEXCEPT;
+//! Blocks until every task enqueued on the loop is done, helping to execute them in the meantime
+GBL_EXPORT GBL_RESULT   GblMainLoop_waitAll     (GBL_SELF)                  GBL_NOEXCEPT;
+//! Returns the number of enqueued tasks which are not yet done
+GBL_EXPORT size_t       GblMainLoop_depth       (GBL_CSELF)                 GBL_NOEXCEPT;
+//! Returns the number of worker threads owned by the loop
+GBL_EXPORT size_t       GblMainLoop_workerCount (GBL_CSELF)                 GBL_NOEXCEPT;
+//! @}
 
-GBL_EXPORT GBL_RESULT GblMainLoop_enqueue (GBL_SELF, GblTask* pTask) GBL_NOEXCEPT;
-GBL_EXPORT GBL_RESULT GblMainLoop_cancel  (GBL_SELF, GblTask* pTask) GBL_NOEXCEPT;
-GBL_EXPORT GblTask*   GblMainLoop_top     (GBL_CSELF)                GBL_NOEXCEPT;
-GBL_EXPORT size_t     GblMainLoop_depth   (GBL_CSELF)                GBL_NOEXCEPT;
+/*! \name  Sources
+ *  \brief Methods for adding timer and idle callbacks
+ *  \relatesalso GblMainLoop
+ *  @{
+ */
+//! Calls \p pFn every \p msec milliseconds from the thread iterating the loop, returning an ID for the source, or 0
+GBL_EXPORT size_t       GblMainLoop_addTimer    (GBL_SELF,
+                                                 uint32_t      msec,
+                                                 GblMainLoopFn pFn,
+                                                 void*         pUserdata)   GBL_NOEXCEPT;
+//! Calls \p pFn from the thread iterating the loop whenever it has nothing else to do, returning an ID for the source, or 0
+GBL_EXPORT size_t       GblMainLoop_addIdle     (GBL_SELF,
+                                                 GblMainLoopFn pFn,
+                                                 void*         pUserdata)   GBL_NOEXCEPT;
+//! Removes the timer or idle source with the given \p id, returning GBL_FALSE if there was none
+GBL_EXPORT GblBool      GblMainLoop_removeSource(GBL_SELF, size_t id)       GBL_NOEXCEPT;
+//! @}
 
-GBL_EXPORT GBL_RESULT GblMainLoop_iteration (GBL_SELF)  GBL_NOEXCEPT;
-GBL_EXPORT GBL_RESULT GblMainLoop_exec      (GBL_SELF)  GBL_NOEXCEPT;
-GBL_EXPORT GBL_RESULT GblMainLoop_stop      (GBL_SELF)  GBL_NOEXCEPT;
-GBL_EXPORT GblBool    GblMainLoop_isRunning (GBL_CSELF) GBL_NOEXCEPT;
+/*! \name  Execution
+ *  \brief Methods for driving the loop from its own thread
+ *  \relatesalso GblMainLoop
+ *  @{
+ */
+//! Runs one non-blocking pass over the loop's timers, queued events, tasks (without workers), and idle sources
+GBL_EXPORT GBL_RESULT   GblMainLoop_iteration   (GBL_SELF)                  GBL_NOEXCEPT;
+//! Iterates the loop until GblMainLoop_stop() is called, sleeping whenever there is nothing to do
+GBL_EXPORT GBL_RESULT   GblMainLoop_exec        (GBL_SELF)                  GBL_NOEXCEPT;
+//! Makes GblMainLoop_exec() return after its current iteration, may be called from any thread
+GBL_EXPORT GBL_RESULT   GblMainLoop_stop        (GBL_SELF)                  GBL_NOEXCEPT;
+//! Returns GBL_TRUE if GblMainLoop_exec() is currently running the loop
+GBL_EXPORT GblBool      GblMainLoop_isRunning   (GBL_CSELF)                 GBL_NOEXCEPT;
+//! @}
 
 GBL_DECLS_END
 
@@ -35,11 +35,19 @@ typedef struct GblCallRecord {
     GBL_RESULT        result;
 } GblCallRecord;
 
-//! Represents a single function's stack frame, from GBL_CTX_BEGIN() to GBL_CTX_END()
+/*! Represents a single function's stack frame, from GBL_CTX_BEGIN() to GBL_CTX_END()
+ *
+ *  A frame starts out as a small header holding only the current result
+ *  and source location. The full GblCallRecord, with its message buffer,
+ *  is only materialized on the stack (see GBL_CTX_RECORD()) once a record
+ *  is actually set, typically upon an error or warning.
+ */
 typedef struct GblStackFrame {
     GBL_ALIGNAS(8)
-    GblCallRecord         record;
+    GBL_RESULT            result;       //!< Result code accumulated by the frame
     uint32_t              sourceCurrentCaptureDepth;
+    GblSourceLocation     srcLocation;  //!< Outermost captured source location
+    GblCallRecord*        pRecord;      //!< Full record, NULL until one has been set
     GblObject*            pObject;
     GblContext*           pContext;
     uint32_t              stackDepth;
@@ -56,6 +64,16 @@ GBL_INLINE GBL_RESULT GblStackFrame_construct (GblStackFrame* pFrame,
                                                GblObject*     pObject,
                                                GBL_RESULT     initialResult) GBL_NOEXCEPT;
 
+GBL_INLINE void       GblStackFrame_constructLeaf
+                                              (GblStackFrame* pFrame,
+                                               GblObject*     pObject)       GBL_NOEXCEPT;
+
+GBL_INLINE GblContext* GblStackFrame_context  (GblStackFrame* pFrame)      GBL_NOEXCEPT;
+
+GBL_INLINE GblCallRecord*
+                      GblStackFrame_record    (GblStackFrame* pFrame,
+                                               GblCallRecord* pStorage)      GBL_NOEXCEPT;
+
 // ===== Implementation =====
 ///\cond
 GBL_FORWARD_DECLARE_STRUCT(GblThd);
@@ -114,8 +132,7 @@ GBL_INLINE void GblCallRecord_construct(GblCallRecord* pRecord, GBL_RESULT resul
     pRecord->result         = resultCode;
 }
 
-GBL_INLINE GBL_RESULT GblStackFrame_construct(GblStackFrame* pFrame, GblObject* pObject, GBL_RESULT initialResult) GBL_NOEXCEPT {
-    GBL_RESULT result               = GBL_RESULT_SUCCESS;
+GBL_INLINE GblContext* GblStackFrame_findContext_(GblObject* pObject) GBL_NOEXCEPT {
     GblContext* pContext            = GBL_NULL;
 
     if GBL_UNLIKELY(pObject) {
@@ -131,9 +148,17 @@ GBL_INLINE GBL_RESULT GblStackFrame_construct(GblStackFrame* pFrame, GblObject*
         pContext = GblThd_context(NULL);
     }
 
-    pFrame->record.srcLocation.pFile    = GBL_NULL;
-    pFrame->record.srcLocation.pFunc    = GBL_NULL;
-    pFrame->record.result               = initialResult;
+    return pContext;
+}
+
+GBL_INLINE GBL_RESULT GblStackFrame_construct(GblStackFrame* pFrame, GblObject* pObject, GBL_RESULT initialResult) GBL_NOEXCEPT {
+    GBL_RESULT result               = GBL_RESULT_SUCCESS;
+    GblContext* pContext            = GblStackFrame_findContext_(pObject);
+
+    pFrame->srcLocation.pFile           = GBL_NULL;
+    pFrame->srcLocation.pFunc           = GBL_NULL;
+    pFrame->result                      = initialResult;
+    pFrame->pRecord                     = GBL_NULL;
     pFrame->stackDepth                  = 0;
     pFrame->sourceCurrentCaptureDepth   = 0;
     pFrame->pObject                     = pObject;
@@ -142,6 +167,39 @@ GBL_INLINE GBL_RESULT GblStackFrame_construct(GblStackFrame* pFrame, GblObject*
     return result;
 }
 
+// Leaf frames defer context lookup until it's needed and are never pushed onto the thread's stack
+GBL_INLINE void GblStackFrame_constructLeaf(GblStackFrame* pFrame, GblObject* pObject) GBL_NOEXCEPT {
+    pFrame->result                      = GBL_RESULT_SUCCESS;
+    pFrame->sourceCurrentCaptureDepth   = 0;
+    pFrame->srcLocation.pFile           = GBL_NULL;
+    pFrame->srcLocation.pFunc           = GBL_NULL;
+    pFrame->pRecord                     = GBL_NULL;
+    pFrame->pObject                     = pObject;
+    pFrame->pContext                    = GBL_NULL;
+    pFrame->stackDepth                  = 0;
+    pFrame->pPrevFrame                  = GBL_NULL;
+}
+
+// Returns the frame's context, resolving a leaf frame's the same way a regular frame's is upon first use
+GBL_INLINE GblContext* GblStackFrame_context(GblStackFrame* pFrame) GBL_NOEXCEPT {
+    if GBL_UNLIKELY(!pFrame->pContext)
+        pFrame->pContext = GblStackFrame_findContext_(pFrame->pObject);
+
+    return pFrame->pContext;
+}
+
+// Materializes the frame's record into pStorage if it has none, then syncs it with the header
+GBL_INLINE GblCallRecord* GblStackFrame_record(GblStackFrame* pFrame, GblCallRecord* pStorage) GBL_NOEXCEPT {
+    if GBL_UNLIKELY(!pFrame->pRecord) {
+        pFrame->pRecord             = pStorage;
+        pFrame->pRecord->message[0] = '\0';
+    }
+
+    pFrame->pRecord->result      = pFrame->result;
+    pFrame->pRecord->srcLocation = pFrame->srcLocation;
+    return pFrame->pRecord;
+}
+
 GBL_DECLS_END
 
 #endif // GIMBAL_CALL_STACK_H
@@ -2,16 +2,46 @@
  *  \brief GblTask high-level concurrent runnable object
  *  \ingroup core
  *
- *  \todo
- *   - implement me (designing API currently, unimplemented)
+ *  This file contains the API for GblTask, a unit of work which is
+ *  scheduled and executed by a GblMainLoop, either on one of its
+ *  worker threads or on the thread driving the loop itself.
  *
- *   \author Falco Girgis
+ *  A task has a life cycle which only ever moves forward:
+ *
+ *      PENDING -> QUEUED -> RUNNING -> FINISHED
+ *         |          |          |
+ *         +----------+----------+---> CANCELED
+ *                    |
+ *                    +--------------> TIMED_OUT
+ *
+ *  A task stays PENDING until it has been enqueued and all of the
+ *  tasks it was chained after with GblTask_then() have completed.
+ *  Should any of those not finish successfully, it is canceled rather
+ *  than being run.
+ *
+ *  \note
+ *  A task can only be scheduled once. Create a new task to run the same
+ *  work again.
+ *
+ *   \author    2023 Falco Girgis
+ *   \copyright MIT License
  */
 
 #ifndef GIMBAL_TASK_H
 #define GIMBAL_TASK_H
 
 #include "../meta/instances/gimbal_object.h"
+#include "../meta/signals/gimbal_signal.h"
+
+/*! \name Type System
+ *  \brief Type UUID and cast operators
+ *  @{
+ */
+#define GBL_TASK_TYPE               (GBL_TYPEID(GblTask))             //!< Type UUID for GblTask
+#define GBL_TASK(self)              (GBL_CAST(GblTask, self))         //!< Function-style GblInstance cast
+#define GBL_TASK_CLASS(klass)       (GBL_CLASS_CAST(GblTask, klass))  //!< Function-style GblClass cast
+#define GBL_TASK_GET_CLASS(self)    (GBL_CLASSOF(GblTask, self))      //!< Get GblTaskClass from GblInstance
+//! @}
 
 #define GBL_SELF_TYPE GblTask
 
@@ -20,42 +50,130 @@ GBL_DECLS_BEGIN
 GBL_FORWARD_DECLARE_STRUCT(GblMainLoop);
 GBL_FORWARD_DECLARE_STRUCT(GblTask);
 
+//! Scheduling priority of a GblTask, see GBL_PRIORITY_LEVEL for the range
 typedef int8_t GblPriority;
 
+//! Function callback type to be used as a task's work with \ref GblTask_create()
+typedef GBL_RESULT (*GblTaskFn)(GBL_SELF);
+
+//! Lifetime states for a GblTask
+GBL_DECLARE_ENUM(GBL_TASK_STATE) {
+    GBL_TASK_STATE_PENDING,     //!< Not yet enqueued, or waiting on prerequisites
+    GBL_TASK_STATE_QUEUED,      //!< Ready and waiting to be picked up by a thread
+    GBL_TASK_STATE_RUNNING,     //!< Currently executing
+    GBL_TASK_STATE_FINISHED,    //!< Ran to completion
+    GBL_TASK_STATE_CANCELED,    //!< Canceled, either directly or by a failed prerequisite
+    GBL_TASK_STATE_TIMED_OUT    //!< Did not start before its timeout elapsed
+};
+
 /*! \struct  GblTaskClass
  *  \extends GblObjectClass
  *  \brief   GblClass structure for GblTask
  *
- *  GblTaskClass provides overridadlbe virtual
+ *  GblTaskClass provides overridable virtual
  *  methods for invoking custom logic based on
  *  different types of scheduling events, as well
  *  as a method for getting the priority for a
  *  GblTask.
  *
+ *  \note
+ *  pFnCancel is invoked from whichever thread canceled
+ *  the task, while pFnExec and pFnTimeout are invoked
+ *  from the thread executing it.
+ *
  *  \sa GblTask
  */
 GBL_CLASS_DERIVE(GblTask, GblObject)
+    //! Performs the actual work, default calls the task's callback
     GBL_RESULT (*pFnExec)    (GBL_SELF);
+    //! Notifies the task that it has been canceled, default does nothing
     GBL_RESULT (*pFnCancel)  (GBL_SELF);
+    //! Notifies the task that it timed out without running, default does nothing
     GBL_RESULT (*pFnTimeout) (GBL_SELF);
+    //! Returns the scheduling priority of the task, default returns what was set with GblTask_setPriority()
     GBL_RESULT (*pFnPriority)(GBL_CSELF, GblPriority* pPriority);
 GBL_CLASS_END
 
 /*! \struct  GblTask
  *  \extends GblObject
+ *  \ingroup core
  *  \brief   High-level schedulable concurrently-executing operation
  *
  *  No public members.
  *
- *  \sa GblTaskClass
+ *  \sa GblTaskClass, GblMainLoop
  */
 GBL_INSTANCE_DERIVE_EMPTY(GblTask, GblObject);
 
-GBL_EXPORT GblPriority GblTask_priority(GBL_CSELF) GBL_NOEXCEPT;
+//! \cond
+GBL_PROPERTIES(GblTask,
+    (state,    GBL_GENERIC, (READ       ), GBL_ENUM_TYPE),
+    (result,   GBL_GENERIC, (READ       ), GBL_ENUM_TYPE),
+    (priority, GBL_GENERIC, (READ, WRITE), GBL_INT16_TYPE),
+    (timeout,  GBL_GENERIC, (READ, WRITE), GBL_UINT32_TYPE),
+    (callback, GBL_GENERIC, (READ, WRITE), GBL_FUNCTION_TYPE)
+)
+//! \endcond
+
+//! Returns the GblType UUID associated with GblTask
+GBL_EXPORT GblType     GblTask_type        (void)                          GBL_NOEXCEPT;
+//! Returns the task which is currently executing on the calling thread, or NULL if there isn't one
+GBL_EXPORT GblTask*    GblTask_current     (void)                          GBL_NOEXCEPT;
+
+//! Creates a GblTask instance which will run \p pCallback, with \p pUserdata as its userdata
+GBL_EXPORT GblTask*    GblTask_create      (GblTaskFn pCallback,
+                                            void*     pUserdata/*=NULL*/)  GBL_NOEXCEPT;
+//! Returns a new reference to an existing task, incrementing its reference count by 1
+GBL_EXPORT GblTask*    GblTask_ref         (GBL_CSELF)                     GBL_NOEXCEPT;
+//! Decrements the reference count of a GblTask instance, deleting it if it's the last one
+GBL_EXPORT GblRefCount GblTask_unref       (GBL_SELF)                      GBL_NOEXCEPT;
 
+//! Returns the C callback function assigned to the given task, or NULL if there isn't one
+GBL_EXPORT GblTaskFn   GblTask_callback    (GBL_CSELF)                     GBL_NOEXCEPT;
+//! Assigns the C callback function of the given task to \p pCb, which will be executed by the default pFnExec
+GBL_EXPORT void        GblTask_setCallback (GBL_SELF, GblTaskFn pCb)       GBL_NOEXCEPT;
+//! Returns the scheduling priority of the given task, as reported by GblTaskClass::pFnPriority
+GBL_EXPORT GblPriority GblTask_priority    (GBL_CSELF)                     GBL_NOEXCEPT;
+//! Sets the priority returned by the default GblTaskClass::pFnPriority, which only matters before the task is queued
+GBL_EXPORT void        GblTask_setPriority (GBL_SELF, GblPriority priority) GBL_NOEXCEPT;
+//! Returns the number of milliseconds the given task may wait to start after being enqueued, or 0 for no timeout
+GBL_EXPORT uint32_t    GblTask_timeout     (GBL_CSELF)                     GBL_NOEXCEPT;
+//! Sets the number of milliseconds the given task may wait to start after being enqueued, with 0 disabling its timeout
+GBL_EXPORT GBL_RESULT  GblTask_setTimeout  (GBL_SELF, uint32_t msec)       GBL_NOEXCEPT;
+
+//! Returns the current state of the given task
+GBL_EXPORT GBL_TASK_STATE GblTask_state    (GBL_CSELF)                     GBL_NOEXCEPT;
+//! Returns the result code returned by the given task's pFnExec, or GBL_RESULT_UNKNOWN if it hasn't run
+GBL_EXPORT GBL_RESULT  GblTask_result      (GBL_CSELF)                     GBL_NOEXCEPT;
+//! Returns GBL_TRUE if the given task has reached a terminal state: finished, canceled, or timed out
+GBL_EXPORT GblBool     GblTask_isDone      (GBL_CSELF)                     GBL_NOEXCEPT;
+//! Returns GBL_TRUE if cancellation has been requested, which running tasks may poll to bail out early
+GBL_EXPORT GblBool     GblTask_isCanceled  (GBL_CSELF)                     GBL_NOEXCEPT;
+
+//! Chains \p pContinuation to run after the given task, which has to be called before \p pContinuation is enqueued
+GBL_EXPORT GBL_RESULT  GblTask_then        (GBL_SELF, GblTask* pContinuation) GBL_NOEXCEPT;
+//! Cancels the given task, preventing it from running if it hasn't started, or flagging it if it has
+GBL_EXPORT GBL_RESULT  GblTask_cancel      (GBL_SELF)                      GBL_NOEXCEPT;
+/*! Blocks until the given (enqueued) task is done, helping to execute other tasks in the meantime
+ *
+ *  Since waiting from within a task, including on a loop's worker thread,
+ *  runs other queued tasks rather than idling, a saturated pool keeps
+ *  making progress. Waiting on a task which the calling thread has
+ *  suspended to help out fails with GBL_RESULT_ERROR_INVALID_OPERATION,
+ *  rather than deadlocking.
+ */
+GBL_EXPORT GBL_RESULT  GblTask_wait        (GBL_SELF)                      GBL_NOEXCEPT;
+
+//! Provides default argument handling for GblTask_create()
+#define GblTask_create(...) GBL_VA_OVERLOAD_CALL_ARGC(GblTask_create_, __VA_ARGS__)
 
 GBL_DECLS_END
 
+///\cond
+#define GblTask_create__2(cb, ud)   ((GblTask_create)(cb, ud))
+#define GblTask_create__1(cb)       (GblTask_create__2(cb, GBL_NULL))
+///\endcond
+
 #undef GBL_SELF_TYPE
 
 #endif // GIMBAL_TASK_H
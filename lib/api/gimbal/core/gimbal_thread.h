@@ -175,6 +175,8 @@ GBL_EXPORT GBL_RESULT  GblThread_setAffinity (GBL_SELF,
 GBL_EXPORT GBL_RESULT  GblThread_start       (GBL_SELF)                       GBL_NOEXCEPT;
 //! Blocks execution of the current thread, awaiting the completion of the given thread
 GBL_EXPORT GBL_RESULT  GblThread_join        (GBL_SELF)                       GBL_NOEXCEPT;
+//! Returns the number of queued events which have been posted to the given thread but not yet processed
+GBL_EXPORT size_t      GblThread_pendingEvents (GBL_CSELF)                    GBL_NOEXCEPT;
 //! Performs a non-blocking wait on the given thread, spinning on a timeout
 GBL_EXPORT GBL_RESULT  GblThread_spinWait    (GBL_SELF/*,
                                               const GblTimeSpec* pTimeout*/)  GBL_NOEXCEPT;
@@ -192,6 +194,8 @@ GBL_EXPORT GBL_RESULT GblThread_yield     (void)                          GBL_NO
 //! Sleeps the current thread for \p nsec nanoseconds, returning the remaining time optionally within \p pRemainder
 GBL_EXPORT GBL_RESULT GblThread_nanoSleep (uint64_t  nsec,
                                            uint64_t* pRemainder/*=NULL*/) GBL_NOEXCEPT;
+//! Delivers up to \p maxEvents (or all, if 0) queued signal emissions posted to the current thread, returning how many were delivered
+GBL_EXPORT size_t     GblThread_processEvents (size_t maxEvents)          GBL_NOEXCEPT;
 //! Ends execution of the currently executing thread, returning \p result and storing the given source context
 GBL_EXPORT GBL_RESULT GblThread_exit      (GBL_RESULT  result,
                                            const char* pMessage/*=NULL*/,
@@ -11,6 +11,7 @@
 #include "allocators/gimbal_arena_allocator.h"
 #include "allocators/gimbal_pool_allocator.h"
 #include "allocators/gimbal_scope_allocator.h"
+#include "allocators/gimbal_slab_allocator.h"
 
 /*! \defgroup allocators Allocators
  * 	\brief    Collection of specialized polymorphic custom allocators
@@ -13,6 +13,7 @@
 #include "containers/gimbal_array_heap.h"
 #include "containers/gimbal_array_list.h"
 #include "containers/gimbal_array_map.h"
+#include "containers/gimbal_concurrent_hash_set.h"
 #include "containers/gimbal_doubly_linked_list.h"
 #include "containers/gimbal_hash_set.h"
 #include "containers/gimbal_linked_list.h"
@@ -46,6 +47,7 @@
         GblArrayDeque		   |Dynamically resizable array with good performance when resizing from either end   | gimbal_array_deque.h
         GblTreeSet             |Binary tree-based associative set structure, analogous to std::set		          | gimbal_tree_set.h
         GblHashSet	           |Hash table-based associative set structure, analogous to std::unordered_set       | gimbal_hash_set.h
+        GblConcurrentHashSet   |Thread-safe, lock-striped hash set which mirrors the GblHashSet API               | gimbal_concurrent_hash_set.h
         GblArrayMap		       |Resizable array-based, [K,V] container with optional binary searchability         | gimbal_array_map.h
         GblArrayHeap           |Dynamic array-based, binary heap structure providing a priority queue API         | gimbal_array_heap.h
         GblRingBuffer          |Fixed-capacity circular buffer backed by a contiguous array with queue semantics  | gimbal_ring_buffer.h
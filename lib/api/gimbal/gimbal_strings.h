@@ -13,6 +13,7 @@
 #define GIMBAL_STRINGS_H
 
 #include "strings/gimbal_pattern.h"
+#include "strings/gimbal_pattern_set.h"
 #include "strings/gimbal_quark.h"
 #include "strings/gimbal_string.h"
 #include "strings/gimbal_string_buffer.h"
@@ -47,6 +48,7 @@
     ::GblQuark      | Hashing or uniquely identifying                      | gimbal_quark.h
     GblStringList   | Storing or operating on multiple strings             | gimbal_string_list.h
     GblPattern      | Searching or applying regular expressions to strings | gimbal_pattern.h
+    GblPatternSet   | Classifying strings against many regular expressions | gimbal_pattern_set.h
 */
 
 
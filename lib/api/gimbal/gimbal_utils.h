@@ -21,6 +21,7 @@
 #include "utils/gimbal_date_time.h"
 #include "utils/gimbal_bit_view.h"
 #include "utils/gimbal_byte_array.h"
+#include "utils/gimbal_byte_chain.h"
 #include "utils/gimbal_scanner.h"
 #include "utils/gimbal_uri.h"
 #include "utils/gimbal_settings.h"
@@ -38,7 +39,7 @@
     - Command-line argument and option parsing
     - User settings management
     - URI decoding
-    - Byte array and bit view containers
+    - Byte array, byte chain, and bit view containers
 */
 
 #endif // GIMBAL_UTILS_H
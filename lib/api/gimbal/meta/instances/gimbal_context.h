@@ -54,6 +54,7 @@ GBL_INSTANCE_DERIVE(GblContext, GblObject)
     GblCallRecord   lastIssue;
     uint32_t        logStackDepth;
     GblFlags        logFilter;
+    GblIAllocator*  pAllocator;
 GBL_INSTANCE_END
 
 GBL_PROPERTIES(GblContext,
@@ -79,6 +80,12 @@ GBL_EXPORT GblContext* GblContext_parentContext    (GBL_CSELF)
 GBL_EXPORT void        GblContext_setLogFilter     (GBL_SELF, GblFlags mask)               GBL_NOEXCEPT;
 GBL_EXPORT void        GblContext_logBuildInfo     (GBL_CSELF)                             GBL_NOEXCEPT;
 
+//! Returns the allocator which has been plugged into the given context, or NULL if it uses the default
+GBL_EXPORT GblIAllocator*
+                       GblContext_allocator        (GBL_CSELF)                             GBL_NOEXCEPT;
+//! Routes every allocation made through the given context to \p pAllocator, or back to the default with NULL
+GBL_EXPORT void        GblContext_setAllocator     (GBL_SELF, GblIAllocator* pAllocator)   GBL_NOEXCEPT;
+
 GBL_DECLS_END
 
 #undef GBL_SELF_TYPE
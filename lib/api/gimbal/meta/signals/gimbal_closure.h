@@ -133,6 +133,14 @@ GBL_EXPORT GBL_RESULT GblClosure_invoke (GBL_SELF,
                                          GblVariant* pRetValue,
                                          size_t      argCount,
                                          GblVariant* pArgValues) GBL_NOEXCEPT;
+//! Invokes the given GblClosure with args read straight from a va_list by \p pFnVaMarshal, bypassing its regular and meta marshals
+GBL_EXPORT GBL_RESULT GblClosure_invokeVa (GBL_SELF,
+                                           GblMarshalVaFn pFnVaMarshal,
+                                           GblVariant*    pRetValue,
+                                           void*          pInstance,
+                                           va_list*       pArgs,
+                                           size_t         argCount,
+                                           const GblType* pParamTypes) GBL_NOEXCEPT;
 //! @}
 
 GBL_DECLS_END
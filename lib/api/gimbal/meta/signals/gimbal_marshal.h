@@ -53,7 +53,16 @@ typedef GBL_RESULT (*GblMarshalFn)  (GblClosure* pClosure,
                                      GblVariant* pArgs,
                                      GblPtr      pMarshalData);
 
-//! Unimplemented, but mirror of GblMarshalFn using a va_list to hold args instead of GblVariant
+/*! Mirror of GblMarshalFn using a va_list to hold args instead of GblVariant
+ *  \ingroup signals
+ *
+ *  Reads its arguments straight out of a va_list, using the default
+ *  argument promotions, rather than from an array of GblVariants, and
+ *  invokes its callback directly. \p pMarshalData optionally overrides
+ *  the GblCClosure's callback.
+ *
+ *  \sa GblMarshal_CClosureVa()
+ */
 typedef GBL_RESULT (*GblMarshalVaFn)(GblClosure*    pClosure,
                                      GblVariant*    pRetValue,
                                      void*          pInstance,
@@ -119,6 +128,17 @@ GBL_DECL_CCLOSURE_MARSHAL_VOID__(INSTANCE_INSTANCE_SIZE);
 
 //! @}
 
+/*! Returns the GblMarshalVaFn equivalent of a builtin GblCClosure marshal for the given parameter types
+ *  \ingroup signals
+ *
+ *  Only returns a va_list marshal when reading the parameters directly
+ *  would yield exactly what \p pFnMarshal would have extracted from
+ *  GblVariants constructed from them, otherwise returns NULL.
+ */
+GBL_EXPORT GblMarshalVaFn GblMarshal_CClosureVa (GblMarshalFn   pFnMarshal,
+                                                 size_t         argCount,
+                                                 const GblType* pParamTypes) GBL_NOEXCEPT;
+
 GBL_DECLS_END
 
 #define GBL_DEFINE_CCLOSURE_MARSHAL_VOID___(paramsPostfix, paramCount, paramList, argList)      \
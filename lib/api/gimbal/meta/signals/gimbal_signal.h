@@ -127,10 +127,39 @@
  *          return 0;
  *      }
  *  \endcode
+ *
+ *  # Queued Connections
+ *  A connection made with GblSignal_connectQueued() or
+ *  GblSignal_connectClosureQueued() has an affinity to a GblThread, which
+ *  defaults to the thread which made the connection. Emitting the signal
+ *  from any thread copies its arguments into a frame, which gets posted to
+ *  that thread's lock-free queue instead of invoking the closure. The closure
+ *  then runs on the target thread once it calls GblThread_processEvents(),
+ *  with GblSignal_emitter() and GblSignal_receiver() still valid:
+ *
+ *  \code{.c}
+ *      // on the UI thread: deliver worker notifications here, later
+ *      GblSignal_connectQueued(GBL_INSTANCE(pWorker),
+ *                              "progress",
+ *                              GBL_INSTANCE(pProgressBar),
+ *                              GBL_CALLBACK(ProgressBar_onProgress_),
+ *                              NULL,
+ *                              NULL);
+ *
+ *      // somewhere in the UI thread's loop
+ *      GblThread_processEvents(0);
+ *  \endcode
+ *
+ *  Queued emissions are always deferred, even when emitted from the target
+ *  thread itself. Disconnecting a queued connection, such as by destroying
+ *  either of its instances, silently drops its undelivered emissions. The
+ *  target thread has to outlive the connection.
  */
 
 GBL_DECLS_BEGIN
 
+GBL_FORWARD_DECLARE_STRUCT(GblThread);
+
 /*! \name  Installing
  *  \brief Methods for installing and uninstalling signals from a GblType.
  *  @{
@@ -174,6 +203,19 @@ GBL_EXPORT GBL_RESULT GblSignal_connectClosure (GblInstance* pEmitter,
                                                 const char*  pSignalName,
                                                 GblInstance* pReceiver,
                                                 GblClosure*  pClosure)       GBL_NOEXCEPT;
+//! Equivalent to GblSignal_connect(), except emissions are queued to \p pThread (the current thread, if `NULL`) and delivered by GblThread_processEvents().
+GBL_EXPORT GBL_RESULT GblSignal_connectQueued        (GblInstance* pEmitter,
+                                                      const char*  pSignalName,
+                                                      GblInstance* pReceiver,
+                                                      GblFnPtr     pFnCCallback,
+                                                      void*        pUserdata,
+                                                      GblThread*   pThread)     GBL_NOEXCEPT;
+//! Equivalent to GblSignal_connectClosure(), except emissions are queued to \p pThread (the current thread, if `NULL`) and delivered by GblThread_processEvents().
+GBL_EXPORT GBL_RESULT GblSignal_connectClosureQueued (GblInstance* pEmitter,
+                                                      const char*  pSignalName,
+                                                      GblInstance* pReceiver,
+                                                      GblClosure*  pClosure,
+                                                      GblThread*   pThread)     GBL_NOEXCEPT;
 //! Disconnects the given \p pClosure on the given \p pReceiver from the given \p pSignalName on the given \p pEmitter, returning the number of closure which were uninstalled.
 GBL_EXPORT size_t     GblSignal_disconnect     (GblInstance* pEmitter,
                                                 const char*  pSignalName,
@@ -66,6 +66,7 @@ typedef enum GblTypeFlags {
     GBL_TYPE_FLAG_INCOMPLETE      = (1 << 11), //!< Incomplete/partial type missing some type dependency
     GBL_TYPE_FLAG_ABSTRACT        = (1 << 12), //!< Type cannot be instantiated without being derived
     GBL_TYPE_FLAG_FINAL           = (1 << 13), //!< Type cannot be derived from
+    GBL_TYPE_FLAG_POOLED          = (1 << 14), //!< Type's instances are allocated from its own pool, with thread-local free caches, rather than the context allocator. Not inherited.
     GBL_TYPE_FLAGS_MASK           = 0xffffffc0 //!< Mask of all user type flags
 } GblTypeFlags;
 
@@ -91,6 +92,16 @@ typedef struct GblTypeInfo {
     size_t                  instancePrivateSize; //!< Size of extra private storage to be associated with a GblType's GblInstance.
 } GblTypeInfo;
 
+//! Statistics for the instance pool of a GBL_TYPE_FLAG_POOLED type, returned by GblType_poolStats()
+typedef struct GblTypePoolStats {
+    size_t entrySize;    //!< Size of each pooled entry, including private instance data
+    size_t pageCount;    //!< Number of pages allocated by the pool
+    size_t totalBytes;   //!< Total capacity of all pages allocated by the pool
+    size_t activeCount;  //!< Number of entries checked out of the pool, including thread-cached ones
+    size_t freeCount;    //!< Number of entries on the pool's shared free list
+    size_t cachedCount;  //!< Approximate number of free entries held within thread-local caches
+} GblTypePoolStats;
+
 /*! \name  Registry
  *  \brief Methods for managing the type registry
  *  @{
@@ -142,6 +153,8 @@ GBL_EXPORT GblFlags           GblType_flags     (GBL_VSELF) GBL_NOEXCEPT;
 GBL_EXPORT GblRefCount GblType_classRefCount (GBL_VSELF) GBL_NOEXCEPT;
 //! Returns the number of active instances of the given GblType
 GBL_EXPORT GblRefCount GblType_instanceCount (GBL_VSELF) GBL_NOEXCEPT;
+//! Fills in \p pStats for the instance pool of a GBL_TYPE_FLAG_POOLED type, zeroed if it has yet to be created
+GBL_EXPORT GBL_RESULT  GblType_poolStats     (GBL_VSELF, GblTypePoolStats* pStats) GBL_NOEXCEPT;
 //! @}
 
 /*! \name  Hierarchy
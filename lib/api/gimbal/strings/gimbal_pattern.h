@@ -44,6 +44,12 @@ GBL_FORWARD_DECLARE_STRUCT(GblStringBuffer);
  *  It is advised that when you are repeatedly using the same
  *  regular expression, you store it and use it as a GblPattern.
  *
+ *  Once a pattern has been matched against a few times, it lazily
+ *  builds a DFA from its expression, which lets whole-string matching
+ *  and ruling out non-matches run in linear time, without backtracking.
+ *  Expressions the DFA cannot represent, such as those with
+ *  backreferences, keep using the backend alone.
+ *
  *  \note
  *  GblPattern is a reference-counted shared pointer type.
  *
@@ -69,6 +75,24 @@ GBL_EXPORT GblRefCount       GblPattern_refCount   (GBL_CSELF)           GBL_NOE
 GBL_EXPORT GblRefCount       GblPattern_totalCount (void)                GBL_NOEXCEPT;
 //! @}
 
+/*! \name Pattern Cache
+ *  \brief Methods for managing the cache behind the string-based API
+ *
+ *  The string-based matching functions, such as GblPattern_matchStr(),
+ *  look their regular expressions up within a global, thread-safe,
+ *  least-recently-used cache of compiled patterns, only compiling
+ *  them upon a miss. Cached patterns are not included within
+ *  GblPattern_totalCount().
+ *
+ *  \relatesalso GblPattern
+ *  @{
+ */
+//! Returns the number of compiled patterns currently held by the cache
+GBL_EXPORT size_t GblPattern_cacheCount (void) GBL_NOEXCEPT;
+//! Evicts every compiled pattern from the cache, freeing those not in use
+GBL_EXPORT void   GblPattern_clearCache (void) GBL_NOEXCEPT;
+//! @}
+
 /*! \name Properties and Operators
  *  \brief Methods for getters and basic operations
  *  \relatesalso GblPattern
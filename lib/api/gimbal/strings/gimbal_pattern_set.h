@@ -0,0 +1,93 @@
+/*! \file
+ *  \brief   GblPatternSet: Matching against many patterns at once
+ *  \ingroup strings
+ *
+ *  This file contains the API and opaque structure declaration
+ *  for GblPatternSet, an immutable collection of compiled regular
+ *  expressions which a string can be tested against all at once.
+ *
+ *  \author     2025 Falco Girgis
+ *  \copyright  MIT License
+ */
+#ifndef GIMBAL_PATTERN_SET_H
+#define GIMBAL_PATTERN_SET_H
+
+#include "gimbal_pattern.h"
+
+#define GBL_SELF_TYPE GblPatternSet
+
+GBL_DECLS_BEGIN
+
+/*! \struct GblPatternSet
+ *  \brief Opaque structure containing a set of compiled regular expressions
+ *
+ *  GblPatternSet compiles each of its regular expressions into a
+ *  GblPattern, along with a single DFA combining all of them.
+ *  Classifying a string, such as a token from a GblScanner, then
+ *  takes one pass over it to rule out the patterns which can't
+ *  match, regardless of how many there are, rather than one
+ *  GblPattern_matchExact() call per pattern. Only the patterns
+ *  which remain are confirmed with GblPattern_matchExact(), so
+ *  the result is always the same as trying each one in order.
+ *
+ *  When any of the expressions can't be represented by the DFA,
+ *  the set falls back to trying each pattern in order instead.
+ *
+ *  \note
+ *  GblPatternSet is a reference-counted shared pointer type.
+ *
+ *  \sa GblPattern
+ *  \ingroup strings
+ */
+struct GblPatternSet;
+typedef struct GblPatternSet GblPatternSet;
+
+/*! \name Lifetime Management
+ *  \brief Methods for creating, referencing, and unreferencing pattern sets
+ *  \relatesalso GblPatternSet
+ *  @{
+ */
+//! Compiles the \p count regular expressions in \p ppRegExps into a new GblPatternSet
+GBL_EXPORT const GblPatternSet* GblPatternSet_create   (const char* const* ppRegExps,
+                                                        size_t             count) GBL_NOEXCEPT;
+//! Returns a new reference to an existing pattern set, incrementing its refcount
+GBL_EXPORT const GblPatternSet* GblPatternSet_ref      (GBL_CSELF)                GBL_NOEXCEPT;
+//! Releases a reference to a pattern set, deallocating it upon reaching zero
+GBL_EXPORT GblRefCount          GblPatternSet_unref    (GBL_CSELF)                GBL_NOEXCEPT;
+//! Returns the number of active references held to the given pattern set
+GBL_EXPORT GblRefCount          GblPatternSet_refCount (GBL_CSELF)                GBL_NOEXCEPT;
+//! @}
+
+/*! \name Properties
+ *  \brief Methods for getters
+ *  \relatesalso GblPatternSet
+ *  @{
+ */
+//! Returns the number of patterns within the given set
+GBL_EXPORT size_t            GblPatternSet_count   (GBL_CSELF)              GBL_NOEXCEPT;
+//! Returns the compiled pattern at \p index within the set, or NULL if out-of-range
+GBL_EXPORT const GblPattern* GblPatternSet_pattern (GBL_CSELF, size_t index) GBL_NOEXCEPT;
+//! Returns GBL_TRUE if every pattern within the set is matched by its combined DFA
+GBL_EXPORT GblBool           GblPatternSet_dfa     (GBL_CSELF)              GBL_NOEXCEPT;
+//! @}
+
+/*! \name Matching
+ *  \brief Methods for matching strings against the set
+ *  \relatesalso GblPatternSet
+ *  @{
+ */
+/*! Returns the index of the first pattern EXACTLY matching \p pString, or -1 if none do
+ *
+ *  Patterns are prioritized by the order they were given to
+ *  GblPatternSet_create(), so when a string is matched by more
+ *  than one pattern, such as a keyword which is also an identifier,
+ *  the earlier pattern wins.
+ */
+GBL_EXPORT int GblPatternSet_matchExact (GBL_CSELF, const char* pString) GBL_NOEXCEPT;
+//! @}
+
+GBL_DECLS_END
+
+#undef GBL_SELF_TYPE
+
+#endif // GIMBAL_PATTERN_SET_H
@@ -22,7 +22,10 @@
  *  since a string literal's lifetime is global.
  *
  *  \note
- *  All functions in this API are thread-safe.
+ *  All functions in this API are thread-safe. Lookups of existing quarks
+ *  (GblQuark_tryString() or GblQuark_fromString() on a registered string)
+ *  never lock, so they scale with the number of reading threads; only
+ *  registering a new string is serialized.
  *
  *  ### Example Usage
  *
@@ -10,7 +10,6 @@
  *      - default argument overloading
  *      - consider making it dynamically resizable easily w/ capacity?
  *      - search/find subbytes
- *      - GblByteView type?
  *
  *  \author     2023 Falco Girgis
  *  \copyright  MIT License
@@ -24,6 +23,8 @@
 
 GBL_DECLS_BEGIN
 
+GBL_FORWARD_DECLARE_STRUCT(GblByteArrayBuffer_);
+
 /*! \brief   Reference-counted resizable array of bytes
  *  \ingroup utils
  *
@@ -31,11 +32,28 @@ GBL_DECLS_BEGIN
  *  bytes with a list-style API as well as various methods
  *  for manipulating and extracting subarrays.
  *
- *  \sa GblBitView
+ *  Subarrays can be extracted without copying with
+ *  GblByteArray_slice(), which returns a new GblByteArray
+ *  pointing into the same buffer, and GblByteArray_copy()
+ *  shares the buffer of its source the same way. Buffers
+ *  are copied on write: the first mutation of an array
+ *  whose buffer is shared gives it its own copy, leaving
+ *  every other array sharing the buffer untouched.
+ *  GblByteArray_fromMapped() wraps a read-only mapping of
+ *  a file, which is copied the same way upon mutation.
+ *
+ *  \note
+ *  Shared and mapped data must only be modified through
+ *  the API, never by writing to GblByteArray::pData.
+ *
+ *  \sa GblBitView, GblByteChain
  */
 typedef struct GblByteArray {
     size_t   size;  //!< Size of the pData structure
     uint8_t* pData; //!< Actual data payload, contiguously-allocated array of bytes
+    GBL_PRIVATE_BEGIN
+        GblByteArrayBuffer_* pBuffer; // Buffer shared with slices and copies, or NULL when pData is owned outright
+    GBL_PRIVATE_END
 } GblByteArray;
 
 /*! \name  Lifetime Management
@@ -47,6 +65,13 @@ typedef struct GblByteArray {
 GBL_EXPORT GblByteArray* GblByteArray_create (size_t      size,
                                               const void* pData/*=NULL*/,
                                               GblContext* pCtx /*=NULL*/) GBL_NOEXCEPT;
+//! Creates and returns a new GblByteArray wrapping a read-only mapping of the file at \p pPath, or NULL upon failure
+GBL_EXPORT GblByteArray* GblByteArray_fromMapped (const char* pPath,
+                                                  GblContext* pCtx/*=NULL*/) GBL_NOEXCEPT;
+//! Creates and returns a new GblByteArray sharing \p bytes of the given array's buffer, starting at \p offset
+GBL_EXPORT GblByteArray* GblByteArray_slice      (GBL_SELF,
+                                                  size_t offset,
+                                                  size_t bytes)      GBL_NOEXCEPT;
 //! Increments the reference counter of the given GblByteArray by 1, returning back a pointer to it
 GBL_EXPORT GblByteArray* GblByteArray_ref    (GBL_SELF)                   GBL_NOEXCEPT;
 //! Decrements the reference counter of the given GblByteArray by 1, destroying it upon hitting 0
@@ -58,13 +83,13 @@ GBL_EXPORT GblRefCount   GblByteArray_unref  (GBL_SELF)                   GBL_NO
  *  \relatesalso GblByteArray
  *  @{
  */
-//! Frees the existing allocation and copies over the allocation and size from \p pOther
+//! Frees the existing allocation and shares the buffer of \p pOther, which is copied upon the first write to either
 GBL_EXPORT GBL_RESULT GblByteArray_copy    (GBL_SELF, const GblByteArray* pOther)   GBL_NOEXCEPT;
 //! Frees the existing allocation and takes the allocation from \p pOther, clearing it
 GBL_EXPORT GBL_RESULT GblByteArray_move    (GBL_SELF, GblByteArray* pOther)         GBL_NOEXCEPT;
 //! Frees the existing allocation and takes the allocation given by \p pData with the given size
 GBL_EXPORT GBL_RESULT GblByteArray_acquire (GBL_SELF, size_t bytes, void* pData)    GBL_NOEXCEPT;
-//! Releases the internal allocation resource, copying it and its size out, clearing them from \p pSelf
+//! Releases the internal allocation resource, copying it and its size out, clearing them from \p pSelf (copying shared data first)
 GBL_EXPORT GBL_RESULT GblByteArray_release (GBL_SELF, size_t* pSize, void** ppData) GBL_NOEXCEPT;
 //! Compares the two byte arrays with semantics similar to memcmp(), returning the result
 GBL_EXPORT int        GblByteArray_compare (GBL_CSELF, const GblByteArray* pRhs)    GBL_NOEXCEPT;
@@ -81,6 +106,8 @@ GBL_EXPORT GblBool    GblByteArray_equals  (GBL_CSELF, const GblByteArray* pRhs)
 GBL_EXPORT GblRefCount   GblByteArray_refCount   (GBL_CSELF) GBL_NOEXCEPT;
 //! Returns the GblContext pointer the GblByteArray was constructed with
 GBL_EXPORT GblContext*   GblByteArray_context    (GBL_CSELF) GBL_NOEXCEPT;
+//! Returns GBL_TRUE if the data of the given GblByteArray is shared or mapped, so the next write will copy it
+GBL_EXPORT GblBool       GblByteArray_shared     (GBL_CSELF) GBL_NOEXCEPT;
 //! Returns the size of the GblByteArray (GblByteArray::size)
 GBL_EXPORT size_t        GblByteArray_size       (GBL_CSELF) GBL_NOEXCEPT;
 //! Returns the data pointer of the GblByteArray (GblByteArray::pData)
@@ -142,6 +169,13 @@ GBL_DECLS_END
     GblByteArray_createDefault__(__VA_ARGS__, GBL_NULL, GBL_NULL)
 #define GblByteArray_createDefault__(bytes, data, ctx, ...) \
     (GblByteArray_create)(bytes, data, ctx)
+
+#define GblByteArray_fromMapped(...) \
+    GblByteArray_fromMappedDefault_(__VA_ARGS__)
+#define GblByteArray_fromMappedDefault_(...) \
+    GblByteArray_fromMappedDefault__(__VA_ARGS__, GBL_NULL)
+#define GblByteArray_fromMappedDefault__(path, ctx, ...) \
+    (GblByteArray_fromMapped)(path, ctx)
 //! \endcond
 
 #undef GBL_SELF_TYPE
@@ -0,0 +1,123 @@
+/*! \file
+ *  \brief   GblByteChain scatter/gather list of GblByteArrays
+ *  \ingroup utils
+ *
+ *  \author     2023 Falco Girgis
+ *  \copyright  MIT License
+ */
+#ifndef GIMBAL_BYTE_CHAIN_H
+#define GIMBAL_BYTE_CHAIN_H
+
+#include "gimbal_byte_array.h"
+#include "../containers/gimbal_array_list.h"
+
+#define GBL_SELF_TYPE GblByteChain
+
+GBL_DECLS_BEGIN
+
+/*! \brief   Scatter/gather list of GblByteArray links
+ *  \ingroup utils
+ *
+ *  GblByteChain represents one logical sequence of bytes
+ *  made up of a list of GblByteArray "links," each of
+ *  which is a slice (see GblByteArray_slice()) of the array
+ *  it was added from, so a message can be assembled from
+ *  headers, payloads, and trailers living in different
+ *  buffers without copying any of them, and prepending to
+ *  a chain never moves the existing data. Since buffers are
+ *  copied on write, modifying an array after adding it
+ *  never changes the contents of the chain.
+ *
+ *  A chain can be written out to a file descriptor with a
+ *  single gather write, or flattened into one contiguous
+ *  GblByteArray when that's what a consumer requires.
+ *
+ *  \sa GblByteArray
+ */
+typedef struct GblByteChain {
+    GBL_PRIVATE_BEGIN
+        GblArrayList links; // GblByteArray* for each link, in order
+        size_t       size;  // Total number of bytes across all links
+    GBL_PRIVATE_END
+} GblByteChain;
+
+/*! \name  Lifetime Management
+ *  \brief Methods for constructing and destructing
+ *  \relatesalso GblByteChain
+ *  @{
+ */
+//! Constructs an empty GblByteChain in place, with an optional GblContext
+GBL_EXPORT GBL_RESULT GblByteChain_construct (GBL_SELF, GblContext* pCtx/*=NULL*/) GBL_NOEXCEPT;
+//! Destructs the given GblByteChain, releasing its reference to each of its links
+GBL_EXPORT GBL_RESULT GblByteChain_destruct  (GBL_SELF)                            GBL_NOEXCEPT;
+//! @}
+
+/*! \name  Properties
+ *  \brief Methods for querying properties
+ *  \relatesalso GblByteChain
+ *  @{
+ */
+//! Returns the GblContext pointer the GblByteChain was constructed with
+GBL_EXPORT GblContext*   GblByteChain_context (GBL_CSELF)               GBL_NOEXCEPT;
+//! Returns the total number of bytes across every link of the GblByteChain
+GBL_EXPORT size_t        GblByteChain_size    (GBL_CSELF)               GBL_NOEXCEPT;
+//! Returns the number of GblByteArray links within the GblByteChain
+GBL_EXPORT size_t        GblByteChain_count   (GBL_CSELF)               GBL_NOEXCEPT;
+//! Returns GBL_TRUE if the given GblByteChain holds no bytes
+GBL_EXPORT GblBool       GblByteChain_empty   (GBL_CSELF)               GBL_NOEXCEPT;
+//! Returns the GblByteArray link at the given \p index, raising an error upon out-of-range access
+GBL_EXPORT GblByteArray* GblByteChain_link    (GBL_CSELF, size_t index) GBL_NOEXCEPT;
+//! @}
+
+/*! \name  Links
+ *  \brief Methods for adding and removing links
+ *  \relatesalso GblByteChain
+ *  @{
+ */
+//! Adds a slice of all of \p pArray to the end of the GblByteChain, returning a status code
+GBL_EXPORT GBL_RESULT GblByteChain_append      (GBL_SELF, GblByteArray* pArray)           GBL_NOEXCEPT;
+//! Adds a slice of all of \p pArray to the beginning of the GblByteChain, returning a status code
+GBL_EXPORT GBL_RESULT GblByteChain_prepend     (GBL_SELF, GblByteArray* pArray)           GBL_NOEXCEPT;
+//! Appends a slice of \p bytes of \p pArray starting at \p offset to the GblByteChain, returning a status code
+GBL_EXPORT GBL_RESULT GblByteChain_appendSlice (GBL_SELF,
+                                                GblByteArray* pArray,
+                                                size_t        offset,
+                                                size_t        bytes)                      GBL_NOEXCEPT;
+//! Releases every link from the given GblByteChain, resetting its size to 0
+GBL_EXPORT GBL_RESULT GblByteChain_clear       (GBL_SELF)                                 GBL_NOEXCEPT;
+//! @}
+
+/*! \name  Reading and Writing
+ *  \brief Methods for extracting the chained bytes
+ *  \relatesalso GblByteChain
+ *  @{
+ */
+//! Copies \p bytes starting at logical \p offset across links into \p pOut, returning a status code
+GBL_EXPORT GBL_RESULT    GblByteChain_read    (GBL_CSELF, size_t offset, size_t bytes, void* pOut) GBL_NOEXCEPT;
+//! Creates and returns a new GblByteArray holding every byte of the chain contiguously
+GBL_EXPORT GblByteArray* GblByteChain_flatten (GBL_CSELF)                                          GBL_NOEXCEPT;
+//! Writes every link to the file descriptor \p fd with gather writes, storing the byte count in \p pWritten
+GBL_EXPORT GBL_RESULT    GblByteChain_write   (GBL_CSELF, int fd, size_t* pWritten/*=NULL*/)       GBL_NOEXCEPT;
+//! @}
+
+GBL_DECLS_END
+
+//! \cond
+#define GblByteChain_construct(...) \
+    GblByteChain_constructDefault_(__VA_ARGS__)
+#define GblByteChain_constructDefault_(...) \
+    GblByteChain_constructDefault__(__VA_ARGS__, GBL_NULL)
+#define GblByteChain_constructDefault__(self, ctx, ...) \
+    (GblByteChain_construct)(self, ctx)
+
+#define GblByteChain_write(...) \
+    GblByteChain_writeDefault_(__VA_ARGS__)
+#define GblByteChain_writeDefault_(...) \
+    GblByteChain_writeDefault__(__VA_ARGS__, GBL_NULL)
+#define GblByteChain_writeDefault__(self, fd, written, ...) \
+    (GblByteChain_write)(self, fd, written)
+//! \endcond
+
+#undef GBL_SELF_TYPE
+
+#endif // GIMBAL_BYTE_CHAIN_H
@@ -15,6 +15,7 @@
 
 #include "../meta/instances/gimbal_object.h"
 #include "../meta/signals/gimbal_signal.h"
+#include "gimbal_byte_array.h"
 
 /*! \name Type System
  *  \brief Type UUID and cast operators
@@ -67,6 +68,21 @@ GBL_CLASS_END
  *  and serialized and deserialized from some common
  *  format.
  *
+ *  By default, settings persist as a compiled, binary
+ *  image: an open-addressed index of key hashes over a
+ *  table of fixed-size entries and a pool of strings.
+ *  Loading memory-maps the image and validates it once,
+ *  so lookups probe it directly, in O(1), without ever
+ *  parsing or copying it. Values written afterwards are
+ *  kept in an overlay on top of the image until the next
+ *  GblSettings_save() recompiles both together, then
+ *  atomically replaces the file at GblSettings::pPath.
+ *
+ *  \note
+ *  Only primitive, string, type, enum, and flags values
+ *  persist; values of other types are skipped with a
+ *  warning when compiling.
+ *
  *  \sa GblSettingsClass
  */
 GBL_INSTANCE_DERIVE(GblSettings, GblObject)
@@ -108,7 +124,10 @@ GBL_EXPORT void         GblSettings_pushArray     (GBL_SELF, const char* pName,
 GBL_EXPORT const char*  GblSettings_pop           (GBL_SELF)                                               GBL_NOEXCEPT;
 GBL_EXPORT GBL_RESULT   GblSettings_setArrayIndex (GBL_SELF, size_t index)                                 GBL_NOEXCEPT;
 
+GBL_EXPORT GBL_RESULT   GblSettings_save          (GBL_SELF)                                               GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT   GblSettings_load          (GBL_SELF)                                               GBL_NOEXCEPT;
 GBL_EXPORT GBL_RESULT   GblSettings_sync          (GBL_SELF)                                               GBL_NOEXCEPT;
+GBL_EXPORT GBL_RESULT   GblSettings_compile       (GBL_CSELF, GblByteArray* pImage)                        GBL_NOEXCEPT;
 
 GBL_EXPORT GBL_RESULT   GblSettings_variant       (GBL_CSELF, const char* pKey, GblVariant* pVariant)      GBL_NOEXCEPT;
 GBL_EXPORT GBL_RESULT   GblSettings_toValue       (GBL_CSELF, const char* pKey, GblType type, ...)         GBL_NOEXCEPT;
@@ -122,14 +141,15 @@ GBL_EXPORT uint16_t     GblSettings_toUint16      (GBL_CSELF, const char* pKey,
 GBL_EXPORT int16_t      GblSettings_toInt16       (GBL_CSELF, const char* pKey, int16_t defaultValue)      GBL_NOEXCEPT;
 GBL_EXPORT uint32_t     GblSettings_toUint32      (GBL_CSELF, const char* pKey, uint32_t defaultValue)     GBL_NOEXCEPT;
 GBL_EXPORT int32_t      GblSettings_toInt32       (GBL_CSELF, const char* pKey, int32_t defaultValue)      GBL_NOEXCEPT;
-GBL_EXPORT uint32_t     GblSettings_toUint64      (GBL_CSELF, const char* pKey, uint32_t defaultValue)     GBL_NOEXCEPT;
-GBL_EXPORT int32_t      GblSettings_toInt64       (GBL_CSELF, const char* pKey, int32_t defaultValue)      GBL_NOEXCEPT;
+GBL_EXPORT uint64_t     GblSettings_toUint64      (GBL_CSELF, const char* pKey, uint64_t defaultValue)     GBL_NOEXCEPT;
+GBL_EXPORT int64_t      GblSettings_toInt64       (GBL_CSELF, const char* pKey, int64_t defaultValue)      GBL_NOEXCEPT;
 GBL_EXPORT size_t       GblSettings_toSize        (GBL_CSELF, const char* pkey, size_t defaultValue)       GBL_NOEXCEPT;
 GBL_EXPORT GblEnum      GblSettings_toEnum        (GBL_CSELF, const char* pKey, GblEnum defaultValue)      GBL_NOEXCEPT;
 GBL_EXPORT GblFlags     GblSettings_toFlags       (GBL_CSELF, const char* pKey, GblFlags defaultValue)     GBL_NOEXCEPT;
 GBL_EXPORT float        GblSettings_toFloat       (GBL_CSELF, const char* pKey, float defaultValue)        GBL_NOEXCEPT;
 GBL_EXPORT double       GblSettings_toDouble      (GBL_CSELF, const char* pKey, double defaultValue)       GBL_NOEXCEPT;
 GBL_EXPORT void*        GblSettings_toPointer     (GBL_CSELF, const char* pKey, void* pDefaultValue)       GBL_NOEXCEPT;
+//! Returns \p pKey's string value in place, valid until it is written or loaded over, or \p pDefValue if it is missing or not a string
 GBL_EXPORT const char*  GblSettings_toString      (GBL_CSELF, const char* pKey, const char* pDefValue)     GBL_NOEXCEPT;
 GBL_EXPORT GblType      GblSettings_toType        (GBL_CSELF, const char* pKey, GblType defaultValue)      GBL_NOEXCEPT;
 
@@ -1,5 +1,16 @@
 #include <gimbal/algorithms/gimbal_compression.h>
+#include <gimbal/utils/gimbal_byte_array.h>
+#include <gimbal/strings/gimbal_string_buffer.h>
+#include <gimbal/core/gimbal_ctx.h>
+#define LZ4F_STATIC_LINKING_ONLY
 #include <lz4.h>
+#include <lz4frame.h>
+
+#define GBL_COMPRESSOR_(self)   (GBL_PRIV_REF(self))
+#define GBL_DECOMPRESSOR_(self) (GBL_PRIV_REF(self))
+
+// Size of the chunks written to the sink by a GblDecompressor
+#define GBL_DECOMPRESSOR_BUFFER_SIZE_   (64 * 1024)
 
 GBL_EXPORT int gblCompress(const void* pSrc,
                            void*       pDst,
@@ -17,3 +28,393 @@ GBL_EXPORT int gblDecompress(const void* pSrc,
 {
     return LZ4_decompress_safe(pSrc, pDst, srcSize, dstCapacity);
 }
+
+static GBL_RESULT GblCompressor_writeByteArray_(void* pUserdata, const void* pData, size_t size) {
+    return GblByteArray_append(pUserdata, size, pData);
+}
+
+static GBL_RESULT GblCompressor_writeStringBuffer_(void* pUserdata, const void* pData, size_t size) {
+    return size? GblStringBuffer_append(pUserdata, pData, size) : GBL_RESULT_SUCCESS;
+}
+
+static LZ4F_blockSizeID_t GblCompressor_blockSizeId_(size_t windowSize) {
+    if(windowSize <= 64 * 1024)   return LZ4F_max64KB;
+    if(windowSize <= 256 * 1024)  return LZ4F_max256KB;
+    if(windowSize <= 1024 * 1024) return LZ4F_max1MB;
+    return LZ4F_max4MB;
+}
+
+static void GblCompressor_preferences_(const GblCompressor* pSelf, LZ4F_preferences_t* pPrefs) {
+    memset(pPrefs, 0, sizeof(LZ4F_preferences_t));
+    pPrefs->frameInfo.blockSizeID         = GblCompressor_blockSizeId_(GBL_COMPRESSOR_(pSelf).windowSize);
+    pPrefs->frameInfo.blockMode           = LZ4F_blockLinked;
+    pPrefs->frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+    pPrefs->compressionLevel              = GBL_COMPRESSOR_(pSelf).level;
+}
+
+static GBL_RESULT GblCompressor_write_(GblCompressor* pSelf, size_t size) {
+    GBL_CTX_BEGIN(GBL_COMPRESSOR_(pSelf).pCtx);
+
+    GBL_CTX_VERIFY(!LZ4F_isError(size),
+                   GBL_RESULT_ERROR_INTERNAL,
+                   "LZ4 frame compression failed: %s",
+                   LZ4F_getErrorName(size));
+
+    if(size) {
+        GBL_CTX_VERIFY(GBL_COMPRESSOR_(pSelf).pFnWrite,
+                       GBL_RESULT_ERROR_INVALID_OPERATION,
+                       "No sink has been set for the compressor!");
+
+        GBL_CTX_VERIFY_CALL(GBL_COMPRESSOR_(pSelf).pFnWrite(GBL_COMPRESSOR_(pSelf).pSink,
+                                                            GBL_COMPRESSOR_(pSelf).pBuffer,
+                                                            size));
+        GBL_COMPRESSOR_(pSelf).bytesOut += size;
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblCompressor_begin_(GblCompressor* pSelf) {
+    GBL_CTX_BEGIN(GBL_COMPRESSOR_(pSelf).pCtx);
+
+    LZ4F_preferences_t prefs;
+    GblCompressor_preferences_(pSelf, &prefs);
+
+    const size_t size = LZ4F_compressBegin_usingCDict(GBL_COMPRESSOR_(pSelf).pLz4,
+                                                      GBL_COMPRESSOR_(pSelf).pBuffer,
+                                                      GBL_COMPRESSOR_(pSelf).bufferSize,
+                                                      GBL_COMPRESSOR_(pSelf).pDict,
+                                                      &prefs);
+
+    GBL_CTX_VERIFY_CALL(GblCompressor_write_(pSelf, size));
+    GBL_COMPRESSOR_(pSelf).inFrame = GBL_TRUE;
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT (GblCompressor_construct)(GblCompressor* pSelf,
+                                                int            level,
+                                                size_t         windowSize,
+                                                GblContext*    pCtx)
+{
+    GBL_CTX_BEGIN(pCtx);
+
+    GBL_CTX_VERIFY_POINTER(pSelf);
+    GBL_CTX_VERIFY_ARG(level <= GBL_COMPRESSOR_LEVEL_MAX);
+
+    memset(pSelf, 0, sizeof(GblCompressor));
+    GBL_COMPRESSOR_(pSelf).pCtx  = pCtx;
+    GBL_COMPRESSOR_(pSelf).level = level;
+
+    switch(GblCompressor_blockSizeId_(windowSize? windowSize : GBL_COMPRESSOR_WINDOW_DEFAULT)) {
+    case LZ4F_max256KB: GBL_COMPRESSOR_(pSelf).windowSize = 256 * 1024;       break;
+    case LZ4F_max1MB:   GBL_COMPRESSOR_(pSelf).windowSize = 1024 * 1024;      break;
+    case LZ4F_max4MB:   GBL_COMPRESSOR_(pSelf).windowSize = 4 * 1024 * 1024;  break;
+    default:            GBL_COMPRESSOR_(pSelf).windowSize = 64 * 1024;        break;
+    }
+
+    LZ4F_preferences_t prefs;
+    GblCompressor_preferences_(pSelf, &prefs);
+
+    // large enough for a header or for everything an update of one window can emit
+    GBL_COMPRESSOR_(pSelf).bufferSize = GBL_MAX(LZ4F_compressBound(GBL_COMPRESSOR_(pSelf).windowSize, &prefs),
+                                                LZ4F_HEADER_SIZE_MAX);
+    GBL_COMPRESSOR_(pSelf).pBuffer    = GBL_CTX_MALLOC(GBL_COMPRESSOR_(pSelf).bufferSize);
+
+    const LZ4F_errorCode_t code = LZ4F_createCompressionContext((LZ4F_cctx**)&GBL_COMPRESSOR_(pSelf).pLz4,
+                                                                LZ4F_VERSION);
+    GBL_CTX_VERIFY(!LZ4F_isError(code),
+                   GBL_RESULT_ERROR_MEM_ALLOC,
+                   "Failed to create LZ4 compression context: %s",
+                   LZ4F_getErrorName(code));
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblCompressor_destruct(GblCompressor* pSelf) {
+    GBL_CTX_BEGIN(GBL_COMPRESSOR_(pSelf).pCtx);
+
+    LZ4F_freeCompressionContext(GBL_COMPRESSOR_(pSelf).pLz4);
+    LZ4F_freeCDict(GBL_COMPRESSOR_(pSelf).pDict);
+
+    if(GBL_COMPRESSOR_(pSelf).pBuffer)
+        GBL_CTX_FREE(GBL_COMPRESSOR_(pSelf).pBuffer);
+
+    GBL_COMPRESSOR_(pSelf).pLz4    = NULL;
+    GBL_COMPRESSOR_(pSelf).pDict   = NULL;
+    GBL_COMPRESSOR_(pSelf).pBuffer = NULL;
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblCompressor_setSink(GblCompressor*       pSelf,
+                                            GblCompressorWriteFn pFnWrite,
+                                            void*                pUserdata)
+{
+    GBL_COMPRESSOR_(pSelf).pFnWrite = pFnWrite;
+    GBL_COMPRESSOR_(pSelf).pSink    = pUserdata;
+    return GBL_RESULT_SUCCESS;
+}
+
+GBL_EXPORT GBL_RESULT GblCompressor_setByteArraySink(GblCompressor* pSelf, GblByteArray* pArray) {
+    return GblCompressor_setSink(pSelf, GblCompressor_writeByteArray_, pArray);
+}
+
+GBL_EXPORT GBL_RESULT GblCompressor_setStringBufferSink(GblCompressor* pSelf, GblStringBuffer* pBuffer) {
+    return GblCompressor_setSink(pSelf, GblCompressor_writeStringBuffer_, pBuffer);
+}
+
+GBL_EXPORT GBL_RESULT GblCompressor_loadDictionary(GblCompressor* pSelf, const void* pData, size_t size) {
+    GBL_CTX_BEGIN(GBL_COMPRESSOR_(pSelf).pCtx);
+
+    GBL_CTX_VERIFY_ARG(pData || !size);
+
+    LZ4F_freeCDict(GBL_COMPRESSOR_(pSelf).pDict);
+    GBL_COMPRESSOR_(pSelf).pDict = NULL;
+
+    if(size) {
+        GBL_COMPRESSOR_(pSelf).pDict = LZ4F_createCDict(pData, size);
+        GBL_CTX_VERIFY(GBL_COMPRESSOR_(pSelf).pDict,
+                       GBL_RESULT_ERROR_MEM_ALLOC,
+                       "Failed to create LZ4 dictionary!");
+    }
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblCompressor_update(GblCompressor* pSelf, const void* pData, size_t size) {
+    GBL_CTX_BEGIN(GBL_COMPRESSOR_(pSelf).pCtx);
+
+    GBL_CTX_VERIFY_ARG(pData || !size);
+
+    if(!GBL_COMPRESSOR_(pSelf).inFrame)
+        GBL_CTX_VERIFY_CALL(GblCompressor_begin_(pSelf));
+
+    // never feed more than a window at once, so the output always fits the buffer
+    for(size_t offset = 0; offset < size; offset += GBL_COMPRESSOR_(pSelf).windowSize) {
+        const size_t chunk = GBL_MIN(size - offset, GBL_COMPRESSOR_(pSelf).windowSize);
+
+        GBL_CTX_VERIFY_CALL(
+            GblCompressor_write_(pSelf,
+                                 LZ4F_compressUpdate(GBL_COMPRESSOR_(pSelf).pLz4,
+                                                     GBL_COMPRESSOR_(pSelf).pBuffer,
+                                                     GBL_COMPRESSOR_(pSelf).bufferSize,
+                                                     (const uint8_t*)pData + offset,
+                                                     chunk,
+                                                     NULL)));
+
+        GBL_COMPRESSOR_(pSelf).bytesIn += chunk;
+    }
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblCompressor_flush(GblCompressor* pSelf) {
+    GBL_CTX_BEGIN(GBL_COMPRESSOR_(pSelf).pCtx);
+
+    if(GBL_COMPRESSOR_(pSelf).inFrame)
+        GBL_CTX_VERIFY_CALL(
+            GblCompressor_write_(pSelf,
+                                 LZ4F_flush(GBL_COMPRESSOR_(pSelf).pLz4,
+                                            GBL_COMPRESSOR_(pSelf).pBuffer,
+                                            GBL_COMPRESSOR_(pSelf).bufferSize,
+                                            NULL)));
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblCompressor_finish(GblCompressor* pSelf) {
+    GBL_CTX_BEGIN(GBL_COMPRESSOR_(pSelf).pCtx);
+
+    if(!GBL_COMPRESSOR_(pSelf).inFrame)
+        GBL_CTX_VERIFY_CALL(GblCompressor_begin_(pSelf));
+
+    GBL_COMPRESSOR_(pSelf).inFrame = GBL_FALSE;
+
+    GBL_CTX_VERIFY_CALL(
+        GblCompressor_write_(pSelf,
+                             LZ4F_compressEnd(GBL_COMPRESSOR_(pSelf).pLz4,
+                                              GBL_COMPRESSOR_(pSelf).pBuffer,
+                                              GBL_COMPRESSOR_(pSelf).bufferSize,
+                                              NULL)));
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT int GblCompressor_level(const GblCompressor* pSelf) {
+    return GBL_COMPRESSOR_(pSelf).level;
+}
+
+GBL_EXPORT size_t GblCompressor_windowSize(const GblCompressor* pSelf) {
+    return GBL_COMPRESSOR_(pSelf).windowSize;
+}
+
+GBL_EXPORT size_t GblCompressor_bytesIn(const GblCompressor* pSelf) {
+    return GBL_COMPRESSOR_(pSelf).bytesIn;
+}
+
+GBL_EXPORT size_t GblCompressor_bytesOut(const GblCompressor* pSelf) {
+    return GBL_COMPRESSOR_(pSelf).bytesOut;
+}
+
+GBL_EXPORT GblBool GblCompressor_inFrame(const GblCompressor* pSelf) {
+    return GBL_COMPRESSOR_(pSelf).inFrame;
+}
+
+GBL_EXPORT GBL_RESULT (GblDecompressor_construct)(GblDecompressor* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+
+    GBL_CTX_VERIFY_POINTER(pSelf);
+
+    memset(pSelf, 0, sizeof(GblDecompressor));
+    GBL_DECOMPRESSOR_(pSelf).pCtx       = pCtx;
+    GBL_DECOMPRESSOR_(pSelf).bufferSize = GBL_DECOMPRESSOR_BUFFER_SIZE_;
+    GBL_DECOMPRESSOR_(pSelf).pBuffer    = GBL_CTX_MALLOC(GBL_DECOMPRESSOR_BUFFER_SIZE_);
+
+    const LZ4F_errorCode_t code = LZ4F_createDecompressionContext((LZ4F_dctx**)&GBL_DECOMPRESSOR_(pSelf).pLz4,
+                                                                  LZ4F_VERSION);
+    GBL_CTX_VERIFY(!LZ4F_isError(code),
+                   GBL_RESULT_ERROR_MEM_ALLOC,
+                   "Failed to create LZ4 decompression context: %s",
+                   LZ4F_getErrorName(code));
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblDecompressor_destruct(GblDecompressor* pSelf) {
+    GBL_CTX_BEGIN(GBL_DECOMPRESSOR_(pSelf).pCtx);
+
+    LZ4F_freeDecompressionContext(GBL_DECOMPRESSOR_(pSelf).pLz4);
+
+    if(GBL_DECOMPRESSOR_(pSelf).pDict)
+        GBL_CTX_FREE(GBL_DECOMPRESSOR_(pSelf).pDict);
+
+    if(GBL_DECOMPRESSOR_(pSelf).pBuffer)
+        GBL_CTX_FREE(GBL_DECOMPRESSOR_(pSelf).pBuffer);
+
+    GBL_DECOMPRESSOR_(pSelf).pLz4    = NULL;
+    GBL_DECOMPRESSOR_(pSelf).pDict   = NULL;
+    GBL_DECOMPRESSOR_(pSelf).pBuffer = NULL;
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblDecompressor_setSink(GblDecompressor*     pSelf,
+                                              GblCompressorWriteFn pFnWrite,
+                                              void*                pUserdata)
+{
+    GBL_DECOMPRESSOR_(pSelf).pFnWrite = pFnWrite;
+    GBL_DECOMPRESSOR_(pSelf).pSink    = pUserdata;
+    return GBL_RESULT_SUCCESS;
+}
+
+GBL_EXPORT GBL_RESULT GblDecompressor_setByteArraySink(GblDecompressor* pSelf, GblByteArray* pArray) {
+    return GblDecompressor_setSink(pSelf, GblCompressor_writeByteArray_, pArray);
+}
+
+GBL_EXPORT GBL_RESULT GblDecompressor_setStringBufferSink(GblDecompressor* pSelf, GblStringBuffer* pBuffer) {
+    return GblDecompressor_setSink(pSelf, GblCompressor_writeStringBuffer_, pBuffer);
+}
+
+GBL_EXPORT GBL_RESULT GblDecompressor_loadDictionary(GblDecompressor* pSelf, const void* pData, size_t size) {
+    GBL_CTX_BEGIN(GBL_DECOMPRESSOR_(pSelf).pCtx);
+
+    GBL_CTX_VERIFY_ARG(pData || !size);
+
+    // LZ4 only ever references the last 64KB of a dictionary
+    if(size > 64 * 1024) {
+        pData = (const uint8_t*)pData + size - 64 * 1024;
+        size  = 64 * 1024;
+    }
+
+    if(GBL_DECOMPRESSOR_(pSelf).pDict) {
+        GBL_CTX_FREE(GBL_DECOMPRESSOR_(pSelf).pDict);
+        GBL_DECOMPRESSOR_(pSelf).pDict = NULL;
+    }
+
+    GBL_DECOMPRESSOR_(pSelf).dictSize = size;
+
+    if(size) {
+        GBL_DECOMPRESSOR_(pSelf).pDict = GBL_CTX_MALLOC(size);
+        memcpy(GBL_DECOMPRESSOR_(pSelf).pDict, pData, size);
+    }
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblDecompressor_update(GblDecompressor* pSelf, const void* pData, size_t size) {
+    GBL_CTX_BEGIN(GBL_DECOMPRESSOR_(pSelf).pCtx);
+
+    GBL_CTX_VERIFY_ARG(pData || !size);
+    GBL_CTX_VERIFY(GBL_DECOMPRESSOR_(pSelf).pFnWrite,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "No sink has been set for the decompressor!");
+
+    const uint8_t* pSrc = pData;
+    size_t         left = size;
+
+    // keep going until all input is consumed and no more output is pending
+    do {
+        size_t srcSize = left;
+        size_t dstSize = GBL_DECOMPRESSOR_(pSelf).bufferSize;
+
+        const size_t hint = LZ4F_decompress_usingDict(GBL_DECOMPRESSOR_(pSelf).pLz4,
+                                                      GBL_DECOMPRESSOR_(pSelf).pBuffer,
+                                                      &dstSize,
+                                                      pSrc,
+                                                      &srcSize,
+                                                      GBL_DECOMPRESSOR_(pSelf).pDict,
+                                                      GBL_DECOMPRESSOR_(pSelf).dictSize,
+                                                      NULL);
+
+        GBL_CTX_VERIFY(!LZ4F_isError(hint),
+                       GBL_RESULT_ERROR_INVALID_ARG,
+                       "LZ4 frame decompression failed: %s",
+                       LZ4F_getErrorName(hint));
+
+        pSrc += srcSize;
+        left -= srcSize;
+        GBL_DECOMPRESSOR_(pSelf).bytesIn += srcSize;
+
+        if(srcSize || dstSize)
+            GBL_DECOMPRESSOR_(pSelf).inFrame = (hint != 0);
+
+        if(dstSize) {
+            GBL_CTX_VERIFY_CALL(GBL_DECOMPRESSOR_(pSelf).pFnWrite(GBL_DECOMPRESSOR_(pSelf).pSink,
+                                                                  GBL_DECOMPRESSOR_(pSelf).pBuffer,
+                                                                  dstSize));
+            GBL_DECOMPRESSOR_(pSelf).bytesOut += dstSize;
+        } else if(!srcSize) {
+            break;
+        }
+    } while(left || GBL_DECOMPRESSOR_(pSelf).inFrame);
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblDecompressor_finish(GblDecompressor* pSelf) {
+    GBL_CTX_BEGIN(GBL_DECOMPRESSOR_(pSelf).pCtx);
+
+    const GblBool inFrame = GBL_DECOMPRESSOR_(pSelf).inFrame;
+
+    LZ4F_resetDecompressionContext(GBL_DECOMPRESSOR_(pSelf).pLz4);
+    GBL_DECOMPRESSOR_(pSelf).inFrame = GBL_FALSE;
+
+    GBL_CTX_VERIFY(!inFrame,
+                   GBL_RESULT_ERROR_UNDERFLOW,
+                   "Compressed stream ended in the middle of a frame!");
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT size_t GblDecompressor_bytesIn(const GblDecompressor* pSelf) {
+    return GBL_DECOMPRESSOR_(pSelf).bytesIn;
+}
+
+GBL_EXPORT size_t GblDecompressor_bytesOut(const GblDecompressor* pSelf) {
+    return GBL_DECOMPRESSOR_(pSelf).bytesOut;
+}
+
+GBL_EXPORT GblBool GblDecompressor_inFrame(const GblDecompressor* pSelf) {
+    return GBL_DECOMPRESSOR_(pSelf).inFrame;
+}
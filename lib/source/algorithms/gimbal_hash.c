@@ -4,6 +4,302 @@
 #include <gimbal/algorithms/gimbal_random.h>
 #define XXH_INLINE_ALL
 #include <xxhash.h>
+#include <stdatomic.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#   include <immintrin.h>
+#   include <cpuid.h>
+#   define GBL_HASH_X86_
+#   define GBL_HASH_TARGET_SSE42_   __attribute__((target("sse4.2")))
+#   define GBL_HASH_TARGET_PCLMUL_  __attribute__((target("sse4.1,pclmul")))
+#elif defined(_M_X64)
+#   include <intrin.h>
+#   define GBL_HASH_X86_
+#   define GBL_HASH_TARGET_SSE42_
+#   define GBL_HASH_TARGET_PCLMUL_
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__)) && \
+      (defined(__ARM_FEATURE_CRC32) || defined(__linux__))
+#   if !defined(__ARM_FEATURE_CRC32)
+#       include <sys/auxv.h>
+#   endif
+#   define GBL_HASH_ARM_
+#   if defined(__clang__)
+#       define GBL_HASH_TARGET_CRC_ __attribute__((target("crc")))
+#   else
+#       define GBL_HASH_TARGET_CRC_ __attribute__((target("+crc")))
+#   endif
+#endif
+
+#define GBL_HASH_CPU_DETECTED_      0x1     // CPU features have been queried
+#define GBL_HASH_CPU_CRC32C_        0x2     // hardware CRC-32C instructions
+#define GBL_HASH_CPU_CRC32_         0x4     // hardware CRC-32 instructions (or carry-less multiply)
+
+#define GBL_HASH_CRC32_POLY_        0xedb88320  // reflected IEEE 802.3 polynomial
+#define GBL_HASH_CRC32C_POLY_       0x82f63b78  // reflected Castagnoli polynomial
+#define GBL_HASH_PCLMUL_MIN_SIZE_   64          // minimum size worth folding with PCLMULQDQ
+#define GBL_HASH_MANY_LANES_        8           // keys hashed together by gblHashMany()
+
+typedef struct GblHashCrcTables_ {
+    uint32_t crc32 [8][256];
+    uint32_t crc32c[8][256];
+} GblHashCrcTables_;
+
+static GblHashCrcTables_ crcTables_;
+static atomic_int        crcTablesState_ = 0;   // 0: empty, 1: being filled, 2: ready
+static atomic_int        cpuFeatures_    = 0;
+
+static int gblHashCpuFeatures_(void) {
+    int features = atomic_load_explicit(&cpuFeatures_, memory_order_relaxed);
+
+    if GBL_UNLIKELY(!features) {
+        features = GBL_HASH_CPU_DETECTED_;
+#if defined(GBL_HASH_X86_)
+#   if defined(_MSC_VER) && !defined(__clang__)
+        int regs[4];
+        __cpuid(regs, 1);
+        const unsigned ecx = regs[2];
+#   else
+        unsigned eax, ebx, ecx = 0, edx;
+        __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+#   endif
+        if(ecx & (1u << 20))
+            features |= GBL_HASH_CPU_CRC32C_;
+        if((ecx & (1u << 1)) && (ecx & (1u << 19)))
+            features |= GBL_HASH_CPU_CRC32_;
+#elif defined(GBL_HASH_ARM_)
+#   if defined(__ARM_FEATURE_CRC32)
+        features |= GBL_HASH_CPU_CRC32_ | GBL_HASH_CPU_CRC32C_;
+#   else
+        if(getauxval(AT_HWCAP) & (1ul << 7)) // HWCAP_CRC32
+            features |= GBL_HASH_CPU_CRC32_ | GBL_HASH_CPU_CRC32C_;
+#   endif
+#endif
+        atomic_store_explicit(&cpuFeatures_, features, memory_order_relaxed);
+    }
+
+    return features;
+}
+
+static void gblHashCrcTableFill_(uint32_t table[8][256], uint32_t poly) {
+    for(unsigned i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for(unsigned b = 0; b < 8; ++b)
+            crc = (crc >> 1) ^ (poly & (-(crc & 1)));
+        table[0][i] = crc;
+    }
+
+    for(unsigned i = 0; i < 256; ++i)
+        for(unsigned t = 1; t < 8; ++t)
+            table[t][i] = (table[t - 1][i] >> 8) ^ table[0][table[t - 1][i] & 0xff];
+}
+
+static const GblHashCrcTables_* gblHashCrcTables_(void) {
+    if GBL_UNLIKELY(atomic_load_explicit(&crcTablesState_, memory_order_acquire) != 2) {
+        int expected = 0;
+
+        if(atomic_compare_exchange_strong(&crcTablesState_, &expected, 1)) {
+            gblHashCrcTableFill_(crcTables_.crc32,  GBL_HASH_CRC32_POLY_);
+            gblHashCrcTableFill_(crcTables_.crc32c, GBL_HASH_CRC32C_POLY_);
+            atomic_store_explicit(&crcTablesState_, 2, memory_order_release);
+        } else while(atomic_load_explicit(&crcTablesState_, memory_order_acquire) != 2);
+    }
+
+    return &crcTables_;
+}
+
+// Slicing-by-8: consumes 8 bytes per iteration with independent table lookups
+static uint32_t gblHashCrcSliced_(uint32_t crc, const uint8_t* pBytes, size_t size, const uint32_t t[8][256]) {
+    for(; size >= 8; size -= 8, pBytes += 8) {
+        const uint32_t lo = crc ^ ((uint32_t)pBytes[0]       | (uint32_t)pBytes[1] << 8 |
+                                   (uint32_t)pBytes[2] << 16 | (uint32_t)pBytes[3] << 24);
+        const uint32_t hi =        (uint32_t)pBytes[4]       | (uint32_t)pBytes[5] << 8 |
+                                   (uint32_t)pBytes[6] << 16 | (uint32_t)pBytes[7] << 24;
+
+        crc = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^ t[5][(lo >> 16) & 0xff] ^ t[4][lo >> 24] ^
+              t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^ t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+    }
+
+    while(size--)
+        crc = t[0][(crc ^ *pBytes++) & 0xff] ^ (crc >> 8);
+
+    return crc;
+}
+
+#if defined(GBL_HASH_X86_)
+/* Folds 64 bytes at a time with carry-less multiplication, as described in
+   "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction"
+   (Gopal et al., Intel, 2009). Requires size >= 64 and a multiple of 16. */
+GBL_HASH_TARGET_PCLMUL_
+static uint32_t gblHashCrcPclmul_(uint32_t crc, const uint8_t* pBytes, size_t size) {
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+    const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163cd6124);
+    const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+    const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    __m128i x1 = _mm_loadu_si128((const __m128i*)(pBytes + 0x00));
+    __m128i x2 = _mm_loadu_si128((const __m128i*)(pBytes + 0x10));
+    __m128i x3 = _mm_loadu_si128((const __m128i*)(pBytes + 0x20));
+    __m128i x4 = _mm_loadu_si128((const __m128i*)(pBytes + 0x30));
+    __m128i x5, x6, x7, x8;
+
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+
+    for(pBytes += 64, size -= 64; size >= 64; pBytes += 64, size -= 64) {
+        x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*)(pBytes + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i*)(pBytes + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i*)(pBytes + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i*)(pBytes + 0x30)));
+    }
+
+    // fold the 4 lanes down into a single 128-bit one
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    // fold in any remaining 16-byte blocks
+    for(; size >= 16; pBytes += 16, size -= 16) {
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i*)pBytes)), x5);
+    }
+
+    // fold 128 bits down to 64
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask);
+    x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction down to 32 bits
+    x2 = _mm_and_si128(x1, mask);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+
+GBL_HASH_TARGET_SSE42_
+static uint32_t gblHashCrc32cSse42_(uint32_t crc, const uint8_t* pBytes, size_t size) {
+#   if defined(__x86_64__) || defined(_M_X64)
+    uint64_t crc64 = crc;
+    for(; size >= 8; pBytes += 8, size -= 8) {
+        uint64_t word;
+        memcpy(&word, pBytes, sizeof(uint64_t));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc = (uint32_t)crc64;
+#   endif
+    for(; size >= 4; pBytes += 4, size -= 4) {
+        uint32_t word;
+        memcpy(&word, pBytes, sizeof(uint32_t));
+        crc = _mm_crc32_u32(crc, word);
+    }
+
+    while(size--)
+        crc = _mm_crc32_u8(crc, *pBytes++);
+
+    return crc;
+}
+
+// Interleaves the CRC-32C of several keys, since each crc32 instruction has a 3-cycle latency
+GBL_HASH_TARGET_SSE42_
+static void gblHashManyCrc32cSse42_(const uint8_t* pKeys, size_t keySize, size_t stride, size_t count, GblHash* pHashes) {
+    size_t k = 0;
+
+    for(; k + 4 <= count; k += 4) {
+        const uint8_t* pKey = pKeys + k * stride;
+        uint32_t crc[4] = { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff };
+        size_t   b      = 0;
+
+        for(; b + 4 <= keySize; b += 4)
+            for(size_t l = 0; l < 4; ++l) {
+                uint32_t word;
+                memcpy(&word, pKey + l * stride + b, sizeof(uint32_t));
+                crc[l] = _mm_crc32_u32(crc[l], word);
+            }
+
+        for(; b < keySize; ++b)
+            for(size_t l = 0; l < 4; ++l)
+                crc[l] = _mm_crc32_u8(crc[l], pKey[l * stride + b]);
+
+        for(size_t l = 0; l < 4; ++l)
+            pHashes[k + l] = ~crc[l];
+    }
+
+    for(; k < count; ++k)
+        pHashes[k] = ~gblHashCrc32cSse42_(0xffffffff, pKeys + k * stride, keySize);
+}
+
+#elif defined(GBL_HASH_ARM_)
+#   define GBL_HASH_ARM_CRC_(name, insnWord, insnByte)                                 \
+        GBL_HASH_TARGET_CRC_                                                            \
+        static uint32_t name(uint32_t crc, const uint8_t* pBytes, size_t size) {        \
+            for(; size >= 8; pBytes += 8, size -= 8) {                                  \
+                uint64_t word;                                                          \
+                memcpy(&word, pBytes, sizeof(uint64_t));                                \
+                __asm__(insnWord " %w0, %w0, %x1" : "+r"(crc) : "r"(word));             \
+            }                                                                           \
+            for(; size; ++pBytes, --size)                                               \
+                __asm__(insnByte " %w0, %w0, %w1" : "+r"(crc) : "r"((uint32_t)*pBytes));\
+            return crc;                                                                 \
+        }
+
+GBL_HASH_ARM_CRC_(gblHashCrcArm_,    "crc32x",  "crc32b")
+GBL_HASH_ARM_CRC_(gblHashCrc32cArm_, "crc32cx", "crc32cb")
+
+#   undef GBL_HASH_ARM_CRC_
+#endif
+
+// Updates a raw (non-inverted) CRC-32 register with the given bytes
+static uint32_t gblHashCrc32Update_(uint32_t crc, const uint8_t* pBytes, size_t size) {
+#if defined(GBL_HASH_X86_)
+    if(size >= GBL_HASH_PCLMUL_MIN_SIZE_ && (gblHashCpuFeatures_() & GBL_HASH_CPU_CRC32_)) {
+        const size_t blocks = size & ~(size_t)15;
+        crc     = gblHashCrcPclmul_(crc, pBytes, blocks);
+        pBytes += blocks;
+        size   -= blocks;
+    }
+#elif defined(GBL_HASH_ARM_)
+    if(gblHashCpuFeatures_() & GBL_HASH_CPU_CRC32_)
+        return gblHashCrcArm_(crc, pBytes, size);
+#endif
+    return gblHashCrcSliced_(crc, pBytes, size, gblHashCrcTables_()->crc32);
+}
+
+// Updates a raw (non-inverted) CRC-32C register with the given bytes
+static uint32_t gblHashCrc32cUpdate_(uint32_t crc, const uint8_t* pBytes, size_t size) {
+#if defined(GBL_HASH_X86_)
+    if(gblHashCpuFeatures_() & GBL_HASH_CPU_CRC32C_)
+        return gblHashCrc32cSse42_(crc, pBytes, size);
+#elif defined(GBL_HASH_ARM_)
+    if(gblHashCpuFeatures_() & GBL_HASH_CPU_CRC32C_)
+        return gblHashCrc32cArm_(crc, pBytes, size);
+#endif
+    return gblHashCrcSliced_(crc, pBytes, size, gblHashCrcTables_()->crc32c);
+}
 
 GBL_EXPORT GblHash gblHash32Bit(uint32_t value) {
     value ^= value >> 16;
@@ -163,51 +459,17 @@ GBL_EXPORT GblHash gblHashMurmur(const void* pData, size_t  size) {
     return out;
 }
 
-GBL_MAYBE_UNUSED GBL_INLINE GblHash gblCrc32LittleEndian(const void* pData, size_t size) {
-    size_t  i;
-    uint32_t rv = 0xFFFFFFFF;
-
-    for(i = 0; i < size; ++i) {
-        rv ^= *((uint8_t*)pData + i);
-        rv = (0xEDB88320 & (-(rv & 1))) ^(rv >> 1);
-        rv = (0xEDB88320 & (-(rv & 1))) ^(rv >> 1);
-        rv = (0xEDB88320 & (-(rv & 1))) ^(rv >> 1);
-        rv = (0xEDB88320 & (-(rv & 1))) ^(rv >> 1);
-        rv = (0xEDB88320 & (-(rv & 1))) ^(rv >> 1);
-        rv = (0xEDB88320 & (-(rv & 1))) ^(rv >> 1);
-        rv = (0xEDB88320 & (-(rv & 1))) ^(rv >> 1);
-        rv = (0xEDB88320 & (-(rv & 1))) ^(rv >> 1);
-    }
-
-     return ~rv;
+GBL_EXPORT GblHash gblHashCrc(const void* pData, size_t size) {
+    return gblHashCrcPartial(pData, size, NULL);
 }
 
-/* This one isn't quite as nice as the one above for little-endian... */
-GBL_MAYBE_UNUSED GBL_INLINE GblHash gblCrc32BigEndian(const void *pData, int size) {
-    int i, j;
-    uint32_t rv = 0xFFFFFFFF, b, c;
-
-    for(i = 0; i < size; ++i) {
-        b = *(uint8_t*)pData+i;
-
-        for(j = 0; j < 8; ++j) {
-            c = ((rv & 0x80000000) ? 1 : 0) ^(b & 1);
-            b >>= 1;
-
-            if(c)   rv = ((rv << 1) ^ 0x04C11DB6) | c;
-            else    rv <<= 1;
-        }
-    }
-
-    return rv;
+GBL_EXPORT uint32_t gblHashCrcPartial(const void* pData, size_t size, uint32_t* pPartial) {
+    const uint32_t crc = pPartial? *pPartial : 0;
+    return ~gblHashCrc32Update_(~crc, (const uint8_t*)pData, size);
 }
 
-GBL_EXPORT GblHash gblHashCrc(const void* pData, size_t size) {
-#if GBL_BIG_ENDIAN == 0
-    return gblCrc32LittleEndian(pData, size);
-#else
-    return gblCrc32BigEndian(pData, size);
-#endif
+GBL_EXPORT GblHash gblHashCrc32c(const void* pData, size_t size) {
+    return ~gblHashCrc32cUpdate_(0xffffffff, (const uint8_t*)pData, size);
 }
 
 //-----------------------------------------------------------------------------
@@ -394,5 +656,56 @@ GBL_EXPORT GblHash gblHashXx(const void* pData, size_t size) {
     return XXH32(pData, size, gblSeed(0));
 }
 
+GBL_EXPORT uint64_t gblHashXx3_64(const void* pData, size_t size) {
+    return XXH3_64bits_withSeed(pData, size, gblSeed(0));
+}
+
+// Runs GBL_HASH_MANY_LANES_ independent FNV1 chains at once, rather than waiting on each multiply
+static void gblHashManyFnv1_(const uint8_t* pKeys, size_t keySize, size_t stride, size_t count, GblHash* pHashes) {
+    size_t k = 0;
+
+    for(; k + GBL_HASH_MANY_LANES_ <= count; k += GBL_HASH_MANY_LANES_) {
+        const uint8_t* pKey = pKeys + k * stride;
+        uint32_t       hash[GBL_HASH_MANY_LANES_];
 
+        for(size_t l = 0; l < GBL_HASH_MANY_LANES_; ++l)
+            hash[l] = 0x811C9DC5;
 
+        for(size_t b = 0; b < keySize; ++b)
+            for(size_t l = 0; l < GBL_HASH_MANY_LANES_; ++l)
+                hash[l] = (hash[l] * 0x01000193) ^ pKey[l * stride + b];
+
+        for(size_t l = 0; l < GBL_HASH_MANY_LANES_; ++l)
+            pHashes[k + l] = hash[l];
+    }
+
+    for(; k < count; ++k)
+        pHashes[k] = gblHashFnv1(pKeys + k * stride, keySize);
+}
+
+GBL_EXPORT void gblHashMany(GblHashFn   pFnHash,
+                            const void* pKeys,
+                            size_t      keySize,
+                            size_t      stride,
+                            size_t      count,
+                            GblHash*    pHashes)
+{
+    const uint8_t* pBytes = (const uint8_t*)pKeys;
+
+    if(!pFnHash) pFnHash = gblHash;
+    if(!stride)  stride  = keySize;
+
+    if(pFnHash == gblHashFnv1) {
+        gblHashManyFnv1_(pBytes, keySize, stride, count, pHashes);
+#if defined(GBL_HASH_X86_)
+    } else if(pFnHash == gblHashCrc32c && (gblHashCpuFeatures_() & GBL_HASH_CPU_CRC32C_)) {
+        gblHashManyCrc32cSse42_(pBytes, keySize, stride, count, pHashes);
+#endif
+    } else {
+        for(size_t k = 0; k < count; ++k) {
+            if(k + 1 < count)
+                GBL_PREFETCH(pBytes + (k + 1) * stride);
+            pHashes[k] = pFnHash(pBytes + k * stride, keySize);
+        }
+    }
+}
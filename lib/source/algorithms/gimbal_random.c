@@ -1,9 +1,11 @@
 #include <gimbal/algorithms/gimbal_random.h>
 #include <gimbal/algorithms/gimbal_hash.h>
+#include <gimbal/core/gimbal_tls.h>
 #include <math.h>
 #include <time.h>
 #include <string.h>
 #include <float.h>
+#include <stdatomic.h>
 
 #define LEHMER_MODULUS    2147483647 /* DON'T CHANGE THIS VALUE                  */
 #define LEHMER_MULTIPLIER 48271      /* DON'T CHANGE THIS VALUE                  */
@@ -12,26 +14,195 @@
 #define LEHMER_A256       22925      /* jump multiplier, DON'T CHANGE THIS VALUE */
 #define LEHMER_DEFAULT    123456789  /* initial seed, use 0 < DEFAULT < MODULUS  */
 
-static uint64_t seeds_[GBL_SEED_COUNT] = { LEHMER_DEFAULT };
-static uint64_t lehmerSeed_ = LEHMER_DEFAULT;
-static GblBool  init_ = GBL_FALSE;
-static GblRandomGeneratorFn generator_ = GBL_RAND_GENERATOR_DEFAULT;
+#define GBL_RAND_LANES_   4          // # of interleaved xoshiro256** streams stepped together (4 x 64 = 256 bits)
+#define GBL_RAND_LANES_DOMAIN_  UINT64_C(0x6c616e6573676268) // separates lane seeds from anything else seeded off a stream
+
+// Per-thread generator state
+typedef struct GblRandThread_ {
+    GblRandState scalar;                        // stream driving gblRand64() and gblRandXoshiro()
+    uint64_t     lanes[4][GBL_RAND_LANES_];     // SoA xoshiro256** states driving the batch methods
+    uint64_t     lehmer;                        // Lehmer generator seed
+    GblBool      seeded;
+} GblRandThread_;
+
+static uint64_t             seeds_[GBL_SEED_COUNT] = { LEHMER_DEFAULT };
+static atomic_int           seedsInit_             = 0;
+static GblRandomGeneratorFn generator_             = GBL_RAND_GENERATOR_DEFAULT;
+static atomic_flag          streamsLock_           = ATOMIC_FLAG_INIT;
+static GblBool              streamsInit_           = GBL_FALSE;
+static GblRandState         streams_;
+
+static GBL_TLS(GblRandThread_, thread_, { .lehmer = LEHMER_DEFAULT, .seeded = GBL_FALSE });
+
+GBL_INLINE uint64_t gblRandRotl_(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+GBL_INLINE uint64_t gblRandSplitMix64_(uint64_t* pSeed) {
+    uint64_t z = (*pSeed += UINT64_C(0x9e3779b97f4a7c15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+    return z ^ (z >> 31);
+}
+
+GBL_EXPORT void GblRandState_seed(GblRandState* pSelf, uint64_t seed) {
+    // SplitMix64, so that similar seeds still yield uncorrelated states
+    for(unsigned i = 0; i < 4; ++i)
+        pSelf->s[i] = gblRandSplitMix64_(&seed);
+}
+
+GBL_EXPORT uint64_t GblRandState_next(GblRandState* pSelf) {
+    uint64_t* s = pSelf->s;
+    const uint64_t result = gblRandRotl_(s[1] * 5, 7) * 9;
+    const uint64_t t      = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3]  = gblRandRotl_(s[3], 45);
+
+    return result;
+}
+
+static void GblRandState_jump_(GblRandState* pSelf, const uint64_t poly[4]) {
+    uint64_t s[4] = { 0 };
+
+    for(unsigned i = 0; i < 4; ++i)
+        for(unsigned b = 0; b < 64; ++b) {
+            if(poly[i] & (UINT64_C(1) << b))
+                for(unsigned w = 0; w < 4; ++w)
+                    s[w] ^= pSelf->s[w];
+
+            GblRandState_next(pSelf);
+        }
+
+    memcpy(pSelf->s, s, sizeof(s));
+}
+
+GBL_EXPORT void GblRandState_jump(GblRandState* pSelf) {
+    static const uint64_t poly[4] = {
+        UINT64_C(0x180ec6d33cfd0aba), UINT64_C(0xd5a61266f0c9392c),
+        UINT64_C(0xa9582618e03fc9aa), UINT64_C(0x39abdc4529b1661c)
+    };
+
+    GblRandState_jump_(pSelf, poly);
+}
+
+GBL_EXPORT void GblRandState_longJump(GblRandState* pSelf) {
+    static const uint64_t poly[4] = {
+        UINT64_C(0x76e15d3efefdcbbf), UINT64_C(0xc5004e441c522fb3),
+        UINT64_C(0x77710069854ee241), UINT64_C(0x39109bb02acbe635)
+    };
+
+    GblRandState_jump_(pSelf, poly);
+}
+
+GBL_EXPORT void GblRandState_split(GblRandState* pSelf, size_t count, GblRandState* pStreams) {
+    for(size_t i = 0; i < count; ++i) {
+        pStreams[i] = *pSelf;
+        GblRandState_jump(pSelf);
+    }
+}
+
+/* Derives the thread's interleaved lanes from its scalar stream. Jumping along
+   the scalar stream would land the lanes on the very streams which
+   GblRandState_split(gblRandState(), ...) hands out, so they're seeded from a
+   domain-separated hash of its state instead, starting at unrelated points. */
+static void gblRandDeriveLanes_(GblRandThread_* pThread) {
+    uint64_t seed = GBL_RAND_LANES_DOMAIN_;
+
+    for(unsigned w = 0; w < 4; ++w) {
+        seed ^= pThread->scalar.s[w];
+        seed  = gblRandSplitMix64_(&seed);
+    }
+
+    for(unsigned l = 0; l < GBL_RAND_LANES_; ++l)
+        for(unsigned w = 0; w < 4; ++w)
+            pThread->lanes[w][l] = gblRandSplitMix64_(&seed);
+}
+
+// Hands each new thread its own 2^192 long slice of the default stream, in order of first use
+static GBL_NO_INLINE void gblRandSeedThread_(GblRandThread_* pThread) {
+    while(atomic_flag_test_and_set_explicit(&streamsLock_, memory_order_acquire));
+
+    if GBL_UNLIKELY(!streamsInit_) {
+        GblRandState_seed(&streams_, GBL_RAND_SEED_DEFAULT);
+        streamsInit_ = GBL_TRUE;
+    }
+
+    pThread->scalar = streams_;
+    GblRandState_longJump(&streams_);
+
+    atomic_flag_clear_explicit(&streamsLock_, memory_order_release);
+
+    gblRandDeriveLanes_(pThread);
+    pThread->seeded = GBL_TRUE;
+}
+
+GBL_INLINE GblRandThread_* gblRandThread_(void) {
+    GblRandThread_* pThread = GBL_TLS_LOAD(thread_);
+
+    if GBL_UNLIKELY(!pThread->seeded)
+        gblRandSeedThread_(pThread);
+
+    return pThread;
+}
+
+// Steps all lanes at once, written as independent per-lane loops (and multiplies as shifts) so they vectorize
+GBL_INLINE void gblRandLanesNext_(uint64_t s[4][GBL_RAND_LANES_], uint64_t* pOut) {
+    for(unsigned l = 0; l < GBL_RAND_LANES_; ++l) {
+        const uint64_t x5 = s[1][l] + (s[1][l] << 2);
+        const uint64_t r  = (x5 << 7) | (x5 >> 57);
+        pOut[l] = r + (r << 3);
+    }
+
+    for(unsigned l = 0; l < GBL_RAND_LANES_; ++l) {
+        const uint64_t t = s[1][l] << 17;
+
+        s[2][l] ^= s[0][l];
+        s[3][l] ^= s[1][l];
+        s[1][l] ^= s[2][l];
+        s[0][l] ^= s[3][l];
+        s[2][l] ^= t;
+        s[3][l]  = (s[3][l] << 45) | (s[3][l] >> 19);
+    }
+}
+
+GBL_EXPORT GblRandState* gblRandState(void) {
+    return &gblRandThread_()->scalar;
+}
+
+GBL_EXPORT void gblRandSetState(const GblRandState* pState) {
+    GblRandThread_* pThread = GBL_TLS_LOAD(thread_);
+
+    pThread->scalar = *pState;
+    gblRandDeriveLanes_(pThread);
+    pThread->seeded = GBL_TRUE;
+}
+
+GBL_EXPORT uint64_t gblRand64(void) {
+    return GblRandState_next(&gblRandThread_()->scalar);
+}
 
 static double gblRandLehmer_(void) {
+    GblRandThread_* pThread = GBL_TLS_LOAD(thread_);
+    uint64_t*       pSeed   = &pThread->lehmer;
 
     const long Q = LEHMER_MODULUS / LEHMER_MULTIPLIER;
     const long R = LEHMER_MODULUS % LEHMER_MULTIPLIER;
           long t;
 
-    t = LEHMER_MULTIPLIER * (lehmerSeed_ % Q) - R * (lehmerSeed_ / Q);
+    t = LEHMER_MULTIPLIER * (*pSeed % Q) - R * (*pSeed / Q);
 
     if (t > 0)
-      lehmerSeed_ = t;
+      *pSeed = t;
     else
-      lehmerSeed_ = t + LEHMER_MODULUS;
+      *pSeed = t + LEHMER_MODULUS;
 
     // returns a number between 0.0f and 1.0f
-    return ((double) lehmerSeed_ / (double)LEHMER_MODULUS);
+    return ((double) *pSeed / (double)LEHMER_MODULUS);
 }
 
 GBL_EXPORT int gblRandLibC(void) {
@@ -42,15 +213,28 @@ GBL_EXPORT int gblRandLehmer(void) {
     return gblRandLehmer_() * RAND_MAX;
 }
 
-GBL_EXPORT uint64_t gblSeed(uint8_t index) {
-    if GBL_UNLIKELY(!init_) {
+GBL_EXPORT int gblRandXoshiro(void) {
+    return (int)((gblRand64() >> 32) % ((uint64_t)RAND_MAX + 1));
+}
+
+static GBL_NO_INLINE void gblSeedInit_(void) {
+    int expected = 0;
+
+    if(atomic_compare_exchange_strong_explicit(&seedsInit_, &expected, 1,
+                                               memory_order_acquire,
+                                               memory_order_relaxed)) {
         seeds_[0] = (uint64_t)time(NULL);
 
         for(unsigned i = 1; i < GBL_SEED_COUNT; ++i)
             seeds_[i] = gblHashCrc(&seeds_[i-1], sizeof(uint64_t));
 
-        init_ = GBL_TRUE;
-    }
+        atomic_store_explicit(&seedsInit_, 2, memory_order_release);
+    } else while(atomic_load_explicit(&seedsInit_, memory_order_acquire) != 2);
+}
+
+GBL_EXPORT uint64_t gblSeed(uint8_t index) {
+    if GBL_UNLIKELY(atomic_load_explicit(&seedsInit_, memory_order_acquire) != 2)
+        gblSeedInit_();
 
     return seeds_[index];
 }
@@ -65,6 +249,11 @@ GBL_EXPORT void gblSetRand(GblRandomGeneratorFn pGen) {
 
 GBL_EXPORT void gblSeedRand(uint8_t index, uint64_t seed) {
     GBL_ASSERT(index < GBL_COUNT_OF(seeds_));
+
+    // don't let the lazy initialization clobber the given seed later
+    if GBL_UNLIKELY(atomic_load_explicit(&seedsInit_, memory_order_acquire) != 2)
+        gblSeedInit_();
+
     seeds_[index] = seed;
 }
 
@@ -96,8 +285,20 @@ GBL_EXPORT int gblRandString(char* pBuffer, int minSize, int maxSize, const char
 }
 
 GBL_EXPORT void gblRandBuffer(void* pData, size_t size) {
-    for(size_t  i = 0; i < size; ++i) {
-        (((uint8_t*)pData)[i]) = (uint8_t)gblRandEquilikely(0, 255);
+    GblRandThread_* pThread = gblRandThread_();
+    uint8_t*        pBytes  = pData;
+    uint64_t        block[GBL_RAND_LANES_];
+
+    while(size >= sizeof(block)) {
+        gblRandLanesNext_(pThread->lanes, block);
+        memcpy(pBytes, block, sizeof(block));
+        pBytes += sizeof(block);
+        size   -= sizeof(block);
+    }
+
+    if(size) {
+        gblRandLanesNext_(pThread->lanes, block);
+        memcpy(pBytes, block, size);
     }
 }
 
@@ -196,6 +397,49 @@ GBL_EXPORT float gblRandNormal(float m, float s) {
     return m + (s * z);
 }
 
+// Two floats in [0, 1) per 64-bit number, from the top 24 bits of each half
+#define GBL_RAND_UNIT_HI_(x)    ((float)((x) >> 40)              * 0x1.0p-24f)
+#define GBL_RAND_UNIT_LO_(x)    ((float)(((x) >> 8) & 0xffffff)  * 0x1.0p-24f)
+
+GBL_EXPORT void gblRandUniformN(float* pValues, size_t count, float a, float b) {
+    GblRandThread_* pThread = gblRandThread_();
+    const float     range   = b - a;
+    uint64_t        block[GBL_RAND_LANES_];
+
+    while(count) {
+        gblRandLanesNext_(pThread->lanes, block);
+
+        for(unsigned l = 0; l < GBL_RAND_LANES_ && count; ++l) {
+            *pValues++ = a + range * GBL_RAND_UNIT_HI_(block[l]);
+            if(!--count) break;
+            *pValues++ = a + range * GBL_RAND_UNIT_LO_(block[l]);
+            --count;
+        }
+    }
+}
+
+// Box-Muller transform, yielding a pair of normals per 64-bit number
+GBL_EXPORT void gblRandNormalN(float* pValues, size_t count, float m, float s) {
+    GblRandThread_* pThread = gblRandThread_();
+    const float     twoPi   = 6.283185307179586f;
+    uint64_t        block[GBL_RAND_LANES_];
+
+    while(count) {
+        gblRandLanesNext_(pThread->lanes, block);
+
+        for(unsigned l = 0; l < GBL_RAND_LANES_ && count; ++l) {
+            const float u1    = 1.0f - GBL_RAND_UNIT_HI_(block[l]); // (0, 1], for the log
+            const float theta = twoPi * GBL_RAND_UNIT_LO_(block[l]);
+            const float r     = s * sqrtf(-2.0f * logf(u1));
+
+            *pValues++ = m + r * cosf(theta);
+            if(!--count) break;
+            *pValues++ = m + r * sinf(theta);
+            --count;
+        }
+    }
+}
+
 GBL_EXPORT float gblRandLogNormal(float a, float b) {
     return (exp(a + b * gblRandNormal(0.0f, 1.0f)));
 }
@@ -1,55 +1,679 @@
 #include <gimbal/algorithms/gimbal_sort.h>
+#include <gimbal/core/gimbal_ctx.h>
+#include <gimbal/core/gimbal_main_loop.h>
 #include <string.h>
-#include <stdio.h>
 
-GBL_EXPORT void gblSortMerge(void* pArray, size_t count, size_t elemSize, GblSortComparatorFn pFnCmp) {
-    uint8_t* pFirstHalf;
-    uint8_t* pEofFirstHalf;
-    uint8_t* pSecondHalf;
-    uint8_t* pEofSecondHalf;
-    uint8_t* pResultBuffer, *pResult;
-    size_t   halfSize;
+#define GBL_SORT_INSERTION_THRESHOLD_       24
+#define GBL_SORT_NINTHER_THRESHOLD_         128
+#define GBL_SORT_PARTIAL_INSERTION_LIMIT_   8
+#define GBL_SORT_MERGE_RUN_                 32
+#define GBL_SORT_MERGE_ALLOCA_MAX_          4096
+#define GBL_SORT_RADIX_BITS_                8
+#define GBL_SORT_RADIX_BUCKETS_             (1 << GBL_SORT_RADIX_BITS_)
+#define GBL_SORT_RADIX_PASSES_              (64 / GBL_SORT_RADIX_BITS_)
+
+#define GBL_SORT_AT_(base, size, index)     ((uint8_t*)(base) + (size) * (index))
+
+// size is a compile-time constant for the specialized instantiations, folding away all but one branch
+GBL_FORCE_INLINE void gblSortSwap_(uint8_t* pA, uint8_t* pB, size_t size) {
+    if(size == sizeof(uint32_t)) {
+        uint32_t temp;
+        memcpy(&temp, pA, sizeof(uint32_t));
+        memcpy(pA, pB, sizeof(uint32_t));
+        memcpy(pB, &temp, sizeof(uint32_t));
+    } else if(size == sizeof(uint64_t)) {
+        uint64_t temp;
+        memcpy(&temp, pA, sizeof(uint64_t));
+        memcpy(pA, pB, sizeof(uint64_t));
+        memcpy(pB, &temp, sizeof(uint64_t));
+    } else if(size == 2 * sizeof(uint64_t)) {
+        uint64_t temp[2];
+        memcpy(temp, pA, sizeof(temp));
+        memcpy(pA, pB, sizeof(temp));
+        memcpy(pB, temp, sizeof(temp));
+    } else {
+        uint8_t temp[64];
+        while(size) {
+            const size_t chunk = GBL_MIN(size, sizeof(temp));
+            memcpy(temp, pA, chunk);
+            memcpy(pA, pB, chunk);
+            memcpy(pB, temp, chunk);
+            pA += chunk; pB += chunk; size -= chunk;
+        }
+    }
+}
 
-    if(count <= 1) return;
+GBL_FORCE_INLINE GblBool gblSortLess_(const void* pA, const void* pB, GblSortComparatorFn pFnCmp) {
+    return pFnCmp(pA, pB) < 0;
+}
+
+GBL_FORCE_INLINE void gblSortSort2_(uint8_t* pA, uint8_t* pB, size_t size, GblSortComparatorFn pFnCmp) {
+    if(gblSortLess_(pB, pA, pFnCmp)) gblSortSwap_(pA, pB, size);
+}
+
+GBL_FORCE_INLINE void gblSortSort3_(uint8_t* pA, uint8_t* pB, uint8_t* pC, size_t size, GblSortComparatorFn pFnCmp) {
+    gblSortSort2_(pA, pB, size, pFnCmp);
+    gblSortSort2_(pB, pC, size, pFnCmp);
+    gblSortSort2_(pA, pB, size, pFnCmp);
+}
+
+GBL_FORCE_INLINE void gblSortInsertion_(uint8_t* pBegin, uint8_t* pEnd, size_t size, GblSortComparatorFn pFnCmp, uint8_t* pTemp) {
+    if(pBegin == pEnd) return;
+
+    for(uint8_t* pCur = pBegin + size; pCur != pEnd; pCur += size) {
+        uint8_t* pSift = pCur;
+
+        if(gblSortLess_(pSift, pSift - size, pFnCmp)) {
+            memcpy(pTemp, pSift, size);
+
+            do {
+                memcpy(pSift, pSift - size, size);
+                pSift -= size;
+            } while(pSift != pBegin && gblSortLess_(pTemp, pSift - size, pFnCmp));
+
+            memcpy(pSift, pTemp, size);
+        }
+    }
+}
+
+// insertion sort which gives up after moving too many elements, returning whether it finished
+GBL_FORCE_INLINE GblBool gblSortPartialInsertion_(uint8_t* pBegin, uint8_t* pEnd, size_t size, GblSortComparatorFn pFnCmp, uint8_t* pTemp) {
+    if(pBegin == pEnd) return GBL_TRUE;
+
+    size_t moves = 0;
+
+    for(uint8_t* pCur = pBegin + size; pCur != pEnd; pCur += size) {
+        uint8_t* pSift = pCur;
+
+        if(gblSortLess_(pSift, pSift - size, pFnCmp)) {
+            memcpy(pTemp, pSift, size);
+
+            do {
+                memcpy(pSift, pSift - size, size);
+                pSift -= size;
+            } while(pSift != pBegin && gblSortLess_(pTemp, pSift - size, pFnCmp));
+
+            memcpy(pSift, pTemp, size);
+            moves += (size_t)(pCur - pSift) / size;
+        }
+
+        if(moves > GBL_SORT_PARTIAL_INSERTION_LIMIT_) return GBL_FALSE;
+    }
+
+    return GBL_TRUE;
+}
+
+GBL_FORCE_INLINE void gblSortHeapSiftDown_(uint8_t* pBase, size_t pos, size_t count, size_t size, GblSortComparatorFn pFnCmp, uint8_t* pTemp) {
+    memcpy(pTemp, GBL_SORT_AT_(pBase, size, pos), size);
+
+    while(1) {
+        size_t child = pos * 2 + 1;
+        if(child >= count) break;
+
+        if(child + 1 < count &&
+           gblSortLess_(GBL_SORT_AT_(pBase, size, child), GBL_SORT_AT_(pBase, size, child + 1), pFnCmp))
+            ++child;
+
+        if(!gblSortLess_(pTemp, GBL_SORT_AT_(pBase, size, child), pFnCmp)) break;
+
+        memcpy(GBL_SORT_AT_(pBase, size, pos), GBL_SORT_AT_(pBase, size, child), size);
+        pos = child;
+    }
+
+    memcpy(GBL_SORT_AT_(pBase, size, pos), pTemp, size);
+}
+
+// worst-case fallback once partitioning keeps going badly
+GBL_FORCE_INLINE void gblSortHeapFallback_(uint8_t* pBase, size_t count, size_t size, GblSortComparatorFn pFnCmp, uint8_t* pTemp) {
+    for(size_t p = count / 2; p-- > 0; )
+        gblSortHeapSiftDown_(pBase, p, count, size, pFnCmp, pTemp);
+
+    for(size_t last = count; last-- > 1; ) {
+        gblSortSwap_(pBase, GBL_SORT_AT_(pBase, size, last), size);
+        gblSortHeapSiftDown_(pBase, 0, last, size, pFnCmp, pTemp);
+    }
+}
+
+// partitions around *pBegin, putting elements equal to it on the right, returns its final position
+GBL_FORCE_INLINE uint8_t* gblSortPartitionRight_(uint8_t* pBegin, uint8_t* pEnd, size_t size, GblSortComparatorFn pFnCmp, uint8_t* pPivot, GblBool* pAlreadyPartitioned) {
+    uint8_t* pFirst = pBegin;
+    uint8_t* pLast  = pEnd;
+
+    memcpy(pPivot, pBegin, size);
+
+    // pivot selection left something no smaller than the pivot at the end
+    while(gblSortLess_((pFirst += size), pPivot, pFnCmp));
+
+    if(pFirst - size == pBegin)
+        while(pFirst < pLast && !gblSortLess_((pLast -= size), pPivot, pFnCmp));
+    else
+        while(!gblSortLess_((pLast -= size), pPivot, pFnCmp));
+
+    *pAlreadyPartitioned = pFirst >= pLast;
+
+    while(pFirst < pLast) {
+        gblSortSwap_(pFirst, pLast, size);
+        while(gblSortLess_((pFirst += size), pPivot, pFnCmp));
+        while(!gblSortLess_((pLast -= size), pPivot, pFnCmp));
+    }
+
+    uint8_t* pPivotPos = pFirst - size;
+    memcpy(pBegin, pPivotPos, size);
+    memcpy(pPivotPos, pPivot, size);
+    return pPivotPos;
+}
+
+// partitions around *pBegin, putting elements equal to it on the left, returns its final position
+GBL_FORCE_INLINE uint8_t* gblSortPartitionLeft_(uint8_t* pBegin, uint8_t* pEnd, size_t size, GblSortComparatorFn pFnCmp, uint8_t* pPivot) {
+    uint8_t* pFirst = pBegin;
+    uint8_t* pLast  = pEnd;
+
+    memcpy(pPivot, pBegin, size);
+
+    while(gblSortLess_(pPivot, (pLast -= size), pFnCmp));
+
+    if(pLast + size == pEnd)
+        while(pFirst < pLast && !gblSortLess_(pPivot, (pFirst += size), pFnCmp));
+    else
+        while(!gblSortLess_(pPivot, (pFirst += size), pFnCmp));
+
+    while(pFirst < pLast) {
+        gblSortSwap_(pFirst, pLast, size);
+        while(gblSortLess_(pPivot, (pLast -= size), pFnCmp));
+        while(!gblSortLess_(pPivot, (pFirst += size), pFnCmp));
+    }
+
+    memcpy(pBegin, pLast, size);
+    memcpy(pLast, pPivot, size);
+    return pLast;
+}
+
+// breaks up patterns which led to an unbalanced partition
+GBL_FORCE_INLINE void gblSortShuffle_(uint8_t* pBegin, uint8_t* pEnd, size_t count, size_t size) {
+    const size_t quarter = count / 4;
+
+    gblSortSwap_(pBegin,      pBegin + quarter * size, size);
+    gblSortSwap_(pEnd - size, pEnd - quarter * size,   size);
+
+    if(count > GBL_SORT_NINTHER_THRESHOLD_) {
+        gblSortSwap_(pBegin + size,     pBegin + (quarter + 1) * size, size);
+        gblSortSwap_(pBegin + 2 * size, pBegin + (quarter + 2) * size, size);
+        gblSortSwap_(pEnd - 2 * size,   pEnd - (quarter + 1) * size,   size);
+        gblSortSwap_(pEnd - 3 * size,   pEnd - (quarter + 2) * size,   size);
+    }
+}
+
+typedef struct GblSortRange_ {
+    uint8_t* pBegin;
+    uint8_t* pEnd;
+    unsigned badAllowed;
+    GblBool  leftmost;
+} GblSortRange_;
+
+// pattern-defeating quicksort, always continuing with the smaller partition to bound the stack
+GBL_FORCE_INLINE void gblSortPdq_(uint8_t* pBase, size_t count, size_t size, GblSortComparatorFn pFnCmp, uint8_t* pTemp, uint8_t* pPivot) {
+    GblSortRange_ stack[64];
+    size_t        depth = 0;
+    unsigned      log2  = 0;
+
+    for(size_t n = count; n > 1; n >>= 1) ++log2;
+
+    stack[depth++] = (GblSortRange_){ pBase, pBase + count * size, log2, GBL_TRUE };
+
+    while(depth) {
+        GblSortRange_ range = stack[--depth];
+
+        while(1) {
+            const size_t n = (size_t)(range.pEnd - range.pBegin) / size;
+
+            if(n < GBL_SORT_INSERTION_THRESHOLD_) {
+                gblSortInsertion_(range.pBegin, range.pEnd, size, pFnCmp, pTemp);
+                break;
+            }
+
+            const size_t half = n / 2;
+            uint8_t*     pMid = range.pBegin + half * size;
+
+            if(n > GBL_SORT_NINTHER_THRESHOLD_) {
+                gblSortSort3_(range.pBegin,        pMid,        range.pEnd - size,     size, pFnCmp);
+                gblSortSort3_(range.pBegin + size, pMid - size, range.pEnd - 2 * size, size, pFnCmp);
+                gblSortSort3_(range.pBegin + 2 * size, pMid + size, range.pEnd - 3 * size, size, pFnCmp);
+                gblSortSort3_(pMid - size, pMid, pMid + size, size, pFnCmp);
+                gblSortSwap_(range.pBegin, pMid, size);
+            } else {
+                gblSortSort3_(pMid, range.pBegin, range.pEnd - size, size, pFnCmp);
+            }
+
+            // a pivot no greater than its predecessor means everything equal to it is already in place
+            if(!range.leftmost && !gblSortLess_(range.pBegin - size, range.pBegin, pFnCmp)) {
+                range.pBegin = gblSortPartitionLeft_(range.pBegin, range.pEnd, size, pFnCmp, pPivot) + size;
+                continue;
+            }
+
+            GblBool        alreadyPartitioned;
+            uint8_t*       pPivotPos = gblSortPartitionRight_(range.pBegin, range.pEnd, size, pFnCmp, pPivot, &alreadyPartitioned);
+            const size_t   leftCount  = (size_t)(pPivotPos - range.pBegin) / size;
+            const size_t   rightCount = n - leftCount - 1;
+
+            if(leftCount < n / 8 || rightCount < n / 8) {
+                if(!--range.badAllowed) {
+                    gblSortHeapFallback_(range.pBegin, n, size, pFnCmp, pTemp);
+                    break;
+                }
+
+                if(leftCount >= GBL_SORT_INSERTION_THRESHOLD_)
+                    gblSortShuffle_(range.pBegin, pPivotPos, leftCount, size);
+
+                if(rightCount >= GBL_SORT_INSERTION_THRESHOLD_)
+                    gblSortShuffle_(pPivotPos + size, range.pEnd, rightCount, size);
+
+            } else if(alreadyPartitioned &&
+                      gblSortPartialInsertion_(range.pBegin, pPivotPos, size, pFnCmp, pTemp) &&
+                      gblSortPartialInsertion_(pPivotPos + size, range.pEnd, size, pFnCmp, pTemp)) {
+                break;
+            }
+
+            const GblSortRange_ left  = { range.pBegin,     pPivotPos,  range.badAllowed, range.leftmost };
+            const GblSortRange_ right = { pPivotPos + size, range.pEnd, range.badAllowed, GBL_FALSE      };
+
+            if(leftCount < rightCount) {
+                stack[depth++] = right;
+                range          = left;
+            } else {
+                stack[depth++] = left;
+                range          = right;
+            }
+        }
+    }
+}
+
+static void gblSort4_(void* pArray, size_t count, GblSortComparatorFn pFnCmp) {
+    uint64_t temp, pivot;
+    gblSortPdq_(pArray, count, 4, pFnCmp, (uint8_t*)&temp, (uint8_t*)&pivot);
+}
 
-    halfSize = count / 2;
-    pFirstHalf = (uint8_t*)pArray;
-    pSecondHalf = (uint8_t*)pArray + (halfSize * elemSize);
+static void gblSort8_(void* pArray, size_t count, GblSortComparatorFn pFnCmp) {
+    uint64_t temp, pivot;
+    gblSortPdq_(pArray, count, 8, pFnCmp, (uint8_t*)&temp, (uint8_t*)&pivot);
+}
 
-    gblSortMerge(pFirstHalf, halfSize, elemSize, pFnCmp);
-    gblSortMerge(pSecondHalf, count-halfSize, elemSize, pFnCmp);
+static void gblSort16_(void* pArray, size_t count, GblSortComparatorFn pFnCmp) {
+    uint64_t temp[2], pivot[2];
+    gblSortPdq_(pArray, count, 16, pFnCmp, (uint8_t*)temp, (uint8_t*)pivot);
+}
 
-    pEofFirstHalf = pSecondHalf;
-    pEofSecondHalf = (uint8_t*)pArray + (count * elemSize);
-    pResultBuffer = (uint8_t*)GBL_ALLOCA(count * elemSize);
-    pResult = pResultBuffer;
+static void gblSortGeneric_(void* pArray, size_t count, size_t elemSize, GblSortComparatorFn pFnCmp) {
+    uint8_t* pTemp = GBL_ALLOCA(elemSize * 2);
+    gblSortPdq_(pArray, count, elemSize, pFnCmp, pTemp, pTemp + elemSize);
+}
 
-    while(pFirstHalf < pEofFirstHalf && pSecondHalf < pEofSecondHalf) {
-        if((*pFnCmp)(pFirstHalf, pSecondHalf) < 0) {
-            memcpy(pResult, pFirstHalf, elemSize);
-            pFirstHalf += elemSize;
+GBL_EXPORT void gblSort(void* pArray, size_t count, size_t elemSize, GblSortComparatorFn pFnCmp) {
+    if(count < 2) return;
+
+    switch(elemSize) {
+    case 4:  gblSort4_(pArray, count, pFnCmp);                 break;
+    case 8:  gblSort8_(pArray, count, pFnCmp);                 break;
+    case 16: gblSort16_(pArray, count, pFnCmp);                break;
+    default: gblSortGeneric_(pArray, count, elemSize, pFnCmp); break;
+    }
+}
+
+// stable merge of two sorted runs into pDst
+static void gblSortMergeRuns_(uint8_t*            pDst,
+                              const uint8_t*      pLeft,
+                              size_t              leftCount,
+                              const uint8_t*      pRight,
+                              size_t              rightCount,
+                              size_t              elemSize,
+                              GblSortComparatorFn pFnCmp)
+{
+    const uint8_t* pLeftEnd  = pLeft  + leftCount  * elemSize;
+    const uint8_t* pRightEnd = pRight + rightCount * elemSize;
+
+    while(pLeft < pLeftEnd && pRight < pRightEnd) {
+        if(gblSortLess_(pRight, pLeft, pFnCmp)) {
+            memcpy(pDst, pRight, elemSize);
+            pRight += elemSize;
         } else {
-            memcpy(pResult, pSecondHalf, elemSize);
-            pSecondHalf += elemSize;
+            memcpy(pDst, pLeft, elemSize);
+            pLeft += elemSize;
+        }
+        pDst += elemSize;
+    }
+
+    memcpy(pDst, pLeft, (size_t)(pLeftEnd - pLeft));
+    pDst += pLeftEnd - pLeft;
+    memcpy(pDst, pRight, (size_t)(pRightEnd - pRight));
+}
+
+GBL_EXPORT void gblSortMergeBuffer(void* pArray, size_t count, size_t elemSize, GblSortComparatorFn pFnCmp, void* pBuffer) {
+    if(count < 2) return;
+
+    uint8_t* pTemp = GBL_ALLOCA(elemSize);
+
+    // insertion sort is stable, so it can seed the initial runs
+    for(size_t r = 0; r < count; r += GBL_SORT_MERGE_RUN_)
+        gblSortInsertion_(GBL_SORT_AT_(pArray, elemSize, r),
+                          GBL_SORT_AT_(pArray, elemSize, GBL_MIN(r + GBL_SORT_MERGE_RUN_, count)),
+                          elemSize,
+                          pFnCmp,
+                          pTemp);
+
+    uint8_t* pSrc = pArray;
+    uint8_t* pDst = pBuffer;
+
+    for(size_t width = GBL_SORT_MERGE_RUN_; width < count; width *= 2) {
+        for(size_t l = 0; l < count; l += 2 * width) {
+            const size_t m = GBL_MIN(l + width, count);
+            const size_t r = GBL_MIN(l + 2 * width, count);
+
+            // runs which are already in order only need to be carried over
+            if(m == r || !gblSortLess_(GBL_SORT_AT_(pSrc, elemSize, m),
+                                       GBL_SORT_AT_(pSrc, elemSize, m - 1),
+                                       pFnCmp))
+                memcpy(GBL_SORT_AT_(pDst, elemSize, l), GBL_SORT_AT_(pSrc, elemSize, l), (r - l) * elemSize);
+            else
+                gblSortMergeRuns_(GBL_SORT_AT_(pDst, elemSize, l),
+                                  GBL_SORT_AT_(pSrc, elemSize, l),
+                                  m - l,
+                                  GBL_SORT_AT_(pSrc, elemSize, m),
+                                  r - m,
+                                  elemSize,
+                                  pFnCmp);
+        }
+
+        uint8_t* pSwap = pSrc;
+        pSrc = pDst;
+        pDst = pSwap;
+    }
+
+    if(pSrc != pArray) memcpy(pArray, pSrc, count * elemSize);
+}
+
+GBL_EXPORT void gblSortMerge(void* pArray, size_t count, size_t elemSize, GblSortComparatorFn pFnCmp) {
+    if(count < 2) return;
+
+    const size_t bytes = count * elemSize;
+
+    if(bytes <= GBL_SORT_MERGE_ALLOCA_MAX_) {
+        gblSortMergeBuffer(pArray, count, elemSize, pFnCmp, GBL_ALLOCA(bytes));
+        return;
+    }
+
+    GBL_CTX_BEGIN(NULL);
+
+    void* pBuffer = GBL_CTX_MALLOC(bytes);
+
+    // still sorted without the scratch space, just not stably
+    if(!pBuffer) {
+        gblSort(pArray, count, elemSize, pFnCmp);
+        GBL_CTX_DONE();
+    }
+
+    gblSortMergeBuffer(pArray, count, elemSize, pFnCmp, pBuffer);
+    GBL_CTX_FREE(pBuffer);
+
+    GBL_CTX_END_BLOCK();
+}
+
+GBL_EXPORT GBL_RESULT gblSortRadix(void* pArray, size_t count, size_t elemSize, GblSortKeyFn pFnKey) {
+    uint64_t* pKeys    = NULL;
+    uint8_t*  pScratch = NULL;
+
+    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_VERIFY_POINTER(pFnKey);
+
+    if(count < 2) GBL_CTX_DONE();
+
+    pKeys    = GBL_CTX_MALLOC(sizeof(uint64_t) * count * 2);
+    pScratch = GBL_CTX_MALLOC(elemSize * count);
+    GBL_CTX_VERIFY(pKeys && pScratch, GBL_RESULT_ERROR_MEM_ALLOC);
+
+    size_t    histograms[GBL_SORT_RADIX_PASSES_][GBL_SORT_RADIX_BUCKETS_] = { { 0 } };
+    uint64_t* pKeySrc  = pKeys;
+    uint64_t* pKeyDst  = pKeys + count;
+    uint8_t*  pSrc     = pArray;
+    uint8_t*  pDst     = pScratch;
+
+    // one pass to extract every key and count every digit
+    for(size_t e = 0; e < count; ++e) {
+        const uint64_t key = pFnKey(GBL_SORT_AT_(pArray, elemSize, e));
+        pKeySrc[e] = key;
+
+        for(size_t p = 0; p < GBL_SORT_RADIX_PASSES_; ++p)
+            ++histograms[p][(key >> (p * GBL_SORT_RADIX_BITS_)) & (GBL_SORT_RADIX_BUCKETS_ - 1)];
+    }
+
+    for(size_t p = 0; p < GBL_SORT_RADIX_PASSES_; ++p) {
+        const unsigned shift = (unsigned)(p * GBL_SORT_RADIX_BITS_);
+        size_t*        pHist = histograms[p];
+
+        // every key has the same digit, so this pass wouldn't move anything
+        if(pHist[(pKeySrc[0] >> shift) & (GBL_SORT_RADIX_BUCKETS_ - 1)] == count)
+            continue;
+
+        size_t offset = 0;
+        for(size_t b = 0; b < GBL_SORT_RADIX_BUCKETS_; ++b) {
+            const size_t bucketCount = pHist[b];
+            pHist[b] = offset;
+            offset  += bucketCount;
+        }
+
+        for(size_t e = 0; e < count; ++e) {
+            const uint64_t key  = pKeySrc[e];
+            const size_t   dest = pHist[(key >> shift) & (GBL_SORT_RADIX_BUCKETS_ - 1)]++;
+
+            pKeyDst[dest] = key;
+            memcpy(GBL_SORT_AT_(pDst, elemSize, dest), GBL_SORT_AT_(pSrc, elemSize, e), elemSize);
         }
-        pResult += elemSize;
+
+        uint64_t* pKeySwap = pKeySrc;
+        pKeySrc = pKeyDst;
+        pKeyDst = pKeySwap;
+
+        uint8_t* pSwap = pSrc;
+        pSrc = pDst;
+        pDst = pSwap;
     }
 
-    while(pFirstHalf < pEofFirstHalf) {
-        memcpy(pResult, pFirstHalf, elemSize);
-        pFirstHalf += elemSize;
-        pResult += elemSize;
+    if(pSrc != pArray) memcpy(pArray, pSrc, elemSize * count);
+
+    GBL_CTX_END_BLOCK();
+
+    if(pScratch) GBL_CTX_FREE(pScratch);
+    if(pKeys)    GBL_CTX_FREE(pKeys);
+
+    return GBL_CTX_RESULT();
+}
+
+// one unit of work for gblSortParallel(), either sorting a chunk in place or merging two runs
+typedef struct GblSortJob_ {
+    uint8_t*            pDst;
+    const uint8_t*      pLeft;
+    size_t              leftCount;
+    const uint8_t*      pRight;
+    size_t              rightCount;
+    size_t              elemSize;
+    GblSortComparatorFn pFnCmp;
+} GblSortJob_;
+
+static GBL_RESULT gblSortParallelExec_(GblTask* pTask) {
+    const GblSortJob_* pJob = GblBox_userdata(GBL_BOX(pTask));
+
+    if(!pJob->pRight)
+        gblSort(pJob->pDst, pJob->leftCount, pJob->elemSize, pJob->pFnCmp);
+    else
+        gblSortMergeRuns_(pJob->pDst,
+                          pJob->pLeft,
+                          pJob->leftCount,
+                          pJob->pRight,
+                          pJob->rightCount,
+                          pJob->elemSize,
+                          pJob->pFnCmp);
+
+    return GBL_RESULT_SUCCESS;
+}
+
+// # of elements from pLeft which precede output position k when stably merging the two runs
+static size_t gblSortCoRank_(size_t              k,
+                             const uint8_t*      pLeft,
+                             size_t              leftCount,
+                             const uint8_t*      pRight,
+                             size_t              rightCount,
+                             size_t              elemSize,
+                             GblSortComparatorFn pFnCmp)
+{
+    size_t lo = k > rightCount? k - rightCount : 0;
+    size_t hi = GBL_MIN(k, leftCount);
+
+    while(lo < hi) {
+        const size_t i = lo + (hi - lo) / 2;
+        const size_t j = k - i;
+
+        // pLeft[i] goes before pRight[j - 1], so more of the left run is needed
+        if(j > 0 && !gblSortLess_(GBL_SORT_AT_(pRight, elemSize, j - 1),
+                                  GBL_SORT_AT_(pLeft, elemSize, i),
+                                  pFnCmp))
+            lo = i + 1;
+        else
+            hi = i;
     }
 
-    while(pSecondHalf < pEofSecondHalf) {
-        memcpy(pResult, pSecondHalf, elemSize);
-        pSecondHalf += elemSize;
-        pResult += elemSize;
+    return lo;
+}
+
+static GBL_RESULT gblSortParallelRun_(GblMainLoop* pLoop, GblSortJob_* pJobs, GblTask** ppTasks, size_t jobCount) {
+    size_t enqueued = 0;
+
+    GBL_CTX_BEGIN(NULL);
+
+    for(size_t j = 0; j < jobCount; ++j) {
+        ppTasks[j] = GblTask_create(gblSortParallelExec_, &pJobs[j]);
+        GBL_CTX_VERIFY_CALL(GblMainLoop_enqueue(pLoop, ppTasks[j]));
+        ++enqueued;
     }
 
-    memcpy(pArray, pResultBuffer, count * elemSize);
+    GBL_CTX_END_BLOCK();
+
+    // always wait on whatever was enqueued, since the jobs point into the caller's buffers
+    GBL_RESULT result = GBL_CTX_RESULT();
+
+    for(size_t j = 0; j < jobCount && ppTasks[j]; ++j) {
+        if(j < enqueued) {
+            const GBL_RESULT waitResult = GblTask_wait(ppTasks[j]);
+            if(GBL_RESULT_SUCCESS(result)) result = waitResult;
+        }
+
+        GblTask_unref(ppTasks[j]);
+        ppTasks[j] = NULL;
+    }
+
+    return result;
 }
 
+GBL_EXPORT GBL_RESULT gblSortParallel(void*               pArray,
+                                      size_t              count,
+                                      size_t              elemSize,
+                                      GblSortComparatorFn pFnCmp,
+                                      GblMainLoop*        pLoop)
+{
+    GblSortJob_* pJobs   = NULL;
+    GblTask**    ppTasks = NULL;
+    uint8_t*     pBuffer = NULL;
+
+    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_VERIFY_POINTER(pFnCmp);
+
+    const size_t threads = pLoop? GblMainLoop_workerCount(pLoop) + 1 : 1;
+    size_t       chunks  = 1;
+
+    while(chunks < threads && count / (chunks * 2) >= GBL_SORT_PARALLEL_GRAIN)
+        chunks *= 2;
+
+    if(chunks == 1) {
+        gblSort(pArray, count, elemSize, pFnCmp);
+        GBL_CTX_DONE();
+    }
+
+    // enough jobs for every chunk, or for every piece of every merge
+    const size_t jobCapacity = chunks * 2;
+    pJobs   = GBL_CTX_MALLOC(sizeof(GblSortJob_) * jobCapacity);
+    ppTasks = GBL_CTX_MALLOC(sizeof(GblTask*) * jobCapacity);
+    pBuffer = GBL_CTX_MALLOC(count * elemSize);
+    GBL_CTX_VERIFY(pJobs && ppTasks && pBuffer, GBL_RESULT_ERROR_MEM_ALLOC);
+
+    uint8_t*     pSrc        = pArray;
+    uint8_t*     pDst        = pBuffer;
+    size_t       jobCount    = 0;
+
+    memset(ppTasks, 0, sizeof(GblTask*) * jobCapacity);
+
+    for(size_t c = 0; c < chunks; ++c) {
+        const size_t begin = count * c / chunks;
+        const size_t end   = count * (c + 1) / chunks;
+
+        pJobs[jobCount++] = (GblSortJob_) {
+            .pDst      = GBL_SORT_AT_(pArray, elemSize, begin),
+            .leftCount = end - begin,
+            .elemSize  = elemSize,
+            .pFnCmp    = pFnCmp
+        };
+    }
+
+    GBL_CTX_VERIFY_CALL(gblSortParallelRun_(pLoop, pJobs, ppTasks, jobCount));
+
+    for(size_t runs = chunks; runs > 1; runs /= 2) {
+        const size_t pieces = chunks / (runs / 2);  // splits each merge so there are always as many jobs as chunks
+        jobCount = 0;
+
+        for(size_t r = 0; r < runs; r += 2) {
+            const size_t   begin      = count * r / runs;
+            const size_t   mid        = count * (r + 1) / runs;
+            const size_t   end        = count * (r + 2) / runs;
+            const uint8_t* pLeft      = GBL_SORT_AT_(pSrc, elemSize, begin);
+            const uint8_t* pRight     = GBL_SORT_AT_(pSrc, elemSize, mid);
+            const size_t   leftCount  = mid - begin;
+            const size_t   rightCount = end - mid;
+            size_t         kPrev      = 0;
+            size_t         iPrev      = 0;
+
+            for(size_t p = 1; p <= pieces; ++p) {
+                const size_t k = (end - begin) * p / pieces;
+                const size_t i = p == pieces? leftCount :
+                                 gblSortCoRank_(k, pLeft, leftCount, pRight, rightCount, elemSize, pFnCmp);
+
+                pJobs[jobCount++] = (GblSortJob_) {
+                    .pDst       = GBL_SORT_AT_(pDst, elemSize, begin + kPrev),
+                    .pLeft      = GBL_SORT_AT_(pLeft, elemSize, iPrev),
+                    .leftCount  = i - iPrev,
+                    .pRight     = GBL_SORT_AT_(pRight, elemSize, kPrev - iPrev),
+                    .rightCount = (k - i) - (kPrev - iPrev),
+                    .elemSize   = elemSize,
+                    .pFnCmp     = pFnCmp
+                };
+
+                kPrev = k;
+                iPrev = i;
+            }
+        }
+
+        GBL_CTX_VERIFY_CALL(gblSortParallelRun_(pLoop, pJobs, ppTasks, jobCount));
+
+        uint8_t* pSwap = pSrc;
+        pSrc = pDst;
+        pDst = pSwap;
+    }
+
+    if(pSrc != pArray) memcpy(pArray, pSrc, count * elemSize);
+
+    GBL_CTX_END_BLOCK();
+
+    if(pBuffer) GBL_CTX_FREE(pBuffer);
+    if(ppTasks) GBL_CTX_FREE(ppTasks);
+    if(pJobs)   GBL_CTX_FREE(pJobs);
+
+    return GBL_CTX_RESULT();
+}
 
 GBL_EXPORT void gblSortSelection(void* pArray, size_t  count, size_t  elemSize, GblSortComparatorFn pFnCmp) {
     void* pTemp = GBL_ALLOCA(elemSize);
@@ -69,7 +693,7 @@ GBL_EXPORT void gblSortSelection(void* pArray, size_t  count, size_t  elemSize,
 }
 
 GBL_EXPORT void gblSortQuick(void* pArray, size_t  count, size_t  elemSize, GblSortComparatorFn pFnCmp) {
-    qsort(pArray, count, elemSize, pFnCmp);
+    gblSort(pArray, count, elemSize, pFnCmp);
 }
 
 GBL_EXPORT void gblSortInsertion(void* pArray, size_t count, size_t  elemSize, GblSortComparatorFn pFnCmp) {
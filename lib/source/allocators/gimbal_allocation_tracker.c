@@ -2,13 +2,24 @@
 #include <gimbal/core/gimbal_ctx.h>
 #include <gimbal/containers/gimbal_hash_set.h>
 #include <gimbal/algorithms/gimbal_hash.h>
+#include <gimbal/algorithms/gimbal_random.h>
+#include <gimbal/algorithms/gimbal_sort.h>
+#include <math.h>
+#include <stdlib.h>
 
 #define GBL_ALLOCATION_TRACKER_INITIAL_CAPACITY_    512
+#define GBL_ALLOCATION_TRACKER_SITE_CAPACITY_       64
+#define GBL_ALLOCATION_TRACKER_FILTER_BITS_         12
 
 typedef struct GblAllocationTracker_ {
     GblAllocationTracker base;
     GblHashSet           activeSet;
+    GblHashSet           siteSet;
+    size_t               sampleInterval;
+    ptrdiff_t            bytesUntilSample;
     GblBool              recursing;
+    // Counts of sampled pointers per hash bucket, letting most frees skip the active set entirely
+    uint16_t             filter[1 << GBL_ALLOCATION_TRACKER_FILTER_BITS_];
 } GblAllocationTracker_;
 
 typedef struct GblAllocationEntry_ {
@@ -17,6 +28,8 @@ typedef struct GblAllocationEntry_ {
     size_t              alignment;
     const char*         pDebugStr;
     GblSourceLocation   sourceLocation;
+    size_t              weightBytes;    // bytes the entry stands in for, just its size unless sampling
+    size_t              weightAllocs;   // allocations the entry stands in for, just 1 unless sampling
 } GblAllocationEntry_;
 
 GblHash GblAllocationTracker_hash_(const GblHashSet* pSet, const void* pEntry) {
@@ -33,7 +46,263 @@ GblBool GblAllocationTracker_compare_(const GblHashSet* pSet,
                 GBL_TRUE : GBL_FALSE;
 }
 
-GBL_EXPORT GblAllocationTracker* GblAllocationTracker_create(GblContext* pCtx) {
+// Call sites are keyed by the addresses of their file and function strings plus their line
+static GblHash GblAllocationTracker_siteHash_(const GblHashSet* pSet, const void* pEntry) {
+    GBL_UNUSED(pSet);
+    return gblHash(&((const GblAllocationSite*)pEntry)->location, sizeof(GblSourceLocation));
+}
+
+static int GblAllocationSite_compareLocation_(const void* pEntry1, const void* pEntry2) {
+    const GblSourceLocation* pLoc1 = &((const GblAllocationSite*)pEntry1)->location;
+    const GblSourceLocation* pLoc2 = &((const GblAllocationSite*)pEntry2)->location;
+
+    if(pLoc1->pFile != pLoc2->pFile)
+        return (uintptr_t)pLoc1->pFile < (uintptr_t)pLoc2->pFile? -1 : 1;
+    if(pLoc1->pFunc != pLoc2->pFunc)
+        return (uintptr_t)pLoc1->pFunc < (uintptr_t)pLoc2->pFunc? -1 : 1;
+    if(pLoc1->line != pLoc2->line)
+        return pLoc1->line < pLoc2->line? -1 : 1;
+
+    return 0;
+}
+
+static GblBool GblAllocationTracker_siteCompare_(const GblHashSet* pSet,
+                                                 const void*       pEntry1,
+                                                 const void*       pEntry2)
+{
+    GBL_UNUSED(pSet);
+    return !GblAllocationSite_compareLocation_(pEntry1, pEntry2);
+}
+
+// Heaviest sites first, for reporting
+static int GblAllocationSite_compareActive_(const void* pEntry1, const void* pEntry2) {
+    const GblAllocationCounters* pCounters1 = &((const GblAllocationSite*)pEntry1)->counters;
+    const GblAllocationCounters* pCounters2 = &((const GblAllocationSite*)pEntry2)->counters;
+
+    if(pCounters1->bytesActive != pCounters2->bytesActive)
+        return pCounters1->bytesActive > pCounters2->bytesActive? -1 : 1;
+    if(pCounters1->bytesAllocated != pCounters2->bytesAllocated)
+        return pCounters1->bytesAllocated > pCounters2->bytesAllocated? -1 : 1;
+
+    return GblAllocationSite_compareLocation_(pEntry1, pEntry2);
+}
+
+static void GblAllocationCounters_diff_(const GblAllocationCounters* pLhs,
+                                        const GblAllocationCounters* pRhs,
+                                        GblAllocationCounters*       pDst)
+{
+    pDst->allocEvents    = pLhs->allocEvents    - pRhs->allocEvents;
+    pDst->reallocEvents  = pLhs->reallocEvents  - pRhs->reallocEvents;
+    pDst->freeEvents     = pLhs->freeEvents     - pRhs->freeEvents;
+
+    pDst->bytesAllocated = pLhs->bytesAllocated - pRhs->bytesAllocated;
+    pDst->bytesFreed     = pLhs->bytesFreed     - pRhs->bytesFreed;
+    pDst->bytesActive    = pLhs->bytesActive    - pRhs->bytesActive;
+
+    pDst->allocsActive   = pLhs->allocsActive   - pRhs->allocsActive;
+}
+
+GBL_INLINE uint16_t* GblAllocationTracker_filter_(GblAllocationTracker_* pSelf_, const void* pPtr) {
+    const uint64_t hash = ((uint64_t)(uintptr_t)pPtr >> 4) * UINT64_C(0x9e3779b97f4a7c15);
+    return &pSelf_->filter[hash >> (64 - GBL_ALLOCATION_TRACKER_FILTER_BITS_)];
+}
+
+// Returns GBL_TRUE if the given pointer might have been sampled
+GBL_INLINE GblBool GblAllocationTracker_maybeSampled_(GblAllocationTracker_* pSelf_, const void* pPtr) {
+    return *GblAllocationTracker_filter_(pSelf_, pPtr) != 0;
+}
+
+// Uniformly distributed over (0, 1], from the top 53 bits of the calling thread's random stream
+static double GblAllocationTracker_uniform_(void) {
+    return (double)((gblRand64() >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+// Exponentially distributed distance to the next sample point, making sampling a Poisson process over bytes
+static ptrdiff_t GblAllocationTracker_nextSample_(const GblAllocationTracker_* pSelf_) {
+    const double interval = -log(GblAllocationTracker_uniform_()) * (double)pSelf_->sampleInterval;
+
+    if(interval < 1.0)
+        return 1;
+    else if(interval >= (double)(PTRDIFF_MAX / 2))
+        return PTRDIFF_MAX / 2;
+    else
+        return (ptrdiff_t)interval;
+}
+
+// Returns GBL_TRUE when an allocation of the given size crosses the next sample point
+GBL_INLINE GblBool GblAllocationTracker_sample_(GblAllocationTracker_* pSelf_, size_t size) {
+    if GBL_LIKELY((pSelf_->bytesUntilSample -= (ptrdiff_t)size) > 0)
+        return GBL_FALSE;
+
+    pSelf_->bytesUntilSample = GblAllocationTracker_nextSample_(pSelf_);
+    return GBL_TRUE;
+}
+
+// Weighs an entry by the inverse of the probability of sampling an allocation its size
+static void GblAllocationTracker_weigh_(const GblAllocationTracker_* pSelf_, GblAllocationEntry_* pEntry) {
+    if(!pSelf_->sampleInterval || !pEntry->size) {
+        pEntry->weightBytes  = pEntry->size;
+        pEntry->weightAllocs = 1;
+    } else {
+        const double probability = -expm1(-(double)pEntry->size / (double)pSelf_->sampleInterval);
+        const double allocs      = 1.0 / probability;
+
+        pEntry->weightBytes  = (size_t)((double)pEntry->size * allocs + 0.5);
+        pEntry->weightAllocs = (size_t)allocs;
+
+        // Rounded randomly rather than to nearest, which would badly skew weights between 1 and 2
+        if(GblAllocationTracker_uniform_() < allocs - (double)pEntry->weightAllocs)
+            ++pEntry->weightAllocs;
+    }
+}
+
+static GblAllocationSite* GblAllocationTracker_site_(GblAllocationTracker_* pSelf_, GblSourceLocation srcLoc) {
+    const GblAllocationSite key = {
+        .location = srcLoc
+    };
+
+    GblAllocationSite* pSite = GblHashSet_get(&pSelf_->siteSet, &key);
+
+    if(!pSite)
+        pSite = GblHashSet_emplace(&pSelf_->siteSet, &key);
+
+    return pSite;
+}
+
+// Adds the weight of a newly recorded entry to the overall counters and those of its call site
+static GblBool GblAllocationTracker_record_(GblAllocationTracker_*     pSelf_,
+                                            const GblAllocationEntry_* pEntry,
+                                            GblBool                    reallocated)
+{
+    GblAllocationSite* pSite = GblAllocationTracker_site_(pSelf_, pEntry->sourceLocation);
+
+    if(!pSite)
+        return GBL_FALSE;
+
+    ++*GblAllocationTracker_filter_(pSelf_, pEntry->pPointer);
+
+    if(reallocated)
+        pSite->counters.reallocEvents += pEntry->weightAllocs;
+    else
+        pSite->counters.allocEvents   += pEntry->weightAllocs;
+
+    pSite->counters.allocsActive   += pEntry->weightAllocs;
+    pSite->counters.bytesAllocated += pEntry->weightBytes;
+    pSite->counters.bytesActive    += pEntry->weightBytes;
+
+    pSelf_->base.counters.bytesAllocated += pEntry->weightBytes;
+    pSelf_->base.counters.bytesActive    += pEntry->weightBytes;
+
+    if(pSelf_->base.counters.bytesActive > (ptrdiff_t)pSelf_->base.maxBytes)
+        pSelf_->base.maxBytes = pSelf_->base.counters.bytesActive;
+
+    return GBL_TRUE;
+}
+
+// Removes the weight of an entry which has been freed, or reallocated with its bytes moving to a new entry
+static void GblAllocationTracker_unrecord_(GblAllocationTracker_*     pSelf_,
+                                           const GblAllocationEntry_* pEntry,
+                                           GblBool                    freed)
+{
+    const GblAllocationSite key = {
+        .location = pEntry->sourceLocation
+    };
+
+    GblAllocationSite* pSite = GblHashSet_get(&pSelf_->siteSet, &key);
+
+    --*GblAllocationTracker_filter_(pSelf_, pEntry->pPointer);
+    pSelf_->base.counters.bytesActive -= pEntry->weightBytes;
+
+    if(freed)
+        pSelf_->base.counters.bytesFreed     += pEntry->weightBytes;
+    else
+        pSelf_->base.counters.bytesAllocated -= pEntry->weightBytes;
+
+    if(pSite) {
+        pSite->counters.allocsActive -= pEntry->weightAllocs;
+        pSite->counters.bytesActive  -= pEntry->weightBytes;
+
+        if(freed) {
+            pSite->counters.freeEvents     += pEntry->weightAllocs;
+            pSite->counters.bytesFreed     += pEntry->weightBytes;
+        } else
+            pSite->counters.bytesAllocated -= pEntry->weightBytes;
+    }
+}
+
+// Records an allocation which has been sampled, or any allocation when not sampling
+static GBL_NO_INLINE GBL_RESULT GblAllocationTracker_insert_(GblAllocationTracker_*   pSelf_,
+                                                            const void*              pPtr,
+                                                            size_t                   size,
+                                                            size_t                   align,
+                                                            const char*              pDbg,
+                                                            const GblSourceLocation* pSrcLoc)
+{
+    GblAllocationEntry_ entry = {
+        .pPointer       = pPtr,
+        .size           = size,
+        .alignment      = align,
+        .pDebugStr      = pDbg,
+        .sourceLocation = *pSrcLoc
+    };
+
+    GBL_CTX_BEGIN(GblHashSet_context(&pSelf_->activeSet));
+
+    pSelf_->recursing = GBL_TRUE;
+    GblAllocationTracker_weigh_(pSelf_, &entry);
+
+    GBL_CTX_VERIFY(GblHashSet_insert(&pSelf_->activeSet, &entry),
+                   GBL_RESULT_ERROR_MEM_ALLOC,
+                   "[Allocation Tracker] Attemping to allocate existing allocation: [%p]", pPtr);
+
+    GBL_CTX_VERIFY(GblAllocationTracker_record_(pSelf_, &entry, GBL_FALSE),
+                   GBL_RESULT_ERROR_MEM_ALLOC,
+                   "[Allocation Tracker] Failed to record call site for allocation: [%p]", pPtr);
+
+    GBL_CTX_END_BLOCK();
+    pSelf_->recursing = GBL_FALSE;
+    return GBL_CTX_RESULT();
+}
+
+// Removes a tracked allocation, warning about unknown pointers
+static GBL_NO_INLINE GBL_RESULT GblAllocationTracker_remove_(GblAllocationTracker_* pSelf_, const void* pPtr) {
+    const GblAllocationEntry_ entry = {
+        .pPointer   = pPtr
+    };
+
+    GBL_CTX_BEGIN(GblHashSet_context(&pSelf_->activeSet));
+
+    pSelf_->recursing = GBL_TRUE;
+    GblAllocationEntry_* pExisting = GblHashSet_extract(&pSelf_->activeSet, &entry);
+
+    if(!pExisting) {
+        GBL_CTX_WARN("[Allocation Tracker] Attempt to free unknown pointer: [%p]", pPtr);
+        GBL_CTX_DONE();
+    }
+
+    GblAllocationTracker_unrecord_(pSelf_, pExisting, GBL_TRUE);
+
+    GBL_CTX_END_BLOCK();
+    pSelf_->recursing = GBL_FALSE;
+    return GBL_CTX_RESULT();
+}
+
+// Removes an allocation which might have been sampled, silently ignoring any which weren't
+static GBL_NO_INLINE void GblAllocationTracker_removeSampled_(GblAllocationTracker_* pSelf_, const void* pPtr) {
+    const GblAllocationEntry_ entry = {
+        .pPointer   = pPtr
+    };
+
+    pSelf_->recursing = GBL_TRUE;
+    GblAllocationEntry_* pExisting = GblHashSet_extract(&pSelf_->activeSet, &entry);
+
+    if(pExisting)
+        GblAllocationTracker_unrecord_(pSelf_, pExisting, GBL_TRUE);
+
+    pSelf_->recursing = GBL_FALSE;
+}
+
+GBL_EXPORT GblAllocationTracker* (GblAllocationTracker_create)(GblContext* pCtx, size_t sampleInterval) {
     GblAllocationTracker_* pTracker = NULL;
 
     GBL_CTX_BEGIN(pCtx);
@@ -41,7 +310,12 @@ GBL_EXPORT GblAllocationTracker* GblAllocationTracker_create(GblContext* pCtx) {
     pTracker = GBL_CTX_MALLOC(sizeof(GblAllocationTracker_));
     memset(pTracker, 0, sizeof(GblAllocationTracker_));
 
-    pTracker->recursing = GBL_TRUE;
+    pTracker->recursing      = GBL_TRUE;
+    pTracker->sampleInterval = sampleInterval;
+
+    if(sampleInterval)
+        pTracker->bytesUntilSample = GblAllocationTracker_nextSample_(pTracker);
+
     GBL_CTX_VERIFY_CALL(GblHashSet_construct(&pTracker->activeSet,
                                              sizeof(GblAllocationEntry_),
                                              GblAllocationTracker_hash_,
@@ -50,6 +324,15 @@ GBL_EXPORT GblAllocationTracker* GblAllocationTracker_create(GblContext* pCtx) {
                                              GBL_ALLOCATION_TRACKER_INITIAL_CAPACITY_,
                                              pCtx,
                                              pTracker));
+
+    GBL_CTX_VERIFY_CALL(GblHashSet_construct(&pTracker->siteSet,
+                                             sizeof(GblAllocationSite),
+                                             GblAllocationTracker_siteHash_,
+                                             GblAllocationTracker_siteCompare_,
+                                             NULL,
+                                             GBL_ALLOCATION_TRACKER_SITE_CAPACITY_,
+                                             pCtx,
+                                             pTracker));
     GBL_CTX_END_BLOCK();
     pTracker->recursing = GBL_FALSE;
     return &pTracker->base;
@@ -59,6 +342,7 @@ GBL_EXPORT GBL_RESULT GblAllocationTracker_destroy(GblAllocationTracker* pSelf)
     GblAllocationTracker_* pSelf_ = (GblAllocationTracker_*)pSelf;
     GBL_CTX_BEGIN(GblHashSet_context(&pSelf_->activeSet));
     pSelf_->recursing = GBL_TRUE;
+    GBL_CTX_VERIFY_CALL(GblHashSet_destruct(&pSelf_->siteSet));
     GBL_CTX_VERIFY_CALL(GblHashSet_destruct(&pSelf_->activeSet));
     pSelf_->recursing = GBL_FALSE;
     GBL_CTX_FREE(pSelf_);
@@ -66,6 +350,10 @@ GBL_EXPORT GBL_RESULT GblAllocationTracker_destroy(GblAllocationTracker* pSelf)
     return GBL_CTX_RESULT();
 }
 
+GBL_EXPORT size_t GblAllocationTracker_sampleInterval(const GblAllocationTracker* pSelf) {
+    return ((const GblAllocationTracker_*)pSelf)->sampleInterval;
+}
+
 GBL_EXPORT GBL_RESULT GblAllocationTracker_allocEvent(GblAllocationTracker* pSelf,
                                                       const void*           pPtr,
                                                       size_t                size,
@@ -73,43 +361,25 @@ GBL_EXPORT GBL_RESULT GblAllocationTracker_allocEvent(GblAllocationTracker* pSel
                                                       const char*           pDbg,
                                                       GblSourceLocation     srcLoc)
 {
-    const GblAllocationEntry_ entry = {
-        .pPointer       = pPtr,
-        .size           = size,
-        .alignment      = align,
-        .pDebugStr      = pDbg,
-        .sourceLocation = srcLoc
-    };
-
     GblAllocationTracker_* pSelf_ = (GblAllocationTracker_*)pSelf;
 
-    GBL_CTX_BEGIN(GblHashSet_context(&pSelf_->activeSet));
-    if(pSelf_->recursing) GBL_CTX_DONE();
-
-    pSelf_->recursing = GBL_TRUE;
-    GBL_CTX_VERIFY(GblHashSet_insert(&pSelf_->activeSet, &entry),
-                   GBL_RESULT_ERROR_MEM_ALLOC,
-                   "[Allocation Tracker] Attemping to allocate existing allocation: [%p]", pPtr);
+    if(pSelf_->recursing)
+        return GBL_RESULT_SUCCESS;
 
-    pSelf_->base.counters.bytesActive += size;
-    pSelf_->base.counters.bytesAllocated += size;
     ++pSelf_->base.counters.allocEvents;
     ++pSelf_->base.counters.allocsActive;
 
-    if(pSelf_->base.counters.allocsActive > pSelf_->base.maxAllocations) {
+    if(pSelf_->base.counters.allocsActive > (ptrdiff_t)pSelf_->base.maxAllocations)
         pSelf_->base.maxAllocations = pSelf_->base.counters.allocsActive;
-    }
-
-    if(pSelf_->base.counters.bytesActive > pSelf_->base.maxBytes) {
-        pSelf_->base.maxBytes = pSelf_->base.counters.bytesActive;
-    }
 
     if(size > pSelf_->base.maxAllocationSize)
         pSelf_->base.maxAllocationSize = size;
 
-    GBL_CTX_END_BLOCK();
-    pSelf_->recursing = GBL_FALSE;
-    return GBL_CTX_RESULT();
+    // Allocations between sample points only cost the counters above
+    if(pSelf_->sampleInterval && !GblAllocationTracker_sample_(pSelf_, size))
+        return GBL_RESULT_SUCCESS;
+
+    return GblAllocationTracker_insert_(pSelf_, pPtr, size, align, pDbg, &srcLoc);
 }
 
 GBL_EXPORT GBL_RESULT GblAllocationTracker_reallocEvent(GblAllocationTracker*   pSelf,
@@ -119,6 +389,11 @@ GBL_EXPORT GBL_RESULT GblAllocationTracker_reallocEvent(GblAllocationTracker*
                                                         size_t                  newAlign,
                                                         GblSourceLocation       srcLoc)
 {
+    GblAllocationTracker_* pSelf_ = (GblAllocationTracker_*)pSelf;
+
+    if(pSelf_->recursing)
+        return GBL_RESULT_SUCCESS;
+
     GblAllocationEntry_ entry = {
         .pPointer       = pExisting,
         .size           = newSize,
@@ -127,69 +402,70 @@ GBL_EXPORT GBL_RESULT GblAllocationTracker_reallocEvent(GblAllocationTracker*
         .sourceLocation = srcLoc
     };
 
-    GblAllocationTracker_* pSelf_ = (GblAllocationTracker_*)pSelf;
+    ++pSelf_->base.counters.reallocEvents;
+
+    if(newSize > pSelf_->base.maxAllocationSize)
+        pSelf_->base.maxAllocationSize = newSize;
+
+    GblBool sample = GBL_TRUE;
+
+    // Nothing to do unless the existing allocation was sampled or the new one will be
+    if(pSelf_->sampleInterval) {
+        sample = GblAllocationTracker_sample_(pSelf_, newSize);
+
+        if(!sample && !GblAllocationTracker_maybeSampled_(pSelf_, pExisting))
+            return GBL_RESULT_SUCCESS;
+    }
+
     GBL_CTX_BEGIN(GblHashSet_context(&pSelf_->activeSet));
-    if(pSelf_->recursing) GBL_CTX_DONE();
 
     pSelf_->recursing = GBL_TRUE;
     GblAllocationEntry_* pExistingEntry = GblHashSet_extract(&pSelf_->activeSet, &entry);
 
-    GBL_CTX_VERIFY(pExistingEntry,
+    GBL_CTX_VERIFY(pExistingEntry || pSelf_->sampleInterval,
                    GBL_RESULT_ERROR_MEM_REALLOC,
                    "[Allocation Tracker] Attempt to realloc unknown pointer: [%p]", pExisting);
 
-    entry.pPointer = pNew;
-    pSelf_->base.counters.bytesActive -= pExistingEntry->size;
-    pSelf_->base.counters.bytesAllocated -= pExistingEntry->size;
+    if(pExistingEntry)
+        GblAllocationTracker_unrecord_(pSelf_, pExistingEntry, GBL_FALSE);
 
-    GBL_CTX_VERIFY(GblHashSet_insert(&pSelf_->activeSet, &entry),
-                   GBL_RESULT_ERROR_MEM_REALLOC,
-                   "[Allocation Tracker] Failed to insert entry for reallocated pointer: [%p]", pNew);
+    if(sample) {
+        entry.pPointer = pNew;
+        GblAllocationTracker_weigh_(pSelf_, &entry);
 
-    pSelf_->base.counters.bytesActive += newSize;
-    pSelf_->base.counters.bytesAllocated += newSize;
-    ++pSelf_->base.counters.reallocEvents;
+        GBL_CTX_VERIFY(GblHashSet_insert(&pSelf_->activeSet, &entry),
+                       GBL_RESULT_ERROR_MEM_REALLOC,
+                       "[Allocation Tracker] Failed to insert entry for reallocated pointer: [%p]", pNew);
 
-    if(pSelf_->base.counters.bytesActive > pSelf_->base.maxBytes) {
-        pSelf_->base.maxBytes = pSelf_->base.counters.bytesActive;
+        GBL_CTX_VERIFY(GblAllocationTracker_record_(pSelf_, &entry, GBL_TRUE),
+                       GBL_RESULT_ERROR_MEM_REALLOC,
+                       "[Allocation Tracker] Failed to record call site for reallocated pointer: [%p]", pNew);
     }
 
-    if(newSize > pSelf_->base.maxAllocationSize)
-        pSelf_->base.maxAllocationSize = newSize;
-
     GBL_CTX_END_BLOCK();
     pSelf_->recursing = GBL_FALSE;
     return GBL_CTX_RESULT();
 }
 
 GBL_EXPORT GBL_RESULT GblAllocationTracker_freeEvent(GblAllocationTracker* pSelf, const void* pPtr, GblSourceLocation srcLoc) {
+    GBL_UNUSED(srcLoc);
     GblAllocationTracker_* pSelf_ = (GblAllocationTracker_*)pSelf;
-    GBL_CTX_BEGIN(GblHashSet_context(&pSelf_->activeSet));
-    if(pSelf_->recursing) GBL_CTX_DONE();
-
-    const GblAllocationEntry_ entry = {
-        .pPointer   = pPtr
-    };
 
-    pSelf_->recursing = GBL_TRUE;
-    GblAllocationEntry_* pExisting = GblHashSet_extract(&pSelf_->activeSet, &entry);
+    if(pSelf_->recursing)
+        return GBL_RESULT_SUCCESS;
 
-    if(!pExisting) {
-        GBL_CTX_WARN("[Allocation Tracker] Attempt to free unknown pointer: [%p]", pPtr);
-        GBL_CTX_DONE();
-    }
-
-    pSelf_->base.counters.bytesActive -= pExisting->size;
-    pSelf_->base.counters.bytesFreed += pExisting->size;
-
-    GBL_CTX_END_BLOCK();
     ++pSelf_->base.counters.freeEvents;
     --pSelf_->base.counters.allocsActive;
 
-    pSelf_->recursing = GBL_FALSE;
-    return GBL_CTX_RESULT();
-}
+    if(!pSelf_->sampleInterval)
+        return GblAllocationTracker_remove_(pSelf_, pPtr);
 
+    // Most frees are of unsampled allocations, which are ruled out without a lookup, warning or stack frame
+    if(GblAllocationTracker_maybeSampled_(pSelf_, pPtr))
+        GblAllocationTracker_removeSampled_(pSelf_, pPtr);
+
+    return GBL_RESULT_SUCCESS;
+}
 GBL_EXPORT GblBool GblAllocationTracker_validatePointer(const GblAllocationTracker* pSelf, const void* pPtr) {
     GblAllocationTracker_* pSelf_ = (GblAllocationTracker_*)pSelf;
     const GblAllocationEntry_ entry = {
@@ -237,19 +513,134 @@ void GblAllocationTracker_diffCounters(const GblAllocationTracker* pSelf,
                                        const GblAllocationCounters* pSrc,
                                        GblAllocationCounters*       pDst) {
 
-    pDst->allocEvents    = pSelf->counters.allocEvents    - pSrc->allocEvents;
-    pDst->reallocEvents  = pSelf->counters.reallocEvents  - pSrc->reallocEvents;
-    pDst->freeEvents     = pSelf->counters.freeEvents     - pSrc->freeEvents;
+    GblAllocationCounters_diff_(&pSelf->counters, pSrc, pDst);
+}
+
+GBL_EXPORT GBL_RESULT GblAllocationTracker_captureProfile(const GblAllocationTracker* pSelf,
+                                                          GblAllocationProfile*       pProfile)
+{
+    GblAllocationTracker_* pSelf_ = (GblAllocationTracker_*)pSelf;
+    GBL_CTX_BEGIN(GblHashSet_context(&pSelf_->activeSet));
+
+    memset(pProfile, 0, sizeof(GblAllocationProfile));
+    GblAllocationTracker_captureCounters(pSelf, &pProfile->counters);
+
+    const size_t siteCount = GblHashSet_size(&pSelf_->siteSet);
+
+    if(siteCount) {
+        pSelf_->recursing = GBL_TRUE;
+        pProfile->pSites  = GBL_CTX_MALLOC(sizeof(GblAllocationSite) * siteCount);
+        pSelf_->recursing = GBL_FALSE;
+
+        GBL_CTX_VERIFY(pProfile->pSites,
+                       GBL_RESULT_ERROR_MEM_ALLOC,
+                       "[Allocation Tracker] Failed to allocate profile for %u sites",
+                       siteCount);
+
+        for(GblHashSetIter it = GblHashSet_next(&pSelf_->siteSet, NULL);
+            GblHashSetIter_valid(&it);
+            it = GblHashSet_next(&pSelf_->siteSet, &it))
+        {
+            memcpy(&pProfile->pSites[pProfile->siteCount++],
+                   GblHashSetIter_value(&it),
+                   sizeof(GblAllocationSite));
+        }
+
+        gblSortQuick(pProfile->pSites,
+                     pProfile->siteCount,
+                     sizeof(GblAllocationSite),
+                     GblAllocationSite_compareActive_);
+    }
 
-    pDst->bytesAllocated = pSelf->counters.bytesAllocated - pSrc->bytesAllocated;
-    pDst->bytesFreed     = pSelf->counters.bytesFreed     - pSrc->bytesFreed;
-    pDst->bytesActive    = pSelf->counters.bytesActive    - pSrc->bytesActive;
+    GBL_CTX_END();
+}
 
-    pDst->allocsActive   = pSelf->counters.allocsActive   - pSrc->allocsActive;
+GBL_EXPORT GBL_RESULT GblAllocationTracker_diffProfile(const GblAllocationTracker* pSelf,
+                                                       const GblAllocationProfile* pSrc,
+                                                       GblAllocationProfile*       pDst)
+{
+    GBL_CTX_BEGIN(GblHashSet_context(&((const GblAllocationTracker_*)pSelf)->activeSet));
+
+    GBL_CTX_VERIFY_CALL(GblAllocationTracker_captureProfile(pSelf, pDst));
+    GblAllocationTracker_diffCounters(pSelf, &pSrc->counters, &pDst->counters);
+
+    if(pDst->siteCount) {
+        // Sites are never removed, so every site in the older profile is also in the newer one
+        gblSortQuick(pDst->pSites,
+                     pDst->siteCount,
+                     sizeof(GblAllocationSite),
+                     GblAllocationSite_compareLocation_);
+
+        for(size_t s = 0; s < pSrc->siteCount; ++s) {
+            GblAllocationSite* pSite = bsearch(&pSrc->pSites[s],
+                                               pDst->pSites,
+                                               pDst->siteCount,
+                                               sizeof(GblAllocationSite),
+                                               GblAllocationSite_compareLocation_);
+            if(pSite)
+                GblAllocationCounters_diff_(&pSite->counters,
+                                            &pSrc->pSites[s].counters,
+                                            &pSite->counters);
+        }
+
+        gblSortQuick(pDst->pSites,
+                     pDst->siteCount,
+                     sizeof(GblAllocationSite),
+                     GblAllocationSite_compareActive_);
+    }
 
+    GBL_CTX_END();
 }
 
+GBL_EXPORT GBL_RESULT GblAllocationTracker_releaseProfile(const GblAllocationTracker* pSelf,
+                                                          GblAllocationProfile*       pProfile)
+{
+    GblAllocationTracker_* pSelf_ = (GblAllocationTracker_*)pSelf;
+    GBL_CTX_BEGIN(GblHashSet_context(&pSelf_->activeSet));
 
+    if(pProfile->pSites) {
+        pSelf_->recursing = GBL_TRUE;
+        GBL_CTX_FREE(pProfile->pSites);
+        pSelf_->recursing = GBL_FALSE;
+    }
 
+    pProfile->pSites    = NULL;
+    pProfile->siteCount = 0;
 
+    GBL_CTX_END();
+}
 
+GBL_EXPORT GBL_RESULT GblAllocationTracker_logProfile(const GblAllocationTracker* pSelf,
+                                                      const GblAllocationProfile* pProfile,
+                                                      size_t                      maxSites)
+{
+    GBL_CTX_BEGIN(GblHashSet_context(&((const GblAllocationTracker_*)pSelf)->activeSet));
+
+    const size_t siteCount = maxSites && maxSites < pProfile->siteCount?
+                                maxSites : pProfile->siteCount;
+
+    GBL_CTX_INFO("[Allocation Tracker] Dumping Heap Profile:");
+    GBL_CTX_PUSH();
+    GBL_CTX_INFO("%-20s: %20d", "Active Allocations", pProfile->counters.allocsActive);
+    GBL_CTX_INFO("%-20s: %20d", "Active Bytes",       pProfile->counters.bytesActive);
+    GBL_CTX_INFO("%-20s: %20u", "Allocations",        pProfile->counters.allocEvents);
+    GBL_CTX_INFO("%-20s: %20u", "Bytes Allocated",    pProfile->counters.bytesAllocated);
+    GBL_CTX_INFO("%-20s: %20u", "Sites",              pProfile->siteCount);
+
+    for(size_t s = 0; s < siteCount; ++s) {
+        const GblAllocationSite* pSite = &pProfile->pSites[s];
+
+        GBL_CTX_INFO("[%u]: %s", s, pSite->location.pFunc);
+        GBL_CTX_PUSH();
+        GBL_CTX_INFO("%-20s: %20s", "File",               pSite->location.pFile);
+        GBL_CTX_INFO("%-20s: %20u", "Line",               pSite->location.line);
+        GBL_CTX_INFO("%-20s: %20d", "Active Allocations", pSite->counters.allocsActive);
+        GBL_CTX_INFO("%-20s: %20d", "Active Bytes",       pSite->counters.bytesActive);
+        GBL_CTX_INFO("%-20s: %20u", "Allocations",        pSite->counters.allocEvents);
+        GBL_CTX_INFO("%-20s: %20u", "Bytes Allocated",    pSite->counters.bytesAllocated);
+        GBL_CTX_POP(1);
+    }
+
+    GBL_CTX_POP(1);
+    GBL_CTX_END();
+}
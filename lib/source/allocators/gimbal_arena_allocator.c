@@ -1,14 +1,30 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#   define _DEFAULT_SOURCE  // MAP_ANONYMOUS and madvise()
+#endif
+
 #include <gimbal/allocators/gimbal_arena_allocator.h>
+#include <gimbal/algorithms/gimbal_numeric.h>
 #include <gimbal/core/gimbal_ctx.h>
 #include <gimbal/meta/ifaces/gimbal_ilogger.h>
 
+#include <tinycthread.h>
+
+#if defined(GBL_LINUX) || defined(GBL_ANDROID)
+#   define GBL_ARENA_ALLOCATOR_MMAP_
+#   include <sys/mman.h>
+#endif
+
 #define GBL_ARENA_PAGE_(node)  GBL_LINKED_LIST_ENTRY(node, GblArenaAllocatorPage, listNode)
 
+static once_flag threadArenaOnce_ = ONCE_FLAG_INIT;
+static tss_t     threadArenaKey_;
+
 GBL_EXPORT GBL_RESULT (GblArenaAllocator_construct)(GblArenaAllocator*     pSelf,
                                                     size_t                 pageSize,
                                                     size_t                 pageAlign,
                                                     GblArenaAllocatorPage* pInitialPage,
-                                                    GblContext*            pCtx)
+                                                    GblContext*            pCtx,
+                                                    GblFlags               flags)
 {
     GBL_CTX_BEGIN(pCtx);
     //GblInstance_construct(GBL_INSTANCE(&pSelf), GBL_ARENA_ALLOCATOR_TYPE);
@@ -19,54 +35,150 @@ GBL_EXPORT GBL_RESULT (GblArenaAllocator_construct)(GblArenaAllocator*     pSelf
         GblLinkedList_pushFront(&pSelf->listNode, &pInitialPage->listNode);
     pSelf->pageSize = pageSize;
     pSelf->pageAlign = pageAlign < GBL_ALIGNOF(GBL_MAX_ALIGN_T)? GBL_ALIGNOF(GBL_MAX_ALIGN_T) : pageAlign;
+    pSelf->flags = flags;
     GBL_CTX_END();
 }
 
-GBL_EXPORT GBL_RESULT GblArenaAllocator_destruct(GblArenaAllocator* pSelf) {
-    return GblArenaAllocator_freeAll(pSelf);
+// Total size of a page's allocation, including its header
+static size_t GblArenaAllocator_pageSize_(size_t capacity) {
+    return sizeof(GblArenaAllocatorPage) + capacity - 1;
 }
 
-static GblArenaAllocatorPage* GblArenaAllocator_allocPage_(GblContext* pCtx, size_t  size, size_t  align) {
+// Whether a (non-static) page with the given capacity was mapped directly rather than coming from the context
+static GblBool GblArenaAllocator_pageMapped_(const GblArenaAllocator* pSelf, size_t capacity) {
+#ifdef GBL_ARENA_ALLOCATOR_MMAP_
+    return (pSelf->flags & GBL_ARENA_ALLOCATOR_FLAG_MMAP) &&
+           GblArenaAllocator_pageSize_(capacity) >= GBL_ARENA_ALLOCATOR_MMAP_THRESHOLD;
+#else
+    GBL_UNUSED(pSelf, capacity);
+    return GBL_FALSE;
+#endif
+}
+
+// Bytes needed to bring the next free byte of the page up to the given alignment
+static size_t GblArenaAllocator_padding_(const GblArenaAllocatorPage* pPage, size_t alignment) {
+    return (alignment - ((uintptr_t)&pPage->bytes[pPage->used] & (alignment - 1))) & (alignment - 1);
+}
+
+static GblArenaAllocatorPage* GblArenaAllocator_allocPage_(GblArenaAllocator* pSelf, size_t capacity, size_t align) {
     GblArenaAllocatorPage* pPage = NULL;
-    GBL_CTX_BEGIN(pCtx);
-    const size_t  actualSize = gblAlignedAllocSize(sizeof(GblArenaAllocatorPage) + size-1, align);
-    pPage = GBL_CTX_MALLOC(actualSize, align);
+    GBL_CTX_BEGIN(pSelf->pCtx);
+
+    if(capacity == pSelf->pageSize && pSelf->pWarmPages) {
+        pPage = pSelf->pWarmPages;
+        pSelf->pWarmPages = pPage->pNext;
+        --pSelf->warmPageCount;
+    } else {
+        const size_t  actualSize = GblArenaAllocator_pageSize_(capacity);
+#ifdef GBL_ARENA_ALLOCATOR_MMAP_
+        if(GblArenaAllocator_pageMapped_(pSelf, capacity)) {
+            void* pMap = mmap(NULL, actualSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            GBL_CTX_VERIFY(pMap != MAP_FAILED,
+                           GBL_RESULT_ERROR_MEM_ALLOC,
+                           "Failed to map arena page of size %zu",
+                           actualSize);
+#   ifdef MADV_HUGEPAGE
+            if(actualSize >= GBL_ARENA_ALLOCATOR_HUGE_PAGE_SIZE)
+                madvise(pMap, actualSize, MADV_HUGEPAGE);
+#   endif
+            pPage = pMap;
+        } else
+#endif
+        pPage = GBL_CTX_MALLOC(gblAlignedAllocSize(actualSize, align), align);
+        GBL_CTX_VERIFY(pPage,
+                       GBL_RESULT_ERROR_MEM_ALLOC,
+                       "Failed to allocate arena page of size %zu",
+                       actualSize);
+        pPage->capacity = capacity;
+        pPage->staticAlloc = GBL_FALSE;
+    }
+
     GblLinkedList_init(&pPage->listNode);
-    pPage->capacity = size;
     pPage->used = 0;
-    pPage->staticAlloc = GBL_FALSE;
+
     GBL_CTX_END_BLOCK();
     return pPage;
 }
 
+static void GblArenaAllocator_freePage_(GblArenaAllocator* pSelf, GblArenaAllocatorPage* pPage) {
+#ifdef GBL_ARENA_ALLOCATOR_MMAP_
+    if(GblArenaAllocator_pageMapped_(pSelf, pPage->capacity)) {
+        munmap(pPage, GblArenaAllocator_pageSize_(pPage->capacity));
+        return;
+    }
+#endif
+    GBL_CTX_BEGIN(pSelf->pCtx);
+    GBL_CTX_FREE(pPage);
+    GBL_CTX_END_BLOCK();
+}
+
+// Keeps a regular page warm for reuse if there's room, otherwise frees it
+static void GblArenaAllocator_retirePage_(GblArenaAllocator* pSelf, GblArenaAllocatorPage* pPage) {
+    if(pPage->staticAlloc) {
+        pPage->used = 0;
+    } else if(pPage->capacity == pSelf->pageSize && pSelf->warmPageCount < pSelf->warmPageLimit) {
+        pPage->pNext = pSelf->pWarmPages;
+        pSelf->pWarmPages = pPage;
+        ++pSelf->warmPageCount;
+    } else {
+        GblArenaAllocator_freePage_(pSelf, pPage);
+    }
+}
+
+GBL_EXPORT GBL_RESULT GblArenaAllocator_destruct(GblArenaAllocator* pSelf) {
+    const GBL_RESULT result = GblArenaAllocator_freeAll(pSelf);
+
+    while(pSelf->pWarmPages) {
+        GblArenaAllocatorPage* pPage = pSelf->pWarmPages;
+        pSelf->pWarmPages = pPage->pNext;
+        GblArenaAllocator_freePage_(pSelf, pPage);
+    }
+    pSelf->warmPageCount = 0;
+
+    return result;
+}
+
+// Gives a request which won't fit within a regular page a dedicated page of its own
+static void* GblArenaAllocator_allocLarge_(GblArenaAllocator* pSelf, size_t size, size_t alignment) {
+    // room to align the data past the page's header
+    GblArenaAllocatorPage* pPage = GblArenaAllocator_allocPage_(pSelf,
+                                                                size + alignment - 1,
+                                                                alignment > pSelf->pageAlign?
+                                                                    alignment : pSelf->pageAlign);
+    if(!pPage)
+        return NULL;
+
+    const size_t padding = GblArenaAllocator_padding_(pPage, alignment);
+    pPage->used = padding + size;
+
+    pPage->pNext = pSelf->pLargePages;
+    pSelf->pLargePages = pPage;
+    ++pSelf->allocCount;
+
+    return &pPage->bytes[padding];
+}
+
 GBL_EXPORT void* GblArenaAllocator_alloc(GblArenaAllocator* pSelf, size_t  size, size_t alignment) {
     void* pData = NULL;
     if(size) {
-
-        GblArenaAllocatorPage* pPage = GBL_ARENA_PAGE_(GblLinkedList_front(&pSelf->listNode));
-
         if(alignment == 0) alignment = GBL_ALIGNOF(GBL_MAX_ALIGN_T);
         const size_t  actualSize = gblAlignedAllocSize(size, alignment);
 
+        if(actualSize > pSelf->pageSize)
+            return GblArenaAllocator_allocLarge_(pSelf, actualSize, alignment);
+
+        GblArenaAllocatorPage* pPage = GBL_ARENA_PAGE_(GblLinkedList_front(&pSelf->listNode));
+
         if(!pPage || (pPage->capacity - pPage->used) < actualSize) {
-            if(actualSize <= pSelf->pageSize) {
-                GblArenaAllocatorPage* pNewPage = GblArenaAllocator_allocPage_(pSelf->pCtx,
-                                                                               pSelf->pageSize,
-                                                                               pSelf->pageAlign);
-                GblLinkedList_pushFront(&pSelf->listNode, &pNewPage->listNode);
-            } else {
-                GBL_CTX_BEGIN(pSelf->pCtx);
-                GBL_CTX_VERIFY(actualSize <= pSelf->pageSize,
-                               GBL_RESULT_ERROR_OVERFLOW,
-                               "Cannot allocate chunk of size %u from pages of size %u",
-                               actualSize, pSelf->pageSize);
-                GBL_CTX_END_BLOCK();
+            pPage = GblArenaAllocator_allocPage_(pSelf, pSelf->pageSize, pSelf->pageAlign);
+            if(!pPage)
                 goto end;
-            }
+
+            GblLinkedList_pushFront(&pSelf->listNode, &pPage->listNode);
         }
 
-        pData = &pSelf->pActivePage->bytes[pSelf->pActivePage->used];
-        pSelf->pActivePage->used += actualSize;
+        pData = &pPage->bytes[pPage->used];
+        pPage->used += actualSize;
         ++pSelf->allocCount;
 
         const uintptr_t rem = (uintptr_t)pData % alignment;
@@ -86,7 +198,7 @@ GBL_EXPORT GBL_RESULT GblArenaAllocator_freeAll(GblArenaAllocator* pSelf) {
     GblLinkedList_init(&staticList);
 
     GblLinkedListNode tempNode;
-    // iterate over all pages, freeing the heap ones, accumulating + clearing the static ones
+    // iterate over all pages, retiring the heap ones, accumulating + clearing the static ones
     for(GblLinkedListNode* pNode = pSelf->listNode.pNext;
         pNode != &pSelf->listNode;
         pNode = pNode->pNext)
@@ -94,7 +206,7 @@ GBL_EXPORT GBL_RESULT GblArenaAllocator_freeAll(GblArenaAllocator* pSelf) {
         GblArenaAllocatorPage* pPage = GBL_ARENA_PAGE_(pNode);
         if(!pPage->staticAlloc) {
             tempNode = *pNode;
-            GBL_CTX_FREE(pPage);
+            GblArenaAllocator_retirePage_(pSelf, pPage);
             pNode = &tempNode;
         } else {
             pPage->used = 0;
@@ -104,6 +216,12 @@ GBL_EXPORT GBL_RESULT GblArenaAllocator_freeAll(GblArenaAllocator* pSelf) {
         }
     }
 
+    while(pSelf->pLargePages) {
+        GblArenaAllocatorPage* pPage = pSelf->pLargePages;
+        pSelf->pLargePages = pPage->pNext;
+        GblArenaAllocator_freePage_(pSelf, pPage);
+    }
+
     GblLinkedList_init(&pSelf->listNode);
     GblLinkedList_joinFront(&pSelf->listNode, &staticList);
     pSelf->allocCount   = 0;
@@ -115,6 +233,30 @@ GBL_EXPORT size_t  GblArenaAllocator_pageCount(const GblArenaAllocator* pSelf) {
     return GblLinkedList_count(&pSelf->listNode);
 }
 
+GBL_EXPORT size_t GblArenaAllocator_largePageCount(const GblArenaAllocator* pSelf) {
+    size_t count = 0;
+    for(const GblArenaAllocatorPage* pIt = pSelf->pLargePages; pIt; pIt = pIt->pNext)
+        ++count;
+    return count;
+}
+
+GBL_EXPORT size_t GblArenaAllocator_warmPageCount(const GblArenaAllocator* pSelf) {
+    return pSelf->warmPageCount;
+}
+
+GBL_EXPORT GBL_RESULT GblArenaAllocator_setWarmPages(GblArenaAllocator* pSelf, size_t count) {
+    pSelf->warmPageLimit = count;
+
+    while(pSelf->warmPageCount > count) {
+        GblArenaAllocatorPage* pPage = pSelf->pWarmPages;
+        pSelf->pWarmPages = pPage->pNext;
+        --pSelf->warmPageCount;
+        GblArenaAllocator_freePage_(pSelf, pPage);
+    }
+
+    return GBL_RESULT_SUCCESS;
+}
+
 GBL_EXPORT size_t  GblArenaAllocator_bytesUsed(const GblArenaAllocator* pSelf) {
     size_t  bytes = 0;
     for(GblLinkedListNode* pIt = pSelf->listNode.pNext;
@@ -123,6 +265,8 @@ GBL_EXPORT size_t  GblArenaAllocator_bytesUsed(const GblArenaAllocator* pSelf) {
     {
         bytes += GBL_ARENA_PAGE_(pIt)->used;
     }
+    for(const GblArenaAllocatorPage* pIt = pSelf->pLargePages; pIt; pIt = pIt->pNext)
+        bytes += pIt->used;
     return bytes;
 }
 
@@ -134,19 +278,14 @@ GBL_EXPORT size_t  GblArenaAllocator_totalCapacity(const GblArenaAllocator* pSel
     {
         bytes += GBL_ARENA_PAGE_(pIt)->capacity;
     }
+    for(const GblArenaAllocatorPage* pIt = pSelf->pLargePages; pIt; pIt = pIt->pNext)
+        bytes += pIt->capacity;
     return bytes;
 }
 
 GBL_EXPORT float GblArenaAllocator_utilization(const GblArenaAllocator* pSelf) {
-    size_t  capacity = 0;
-    size_t  used = 0;
-    for(GblLinkedListNode* pIt = pSelf->listNode.pNext;
-        pIt != &pSelf->listNode;
-        pIt = pIt->pNext)
-    {
-        capacity += GBL_ARENA_PAGE_(pIt)->capacity;
-        used += GBL_ARENA_PAGE_(pIt)->used;
-    }
+    const size_t capacity = GblArenaAllocator_totalCapacity(pSelf);
+    const size_t used     = GblArenaAllocator_bytesUsed(pSelf);
     return (capacity != 0)? (float)used/(float)capacity : 0.0f;
 }
 
@@ -164,27 +303,103 @@ GBL_EXPORT size_t  GblArenaAllocator_fragmentedBytes(const GblArenaAllocator* pS
 
 GBL_EXPORT size_t  GblArenaAllocator_bytesAvailable(const GblArenaAllocator* pSelf) {
     size_t bytes = 0;
-    if(pSelf->pActivePage) {
-        bytes = pSelf->pActivePage->capacity - pSelf->pActivePage->used;
+    const GblArenaAllocatorPage* pPage = GBL_ARENA_PAGE_(GblLinkedList_front(&pSelf->listNode));
+    if(pPage) {
+        bytes = pPage->capacity - pPage->used;
     }
     return bytes;
 }
 
 GBL_EXPORT void GblArenaAllocator_saveState(const GblArenaAllocator* pSelf, GblArenaAllocatorState* pState) {
-    pState->pActivePage = pSelf->pActivePage;
-    pState->bytesUsed   = pSelf->pActivePage->used;
+    pState->pActivePage = GBL_ARENA_PAGE_(GblLinkedList_front(&pSelf->listNode));
+    pState->bytesUsed   = pState->pActivePage? pState->pActivePage->used : 0;
+    pState->pLargePage  = pSelf->pLargePages;
 }
 
 GBL_EXPORT GBL_RESULT GblArenaAllocator_loadState(GblArenaAllocator* pSelf, const GblArenaAllocatorState* pState) {
     GBL_CTX_BEGIN(pSelf->pCtx);
-    while(pSelf->pActivePage != pState->pActivePage) {
-        GblArenaAllocatorPage* pPage = GBL_ARENA_PAGE_(GblLinkedList_popFront(&pSelf->listNode));
-        GBL_CTX_FREE(pPage);
+    GblArenaAllocatorPage* pPage;
+    while((pPage = GBL_ARENA_PAGE_(GblLinkedList_front(&pSelf->listNode))) != pState->pActivePage) {
+        GBL_CTX_VERIFY(pPage,
+                       GBL_RESULT_ERROR_INVALID_ARG,
+                       "Active page of the given state is no longer within the arena");
+        GblLinkedList_popFront(&pSelf->listNode);
+        GblArenaAllocator_retirePage_(pSelf, pPage);
+    }
+    if(pPage) pPage->used = pState->bytesUsed;
+
+    while(pSelf->pLargePages && pSelf->pLargePages != pState->pLargePage) {
+        pPage = pSelf->pLargePages;
+        pSelf->pLargePages = pPage->pNext;
+        GblArenaAllocator_freePage_(pSelf, pPage);
     }
-    pSelf->pActivePage->used = pState->bytesUsed;
     GBL_CTX_END();
 }
 
+static void GblThreadArena_destroy_(void* pData) {
+    GblArenaAllocator* pArena = pData;
+    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_CALL(GblArenaAllocator_destruct(pArena));
+    GBL_CTX_FREE(pArena);
+    GBL_CTX_END_BLOCK();
+}
+
+static void GblThreadArena_init_(void) {
+    tss_create(&threadArenaKey_, GblThreadArena_destroy_);
+}
+
+GBL_EXPORT GblArenaAllocator* GblThreadArena_current(void) {
+    call_once(&threadArenaOnce_, GblThreadArena_init_);
+
+    GblArenaAllocator* pArena = tss_get(threadArenaKey_);
+
+    if GBL_UNLIKELY(!pArena) {
+        GBL_CTX_BEGIN(NULL);
+        pArena = GBL_CTX_NEW(GblArenaAllocator);
+        GBL_CTX_VERIFY_CALL(GblArenaAllocator_construct(pArena,
+                                                        GBL_THREAD_ARENA_PAGE_SIZE,
+                                                        0,
+                                                        GBL_NULL,
+                                                        GBL_NULL,
+                                                        GBL_ARENA_ALLOCATOR_FLAG_MMAP));
+        GBL_CTX_VERIFY_CALL(GblArenaAllocator_setWarmPages(pArena, GBL_THREAD_ARENA_WARM_PAGES));
+
+        if GBL_UNLIKELY(tss_set(threadArenaKey_, pArena) != thrd_success) {
+            GBL_CTX_FREE(pArena);
+            pArena = NULL;
+            GBL_CTX_RECORD_SET(GBL_RESULT_ERROR_INTERNAL,
+                               "[GblThreadArena] Failed to set thread's arena!");
+        }
+        GBL_CTX_END_BLOCK();
+    }
+
+    return pArena;
+}
+
+GBL_EXPORT void* (GblThreadArena_alloc)(size_t size, size_t align) {
+    GblArenaAllocator* pArena = GblThreadArena_current();
+    return pArena? GblArenaAllocator_alloc(pArena, size, align) : NULL;
+}
+
+GBL_EXPORT GBL_RESULT GblThreadArena_reset(void) {
+    call_once(&threadArenaOnce_, GblThreadArena_init_);
+
+    GblArenaAllocator* pArena = tss_get(threadArenaKey_);
+    return pArena? GblArenaAllocator_freeAll(pArena) : GBL_RESULT_SUCCESS;
+}
+
+GBL_EXPORT GBL_RESULT GblThreadArena_release(void) {
+    call_once(&threadArenaOnce_, GblThreadArena_init_);
+
+    GblArenaAllocator* pArena = tss_get(threadArenaKey_);
+    if(pArena) {
+        tss_set(threadArenaKey_, NULL);
+        GblThreadArena_destroy_(pArena);
+    }
+
+    return GBL_RESULT_SUCCESS;
+}
+
 static GBL_RESULT GblArenaAllocator_IAllocator_alloc_(GblIAllocator*       pIAllocator,
                                            const GblStackFrame* pFrame,
                                            size_t               size,
@@ -1,13 +1,268 @@
 #include <gimbal/allocators/gimbal_pool_allocator.h>
 #include <gimbal/algorithms/gimbal_numeric.h>
+#include <gimbal/algorithms/gimbal_sort.h>
 #include <gimbal/core/gimbal_ctx.h>
 
+#include <tinycthread.h>
+#include <stdatomic.h>
+
+#define GBL_ARENA_PAGE_(node)               GBL_LINKED_LIST_ENTRY(node, GblArenaAllocatorPage, listNode)
+#define GBL_POOL_ALLOCATOR_BATCH_           (GBL_POOL_ALLOCATOR_MAGAZINE_SIZE / 2)
+
+/* The shared stack's head packs its top entry together with a tag which is
+   bumped upon every update, so a pop racing with another thread popping and
+   pushing back the same entry (ABA) fails its compare-exchange. */
+#if UINTPTR_MAX > 0xffffffff
+#   define GBL_POOL_ALLOCATOR_TAG_SHIFT_    48  // user-space addresses fit within 48 bits
+#else
+#   define GBL_POOL_ALLOCATOR_TAG_SHIFT_    32
+#endif
+
+#define GBL_POOL_ALLOCATOR_PTR_MASK_        ((UINT64_C(1) << GBL_POOL_ALLOCATOR_TAG_SHIFT_) - 1)
+
+// A single thread's cache of free entries
+typedef struct GblPoolMagazine_ {
+    struct GblPoolMagazine_* pNext;     // within the allocator's list of magazines
+    struct GblPoolMagazine_* pPrev;
+    GblPoolAllocator*        pPool;
+    GblLinkedListNode*       pHead;     // NULL-terminated
+    atomic_size_t            count;     // only ever written by the owning thread
+} GblPoolMagazine_;
+
+struct GblPoolAllocatorSync_ {
+    _Atomic(uint64_t) head;             // tagged top of the shared stack of free entries
+    atomic_size_t     sharedCount;      // entries on the shared stack
+    atomic_size_t     carvedCount;      // entries ever handed out by the arena
+    mtx_t             arenaMtx;         // guards growing the arena
+    mtx_t             magazinesMtx;     // guards the list of magazines
+    GblPoolMagazine_* pMagazines;
+    tss_t             magazineKey;
+};
+
+static uint64_t GblPoolAllocator_tagPack_(GblLinkedListNode* pNode, uint64_t tag) {
+    return ((uint64_t)(uintptr_t)pNode & GBL_POOL_ALLOCATOR_PTR_MASK_) |
+           (tag << GBL_POOL_ALLOCATOR_TAG_SHIFT_);
+}
+
+static GblLinkedListNode* GblPoolAllocator_tagPtr_(uint64_t head) {
+    return (GblLinkedListNode*)(uintptr_t)(head & GBL_POOL_ALLOCATOR_PTR_MASK_);
+}
+
+static uint64_t GblPoolAllocator_tagNext_(uint64_t head) {
+    return (head >> GBL_POOL_ALLOCATOR_TAG_SHIFT_) + 1;
+}
+
+// Pushes a NULL-terminated chain of count entries onto the shared stack with a single exchange
+static void GblPoolAllocator_sharedPush_(GblPoolAllocatorSync_* pSync,
+                                         GblLinkedListNode*     pFirst,
+                                         GblLinkedListNode*     pLast,
+                                         size_t                 count)
+{
+    uint64_t head = atomic_load_explicit(&pSync->head, memory_order_relaxed);
+    do {
+        pLast->pNext = GblPoolAllocator_tagPtr_(head);
+    } while(!atomic_compare_exchange_weak_explicit(&pSync->head,
+                                                   &head,
+                                                   GblPoolAllocator_tagPack_(pFirst, GblPoolAllocator_tagNext_(head)),
+                                                   memory_order_release,
+                                                   memory_order_relaxed));
+
+    atomic_fetch_add_explicit(&pSync->sharedCount, count, memory_order_relaxed);
+}
+
+static GblLinkedListNode* GblPoolAllocator_sharedPop_(GblPoolAllocatorSync_* pSync) {
+    uint64_t           head = atomic_load_explicit(&pSync->head, memory_order_acquire);
+    GblLinkedListNode* pNode;
+
+    /* Entries are never unmapped while other threads are using the allocator,
+       so reading the link of one which was just popped elsewhere is harmless:
+       the stale value is discarded when the tag no longer matches. */
+    while((pNode = GblPoolAllocator_tagPtr_(head))) {
+        if(atomic_compare_exchange_weak_explicit(&pSync->head,
+                                                 &head,
+                                                 GblPoolAllocator_tagPack_(pNode->pNext,
+                                                                           GblPoolAllocator_tagNext_(head)),
+                                                 memory_order_acquire,
+                                                 memory_order_acquire))
+        {
+            atomic_fetch_sub_explicit(&pSync->sharedCount, 1, memory_order_relaxed);
+            break;
+        }
+    }
+
+    return pNode;
+}
+
+// Keeps the most recently freed half of the magazine, returning the rest to the shared stack
+static void GblPoolMagazine_spill_(GblPoolMagazine_* pMagazine, size_t keep) {
+    const size_t count = atomic_load_explicit(&pMagazine->count, memory_order_relaxed);
+
+    if(count <= keep)
+        return;
+
+    GblLinkedListNode* pFirst;
+    GblLinkedListNode* pLast = NULL;
+
+    if(keep) {
+        pLast = pMagazine->pHead;
+        for(size_t e = 1; e < keep; ++e)
+            pLast = pLast->pNext;
+        pFirst = pLast->pNext;
+        pLast->pNext = NULL;
+    } else {
+        pFirst = pMagazine->pHead;
+        pMagazine->pHead = NULL;
+    }
+
+    pLast = pFirst;
+    while(pLast->pNext)
+        pLast = pLast->pNext;
+
+    GblPoolAllocator_sharedPush_(pMagazine->pPool->pSync, pFirst, pLast, count - keep);
+    atomic_store_explicit(&pMagazine->count, keep, memory_order_relaxed);
+}
+
+// Registered with the allocator's thread-specific key, returning a thread's magazine as it exits
+static void GblPoolMagazine_destroy_(void* pData) {
+    GblPoolMagazine_*      pMagazine = pData;
+    GblPoolAllocator*      pSelf     = pMagazine->pPool;
+    GblPoolAllocatorSync_* pSync     = pSelf->pSync;
+
+    GblPoolMagazine_spill_(pMagazine, 0);
+
+    mtx_lock(&pSync->magazinesMtx);
+    if(pMagazine->pPrev) pMagazine->pPrev->pNext = pMagazine->pNext;
+    else                 pSync->pMagazines       = pMagazine->pNext;
+    if(pMagazine->pNext) pMagazine->pNext->pPrev = pMagazine->pPrev;
+    mtx_unlock(&pSync->magazinesMtx);
+
+    GBL_CTX_BEGIN(pSelf->arena.pCtx);
+    GBL_CTX_FREE(pMagazine);
+    GBL_CTX_END_BLOCK();
+}
+
+static GblPoolMagazine_* GblPoolAllocator_magazineCreate_(GblPoolAllocator* pSelf) {
+    GblPoolAllocatorSync_* pSync     = pSelf->pSync;
+    GblPoolMagazine_*      pMagazine = NULL;
+
+    GBL_CTX_BEGIN(pSelf->arena.pCtx);
+
+    pMagazine = GBL_CTX_NEW(GblPoolMagazine_);
+    GBL_CTX_VERIFY(pMagazine, GBL_RESULT_ERROR_MEM_ALLOC);
+    memset(pMagazine, 0, sizeof(GblPoolMagazine_));
+    pMagazine->pPool = pSelf;
+    atomic_init(&pMagazine->count, 0);
+
+    if GBL_UNLIKELY(tss_set(pSync->magazineKey, pMagazine) != thrd_success) {
+        GBL_CTX_FREE(pMagazine);
+        pMagazine = NULL;
+        GBL_CTX_RECORD_SET(GBL_RESULT_ERROR_INTERNAL,
+                           "[GblPoolAllocator] Failed to set thread's magazine!");
+        GBL_CTX_DONE();
+    }
+
+    mtx_lock(&pSync->magazinesMtx);
+    pMagazine->pNext = pSync->pMagazines;
+    if(pSync->pMagazines) pSync->pMagazines->pPrev = pMagazine;
+    pSync->pMagazines = pMagazine;
+    mtx_unlock(&pSync->magazinesMtx);
+
+    GBL_CTX_END_BLOCK();
+    return pMagazine;
+}
+
+static GblPoolMagazine_* GblPoolAllocator_magazine_(GblPoolAllocator* pSelf) {
+    GblPoolMagazine_* pMagazine = tss_get(pSelf->pSync->magazineKey);
+
+    if GBL_UNLIKELY(!pMagazine)
+        pMagazine = GblPoolAllocator_magazineCreate_(pSelf);
+
+    return pMagazine;
+}
+
+// Refills an empty magazine from the shared stack, only growing the arena once that's exhausted
+static GblBool GblPoolMagazine_refill_(GblPoolMagazine_* pMagazine) {
+    GblPoolAllocator*      pSelf = pMagazine->pPool;
+    GblPoolAllocatorSync_* pSync = pSelf->pSync;
+    size_t                 count = 0;
+
+    for(; count < GBL_POOL_ALLOCATOR_BATCH_; ++count) {
+        GblLinkedListNode* pEntry = GblPoolAllocator_sharedPop_(pSync);
+        if(!pEntry) break;
+        pEntry->pNext = pMagazine->pHead;
+        pMagazine->pHead = pEntry;
+    }
+
+    if(!count) {
+        mtx_lock(&pSync->arenaMtx);
+        for(; count < GBL_POOL_ALLOCATOR_BATCH_; ++count) {
+            GblLinkedListNode* pEntry = GblArenaAllocator_alloc(&pSelf->arena,
+                                                                pSelf->entrySize,
+                                                                pSelf->entryAlign);
+            if(!pEntry) break;
+            pEntry->pNext = pMagazine->pHead;
+            pMagazine->pHead = pEntry;
+        }
+        mtx_unlock(&pSync->arenaMtx);
+        atomic_fetch_add_explicit(&pSync->carvedCount, count, memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&pMagazine->count, count, memory_order_relaxed);
+    return count != 0;
+}
+
+static void* GblPoolMagazine_pop_(GblPoolMagazine_* pMagazine) {
+    if GBL_UNLIKELY(!pMagazine->pHead && !GblPoolMagazine_refill_(pMagazine))
+        return NULL;
+
+    GblLinkedListNode* pEntry = pMagazine->pHead;
+    pMagazine->pHead = pEntry->pNext;
+    atomic_store_explicit(&pMagazine->count,
+                          atomic_load_explicit(&pMagazine->count, memory_order_relaxed) - 1,
+                          memory_order_relaxed);
+    return pEntry;
+}
+
+static void GblPoolMagazine_push_(GblPoolMagazine_* pMagazine, void* pEntry) {
+    GblLinkedListNode* pNode = pEntry;
+    pNode->pNext     = pMagazine->pHead;
+    pMagazine->pHead = pNode;
+    atomic_store_explicit(&pMagazine->count,
+                          atomic_load_explicit(&pMagazine->count, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+}
+
+static GBL_RESULT GblPoolAllocator_syncCreate_(GblPoolAllocator* pSelf) {
+    GBL_CTX_BEGIN(pSelf->arena.pCtx);
+
+    GblPoolAllocatorSync_* pSync = GBL_CTX_NEW(GblPoolAllocatorSync_);
+    GBL_CTX_VERIFY(pSync, GBL_RESULT_ERROR_MEM_ALLOC);
+    memset(pSync, 0, sizeof(GblPoolAllocatorSync_));
+    atomic_init(&pSync->head, 0);
+    atomic_init(&pSync->sharedCount, 0);
+    atomic_init(&pSync->carvedCount, 0);
+
+    if(tss_create(&pSync->magazineKey, GblPoolMagazine_destroy_) != thrd_success) {
+        GBL_CTX_FREE(pSync);
+        GBL_CTX_RECORD_SET(GBL_RESULT_ERROR_INTERNAL,
+                           "[GblPoolAllocator] Failed to create thread-specific key!");
+        GBL_CTX_DONE();
+    }
+
+    mtx_init(&pSync->arenaMtx, mtx_plain);
+    mtx_init(&pSync->magazinesMtx, mtx_plain);
+    pSelf->pSync = pSync;
+
+    GBL_CTX_END();
+}
+
 GBL_EXPORT GBL_RESULT (GblPoolAllocator_construct)(GblPoolAllocator*      pSelf,
                                                    size_t                 entrySize,
                                                    size_t                 entriesPerPage,
                                                    size_t                 entryAlign,
                                                    GblArenaAllocatorPage* pInitialPage,
-                                                   GblContext*            pCtx)
+                                                   GblContext*            pCtx,
+                                                   GblFlags               flags)
 {
     GBL_CTX_BEGIN(pCtx);
 
@@ -15,20 +270,62 @@ GBL_EXPORT GBL_RESULT (GblPoolAllocator_construct)(GblPoolAllocator*      pSelf,
                                                     gblAlignedAllocSize(entrySize, entryAlign) * entriesPerPage,
                                                     entryAlign,
                                                     pInitialPage,
-                                                    pCtx));
+                                                    pCtx,
+                                                    0));
     GblLinkedList_init(&pSelf->freeList);
-    pSelf->entrySize    = entrySize;
-    pSelf->entryAlign   = entryAlign;
+    pSelf->entrySize     = entrySize;
+    pSelf->entryAlign    = entryAlign;
+    pSelf->activeEntries = 0;
+    pSelf->freeCount     = 0;
+    pSelf->flags         = flags;
+    pSelf->pSync         = NULL;
+
+    if(flags & GBL_POOL_ALLOCATOR_FLAG_CONCURRENT)
+        GBL_CTX_VERIFY_CALL(GblPoolAllocator_syncCreate_(pSelf));
+
     GBL_CTX_END();
 }
 
 GBL_EXPORT GBL_RESULT GblPoolAllocator_destruct(GblPoolAllocator* pSelf) {
+    GblPoolAllocatorSync_* pSync = pSelf->pSync;
+
+    if(pSync) {
+        GBL_CTX_BEGIN(pSelf->arena.pCtx);
+
+        // Magazines of threads which are still running are never handed to the destructor
+        tss_delete(pSync->magazineKey);
+
+        while(pSync->pMagazines) {
+            GblPoolMagazine_* pMagazine = pSync->pMagazines;
+            pSync->pMagazines = pMagazine->pNext;
+            GBL_CTX_FREE(pMagazine);
+        }
+
+        mtx_destroy(&pSync->arenaMtx);
+        mtx_destroy(&pSync->magazinesMtx);
+        GBL_CTX_FREE(pSync);
+        pSelf->pSync = NULL;
+
+        GBL_CTX_END_BLOCK();
+    }
+
+    pSelf->activeEntries = 0;
+    pSelf->freeCount     = 0;
+    GblLinkedList_init(&pSelf->freeList);
+
     return GblArenaAllocator_destruct(&pSelf->arena);
 }
 
 GBL_EXPORT void* GblPoolAllocator_new(GblPoolAllocator* pSelf) {
+    if(pSelf->pSync) {
+        GblPoolMagazine_* pMagazine = GblPoolAllocator_magazine_(pSelf);
+        return pMagazine? GblPoolMagazine_pop_(pMagazine) : NULL;
+    }
+
     GblLinkedListNode* pPtr = GblLinkedList_popFront(&pSelf->freeList);
-    if(!pPtr) {
+    if(pPtr) {
+        --pSelf->freeCount;
+    } else {
         pPtr = GblArenaAllocator_alloc(&pSelf->arena,
                                        pSelf->entrySize,
                                        pSelf->entryAlign);
@@ -38,11 +335,247 @@ GBL_EXPORT void* GblPoolAllocator_new(GblPoolAllocator* pSelf) {
 }
 
 GBL_EXPORT GBL_RESULT GblPoolAllocator_delete(GblPoolAllocator* pSelf, void* pEntry) {
+    if(pSelf->pSync) {
+        GblPoolMagazine_* pMagazine = GblPoolAllocator_magazine_(pSelf);
+
+        if GBL_UNLIKELY(!pMagazine) {
+            GblLinkedListNode* pNode = pEntry;
+            GblPoolAllocator_sharedPush_(pSelf->pSync, pNode, pNode, 1);
+        } else {
+            GblPoolMagazine_push_(pMagazine, pEntry);
+
+            if GBL_UNLIKELY(atomic_load_explicit(&pMagazine->count, memory_order_relaxed) >
+                            GBL_POOL_ALLOCATOR_MAGAZINE_SIZE)
+                GblPoolMagazine_spill_(pMagazine, GBL_POOL_ALLOCATOR_BATCH_);
+        }
+
+        return GBL_RESULT_SUCCESS;
+    }
+
     GblLinkedList_pushFront(&pSelf->freeList, (GblLinkedListNode*)pEntry);
+    ++pSelf->freeCount;
     --pSelf->activeEntries;
     return GBL_RESULT_SUCCESS;
 }
 
-GBL_EXPORT size_t  GblPoolAllocator_freeListSize(const GblPoolAllocator* pSelf) {
-    return GblLinkedList_count(&pSelf->freeList);
+GBL_EXPORT size_t GblPoolAllocator_newN(GblPoolAllocator* pSelf, void** ppEntries, size_t count) {
+    size_t e = 0;
+
+    if(pSelf->pSync) {
+        GblPoolMagazine_* pMagazine = GblPoolAllocator_magazine_(pSelf);
+
+        if(pMagazine) {
+            for(; e < count; ++e)
+                if(!(ppEntries[e] = GblPoolMagazine_pop_(pMagazine)))
+                    break;
+        }
+    } else {
+        for(; e < count; ++e)
+            if(!(ppEntries[e] = GblPoolAllocator_new(pSelf)))
+                break;
+    }
+
+    return e;
+}
+
+GBL_EXPORT GBL_RESULT GblPoolAllocator_deleteN(GblPoolAllocator* pSelf, void* const* ppEntries, size_t count) {
+    if(!count)
+        return GBL_RESULT_SUCCESS;
+
+    if(pSelf->pSync) {
+        GblPoolMagazine_* pMagazine = GblPoolAllocator_magazine_(pSelf);
+
+        if GBL_UNLIKELY(!pMagazine) {
+            for(size_t e = 0; e + 1 < count; ++e)
+                ((GblLinkedListNode*)ppEntries[e])->pNext = ppEntries[e + 1];
+            GblPoolAllocator_sharedPush_(pSelf->pSync, ppEntries[0], ppEntries[count - 1], count);
+        } else {
+            for(size_t e = 0; e < count; ++e)
+                GblPoolMagazine_push_(pMagazine, ppEntries[e]);
+
+            // overflow goes back to the shared stack in a single exchange
+            if(atomic_load_explicit(&pMagazine->count, memory_order_relaxed) > GBL_POOL_ALLOCATOR_MAGAZINE_SIZE)
+                GblPoolMagazine_spill_(pMagazine, GBL_POOL_ALLOCATOR_BATCH_);
+        }
+
+        return GBL_RESULT_SUCCESS;
+    }
+
+    for(size_t e = 0; e < count; ++e)
+        GblLinkedList_pushFront(&pSelf->freeList, (GblLinkedListNode*)ppEntries[e]);
+
+    pSelf->freeCount     += count;
+    pSelf->activeEntries -= count;
+    return GBL_RESULT_SUCCESS;
+}
+
+GBL_EXPORT size_t GblPoolAllocator_freeListSize(const GblPoolAllocator* pSelf) {
+    GblPoolAllocatorSync_* pSync = pSelf->pSync;
+
+    if(!pSync)
+        return pSelf->freeCount;
+
+    size_t count = atomic_load_explicit(&pSync->sharedCount, memory_order_relaxed);
+
+    mtx_lock(&pSync->magazinesMtx);
+    for(GblPoolMagazine_* pIt = pSync->pMagazines; pIt; pIt = pIt->pNext)
+        count += atomic_load_explicit(&pIt->count, memory_order_relaxed);
+    mtx_unlock(&pSync->magazinesMtx);
+
+    return count;
+}
+
+GBL_EXPORT size_t GblPoolAllocator_activeCount(const GblPoolAllocator* pSelf) {
+    if(!pSelf->pSync)
+        return pSelf->activeEntries;
+
+    const size_t carved = atomic_load_explicit(&pSelf->pSync->carvedCount, memory_order_relaxed);
+    const size_t free   = GblPoolAllocator_freeListSize(pSelf);
+
+    return carved > free? carved - free : 0;
+}
+
+typedef struct GblPoolAllocatorReclaimPage_ {
+    GblArenaAllocatorPage* pPage;
+    size_t                 entries;
+    size_t                 freeEntries;
+} GblPoolAllocatorReclaimPage_;
+
+static int GblPoolAllocator_reclaimPageCmp_(const void* pA, const void* pB) {
+    const uintptr_t a = (uintptr_t)((const GblPoolAllocatorReclaimPage_*)pA)->pPage->bytes;
+    const uintptr_t b = (uintptr_t)((const GblPoolAllocatorReclaimPage_*)pB)->pPage->bytes;
+    return (a > b) - (a < b);
+}
+
+static GblPoolAllocatorReclaimPage_* GblPoolAllocator_reclaimPageFind_(GblPoolAllocatorReclaimPage_* pPages,
+                                                                       size_t                        count,
+                                                                       const void*                   pEntry)
+{
+    size_t lo = 0, hi = count;
+
+    while(lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        const uint8_t* pBytes = pPages[mid].pPage->bytes;
+
+        if((const uint8_t*)pEntry < pBytes)
+            hi = mid;
+        else if((const uint8_t*)pEntry >= pBytes + pPages[mid].pPage->used)
+            lo = mid + 1;
+        else
+            return &pPages[mid];
+    }
+
+    return NULL;
+}
+
+GBL_EXPORT GBL_RESULT GblPoolAllocator_reclaim(GblPoolAllocator* pSelf, size_t* pPages) {
+    GblPoolAllocatorReclaimPage_* pTable = NULL;
+    GblLinkedListNode*            pFree  = NULL;
+    GblPoolAllocatorSync_*        pSync  = pSelf->pSync;
+    size_t                        pages  = 0;
+
+    GBL_CTX_BEGIN(pSelf->arena.pCtx);
+
+    const size_t stride    = gblAlignedAllocSize(pSelf->entrySize, pSelf->entryAlign);
+    const size_t pageCount = GblArenaAllocator_pageCount(&pSelf->arena);
+
+    // allocated up-front, so the free list is left untouched upon failure
+    if(pageCount)
+        pTable = GBL_CTX_MALLOC(sizeof(GblPoolAllocatorReclaimPage_) * pageCount);
+
+    // Gather every free entry into one NULL-terminated list
+    if(pSync) {
+        for(GblPoolMagazine_* pIt = pSync->pMagazines; pIt; pIt = pIt->pNext)
+            GblPoolMagazine_spill_(pIt, 0);
+        pFree = GblPoolAllocator_tagPtr_(atomic_exchange_explicit(&pSync->head,
+                                                                  GblPoolAllocator_tagPack_(NULL, 0),
+                                                                  memory_order_acquire));
+        atomic_store_explicit(&pSync->sharedCount, 0, memory_order_relaxed);
+    } else {
+        GblLinkedListNode* pNode;
+        while((pNode = GblLinkedList_popFront(&pSelf->freeList))) {
+            pNode->pNext = pFree;
+            pFree = pNode;
+        }
+    }
+
+    if(pFree && pTable) {
+        size_t p = 0;
+        for(GblLinkedListNode* pIt = pSelf->arena.listNode.pNext;
+            pIt != &pSelf->arena.listNode;
+            pIt = pIt->pNext)
+        {
+            pTable[p].pPage       = GBL_ARENA_PAGE_(pIt);
+            pTable[p].entries     = pTable[p].pPage->used / stride;
+            pTable[p].freeEntries = 0;
+            ++p;
+        }
+
+        gblSort(pTable, pageCount, sizeof(GblPoolAllocatorReclaimPage_), GblPoolAllocator_reclaimPageCmp_);
+
+        for(GblLinkedListNode* pIt = pFree; pIt; pIt = pIt->pNext) {
+            GblPoolAllocatorReclaimPage_* pPage = GblPoolAllocator_reclaimPageFind_(pTable, pageCount, pIt);
+            if(pPage) ++pPage->freeEntries;
+        }
+
+        // Drop the free entries living on pages which are about to be released
+        GblLinkedListNode* pKeep = NULL;
+        while(pFree) {
+            GblLinkedListNode*            pNode = pFree;
+            GblPoolAllocatorReclaimPage_* pPage = GblPoolAllocator_reclaimPageFind_(pTable, pageCount, pNode);
+            pFree = pNode->pNext;
+
+            if(!pPage || !pPage->entries || pPage->freeEntries != pPage->entries) {
+                pNode->pNext = pKeep;
+                pKeep = pNode;
+            }
+        }
+        pFree = pKeep;
+
+        for(p = 0; p < pageCount; ++p) {
+            GblArenaAllocatorPage* pPage = pTable[p].pPage;
+
+            if(!pTable[p].entries || pTable[p].freeEntries != pTable[p].entries)
+                continue;
+
+            pSelf->arena.allocCount -= pTable[p].entries;
+            if(pSync) atomic_fetch_sub_explicit(&pSync->carvedCount, pTable[p].entries, memory_order_relaxed);
+            ++pages;
+
+            /* the active page is rewound to be carved up again, while static pages can't be
+               freed, so they're only rewound, staying with the arena until it's destructed */
+            if(pPage == pSelf->arena.pActivePage || pPage->staticAlloc) {
+                pPage->used = 0;
+            } else {
+                GblLinkedList_remove(&pSelf->arena.listNode, &pPage->listNode);
+                GBL_CTX_FREE(pPage);
+            }
+        }
+    }
+
+    // Return whatever is left over
+    if(pSync) {
+        if(pFree) {
+            GblLinkedListNode* pLast = pFree;
+            size_t             count = 1;
+            while(pLast->pNext) {
+                pLast = pLast->pNext;
+                ++count;
+            }
+            GblPoolAllocator_sharedPush_(pSync, pFree, pLast, count);
+        }
+    } else {
+        pSelf->freeCount = 0;
+        while(pFree) {
+            GblLinkedListNode* pNode = pFree;
+            pFree = pNode->pNext;
+            GblLinkedList_pushFront(&pSelf->freeList, pNode);
+            ++pSelf->freeCount;
+        }
+    }
+
+    if(pTable) GBL_CTX_FREE(pTable);
+    if(pPages) *pPages = pages;
+
+    GBL_CTX_END();
 }
@@ -0,0 +1,838 @@
+#include <gimbal/allocators/gimbal_slab_allocator.h>
+#include <gimbal/meta/instances/gimbal_context.h>
+#include <gimbal/algorithms/gimbal_numeric.h>
+#include <gimbal/strings/gimbal_quark.h>
+
+#include <tinycthread.h>
+#include <stdatomic.h>
+#include <string.h>
+
+#define GBL_SLAB_ALLOCATOR_SLAB_SHIFT_      16      // log2(GBL_SLAB_ALLOCATOR_SLAB_SIZE)
+#define GBL_SLAB_ALLOCATOR_HEADER_SIZE_     64      // reserved for the GblSlab_ header, keeping entries 64-byte aligned
+#define GBL_SLAB_ALLOCATOR_BIN_ALIGN_       64      // keeps each size class's lock on its own cache line
+#define GBL_SLAB_ALLOCATOR_SPIN_COUNT_      16      // busy-waits on a lock before yielding
+#define GBL_SLAB_ALLOCATOR_MAP_LEAF_BITS_   16      // log2 of the number of slabs tracked by each leaf of the slab map
+
+#if UINTPTR_MAX > 0xffffffff
+#   define GBL_SLAB_ALLOCATOR_ADDRESS_BITS_ 48
+#else
+#   define GBL_SLAB_ALLOCATOR_ADDRESS_BITS_ 32
+#endif
+
+#define GBL_SLAB_ALLOCATOR_INDEX_BITS_      (GBL_SLAB_ALLOCATOR_ADDRESS_BITS_ - GBL_SLAB_ALLOCATOR_SLAB_SHIFT_)
+#define GBL_SLAB_ALLOCATOR_MAP_ROOTS_       ((size_t)1 << (GBL_SLAB_ALLOCATOR_INDEX_BITS_ - GBL_SLAB_ALLOCATOR_MAP_LEAF_BITS_))
+#define GBL_SLAB_ALLOCATOR_MAP_LEAF_WORDS_  (((size_t)1 << GBL_SLAB_ALLOCATOR_MAP_LEAF_BITS_) / 64)
+
+GBL_STATIC_ASSERT(GBL_SLAB_ALLOCATOR_SLAB_SIZE == (1 << GBL_SLAB_ALLOCATOR_SLAB_SHIFT_))
+
+// Header at the start of every slab, which is GBL_SLAB_ALLOCATOR_SLAB_SIZE aligned
+typedef struct GblSlab_ {
+    GblSlabAllocator* pOwner;
+    struct GblSlab_*  pNext;        // within its size class's partial or full list
+    struct GblSlab_*  pPrev;
+    void*             pFreeList;    // entries which have been returned to the slab
+    uint8_t*          pBump;        // first entry which has never been handed out
+    uint32_t          entrySize;
+    uint32_t          capacity;
+    uint32_t          used;         // entries held by thread caches or the user
+    uint8_t           bin;
+    uint8_t           full;
+} GblSlab_;
+
+GBL_STATIC_ASSERT(sizeof(GblSlab_) <= GBL_SLAB_ALLOCATOR_HEADER_SIZE_)
+
+// Central lists of a single size class, guarded by its own lock
+typedef struct GblSlabAllocatorBin_ {
+    GBL_ALIGNAS(GBL_SLAB_ALLOCATOR_BIN_ALIGN_)
+    atomic_flag lock;
+    GblSlab_*   pPartial;           // slabs with entries left to hand out
+    GblSlab_*   pFull;              // slabs with every entry handed out
+    GblSlab_*   pSpare;             // a single completely free slab, kept around to avoid thrashing
+} GblSlabAllocatorBin_;
+
+// A single thread's free entries for each size class
+typedef struct GblSlabAllocatorCache_ {
+    GblSlabAllocator*              pOwner;
+    struct GblSlabAllocatorCache_* pNext;
+    struct GblSlabAllocatorCache_* pPrev;
+    struct {
+        void*    pHead;
+        uint32_t count;
+    }                              bins[GBL_SLAB_ALLOCATOR_CLASS_COUNT];
+    // only ever written by the owning thread, so they're never contended
+    atomic_size_t                  allocs;
+    atomic_size_t                  frees;
+    atomic_size_t                  bytesAllocated;
+    atomic_size_t                  bytesFreed;
+} GblSlabAllocatorCache_;
+
+struct GblSlabAllocatorCentral_ {
+    GblSlabAllocatorBin_    bins[GBL_SLAB_ALLOCATOR_CLASS_COUNT];
+    tss_t                   cacheKey;
+    atomic_flag             cachesLock;
+    GblSlabAllocatorCache_* pCaches;
+    atomic_size_t           slabs;
+    atomic_size_t           refills;
+    atomic_size_t           flushes;
+    atomic_size_t           largeAllocs;
+    atomic_size_t           largeFrees;
+    // retired from the caches of threads which have exited
+    atomic_size_t           allocs;
+    atomic_size_t           frees;
+    atomic_size_t           bytesAllocated;
+    atomic_size_t           bytesFreed;
+};
+
+typedef GblSlabAllocatorBin_   Bin_;
+typedef GblSlabAllocatorCache_ Cache_;
+typedef GblSlabAllocatorCentral_ Central_;
+
+static const uint16_t GblSlabAllocator_sizes_[GBL_SLAB_ALLOCATOR_CLASS_COUNT] = {
+      16,   32,   48,   64,   80,   96,  112,  128,
+     160,  192,  224,  256,  320,  384,  448,  512,
+     640,  768,  896, 1024, 1280, 1536, 1792, 2048,
+    2560, 3072, 3584, 4096, 5120, 6144, 7168, 8192
+};
+
+// entries moved between a thread cache and the central lists at once, about 16KB worth
+static const uint8_t GblSlabAllocator_batches_[GBL_SLAB_ALLOCATOR_CLASS_COUNT] = {
+    64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 51, 42, 36, 32,
+    25, 21, 18, 16, 12, 10,  9,  8,
+     6,  5,  4,  4,  3,  2,  2,  2
+};
+
+/* Two-level bitmap shared by every GblSlabAllocator, marking which
+   GBL_SLAB_ALLOCATOR_SLAB_SIZE aligned blocks of the address space are
+   slabs. It lets a pointer be identified as coming from a slab without
+   ever dereferencing memory which might not belong to one. Leaves are
+   never released, as each covers 4GB worth of slabs with 8KB. */
+static _Atomic(atomic_uint_fast64_t*) slabMap_[GBL_SLAB_ALLOCATOR_MAP_ROOTS_];
+
+static void GblSlabAllocator_lock_(atomic_flag* pLock) {
+    unsigned spins = 0;
+
+    while(atomic_flag_test_and_set_explicit(pLock, memory_order_acquire)) {
+        if(++spins >= GBL_SLAB_ALLOCATOR_SPIN_COUNT_) {
+            spins = 0;
+            thrd_yield();
+        }
+    }
+}
+
+static void GblSlabAllocator_unlock_(atomic_flag* pLock) {
+    atomic_flag_clear_explicit(pLock, memory_order_release);
+}
+
+// Non-atomic increment of a counter which only has a single writer
+GBL_INLINE void GblSlabAllocator_count_(atomic_size_t* pCounter, size_t value) {
+    atomic_store_explicit(pCounter,
+                          atomic_load_explicit(pCounter, memory_order_relaxed) + value,
+                          memory_order_relaxed);
+}
+
+GBL_INLINE void* GblSlabAllocator_sysAlloc_(size_t align, size_t size) {
+    return GBL_ALIGNED_ALLOC(align, (size + align - 1) & ~(align - 1));
+}
+
+/* Returns the allocator which large and foreign allocations are passed on to,
+   or NULL for the system allocator, which is also what a root GblContext uses.
+   A context which this allocator has been plugged into would only hand the
+   request straight back, so it's skipped in favor of its own parent context. */
+static GblIAllocator* GblSlabAllocator_parent_(GblSlabAllocator* pSelf) {
+    GblIAllocator* pParent = GblIAllocator_parent(GBL_IALLOCATOR(pSelf));
+
+    while(pParent &&
+          GBL_TYPECHECK(GblContext, pParent) &&
+          GblContext_allocator(GBL_CONTEXT(pParent)) == GBL_IALLOCATOR(pSelf))
+    {
+        pParent = GBL_AS(GblIAllocator, GblContext_parentContext(GBL_CONTEXT(pParent)));
+    }
+
+    return pParent;
+}
+
+static atomic_uint_fast64_t* GblSlabAllocator_mapLeaf_(uintptr_t index, GblBool create) {
+    _Atomic(atomic_uint_fast64_t*)* pRoot = &slabMap_[index >> GBL_SLAB_ALLOCATOR_MAP_LEAF_BITS_];
+    atomic_uint_fast64_t*           pLeaf = atomic_load_explicit(pRoot, memory_order_acquire);
+
+    if(!pLeaf && create) {
+        const size_t          bytes = sizeof(atomic_uint_fast64_t) * GBL_SLAB_ALLOCATOR_MAP_LEAF_WORDS_;
+        atomic_uint_fast64_t* pNew  = GblSlabAllocator_sysAlloc_(GBL_ALLOC_MIN_SIZE, bytes);
+
+        if(pNew) {
+            memset(pNew, 0, bytes);
+
+            if(atomic_compare_exchange_strong_explicit(pRoot, &pLeaf, pNew,
+                                                       memory_order_acq_rel,
+                                                       memory_order_acquire))
+                pLeaf = pNew;
+            else
+                GBL_ALIGNED_FREE(pNew);
+        }
+    }
+
+    return pLeaf;
+}
+
+static GblSlab_* GblSlabAllocator_slabOf_(const void* pPtr) {
+    const uintptr_t index = (uintptr_t)pPtr >> GBL_SLAB_ALLOCATOR_SLAB_SHIFT_;
+
+    if GBL_UNLIKELY(!pPtr || index >> GBL_SLAB_ALLOCATOR_INDEX_BITS_)
+        return NULL;
+
+    atomic_uint_fast64_t* pLeaf = GblSlabAllocator_mapLeaf_(index, GBL_FALSE);
+
+    if GBL_UNLIKELY(!pLeaf)
+        return NULL;
+
+    const uintptr_t bit = index & (((uintptr_t)1 << GBL_SLAB_ALLOCATOR_MAP_LEAF_BITS_) - 1);
+
+    if(!(atomic_load_explicit(&pLeaf[bit >> 6], memory_order_acquire) & (UINT64_C(1) << (bit & 63))))
+        return NULL;
+
+    return (GblSlab_*)((uintptr_t)pPtr & ~(uintptr_t)(GBL_SLAB_ALLOCATOR_SLAB_SIZE - 1));
+}
+
+static void GblSlabAllocator_mapSet_(GblSlab_* pSlab, GblBool value) {
+    const uintptr_t       index = (uintptr_t)pSlab >> GBL_SLAB_ALLOCATOR_SLAB_SHIFT_;
+    const uintptr_t       bit   = index & (((uintptr_t)1 << GBL_SLAB_ALLOCATOR_MAP_LEAF_BITS_) - 1);
+    atomic_uint_fast64_t* pLeaf = GblSlabAllocator_mapLeaf_(index, GBL_FALSE);
+
+    if(value) atomic_fetch_or_explicit(&pLeaf[bit >> 6], UINT64_C(1) << (bit & 63), memory_order_release);
+    else      atomic_fetch_and_explicit(&pLeaf[bit >> 6], ~(UINT64_C(1) << (bit & 63)), memory_order_release);
+}
+
+// Returns the size class of the given request, or GBL_SLAB_ALLOCATOR_CLASS_COUNT if it's too large or 0
+GBL_INLINE unsigned GblSlabAllocator_bin_(size_t size, size_t align) {
+    if GBL_UNLIKELY(align > GBL_ALLOC_MIN_SIZE) {
+        if(align > GBL_SLAB_ALLOCATOR_ALIGN_MAX)
+            return GBL_SLAB_ALLOCATOR_CLASS_COUNT;
+
+        // entries of power-of-two classes are aligned to their size, up to the header size
+        size = gblPow2Next_u64(size < align? align : size);
+    }
+
+    if(size <= 128)
+        return (unsigned)((size + 15) >> 4) - 1;
+
+    if(size > GBL_SLAB_ALLOCATOR_CLASS_SIZE_MAX)
+        return GBL_SLAB_ALLOCATOR_CLASS_COUNT;
+
+    // four classes per doubling, with size in (2^log, 2^(log + 1)]
+    unsigned log = 7;
+    while((size - 1) >> (log + 1))
+        ++log;
+
+    return 8 + (log - 7) * 4 + (unsigned)((size - 1) >> (log - 2)) - 4;
+}
+
+static void GblSlabAllocator_listPush_(GblSlab_** ppHead, GblSlab_* pSlab) {
+    pSlab->pPrev = NULL;
+    pSlab->pNext = *ppHead;
+
+    if(*ppHead)
+        (*ppHead)->pPrev = pSlab;
+
+    *ppHead = pSlab;
+}
+
+static void GblSlabAllocator_listRemove_(GblSlab_** ppHead, GblSlab_* pSlab) {
+    if(pSlab->pPrev) pSlab->pPrev->pNext = pSlab->pNext;
+    else             *ppHead             = pSlab->pNext;
+
+    if(pSlab->pNext) pSlab->pNext->pPrev = pSlab->pPrev;
+}
+
+static void GblSlabAllocator_slabReset_(GblSlab_* pSlab) {
+    pSlab->pFreeList = NULL;
+    pSlab->pBump     = (uint8_t*)pSlab + GBL_SLAB_ALLOCATOR_HEADER_SIZE_;
+    pSlab->used      = 0;
+    pSlab->full      = GBL_FALSE;
+}
+
+static GblSlab_* GblSlabAllocator_slabCreate_(GblSlabAllocator* pSelf, unsigned bin) {
+    GblSlab_* pSlab = GBL_ALIGNED_ALLOC(GBL_SLAB_ALLOCATOR_SLAB_SIZE, GBL_SLAB_ALLOCATOR_SLAB_SIZE);
+
+    if GBL_UNLIKELY(!pSlab)
+        return NULL;
+
+    const uintptr_t index = (uintptr_t)pSlab >> GBL_SLAB_ALLOCATOR_SLAB_SHIFT_;
+
+    if GBL_UNLIKELY(index >> GBL_SLAB_ALLOCATOR_INDEX_BITS_ ||
+                    !GblSlabAllocator_mapLeaf_(index, GBL_TRUE)) {
+        GBL_ALIGNED_FREE(pSlab);
+        return NULL;
+    }
+
+    pSlab->pOwner    = pSelf;
+    pSlab->entrySize = GblSlabAllocator_sizes_[bin];
+    pSlab->capacity  = (GBL_SLAB_ALLOCATOR_SLAB_SIZE - GBL_SLAB_ALLOCATOR_HEADER_SIZE_) / pSlab->entrySize;
+    pSlab->bin       = (uint8_t)bin;
+    GblSlabAllocator_slabReset_(pSlab);
+
+    GblSlabAllocator_mapSet_(pSlab, GBL_TRUE);
+    atomic_fetch_add_explicit(&GBL_PRIV_REF(pSelf).pCentral->slabs, 1, memory_order_relaxed);
+
+    return pSlab;
+}
+
+static void GblSlabAllocator_slabDestroy_(GblSlab_* pSlab) {
+    atomic_fetch_sub_explicit(&GBL_PRIV_REF(pSlab->pOwner).pCentral->slabs, 1, memory_order_relaxed);
+    // must be cleared before the memory can be handed out again by the system
+    GblSlabAllocator_mapSet_(pSlab, GBL_FALSE);
+    GBL_ALIGNED_FREE(pSlab);
+}
+
+// Moves a batch of entries from the central lists into the cache, returning how many were moved
+static unsigned GblSlabAllocator_refill_(GblSlabAllocator* pSelf, Cache_* pCache, unsigned bin) {
+    Central_*      pCentral = GBL_PRIV_REF(pSelf).pCentral;
+    Bin_*          pBin     = &pCentral->bins[bin];
+    const unsigned batch    = GblSlabAllocator_batches_[bin];
+    void*          pHead    = NULL;
+    void**         ppTail   = &pHead;
+    unsigned       count    = 0;
+
+    GblSlabAllocator_lock_(&pBin->lock);
+
+    while(count < batch) {
+        GblSlab_* pSlab = pBin->pPartial;
+
+        if(!pSlab) {
+            if(pBin->pSpare) {
+                pSlab = pBin->pSpare;
+                pBin->pSpare = NULL;
+                GblSlabAllocator_slabReset_(pSlab);
+            } else if(!(pSlab = GblSlabAllocator_slabCreate_(pSelf, bin)))
+                break;
+
+            GblSlabAllocator_listPush_(&pBin->pPartial, pSlab);
+        }
+
+        // linked in address order, for locality
+        while(count < batch && pSlab->used < pSlab->capacity) {
+            void* pEntry = pSlab->pFreeList;
+
+            if(pEntry)
+                pSlab->pFreeList = *(void**)pEntry;
+            else {
+                pEntry        = pSlab->pBump;
+                pSlab->pBump += pSlab->entrySize;
+            }
+
+            ++pSlab->used;
+            *ppTail = pEntry;
+            ppTail  = (void**)pEntry;
+            ++count;
+        }
+
+        if(pSlab->used == pSlab->capacity) {
+            GblSlabAllocator_listRemove_(&pBin->pPartial, pSlab);
+            GblSlabAllocator_listPush_(&pBin->pFull, pSlab);
+            pSlab->full = GBL_TRUE;
+        }
+    }
+
+    GblSlabAllocator_unlock_(&pBin->lock);
+
+    *ppTail = pCache->bins[bin].pHead;
+    pCache->bins[bin].pHead  = pHead;
+    pCache->bins[bin].count += count;
+
+    if(count)
+        atomic_fetch_add_explicit(&pCentral->refills, 1, memory_order_relaxed);
+
+    return count;
+}
+
+// Returns a list of count entries to their slabs, releasing any slabs which become free
+static void GblSlabAllocator_release_(GblSlabAllocator* pSelf, unsigned bin, void* pHead, unsigned count) {
+    Central_* pCentral = GBL_PRIV_REF(pSelf).pCentral;
+    Bin_*     pBin     = &pCentral->bins[bin];
+    GblSlab_* pFreed   = NULL;
+
+    GblSlabAllocator_lock_(&pBin->lock);
+
+    while(count--) {
+        void*     pEntry = pHead;
+        GblSlab_* pSlab  = (GblSlab_*)((uintptr_t)pEntry & ~(uintptr_t)(GBL_SLAB_ALLOCATOR_SLAB_SIZE - 1));
+
+        pHead            = *(void**)pEntry;
+        *(void**)pEntry  = pSlab->pFreeList;
+        pSlab->pFreeList = pEntry;
+
+        if(pSlab->full) {
+            GblSlabAllocator_listRemove_(&pBin->pFull, pSlab);
+            GblSlabAllocator_listPush_(&pBin->pPartial, pSlab);
+            pSlab->full = GBL_FALSE;
+        }
+
+        if(!--pSlab->used) {
+            GblSlabAllocator_listRemove_(&pBin->pPartial, pSlab);
+
+            if(!pBin->pSpare)
+                pBin->pSpare = pSlab;
+            else {
+                pSlab->pNext = pFreed;
+                pFreed       = pSlab;
+            }
+        }
+    }
+
+    GblSlabAllocator_unlock_(&pBin->lock);
+
+    atomic_fetch_add_explicit(&pCentral->flushes, 1, memory_order_relaxed);
+
+    while(pFreed) {
+        GblSlab_* pNext = pFreed->pNext;
+        GblSlabAllocator_slabDestroy_(pFreed);
+        pFreed = pNext;
+    }
+}
+
+// Returns the first count entries of the cache's list for a size class
+static void GblSlabAllocator_flush_(GblSlabAllocator* pSelf, Cache_* pCache, unsigned bin, unsigned count) {
+    void* pHead = pCache->bins[bin].pHead;
+    void* pRest = pHead;
+
+    for(unsigned e = 0; e < count; ++e)
+        pRest = *(void**)pRest;
+
+    pCache->bins[bin].pHead  = pRest;
+    pCache->bins[bin].count -= count;
+
+    GblSlabAllocator_release_(pSelf, bin, pHead, count);
+}
+
+// Invoked when a thread with a cache exits, or upon flushing
+static void GblSlabAllocator_cacheDestroy_(void* pData) {
+    Cache_*           pCache   = pData;
+    GblSlabAllocator* pSelf    = pCache->pOwner;
+    Central_*         pCentral = GBL_PRIV_REF(pSelf).pCentral;
+
+    for(unsigned b = 0; b < GBL_SLAB_ALLOCATOR_CLASS_COUNT; ++b)
+        if(pCache->bins[b].count)
+            GblSlabAllocator_flush_(pSelf, pCache, b, pCache->bins[b].count);
+
+    GblSlabAllocator_lock_(&pCentral->cachesLock);
+
+    atomic_fetch_add_explicit(&pCentral->allocs,         atomic_load(&pCache->allocs),         memory_order_relaxed);
+    atomic_fetch_add_explicit(&pCentral->frees,          atomic_load(&pCache->frees),          memory_order_relaxed);
+    atomic_fetch_add_explicit(&pCentral->bytesAllocated, atomic_load(&pCache->bytesAllocated), memory_order_relaxed);
+    atomic_fetch_add_explicit(&pCentral->bytesFreed,     atomic_load(&pCache->bytesFreed),     memory_order_relaxed);
+
+    if(pCache->pPrev) pCache->pPrev->pNext = pCache->pNext;
+    else              pCentral->pCaches    = pCache->pNext;
+    if(pCache->pNext) pCache->pNext->pPrev = pCache->pPrev;
+
+    GblSlabAllocator_unlock_(&pCentral->cachesLock);
+
+    GBL_ALIGNED_FREE(pCache);
+}
+
+static GBL_NO_INLINE Cache_* GblSlabAllocator_cacheCreate_(GblSlabAllocator* pSelf) {
+    Central_* pCentral = GBL_PRIV_REF(pSelf).pCentral;
+    Cache_*   pCache   = GblSlabAllocator_sysAlloc_(GBL_ALLOC_MIN_SIZE, sizeof(Cache_));
+
+    if GBL_UNLIKELY(!pCache)
+        return NULL;
+
+    memset(pCache, 0, sizeof(Cache_));
+    pCache->pOwner = pSelf;
+
+    if GBL_UNLIKELY(tss_set(pCentral->cacheKey, pCache) != thrd_success) {
+        GBL_ALIGNED_FREE(pCache);
+        return NULL;
+    }
+
+    GblSlabAllocator_lock_(&pCentral->cachesLock);
+
+    pCache->pNext = pCentral->pCaches;
+    if(pCentral->pCaches)
+        pCentral->pCaches->pPrev = pCache;
+    pCentral->pCaches = pCache;
+
+    GblSlabAllocator_unlock_(&pCentral->cachesLock);
+
+    return pCache;
+}
+
+GBL_INLINE Cache_* GblSlabAllocator_cache_(GblSlabAllocator* pSelf) {
+    Cache_* pCache = tss_get(GBL_PRIV_REF(pSelf).pCentral->cacheKey);
+
+    if GBL_UNLIKELY(!pCache)
+        pCache = GblSlabAllocator_cacheCreate_(pSelf);
+
+    return pCache;
+}
+
+GBL_INLINE void* GblSlabAllocator_pop_(GblSlabAllocator* pSelf, Cache_* pCache, unsigned bin) {
+    void* pEntry = pCache->bins[bin].pHead;
+
+    pCache->bins[bin].pHead = *(void**)pEntry;
+    --pCache->bins[bin].count;
+
+    if(GBL_PRIV_REF(pSelf).flags & GBL_SLAB_ALLOCATOR_FLAG_STATS) {
+        GblSlabAllocator_count_(&pCache->allocs, 1);
+        GblSlabAllocator_count_(&pCache->bytesAllocated, GblSlabAllocator_sizes_[bin]);
+    }
+
+    return pEntry;
+}
+
+static GBL_NO_INLINE GBL_RESULT GblSlabAllocator_allocSlow_(GblSlabAllocator*    pSelf,
+                                                           const GblStackFrame* pFrame,
+                                                           size_t               size,
+                                                           size_t               align,
+                                                           unsigned             bin,
+                                                           const char*          pDbgStr,
+                                                           void**               ppData)
+{
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY_POINTER(ppData);
+    GBL_CTX_VERIFY_ARG(size);
+
+    *ppData = NULL;
+
+    if(bin < GBL_SLAB_ALLOCATOR_CLASS_COUNT) {
+        Cache_* pCache = GblSlabAllocator_cache_(pSelf);
+
+        GBL_CTX_VERIFY(pCache,
+                       GBL_RESULT_ERROR_MEM_ALLOC,
+                       "Failed to create a thread cache!");
+
+        GBL_CTX_VERIFY(GblSlabAllocator_refill_(pSelf, pCache, bin),
+                       GBL_RESULT_ERROR_MEM_ALLOC,
+                       "Failed to reserve a slab for size class: %zu",
+                       (size_t)GblSlabAllocator_sizes_[bin]);
+
+        *ppData = GblSlabAllocator_pop_(pSelf, pCache, bin);
+
+    } else {
+        GblIAllocator* pParent = GblSlabAllocator_parent_(pSelf);
+
+        if(!align)
+            align = GBL_ALLOC_MIN_SIZE;
+
+        GBL_CTX_VERIFY_ARG(gblPow2Check(align));
+
+        if(pParent)
+            GBL_CTX_VERIFY_CALL(GblIAllocator_alloc(pParent, pFrame, size, align, pDbgStr, ppData));
+        else
+            *ppData = GblSlabAllocator_sysAlloc_(align, size);
+
+        GBL_CTX_VERIFY(*ppData, GBL_RESULT_ERROR_MEM_ALLOC);
+
+        if(GBL_PRIV_REF(pSelf).flags & GBL_SLAB_ALLOCATOR_FLAG_STATS)
+            atomic_fetch_add_explicit(&GBL_PRIV_REF(pSelf).pCentral->largeAllocs, 1, memory_order_relaxed);
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblSlabAllocator_IAllocator_alloc_(GblIAllocator*       pIAllocator,
+                                                     const GblStackFrame* pFrame,
+                                                     size_t               size,
+                                                     size_t               align,
+                                                     const char*          pDbgStr,
+                                                     void**               ppData)
+{
+    GblSlabAllocator* pSelf = (GblSlabAllocator*)pIAllocator;
+    const unsigned    bin   = GblSlabAllocator_bin_(size, align);
+
+    // lock-free fast path, straight out of the thread's cache
+    if GBL_LIKELY(bin < GBL_SLAB_ALLOCATOR_CLASS_COUNT && ppData) {
+        Cache_* pCache = GblSlabAllocator_cache_(pSelf);
+
+        if GBL_LIKELY(pCache && pCache->bins[bin].pHead) {
+            *ppData = GblSlabAllocator_pop_(pSelf, pCache, bin);
+            return GBL_RESULT_SUCCESS;
+        }
+    }
+
+    return GblSlabAllocator_allocSlow_(pSelf, pFrame, size, align, bin, pDbgStr, ppData);
+}
+
+static GBL_RESULT GblSlabAllocator_IAllocator_free_(GblIAllocator*       pIAllocator,
+                                                    const GblStackFrame* pFrame,
+                                                    void*                pData)
+{
+    GblSlabAllocator* pSelf = (GblSlabAllocator*)pIAllocator;
+    GblSlab_*         pSlab = GblSlabAllocator_slabOf_(pData);
+
+    if GBL_LIKELY(pSlab) {
+        if GBL_UNLIKELY(pSlab->pOwner != pSelf)
+            return GblSlabAllocator_IAllocator_free_(GBL_IALLOCATOR(pSlab->pOwner), pFrame, pData);
+
+        const unsigned bin    = pSlab->bin;
+        Cache_*        pCache = GblSlabAllocator_cache_(pSelf);
+
+        if GBL_UNLIKELY(!pCache) {
+            *(void**)pData = NULL;
+            GblSlabAllocator_release_(pSelf, bin, pData, 1);
+            return GBL_RESULT_SUCCESS;
+        }
+
+        *(void**)pData          = pCache->bins[bin].pHead;
+        pCache->bins[bin].pHead = pData;
+
+        if(GBL_PRIV_REF(pSelf).flags & GBL_SLAB_ALLOCATOR_FLAG_STATS) {
+            GblSlabAllocator_count_(&pCache->frees, 1);
+            GblSlabAllocator_count_(&pCache->bytesFreed, pSlab->entrySize);
+        }
+
+        // keep up to two batches around, so alternating allocs and frees don't ping-pong
+        if GBL_UNLIKELY(++pCache->bins[bin].count > 2u * GblSlabAllocator_batches_[bin])
+            GblSlabAllocator_flush_(pSelf, pCache, bin, GblSlabAllocator_batches_[bin]);
+
+    } else if(pData) {
+        // hand it back to whichever allocator it came from
+        GblIAllocator* pParent = GblSlabAllocator_parent_(pSelf);
+
+        if(GBL_PRIV_REF(pSelf).flags & GBL_SLAB_ALLOCATOR_FLAG_STATS)
+            atomic_fetch_add_explicit(&GBL_PRIV_REF(pSelf).pCentral->largeFrees, 1, memory_order_relaxed);
+
+        if(pParent)
+            return GblIAllocator_free(pParent, pFrame, pData);
+
+        GBL_ALIGNED_FREE(pData);
+    }
+
+    return GBL_RESULT_SUCCESS;
+}
+
+static GBL_RESULT GblSlabAllocator_IAllocator_realloc_(GblIAllocator*       pIAllocator,
+                                                       const GblStackFrame* pFrame,
+                                                       void*                pData,
+                                                       size_t               newSize,
+                                                       size_t               newAlign,
+                                                       void**               ppNewData)
+{
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY_POINTER(ppNewData);
+    GBL_CTX_VERIFY_ARG(newSize);
+
+    GblSlab_* pSlab = GblSlabAllocator_slabOf_(pData);
+
+    if(!pData) {
+        GBL_CTX_VERIFY_CALL(GblSlabAllocator_IAllocator_alloc_(pIAllocator, pFrame, newSize, newAlign, NULL, ppNewData));
+
+    } else if(pSlab) {
+        // still fits within the same size class
+        if(GblSlabAllocator_bin_(newSize, newAlign) == pSlab->bin) {
+            *ppNewData = pData;
+        } else {
+            GBL_CTX_VERIFY_CALL(GblSlabAllocator_IAllocator_alloc_(pIAllocator, pFrame, newSize, newAlign, NULL, ppNewData));
+            memcpy(*ppNewData, pData, newSize < pSlab->entrySize? newSize : pSlab->entrySize);
+            GBL_CTX_VERIFY_CALL(GblSlabAllocator_IAllocator_free_(pIAllocator, pFrame, pData));
+        }
+
+    } else {
+        // its size is unknown, so it can only stay with whichever allocator it came from
+        GblIAllocator* pParent = GblSlabAllocator_parent_((GblSlabAllocator*)pIAllocator);
+
+        if(!newAlign)
+            newAlign = GBL_ALLOC_MIN_SIZE;
+
+        if(pParent)
+            GBL_CTX_VERIFY_CALL(GblIAllocator_realloc(pParent, pFrame, pData, newSize, newAlign, ppNewData));
+        else
+            *ppNewData = GBL_ALIGNED_REALLOC(pData, newAlign, newSize);
+
+        GBL_CTX_VERIFY(*ppNewData, GBL_RESULT_ERROR_MEM_REALLOC);
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblSlabAllocator_init_(GblInstance* pInstance) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblSlabAllocator* pSelf    = GBL_SLAB_ALLOCATOR(pInstance);
+    Central_*         pCentral = GblSlabAllocator_sysAlloc_(GBL_SLAB_ALLOCATOR_BIN_ALIGN_, sizeof(Central_));
+
+    GBL_CTX_VERIFY(pCentral, GBL_RESULT_ERROR_MEM_ALLOC);
+
+    memset(pCentral, 0, sizeof(Central_));
+
+    for(unsigned b = 0; b < GBL_SLAB_ALLOCATOR_CLASS_COUNT; ++b)
+        atomic_flag_clear(&pCentral->bins[b].lock);
+
+    atomic_flag_clear(&pCentral->cachesLock);
+
+    if(tss_create(&pCentral->cacheKey, GblSlabAllocator_cacheDestroy_) != thrd_success) {
+        GBL_ALIGNED_FREE(pCentral);
+        GBL_CTX_RECORD_SET(GBL_RESULT_ERROR_INTERNAL,
+                           "Failed to create thread cache key!");
+        GBL_CTX_DONE();
+    }
+
+    GBL_PRIV_REF(pSelf).pCentral = pCentral;
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblSlabAllocator_destructor_(GblBox* pBox) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblSlabAllocator* pSelf    = GBL_SLAB_ALLOCATOR(pBox);
+    Central_*         pCentral = GBL_PRIV_REF(pSelf).pCentral;
+
+    if(pCentral) {
+        // deleting the key keeps threads exiting later from flushing into freed slabs
+        tss_delete(pCentral->cacheKey);
+
+        while(pCentral->pCaches) {
+            Cache_* pNext = pCentral->pCaches->pNext;
+            GBL_ALIGNED_FREE(pCentral->pCaches);
+            pCentral->pCaches = pNext;
+        }
+
+        for(unsigned b = 0; b < GBL_SLAB_ALLOCATOR_CLASS_COUNT; ++b) {
+            Bin_*     pBin     = &pCentral->bins[b];
+            GblSlab_* pLists[] = { pBin->pPartial, pBin->pFull, pBin->pSpare };
+
+            for(unsigned l = 0; l < GBL_COUNT_OF(pLists); ++l) {
+                while(pLists[l]) {
+                    GblSlab_* pNext = (l < 2)? pLists[l]->pNext : NULL;
+                    GblSlabAllocator_mapSet_(pLists[l], GBL_FALSE);
+                    GBL_ALIGNED_FREE(pLists[l]);
+                    pLists[l] = pNext;
+                }
+            }
+        }
+
+        GBL_ALIGNED_FREE(pCentral);
+        GBL_PRIV_REF(pSelf).pCentral = NULL;
+    }
+
+    GBL_VCALL_DEFAULT(GblObject, base.pFnDestructor, pBox);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblSlabAllocatorClass_init_(GblSlabAllocatorClass* pClass, const void* pData) {
+    GBL_UNUSED(pData);
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_BOX_CLASS(pClass)       ->pFnDestructor = GblSlabAllocator_destructor_;
+    GBL_IALLOCATOR_CLASS(pClass)->pFnAlloc      = GblSlabAllocator_IAllocator_alloc_;
+    GBL_IALLOCATOR_CLASS(pClass)->pFnRealloc    = GblSlabAllocator_IAllocator_realloc_;
+    GBL_IALLOCATOR_CLASS(pClass)->pFnFree       = GblSlabAllocator_IAllocator_free_;
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GblSlabAllocator* GblSlabAllocator_create(GblFlags flags) {
+    GblSlabAllocator* pSelf = GBL_NEW(GblSlabAllocator);
+
+    if(pSelf)
+        GBL_PRIV_REF(pSelf).flags = flags;
+
+    return pSelf;
+}
+
+GBL_EXPORT GblSlabAllocator* GblSlabAllocator_ref(GblSlabAllocator* pSelf) {
+    return GBL_REF(pSelf);
+}
+
+GBL_EXPORT GblRefCount GblSlabAllocator_unref(GblSlabAllocator* pSelf) {
+    return GBL_UNREF(pSelf);
+}
+
+GBL_EXPORT GblFlags GblSlabAllocator_flags(const GblSlabAllocator* pSelf) {
+    return GBL_PRIV_REF(pSelf).flags;
+}
+
+GBL_EXPORT size_t GblSlabAllocator_classSize(size_t size) {
+    const unsigned bin = size? GblSlabAllocator_bin_(size, 0) : 0;
+
+    return bin < GBL_SLAB_ALLOCATOR_CLASS_COUNT? GblSlabAllocator_sizes_[bin] : 0;
+}
+
+GBL_EXPORT GBL_RESULT GblSlabAllocator_stats(const GblSlabAllocator* pSelf, GblSlabAllocatorStats* pStats) {
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY_POINTER(pSelf);
+    GBL_CTX_VERIFY_POINTER(pStats);
+
+    Central_* pCentral       = GBL_PRIV_REF(pSelf).pCentral;
+    size_t    bytesAllocated = 0;
+    size_t    bytesFreed     = 0;
+
+    memset(pStats, 0, sizeof(GblSlabAllocatorStats));
+
+    GblSlabAllocator_lock_(&pCentral->cachesLock);
+
+    for(const Cache_* pCache = pCentral->pCaches; pCache; pCache = pCache->pNext) {
+        pStats->allocs += atomic_load_explicit(&pCache->allocs, memory_order_relaxed);
+        pStats->frees  += atomic_load_explicit(&pCache->frees,  memory_order_relaxed);
+        bytesAllocated += atomic_load_explicit(&pCache->bytesAllocated, memory_order_relaxed);
+        bytesFreed     += atomic_load_explicit(&pCache->bytesFreed,     memory_order_relaxed);
+    }
+
+    pStats->allocs += atomic_load_explicit(&pCentral->allocs, memory_order_relaxed);
+    pStats->frees  += atomic_load_explicit(&pCentral->frees,  memory_order_relaxed);
+    bytesAllocated += atomic_load_explicit(&pCentral->bytesAllocated, memory_order_relaxed);
+    bytesFreed     += atomic_load_explicit(&pCentral->bytesFreed,     memory_order_relaxed);
+
+    GblSlabAllocator_unlock_(&pCentral->cachesLock);
+
+    // entries freed on another thread than they were allocated on can briefly outpace their allocs
+    pStats->bytesActive = bytesAllocated > bytesFreed? bytesAllocated - bytesFreed : 0;
+    pStats->largeAllocs = atomic_load_explicit(&pCentral->largeAllocs, memory_order_relaxed);
+    pStats->largeFrees  = atomic_load_explicit(&pCentral->largeFrees,  memory_order_relaxed);
+    pStats->slabs       = atomic_load_explicit(&pCentral->slabs,       memory_order_relaxed);
+    pStats->refills     = atomic_load_explicit(&pCentral->refills,     memory_order_relaxed);
+    pStats->flushes     = atomic_load_explicit(&pCentral->flushes,     memory_order_relaxed);
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblSlabAllocator_flushCache(GblSlabAllocator* pSelf) {
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY_POINTER(pSelf);
+
+    Cache_* pCache = tss_get(GBL_PRIV_REF(pSelf).pCentral->cacheKey);
+
+    if(pCache) {
+        for(unsigned b = 0; b < GBL_SLAB_ALLOCATOR_CLASS_COUNT; ++b)
+            if(pCache->bins[b].count)
+                GblSlabAllocator_flush_(pSelf, pCache, b, pCache->bins[b].count);
+    }
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GblType GblSlabAllocator_type(void) {
+    static GblType type = GBL_INVALID_TYPE;
+
+    static GblInterfaceImpl ifaceEntries[] = {
+        {
+            .classOffset   = offsetof(GblSlabAllocatorClass, GblIAllocatorImpl)
+        }
+    };
+
+    static GblTypeInfo info = {
+        .pFnClassInit     = (GblClassInitFn)GblSlabAllocatorClass_init_,
+        .classSize        = sizeof(GblSlabAllocatorClass),
+        .pFnInstanceInit  = GblSlabAllocator_init_,
+        .instanceSize     = sizeof(GblSlabAllocator),
+        .interfaceCount   = 1,
+        .pInterfaceImpls  = ifaceEntries
+    };
+
+    if GBL_UNLIKELY(type == GBL_INVALID_TYPE) {
+        ifaceEntries[0].interfaceType = GBL_IALLOCATOR_TYPE;
+
+        type = GblType_register(GblQuark_internStatic("GblSlabAllocator"),
+                                GBL_OBJECT_TYPE,
+                                &info,
+                                GBL_TYPE_FLAG_TYPEINFO_STATIC);
+    }
+
+    return type;
+}
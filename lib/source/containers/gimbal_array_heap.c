@@ -1,18 +1,256 @@
 #include <gimbal/containers/gimbal_array_heap.h>
 
-#define GBL_ARRAY_HEAP_LIST_(heap)      (&GBL_PRIV_REF(heap).list)
-#define GBL_ARRAY_HEAP_PARENT_(npos)    ((intptr_t)(((npos) - 1) / 2))
-#define GBL_ARRAY_HEAP_LEFT_(npos)      (((npos) * 2) + 1)
-#define GBL_ARRAY_HEAP_RIGHT_(npos)     (((npos) * 2) + 2)
+#define GBL_ARRAY_HEAP_LIST_(heap)          (&GBL_PRIV_REF(heap).list)
+#define GBL_ARRAY_HEAP_AT_(data, size, npos)    ((uint8_t*)(data) + (size) * (npos))
+#define GBL_ARRAY_HEAP_FREE_                0x80000000u
+
+// handle bookkeeping, only allocated once a handle has been requested
+typedef struct GblArrayHeapTracker_ {
+    size_t    capacity;         // # of slots in each array
+    size_t    handleCount;      // # of handles ever given out (live + free)
+    uint32_t  freeHead;         // first reusable handle
+    uint32_t* pHandles;         // position -> handle
+    uint32_t* pPositions;       // handle -> position, or FREE | next free handle
+} GblArrayHeapTracker_;
+
+// whether pEntry1 belongs above pEntry2
+GBL_INLINE GblBool GblArrayHeap_above_(const GblArrayHeap* pSelf, const void* pEntry1, const void* pEntry2) {
+    const uint8_t* pKey1 = (const uint8_t*)pEntry1 + GBL_PRIV_REF(pSelf).keyOffset;
+    const uint8_t* pKey2 = (const uint8_t*)pEntry2 + GBL_PRIV_REF(pSelf).keyOffset;
+
+    switch(GBL_PRIV_REF(pSelf).keyType) {
+    case GBL_ARRAY_HEAP_KEY_INT64_MIN:
+    case GBL_ARRAY_HEAP_KEY_INT64_MAX: {
+        int64_t key1, key2;
+        memcpy(&key1, pKey1, sizeof(int64_t));
+        memcpy(&key2, pKey2, sizeof(int64_t));
+        return GBL_PRIV_REF(pSelf).keyType == GBL_ARRAY_HEAP_KEY_INT64_MIN? key1 < key2 : key1 > key2;
+    }
+    case GBL_ARRAY_HEAP_KEY_UINT64_MIN:
+    case GBL_ARRAY_HEAP_KEY_UINT64_MAX: {
+        uint64_t key1, key2;
+        memcpy(&key1, pKey1, sizeof(uint64_t));
+        memcpy(&key2, pKey2, sizeof(uint64_t));
+        return GBL_PRIV_REF(pSelf).keyType == GBL_ARRAY_HEAP_KEY_UINT64_MIN? key1 < key2 : key1 > key2;
+    }
+    default:
+        return GBL_PRIV_REF(pSelf).pFnCmp(pEntry1, pEntry2) > 0;
+    }
+}
 
-GBL_EXPORT GBL_RESULT (GblArrayHeap_construct)(GblArrayHeap*     pSelf,
-                                               size_t            elemSize,
-                                               GblArrayHeapCmpFn pFnCmp,
-                                               size_t            structSize,
-                                               GblContext*       pCtx)
+// places an entry and its handle at a position
+GBL_INLINE void GblArrayHeap_place_(GblArrayHeap* pSelf, uint8_t* pData, size_t pos, const void* pEntry, uint32_t handle) {
+    const size_t elemSize = GblArrayHeap_elementSize(pSelf);
+
+    memcpy(GBL_ARRAY_HEAP_AT_(pData, elemSize, pos), pEntry, elemSize);
+
+    if(GBL_PRIV_REF(pSelf).pTracker) {
+        GBL_PRIV_REF(pSelf).pTracker->pHandles[pos]      = handle;
+        GBL_PRIV_REF(pSelf).pTracker->pPositions[handle] = (uint32_t)pos;
+    }
+}
+
+GBL_INLINE void GblArrayHeap_move_(GblArrayHeap* pSelf, uint8_t* pData, size_t from, size_t to) {
+    GblArrayHeap_place_(pSelf,
+                        pData,
+                        to,
+                        GBL_ARRAY_HEAP_AT_(pData, GblArrayHeap_elementSize(pSelf), from),
+                        GBL_PRIV_REF(pSelf).pTracker?
+                            GBL_PRIV_REF(pSelf).pTracker->pHandles[from] :
+                            GBL_ARRAY_HEAP_HANDLE_INVALID);
+}
+
+// moves the hole at pos up until pEntry fits in it
+static void GblArrayHeap_siftUp_(GblArrayHeap* pSelf, size_t pos, const void* pEntry, uint32_t handle) {
+    uint8_t*     pData    = GblArrayHeap_data(pSelf);
+    const size_t elemSize = GblArrayHeap_elementSize(pSelf);
+    const size_t arity    = GBL_PRIV_REF(pSelf).arity;
+
+    while(pos > 0) {
+        const size_t ppos = (pos - 1) / arity;
+
+        if(!GblArrayHeap_above_(pSelf, pEntry, GBL_ARRAY_HEAP_AT_(pData, elemSize, ppos)))
+            break;
+
+        GblArrayHeap_move_(pSelf, pData, ppos, pos);
+        pos = ppos;
+    }
+
+    GblArrayHeap_place_(pSelf, pData, pos, pEntry, handle);
+}
+
+// moves the hole at pos down until pEntry fits in it
+static void GblArrayHeap_siftDown_(GblArrayHeap* pSelf, size_t pos, const void* pEntry, uint32_t handle, size_t size) {
+    uint8_t*     pData    = GblArrayHeap_data(pSelf);
+    const size_t elemSize = GblArrayHeap_elementSize(pSelf);
+    const size_t arity    = GBL_PRIV_REF(pSelf).arity;
+
+    while(1) {
+        const size_t first = pos * arity + 1;
+        if(first >= size) break;
+
+        const size_t last = GBL_MIN(first + arity, size);
+        size_t       mpos = first;
+
+        for(size_t c = first + 1; c < last; ++c)
+            if(GblArrayHeap_above_(pSelf,
+                                   GBL_ARRAY_HEAP_AT_(pData, elemSize, c),
+                                   GBL_ARRAY_HEAP_AT_(pData, elemSize, mpos)))
+                mpos = c;
+
+        if(!GblArrayHeap_above_(pSelf, GBL_ARRAY_HEAP_AT_(pData, elemSize, mpos), pEntry))
+            break;
+
+        GblArrayHeap_move_(pSelf, pData, mpos, pos);
+        pos = mpos;
+    }
+
+    GblArrayHeap_place_(pSelf, pData, pos, pEntry, handle);
+}
+
+// restores the heap property for an entry going into pos, which may have to move either way
+static void GblArrayHeap_fix_(GblArrayHeap* pSelf, size_t pos, const void* pEntry, uint32_t handle, size_t size) {
+    const size_t elemSize = GblArrayHeap_elementSize(pSelf);
+
+    if(pos > 0 &&
+       GblArrayHeap_above_(pSelf,
+                           pEntry,
+                           GBL_ARRAY_HEAP_AT_(GblArrayHeap_data(pSelf), elemSize, (pos - 1) / GBL_PRIV_REF(pSelf).arity)))
+        GblArrayHeap_siftUp_(pSelf, pos, pEntry, handle);
+    else
+        GblArrayHeap_siftDown_(pSelf, pos, pEntry, handle, size);
+}
+
+// Floyd's bottom-up heap construction, O(n)
+static void GblArrayHeap_heapify_(GblArrayHeap* pSelf) {
+    const size_t size = GblArrayHeap_size(pSelf);
+    if(size < 2) return;
+
+    const size_t elemSize = GblArrayHeap_elementSize(pSelf);
+    uint8_t*     pData    = GblArrayHeap_data(pSelf);
+    void*        pTemp    = GBL_ALLOCA(elemSize);
+
+    for(size_t p = (size - 2) / GBL_PRIV_REF(pSelf).arity + 1; p-- > 0; ) {
+        memcpy(pTemp, GBL_ARRAY_HEAP_AT_(pData, elemSize, p), elemSize);
+        GblArrayHeap_siftDown_(pSelf,
+                               p,
+                               pTemp,
+                               GBL_PRIV_REF(pSelf).pTracker?
+                                   GBL_PRIV_REF(pSelf).pTracker->pHandles[p] :
+                                   GBL_ARRAY_HEAP_HANDLE_INVALID,
+                               size);
+    }
+}
+
+static GBL_RESULT GblArrayHeap_trackerReserve_(GblArrayHeap* pSelf, size_t capacity) {
+    GblArrayHeapTracker_* pTracker = GBL_PRIV_REF(pSelf).pTracker;
+
+    GBL_CTX_BEGIN(GblArrayHeap_context(pSelf));
+
+    if(capacity <= pTracker->capacity) GBL_CTX_DONE();
+
+    GBL_CTX_VERIFY(capacity < GBL_ARRAY_HEAP_FREE_,
+                   GBL_RESULT_ERROR_OVERFLOW,
+                   "Handle tracking is limited to %u entries",
+                   GBL_ARRAY_HEAP_FREE_);
+
+    capacity = GBL_MAX(capacity, pTracker->capacity * 2);
+    capacity = GBL_MAX(capacity, 8);
+
+    uint32_t* pArrays = GBL_CTX_MALLOC(sizeof(uint32_t) * capacity * 2);
+
+    if(pTracker->capacity) {
+        memcpy(pArrays,            pTracker->pHandles,   sizeof(uint32_t) * pTracker->capacity);
+        memcpy(pArrays + capacity, pTracker->pPositions, sizeof(uint32_t) * pTracker->capacity);
+        GBL_CTX_FREE(pTracker->pHandles);
+    }
+
+    pTracker->pHandles   = pArrays;
+    pTracker->pPositions = pArrays + capacity;
+    pTracker->capacity   = capacity;
+
+    GBL_CTX_END();
+}
+
+// starts tracking, giving each existing entry a handle
+static GBL_RESULT GblArrayHeap_track_(GblArrayHeap* pSelf) {
+    GBL_CTX_BEGIN(GblArrayHeap_context(pSelf));
+
+    if(GBL_PRIV_REF(pSelf).pTracker) GBL_CTX_DONE();
+
+    GblArrayHeapTracker_* pTracker = GBL_CTX_NEW(GblArrayHeapTracker_);
+    memset(pTracker, 0, sizeof(GblArrayHeapTracker_));
+    pTracker->freeHead = GBL_ARRAY_HEAP_HANDLE_INVALID;
+    GBL_PRIV_REF(pSelf).pTracker = pTracker;
+
+    const size_t size = GblArrayHeap_size(pSelf);
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_trackerReserve_(pSelf, size));
+
+    for(size_t p = 0; p < size; ++p)
+        pTracker->pHandles[p] = pTracker->pPositions[p] = (uint32_t)p;
+
+    pTracker->handleCount = size;
+
+    GBL_CTX_END();
+}
+
+static void GblArrayHeap_untrack_(GblArrayHeap* pSelf) {
+    GblArrayHeapTracker_* pTracker = GBL_PRIV_REF(pSelf).pTracker;
+    if(!pTracker) return;
+
+    GBL_CTX_BEGIN(GblArrayHeap_context(pSelf));
+    if(pTracker->capacity) GBL_CTX_FREE(pTracker->pHandles);
+    GBL_CTX_FREE(pTracker);
+    GBL_CTX_END_BLOCK();
+
+    GBL_PRIV_REF(pSelf).pTracker = NULL;
+}
+
+// handle capacity must already have been reserved
+static uint32_t GblArrayHeap_handleAlloc_(GblArrayHeap* pSelf) {
+    GblArrayHeapTracker_* pTracker = GBL_PRIV_REF(pSelf).pTracker;
+    if(!pTracker) return GBL_ARRAY_HEAP_HANDLE_INVALID;
+
+    if(pTracker->freeHead != GBL_ARRAY_HEAP_HANDLE_INVALID) {
+        const uint32_t handle = pTracker->freeHead;
+        const uint32_t next   = pTracker->pPositions[handle] & ~GBL_ARRAY_HEAP_FREE_;
+
+        pTracker->freeHead = next == (GBL_ARRAY_HEAP_HANDLE_INVALID & ~GBL_ARRAY_HEAP_FREE_)?
+                                 GBL_ARRAY_HEAP_HANDLE_INVALID : next;
+        return handle;
+    }
+
+    return (uint32_t)pTracker->handleCount++;
+}
+
+static void GblArrayHeap_handleFree_(GblArrayHeap* pSelf, uint32_t handle) {
+    GblArrayHeapTracker_* pTracker = GBL_PRIV_REF(pSelf).pTracker;
+    if(!pTracker) return;
+
+    pTracker->pPositions[handle] = GBL_ARRAY_HEAP_FREE_ | pTracker->freeHead;
+    pTracker->freeHead           = handle;
+}
+
+// position of the entry a handle refers to, or SIZE_MAX if it isn't live
+static size_t GblArrayHeap_position_(const GblArrayHeap* pSelf, GblArrayHeapHandle handle) {
+    const GblArrayHeapTracker_* pTracker = GBL_PRIV_REF(pSelf).pTracker;
+
+    if(!pTracker || handle >= pTracker->handleCount ||
+       (pTracker->pPositions[handle] & GBL_ARRAY_HEAP_FREE_))
+        return SIZE_MAX;
+
+    return pTracker->pPositions[handle];
+}
+
+static GBL_RESULT GblArrayHeap_init_(GblArrayHeap* pSelf,
+                                     size_t       elemSize,
+                                     size_t       structSize,
+                                     GblContext*  pCtx,
+                                     size_t       arity)
 {
     GBL_CTX_BEGIN(pCtx);
-    GBL_CTX_VERIFY_POINTER(pFnCmp);
+    if(!arity) arity = GBL_ARRAY_HEAP_ARITY_DEFAULT;
+    GBL_CTX_VERIFY_ARG(arity >= 2 && arity <= UINT8_MAX);
     GBL_CTX_VERIFY_CALL(GblArrayList_construct(GBL_ARRAY_HEAP_LIST_(pSelf),
                                                elemSize,
                                                0,
@@ -20,21 +258,81 @@ GBL_EXPORT GBL_RESULT (GblArrayHeap_construct)(GblArrayHeap*     pSelf,
                                                structSize-(sizeof(GblArrayHeap)-sizeof(GblArrayList)),
                                                GBL_FALSE,
                                                pCtx));
+    GBL_PRIV_REF(pSelf).pTracker  = NULL;
+    GBL_PRIV_REF(pSelf).keyOffset = 0;
+    GBL_PRIV_REF(pSelf).keyType   = GBL_ARRAY_HEAP_KEY_NONE;
+    GBL_PRIV_REF(pSelf).arity     = (uint8_t)arity;
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT (GblArrayHeap_construct)(GblArrayHeap*     pSelf,
+                                               size_t            elemSize,
+                                               GblArrayHeapCmpFn pFnCmp,
+                                               size_t            structSize,
+                                               GblContext*       pCtx,
+                                               size_t            arity)
+{
+    GBL_CTX_BEGIN(pCtx);
+    GBL_CTX_VERIFY_POINTER(pFnCmp);
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_init_(pSelf, elemSize, structSize, pCtx, arity));
     GBL_PRIV_REF(pSelf).pFnCmp = pFnCmp;
     GBL_CTX_END();
 }
 
+GBL_EXPORT GBL_RESULT (GblArrayHeap_constructKeyed)(GblArrayHeap*      pSelf,
+                                                    size_t             elemSize,
+                                                    size_t             keyOffset,
+                                                    GBL_ARRAY_HEAP_KEY keyType,
+                                                    size_t             structSize,
+                                                    GblContext*        pCtx,
+                                                    size_t             arity)
+{
+    GBL_CTX_BEGIN(pCtx);
+    GBL_CTX_VERIFY_ARG(keyType > GBL_ARRAY_HEAP_KEY_NONE && keyType < GBL_ARRAY_HEAP_KEY_COUNT);
+    GBL_CTX_VERIFY_ARG(keyOffset + sizeof(uint64_t) <= elemSize);
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_init_(pSelf, elemSize, structSize, pCtx, arity));
+    GBL_PRIV_REF(pSelf).pFnCmp    = NULL;
+    GBL_PRIV_REF(pSelf).keyOffset = (uint32_t)keyOffset;
+    GBL_PRIV_REF(pSelf).keyType   = (uint8_t)keyType;
+    GBL_CTX_END();
+}
+
 GBL_EXPORT GBL_RESULT GblArrayHeap_destruct(GblArrayHeap* pSelf) {
+    GblArrayHeap_untrack_(pSelf);
     return GblArrayList_destruct(GBL_ARRAY_HEAP_LIST_(pSelf));
 }
 
 GBL_EXPORT GBL_RESULT GblArrayHeap_copy(GblArrayHeap* pSelf, const GblArrayHeap* pRhs) {
+    GblArrayHeap_untrack_(pSelf);
     GblArrayList_destruct(GBL_ARRAY_HEAP_LIST_(pSelf));
 
-    const GBL_RESULT result = GblArrayList_assign(GBL_ARRAY_HEAP_LIST_(pSelf),
-                                                  GblArrayList_data(GBL_ARRAY_HEAP_LIST_(pRhs)),
-                                                  GblArrayList_size(GBL_ARRAY_HEAP_LIST_(pRhs)));
-    GBL_PRIV_REF(pSelf).pFnCmp = GBL_PRIV_REF(pRhs).pFnCmp;
+    GBL_RESULT result = GblArrayList_assign(GBL_ARRAY_HEAP_LIST_(pSelf),
+                                            GblArrayList_data(GBL_ARRAY_HEAP_LIST_(pRhs)),
+                                            GblArrayList_size(GBL_ARRAY_HEAP_LIST_(pRhs)));
+    GBL_PRIV_REF(pSelf).pFnCmp    = GBL_PRIV_REF(pRhs).pFnCmp;
+    GBL_PRIV_REF(pSelf).keyOffset = GBL_PRIV_REF(pRhs).keyOffset;
+    GBL_PRIV_REF(pSelf).keyType   = GBL_PRIV_REF(pRhs).keyType;
+    GBL_PRIV_REF(pSelf).arity     = GBL_PRIV_REF(pRhs).arity;
+
+    // handles refer to the same entries within the copy
+    const GblArrayHeapTracker_* pRhsTracker = GBL_PRIV_REF(pRhs).pTracker;
+
+    if(GBL_RESULT_SUCCESS(result) && pRhsTracker) {
+        result = GblArrayHeap_track_(pSelf);
+
+        if(GBL_RESULT_SUCCESS(result))
+            result = GblArrayHeap_trackerReserve_(pSelf, pRhsTracker->capacity);
+
+        if(GBL_RESULT_SUCCESS(result)) {
+            GblArrayHeapTracker_* pTracker = GBL_PRIV_REF(pSelf).pTracker;
+
+            memcpy(pTracker->pHandles,   pRhsTracker->pHandles,   sizeof(uint32_t) * pRhsTracker->capacity);
+            memcpy(pTracker->pPositions, pRhsTracker->pPositions, sizeof(uint32_t) * pRhsTracker->capacity);
+            pTracker->handleCount = pRhsTracker->handleCount;
+            pTracker->freeHead    = pRhsTracker->freeHead;
+        }
+    }
+
     return result;
 }
 
@@ -43,89 +341,170 @@ GBL_EXPORT GBL_RESULT GblArrayHeap_move(GblArrayHeap* pSelf, GblArrayHeap* pRhs)
     size_t  size;
     size_t  capacity;
 
+    GblArrayHeap_untrack_(pSelf);
     GblArrayList_destruct(GBL_ARRAY_HEAP_LIST_(pSelf));
 
     GBL_RESULT result = GblArrayList_release(GBL_ARRAY_HEAP_LIST_(pRhs), &pData, &size, &capacity);
     if(!GBL_RESULT_SUCCESS(result)) return result;
     result = GblArrayList_acquire(GBL_ARRAY_HEAP_LIST_(pSelf), pData, size, capacity);
 
-    GBL_PRIV_REF(pSelf).pFnCmp = GBL_PRIV_REF(pRhs).pFnCmp;
+    GBL_PRIV_REF(pSelf).pFnCmp    = GBL_PRIV_REF(pRhs).pFnCmp;
+    GBL_PRIV_REF(pSelf).keyOffset = GBL_PRIV_REF(pRhs).keyOffset;
+    GBL_PRIV_REF(pSelf).keyType   = GBL_PRIV_REF(pRhs).keyType;
+    GBL_PRIV_REF(pSelf).arity     = GBL_PRIV_REF(pRhs).arity;
+    GBL_PRIV_REF(pSelf).pTracker  = GBL_PRIV_REF(pRhs).pTracker;
+    GBL_PRIV_REF(pRhs).pTracker   = NULL;
     return result;
 }
 
-GBL_EXPORT GBL_RESULT GblArrayHeap_push(GblArrayHeap* pSelf, const void* pEntry) {
-    GblArrayList* pList = GBL_ARRAY_HEAP_LIST_(pSelf);
+GBL_EXPORT GBL_RESULT (GblArrayHeap_push)(GblArrayHeap* pSelf, const void* pEntry, GblArrayHeapHandle* pHandle) {
     GBL_CTX_BEGIN(GblArrayHeap_context(pSelf));
-    GBL_CTX_VERIFY_CALL(GblArrayHeap_reserve(pSelf, GblArrayHeap_size(pSelf)+1));
 
-    GBL_CTX_VERIFY_CALL(GblArrayList_pushBack(pList, pEntry));
+    const size_t size     = GblArrayHeap_size(pSelf);
+    const size_t elemSize = GblArrayHeap_elementSize(pSelf);
+    void*        pTemp    = GBL_ALLOCA(elemSize);
 
-    const size_t  elementSize = GblArrayHeap_elementSize(pSelf);
-    intptr_t ipos = (intptr_t)GblArrayHeap_size(pSelf)-1;
-    intptr_t ppos = GBL_ARRAY_HEAP_PARENT_(ipos);
+    // the entry could live within the buffer which is about to grow
+    memcpy(pTemp, pEntry, elemSize);
 
-    void* pTempEntry = GBL_ALLOCA(elementSize);
+    if(pHandle) GBL_CTX_VERIFY_CALL(GblArrayHeap_track_(pSelf));
+    if(GBL_PRIV_REF(pSelf).pTracker)
+        GBL_CTX_VERIFY_CALL(GblArrayHeap_trackerReserve_(pSelf, size + 1));
 
-    while(ipos > 0) {
-        void* pPposEntry = GblArrayList_at(pList, ppos);
-        void* pIposEntry = GblArrayList_at(pList, ipos);
-        if(GBL_PRIV_REF(pSelf).pFnCmp(GblArrayList_at(pList, ppos),
-                                      GblArrayList_at(pList, ipos)) >= 0)
-            break;
+    GBL_CTX_VERIFY_CALL(GblArrayList_resize(GBL_ARRAY_HEAP_LIST_(pSelf), size + 1));
 
-        memcpy(pTempEntry, pPposEntry, elementSize);
-        memcpy(pPposEntry, pIposEntry, elementSize);
-        memcpy(pIposEntry, pTempEntry, elementSize);
+    const uint32_t handle = GblArrayHeap_handleAlloc_(pSelf);
+    GblArrayHeap_siftUp_(pSelf, size, pTemp, handle);
 
-        ipos = ppos;
-        ppos = GBL_ARRAY_HEAP_PARENT_(ipos);
-    }
+    if(pHandle) *pHandle = handle;
 
     GBL_CTX_END();
 }
 
-GBL_EXPORT GBL_RESULT GblArrayHeap_pop(GblArrayHeap* pSelf, void* pEntryOut) {
-    if(!GblArrayHeap_size(pSelf)) return GBL_RESULT_ERROR_OUT_OF_RANGE;
+GBL_EXPORT GBL_RESULT (GblArrayHeap_pushN)(GblArrayHeap*       pSelf,
+                                           const void*         pEntries,
+                                           size_t              count,
+                                           GblArrayHeapHandle* pHandles)
+{
+    GBL_CTX_BEGIN(GblArrayHeap_context(pSelf));
 
-    GblArrayList* pList = GBL_ARRAY_HEAP_LIST_(pSelf);
-    GBL_RESULT result = GblArrayList_popFront(pList, pEntryOut);
-    if(!GBL_RESULT_SUCCESS(result)) return result;
+    if(!count) GBL_CTX_DONE();
+    GBL_CTX_VERIFY_POINTER(pEntries);
 
-    intptr_t mpos = 0;
-    intptr_t ipos = 0;
-    intptr_t lpos = GBL_ARRAY_HEAP_LEFT_(ipos);
-    intptr_t rpos = GBL_ARRAY_HEAP_RIGHT_(ipos);
-    void* pTemp   = GBL_ALLOCA(GblArrayHeap_elementSize(pSelf));
+    const size_t size     = GblArrayHeap_size(pSelf);
+    const size_t elemSize = GblArrayHeap_elementSize(pSelf);
 
-    while(1) {
-        lpos = GBL_ARRAY_HEAP_LEFT_(ipos);
-        rpos = GBL_ARRAY_HEAP_RIGHT_(ipos);
-
-        if(lpos < (intptr_t)GblArrayHeap_size(pSelf) &&
-           GBL_PRIV_REF(pSelf).pFnCmp(GblArrayList_at(pList, lpos),
-                                      GblArrayList_at(pList, ipos)) > 0) {
-            mpos = lpos;
-        } else {
-            mpos = ipos;
-        }
+    if(pHandles) GBL_CTX_VERIFY_CALL(GblArrayHeap_track_(pSelf));
+    if(GBL_PRIV_REF(pSelf).pTracker)
+        GBL_CTX_VERIFY_CALL(GblArrayHeap_trackerReserve_(pSelf, size + count));
+
+    GBL_CTX_VERIFY_CALL(GblArrayList_append(GBL_ARRAY_HEAP_LIST_(pSelf), pEntries, count));
+
+    uint8_t*              pData    = GblArrayHeap_data(pSelf);
+    GblArrayHeapTracker_* pTracker = GBL_PRIV_REF(pSelf).pTracker;
+
+    if(pTracker) {
+        for(size_t e = 0; e < count; ++e) {
+            const uint32_t handle = GblArrayHeap_handleAlloc_(pSelf);
+
+            pTracker->pHandles[size + e] = handle;
+            pTracker->pPositions[handle] = (uint32_t)(size + e);
 
-        if(rpos < (intptr_t)GblArrayHeap_size(pSelf) &&
-           GBL_PRIV_REF(pSelf).pFnCmp(GblArrayList_at(pList, rpos),
-                                      GblArrayList_at(pList, mpos)) > 0) {
-            mpos = rpos;
+            if(pHandles) pHandles[e] = handle;
         }
+    }
 
-        if(mpos == ipos) break;
+    // rebuilding the whole heap is linear, which beats sifting each new entry up once the heap at least doubles
+    if(count >= size) {
+        GblArrayHeap_heapify_(pSelf);
+    } else {
+        void* pTemp = GBL_ALLOCA(elemSize);
+
+        for(size_t p = size; p < size + count; ++p) {
+            memcpy(pTemp, GBL_ARRAY_HEAP_AT_(pData, elemSize, p), elemSize);
+            GblArrayHeap_siftUp_(pSelf,
+                                 p,
+                                 pTemp,
+                                 pTracker? pTracker->pHandles[p] : GBL_ARRAY_HEAP_HANDLE_INVALID);
+        }
+    }
 
-        memcpy(pTemp, GblArrayList_at(pList, mpos), GblArrayHeap_elementSize(pSelf));
-        memcpy(GblArrayList_at(pList, mpos), GblArrayList_at(pList, ipos), GblArrayHeap_elementSize(pSelf));
-        memcpy(GblArrayList_at(pList, ipos), pTemp, GblArrayHeap_elementSize(pSelf));
+    GBL_CTX_END();
+}
 
-        ipos = mpos;
+// takes the entry at pos out, filling its spot with the last entry
+static GBL_RESULT GblArrayHeap_remove_(GblArrayHeap* pSelf, size_t pos, void* pEntryOut) {
+    GblArrayHeapTracker_* pTracker = GBL_PRIV_REF(pSelf).pTracker;
+    uint8_t*              pData    = GblArrayHeap_data(pSelf);
+    const size_t          elemSize = GblArrayHeap_elementSize(pSelf);
+    const size_t          last     = GblArrayHeap_size(pSelf) - 1;
+
+    if(pEntryOut) memcpy(pEntryOut, GBL_ARRAY_HEAP_AT_(pData, elemSize, pos), elemSize);
+    if(pTracker)  GblArrayHeap_handleFree_(pSelf, pTracker->pHandles[pos]);
+
+    if(pos != last) {
+        void* pTemp = GBL_ALLOCA(elemSize);
+
+        memcpy(pTemp, GBL_ARRAY_HEAP_AT_(pData, elemSize, last), elemSize);
+        GblArrayHeap_fix_(pSelf,
+                          pos,
+                          pTemp,
+                          pTracker? pTracker->pHandles[last] : GBL_ARRAY_HEAP_HANDLE_INVALID,
+                          last);
     }
-    return result;
+
+    return GblArrayList_resize(GBL_ARRAY_HEAP_LIST_(pSelf), last);
+}
+
+GBL_EXPORT void* GblArrayHeap_at(const GblArrayHeap* pSelf, GblArrayHeapHandle handle) {
+    void* pEntry = NULL;
+    GBL_CTX_BEGIN(GblArrayHeap_context(pSelf));
+
+    const size_t pos = GblArrayHeap_position_(pSelf, handle);
+    GBL_CTX_VERIFY(pos != SIZE_MAX, GBL_RESULT_ERROR_INVALID_HANDLE);
+
+    pEntry = GBL_ARRAY_HEAP_AT_(GblArrayHeap_data(pSelf), GblArrayHeap_elementSize(pSelf), pos);
+
+    GBL_CTX_END_BLOCK();
+    return pEntry;
+}
+
+GBL_EXPORT GBL_RESULT GblArrayHeap_update(GblArrayHeap* pSelf, GblArrayHeapHandle handle, const void* pEntry) {
+    GBL_CTX_BEGIN(GblArrayHeap_context(pSelf));
+    GBL_CTX_VERIFY_POINTER(pEntry);
+
+    const size_t pos = GblArrayHeap_position_(pSelf, handle);
+    GBL_CTX_VERIFY(pos != SIZE_MAX, GBL_RESULT_ERROR_INVALID_HANDLE);
+
+    void* pTemp = GBL_ALLOCA(GblArrayHeap_elementSize(pSelf));
+    memcpy(pTemp, pEntry, GblArrayHeap_elementSize(pSelf));
+
+    GblArrayHeap_fix_(pSelf, pos, pTemp, handle, GblArrayHeap_size(pSelf));
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblArrayHeap_remove(GblArrayHeap* pSelf, GblArrayHeapHandle handle, void* pEntryOut) {
+    GBL_CTX_BEGIN(GblArrayHeap_context(pSelf));
+
+    const size_t pos = GblArrayHeap_position_(pSelf, handle);
+    GBL_CTX_VERIFY(pos != SIZE_MAX, GBL_RESULT_ERROR_INVALID_HANDLE);
+
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_remove_(pSelf, pos, pEntryOut));
+
+    GBL_CTX_END();
 }
 
+GBL_EXPORT GBL_RESULT GblArrayHeap_pop(GblArrayHeap* pSelf, void* pEntryOut) {
+    GBL_CTX_BEGIN(GblArrayHeap_context(pSelf));
+
+    const size_t size = GblArrayHeap_size(pSelf);
+    GBL_CTX_VERIFY(size, GBL_RESULT_ERROR_OUT_OF_RANGE);
+
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_remove_(pSelf, 0, pEntryOut));
+
+    GBL_CTX_END();
+}
 
 GBL_EXPORT GblContext* GblArrayHeap_context(const GblArrayHeap* pSelf) {
     return GblArrayList_context(&GBL_PRIV_REF(pSelf).list);
@@ -135,6 +514,10 @@ GBL_EXPORT size_t  GblArrayHeap_elementSize(const GblArrayHeap* pSelf) {
     return GblArrayList_elementSize(&GBL_PRIV_REF(pSelf).list);
 }
 
+GBL_EXPORT size_t GblArrayHeap_arity(const GblArrayHeap* pSelf) {
+    return GBL_PRIV_REF(pSelf).arity;
+}
+
 GBL_EXPORT size_t  GblArrayHeap_size(const GblArrayHeap* pSelf)  {
     return GblArrayList_size(&GBL_PRIV_REF(pSelf).list);
 }
@@ -151,6 +534,10 @@ GBL_EXPORT GblBool GblArrayHeap_empty(const GblArrayHeap* pSelf) {
     return GblArrayList_empty(&GBL_PRIV_REF(pSelf).list);
 }
 
+GBL_EXPORT GblBool GblArrayHeap_tracking(const GblArrayHeap* pSelf) {
+    return GBL_PRIV_REF(pSelf).pTracker != NULL;
+}
+
 GBL_EXPORT void* GblArrayHeap_data(const GblArrayHeap* pSelf) {
     return GblArrayList_data(&GBL_PRIV_REF(pSelf).list);
 }
@@ -160,6 +547,11 @@ GBL_EXPORT void* GblArrayHeap_peek(const GblArrayHeap* pSelf) {
 }
 
 GBL_EXPORT GBL_RESULT GblArrayHeap_clear(GblArrayHeap* pSelf) {
+    if(GBL_PRIV_REF(pSelf).pTracker) {
+        GBL_PRIV_REF(pSelf).pTracker->handleCount = 0;
+        GBL_PRIV_REF(pSelf).pTracker->freeHead    = GBL_ARRAY_HEAP_HANDLE_INVALID;
+    }
+
     return GblArrayList_clear(&GBL_PRIV_REF(pSelf).list);
 }
 
@@ -176,10 +568,17 @@ GBL_EXPORT GBL_RESULT GblArrayHeap_acquire(GblArrayHeap* pSelf,
                                            size_t        size,
                                            size_t        capacity)
 {
-    return GblArrayList_acquire(&GBL_PRIV_REF(pSelf).list,
-                                pData,
-                                size,
-                                capacity);
+    // the adopted entries are in no particular order, and any previous handles are stale
+    GblArrayHeap_untrack_(pSelf);
+
+    const GBL_RESULT result = GblArrayList_acquire(&GBL_PRIV_REF(pSelf).list,
+                                                   pData,
+                                                   size,
+                                                   capacity);
+    if(GBL_RESULT_SUCCESS(result))
+        GblArrayHeap_heapify_(pSelf);
+
+    return result;
 }
 
 GBL_EXPORT GBL_RESULT GblArrayHeap_release(GblArrayHeap* pSelf,
@@ -187,6 +586,8 @@ GBL_EXPORT GBL_RESULT GblArrayHeap_release(GblArrayHeap* pSelf,
                                            size_t * pSize,
                                            size_t * pCapacity)
 {
+    GblArrayHeap_untrack_(pSelf);
+
     return GblArrayList_release(&GBL_PRIV_REF(pSelf).list,
                                 ppData,
                                 pSize,
@@ -0,0 +1,446 @@
+#include <gimbal/containers/gimbal_concurrent_hash_set.h>
+#include <gimbal/algorithms/gimbal_numeric.h>
+
+#include <tinycthread.h>
+#include <stdatomic.h>
+
+#define GBL_CONCURRENT_HASH_SET_SPIN_COUNT_     16          // busy-waits on a shard lock before yielding
+#define GBL_CONCURRENT_HASH_SET_SHARD_ALIGN_    64          // keeps each shard's lock on its own cache line
+
+/* Each shard is a GblHashSet guarded by a readers-writer spin lock, where
+   lock holds the number of readers, or -1 while a writer holds it. Writers
+   announce themselves through writers first, which holds off new readers
+   so that a steady stream of lookups can't starve them. */
+struct GblConcurrentHashSetShard_ {
+    GBL_ALIGNAS(GBL_CONCURRENT_HASH_SET_SHARD_ALIGN_)
+    atomic_int            lock;
+    atomic_int            writers;
+    atomic_size_t         count;    // mirrors set's count, so size() needn't lock
+    GblHashSet            set;      // has the GblConcurrentHashSet as its userdata, for forwarding callbacks
+};
+
+typedef GblConcurrentHashSetShard_ Shard_;
+
+static void GblConcurrentHashSet_backoff_(unsigned* pSpins) {
+    if(++*pSpins >= GBL_CONCURRENT_HASH_SET_SPIN_COUNT_) {
+        *pSpins = 0;
+        thrd_yield();
+    }
+}
+
+static void GblConcurrentHashSet_readLock_(Shard_* pShard) {
+    unsigned spins = 0;
+
+    for(;;) {
+        if GBL_LIKELY(!atomic_load_explicit(&pShard->writers, memory_order_relaxed)) {
+            int readers = atomic_load_explicit(&pShard->lock, memory_order_relaxed);
+
+            if GBL_LIKELY(readers >= 0 &&
+                          atomic_compare_exchange_weak_explicit(&pShard->lock,
+                                                                &readers,
+                                                                readers + 1,
+                                                                memory_order_acquire,
+                                                                memory_order_relaxed))
+                return;
+        }
+
+        GblConcurrentHashSet_backoff_(&spins);
+    }
+}
+
+static void GblConcurrentHashSet_readUnlock_(Shard_* pShard) {
+    atomic_fetch_sub_explicit(&pShard->lock, 1, memory_order_release);
+}
+
+static void GblConcurrentHashSet_writeLock_(Shard_* pShard) {
+    unsigned spins = 0;
+
+    atomic_fetch_add_explicit(&pShard->writers, 1, memory_order_relaxed);
+
+    for(;;) {
+        int readers = 0;
+
+        if GBL_LIKELY(atomic_compare_exchange_weak_explicit(&pShard->lock,
+                                                            &readers,
+                                                            -1,
+                                                            memory_order_acquire,
+                                                            memory_order_relaxed))
+            break;
+
+        GblConcurrentHashSet_backoff_(&spins);
+    }
+
+    atomic_fetch_sub_explicit(&pShard->writers, 1, memory_order_relaxed);
+}
+
+static void GblConcurrentHashSet_writeUnlock_(Shard_* pShard) {
+    atomic_store_explicit(&pShard->count,
+                          GblHashSet_size(&pShard->set),
+                          memory_order_relaxed);
+    atomic_store_explicit(&pShard->lock, 0, memory_order_release);
+}
+
+// Selects the shard from hash bits which are independent from those used within the shard
+GBL_INLINE Shard_* GblConcurrentHashSet_shard_(const GblConcurrentHashSet* pSelf, const void* pKey) {
+    const GblHash hash = GBL_PRIV_REF(pSelf).pFnHash(pSelf, pKey);
+    return &GBL_PRIV_REF(pSelf).pShards[((uint32_t)(hash * 0x9e3779b9u) >> 16) &
+                                        GBL_PRIV_REF(pSelf).shardMask];
+}
+
+static GblHash GblConcurrentHashSet_hasher_(const GblHashSet* pSet, const void* pEntry) {
+    const GblConcurrentHashSet* pSelf = GblHashSet_userdata(pSet);
+    return GBL_PRIV_REF(pSelf).pFnHash(pSelf, pEntry);
+}
+
+static GblBool GblConcurrentHashSet_comparator_(const GblHashSet* pSet, const void* pEntry1, const void* pEntry2) {
+    const GblConcurrentHashSet* pSelf = GblHashSet_userdata(pSet);
+    return GBL_PRIV_REF(pSelf).pFnCompare(pSelf, pEntry1, pEntry2);
+}
+
+static void GblConcurrentHashSet_destructor_(const GblHashSet* pSet, void* pEntry) {
+    const GblConcurrentHashSet* pSelf = GblHashSet_userdata(pSet);
+    GBL_PRIV_REF(pSelf).pFnDestruct(pSelf, pEntry);
+}
+
+GBL_EXPORT GBL_RESULT GblConcurrentHashSet_construct_9(GblConcurrentHashSet*      pSelf,
+                                                       size_t                     entrySize,
+                                                       GblConcurrentHashSetHashFn pFnHash,
+                                                       GblConcurrentHashSetCmpFn  pFnCompare,
+                                                       GblConcurrentHashSetDtorFn pFnDestruct,
+                                                       size_t                     capacity,
+                                                       GblContext*                pCtx,
+                                                       void*                      pUserdata,
+                                                       size_t                     shardCount)
+{
+    GBL_CTX_BEGIN(pCtx);
+    GBL_CTX_VERIFY_POINTER(pSelf);
+    GBL_CTX_VERIFY_POINTER(pFnHash);
+    GBL_CTX_VERIFY_POINTER(pFnCompare);
+    GBL_CTX_VERIFY_ARG(entrySize);
+
+    memset(pSelf, 0, sizeof(GblConcurrentHashSet));
+
+    if(!shardCount) shardCount = GBL_CONCURRENT_HASH_SET_SHARD_COUNT_DEFAULT;
+    shardCount = gblPow2Next_u64(shardCount);
+    GBL_CTX_VERIFY(shardCount <= 0x10000,
+                   GBL_RESULT_ERROR_OUT_OF_RANGE,
+                   "Too many shards requested: [%zu]",
+                   shardCount);
+
+    GBL_PRIV_REF(pSelf).pCtx        = pCtx;
+    GBL_PRIV_REF(pSelf).entrySize   = entrySize;
+    GBL_PRIV_REF(pSelf).pFnHash     = pFnHash;
+    GBL_PRIV_REF(pSelf).pFnCompare  = pFnCompare;
+    GBL_PRIV_REF(pSelf).pFnDestruct = pFnDestruct;
+    GBL_PRIV_REF(pSelf).pUserdata   = pUserdata;
+    GBL_PRIV_REF(pSelf).shardMask   = shardCount - 1;
+    GBL_PRIV_REF(pSelf).pShards     = GBL_CTX_MALLOC(gblAlignedAllocSizeDefault(sizeof(Shard_) * shardCount),
+                                                     GBL_CONCURRENT_HASH_SET_SHARD_ALIGN_,
+                                                     "GblConcurrentHashSet");
+
+    for(size_t s = 0; s < shardCount; ++s) {
+        Shard_* pShard = &GBL_PRIV_REF(pSelf).pShards[s];
+
+        atomic_init(&pShard->lock, 0);
+        atomic_init(&pShard->writers, 0);
+        atomic_init(&pShard->count, 0);
+
+        GBL_CTX_VERIFY_CALL(GblHashSet_construct(&pShard->set,
+                                                 entrySize,
+                                                 GblConcurrentHashSet_hasher_,
+                                                 GblConcurrentHashSet_comparator_,
+                                                 pFnDestruct? GblConcurrentHashSet_destructor_ : NULL,
+                                                 capacity / shardCount,
+                                                 pCtx,
+                                                 pSelf,
+                                                 GBL_HASH_SET_LAYOUT_GROUPED));
+    }
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblConcurrentHashSet_construct_8(GblConcurrentHashSet*      pSelf,
+                                                       size_t                     entrySize,
+                                                       GblConcurrentHashSetHashFn pFnHash,
+                                                       GblConcurrentHashSetCmpFn  pFnCompare,
+                                                       GblConcurrentHashSetDtorFn pFnDestruct,
+                                                       size_t                     capacity,
+                                                       GblContext*                pCtx,
+                                                       void*                      pUserdata)
+{
+    return GblConcurrentHashSet_construct_9(pSelf, entrySize, pFnHash, pFnCompare, pFnDestruct, capacity, pCtx, pUserdata, 0);
+}
+
+GBL_EXPORT GBL_RESULT GblConcurrentHashSet_construct_7(GblConcurrentHashSet*      pSelf,
+                                                       size_t                     entrySize,
+                                                       GblConcurrentHashSetHashFn pFnHash,
+                                                       GblConcurrentHashSetCmpFn  pFnCompare,
+                                                       GblConcurrentHashSetDtorFn pFnDestruct,
+                                                       size_t                     capacity,
+                                                       GblContext*                pCtx)
+{
+    return GblConcurrentHashSet_construct_8(pSelf, entrySize, pFnHash, pFnCompare, pFnDestruct, capacity, pCtx, NULL);
+}
+
+GBL_EXPORT GBL_RESULT GblConcurrentHashSet_construct_6(GblConcurrentHashSet*      pSelf,
+                                                       size_t                     entrySize,
+                                                       GblConcurrentHashSetHashFn pFnHash,
+                                                       GblConcurrentHashSetCmpFn  pFnCompare,
+                                                       GblConcurrentHashSetDtorFn pFnDestruct,
+                                                       size_t                     capacity)
+{
+    return GblConcurrentHashSet_construct_7(pSelf, entrySize, pFnHash, pFnCompare, pFnDestruct, capacity, NULL);
+}
+
+GBL_EXPORT GBL_RESULT GblConcurrentHashSet_construct_5(GblConcurrentHashSet*      pSelf,
+                                                       size_t                     entrySize,
+                                                       GblConcurrentHashSetHashFn pFnHash,
+                                                       GblConcurrentHashSetCmpFn  pFnCompare,
+                                                       GblConcurrentHashSetDtorFn pFnDestruct)
+{
+    return GblConcurrentHashSet_construct_6(pSelf, entrySize, pFnHash, pFnCompare, pFnDestruct, 0);
+}
+
+GBL_EXPORT GBL_RESULT GblConcurrentHashSet_construct_4(GblConcurrentHashSet*      pSelf,
+                                                       size_t                     entrySize,
+                                                       GblConcurrentHashSetHashFn pFnHash,
+                                                       GblConcurrentHashSetCmpFn  pFnCompare)
+{
+    return GblConcurrentHashSet_construct_5(pSelf, entrySize, pFnHash, pFnCompare, NULL);
+}
+
+GBL_EXPORT GBL_RESULT GblConcurrentHashSet_destruct(GblConcurrentHashSet* pSelf) {
+    GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
+
+    if(GBL_PRIV_REF(pSelf).pShards) {
+        for(size_t s = 0; s <= GBL_PRIV_REF(pSelf).shardMask; ++s)
+            GBL_CTX_VERIFY_CALL(GblHashSet_destruct(&GBL_PRIV_REF(pSelf).pShards[s].set));
+
+        GBL_CTX_FREE(GBL_PRIV_REF(pSelf).pShards);
+        GBL_PRIV_REF(pSelf).pShards = NULL;
+    }
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT size_t GblConcurrentHashSet_size(const GblConcurrentHashSet* pSelf) {
+    size_t count = 0;
+
+    for(size_t s = 0; s <= GBL_PRIV_REF(pSelf).shardMask; ++s)
+        count += atomic_load_explicit(&GBL_PRIV_REF(pSelf).pShards[s].count, memory_order_relaxed);
+
+    return count;
+}
+
+GBL_EXPORT GblBool GblConcurrentHashSet_empty(const GblConcurrentHashSet* pSelf) {
+    return GblConcurrentHashSet_size(pSelf)? GBL_FALSE : GBL_TRUE;
+}
+
+GBL_EXPORT size_t GblConcurrentHashSet_shardCount(const GblConcurrentHashSet* pSelf) {
+    return GBL_PRIV_REF(pSelf).shardMask + 1;
+}
+
+GBL_EXPORT GblContext* GblConcurrentHashSet_context(const GblConcurrentHashSet* pSelf) {
+    return GBL_PRIV_REF(pSelf).pCtx;
+}
+
+GBL_EXPORT void* GblConcurrentHashSet_userdata(const GblConcurrentHashSet* pSelf) {
+    return GBL_PRIV_REF(pSelf).pUserdata;
+}
+
+GBL_EXPORT GblBool GblConcurrentHashSet_get(const GblConcurrentHashSet* pSelf, const void* pKey, void* pEntry) {
+    GblBool found = GBL_FALSE;
+
+    if GBL_UNLIKELY(!pKey) {
+        GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
+        GBL_CTX_VERIFY_POINTER(pKey);
+        GBL_CTX_END_BLOCK();
+    } else {
+        Shard_* pShard = GblConcurrentHashSet_shard_(pSelf, pKey);
+
+        GblConcurrentHashSet_readLock_(pShard);
+
+        const void* pFound = GblHashSet_get(&pShard->set, pKey);
+        if(pFound) {
+            if(pEntry) memcpy(pEntry, pFound, GBL_PRIV_REF(pSelf).entrySize);
+            found = GBL_TRUE;
+        }
+
+        GblConcurrentHashSet_readUnlock_(pShard);
+    }
+
+    return found;
+}
+
+GBL_EXPORT GblBool GblConcurrentHashSet_contains(const GblConcurrentHashSet* pSelf, const void* pKey) {
+    return GblConcurrentHashSet_get(pSelf, pKey, NULL);
+}
+
+GBL_EXPORT size_t GblConcurrentHashSet_count(const GblConcurrentHashSet* pSelf, const void* pKey) {
+    return GblConcurrentHashSet_get(pSelf, pKey, NULL)? 1 : 0;
+}
+
+GBL_EXPORT GblBool (GblConcurrentHashSet_set)(GblConcurrentHashSet* pSelf, const void* pEntry, void* pPrevEntry) {
+    GblBool replaced = GBL_FALSE;
+
+    if GBL_UNLIKELY(!pEntry) {
+        GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
+        GBL_CTX_VERIFY_POINTER(pEntry);
+        GBL_CTX_END_BLOCK();
+    } else {
+        Shard_* pShard = GblConcurrentHashSet_shard_(pSelf, pEntry);
+
+        GblConcurrentHashSet_writeLock_(pShard);
+
+        const void* pPrev = GblHashSet_set(&pShard->set, pEntry);
+        if(pPrev) {
+            if(pPrevEntry) memcpy(pPrevEntry, pPrev, GBL_PRIV_REF(pSelf).entrySize);
+            replaced = GBL_TRUE;
+        }
+
+        GblConcurrentHashSet_writeUnlock_(pShard);
+    }
+
+    return replaced;
+}
+
+GBL_EXPORT GblBool GblConcurrentHashSet_insert(GblConcurrentHashSet* pSelf, const void* pEntry) {
+    GblBool inserted = GBL_FALSE;
+
+    if GBL_UNLIKELY(!pEntry) {
+        GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
+        GBL_CTX_VERIFY_POINTER(pEntry);
+        GBL_CTX_END_BLOCK();
+    } else {
+        Shard_* pShard = GblConcurrentHashSet_shard_(pSelf, pEntry);
+
+        GblConcurrentHashSet_writeLock_(pShard);
+        inserted = GblHashSet_insert(&pShard->set, pEntry);
+        GblConcurrentHashSet_writeUnlock_(pShard);
+    }
+
+    return inserted;
+}
+
+GBL_EXPORT void GblConcurrentHashSet_insertOrAssign(GblConcurrentHashSet* pSelf, const void* pEntry) {
+    if GBL_UNLIKELY(!pEntry) {
+        GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
+        GBL_CTX_VERIFY_POINTER(pEntry);
+        GBL_CTX_END_BLOCK();
+    } else {
+        Shard_* pShard = GblConcurrentHashSet_shard_(pSelf, pEntry);
+
+        GblConcurrentHashSet_writeLock_(pShard);
+        GblHashSet_insertOrAssign(&pShard->set, pEntry);
+        GblConcurrentHashSet_writeUnlock_(pShard);
+    }
+}
+
+GBL_EXPORT GblBool GblConcurrentHashSet_visit(GblConcurrentHashSet*      pSelf,
+                                              const void*                pKey,
+                                              GblConcurrentHashSetIterFn pFnVisit,
+                                              void*                      pUdata)
+{
+    GblBool found = GBL_FALSE;
+
+    if GBL_UNLIKELY(!pKey || !pFnVisit) {
+        GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
+        GBL_CTX_VERIFY_POINTER(pKey);
+        GBL_CTX_VERIFY_POINTER(pFnVisit);
+        GBL_CTX_END_BLOCK();
+    } else {
+        Shard_* pShard = GblConcurrentHashSet_shard_(pSelf, pKey);
+
+        GblConcurrentHashSet_writeLock_(pShard);
+
+        void* pEntry = GblHashSet_get(&pShard->set, pKey);
+        if(pEntry) {
+            pFnVisit(pSelf, pEntry, pUdata);
+            found = GBL_TRUE;
+        }
+
+        GblConcurrentHashSet_writeUnlock_(pShard);
+    }
+
+    return found;
+}
+
+GBL_EXPORT GblBool GblConcurrentHashSet_erase(GblConcurrentHashSet* pSelf, const void* pKey) {
+    GblBool removed = GBL_FALSE;
+
+    if GBL_UNLIKELY(!pKey) {
+        GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
+        GBL_CTX_VERIFY_POINTER(pKey);
+        GBL_CTX_END_BLOCK();
+    } else {
+        Shard_* pShard = GblConcurrentHashSet_shard_(pSelf, pKey);
+
+        GblConcurrentHashSet_writeLock_(pShard);
+        removed = GblHashSet_erase(&pShard->set, pKey);
+        GblConcurrentHashSet_writeUnlock_(pShard);
+    }
+
+    return removed;
+}
+
+GBL_EXPORT GblBool GblConcurrentHashSet_extract(GblConcurrentHashSet* pSelf, const void* pKey, void* pEntry) {
+    GblBool removed = GBL_FALSE;
+
+    if GBL_UNLIKELY(!pKey) {
+        GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
+        GBL_CTX_VERIFY_POINTER(pKey);
+        GBL_CTX_END_BLOCK();
+    } else {
+        Shard_* pShard = GblConcurrentHashSet_shard_(pSelf, pKey);
+
+        GblConcurrentHashSet_writeLock_(pShard);
+
+        const void* pExtracted = GblHashSet_extract(&pShard->set, pKey);
+        if(pExtracted) {
+            if(pEntry) memcpy(pEntry, pExtracted, GBL_PRIV_REF(pSelf).entrySize);
+            removed = GBL_TRUE;
+        }
+
+        GblConcurrentHashSet_writeUnlock_(pShard);
+    }
+
+    return removed;
+}
+
+GBL_EXPORT void GblConcurrentHashSet_clear(GblConcurrentHashSet* pSelf) {
+    for(size_t s = 0; s <= GBL_PRIV_REF(pSelf).shardMask; ++s) {
+        Shard_* pShard = &GBL_PRIV_REF(pSelf).pShards[s];
+
+        GblConcurrentHashSet_writeLock_(pShard);
+        GblHashSet_clear(&pShard->set);
+        GblConcurrentHashSet_writeUnlock_(pShard);
+    }
+}
+
+typedef struct GblConcurrentHashSetForeach_ {
+    GblConcurrentHashSetIterFn pFnIter;
+    void*                      pUdata;
+} GblConcurrentHashSetForeach_;
+
+static GblBool GblConcurrentHashSet_foreachIter_(const GblHashSet* pSet, void* pEntry, void* pUdata) {
+    const GblConcurrentHashSetForeach_* pForeach = pUdata;
+    return pForeach->pFnIter(GblHashSet_userdata(pSet), pEntry, pForeach->pUdata);
+}
+
+GBL_EXPORT GblBool GblConcurrentHashSet_foreach(const GblConcurrentHashSet* pSelf,
+                                                GblConcurrentHashSetIterFn  pFnIter,
+                                                void*                       pUdata)
+{
+    GblBool finished = GBL_TRUE;
+    GblConcurrentHashSetForeach_ foreach = { pFnIter, pUdata };
+
+    for(size_t s = 0; s <= GBL_PRIV_REF(pSelf).shardMask && finished; ++s) {
+        Shard_* pShard = &GBL_PRIV_REF(pSelf).pShards[s];
+
+        GblConcurrentHashSet_readLock_(pShard);
+        finished = GblHashSet_foreach(&pShard->set, GblConcurrentHashSet_foreachIter_, &foreach);
+        GblConcurrentHashSet_readUnlock_(pShard);
+    }
+
+    return finished;
+}
@@ -2,6 +2,20 @@
 #include <gimbal/algorithms/gimbal_hash.h>
 #include <gimbal/algorithms/gimbal_numeric.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define GBL_HASH_SET_SSE2_
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#   include <arm_neon.h>
+#   define GBL_HASH_SET_NEON_
+#endif
+
+#define GBL_HASH_SET_GROUP_WIDTH_       16
+#define GBL_HASH_SET_GROUP_SHIFT_       4
+#define GBL_HASH_SET_CTRL_EMPTY_        0x80
+#define GBL_HASH_SET_CTRL_DELETED_      0xfe
+#define GBL_HASH_SET_GROUPED_(self)     (GBL_PRIV_REF(self).layout == GBL_HASH_SET_LAYOUT_GROUPED)
+
 struct GblHashSetBucket_ {
     uint32_t hash;
     uint16_t dib;
@@ -18,22 +32,246 @@ GBL_INLINE void *GblHashSet_bucketItem_(struct GblHashSetBucket_ *entry) {
 GBL_INLINE uint32_t GblHashSet_getHash_(const struct GblHashSet *map, const void *key) {
     return GBL_PRIV_REF(map).pFnHash(map, key);
 }
+
+/* ===== GBL_HASH_SET_LAYOUT_GROUPED =====
+ * Every bucket has a control byte, which is either EMPTY, DELETED (a
+ * tombstone), or the low 7 bits of its entry's hash (the "tag"). Control
+ * bytes are probed a group of 16 at a time, comparing the whole group
+ * against a tag at once, and only entries whose tags match are ever
+ * touched. The remaining hash bits select the first group, with
+ * subsequent groups visited by triangular probing, which covers every
+ * group of a power-of-two table.
+ *
+ * A lookup stops at the first group containing an EMPTY byte, so a
+ * removed entry only reverts to EMPTY if its group already contains one,
+ * meaning no probe sequence could have been passing through it.
+ */
+
+GBL_INLINE uint32_t GblHashSet_groupMatch_(const uint8_t* pGroup, uint8_t ctrl) {
+#if defined(GBL_HASH_SET_SSE2_)
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)pGroup),
+                                                      _mm_set1_epi8((char)ctrl)));
+#elif defined(GBL_HASH_SET_NEON_)
+    static const uint8_t bits[GBL_HASH_SET_GROUP_WIDTH_] = {
+        1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128
+    };
+    const uint8x16_t matches = vandq_u8(vceqq_u8(vld1q_u8(pGroup), vdupq_n_u8(ctrl)),
+                                        vld1q_u8(bits));
+    return (uint32_t)vaddv_u8(vget_low_u8(matches)) |
+           ((uint32_t)vaddv_u8(vget_high_u8(matches)) << 8);
+#else
+    uint32_t mask = 0;
+    for(unsigned b = 0; b < GBL_HASH_SET_GROUP_WIDTH_; ++b)
+        mask |= (uint32_t)(pGroup[b] == ctrl) << b;
+    return mask;
+#endif
+}
+
+// Both EMPTY and DELETED have their high bit set, while tags never do
+GBL_INLINE uint32_t GblHashSet_groupMatchFree_(const uint8_t* pGroup) {
+#if defined(GBL_HASH_SET_SSE2_)
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)pGroup));
+#elif defined(GBL_HASH_SET_NEON_)
+    static const uint8_t bits[GBL_HASH_SET_GROUP_WIDTH_] = {
+        1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128
+    };
+    const uint8x16_t matches = vandq_u8(vtstq_u8(vld1q_u8(pGroup), vdupq_n_u8(0x80)),
+                                        vld1q_u8(bits));
+    return (uint32_t)vaddv_u8(vget_low_u8(matches)) |
+           ((uint32_t)vaddv_u8(vget_high_u8(matches)) << 8);
+#else
+    uint32_t mask = 0;
+    for(unsigned b = 0; b < GBL_HASH_SET_GROUP_WIDTH_; ++b)
+        mask |= (uint32_t)(pGroup[b] >> 7) << b;
+    return mask;
+#endif
+}
+
+GBL_INLINE void* GblHashSet_slotItem_(const GblHashSet* pSelf, size_t slot) {
+    return (char*)GBL_PRIV_REF(pSelf).pBuckets + slot * GBL_PRIV_REF(pSelf).entrySize;
+}
+
+// Maximum number of occupied buckets (including tombstones) at a 7/8 load factor
+GBL_INLINE size_t GblHashSet_groupedLimit_(size_t bucketCount) {
+    return bucketCount - bucketCount / 8;
+}
+
+// Returns the bucket holding an entry matching pKey, or bucketCount if there isn't one
+static size_t GblHashSet_findGrouped_(const GblHashSet* pSelf, const void* pKey, GblHash hash) {
+    const uint8_t* pCtrl     = GBL_PRIV_REF(pSelf).pCtrl;
+    const uint8_t  tag       = hash & 0x7f;
+    const size_t   groupMask = GBL_PRIV_REF(pSelf).mask >> GBL_HASH_SET_GROUP_SHIFT_;
+    size_t         group     = (hash >> 7) & groupMask;
+
+    for(size_t step = 1; ; ++step) {
+        const size_t   base   = group << GBL_HASH_SET_GROUP_SHIFT_;
+        const uint8_t* pGroup = &pCtrl[base];
+
+        for(uint32_t m = GblHashSet_groupMatch_(pGroup, tag); m; m &= m - 1) {
+            const size_t slot = base + GBL_BITMASK_CTZ(m);
+            if(GBL_PRIV_REF(pSelf).pFnCompare(pSelf, pKey, GblHashSet_slotItem_(pSelf, slot)))
+                return slot;
+        }
+
+        if GBL_LIKELY(GblHashSet_groupMatch_(pGroup, GBL_HASH_SET_CTRL_EMPTY_))
+            return GBL_PRIV_REF(pSelf).bucketCount;
+
+        group = (group + step) & groupMask;
+    }
+}
+
+// Returns the first EMPTY or DELETED bucket along the probe sequence for hash
+static size_t GblHashSet_findFreeGrouped_(const GblHashSet* pSelf, GblHash hash) {
+    const size_t groupMask = GBL_PRIV_REF(pSelf).mask >> GBL_HASH_SET_GROUP_SHIFT_;
+    size_t       group     = (hash >> 7) & groupMask;
+
+    for(size_t step = 1; ; ++step) {
+        const size_t   base = group << GBL_HASH_SET_GROUP_SHIFT_;
+        const uint32_t m    = GblHashSet_groupMatchFree_(&GBL_PRIV_REF(pSelf).pCtrl[base]);
+
+        if GBL_LIKELY(m)
+            return base + GBL_BITMASK_CTZ(m);
+
+        group = (group + step) & groupMask;
+    }
+}
+
+static GBL_RESULT GblHashSet_allocGrouped_(GblHashSet* pSelf, size_t bucketCount) {
+    GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
+
+    // entries first, so they keep the allocation's alignment, then the control bytes
+    void* pBlock = GBL_CTX_MALLOC(gblAlignedAllocSizeDefault(bucketCount * (GBL_PRIV_REF(pSelf).entrySize + 1)));
+    // Leaves the existing table intact, so a failed resize loses nothing
+    GBL_CTX_VERIFY(pBlock, GBL_RESULT_ERROR_MEM_ALLOC);
+
+    GBL_PRIV_REF(pSelf).pBuckets    = pBlock;
+    GBL_PRIV_REF(pSelf).pCtrl       = (uint8_t*)pBlock + bucketCount * GBL_PRIV_REF(pSelf).entrySize;
+    GBL_PRIV_REF(pSelf).bucketCount = bucketCount;
+    GBL_PRIV_REF(pSelf).mask        = bucketCount - 1;
+    GBL_PRIV_REF(pSelf).growthLeft  = GblHashSet_groupedLimit_(bucketCount) - GBL_PRIV_REF(pSelf).count;
+    memset(GBL_PRIV_REF(pSelf).pCtrl, GBL_HASH_SET_CTRL_EMPTY_, bucketCount);
+
+    GBL_CTX_END();
+}
+
+// Rehashes every entry into a new table, which also drops all tombstones
+static GBL_RESULT GblHashSet_resizeGrouped_(GblHashSet* pSelf, size_t bucketCount) {
+    GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
+
+    const size_t   entrySize      = GBL_PRIV_REF(pSelf).entrySize;
+    const size_t   oldBucketCount = GBL_PRIV_REF(pSelf).bucketCount;
+    const uint8_t* pOldCtrl       = GBL_PRIV_REF(pSelf).pCtrl;
+    char*          pOldBuckets    = GBL_PRIV_REF(pSelf).pBuckets;
+
+    if(bucketCount < GBL_HASH_SET_GROUP_WIDTH_)
+        bucketCount = GBL_HASH_SET_GROUP_WIDTH_;
+    bucketCount = gblPow2Next_u64(bucketCount);
+    while(GblHashSet_groupedLimit_(bucketCount) <= GBL_PRIV_REF(pSelf).count)
+        bucketCount <<= 1;
+
+    GBL_CTX_VERIFY_CALL(GblHashSet_allocGrouped_(pSelf, bucketCount));
+
+    for(size_t b = 0; b < oldBucketCount; ++b) {
+        if(pOldCtrl[b] & 0x80) continue;
+
+        const void*   pEntry = pOldBuckets + b * entrySize;
+        const GblHash hash   = GblHashSet_getHash_(pSelf, pEntry);
+        const size_t  slot   = GblHashSet_findFreeGrouped_(pSelf, hash);
+
+        GBL_PRIV_REF(pSelf).pCtrl[slot] = hash & 0x7f;
+        memcpy(GblHashSet_slotItem_(pSelf, slot), pEntry, entrySize);
+    }
+
+    GBL_CTX_FREE(pOldBuckets);
+
+    GBL_CTX_END();
+}
+
+static void* GblHashSet_rawSetGrouped_(GblHashSet* pSelf, const void* pItem, void** ppNewEntry) {
+    const GblHash hash = GblHashSet_getHash_(pSelf, pItem);
+    size_t        slot = GblHashSet_findGrouped_(pSelf, pItem, hash);
+
+    if(slot != GBL_PRIV_REF(pSelf).bucketCount) {
+        void* pEntry = GblHashSet_slotItem_(pSelf, slot);
+        memcpy(GBL_PRIV_REF(pSelf).pSpare, pEntry, GBL_PRIV_REF(pSelf).entrySize);
+        memcpy(pEntry, pItem, GBL_PRIV_REF(pSelf).entrySize);
+        if(ppNewEntry) *ppNewEntry = pEntry;
+        return GBL_PRIV_REF(pSelf).pSpare;
+    }
+
+    slot = GblHashSet_findFreeGrouped_(pSelf, hash);
+
+    // only claiming an EMPTY bucket uses up growth, reusing a tombstone doesn't
+    if(GBL_PRIV_REF(pSelf).pCtrl[slot] == GBL_HASH_SET_CTRL_EMPTY_) {
+        if GBL_UNLIKELY(!GBL_PRIV_REF(pSelf).growthLeft) {
+            // rehash in place when it's mostly tombstones, otherwise grow
+            const size_t bucketCount = GBL_PRIV_REF(pSelf).count * 2 < GblHashSet_groupedLimit_(GBL_PRIV_REF(pSelf).bucketCount)?
+                                           GBL_PRIV_REF(pSelf).bucketCount :
+                                           GBL_PRIV_REF(pSelf).bucketCount * 2;
+            if GBL_UNLIKELY(!GBL_RESULT_SUCCESS(GblHashSet_resizeGrouped_(pSelf, bucketCount)))
+                return NULL;
+
+            slot = GblHashSet_findFreeGrouped_(pSelf, hash);
+        }
+
+        --GBL_PRIV_REF(pSelf).growthLeft;
+    }
+
+    void* pEntry = GblHashSet_slotItem_(pSelf, slot);
+    GBL_PRIV_REF(pSelf).pCtrl[slot] = hash & 0x7f;
+    memcpy(pEntry, pItem, GBL_PRIV_REF(pSelf).entrySize);
+    ++GBL_PRIV_REF(pSelf).count;
+    if(ppNewEntry) *ppNewEntry = pEntry;
+
+    return NULL;
+}
+
+static void* GblHashSet_extractGrouped_(GblHashSet* pSelf, const void* pKey) {
+    const size_t slot = GblHashSet_findGrouped_(pSelf, pKey, GblHashSet_getHash_(pSelf, pKey));
+
+    if(slot == GBL_PRIV_REF(pSelf).bucketCount)
+        return NULL;
+
+    memcpy(GBL_PRIV_REF(pSelf).pSpare, GblHashSet_slotItem_(pSelf, slot), GBL_PRIV_REF(pSelf).entrySize);
+
+    const size_t base = slot & ~(size_t)(GBL_HASH_SET_GROUP_WIDTH_ - 1);
+    if(GblHashSet_groupMatch_(&GBL_PRIV_REF(pSelf).pCtrl[base], GBL_HASH_SET_CTRL_EMPTY_)) {
+        GBL_PRIV_REF(pSelf).pCtrl[slot] = GBL_HASH_SET_CTRL_EMPTY_;
+        ++GBL_PRIV_REF(pSelf).growthLeft;
+    } else {
+        GBL_PRIV_REF(pSelf).pCtrl[slot] = GBL_HASH_SET_CTRL_DELETED_;
+    }
+
+    --GBL_PRIV_REF(pSelf).count;
+
+    if(GBL_PRIV_REF(pSelf).bucketCount > GBL_PRIV_REF(pSelf).capacity &&
+       GBL_PRIV_REF(pSelf).count <= GBL_PRIV_REF(pSelf).bucketCount*0.1)
+    {
+        // Failing to shrink doesn't affect the integrity of the data.
+        GblHashSet_resizeGrouped_(pSelf, GBL_PRIV_REF(pSelf).bucketCount/2);
+    }
+
+    return GBL_PRIV_REF(pSelf).pSpare;
+}
 /// \endcond
 
 
-GBL_EXPORT GBL_RESULT GblHashSet_construct_8(GblHashSet*      pSet,
-                                             size_t           elsize,
-                                             GblHashSetHashFn pFnHash,
-                                             GblHashSetCmpFn  pFnCompare,
-                                             GblHashSetDtorFn pFnDestruct,
-                                             size_t           capacity,
-                                             GblContext*      pCtx,
-                                             void*            pUserdata)
+GBL_EXPORT GBL_RESULT GblHashSet_construct_9(GblHashSet*         pSet,
+                                             size_t              elsize,
+                                             GblHashSetHashFn    pFnHash,
+                                             GblHashSetCmpFn     pFnCompare,
+                                             GblHashSetDtorFn    pFnDestruct,
+                                             size_t              capacity,
+                                             GblContext*         pCtx,
+                                             void*               pUserdata,
+                                             GBL_HASH_SET_LAYOUT layout)
 {
 
     GBL_CTX_BEGIN(pCtx);
     {
         GBL_CTX_VERIFY_POINTER(pSet);
+        GBL_CTX_VERIFY_ARG(layout == GBL_HASH_SET_LAYOUT_ROBIN_HOOD ||
+                           layout == GBL_HASH_SET_LAYOUT_GROUPED);
         size_t  ncap = 16;
         if (capacity < ncap) {
             capacity = ncap;
@@ -56,8 +294,15 @@ GBL_EXPORT GBL_RESULT GblHashSet_construct_8(GblHashSet*      pSet,
         GBL_PRIV_REF(pSet).pFnHash        = pFnHash;
         GBL_PRIV_REF(pSet).pFnCompare     = pFnCompare;
         GBL_PRIV_REF(pSet).pFnDestruct    = pFnDestruct;
-        GBL_PRIV_REF(pSet).pSpare         = GBL_CTX_MALLOC(GBL_PRIV_REF(pSet).bucketSize);
+        GBL_PRIV_REF(pSet).layout         = layout;
         GBL_PRIV_REF(pSet).capacity       = capacity;
+        if(layout == GBL_HASH_SET_LAYOUT_GROUPED) {
+            GBL_PRIV_REF(pSet).bucketSize = elsize;
+            GBL_PRIV_REF(pSet).pSpare     = GBL_CTX_MALLOC(gblAlignedAllocSizeDefault(elsize));
+            GBL_CTX_VERIFY_CALL(GblHashSet_allocGrouped_(pSet, capacity));
+            GBL_CTX_DONE();
+        }
+        GBL_PRIV_REF(pSet).pSpare         = GBL_CTX_MALLOC(GBL_PRIV_REF(pSet).bucketSize);
         GBL_PRIV_REF(pSet).bucketCount    = capacity;
         GBL_PRIV_REF(pSet).mask           = GBL_PRIV_REF(pSet).bucketCount-1;
         GBL_PRIV_REF(pSet).pBuckets       = GBL_CTX_MALLOC(GBL_PRIV_REF(pSet).bucketSize*GBL_PRIV_REF(pSet).bucketCount);
@@ -66,6 +311,19 @@ GBL_EXPORT GBL_RESULT GblHashSet_construct_8(GblHashSet*      pSet,
     GBL_CTX_END();
 
 }
+
+GBL_EXPORT GBL_RESULT GblHashSet_construct_8(GblHashSet*      pSet,
+                                             size_t           entrySize,
+                                             GblHashSetHashFn pFnHash,
+                                             GblHashSetCmpFn  pFnCompare,
+                                             GblHashSetDtorFn pFnDestruct,
+                                             size_t           capacity,
+                                             GblContext*      pCtx,
+                                             void*            pUserdata)
+{
+    return GblHashSet_construct_9(pSet, entrySize, pFnHash, pFnCompare, pFnDestruct, capacity, pCtx, pUserdata, GBL_HASH_SET_LAYOUT_ROBIN_HOOD);
+}
+
 GBL_EXPORT GBL_RESULT             GblHashSet_construct_7(GblHashSet*                 pSet,
                                            size_t                      entrySize,
                                            GblHashSetHashFn       pFnHash,
@@ -106,14 +364,15 @@ GBL_EXPORT GBL_RESULT             GblHashSet_construct_4(GblHashSet*
 GBL_EXPORT GBL_RESULT  GblHashSet_clone(GblHashSet* pSelf, const GblHashSet* pRhs, GblContext* pCtx)  {
     if(!pCtx) pCtx = GBL_PRIV_REF(pRhs).pCtx;
     GBL_CTX_BEGIN(pCtx);
-    GBL_CTX_CALL(GblHashSet_construct_8(pSelf,
+    GBL_CTX_CALL(GblHashSet_construct_9(pSelf,
                                        GBL_PRIV_REF(pRhs).entrySize,
                                        GBL_PRIV_REF(pRhs).pFnHash,
                                        GBL_PRIV_REF(pRhs).pFnCompare,
                                        GBL_PRIV_REF(pRhs).pFnDestruct,
                                        GBL_PRIV_REF(pRhs).capacity,
                                        pCtx,
-                                       GBL_PRIV_REF(pRhs).pUserdata));
+                                       GBL_PRIV_REF(pRhs).pUserdata,
+                                       GBL_PRIV_REF(pRhs).layout));
 
     for(size_t  s = 0; s < GBL_PRIV_REF(pRhs).bucketCount; ++s) {
         void* pEntry = GblHashSet_probe(pRhs, s);
@@ -148,7 +407,12 @@ GBL_EXPORT GBL_RESULT GblHashSet_assignMove(GblHashSet* pLhs, GblHashSet* pRhs)
 }
 
 static void free_elements(GblHashSet *map) {
-    if (GBL_PRIV_REF(map).pFnDestruct) {
+    if (GBL_PRIV_REF(map).pFnDestruct && GBL_HASH_SET_GROUPED_(map)) {
+        for (size_t i = 0; i < GBL_PRIV_REF(map).bucketCount; i++) {
+            if (!(GBL_PRIV_REF(map).pCtrl[i] & 0x80))
+                GBL_PRIV_REF(map).pFnDestruct(map, GblHashSet_slotItem_(map, i));
+        }
+    } else if (GBL_PRIV_REF(map).pFnDestruct) {
         for (size_t i = 0; i < GBL_PRIV_REF(map).bucketCount; i++) {
             struct GblHashSetBucket_ *bucket = GblHashSet_bucketAt_(map, i);
             if (bucket->dib) GBL_PRIV_REF(map).pFnDestruct(map, GblHashSet_bucketItem_(bucket));
@@ -166,8 +430,14 @@ GBL_EXPORT void GblHashSet_clear(GblHashSet *map)  {
     if(!GBL_PRIV_REF(map).count) return;
     GblBool update_cap = GBL_TRUE;
     GBL_CTX_BEGIN(GBL_PRIV_REF(map).pCtx);
-    GBL_PRIV_REF(map).count = 0;
     free_elements(map);
+    GBL_PRIV_REF(map).count = 0;
+    if (GBL_HASH_SET_GROUPED_(map)) {
+        GBL_PRIV_REF(map).capacity = GBL_PRIV_REF(map).bucketCount;
+        GBL_PRIV_REF(map).growthLeft = GblHashSet_groupedLimit_(GBL_PRIV_REF(map).bucketCount);
+        memset(GBL_PRIV_REF(map).pCtrl, GBL_HASH_SET_CTRL_EMPTY_, GBL_PRIV_REF(map).bucketCount);
+        GBL_CTX_DONE();
+    }
     if (update_cap) {
         GBL_PRIV_REF(map).capacity = GBL_PRIV_REF(map).bucketCount;
     } else if (GBL_PRIV_REF(map).bucketCount != GBL_PRIV_REF(map).capacity) {
@@ -230,7 +500,9 @@ static GblBool resize(struct GblHashSet *map, size_t new_cap) {
 
 GBL_EXPORT GBL_RESULT GblHashSet_shrinkToFit(GblHashSet* pSelf)  {
     GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
-    if(GBL_PRIV_REF(pSelf).count < GBL_PRIV_REF(pSelf).bucketCount * 0.75) {
+    if(GBL_HASH_SET_GROUPED_(pSelf)) {
+        GBL_CTX_VERIFY_CALL(GblHashSet_resizeGrouped_(pSelf, GBL_PRIV_REF(pSelf).count));
+    } else if(GBL_PRIV_REF(pSelf).count < GBL_PRIV_REF(pSelf).bucketCount * 0.75) {
         GBL_CTX_VERIFY_EXPRESSION(resize(pSelf, GBL_PRIV_REF(pSelf).bucketCount*0.75));
     }
     GBL_CTX_END();
@@ -238,6 +510,9 @@ GBL_EXPORT GBL_RESULT GblHashSet_shrinkToFit(GblHashSet* pSelf)  {
 
 
 static void* GblHashSet_rawSet_(GblHashSet* map, const void* item, void** ppNewEntry)  {
+    if(GBL_HASH_SET_GROUPED_(map))
+        return GblHashSet_rawSetGrouped_(map, item, ppNewEntry);
+
     void* pPrevItem = NULL;
 
     void* edata = GBL_ALLOCA(GBL_PRIV_REF(map).bucketSize);
@@ -321,6 +596,9 @@ GBL_EXPORT void* GblHashSet_set(GblHashSet *map, const void *item)  {
 // buckets in the hashmap.
 GBL_EXPORT void* GblHashSet_probe(const GblHashSet *map, size_t  position)  {
     size_t i = position & GBL_PRIV_REF(map).mask;
+    if (GBL_HASH_SET_GROUPED_(map)) {
+        return (GBL_PRIV_REF(map).pCtrl[i] & 0x80)? NULL : GblHashSet_slotItem_(map, i);
+    }
     struct GblHashSetBucket_ *bucket = GblHashSet_bucketAt_(map, i);
     if (!bucket->dib) {
         return NULL;
@@ -347,6 +625,9 @@ GBL_EXPORT void* GblHashSet_extract(GblHashSet *map, const void* pKey)  {
 
     GBL_ASSERT(pKey);
 
+    if(GBL_HASH_SET_GROUPED_(map))
+        return GblHashSet_extractGrouped_(map, pKey);
+
     uint32_t hash = GblHashSet_getHash_(map, pKey);
     size_t i = hash & GBL_PRIV_REF(map).mask;
     for (;;) {
@@ -402,6 +683,17 @@ GBL_EXPORT GBL_RESULT GblHashSet_destruct(GblHashSet *map)  {
 GBL_EXPORT GblBool GblHashSet_foreach(const GblHashSet *map,
                   GblHashSetIterFn iter, void* udata)
 {
+    if (GBL_HASH_SET_GROUPED_(map)) {
+        for (size_t g = 0; g < GBL_PRIV_REF(map).bucketCount; g += GBL_HASH_SET_GROUP_WIDTH_) {
+            uint32_t full = ~GblHashSet_groupMatchFree_(&GBL_PRIV_REF(map).pCtrl[g]) & 0xffff;
+            for (; full; full &= full - 1) {
+                if (!iter(map, GblHashSet_slotItem_(map, g + GBL_BITMASK_CTZ(full)), udata)) {
+                    return GBL_FALSE;
+                }
+            }
+        }
+        return GBL_TRUE;
+    }
     for (size_t i = 0; i < GBL_PRIV_REF(map).bucketCount; i++) {
         struct GblHashSetBucket_ *bucket = GblHashSet_bucketAt_(map, i);
         if (bucket->dib) {
@@ -454,6 +746,10 @@ GBL_EXPORT void* GblHashSet_userdata(const GblHashSet* pSelf) {
     return GBL_PRIV_REF(pSelf).pUserdata;
 }
 
+GBL_EXPORT GBL_HASH_SET_LAYOUT GblHashSet_layout(const GblHashSet* pSelf) {
+    return GBL_PRIV_REF(pSelf).layout;
+}
+
 GBL_EXPORT GblBool GblHashSet_empty(const GblHashSet* pSelf) {
     return GBL_PRIV_REF(pSelf).count? GBL_FALSE : GBL_TRUE;
 }
@@ -482,6 +778,10 @@ GBL_EXPORT void* GblHashSet_get(const GblHashSet* pSelf, const void *pKey) {
         GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
         GBL_CTX_VERIFY_POINTER(pKey);
         GBL_CTX_END_BLOCK();
+    } else if(GBL_HASH_SET_GROUPED_(pSelf)) {
+        const size_t slot = GblHashSet_findGrouped_(pSelf, pKey, GblHashSet_getHash_(pSelf, pKey));
+        if(slot != GBL_PRIV_REF(pSelf).bucketCount)
+            pEntry = GblHashSet_slotItem_(pSelf, slot);
     } else {
         const uint32_t hash = GblHashSet_getHash_(pSelf, pKey);
         size_t i = hash & GBL_PRIV_REF(pSelf).mask;
@@ -510,6 +810,10 @@ GBL_EXPORT GblHashSetIter GblHashSet_find(const GblHashSet* map, const void* key
 
     GBL_ASSERT(key);
     uint32_t hash = GblHashSet_getHash_(map, key);
+    if (GBL_HASH_SET_GROUPED_(map)) {
+        GBL_PRIV(it).bucketIdx = GblHashSet_findGrouped_(map, key, hash);
+        return it;
+    }
     size_t i = hash & GBL_PRIV_REF(map).mask;
     for (;;) {
         struct GblHashSetBucket_ *bucket = GblHashSet_bucketAt_(map, i);
@@ -1,5 +1,40 @@
 #include <gimbal/containers/gimbal_ring_buffer.h>
-
+#include <gimbal/algorithms/gimbal_numeric.h>
+
+#include <tinycthread.h>
+#include <stdatomic.h>
+
+#define GBL_RING_BUFFER_SPIN_COUNT_     16          // failed attempts before yielding or sleeping
+#define GBL_RING_BUFFER_SYNC_ALIGN_     64          // keeps producer and consumer state on separate cache lines
+
+#define GBL_RING_BUFFER_MODE_(self)     (GBL_PRIV_REF(self).mode & ~GBL_RING_BUFFER_MODE_BLOCKING)
+#define GBL_RING_BUFFER_BLOCKING_(self) (GBL_PRIV_REF(self).mode & GBL_RING_BUFFER_MODE_BLOCKING)
+
+/* State shared between threads in the concurrent modes. head and tail are
+   free-running positions, which are masked into slot indices. In SPSC mode,
+   each side also keeps a cached copy of the other side's position on its
+   own cache line, so it only has to touch the other line once the cached
+   copy says the buffer is full or empty. In MPMC mode, each slot has a
+   sequence number which tells a producer at position p that it may write
+   the slot when it equals p, and a consumer that it may read it when it
+   equals p + 1, as in Dmitry Vyukov's bounded queue. */
+struct GblRingBufferSync_ {
+    GBL_ALIGNAS(GBL_RING_BUFFER_SYNC_ALIGN_)
+    atomic_size_t head;             // next position to pop
+    size_t        tailCache;        // SPSC consumer's last observed tail
+    GBL_ALIGNAS(GBL_RING_BUFFER_SYNC_ALIGN_)
+    atomic_size_t tail;             // next position to push
+    size_t        headCache;        // SPSC producer's last observed head
+    GBL_ALIGNAS(GBL_RING_BUFFER_SYNC_ALIGN_)
+    atomic_int    pushWaiters;      // producers sleeping on notFull
+    atomic_int    popWaiters;       // consumers sleeping on notEmpty
+    mtx_t         mtx;
+    cnd_t         notFull;
+    cnd_t         notEmpty;
+    atomic_size_t sequences[];      // MPMC only, one per slot
+};
+
+typedef GblRingBufferSync_ Sync_;
 
 GBL_INLINE size_t GblRingBuffer_mappedIndex_(const GblRingBuffer* pSelf, size_t  index) {
     return (GBL_PRIV_REF(pSelf).frontPos + index) % GBL_PRIV_REF(pSelf).capacity;
@@ -13,8 +48,264 @@ GBL_INLINE void GblRingBuffer_advance_(GblRingBuffer* pSelf) GBL_NOEXCEPT {
         ++GBL_PRIV_REF(pSelf).size;
     }
 }
+
+// copies count elements into the slots starting at index, wrapping around at most once
+static void GblRingBuffer_copyIn_(GblRingBuffer* pSelf, size_t index, const void* pData, size_t count) {
+    const size_t elementSize = GBL_PRIV_REF(pSelf).elementSize;
+    const size_t first       = GBL_MIN(count, GBL_PRIV_REF(pSelf).capacity - index);
+
+    memcpy(&GBL_PRIV_REF(pSelf).pData[index * elementSize], pData, first * elementSize);
+
+    if(count > first)
+        memcpy(GBL_PRIV_REF(pSelf).pData,
+               (const uint8_t*)pData + first * elementSize,
+               (count - first) * elementSize);
+}
+
+// copies count elements out of the slots starting at index, wrapping around at most once
+static void GblRingBuffer_copyOut_(const GblRingBuffer* pSelf, size_t index, void* pData, size_t count) {
+    if(!pData) return;
+
+    const size_t elementSize = GBL_PRIV_REF(pSelf).elementSize;
+    const size_t first       = GBL_MIN(count, GBL_PRIV_REF(pSelf).capacity - index);
+
+    memcpy(pData, &GBL_PRIV_REF(pSelf).pData[index * elementSize], first * elementSize);
+
+    if(count > first)
+        memcpy((uint8_t*)pData + first * elementSize,
+               GBL_PRIV_REF(pSelf).pData,
+               (count - first) * elementSize);
+}
+
+static void GblRingBuffer_backoff_(unsigned* pSpins) {
+    if(++*pSpins >= GBL_RING_BUFFER_SPIN_COUNT_) {
+        *pSpins = 0;
+        thrd_yield();
+    }
+}
+
+static size_t GblRingBuffer_spscPush_(GblRingBuffer* pSelf, const void* pData, size_t count) {
+    Sync_*       pSync    = GBL_PRIV_REF(pSelf).pSync;
+    const size_t capacity = GBL_PRIV_REF(pSelf).capacity;
+    const size_t tail     = atomic_load_explicit(&pSync->tail, memory_order_relaxed);
+    size_t       space    = capacity - (tail - pSync->headCache);
+
+    if(space < count) {
+        pSync->headCache = atomic_load_explicit(&pSync->head, memory_order_acquire);
+        space            = capacity - (tail - pSync->headCache);
+    }
+
+    if(count > space) count = space;
+
+    if(count) {
+        GblRingBuffer_copyIn_(pSelf, tail & (capacity - 1), pData, count);
+        atomic_store_explicit(&pSync->tail, tail + count, memory_order_release);
+    }
+
+    return count;
+}
+
+static size_t GblRingBuffer_spscPop_(GblRingBuffer* pSelf, void* pData, size_t count) {
+    Sync_*       pSync    = GBL_PRIV_REF(pSelf).pSync;
+    const size_t capacity = GBL_PRIV_REF(pSelf).capacity;
+    const size_t head     = atomic_load_explicit(&pSync->head, memory_order_relaxed);
+    size_t       ready    = pSync->tailCache - head;
+
+    if(ready < count) {
+        pSync->tailCache = atomic_load_explicit(&pSync->tail, memory_order_acquire);
+        ready            = pSync->tailCache - head;
+    }
+
+    if(count > ready) count = ready;
+
+    if(count) {
+        GblRingBuffer_copyOut_(pSelf, head & (capacity - 1), pData, count);
+        atomic_store_explicit(&pSync->head, head + count, memory_order_release);
+    }
+
+    return count;
+}
+
+/* Claims as many consecutive free slots as are available, up to count, with
+   a single CAS on tail. Nobody else can write to a slot whose sequence still
+   matches its position while tail hasn't moved past it, so the claimed span
+   can be filled in with plain copies before the slots are published. */
+static size_t GblRingBuffer_mpmcPush_(GblRingBuffer* pSelf, const void* pData, size_t count) {
+    Sync_*       pSync = GBL_PRIV_REF(pSelf).pSync;
+    const size_t mask  = GBL_PRIV_REF(pSelf).capacity - 1;
+    size_t       pos   = atomic_load_explicit(&pSync->tail, memory_order_relaxed);
+    size_t       n     = 0;
+
+    if GBL_UNLIKELY(!count) return 0;
+
+    for(;;) {
+        const size_t   seq  = atomic_load_explicit(&pSync->sequences[pos & mask], memory_order_acquire);
+        const intptr_t diff = (intptr_t)(seq - pos);
+
+        if(diff == 0) {
+            n = 1;
+            while(n < count &&
+                  atomic_load_explicit(&pSync->sequences[(pos + n) & mask], memory_order_acquire) == pos + n)
+                ++n;
+
+            if(atomic_compare_exchange_weak_explicit(&pSync->tail, &pos, pos + n,
+                                                     memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if(diff < 0) {
+            return 0;
+        } else {
+            pos = atomic_load_explicit(&pSync->tail, memory_order_relaxed);
+        }
+    }
+
+    GblRingBuffer_copyIn_(pSelf, pos & mask, pData, n);
+
+    for(size_t i = 0; i < n; ++i)
+        atomic_store_explicit(&pSync->sequences[(pos + i) & mask], pos + i + 1, memory_order_release);
+
+    return n;
+}
+
+static size_t GblRingBuffer_mpmcPop_(GblRingBuffer* pSelf, void* pData, size_t count) {
+    Sync_*       pSync = GBL_PRIV_REF(pSelf).pSync;
+    const size_t mask  = GBL_PRIV_REF(pSelf).capacity - 1;
+    size_t       pos   = atomic_load_explicit(&pSync->head, memory_order_relaxed);
+    size_t       n     = 0;
+
+    if GBL_UNLIKELY(!count) return 0;
+
+    for(;;) {
+        const size_t   seq  = atomic_load_explicit(&pSync->sequences[pos & mask], memory_order_acquire);
+        const intptr_t diff = (intptr_t)(seq - (pos + 1));
+
+        if(diff == 0) {
+            n = 1;
+            while(n < count &&
+                  atomic_load_explicit(&pSync->sequences[(pos + n) & mask], memory_order_acquire) == pos + n + 1)
+                ++n;
+
+            if(atomic_compare_exchange_weak_explicit(&pSync->head, &pos, pos + n,
+                                                     memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if(diff < 0) {
+            return 0;
+        } else {
+            pos = atomic_load_explicit(&pSync->head, memory_order_relaxed);
+        }
+    }
+
+    GblRingBuffer_copyOut_(pSelf, pos & mask, pData, n);
+
+    for(size_t i = 0; i < n; ++i)
+        atomic_store_explicit(&pSync->sequences[(pos + i) & mask], pos + i + mask + 1, memory_order_release);
+
+    return n;
+}
+
+static size_t GblRingBuffer_rawPush_(GblRingBuffer* pSelf, const void* pData, size_t count) {
+    return GBL_RING_BUFFER_MODE_(pSelf) == GBL_RING_BUFFER_MODE_SPSC?
+                GblRingBuffer_spscPush_(pSelf, pData, count) :
+                GblRingBuffer_mpmcPush_(pSelf, pData, count);
+}
+
+static size_t GblRingBuffer_rawPop_(GblRingBuffer* pSelf, void* pData, size_t count) {
+    return GBL_RING_BUFFER_MODE_(pSelf) == GBL_RING_BUFFER_MODE_SPSC?
+                GblRingBuffer_spscPop_(pSelf, pData, count) :
+                GblRingBuffer_mpmcPop_(pSelf, pData, count);
+}
+
+/* Pairs with the waiter registering itself before retrying under the mutex:
+   either the waiter's retry sees what was just published, or this sees the
+   waiter and wakes it up. */
+static void GblRingBuffer_notify_(GblRingBuffer* pSelf, atomic_int* pWaiters, cnd_t* pCnd) {
+    Sync_* pSync = GBL_PRIV_REF(pSelf).pSync;
+
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if GBL_UNLIKELY(atomic_load_explicit(pWaiters, memory_order_relaxed)) {
+        mtx_lock(&pSync->mtx);
+        cnd_broadcast(pCnd);
+        mtx_unlock(&pSync->mtx);
+    }
+}
+
+static size_t GblRingBuffer_concurrentPush_(GblRingBuffer* pSelf, const void* pData, size_t count) {
+    const size_t pushed = GblRingBuffer_rawPush_(pSelf, pData, count);
+
+    if(pushed && GBL_RING_BUFFER_BLOCKING_(pSelf))
+        GblRingBuffer_notify_(pSelf,
+                              &GBL_PRIV_REF(pSelf).pSync->popWaiters,
+                              &GBL_PRIV_REF(pSelf).pSync->notEmpty);
+
+    return pushed;
+}
+
+static size_t GblRingBuffer_concurrentPop_(GblRingBuffer* pSelf, void* pData, size_t count) {
+    const size_t popped = GblRingBuffer_rawPop_(pSelf, pData, count);
+
+    if(popped && GBL_RING_BUFFER_BLOCKING_(pSelf))
+        GblRingBuffer_notify_(pSelf,
+                              &GBL_PRIV_REF(pSelf).pSync->pushWaiters,
+                              &GBL_PRIV_REF(pSelf).pSync->notFull);
+
+    return popped;
+}
+
+// spins, then either yields or sleeps until a single element could be pushed or popped
+static void GblRingBuffer_wait_(GblRingBuffer* pSelf, void* pData, GblBool push) {
+    Sync_*      pSync    = GBL_PRIV_REF(pSelf).pSync;
+    atomic_int* pWaiters = push? &pSync->pushWaiters : &pSync->popWaiters;
+    cnd_t*      pCnd     = push? &pSync->notFull     : &pSync->notEmpty;
+    unsigned    spins    = 0;
+    unsigned    tries    = 0;
+
+    for(;;) {
+        if(push? GblRingBuffer_rawPush_(pSelf, pData, 1) : GblRingBuffer_rawPop_(pSelf, pData, 1))
+            break;
+
+        if(!GBL_RING_BUFFER_BLOCKING_(pSelf) || ++tries < GBL_RING_BUFFER_SPIN_COUNT_) {
+            GblRingBuffer_backoff_(&spins);
+            continue;
+        }
+
+        mtx_lock(&pSync->mtx);
+        atomic_fetch_add(pWaiters, 1);
+
+        const GblBool done = push? GblRingBuffer_rawPush_(pSelf, pData, 1) :
+                                   GblRingBuffer_rawPop_(pSelf, pData, 1);
+        if(!done)
+            cnd_wait(pCnd, &pSync->mtx);
+
+        atomic_fetch_sub(pWaiters, 1);
+        mtx_unlock(&pSync->mtx);
+
+        if(done) break;
+    }
+
+    if(GBL_RING_BUFFER_BLOCKING_(pSelf)) {
+        if(push) GblRingBuffer_notify_(pSelf, &pSync->popWaiters,  &pSync->notEmpty);
+        else     GblRingBuffer_notify_(pSelf, &pSync->pushWaiters, &pSync->notFull);
+    }
+}
+
+static GBL_RESULT GblRingBuffer_invalidOperation_(const GblRingBuffer* pSelf) {
+    GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
+    GBL_CTX_RECORD_SET(GBL_RESULT_ERROR_INVALID_OPERATION,
+                       "Unsupported by GblRingBuffer in its current concurrent mode");
+    GBL_CTX_END();
+}
 /// \endcond
 
+GBL_EXPORT GBL_RESULT GblRingBuffer_construct_6(GblRingBuffer* pSelf,
+                                                uint16_t       elementSize,
+                                                size_t         capacity,
+                                                size_t         initialSize,
+                                                const void*    pInitialData,
+                                                GblContext*    pCtx) GBL_NOEXCEPT
+{
+    return GblRingBuffer_construct_7(pSelf, elementSize, capacity, initialSize, pInitialData, pCtx, GBL_RING_BUFFER_MODE_DEFAULT);
+}
+
 GBL_EXPORT GBL_RESULT GblRingBuffer_construct_5(GblRingBuffer* pSelf,
                                                 uint16_t    elementSize,
                                                 size_t      capacity,
@@ -48,13 +339,26 @@ GBL_EXPORT size_t  GblRingBuffer_capacity(const GblRingBuffer* pSelf) GBL_NOEXCE
 }
 
 GBL_EXPORT size_t  GblRingBuffer_size(const GblRingBuffer* pSelf) GBL_NOEXCEPT {
-    return GBL_PRIV_REF(pSelf).size;
+    const Sync_* pSync = GBL_PRIV_REF(pSelf).pSync;
+
+    if(!pSync)
+        return GBL_PRIV_REF(pSelf).size;
+
+    // head first, so that tail can't be observed behind it
+    const size_t head = atomic_load_explicit(&pSync->head, memory_order_acquire);
+    const size_t tail = atomic_load_explicit(&pSync->tail, memory_order_acquire);
+
+    return GBL_MIN(tail - head, GBL_PRIV_REF(pSelf).capacity);
 }
 
 GBL_EXPORT size_t  GblRingBuffer_elementSize(const GblRingBuffer* pSelf) GBL_NOEXCEPT {
     return GBL_PRIV_REF(pSelf).elementSize;
 }
 
+GBL_EXPORT GBL_RING_BUFFER_MODE GblRingBuffer_mode(const GblRingBuffer* pSelf) GBL_NOEXCEPT {
+    return (GBL_RING_BUFFER_MODE)GBL_PRIV_REF(pSelf).mode;
+}
+
 GBL_EXPORT GblBool GblRingBuffer_empty(const GblRingBuffer* pSelf) GBL_NOEXCEPT {
     return GblRingBuffer_size(pSelf) == 0? GBL_TRUE : GBL_FALSE;
 }
@@ -67,10 +371,16 @@ GBL_EXPORT void* GblRingBuffer_at(const GblRingBuffer* pSelf, size_t  index) GBL
     const size_t  size = GblRingBuffer_size(pSelf);
     void* pData = GBL_NULL;
 
-    if GBL_UNLIKELY(index >= size) {
+    if GBL_UNLIKELY(GBL_RING_BUFFER_MODE_(pSelf) == GBL_RING_BUFFER_MODE_MPMC) {
+        GblRingBuffer_invalidOperation_(pSelf);
+    } else if GBL_UNLIKELY(index >= size) {
         GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
         GBL_CTX_RECORD_SET(GBL_RESULT_ERROR_OUT_OF_RANGE);
         GBL_CTX_END_BLOCK();
+    } else if(GBL_PRIV_REF(pSelf).pSync) {
+        const size_t head = atomic_load_explicit(&GBL_PRIV_REF(pSelf).pSync->head, memory_order_relaxed);
+        pData = &GBL_PRIV_REF(pSelf).pData[((head + index) & (GBL_PRIV_REF(pSelf).capacity - 1)) *
+                                           GBL_PRIV_REF(pSelf).elementSize];
     } else {
         pData = &GBL_PRIV_REF(pSelf).pData[GblRingBuffer_mappedIndex_(pSelf, index) *
                                            GBL_PRIV_REF(pSelf).elementSize];
@@ -84,17 +394,34 @@ GBL_EXPORT void* GblRingBuffer_front(const GblRingBuffer* pSelf) GBL_NOEXCEPT {
 }
 
 GBL_EXPORT void* GblRingBuffer_back(const GblRingBuffer* pSelf) GBL_NOEXCEPT {
-    return GblRingBuffer_at(pSelf, GBL_PRIV_REF(pSelf).size-1);
+    return GblRingBuffer_at(pSelf, GblRingBuffer_size(pSelf)-1);
 }
 
 
 GBL_EXPORT void* GblRingBuffer_emplaceBack(GblRingBuffer* pSelf) GBL_NOEXCEPT {
+    if GBL_UNLIKELY(GBL_PRIV_REF(pSelf).pSync) {
+        GblRingBuffer_invalidOperation_(pSelf);
+        return GBL_NULL;
+    }
+
     GblRingBuffer_advance_(pSelf);
     return GblRingBuffer_back(pSelf);
 }
 
 GBL_EXPORT GBL_RESULT GblRingBuffer_pushBack(GblRingBuffer* pSelf, const void* pData) GBL_NOEXCEPT {
     GBL_RESULT result = GBL_RESULT_SUCCESS;
+
+    if(GBL_PRIV_REF(pSelf).pSync) {
+        if GBL_UNLIKELY(!GblRingBuffer_concurrentPush_(pSelf, pData, 1)) {
+            GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
+            GBL_CTX_RECORD_SET(GBL_RESULT_ERROR_OVERFLOW);
+            GBL_CTX_END_BLOCK();
+            result = GBL_RESULT_ERROR_OVERFLOW;
+        }
+
+        return result;
+    }
+
     void* pBuffer = GblRingBuffer_emplaceBack(pSelf);
 
     if GBL_LIKELY(pBuffer)
@@ -106,6 +433,11 @@ GBL_EXPORT GBL_RESULT GblRingBuffer_pushBack(GblRingBuffer* pSelf, const void* p
 }
 
 GBL_EXPORT void* GblRingBuffer_popFront(GblRingBuffer* pSelf) GBL_NOEXCEPT {
+    if GBL_UNLIKELY(GBL_PRIV_REF(pSelf).pSync) {
+        GblRingBuffer_invalidOperation_(pSelf);
+        return GBL_NULL;
+    }
+
     void* pFront = GblRingBuffer_front(pSelf);
     if(pFront) {
         --GBL_PRIV_REF(pSelf).size;
@@ -121,32 +453,164 @@ GBL_EXPORT void* GblRingBuffer_popFront(GblRingBuffer* pSelf) GBL_NOEXCEPT {
 }
 
 GBL_EXPORT void GblRingBuffer_clear(GblRingBuffer* pSelf) GBL_NOEXCEPT {
+    if(GBL_PRIV_REF(pSelf).pSync) {
+        while(GblRingBuffer_concurrentPop_(pSelf, GBL_NULL, GBL_PRIV_REF(pSelf).capacity));
+        return;
+    }
+
     GBL_PRIV_REF(pSelf).frontPos = 0;
     GBL_PRIV_REF(pSelf).size     = 0;
 }
 
-GBL_EXPORT GBL_RESULT GblRingBuffer_construct_6(GblRingBuffer* pSelf,
-                                                uint16_t       elementSize,
-                                                size_t         capacity,
-                                                size_t         initialSize,
-                                                const void*    pInitialData,
-                                                GblContext*    pCtx)
+GBL_EXPORT GblBool GblRingBuffer_tryPushBack(GblRingBuffer* pSelf, const void* pData) GBL_NOEXCEPT {
+    if(!GBL_PRIV_REF(pSelf).pSync && GblRingBuffer_full(pSelf))
+        return GBL_FALSE;
+
+    return GblRingBuffer_pushBackN(pSelf, pData, 1) == 1;
+}
+
+GBL_EXPORT GblBool GblRingBuffer_tryPopFront(GblRingBuffer* pSelf, void* pData) GBL_NOEXCEPT {
+    return GblRingBuffer_popFrontN(pSelf, pData, 1) == 1;
+}
+
+GBL_EXPORT size_t GblRingBuffer_pushBackN(GblRingBuffer* pSelf, const void* pData, size_t count) GBL_NOEXCEPT {
+    const size_t capacity = GBL_PRIV_REF(pSelf).capacity;
+
+    if(GBL_PRIV_REF(pSelf).pSync)
+        return GblRingBuffer_concurrentPush_(pSelf, pData, count);
+
+    if GBL_UNLIKELY(!capacity || !count)
+        return 0;
+
+    const size_t pushed = count;
+
+    // only the last capacity values would survive anyway
+    if(count >= capacity) {
+        pData = (const uint8_t*)pData + (count - capacity) * GBL_PRIV_REF(pSelf).elementSize;
+        count = capacity;
+        GBL_PRIV_REF(pSelf).frontPos = 0;
+        GBL_PRIV_REF(pSelf).size     = 0;
+    }
+
+    GblRingBuffer_copyIn_(pSelf,
+                          (GBL_PRIV_REF(pSelf).frontPos + GBL_PRIV_REF(pSelf).size) % capacity,
+                          pData,
+                          count);
+
+    GBL_PRIV_REF(pSelf).size += count;
+
+    if(GBL_PRIV_REF(pSelf).size > capacity) {
+        GBL_PRIV_REF(pSelf).frontPos = (GBL_PRIV_REF(pSelf).frontPos +
+                                        GBL_PRIV_REF(pSelf).size - capacity) % capacity;
+        GBL_PRIV_REF(pSelf).size     = capacity;
+    }
+
+    return pushed;
+}
+
+GBL_EXPORT size_t GblRingBuffer_popFrontN(GblRingBuffer* pSelf, void* pData, size_t count) GBL_NOEXCEPT {
+    if(GBL_PRIV_REF(pSelf).pSync)
+        return GblRingBuffer_concurrentPop_(pSelf, pData, count);
+
+    if(count > GBL_PRIV_REF(pSelf).size)
+        count = GBL_PRIV_REF(pSelf).size;
+
+    if(count) {
+        GblRingBuffer_copyOut_(pSelf, GBL_PRIV_REF(pSelf).frontPos, pData, count);
+
+        GBL_PRIV_REF(pSelf).frontPos = (GBL_PRIV_REF(pSelf).frontPos + count) %
+                                       GBL_PRIV_REF(pSelf).capacity;
+        GBL_PRIV_REF(pSelf).size    -= count;
+    }
+
+    return count;
+}
+
+GBL_EXPORT GBL_RESULT GblRingBuffer_waitPushBack(GblRingBuffer* pSelf, const void* pData) GBL_NOEXCEPT {
+    if(!GBL_PRIV_REF(pSelf).pSync)
+        return GblRingBuffer_pushBack(pSelf, pData);
+
+    GblRingBuffer_wait_(pSelf, (void*)pData, GBL_TRUE);
+    return GBL_RESULT_SUCCESS;
+}
+
+GBL_EXPORT GBL_RESULT GblRingBuffer_waitPopFront(GblRingBuffer* pSelf, void* pData) GBL_NOEXCEPT {
+    GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
+
+    if(GBL_PRIV_REF(pSelf).pSync)
+        GblRingBuffer_wait_(pSelf, pData, GBL_FALSE);
+    else // nothing else could ever fill it up
+        GBL_CTX_VERIFY(GblRingBuffer_popFrontN(pSelf, pData, 1),
+                       GBL_RESULT_ERROR_OUT_OF_RANGE);
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblRingBuffer_construct_7(GblRingBuffer*       pSelf,
+                                                uint16_t             elementSize,
+                                                size_t               capacity,
+                                                size_t               initialSize,
+                                                const void*          pInitialData,
+                                                GblContext*          pCtx,
+                                                GBL_RING_BUFFER_MODE mode)
 {
     GBL_CTX_BEGIN(pCtx);
     GBL_CTX_VERIFY_POINTER(pSelf);
     GBL_CTX_VERIFY_ARG(elementSize > 0);
     //GBL_CTX_VERIFY_ARG(capacity > 0);
 
+    const GBL_RING_BUFFER_MODE threading = (GBL_RING_BUFFER_MODE)(mode & ~GBL_RING_BUFFER_MODE_BLOCKING);
+
+    GBL_CTX_VERIFY_ARG(threading <= GBL_RING_BUFFER_MODE_MPMC);
+    GBL_CTX_VERIFY_ARG(threading != GBL_RING_BUFFER_MODE_DEFAULT ||
+                       !(mode & GBL_RING_BUFFER_MODE_BLOCKING));
+
     memset(pSelf, 0, sizeof(GblRingBuffer));
 
+    // slots are found by masking free-running positions
+    if(threading != GBL_RING_BUFFER_MODE_DEFAULT)
+        capacity = gblPow2Next_u64(GBL_MAX(capacity, 2));
+
     GBL_PRIV_REF(pSelf).pCtx        = pCtx;
     GBL_PRIV_REF(pSelf).elementSize = elementSize;
     GBL_PRIV_REF(pSelf).capacity    = capacity;
+    GBL_PRIV_REF(pSelf).mode        = mode;
 
     if(capacity)
         GBL_PRIV_REF(pSelf).pData       = GBL_CTX_MALLOC(capacity * elementSize, 0, "GblRingBuffer");
 
-    for(size_t  i = 0; i < initialSize; ++i) {
+    if(threading != GBL_RING_BUFFER_MODE_DEFAULT) {
+        size_t syncSize = sizeof(Sync_);
+
+        if(threading == GBL_RING_BUFFER_MODE_MPMC)
+            syncSize += capacity * sizeof(atomic_size_t);
+
+        syncSize = (syncSize + GBL_RING_BUFFER_SYNC_ALIGN_ - 1) & ~(size_t)(GBL_RING_BUFFER_SYNC_ALIGN_ - 1);
+
+        Sync_* pSync = GBL_CTX_MALLOC(syncSize, GBL_RING_BUFFER_SYNC_ALIGN_, "GblRingBufferSync");
+
+        atomic_init(&pSync->head, 0);
+        atomic_init(&pSync->tail, 0);
+        atomic_init(&pSync->pushWaiters, 0);
+        atomic_init(&pSync->popWaiters, 0);
+        pSync->tailCache = 0;
+        pSync->headCache = 0;
+
+        if(threading == GBL_RING_BUFFER_MODE_MPMC)
+            for(size_t s = 0; s < capacity; ++s)
+                atomic_init(&pSync->sequences[s], s);
+
+        if(mode & GBL_RING_BUFFER_MODE_BLOCKING) {
+            mtx_init(&pSync->mtx, mtx_plain);
+            cnd_init(&pSync->notFull);
+            cnd_init(&pSync->notEmpty);
+        }
+
+        GBL_PRIV_REF(pSelf).pSync = pSync;
+
+        GBL_CTX_VERIFY(GblRingBuffer_pushBackN(pSelf, pInitialData, initialSize) == initialSize,
+                       GBL_RESULT_ERROR_OVERFLOW);
+    } else for(size_t  i = 0; i < initialSize; ++i) {
         GBL_CTX_VERIFY_CALL(GblRingBuffer_pushBack(pSelf, (void*)((uintptr_t)pInitialData + (elementSize * i))));
     }
     GBL_CTX_END();
@@ -155,6 +619,19 @@ GBL_EXPORT GBL_RESULT GblRingBuffer_construct_6(GblRingBuffer* pSelf,
 
 GBL_EXPORT GBL_RESULT GblRingBuffer_destruct(GblRingBuffer* pSelf) {
     GBL_CTX_BEGIN(GBL_PRIV_REF(pSelf).pCtx);
+    Sync_* pSync = GBL_PRIV_REF(pSelf).pSync;
+
+    if(pSync) {
+        if(GBL_RING_BUFFER_BLOCKING_(pSelf)) {
+            cnd_destroy(&pSync->notEmpty);
+            cnd_destroy(&pSync->notFull);
+            mtx_destroy(&pSync->mtx);
+        }
+
+        GBL_CTX_FREE(pSync);
+        GBL_PRIV_REF(pSelf).pSync = NULL;
+    }
+
     GblRingBuffer_clear(pSelf);
     GBL_CTX_FREE(GBL_PRIV_REF(pSelf).pData);
     GBL_PRIV_REF(pSelf).pData = NULL;
@@ -167,18 +644,35 @@ GBL_EXPORT GBL_RESULT GblRingBuffer_copy(GblRingBuffer* pSelf,
     GBL_CTX_BEGIN(GBL_PRIV_REF(pOther).pCtx);
     GBL_CTX_VERIFY_CALL(GblRingBuffer_destruct(pSelf));
 
-    GBL_CTX_VERIFY_CALL(GblRingBuffer_construct_6(pSelf,
+    GBL_CTX_VERIFY_CALL(GblRingBuffer_construct_7(pSelf,
                                                   GBL_PRIV_REF(pOther).elementSize,
                                                   GBL_PRIV_REF(pOther).capacity,
                                                   0,
                                                   NULL,
-                                                  GBL_PRIV_REF(pOther).pCtx));
+                                                  GBL_PRIV_REF(pOther).pCtx,
+                                                  GblRingBuffer_mode(pOther)));
 
     memcpy(GBL_PRIV_REF(pSelf).pData,
            GBL_PRIV_REF(pOther).pData,
            GBL_PRIV_REF(pSelf).elementSize * GBL_PRIV_REF(pSelf).capacity);
 
-    GBL_PRIV_REF(pSelf).size = GBL_PRIV_REF(pOther).size;
+    GBL_PRIV_REF(pSelf).size     = GBL_PRIV_REF(pOther).size;
+    GBL_PRIV_REF(pSelf).frontPos = GBL_PRIV_REF(pOther).frontPos;
+
+    // only valid while pOther isn't being modified by another thread
+    if(GBL_PRIV_REF(pOther).pSync) {
+        Sync_*       pSync  = GBL_PRIV_REF(pSelf).pSync;
+        const Sync_* pOSync = GBL_PRIV_REF(pOther).pSync;
+
+        atomic_store(&pSync->head, atomic_load(&pOSync->head));
+        atomic_store(&pSync->tail, atomic_load(&pOSync->tail));
+        pSync->tailCache = pOSync->tailCache;
+        pSync->headCache = pOSync->headCache;
+
+        if(GBL_RING_BUFFER_MODE_(pSelf) == GBL_RING_BUFFER_MODE_MPMC)
+            for(size_t s = 0; s < GBL_PRIV_REF(pSelf).capacity; ++s)
+                atomic_store(&pSync->sequences[s], atomic_load(&pOSync->sequences[s]));
+    }
 
     GBL_CTX_END();
 }
@@ -191,6 +685,7 @@ GBL_EXPORT GBL_RESULT GblRingBuffer_move(GblRingBuffer* pSelf,
 
     memcpy(pSelf, pOther, sizeof(GblRingBuffer));
     GBL_PRIV_REF(pOther).pData = NULL;
+    GBL_PRIV_REF(pOther).pSync = NULL;
     GBL_PRIV_REF(pOther).size = 0;
     GBL_PRIV_REF(pOther).capacity = 0;
 
@@ -48,8 +48,11 @@ static GblTreeSetNode *node_new_(GblTreeSet* pSelf, GblBool leaf) {
     GblTreeSetNode* pNode = NULL;
     GBL_CTX_BEGIN(pSelf->pCtx);
     size_t  size = sizeof(GblTreeSetNode);
+    size_t  countOffset = 0;
     if (!leaf) {
         size += sizeof(GblTreeSetNode*) * pSelf->maxCount;
+        countOffset = size;
+        size += sizeof(size_t) * (pSelf->maxCount+1);
     }
     size_t  entryOffset = size;
     size += pSelf->entrySize * (pSelf->maxCount-1);
@@ -57,6 +60,7 @@ static GblTreeSetNode *node_new_(GblTreeSet* pSelf, GblBool leaf) {
     pNode->leaf = leaf;
     pNode->entryCount = 0;
     pNode->pEntries = (uint8_t*)pNode + entryOffset;
+    pNode->pCounts = leaf? NULL : (size_t*)((uint8_t*)pNode + countOffset);
     GBL_CTX_END_BLOCK();
     return pNode;
 }
@@ -166,6 +170,17 @@ GBL_INLINE void swap_item_at_(GblTreeSetNode* pNode, size_t  entrySize, size_t
     memcpy(pPtr, pEntry, entrySize);
 }
 
+// total # of entries within the subtree rooted at the given node
+static size_t node_count_(const GblTreeSetNode* pNode) {
+    size_t count = pNode->entryCount;
+    if(!pNode->leaf) {
+        for(uint16_t c = 0; c <= pNode->entryCount; ++c) {
+            count += pNode->pCounts[c];
+        }
+    }
+    return count;
+}
+
 static int node_find_(const GblTreeSet* pSelf, GblTreeSetNode* pNode, const void* pKey,
                      GblBool* pFound, uint64_t* pHint, int depth)
 {
@@ -242,6 +257,7 @@ static void node_split_(GblTreeSet* pSelf, GblTreeSetNode* pNode,
     if(!pNode->leaf) {
         for(int e = 0; e <= (*ppRight)->entryCount; ++e) {
             (*ppRight)->pChildren[e] = pNode->pChildren[mid+1+e];
+            (*ppRight)->pCounts[e]   = pNode->pCounts[mid+1+e];
         }
     }
     pNode->entryCount = (uint16_t)mid;
@@ -255,6 +271,9 @@ static void node_join_(GblTreeSetNode* pLeft, GblTreeSetNode* pRight, size_t  en
         memcpy(&pLeft->pChildren[pLeft->entryCount],
                &pRight->pChildren[0],
                (size_t)(pRight->entryCount+1)*sizeof(GblTreeSetNode*));
+        memcpy(&pLeft->pCounts[pLeft->entryCount],
+               &pRight->pCounts[0],
+               (size_t)(pRight->entryCount+1)*sizeof(size_t));
     }
     pLeft->entryCount += pRight->entryCount;
 }
@@ -269,6 +288,9 @@ GBL_INLINE void node_shift_right_(GblTreeSetNode* pNode, size_t  entrySize, size
         memmove(&pNode->pChildren[index+1],
                 &pNode->pChildren[index],
                 ((size_t)pNode->entryCount - index+1)*sizeof(GblTreeSetNode*));
+        memmove(&pNode->pCounts[index+1],
+                &pNode->pCounts[index],
+                ((size_t)pNode->entryCount - index+1)*sizeof(size_t));
     }
     ++pNode->entryCount;
 }
@@ -286,6 +308,9 @@ GBL_INLINE void node_shift_left_(GblTreeSetNode* pNode, size_t  entrySize, size_
         memmove(&pNode->pChildren[index],
                 &pNode->pChildren[index+1],
                 ((size_t)pNode->entryCount-index+1)*sizeof(GblTreeSetNode*));
+        memmove(&pNode->pCounts[index],
+                &pNode->pCounts[index+1],
+                ((size_t)pNode->entryCount-index+1)*sizeof(size_t));
     }
     --pNode->entryCount;
 }
@@ -307,13 +332,17 @@ GBL_INLINE GblBool node_set_(GblTreeSet* pSelf, GblTreeSetNode* pNode, const voi
     else if(node_set_(pSelf, pNode->pChildren[i], pEntry, leanLeft, pHint, depth+1)) {
         return GBL_TRUE;
     }
-    else if((size_t )pNode->pChildren[i]->entryCount == (pSelf->maxCount-1)) {
+    ++pNode->pCounts[i];
+    if((size_t )pNode->pChildren[i]->entryCount == (pSelf->maxCount-1)) {
         void*           pMedian = NULL;
         GblTreeSetNode* pRight  = NULL;
+        const size_t    total   = pNode->pCounts[i];
         node_split_(pSelf, pNode->pChildren[i], &pRight, &pMedian, leanLeft);
         node_shift_right_(pNode, pSelf->entrySize, (size_t )i);
         set_item_at_(pNode, pSelf->entrySize, (size_t )i, pMedian);
         pNode->pChildren[i+1] = pRight;
+        pNode->pCounts[i+1]   = node_count_(pRight);
+        pNode->pCounts[i]     = total - pNode->pCounts[i+1] - 1;
     }
     return GBL_FALSE;
 }
@@ -350,6 +379,8 @@ static void* btree_set_x_(GblTreeSet* pSelf, const void* pEntry, GblBool leanLef
             pSelf->pRoot->pChildren[0] = pOldRoot;
             set_item_at_(pSelf->pRoot, pSelf->entrySize, 0, pMedian);
             pSelf->pRoot->pChildren[1] = pRight;
+            pSelf->pRoot->pCounts[1] = node_count_(pRight);
+            pSelf->pRoot->pCounts[0] = pSelf->count - pSelf->pRoot->pCounts[1] - 1;
             pSelf->pRoot->entryCount = 1;
             ++pSelf->height;
         }
@@ -478,6 +509,7 @@ GBL_EXPORT void GblTreeSet_clear(GblTreeSet* pSelf) GBL_NOEXCEPT {
     GBL_CTX_CALL(release_pool_(pSelf));
     pSelf->pRoot = NULL;
     pSelf->count = 0;
+    pSelf->height = 0;
     reset_load_fields_(pSelf);
     GBL_CTX_END_BLOCK();
 }
@@ -613,6 +645,8 @@ static GblBool node_delete_(GblTreeSet* pSelf, GblTreeSetNode* pNode, enum delac
         return GBL_FALSE;
     }
 
+    --pNode->pCounts[i];
+
     if ((size_t )pNode->pChildren[i]->entryCount >= pSelf->minCount) {
         return GBL_TRUE;
     }
@@ -626,6 +660,7 @@ static GblBool node_delete_(GblTreeSet* pSelf, GblTreeSetNode* pNode, enum delac
 
     if((size_t )(pLeft->entryCount + pRight->entryCount + 1) < (pSelf->maxCount - 1)) {
         // merge left + item + right
+        pNode->pCounts[i] += pNode->pCounts[i+1] + 1;
         copy_item_(pLeft, pSelf->entrySize, (size_t )pLeft->entryCount, pNode, (size_t )i);
         ++pLeft->entryCount;
         node_join_(pLeft, pRight, pSelf->entrySize);
@@ -633,11 +668,15 @@ static GblBool node_delete_(GblTreeSet* pSelf, GblTreeSetNode* pNode, enum delac
         node_shift_left_(pNode, pSelf->entrySize, (size_t )i, GBL_TRUE);
     } else if (pLeft->entryCount > pRight->entryCount) {
         // move left -> right
+        const size_t moved = 1 + (pLeft->leaf? 0 : pLeft->pCounts[pLeft->entryCount]);
         node_shift_right_(pRight, pSelf->entrySize, 0);
         copy_item_(pRight, pSelf->entrySize, 0, pNode, (size_t )i);
         if(!pLeft->leaf) {
             pRight->pChildren[0] = pLeft->pChildren[pLeft->entryCount];
+            pRight->pCounts[0]   = moved - 1;
         }
+        pNode->pCounts[i]   -= moved;
+        pNode->pCounts[i+1] += moved;
         copy_item_(pNode, pSelf->entrySize, (size_t )i, pLeft, (size_t )(pLeft->entryCount - 1));
         if (!pLeft->leaf) {
             pLeft->pChildren[pLeft->entryCount] = NULL;
@@ -645,10 +684,14 @@ static GblBool node_delete_(GblTreeSet* pSelf, GblTreeSetNode* pNode, enum delac
         --pLeft->entryCount;
     } else {
         // move right -> left
+        const size_t moved = 1 + (pRight->leaf? 0 : pRight->pCounts[0]);
         copy_item_(pLeft, pSelf->entrySize, (size_t )pLeft->entryCount, pNode, (size_t )i);
         if (!pLeft->leaf) {
             pLeft->pChildren[pLeft->entryCount+1] = pRight->pChildren[0];
+            pLeft->pCounts[pLeft->entryCount+1]   = moved - 1;
         }
+        pNode->pCounts[i]   += moved;
+        pNode->pCounts[i+1] -= moved;
         ++pLeft->entryCount;
         copy_item_(pNode, pSelf->entrySize, (size_t )i, pRight, 0);
         node_shift_left_(pRight, pSelf->entrySize, 0, GBL_FALSE);
@@ -727,3 +770,481 @@ GBL_EXPORT void* GblTreeSet_userdata(const GblTreeSet* pSelf) {
     return pSelf->pUserdata;
 }
 
+// Builds the tree bottom-up from entries which are already sorted, packing
+// each level with as many nodes as possible, splitting the entries evenly
+// between them, and promoting the entries between nodes as the next level's
+// separators. Nodes are filled to one entry below the split threshold.
+static GBL_RESULT load_(GblTreeSet* pSelf, const void* pEntries, size_t count) {
+    const size_t     entrySize = pSelf->entrySize;
+    const size_t     cap       = pSelf->maxCount - 2;
+    size_t           nodeCount = (count + cap + 1) / (cap + 1);
+    GblTreeSetNode** ppNodes   = NULL;
+    size_t*          pCounts   = NULL;
+    const uint8_t**  ppSeps    = NULL;
+    const uint8_t*   pSrc      = pEntries;
+    size_t           built     = 0;     // nodes of the level being built, at the front of ppNodes
+    size_t           children  = 0;     // nodes of the level below it
+    size_t           c         = 0;     // first of those not yet given a parent
+
+    GBL_CTX_BEGIN(pSelf->pCtx);
+
+    ppNodes = GBL_CTX_MALLOC(sizeof(GblTreeSetNode*) * nodeCount);
+    pCounts = GBL_CTX_MALLOC(sizeof(size_t) * nodeCount);
+    ppSeps  = GBL_CTX_MALLOC(sizeof(uint8_t*) * nodeCount);
+    GBL_CTX_VERIFY(ppNodes && pCounts && ppSeps, GBL_RESULT_ERROR_MEM_ALLOC);
+
+    // leaves, which all get count - (nodeCount - 1) entries between them
+    const size_t leafEntries = count - (nodeCount - 1);
+
+    for(size_t n = 0; n < nodeCount; ++n) {
+        const size_t    entries = leafEntries / nodeCount + (n < leafEntries % nodeCount);
+        GblTreeSetNode* pLeaf   = node_new_(pSelf, GBL_TRUE);
+        GBL_CTX_VERIFY(pLeaf, GBL_RESULT_ERROR_MEM_ALLOC);
+
+        memcpy(pLeaf->pEntries, pSrc, entries * entrySize);
+        pLeaf->entryCount = (uint16_t)entries;
+        pSrc += entries * entrySize;
+
+        ppNodes[built++] = pLeaf;
+        pCounts[n]       = entries;
+
+        if(n + 1 < nodeCount) {
+            ppSeps[n] = pSrc;
+            pSrc += entrySize;
+        }
+    }
+
+    pSelf->height = 1;
+
+    // branches, built in place over the previous level's arrays
+    while(nodeCount > 1) {
+        children = nodeCount;
+        built    = 0;
+        c        = 0;
+
+        nodeCount = (children + cap) / (cap + 1);
+
+        for(size_t n = 0; n < nodeCount; ++n) {
+            const size_t    childCount = children / nodeCount + (n < children % nodeCount);
+            GblTreeSetNode* pBranch    = node_new_(pSelf, GBL_FALSE);
+            size_t          total      = 0;
+            GBL_CTX_VERIFY(pBranch, GBL_RESULT_ERROR_MEM_ALLOC);
+
+            for(size_t j = 0; j < childCount; ++j, ++c) {
+                pBranch->pChildren[j] = ppNodes[c];
+                pBranch->pCounts[j]   = pCounts[c];
+                total += pCounts[c];
+
+                if(j + 1 < childCount) {
+                    set_item_at_(pBranch, entrySize, j, ppSeps[c]);
+                    ++total;
+                }
+            }
+
+            pBranch->entryCount = (uint16_t)(childCount - 1);
+
+            if(n + 1 < nodeCount)
+                ppSeps[n] = ppSeps[c - 1];
+
+            ppNodes[built++] = pBranch;
+            pCounts[n]       = total;
+        }
+
+        ++pSelf->height;
+    }
+
+    pSelf->pRoot = ppNodes[0];
+    pSelf->count = count;
+
+    GBL_CTX_END_BLOCK();
+
+    // Drops whatever was built without destructing it, leaving the entries with the caller
+    if(GBL_RESULT_ERROR(GBL_CTX_RESULT()) && ppNodes) {
+        GblTreeSetDestructFn pFnDestruct = pSelf->pFnDestruct;
+        pSelf->pFnDestruct = NULL;
+
+        for(size_t n = 0; n < built; ++n)
+            node_free_(pSelf, ppNodes[n]);
+
+        for(; c < children; ++c)
+            node_free_(pSelf, ppNodes[c]);
+
+        pSelf->pFnDestruct = pFnDestruct;
+        pSelf->height      = 0;
+    }
+
+    if(ppSeps)  GBL_CTX_FREE(ppSeps);
+    if(pCounts) GBL_CTX_FREE(pCounts);
+    if(ppNodes) GBL_CTX_FREE(ppNodes);
+
+    return GBL_CTX_RESULT();
+}
+
+GBL_EXPORT GBL_RESULT GblTreeSet_load(GblTreeSet* pSelf, const void* pEntries, size_t count) GBL_NOEXCEPT {
+    GBL_CTX_BEGIN(pSelf->pCtx);
+    GBL_CTX_VERIFY_ARG(pEntries || !count);
+
+    for(size_t e = 1; e < count; ++e) {
+        GBL_CTX_VERIFY(pSelf->pFnCompare(pSelf,
+                                         (const uint8_t*)pEntries + (e-1)*pSelf->entrySize,
+                                         (const uint8_t*)pEntries + e*pSelf->entrySize) < 0,
+                       GBL_RESULT_ERROR_INVALID_ARG,
+                       "[GblTreeSet]: Loaded entries must be in strictly ascending order!");
+    }
+
+    GblTreeSet_clear(pSelf);
+
+    if(count) {
+        GBL_CTX_VERIFY_CALL(load_(pSelf, pEntries, count));
+    }
+
+    GBL_CTX_END();
+}
+
+// # of entries less than (or equal to, when inclusive) the given key
+static size_t rank_(const GblTreeSet* pSelf, const void* pKey, GblBool inclusive) {
+    size_t          rank  = 0;
+    GblTreeSetNode* pNode = pSelf->pRoot;
+
+    while(pNode) {
+        GblBool   found = GBL_FALSE;
+        const int i     = node_find_(pSelf, pNode, pKey, &found, NULL, 0);
+
+        rank += (size_t)i;
+
+        if(!pNode->leaf) {
+            for(int c = 0; c < i; ++c) {
+                rank += pNode->pCounts[c];
+            }
+        }
+
+        if(found) {
+            if(!pNode->leaf) {
+                rank += pNode->pCounts[i];
+            }
+            return inclusive? rank + 1 : rank;
+        }
+
+        pNode = pNode->leaf? NULL : pNode->pChildren[i];
+    }
+
+    return rank;
+}
+
+static void* select_(const GblTreeSet* pSelf, size_t index) {
+    GblTreeSetNode* pNode = pSelf->pRoot;
+
+    while(!pNode->leaf) {
+        uint16_t c = 0;
+
+        for(;; ++c) {
+            if(index < pNode->pCounts[c]) {
+                break;
+            }
+            index -= pNode->pCounts[c];
+            if(!index) {
+                return get_item_at_(pNode, pSelf->entrySize, c);
+            }
+            --index;
+        }
+
+        pNode = pNode->pChildren[c];
+    }
+
+    return get_item_at_(pNode, pSelf->entrySize, index);
+}
+
+GBL_EXPORT size_t GblTreeSet_rank(const GblTreeSet* pSelf, const void* pKey) GBL_NOEXCEPT {
+    size_t rank = 0;
+    GBL_CTX_BEGIN(pSelf->pCtx);
+    GBL_CTX_VERIFY_POINTER(pKey);
+    rank = rank_(pSelf, pKey, GBL_FALSE);
+    GBL_CTX_END_BLOCK();
+    return rank;
+}
+
+GBL_EXPORT size_t GblTreeSet_countRange(const GblTreeSet* pSelf, const void* pLower, const void* pUpper) GBL_NOEXCEPT {
+    const size_t first = pLower? rank_(pSelf, pLower, GBL_FALSE) : 0;
+    const size_t last  = pUpper? rank_(pSelf, pUpper, GBL_TRUE)  : pSelf->count;
+    return last > first? last - first : 0;
+}
+
+GBL_EXPORT void* GblTreeSet_select(const GblTreeSet* pSelf, size_t index) GBL_NOEXCEPT {
+    void* pEntry = NULL;
+    GBL_CTX_BEGIN(pSelf->pCtx);
+    GBL_CTX_VERIFY(index < pSelf->count,
+                   GBL_RESULT_ERROR_OUT_OF_RANGE);
+    pEntry = select_(pSelf, index);
+    GBL_CTX_END_BLOCK();
+    return pEntry;
+}
+
+GBL_EXPORT void* GblTreeSet_min(const GblTreeSet* pSelf) GBL_NOEXCEPT {
+    GblTreeSetNode* pNode = pSelf->pRoot;
+    if(!pNode) {
+        return NULL;
+    }
+    while(!pNode->leaf) {
+        pNode = pNode->pChildren[0];
+    }
+    return get_item_at_(pNode, pSelf->entrySize, 0);
+}
+
+GBL_EXPORT void* GblTreeSet_max(const GblTreeSet* pSelf) GBL_NOEXCEPT {
+    GblTreeSetNode* pNode = pSelf->pRoot;
+    if(!pNode) {
+        return NULL;
+    }
+    while(!pNode->leaf) {
+        pNode = pNode->pChildren[pNode->entryCount];
+    }
+    return get_item_at_(pNode, pSelf->entrySize, (size_t)pNode->entryCount-1);
+}
+
+GBL_EXPORT void* GblTreeSet_popMin(GblTreeSet* pSelf) GBL_NOEXCEPT {
+    return delete_x_(pSelf, POPFRONT, 0, NULL, NULL);
+}
+
+GBL_EXPORT void* GblTreeSet_popMax(GblTreeSet* pSelf) GBL_NOEXCEPT {
+    return delete_x_(pSelf, POPBACK, 0, NULL, NULL);
+}
+
+// pushes the path down to the leftmost leaf of the given subtree
+static void cursor_descend_(GblTreeSetCursor* pCursor, GblTreeSetNode* pNode) {
+    for(;;) {
+        GBL_PRIV_REF(pCursor).stack[GBL_PRIV_REF(pCursor).depth].pNode = pNode;
+        GBL_PRIV_REF(pCursor).stack[GBL_PRIV_REF(pCursor).depth].index = 0;
+        ++GBL_PRIV_REF(pCursor).depth;
+        if(pNode->leaf) {
+            break;
+        }
+        pNode = pNode->pChildren[0];
+    }
+}
+
+// pops finished nodes, then ends the cursor if it has passed its upper bound
+static void* cursor_settle_(GblTreeSetCursor* pCursor) {
+    const GblTreeSet* pSet = GBL_PRIV_REF(pCursor).pSet;
+
+    while(GBL_PRIV_REF(pCursor).depth &&
+          GBL_PRIV_REF(pCursor).stack[GBL_PRIV_REF(pCursor).depth-1].index >=
+          GBL_PRIV_REF(pCursor).stack[GBL_PRIV_REF(pCursor).depth-1].pNode->entryCount) {
+        --GBL_PRIV_REF(pCursor).depth;
+    }
+
+    void* pEntry = GblTreeSetCursor_entry(pCursor);
+
+    if(pEntry && GBL_PRIV_REF(pCursor).pUpper &&
+       pSet->pFnCompare(pSet, pEntry, GBL_PRIV_REF(pCursor).pUpper) > 0) {
+        GBL_PRIV_REF(pCursor).depth = 0;
+        pEntry = NULL;
+    }
+
+    return pEntry;
+}
+
+GBL_EXPORT void* GblTreeSet_range(const GblTreeSet* pSelf,
+                                  GblTreeSetCursor* pCursor,
+                                  const void*       pLower,
+                                  const void*       pUpper) GBL_NOEXCEPT
+{
+    void* pEntry = NULL;
+    GBL_CTX_BEGIN(pSelf->pCtx);
+    GBL_CTX_VERIFY_POINTER(pCursor);
+
+    memset(pCursor, 0, sizeof(GblTreeSetCursor));
+    GBL_PRIV_REF(pCursor).pSet   = pSelf;
+    GBL_PRIV_REF(pCursor).pUpper = pUpper;
+
+    GBL_CTX_VERIFY(pSelf->height <= GBL_TREE_SET_CURSOR_DEPTH,
+                   GBL_RESULT_ERROR_OVERFLOW,
+                   "[GblTreeSet]: Tree is too tall for a cursor!");
+
+    if(!pSelf->pRoot) {
+        GBL_CTX_DONE();
+    }
+
+    if(!pLower) {
+        cursor_descend_(pCursor, pSelf->pRoot);
+    } else {
+        GblTreeSetNode* pNode = pSelf->pRoot;
+        for(;;) {
+            GblBool   found = GBL_FALSE;
+            const int i     = node_find_(pSelf, pNode, pLower, &found, NULL, 0);
+
+            GBL_PRIV_REF(pCursor).stack[GBL_PRIV_REF(pCursor).depth].pNode = pNode;
+            GBL_PRIV_REF(pCursor).stack[GBL_PRIV_REF(pCursor).depth].index = (size_t)i;
+            ++GBL_PRIV_REF(pCursor).depth;
+
+            if(found || pNode->leaf) {
+                break;
+            }
+            pNode = pNode->pChildren[i];
+        }
+    }
+
+    pEntry = cursor_settle_(pCursor);
+
+    GBL_CTX_END_BLOCK();
+    return pEntry;
+}
+
+GBL_EXPORT size_t GblTreeSet_eraseRange(GblTreeSet* pSelf, const void* pLower, const void* pUpper) GBL_NOEXCEPT {
+    size_t   erased    = 0;
+    size_t   remaining = 0;
+    uint8_t* pBuffer   = NULL;
+    GBL_CTX_BEGIN(pSelf->pCtx);
+
+    const size_t first = pLower? rank_(pSelf, pLower, GBL_FALSE) : 0;
+    const size_t last  = pUpper? rank_(pSelf, pUpper, GBL_TRUE)  : pSelf->count;
+
+    if(last <= first) {
+        GBL_CTX_DONE();
+    }
+
+    erased = last - first;
+
+    remaining = pSelf->count - erased;
+
+    // cheaper to rebuild the tree from whatever survives, given somewhere to move it
+    if(erased * 16 >= pSelf->count && remaining)
+        pBuffer = GBL_CTX_MALLOC(remaining * pSelf->entrySize);
+
+    if(erased * 16 < pSelf->count || (remaining && !pBuffer)) {
+        // only a few entries (or no room for the rest), so delete them one at a time
+        for(size_t e = 0; e < erased; ++e) {
+            memcpy(pSelf->pSpares[1], select_(pSelf, first), pSelf->entrySize);
+            void* pEntry = delete_x_(pSelf, DELKEY, 0, pSelf->pSpares[1], NULL);
+            if(pSelf->pFnDestruct) {
+                pSelf->pFnDestruct(pSelf, pEntry);
+            }
+        }
+    } else {
+        GblTreeSetDestructFn pFnDestruct = pSelf->pFnDestruct;
+        GblTreeSetCursor     cursor;
+        size_t               index       = 0;
+        size_t               kept        = 0;
+        size_t               spanCount   = 0;
+
+        for(uint8_t* pSpan = GblTreeSet_range(pSelf, &cursor, NULL, NULL);
+            pSpan;
+            pSpan = GblTreeSetCursor_entry(&cursor))
+        {
+            pSpan = GblTreeSetCursor_span(&cursor, &spanCount);
+
+            for(size_t s = 0; s < spanCount; ++s, ++index) {
+                uint8_t* pEntry = pSpan + s * pSelf->entrySize;
+                if(index >= first && index < last) {
+                    if(pFnDestruct) {
+                        pFnDestruct(pSelf, pEntry);
+                    }
+                } else {
+                    memcpy(pBuffer + (kept++) * pSelf->entrySize, pEntry, pSelf->entrySize);
+                }
+            }
+        }
+
+        // the survivors have been moved out, so drop the nodes without destructing them
+        pSelf->pFnDestruct = NULL;
+        GblTreeSet_clear(pSelf);
+        pSelf->pFnDestruct = pFnDestruct;
+
+        if(remaining) {
+            GBL_CTX_VERIFY_CALL(load_(pSelf, pBuffer, remaining));
+        }
+    }
+
+    GBL_CTX_END_BLOCK();
+
+    if(pBuffer) {
+        // the survivors couldn't be loaded back, so they're erased too
+        if(GBL_RESULT_ERROR(GBL_CTX_RESULT())) {
+            if(pSelf->pFnDestruct) {
+                for(size_t e = 0; e < remaining; ++e)
+                    pSelf->pFnDestruct(pSelf, pBuffer + e * pSelf->entrySize);
+            }
+            erased += remaining;
+        }
+
+        GBL_CTX_FREE(pBuffer);
+    }
+
+    return erased;
+}
+
+GBL_EXPORT void* GblTreeSetCursor_entry(const GblTreeSetCursor* pSelf) GBL_NOEXCEPT {
+    if(!GBL_PRIV_REF(pSelf).depth) {
+        return NULL;
+    }
+    return get_item_at_(GBL_PRIV_REF(pSelf).stack[GBL_PRIV_REF(pSelf).depth-1].pNode,
+                        GBL_PRIV_REF(pSelf).pSet->entrySize,
+                        GBL_PRIV_REF(pSelf).stack[GBL_PRIV_REF(pSelf).depth-1].index);
+}
+
+GBL_EXPORT GblBool GblTreeSetCursor_valid(const GblTreeSetCursor* pSelf) GBL_NOEXCEPT {
+    return GBL_PRIV_REF(pSelf).depth? GBL_TRUE : GBL_FALSE;
+}
+
+GBL_EXPORT void* GblTreeSetCursor_next(GblTreeSetCursor* pSelf) GBL_NOEXCEPT {
+    if(!GBL_PRIV_REF(pSelf).depth) {
+        return NULL;
+    }
+
+    GblTreeSetNode* pNode  = GBL_PRIV_REF(pSelf).stack[GBL_PRIV_REF(pSelf).depth-1].pNode;
+    const size_t    index  = ++GBL_PRIV_REF(pSelf).stack[GBL_PRIV_REF(pSelf).depth-1].index;
+
+    // after a branch's entry comes the leftmost entry of its next child
+    if(!pNode->leaf) {
+        cursor_descend_(pSelf, pNode->pChildren[index]);
+    }
+
+    return cursor_settle_(pSelf);
+}
+
+GBL_EXPORT void* GblTreeSetCursor_span(GblTreeSetCursor* pSelf, size_t* pCount) GBL_NOEXCEPT {
+    void* pFirst = GblTreeSetCursor_entry(pSelf);
+
+    if(!pFirst) {
+        *pCount = 0;
+        return NULL;
+    }
+
+    const GblTreeSet* pSet   = GBL_PRIV_REF(pSelf).pSet;
+    GblTreeSetNode*   pNode  = GBL_PRIV_REF(pSelf).stack[GBL_PRIV_REF(pSelf).depth-1].pNode;
+    const size_t      index  = GBL_PRIV_REF(pSelf).stack[GBL_PRIV_REF(pSelf).depth-1].index;
+
+    // entries within a branch are separated by whole subtrees
+    if(!pNode->leaf) {
+        *pCount = 1;
+        GblTreeSetCursor_next(pSelf);
+        return pFirst;
+    }
+
+    size_t end = pNode->entryCount;
+
+    // only search for the upper bound in the leaf which actually contains it
+    if(GBL_PRIV_REF(pSelf).pUpper &&
+       pSet->pFnCompare(pSet,
+                        get_item_at_(pNode, pSet->entrySize, end-1),
+                        GBL_PRIV_REF(pSelf).pUpper) > 0)
+    {
+        size_t low = index, high = end;
+        while(low < high) {
+            const size_t mid = (low + high) / 2;
+            if(pSet->pFnCompare(pSet,
+                                get_item_at_(pNode, pSet->entrySize, mid),
+                                GBL_PRIV_REF(pSelf).pUpper) > 0) {
+                high = mid;
+            } else {
+                low = mid + 1;
+            }
+        }
+        end = low;
+    }
+
+    *pCount = end - index;
+    GBL_PRIV_REF(pSelf).stack[GBL_PRIV_REF(pSelf).depth-1].index = end;
+    cursor_settle_(pSelf);
+
+    return pFirst;
+}
@@ -1,5 +1,6 @@
 #include <gimbal/core/gimbal_logger.h>
 #include <tinycthread.h>
+#include <stdatomic.h>
 
 #define GBL_LOGGER_THREAD_FILTER_FIELD_NAME_    "GblLogger.threadFilter"
 #define GBL_LOGGER_DOMAIN_FILTER_FIELD_NAME_    "GblLogger.domainFilter"
@@ -13,6 +14,49 @@
         }                                                     \
     } GBL_STMT_END
 
+#define GBL_LOGGER_ASYNC_CACHE_LINE_            64
+#define GBL_LOGGER_ASYNC_RECORD_ALIGN_          8
+#define GBL_LOGGER_ASYNC_BUFFER_SIZE_MIN_       1024
+#define GBL_LOGGER_ASYNC_BUFFER_SIZE_DEFAULT_   4096
+#define GBL_LOGGER_ASYNC_FLUSH_MS_DEFAULT_      100
+#define GBL_LOGGER_ASYNC_RING_CAPACITY_(ring)   ((ring)->mask + 1)
+
+// Kinds of entries queued within a thread's ring buffer
+typedef enum GBL_LOGGER_RECORD_ {
+    GBL_LOGGER_RECORD_PAD_,     // Unused space before the ring wraps around
+    GBL_LOGGER_RECORD_WRITE_,   // GblLogger_write()
+    GBL_LOGGER_RECORD_PUSH_,    // GblLogger_push()
+    GBL_LOGGER_RECORD_POP_      // GblLogger_pop()
+} GBL_LOGGER_RECORD_;
+
+// Header for an entry, followed by its domain and message strings
+typedef struct GblLoggerRecord_ {
+    uint32_t      size;         // total size including strings, padded to alignment
+    uint16_t      type;         // GBL_LOGGER_RECORD_
+    uint16_t      domainSize;   // domain length + NUL or 0 for a NULL domain
+    GBL_LOG_FLAGS flags;
+    size_t        depth;        // log stack depth of the producer thread
+    size_t        lineOrCount;  // source line for writes, count for pops
+    const char*   pFile;
+    const char*   pFunction;
+    GblThd*       pThread;
+    time_t        timeStamp;
+} GblLoggerRecord_;
+
+/* Single-producer, single-consumer byte ring owned by one thread, with
+   monotonically increasing head and tail offsets on separate cache lines. */
+typedef struct GblLoggerRing_ {
+    GBL_ALIGNAS(GBL_LOGGER_ASYNC_CACHE_LINE_)
+    atomic_size_t           head;       // written by the owning thread
+    GBL_ALIGNAS(GBL_LOGGER_ASYNC_CACHE_LINE_)
+    atomic_size_t           tail;       // written by the draining thread
+    GBL_ALIGNAS(GBL_LOGGER_ASYNC_CACHE_LINE_)
+    atomic_bool             busy;       // owner is between checking and writing
+    atomic_bool             orphaned;   // owner exited, ring can be reclaimed
+    size_t                  mask;
+    struct GblLoggerRing_*  pNext;
+    uint8_t*                pData;
+} GblLoggerRing_;
 
 static GblLinkedListNode loggerList_ = {
     .pNext = &loggerList_
@@ -28,8 +72,42 @@ static GblQuark  threadFilterQuark_ = GBL_QUARK_INVALID;
 static GBL_THREAD_LOCAL
        size_t    stackDepth_        = 0;
 
+static atomic_bool              asyncEnabled_     = GBL_FALSE;
+static _Atomic(GblLoggerRing_*) pRingList_        = NULL;
+static atomic_size_t            ringGeneration_   = 0;
+static atomic_size_t            asyncDropped_     = 0;
+static atomic_bool              wakePending_      = GBL_FALSE;
+static atomic_bool              drainRunning_     = GBL_FALSE;
+static mtx_t                    asyncMtx_;
+static mtx_t                    wakeMtx_;
+static cnd_t                    wakeCnd_;
+static tss_t                    ringTss_;
+static thrd_t                   drainThread_;
+static GblLoggerAsyncConfig     asyncConfig_;
+static GBL_THREAD_LOCAL
+       GblLoggerRing_*          pThreadRing_      = NULL;
+static GBL_THREAD_LOCAL
+       size_t                   threadRingGen_    = 0;
+static GBL_THREAD_LOCAL
+       GblBool                  draining_         = GBL_FALSE;
+
+static void GblLogger_freeRings_(void) {
+    GblLoggerRing_* pRing = atomic_exchange(&pRingList_, NULL);
+    atomic_fetch_add(&ringGeneration_, 1);
+
+    GBL_CTX_BEGIN(NULL);
+    while(pRing) {
+        GblLoggerRing_* pNext = pRing->pNext;
+        GBL_CTX_FREE(pRing);
+        pRing = pNext;
+    }
+    GBL_CTX_END_BLOCK();
+}
+
 static void GblLogger_finalize_(void) {
     if(!initialized_) return;
+    GblLogger_stopAsync();
+    GblLogger_freeRings_();
     mtx_lock(&listMtx_);
 
     for(GblLinkedListNode* pIt = loggerList_.pNext;
@@ -44,8 +122,21 @@ static void GblLogger_finalize_(void) {
     mtx_unlock(&listMtx_);
 }
 
+static void GblLogger_orphanRing_(void* pRing) {
+    // Runs on the exiting thread, so its ring can no longer be written to
+    if(threadRingGen_ == atomic_load(&ringGeneration_))
+        atomic_store(&((GblLoggerRing_*)pRing)->orphaned, GBL_TRUE);
+    pThreadRing_ = NULL;
+}
+
 static void GblLogger_initialize_(void) {
-    if(!inittedOnce_) mtx_init(&listMtx_, mtx_recursive);
+    if(!inittedOnce_) {
+        mtx_init(&listMtx_, mtx_recursive);
+        mtx_init(&asyncMtx_, mtx_plain);
+        mtx_init(&wakeMtx_, mtx_plain);
+        cnd_init(&wakeCnd_);
+        tss_create(&ringTss_, GblLogger_orphanRing_);
+    }
     mtx_lock(&listMtx_);
     inittedOnce_ = GBL_TRUE;
     initializing_ = GBL_TRUE;
@@ -265,14 +356,8 @@ GBL_EXPORT const GblThd** GblLogger_threadFilters(const GblLogger* pSelf) {
 }
 
 
-GBL_EXPORT GBL_RESULT GblLogger_push(void) {
+static GBL_RESULT GblLogger_dispatchPush_(GblThd* pThread) {
     GBL_CTX_BEGIN(NULL);
-    GBL_LOGGER_ENSURE_INITIALIZED_();
-    mtx_lock(&listMtx_);
-
-    ++stackDepth_;
-
-    GblThd* pThread = GblThd_current();
 
     for(GblLinkedListNode* pIt = loggerList_.pNext;
         pIt != &loggerList_;
@@ -284,20 +369,11 @@ GBL_EXPORT GBL_RESULT GblLogger_push(void) {
         }
     }
 
-    GBL_CTX_END_BLOCK();
-    mtx_unlock(&listMtx_);
-    return GBL_CTX_RESULT();
+    GBL_CTX_END();
 }
 
-GBL_EXPORT GBL_RESULT GblLogger_pop(size_t count) {
+static GBL_RESULT GblLogger_dispatchPop_(GblThd* pThread, size_t count) {
     GBL_CTX_BEGIN(NULL);
-    GBL_LOGGER_ENSURE_INITIALIZED_();
-    mtx_lock(&listMtx_);
-
-    GBL_ASSERT(stackDepth_, "Underflowed log stack for thread!");
-    --stackDepth_;
-
-    GblThd* pThread = GblThd_current();
 
     for(GblLinkedListNode* pIt = loggerList_.pNext;
         pIt != &loggerList_;
@@ -311,9 +387,422 @@ GBL_EXPORT GBL_RESULT GblLogger_pop(size_t count) {
         }
     }
 
-    GBL_CTX_END_BLOCK();
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblLogger_dispatchWrite_(const char*   pFile,
+                                           const char*   pFunction,
+                                           size_t        line,
+                                           GblThd*       pThread,
+                                           time_t        timeStamp,
+                                           const char*   pDomain,
+                                           GBL_LOG_FLAGS flags,
+                                           const char*   pFmt,
+                                           va_list       varArgs) {
+    GBL_CTX_BEGIN(NULL);
+
+    for(GblLinkedListNode* pIt = loggerList_.pNext;
+        pIt != &loggerList_;
+        pIt = pIt->pNext)
+    {
+        GblLogger* pLogger = GBL_LOGGER_ENTRY_(pIt);
+        if(GblLogger_hasFilter(pLogger, pThread, pDomain, flags)) {
+            const GblBool firstTime = !GBL_PRIV_REF(pLogger).reentrant;
+
+            if(!firstTime &&
+               !(pLogger->flagsFilter & GBL_LOG_REENTRANT)) {
+                GBL_ASSERT(GBL_FALSE, "Logger doesn't support reentrancy!");
+                continue;
+            } else GBL_PRIV_REF(pLogger).reentrant = GBL_TRUE;
+
+            va_list args;
+            va_copy(args, varArgs);
+
+            GBL_CTX_CALL(GBL_LOGGER_GET_CLASS(pLogger)->pFnWrite(pLogger,
+                                                                 pFile,
+                                                                 pFunction,
+                                                                 line,
+                                                                 pThread,
+                                                                 timeStamp,
+                                                                 pDomain,
+                                                                 flags,
+                                                                 pFmt,
+                                                                 args));
+            va_end(args);
+
+            if(firstTime)
+                GBL_PRIV_REF(pLogger).reentrant = GBL_FALSE;
+
+        }
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblLogger_dispatchWritef_(const char*   pFile,
+                                            const char*   pFunction,
+                                            size_t        line,
+                                            GblThd*       pThread,
+                                            time_t        timeStamp,
+                                            const char*   pDomain,
+                                            GBL_LOG_FLAGS flags,
+                                            const char*   pFmt,
+                                            ...) {
+    va_list varArgs;
+    va_start(varArgs, pFmt);
+
+    const GBL_RESULT result = GblLogger_dispatchWrite_(pFile,
+                                                       pFunction,
+                                                       line,
+                                                       pThread,
+                                                       timeStamp,
+                                                       pDomain,
+                                                       flags,
+                                                       pFmt,
+                                                       varArgs);
+    va_end(varArgs);
+    return result;
+}
+
+static void GblLogger_wakeDrain_(void) {
+    // Only the first waker since the last drain pays for the signal
+    if(!atomic_exchange(&wakePending_, GBL_TRUE)) {
+        mtx_lock(&wakeMtx_);
+        cnd_signal(&wakeCnd_);
+        mtx_unlock(&wakeMtx_);
+    }
+}
+
+static GblLoggerRing_* GblLogger_threadRing_(void) {
+    const size_t generation = atomic_load_explicit(&ringGeneration_,
+                                                   memory_order_relaxed);
+
+    if GBL_LIKELY(pThreadRing_ && threadRingGen_ == generation)
+        return pThreadRing_;
+
+    GblLoggerRing_* pRing = NULL;
+
+    // Reuse the ring of a thread which has since exited
+    for(GblLoggerRing_* pIt = atomic_load(&pRingList_);
+        pIt;
+        pIt = pIt->pNext)
+    {
+        GblBool orphaned = GBL_TRUE;
+        if(atomic_compare_exchange_strong(&pIt->orphaned, &orphaned, GBL_FALSE)) {
+            pRing = pIt;
+            break;
+        }
+    }
+
+    if(!pRing) {
+        size_t capacity = GBL_LOGGER_ASYNC_BUFFER_SIZE_MIN_;
+        while(capacity < asyncConfig_.bufferSize) capacity <<= 1;
+
+        GBL_CTX_BEGIN(NULL);
+        pRing = GBL_CTX_MALLOC(sizeof(GblLoggerRing_) + capacity,
+                               GBL_LOGGER_ASYNC_CACHE_LINE_);
+        GBL_CTX_END_BLOCK();
+
+        if(!pRing) return NULL;
+
+        atomic_init(&pRing->head,     0);
+        atomic_init(&pRing->tail,     0);
+        atomic_init(&pRing->busy,     GBL_FALSE);
+        atomic_init(&pRing->orphaned, GBL_FALSE);
+        pRing->mask  = capacity - 1;
+        pRing->pData = (uint8_t*)(pRing + 1);
+        pRing->pNext = atomic_load(&pRingList_);
+
+        while(!atomic_compare_exchange_weak(&pRingList_, &pRing->pNext, pRing));
+    }
+
+    pThreadRing_   = pRing;
+    threadRingGen_ = generation;
+    tss_set(ringTss_, pRing);
+
+    return pRing;
+}
+
+/* Copies an entry into the calling thread's ring without locking, returning
+   GBL_FALSE if it must be dispatched synchronously instead. */
+static GblBool GblLogger_enqueue_(GBL_LOGGER_RECORD_ type,
+                                  const char*        pFile,
+                                  const char*        pFunction,
+                                  size_t             lineOrCount,
+                                  const char*        pDomain,
+                                  GBL_LOG_FLAGS      flags,
+                                  const char*        pMessage,
+                                  size_t             messageLength) {
+    if(!atomic_load_explicit(&asyncEnabled_, memory_order_relaxed) || draining_)
+        return GBL_FALSE;
+
+    GblLoggerRing_* pRing = GblLogger_threadRing_();
+
+    if GBL_UNLIKELY(!pRing)
+        return GBL_FALSE;
+
+    // Announce the write, then make sure GblLogger_stopAsync() hasn't begun
+    atomic_store(&pRing->busy, GBL_TRUE);
+
+    if GBL_UNLIKELY(!atomic_load(&asyncEnabled_)) {
+        atomic_store_explicit(&pRing->busy, GBL_FALSE, memory_order_release);
+        return GBL_FALSE;
+    }
+
+    const size_t capacity   = GBL_LOGGER_ASYNC_RING_CAPACITY_(pRing);
+    const size_t maxSize    = capacity / 2;
+    const size_t domainSize = pDomain? strlen(pDomain) + 1 : 0;
+    size_t       size       = sizeof(GblLoggerRecord_) + domainSize + messageLength + 1;
+
+    // Truncate anything that wouldn't leave room for other entries
+    if GBL_UNLIKELY(size > maxSize) {
+        const size_t excess = size - maxSize;
+        messageLength = (excess < messageLength)? messageLength - excess : 0;
+        size          = sizeof(GblLoggerRecord_) + domainSize + messageLength + 1;
+    }
+
+    size = (size + GBL_LOGGER_ASYNC_RECORD_ALIGN_ - 1) &
+           ~(size_t)(GBL_LOGGER_ASYNC_RECORD_ALIGN_ - 1);
+
+    size_t head = atomic_load_explicit(&pRing->head, memory_order_relaxed);
+    size_t offset, contiguous;
+
+    for(;;) {
+        const size_t tail = atomic_load_explicit(&pRing->tail, memory_order_acquire);
+
+        offset     = head & pRing->mask;
+        contiguous = capacity - offset;
+
+        // An entry which doesn't fit before the end is preceded by padding
+        const size_t needed = (contiguous < size)? contiguous + size : size;
+
+        if GBL_LIKELY(capacity - (head - tail) >= needed)
+            break;
+
+        GblLogger_wakeDrain_();
+
+        if(asyncConfig_.overflow == GBL_LOG_OVERFLOW_DROP) {
+            atomic_fetch_add_explicit(&asyncDropped_, 1, memory_order_relaxed);
+            atomic_store_explicit(&pRing->busy, GBL_FALSE, memory_order_release);
+            return GBL_TRUE;
+        }
+
+        thrd_yield();
+    }
+
+    if(contiguous < size) {
+        // Too little space for a header is skipped implicitly by the reader
+        if(contiguous >= sizeof(GblLoggerRecord_)) {
+            GblLoggerRecord_* pPad = (GblLoggerRecord_*)&pRing->pData[offset];
+            pPad->size = contiguous;
+            pPad->type = GBL_LOGGER_RECORD_PAD_;
+        }
+
+        head  += contiguous;
+        offset = 0;
+    }
+
+    GblLoggerRecord_* pRecord = (GblLoggerRecord_*)&pRing->pData[offset];
+    char*             pString = (char*)(pRecord + 1);
+
+    pRecord->size        = size;
+    pRecord->type        = type;
+    pRecord->domainSize  = domainSize;
+    pRecord->flags       = flags;
+    pRecord->depth       = stackDepth_;
+    pRecord->lineOrCount = lineOrCount;
+    pRecord->pFile       = pFile;
+    pRecord->pFunction   = pFunction;
+    pRecord->pThread     = GblThd_current();
+    pRecord->timeStamp   = (type == GBL_LOGGER_RECORD_WRITE_)? time(NULL) : 0;
+
+    if(domainSize)
+        memcpy(pString, pDomain, domainSize);
+
+    memcpy(pString + domainSize, pMessage, messageLength);
+    pString[domainSize + messageLength] = '\0';
+
+    head += size;
+    atomic_store_explicit(&pRing->head, head, memory_order_release);
+    atomic_store_explicit(&pRing->busy, GBL_FALSE, memory_order_release);
+
+    if((flags & asyncConfig_.flushFlags) ||
+       head - atomic_load_explicit(&pRing->tail, memory_order_relaxed) > maxSize)
+        GblLogger_wakeDrain_();
+
+    return GBL_TRUE;
+}
+
+static size_t GblLogger_drainRing_(GblLoggerRing_* pRing) {
+    const size_t capacity = GBL_LOGGER_ASYNC_RING_CAPACITY_(pRing);
+    const size_t head     = atomic_load_explicit(&pRing->head, memory_order_acquire);
+    size_t       tail     = atomic_load_explicit(&pRing->tail, memory_order_relaxed);
+    size_t       count    = 0;
+
+    while(tail != head) {
+        const size_t offset     = tail & pRing->mask;
+        const size_t contiguous = capacity - offset;
+
+        if(contiguous < sizeof(GblLoggerRecord_)) {
+            tail += contiguous;
+            continue;
+        }
+
+        const GblLoggerRecord_* pRecord = (const GblLoggerRecord_*)&pRing->pData[offset];
+        const char*             pString = (const char*)(pRecord + 1);
+
+        // Indent as the producer would have
+        stackDepth_ = pRecord->depth;
+
+        switch(pRecord->type) {
+        case GBL_LOGGER_RECORD_WRITE_:
+            GblLogger_dispatchWritef_(pRecord->pFile,
+                                      pRecord->pFunction,
+                                      pRecord->lineOrCount,
+                                      pRecord->pThread,
+                                      pRecord->timeStamp,
+                                      pRecord->domainSize? pString : NULL,
+                                      pRecord->flags,
+                                      "%s",
+                                      pString + pRecord->domainSize);
+            ++count;
+            break;
+        case GBL_LOGGER_RECORD_PUSH_:
+            GblLogger_dispatchPush_(pRecord->pThread);
+            break;
+        case GBL_LOGGER_RECORD_POP_:
+            GblLogger_dispatchPop_(pRecord->pThread, pRecord->lineOrCount);
+            break;
+        default: break;
+        }
+
+        tail += pRecord->size;
+        atomic_store_explicit(&pRing->tail, tail, memory_order_release);
+    }
+
+    return count;
+}
+
+static size_t GblLogger_drainAll_(void) {
+    size_t count = 0;
+
+    mtx_lock(&listMtx_);
+
+    const GblBool draining = draining_;
+    const size_t  depth    = stackDepth_;
+
+    draining_ = GBL_TRUE;
+
+    for(GblLoggerRing_* pRing = atomic_load(&pRingList_);
+        pRing;
+        pRing = pRing->pNext)
+            count += GblLogger_drainRing_(pRing);
+
+    stackDepth_ = depth;
+    draining_   = draining;
+
     mtx_unlock(&listMtx_);
-    return GBL_CTX_RESULT();
+
+    // One flush per batch rather than per message
+    if(count) {
+        fflush(stdout);
+        fflush(stderr);
+    }
+
+    return count;
+}
+
+static int GblLogger_drainMain_(void* pUserdata) {
+    GBL_UNUSED(pUserdata);
+
+    // Anything logged from this thread is dispatched directly
+    draining_ = GBL_TRUE;
+
+    while(atomic_load(&drainRunning_)) {
+        mtx_lock(&wakeMtx_);
+
+        if(!atomic_load(&wakePending_) && atomic_load(&drainRunning_)) {
+            if(asyncConfig_.flushMs) {
+                struct timespec deadline;
+                timespec_get(&deadline, TIME_UTC);
+
+                deadline.tv_sec  += asyncConfig_.flushMs / 1000;
+                deadline.tv_nsec += (long)(asyncConfig_.flushMs % 1000) * 1000000;
+
+                if(deadline.tv_nsec >= 1000000000) {
+                    ++deadline.tv_sec;
+                    deadline.tv_nsec -= 1000000000;
+                }
+
+                cnd_timedwait(&wakeCnd_, &wakeMtx_, &deadline);
+            } else cnd_wait(&wakeCnd_, &wakeMtx_);
+        }
+
+        atomic_store(&wakePending_, GBL_FALSE);
+        mtx_unlock(&wakeMtx_);
+
+        GblLogger_drainAll_();
+    }
+
+    return 0;
+}
+
+static void GblLogger_stopAsync_(void) {
+    if(!atomic_load(&drainRunning_)) return;
+
+    // Route new entries synchronously, then wait out any still being copied
+    atomic_store(&asyncEnabled_, GBL_FALSE);
+
+    for(GblLoggerRing_* pRing = atomic_load(&pRingList_);
+        pRing;
+        pRing = pRing->pNext)
+            while(atomic_load(&pRing->busy)) thrd_yield();
+
+    atomic_store(&drainRunning_, GBL_FALSE);
+    atomic_store(&wakePending_, GBL_TRUE);
+
+    mtx_lock(&wakeMtx_);
+    cnd_signal(&wakeCnd_);
+    mtx_unlock(&wakeMtx_);
+
+    thrd_join(drainThread_, NULL);
+
+    GblLogger_drainAll_();
+}
+
+GBL_EXPORT GBL_RESULT GblLogger_push(void) {
+    GBL_CTX_BEGIN(NULL);
+    GBL_LOGGER_ENSURE_INITIALIZED_();
+
+    ++stackDepth_;
+
+    if(!GblLogger_enqueue_(GBL_LOGGER_RECORD_PUSH_,
+                           NULL, NULL, 0, NULL, 0, NULL, 0))
+    {
+        mtx_lock(&listMtx_);
+        GBL_CTX_CALL(GblLogger_dispatchPush_(GblThd_current()));
+        mtx_unlock(&listMtx_);
+    }
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblLogger_pop(size_t count) {
+    GBL_CTX_BEGIN(NULL);
+    GBL_LOGGER_ENSURE_INITIALIZED_();
+
+    GBL_ASSERT(stackDepth_, "Underflowed log stack for thread!");
+    --stackDepth_;
+
+    if(!GblLogger_enqueue_(GBL_LOGGER_RECORD_POP_,
+                           NULL, NULL, count, NULL, 0, NULL, 0))
+    {
+        mtx_lock(&listMtx_);
+        GBL_CTX_CALL(GblLogger_dispatchPop_(GblThd_current(), count));
+        mtx_unlock(&listMtx_);
+    }
+
+    GBL_CTX_END();
 }
 
 GBL_EXPORT size_t GblLogger_depth(void) {
@@ -349,49 +838,144 @@ GBL_EXPORT GBL_RESULT GblLogger_writeVa(const char*   pFile,
                                         GBL_LOG_FLAGS flags,
                                         const char*   pFmt,
                                         va_list       varArgs) {
+    // Fast path: format on the stack and hand off, without locking or stdio
+    if(atomic_load_explicit(&asyncEnabled_, memory_order_relaxed) && !draining_) {
+        char buffer[GBL_VA_SNPRINTF_BUFFER_SIZE];
+
+        const int    bytes  = vsnprintf(buffer, sizeof(buffer), pFmt, varArgs);
+        const size_t length = (bytes < 0)? 0 : GBL_MIN((size_t)bytes, sizeof(buffer) - 1);
+
+        if(!GblLogger_enqueue_(GBL_LOGGER_RECORD_WRITE_,
+                               pFile,
+                               pFunction,
+                               line,
+                               pDomain,
+                               flags,
+                               buffer,
+                               length))
+        {
+            mtx_lock(&listMtx_);
+            GblLogger_dispatchWritef_(pFile,
+                                      pFunction,
+                                      line,
+                                      GblThd_current(),
+                                      time(NULL),
+                                      pDomain,
+                                      flags,
+                                      "%s",
+                                      buffer);
+            mtx_unlock(&listMtx_);
+        }
+
+        return (bytes >= (int)sizeof(buffer))? GBL_RESULT_TRUNCATED : GBL_RESULT_SUCCESS;
+    }
+
     GBL_CTX_BEGIN(NULL);
     GBL_LOGGER_ENSURE_INITIALIZED_();
     mtx_lock(&listMtx_);
 
-    GblThd* pThread = GblThd_current();
-    const time_t timeStamp = time(NULL);
+    GBL_CTX_CALL(GblLogger_dispatchWrite_(pFile,
+                                          pFunction,
+                                          line,
+                                          GblThd_current(),
+                                          time(NULL),
+                                          pDomain,
+                                          flags,
+                                          pFmt,
+                                          varArgs));
 
-    for(GblLinkedListNode* pIt = loggerList_.pNext;
-        pIt != &loggerList_;
-        pIt = pIt->pNext)
-    {
-        GblLogger* pLogger = GBL_LOGGER_ENTRY_(pIt);
-        if(GblLogger_hasFilter(pLogger, pThread, pDomain, flags)) {
-            const GblBool firstTime = !GBL_PRIV_REF(pLogger).reentrant;
+    GBL_CTX_END_BLOCK();
+    mtx_unlock(&listMtx_);
+    return GBL_CTX_RESULT();
+}
 
-            if(!firstTime &&
-               !(pLogger->flagsFilter & GBL_LOG_REENTRANT)) {
-                GBL_ASSERT(GBL_FALSE, "Logger doesn't support reentrancy!");
-                continue;
-            } else GBL_PRIV_REF(pLogger).reentrant = GBL_TRUE;
+GBL_EXPORT GBL_RESULT GblLogger_startAsync(const GblLoggerAsyncConfig* pConfig) {
+    static const GblLoggerAsyncConfig defaultConfig = {
+        .bufferSize = GBL_LOGGER_ASYNC_BUFFER_SIZE_DEFAULT_,
+        .flushMs    = GBL_LOGGER_ASYNC_FLUSH_MS_DEFAULT_,
+        .flushFlags = GBL_LOG_ERROR,
+        .overflow   = GBL_LOG_OVERFLOW_DROP
+    };
 
-            GBL_CTX_CALL(GBL_LOGGER_GET_CLASS(pLogger)->pFnWrite(pLogger,
-                                                                 pFile,
-                                                                 pFunction,
-                                                                 line,
-                                                                 pThread,
-                                                                 timeStamp,
-                                                                 pDomain,
-                                                                 flags,
-                                                                 pFmt,
-                                                                 varArgs));
+    GBL_CTX_BEGIN(NULL);
+    GBL_LOGGER_ENSURE_INITIALIZED_();
+    mtx_lock(&asyncMtx_);
 
-            if(firstTime)
-                GBL_PRIV_REF(pLogger).reentrant = GBL_FALSE;
+    // Reconfigure from a clean, synchronous state
+    GblLogger_stopAsync_();
 
-        }
-    }
+    asyncConfig_ = pConfig? *pConfig : defaultConfig;
+
+    GBL_CTX_VERIFY_ARG(asyncConfig_.overflow == GBL_LOG_OVERFLOW_DROP ||
+                       asyncConfig_.overflow == GBL_LOG_OVERFLOW_BLOCK);
+
+    if(!asyncConfig_.bufferSize)
+        asyncConfig_.bufferSize = defaultConfig.bufferSize;
+
+    atomic_store(&drainRunning_, GBL_TRUE);
+
+    const int result = thrd_create(&drainThread_,
+                                   GblLogger_drainMain_,
+                                   NULL);
+
+    if(result != thrd_success)
+        atomic_store(&drainRunning_, GBL_FALSE);
+
+    GBL_CTX_VERIFY(result == thrd_success,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "Failed to create logger thread with code: %d",
+                   result);
+
+    atomic_store(&asyncEnabled_, GBL_TRUE);
 
     GBL_CTX_END_BLOCK();
-    mtx_unlock(&listMtx_);
+    mtx_unlock(&asyncMtx_);
     return GBL_CTX_RESULT();
 }
 
+GBL_EXPORT GBL_RESULT GblLogger_stopAsync(void) {
+    if(!inittedOnce_) return GBL_RESULT_SUCCESS;
+
+    mtx_lock(&asyncMtx_);
+    GblLogger_stopAsync_();
+    mtx_unlock(&asyncMtx_);
+
+    return GBL_RESULT_SUCCESS;
+}
+
+GBL_EXPORT GblBool GblLogger_isAsync(void) {
+    return atomic_load(&asyncEnabled_);
+}
+
+GBL_EXPORT GBL_RESULT GblLogger_flush(void) {
+    GBL_CTX_BEGIN(NULL);
+
+    // Wait for everything enqueued so far, unless we'd be waiting on ourself
+    if(atomic_load(&asyncEnabled_) && !draining_) {
+        for(GblLoggerRing_* pRing = atomic_load(&pRingList_);
+            pRing;
+            pRing = pRing->pNext)
+        {
+            const size_t head = atomic_load_explicit(&pRing->head,
+                                                     memory_order_acquire);
+
+            while(atomic_load_explicit(&pRing->tail, memory_order_acquire) < head) {
+                GblLogger_wakeDrain_();
+                thrd_yield();
+            }
+        }
+    }
+
+    GBL_CTX_VERIFY(fflush(stdout) == 0 && fflush(stderr) == 0,
+                   GBL_RESULT_ERROR_FILE_WRITE);
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT size_t GblLogger_asyncDropped(void) {
+    return atomic_load(&asyncDropped_);
+}
+
 
 static GBL_RESULT GblLogger_push_(GblLogger* pSelf, GblThd* pThread) {
     GBL_UNUSED(pSelf, pThread);
@@ -467,11 +1051,11 @@ static GBL_RESULT GblLogger_write_(GblLogger*    pSelf,
         if(((fprintf(pOut, "[%6s] %s%s%s\n",
                     pDomain,
                     tabBuff, pPrefix, buffer)
-            >= 0))) result = GBL_RESULT_ERROR_FILE_WRITE;
+            < 0))) result = GBL_RESULT_ERROR_FILE_WRITE;
     }
 
-    // Flush the buffer to not miss anything
-    if(fflush(pOut) == 0) result = GBL_RESULT_ERROR_FILE_WRITE;
+    // Flush the buffer to not miss anything, unless a batch flushes after
+    if(!draining_ && fflush(pOut) != 0) result = GBL_RESULT_ERROR_FILE_WRITE;
 
     return result;
 }
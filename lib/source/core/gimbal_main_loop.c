@@ -1,2 +1,1212 @@
 #include <gimbal/core/gimbal_main_loop.h>
+#include <gimbal/core/gimbal_thread.h>
+#include <gimbal/core/gimbal_tls.h>
+#include <gimbal/containers/gimbal_array_list.h>
+#include <gimbal/meta/signals/gimbal_marshal.h>
+#include "gimbal_task_.h"
 
+#include <tinycthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+#define GBL_MAIN_LOOP_(self)                (GBL_PRIVATE(GblMainLoop, self))
+#define GBL_MAIN_LOOP_DEQUE_CAPACITY_       64      // initial slots per deque, must be a power of 2
+#define GBL_MAIN_LOOP_SPIN_COUNT_           64      // yields before a worker goes to sleep
+#define GBL_MAIN_LOOP_SLEEP_NSEC_           1000000 // upper bound on any one sleep of a non-worker thread
+#define GBL_MAIN_LOOP_ITERATION_BUDGET_     256     // tasks run per iteration without workers
+
+// Growable ring of task slots, retired buffers are kept around until the deque is destroyed
+typedef struct GblTaskBuffer_ {
+    struct GblTaskBuffer_* pPrev;
+    size_t                 mask;
+    _Atomic(GblTask*)      slots[];
+} GblTaskBuffer_;
+
+/* Chase-Lev deque: the owner pushes and takes at the bottom, while
+   any other thread may steal from the top. */
+typedef struct GblTaskDeque_ {
+    atomic_ptrdiff_t          top;
+    atomic_ptrdiff_t          bottom;
+    _Atomic(GblTaskBuffer_*)  pBuffer;
+} GblTaskDeque_;
+
+typedef struct GblMainLoopWorker_ {
+    GblTaskDeque_       deques[GBL_PRIORITY_COUNT];
+    GblMainLoop*        pLoop;
+    GblThread*          pThread;
+    // odd while the worker is executing a task, lets the reaper know when it's safe to release one
+    atomic_size_t       epoch;
+    size_t              nesting;
+    uint32_t            seed;
+} GblMainLoopWorker_;
+
+typedef struct GblMainLoopSource_ {
+    uint64_t      deadline;     // nsec, 0 for idle sources
+    uint64_t      interval;     // nsec
+    size_t        id;
+    GblMainLoopFn pFn;
+    void*         pUserdata;
+} GblMainLoopSource_;
+
+GBL_DECLARE_STRUCT(GblMainLoop_) {
+    GblMainLoopWorker_* pWorkers;
+    size_t              workerCount;
+    // guards the injection queue, sources, and sleeping
+    mtx_t               mtx;
+    cnd_t               workCnd;
+    cnd_t               doneCnd;
+    GblTask*            pInjectHead[GBL_PRIORITY_COUNT];
+    GblTask*            pInjectTail[GBL_PRIORITY_COUNT];
+    atomic_uint         injectMask;
+    atomic_size_t       queued;
+    atomic_size_t       depth;
+    atomic_size_t       sleepers;
+    atomic_size_t       waiters;
+    // number of tasks being executed by threads outside of the pool
+    atomic_size_t       helping;
+    // tasks which are done, waiting on a non-worker thread to release them
+    _Atomic(GblTask*)   pRetired;
+    mtx_t               reapMtx;
+    GblTask*            pLimbo;
+    size_t*             pLimboEpochs;
+    GblBool             limboHelping;
+    atomic_bool         stopping;
+    atomic_bool         stopRequested;
+    atomic_bool         running;
+    GblArrayList        timers;
+    GblArrayList        idlers;
+    size_t              nextSourceId;
+    size_t              dispatchingId;
+    GblBool             dispatchRemoved;
+};
+
+GBL_TLS(GblMainLoopWorker_*, pCurWorker_, NULL);
+
+static uint64_t GblMainLoop_now_(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void GblMainLoop_timedWait_(cnd_t* pCnd, mtx_t* pMtx, uint64_t nsec) {
+    const uint64_t  until = GblMainLoop_now_() + nsec;
+    struct timespec ts    = {
+        .tv_sec  = (time_t)(until / 1000000000ull),
+        .tv_nsec = (long)(until % 1000000000ull)
+    };
+    cnd_timedwait(pCnd, pMtx, &ts);
+}
+
+static GblMainLoopWorker_* GblMainLoop_worker_(const GblMainLoop* pSelf) {
+    GblMainLoopWorker_* pWorker = *GBL_TLS_LOAD(pCurWorker_);
+    return pWorker && pWorker->pLoop == pSelf? pWorker : NULL;
+}
+
+static GBL_RESULT GblTaskDeque_construct_(GblTaskDeque_* pSelf) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblTaskBuffer_* pBuffer = GBL_CTX_MALLOC(sizeof(GblTaskBuffer_) +
+                                             sizeof(GblTask*) * GBL_MAIN_LOOP_DEQUE_CAPACITY_);
+    pBuffer->pPrev = NULL;
+    pBuffer->mask  = GBL_MAIN_LOOP_DEQUE_CAPACITY_ - 1;
+
+    atomic_init(&pSelf->top,     0);
+    atomic_init(&pSelf->bottom,  0);
+    atomic_init(&pSelf->pBuffer, pBuffer);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblTaskDeque_destruct_(GblTaskDeque_* pSelf) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblTaskBuffer_* pBuffer = atomic_load_explicit(&pSelf->pBuffer, memory_order_relaxed);
+
+    while(pBuffer) {
+        GblTaskBuffer_* pPrev = pBuffer->pPrev;
+        GBL_CTX_FREE(pBuffer);
+        pBuffer = pPrev;
+    }
+
+    GBL_CTX_END();
+}
+
+// Owner only
+static GBL_RESULT GblTaskDeque_push_(GblTaskDeque_* pSelf, GblTask* pTask) {
+    GBL_CTX_BEGIN(NULL);
+
+    const ptrdiff_t b       = atomic_load_explicit(&pSelf->bottom, memory_order_relaxed);
+    const ptrdiff_t t       = atomic_load_explicit(&pSelf->top,    memory_order_acquire);
+    GblTaskBuffer_* pBuffer = atomic_load_explicit(&pSelf->pBuffer, memory_order_relaxed);
+
+    if GBL_UNLIKELY((size_t)(b - t) > pBuffer->mask) {
+        const size_t    capacity = (pBuffer->mask + 1) * 2;
+        GblTaskBuffer_* pGrown   = GBL_CTX_MALLOC(sizeof(GblTaskBuffer_) +
+                                                  sizeof(GblTask*) * capacity);
+        pGrown->pPrev = pBuffer;
+        pGrown->mask  = capacity - 1;
+
+        for(ptrdiff_t i = t; i < b; ++i)
+            atomic_store_explicit(&pGrown->slots[i & pGrown->mask],
+                                  atomic_load_explicit(&pBuffer->slots[i & pBuffer->mask],
+                                                       memory_order_relaxed),
+                                  memory_order_relaxed);
+
+        // thieves still reading the old buffer see the same tasks, so it's kept alive
+        atomic_store_explicit(&pSelf->pBuffer, pGrown, memory_order_release);
+        pBuffer = pGrown;
+    }
+
+    atomic_store_explicit(&pBuffer->slots[b & pBuffer->mask], pTask, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&pSelf->bottom, b + 1, memory_order_relaxed);
+
+    GBL_CTX_END();
+}
+
+// Owner only
+static GblTask* GblTaskDeque_take_(GblTaskDeque_* pSelf) {
+    const ptrdiff_t b       = atomic_load_explicit(&pSelf->bottom, memory_order_relaxed) - 1;
+    GblTaskBuffer_* pBuffer = atomic_load_explicit(&pSelf->pBuffer, memory_order_relaxed);
+
+    atomic_store_explicit(&pSelf->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    ptrdiff_t t     = atomic_load_explicit(&pSelf->top, memory_order_relaxed);
+    GblTask*  pTask = NULL;
+
+    if(t <= b) {
+        pTask = atomic_load_explicit(&pBuffer->slots[b & pBuffer->mask], memory_order_relaxed);
+
+        // last one left, race thieves for it
+        if(t == b) {
+            if(!atomic_compare_exchange_strong_explicit(&pSelf->top,
+                                                        &t,
+                                                        t + 1,
+                                                        memory_order_seq_cst,
+                                                        memory_order_relaxed))
+                pTask = NULL;
+
+            atomic_store_explicit(&pSelf->bottom, b + 1, memory_order_relaxed);
+        }
+    } else {
+        atomic_store_explicit(&pSelf->bottom, b + 1, memory_order_relaxed);
+    }
+
+    return pTask;
+}
+
+// Any thread
+static GblTask* GblTaskDeque_steal_(GblTaskDeque_* pSelf) {
+    ptrdiff_t t = atomic_load_explicit(&pSelf->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    const ptrdiff_t b = atomic_load_explicit(&pSelf->bottom, memory_order_acquire);
+
+    if(t < b) {
+        GblTaskBuffer_* pBuffer = atomic_load_explicit(&pSelf->pBuffer, memory_order_acquire);
+        GblTask*        pTask   = atomic_load_explicit(&pBuffer->slots[t & pBuffer->mask],
+                                                       memory_order_relaxed);
+
+        if(atomic_compare_exchange_strong_explicit(&pSelf->top,
+                                                   &t,
+                                                   t + 1,
+                                                   memory_order_seq_cst,
+                                                   memory_order_relaxed))
+            return pTask;
+    }
+
+    return NULL;
+}
+
+static void GblMainLoop_wake_(GblMainLoop_* pSelf_) {
+    if(atomic_load(&pSelf_->sleepers) || atomic_load(&pSelf_->waiters)) {
+        mtx_lock(&pSelf_->mtx);
+        cnd_signal(&pSelf_->workCnd);
+        cnd_broadcast(&pSelf_->doneCnd);
+        mtx_unlock(&pSelf_->mtx);
+    }
+}
+
+static void GblMainLoop_schedule_(GblTask* pTask);
+
+static void GblMainLoop_complete_(GblMainLoop* pSelf, GblTask* pTask) {
+    GblMainLoop_* pSelf_ = GBL_MAIN_LOOP_(pSelf);
+    GblTask_*     pTask_ = GBL_TASK_(pTask);
+
+    const int     state  = atomic_load_explicit(&pTask_->state, memory_order_acquire);
+
+    while(atomic_flag_test_and_set_explicit(&pTask_->linkLock, memory_order_acquire));
+    pTask_->linksClosed = GBL_TRUE;
+    pTask_->failed      = state != GBL_TASK_STATE_FINISHED ||
+                          !GBL_RESULT_SUCCESS(pTask_->result);
+    atomic_flag_clear_explicit(&pTask_->linkLock, memory_order_release);
+
+    // no more links can be added, so they can be walked without the lock
+    for(GblTaskLink_* pLink = pTask_->pLinks; pLink; pLink = pLink->pNext) {
+        if(pTask_->failed)
+            GblTask_cancel(pLink->pTask);
+
+        GblMainLoop_release_(pLink->pTask);
+    }
+
+    // hand the loop's references over to the reaper
+    GblTask* pHead = atomic_load_explicit(&pSelf_->pRetired, memory_order_relaxed);
+    do {
+        pTask_->pNextQueued = pHead;
+    } while(!atomic_compare_exchange_weak_explicit(&pSelf_->pRetired,
+                                                   &pHead,
+                                                   pTask,
+                                                   memory_order_release,
+                                                   memory_order_relaxed));
+
+    atomic_fetch_sub(&pSelf_->depth, 1);
+
+    if(atomic_load(&pSelf_->waiters)) {
+        mtx_lock(&pSelf_->mtx);
+        cnd_broadcast(&pSelf_->doneCnd);
+        mtx_unlock(&pSelf_->mtx);
+    }
+}
+
+static void GblMainLoop_schedule_(GblTask* pTask) {
+    GblTask_*           pTask_  = GBL_TASK_(pTask);
+    GblMainLoop*        pSelf   = pTask_->pLoop;
+    GblMainLoop_*       pSelf_  = GBL_MAIN_LOOP_(pSelf);
+    GblMainLoopWorker_* pWorker = GblMainLoop_worker_(pSelf);
+    int                 state   = GBL_TASK_STATE_PENDING;
+
+    // canceled before it ever got queued
+    if(!atomic_compare_exchange_strong_explicit(&pTask_->state,
+                                                &state,
+                                                GBL_TASK_STATE_QUEUED,
+                                                memory_order_acq_rel,
+                                                memory_order_acquire)) {
+        GblMainLoop_complete_(pSelf, pTask);
+        return;
+    }
+
+    GblPriority level = GblTask_priority(pTask);
+
+    if(level < GBL_PRIORITY_IDLE)
+        level = GBL_PRIORITY_IDLE;
+    else if(level >= GBL_PRIORITY_COUNT)
+        level = GBL_PRIORITY_COUNT - 1;
+
+    // tasks spawned by a worker stay local to it until somebody steals them
+    if(pWorker) {
+        GblTaskDeque_push_(&pWorker->deques[level], pTask);
+    } else {
+        pTask_->pNextQueued = NULL;
+
+        mtx_lock(&pSelf_->mtx);
+        if(pSelf_->pInjectTail[level])
+            GBL_TASK_(pSelf_->pInjectTail[level])->pNextQueued = pTask;
+        else
+            pSelf_->pInjectHead[level] = pTask;
+        pSelf_->pInjectTail[level] = pTask;
+        atomic_fetch_or(&pSelf_->injectMask, 1u << level);
+        mtx_unlock(&pSelf_->mtx);
+    }
+
+    atomic_fetch_add(&pSelf_->queued, 1);
+
+    GblMainLoop_wake_(pSelf_);
+}
+
+void GblMainLoop_release_(GblTask* pTask) {
+    GblTask_* pTask_ = GBL_TASK_(pTask);
+
+    if(atomic_fetch_sub_explicit(&pTask_->pending, 1, memory_order_acq_rel) == 1)
+        GblMainLoop_schedule_(pTask);
+}
+
+static GblTask* GblMainLoop_popInjected_(GblMainLoop_* pSelf_, size_t level) {
+    GblTask* pTask = NULL;
+
+    if(atomic_load_explicit(&pSelf_->injectMask, memory_order_relaxed) & (1u << level)) {
+        mtx_lock(&pSelf_->mtx);
+
+        if((pTask = pSelf_->pInjectHead[level])) {
+            pSelf_->pInjectHead[level] = GBL_TASK_(pTask)->pNextQueued;
+
+            if(!pSelf_->pInjectHead[level]) {
+                pSelf_->pInjectTail[level] = NULL;
+                atomic_fetch_and(&pSelf_->injectMask, ~(1u << level));
+            }
+        }
+
+        mtx_unlock(&pSelf_->mtx);
+    }
+
+    return pTask;
+}
+
+// Fetches the next task, from the highest priority level down: own deque, injection queue, then other workers
+static GblTask* GblMainLoop_take_(GblMainLoop* pSelf, GblMainLoopWorker_* pWorker) {
+    GblMainLoop_* pSelf_ = GBL_MAIN_LOOP_(pSelf);
+    GblTask*      pTask  = NULL;
+
+    if(!atomic_load_explicit(&pSelf_->queued, memory_order_relaxed))
+        return NULL;
+
+    for(int level = GBL_PRIORITY_COUNT - 1; level >= 0 && !pTask; --level) {
+        if(pWorker && (pTask = GblTaskDeque_take_(&pWorker->deques[level])))
+            break;
+
+        if((pTask = GblMainLoop_popInjected_(pSelf_, level)))
+            break;
+
+        if(pSelf_->workerCount) {
+            size_t start = 0;
+
+            // xorshift for picking a random victim to start stealing from
+            if(pWorker) {
+                pWorker->seed ^= pWorker->seed << 13;
+                pWorker->seed ^= pWorker->seed >> 17;
+                pWorker->seed ^= pWorker->seed << 5;
+                start = pWorker->seed % pSelf_->workerCount;
+            }
+
+            for(size_t w = 0; w < pSelf_->workerCount && !pTask; ++w) {
+                GblMainLoopWorker_* pVictim = &pSelf_->pWorkers[(start + w) % pSelf_->workerCount];
+
+                if(pVictim != pWorker)
+                    pTask = GblTaskDeque_steal_(&pVictim->deques[level]);
+            }
+        }
+    }
+
+    if(pTask)
+        atomic_fetch_sub(&pSelf_->queued, 1);
+
+    return pTask;
+}
+
+static void GblMainLoop_run_(GblMainLoop* pSelf, GblMainLoopWorker_* pWorker, GblTask* pTask) {
+    GblMainLoop_* pSelf_ = GBL_MAIN_LOOP_(pSelf);
+
+    if(pWorker) {
+        if(!pWorker->nesting++)
+            atomic_fetch_add(&pWorker->epoch, 1);
+    } else
+        atomic_fetch_add(&pSelf_->helping, 1);
+
+    GBL_CTX_BEGIN(NULL);
+    GBL_VCALL(GblMainLoop, pFnExecTask, pSelf, pTask);
+    GBL_CTX_END_BLOCK();
+
+    // an override which didn't run the task at all has effectively dropped it
+    int state = GBL_TASK_STATE_QUEUED;
+    atomic_compare_exchange_strong(&GBL_TASK_(pTask)->state, &state, GBL_TASK_STATE_CANCELED);
+
+    GblMainLoop_complete_(pSelf, pTask);
+
+    if(pWorker) {
+        if(!--pWorker->nesting)
+            atomic_fetch_add(&pWorker->epoch, 1);
+    } else
+        atomic_fetch_sub(&pSelf_->helping, 1);
+}
+
+// Whether every thread which could have still been touching the limbo batch has since moved on
+static GblBool GblMainLoop_graceElapsed_(GblMainLoop_* pSelf_) {
+    if(pSelf_->limboHelping && atomic_load(&pSelf_->helping))
+        return GBL_FALSE;
+
+    for(size_t w = 0; w < pSelf_->workerCount; ++w) {
+        const size_t epoch = pSelf_->pLimboEpochs[w];
+
+        if((epoch & 1) && atomic_load(&pSelf_->pWorkers[w].epoch) == epoch)
+            return GBL_FALSE;
+    }
+
+    return GBL_TRUE;
+}
+
+static GBL_RESULT GblMainLoop_releaseTasks_(GblTask* pTask) {
+    GBL_CTX_BEGIN(NULL);
+
+    while(pTask) {
+        GblTask_* pTask_ = GBL_TASK_(pTask);
+        GblTask*  pNext  = pTask_->pNextQueued;
+
+        while(pTask_->pLinks) {
+            GblTaskLink_* pLink = pTask_->pLinks;
+            pTask_->pLinks = pLink->pNext;
+
+            GBL_UNREF(pLink->pTask);
+            GBL_CTX_FREE(pLink);
+        }
+
+        GBL_UNREF(pTask);
+        pTask = pNext;
+    }
+
+    GBL_CTX_END();
+}
+
+/* Releases the loop's references to done tasks. Reference counting
+   isn't atomic, so this only ever happens on threads outside of the
+   pool, and only once every task which was running when a batch was
+   retired has returned, since it could have spawned tasks in the batch
+   and may still be holding references to them. */
+static void GblMainLoop_reap_(GblMainLoop* pSelf) {
+    GblMainLoop_* pSelf_ = GBL_MAIN_LOOP_(pSelf);
+
+    if(mtx_trylock(&pSelf_->reapMtx) != thrd_success)
+        return;
+
+    GBL_CTX_BEGIN(NULL);
+
+    if(pSelf_->pLimbo && GblMainLoop_graceElapsed_(pSelf_)) {
+        GblMainLoop_releaseTasks_(pSelf_->pLimbo);
+        pSelf_->pLimbo = NULL;
+    }
+
+    if(!pSelf_->pLimbo && atomic_load_explicit(&pSelf_->pRetired, memory_order_relaxed)) {
+        pSelf_->pLimbo = atomic_exchange(&pSelf_->pRetired, NULL);
+
+        for(size_t w = 0; w < pSelf_->workerCount; ++w)
+            pSelf_->pLimboEpochs[w] = atomic_load(&pSelf_->pWorkers[w].epoch);
+
+        pSelf_->limboHelping = atomic_load(&pSelf_->helping) != 0;
+
+        if(GblMainLoop_graceElapsed_(pSelf_)) {
+            GblMainLoop_releaseTasks_(pSelf_->pLimbo);
+            pSelf_->pLimbo = NULL;
+        }
+    }
+
+    GBL_CTX_END_BLOCK();
+
+    mtx_unlock(&pSelf_->reapMtx);
+}
+
+// Executes tasks on the calling thread until the given one, or everything if NULL, is done
+static GBL_RESULT GblMainLoop_help_(GblMainLoop* pSelf, GblTask* pTask) {
+    GblMainLoop_*       pSelf_  = GBL_MAIN_LOOP_(pSelf);
+    GblMainLoopWorker_* pWorker = GblMainLoop_worker_(pSelf);
+
+    GBL_CTX_BEGIN(NULL);
+
+    while(pTask? !GblTask_isDone(pTask) : atomic_load(&pSelf_->depth) != 0) {
+        GblTask* pNext = GblMainLoop_take_(pSelf, pWorker);
+
+        if(pNext) {
+            GblMainLoop_run_(pSelf, pWorker, pNext);
+            continue;
+        }
+
+        if(pWorker) {
+            thrd_yield();
+            continue;
+        }
+
+        GblMainLoop_reap_(pSelf);
+
+        mtx_lock(&pSelf_->mtx);
+        atomic_fetch_add(&pSelf_->waiters, 1);
+
+        if(!atomic_load(&pSelf_->queued) &&
+           (pTask? !GblTask_isDone(pTask) : atomic_load(&pSelf_->depth) != 0))
+            GblMainLoop_timedWait_(&pSelf_->doneCnd, &pSelf_->mtx, GBL_MAIN_LOOP_SLEEP_NSEC_);
+
+        atomic_fetch_sub(&pSelf_->waiters, 1);
+        mtx_unlock(&pSelf_->mtx);
+    }
+
+    if(!pWorker)
+        GblMainLoop_reap_(pSelf);
+
+    GBL_CTX_END();
+}
+
+GBL_RESULT GblMainLoop_wait_(GblMainLoop* pSelf, GblTask* pTask) {
+    return GblMainLoop_help_(pSelf, pTask);
+}
+
+static GBL_RESULT GblMainLoop_runWorker_(GblThread* pThread) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblMainLoopWorker_* pWorker = GblBox_userdata(GBL_BOX(pThread));
+    GblMainLoop*        pSelf   = pWorker->pLoop;
+    GblMainLoop_*       pSelf_  = GBL_MAIN_LOOP_(pSelf);
+    size_t              spins   = 0;
+
+    *GBL_TLS_LOAD(pCurWorker_) = pWorker;
+
+    while(!atomic_load(&pSelf_->stopping)) {
+        GblTask* pTask = GblMainLoop_take_(pSelf, pWorker);
+
+        if(pTask) {
+            GblMainLoop_run_(pSelf, pWorker, pTask);
+            spins = 0;
+        } else if(++spins < GBL_MAIN_LOOP_SPIN_COUNT_) {
+            thrd_yield();
+        } else {
+            mtx_lock(&pSelf_->mtx);
+            atomic_fetch_add(&pSelf_->sleepers, 1);
+
+            while(!atomic_load(&pSelf_->queued) && !atomic_load(&pSelf_->stopping))
+                cnd_wait(&pSelf_->workCnd, &pSelf_->mtx);
+
+            atomic_fetch_sub(&pSelf_->sleepers, 1);
+            mtx_unlock(&pSelf_->mtx);
+            spins = 0;
+        }
+    }
+
+    *GBL_TLS_LOAD(pCurWorker_) = NULL;
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblMainLoop_enqueueTask_(GblMainLoop* pSelf, GblTask* pTask) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblMainLoop_* pSelf_ = GBL_MAIN_LOOP_(pSelf);
+    GblTask_*     pTask_ = GBL_TASK_(pTask);
+
+    GBL_CTX_VERIFY(!pTask_->pLoop,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "Cannot enqueue task [%s] more than once!",
+                   GblObject_name(GBL_OBJECT(pTask)));
+
+    GBL_REF(pTask);
+
+    pTask_->pLoop    = pSelf;
+    pTask_->deadline = pTask_->timeout?
+                           GblMainLoop_now_() + (uint64_t)pTask_->timeout * 1000000ull : 0;
+
+    atomic_fetch_add(&pSelf_->depth, 1);
+
+    GBL_EMIT(pSelf, "taskEnqueued", pTask);
+
+    // drop the "not enqueued" count, queueing the task unless it's still waiting on prerequisites
+    GblMainLoop_release_(pTask);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblMainLoop_execTask_(GblMainLoop* pSelf, GblTask* pTask) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(NULL);
+
+    GblTask_* pTask_ = GBL_TASK_(pTask);
+    int       state  = GBL_TASK_STATE_QUEUED;
+
+    if(pTask_->deadline && GblMainLoop_now_() > pTask_->deadline) {
+        if(atomic_compare_exchange_strong(&pTask_->state, &state, GBL_TASK_STATE_TIMED_OUT))
+            GBL_VCALL(GblTask, pFnTimeout, pTask);
+
+    } else if(atomic_compare_exchange_strong(&pTask_->state, &state, GBL_TASK_STATE_RUNNING)) {
+        GblTask* pPrev = GblTask_setCurrent_(pTask);
+
+        pTask_->pOuter = pPrev;
+        pTask_->result = GBL_TASK_GET_CLASS(pTask)->pFnExec(pTask);
+        pTask_->pOuter = NULL;
+
+        GblTask_setCurrent_(pPrev);
+
+        atomic_store_explicit(&pTask_->state,
+                              atomic_load(&pTask_->canceled)?
+                                  GBL_TASK_STATE_CANCELED : GBL_TASK_STATE_FINISHED,
+                              memory_order_release);
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblMainLoop_cancelTask_(GblMainLoop* pSelf, GblTask* pTask) {
+    GBL_UNUSED(pSelf);
+    return GblTask_cancel(pTask);
+}
+
+static GBL_RESULT GblMainLoop_runSources_(GblMainLoop* pSelf, GblArrayList* pList, size_t index) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblMainLoop_*      pSelf_ = GBL_MAIN_LOOP_(pSelf);
+    GblMainLoopSource_ source  = *(GblMainLoopSource_*)GblArrayList_at(pList, index);
+
+    GBL_CTX_VERIFY_CALL(GblArrayList_erase(pList, index, 1));
+
+    pSelf_->dispatchingId   = source.id;
+    pSelf_->dispatchRemoved = GBL_FALSE;
+
+    // callbacks are free to add or remove sources
+    mtx_unlock(&pSelf_->mtx);
+    const GblBool keep = source.pFn(pSelf, source.pUserdata);
+    mtx_lock(&pSelf_->mtx);
+
+    pSelf_->dispatchingId = 0;
+
+    if(keep && !pSelf_->dispatchRemoved) {
+        if(source.interval) {
+            const uint64_t now = GblMainLoop_now_();
+
+            // skip any periods which were missed entirely
+            source.deadline += source.interval;
+            if(source.deadline <= now)
+                source.deadline = now + source.interval;
+
+            size_t t = 0;
+            while(t < GblArrayList_size(pList) &&
+                  ((GblMainLoopSource_*)GblArrayList_at(pList, t))->deadline <= source.deadline)
+                ++t;
+
+            GBL_CTX_VERIFY(GblArrayList_insert(pList, t, 1, &source),
+                           GBL_RESULT_ERROR_MEM_ALLOC);
+        } else {
+            // idle sources are kept sorted by ID
+            size_t i = 0;
+            while(i < GblArrayList_size(pList) &&
+                  ((GblMainLoopSource_*)GblArrayList_at(pList, i))->id < source.id)
+                ++i;
+
+            GBL_CTX_VERIFY(GblArrayList_insert(pList, i, 1, &source),
+                           GBL_RESULT_ERROR_MEM_ALLOC);
+        }
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblMainLoop_dispatchTimers_(GblMainLoop* pSelf, GblBool* pBusy) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblMainLoop_*  pSelf_ = GBL_MAIN_LOOP_(pSelf);
+    const uint64_t now    = GblMainLoop_now_();
+
+    mtx_lock(&pSelf_->mtx);
+
+    // re-armed timers are always due in the future, so this can't spin
+    while(GblArrayList_size(&pSelf_->timers) &&
+          ((GblMainLoopSource_*)GblArrayList_front(&pSelf_->timers))->deadline <= now)
+    {
+        *pBusy = GBL_TRUE;
+        GBL_CTX_CALL(GblMainLoop_runSources_(pSelf, &pSelf_->timers, 0));
+    }
+
+    mtx_unlock(&pSelf_->mtx);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblMainLoop_execIdle_(GblMainLoop* pSelf) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblMainLoop_* pSelf_ = GBL_MAIN_LOOP_(pSelf);
+    size_t        lastId = 0;
+
+    mtx_lock(&pSelf_->mtx);
+
+    // walk by ID rather than index, since the list can change under each callback
+    for(;;) {
+        size_t i = 0;
+
+        while(i < GblArrayList_size(&pSelf_->idlers) &&
+              ((GblMainLoopSource_*)GblArrayList_at(&pSelf_->idlers, i))->id <= lastId)
+            ++i;
+
+        if(i >= GblArrayList_size(&pSelf_->idlers))
+            break;
+
+        lastId = ((GblMainLoopSource_*)GblArrayList_at(&pSelf_->idlers, i))->id;
+
+        GBL_CTX_CALL(GblMainLoop_runSources_(pSelf, &pSelf_->idlers, i));
+    }
+
+    mtx_unlock(&pSelf_->mtx);
+
+    GBL_EMIT(pSelf, "execIdle");
+
+    GBL_CTX_END();
+}
+
+static size_t GblMainLoop_addSource_(GblMainLoop* pSelf, GblArrayList* pList, GblMainLoopSource_* pSource) {
+    GblMainLoop_* pSelf_ = GBL_MAIN_LOOP_(pSelf);
+    size_t        id     = 0;
+    size_t        i      = 0;
+
+    mtx_lock(&pSelf_->mtx);
+
+    pSource->id = pSelf_->nextSourceId;
+
+    // timers are sorted by deadline, idle sources by ID
+    if(pSource->interval)
+        while(i < GblArrayList_size(pList) &&
+              ((GblMainLoopSource_*)GblArrayList_at(pList, i))->deadline <= pSource->deadline)
+            ++i;
+    else
+        i = GblArrayList_size(pList);
+
+    if(GblArrayList_insert(pList, i, 1, pSource)) {
+        id = pSelf_->nextSourceId++;
+        // wake up GblMainLoop_exec() in case it's sleeping past the new source
+        cnd_broadcast(&pSelf_->doneCnd);
+    }
+
+    mtx_unlock(&pSelf_->mtx);
+
+    return id;
+}
+
+GBL_EXPORT size_t GblMainLoop_addTimer(GblMainLoop*  pSelf,
+                                       uint32_t      msec,
+                                       GblMainLoopFn pFn,
+                                       void*         pUserdata)
+{
+    size_t id = 0;
+
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY_POINTER(pFn);
+
+    GblMainLoopSource_ source = {
+        .interval  = (msec? msec : 1) * 1000000ull,
+        .pFn       = pFn,
+        .pUserdata = pUserdata
+    };
+
+    source.deadline = GblMainLoop_now_() + source.interval;
+
+    id = GblMainLoop_addSource_(pSelf, &GBL_MAIN_LOOP_(pSelf)->timers, &source);
+
+    GBL_CTX_VERIFY(id,
+                   GBL_RESULT_ERROR_MEM_ALLOC,
+                   "Failed to add timer to loop [%s]",
+                   GblObject_name(GBL_OBJECT(pSelf)));
+
+    GBL_CTX_END_BLOCK();
+
+    return id;
+}
+
+GBL_EXPORT size_t GblMainLoop_addIdle(GblMainLoop*  pSelf,
+                                      GblMainLoopFn pFn,
+                                      void*         pUserdata)
+{
+    size_t id = 0;
+
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY_POINTER(pFn);
+
+    GblMainLoopSource_ source = {
+        .pFn       = pFn,
+        .pUserdata = pUserdata
+    };
+
+    id = GblMainLoop_addSource_(pSelf, &GBL_MAIN_LOOP_(pSelf)->idlers, &source);
+
+    GBL_CTX_VERIFY(id,
+                   GBL_RESULT_ERROR_MEM_ALLOC,
+                   "Failed to add idle source to loop [%s]",
+                   GblObject_name(GBL_OBJECT(pSelf)));
+
+    GBL_CTX_END_BLOCK();
+
+    return id;
+}
+
+GBL_EXPORT GblBool GblMainLoop_removeSource(GblMainLoop* pSelf, size_t id) {
+    GblMainLoop_* pSelf_  = GBL_MAIN_LOOP_(pSelf);
+    GblBool       removed = GBL_FALSE;
+
+    mtx_lock(&pSelf_->mtx);
+
+    if(id && id == pSelf_->dispatchingId) {
+        // currently out of the list, it just won't be put back
+        removed = !pSelf_->dispatchRemoved;
+        pSelf_->dispatchRemoved = GBL_TRUE;
+    } else {
+        GblArrayList* lists[] = { &pSelf_->timers, &pSelf_->idlers };
+
+        for(size_t l = 0; l < GBL_COUNT_OF(lists) && !removed; ++l) {
+            for(size_t i = 0; i < GblArrayList_size(lists[l]); ++i) {
+                if(((GblMainLoopSource_*)GblArrayList_at(lists[l], i))->id == id) {
+                    removed = GBL_RESULT_SUCCESS(GblArrayList_erase(lists[l], i, 1));
+                    break;
+                }
+            }
+        }
+    }
+
+    mtx_unlock(&pSelf_->mtx);
+
+    return removed;
+}
+
+static GBL_RESULT GblMainLoop_iterate_(GblMainLoop* pSelf, GblBool* pBusy) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblMainLoop_* pSelf_ = GBL_MAIN_LOOP_(pSelf);
+
+    GblMainLoop_reap_(pSelf);
+
+    if(GblThread_processEvents(0))
+        *pBusy = GBL_TRUE;
+
+    GBL_CTX_VERIFY_CALL(GblMainLoop_dispatchTimers_(pSelf, pBusy));
+
+    // without workers, this thread is the one executing tasks
+    if(!pSelf_->workerCount) {
+        GblTask* pTask;
+        size_t   budget = GBL_MAIN_LOOP_ITERATION_BUDGET_;
+
+        while(budget-- && (pTask = GblMainLoop_take_(pSelf, NULL))) {
+            GblMainLoop_run_(pSelf, NULL, pTask);
+            *pBusy = GBL_TRUE;
+        }
+
+        GblMainLoop_reap_(pSelf);
+    }
+
+    if(!*pBusy)
+        GBL_VCALL(GblMainLoop, pFnExecIdle, pSelf);
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblMainLoop_iteration(GblMainLoop* pSelf) {
+    GblBool busy = GBL_FALSE;
+    return GblMainLoop_iterate_(pSelf, &busy);
+}
+
+GBL_EXPORT GBL_RESULT GblMainLoop_exec(GblMainLoop* pSelf) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblMainLoop_* pSelf_ = GBL_MAIN_LOOP_(pSelf);
+
+    GBL_CTX_VERIFY(!atomic_exchange(&pSelf_->running, GBL_TRUE),
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "Loop [%s] is already running!",
+                   GblObject_name(GBL_OBJECT(pSelf)));
+
+    GblObject_emitPropertyChange(GBL_OBJECT(pSelf), "running");
+
+    while(!atomic_exchange(&pSelf_->stopRequested, GBL_FALSE)) {
+        GblBool busy = GBL_FALSE;
+
+        GBL_CTX_CALL(GblMainLoop_iterate_(pSelf, &busy));
+
+        if(busy) continue;
+
+        mtx_lock(&pSelf_->mtx);
+
+        // sleep until the next timer, bounded so that posted thread events get noticed
+        uint64_t sleep = GblArrayList_size(&pSelf_->idlers)? 0 : GBL_MAIN_LOOP_SLEEP_NSEC_;
+
+        if(sleep && GblArrayList_size(&pSelf_->timers)) {
+            const uint64_t deadline = ((GblMainLoopSource_*)GblArrayList_front(&pSelf_->timers))->deadline;
+            const uint64_t now      = GblMainLoop_now_();
+
+            sleep = deadline <= now? 0 : GBL_MIN(sleep, deadline - now);
+        }
+
+        if(sleep && !atomic_load(&pSelf_->stopRequested) &&
+           !(!pSelf_->workerCount && atomic_load(&pSelf_->queued)))
+        {
+            atomic_fetch_add(&pSelf_->waiters, 1);
+            GblMainLoop_timedWait_(&pSelf_->doneCnd, &pSelf_->mtx, sleep);
+            atomic_fetch_sub(&pSelf_->waiters, 1);
+        }
+
+        mtx_unlock(&pSelf_->mtx);
+    }
+
+    atomic_store(&pSelf_->running, GBL_FALSE);
+
+    GblObject_emitPropertyChange(GBL_OBJECT(pSelf), "running");
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblMainLoop_stop(GblMainLoop* pSelf) {
+    GblMainLoop_* pSelf_ = GBL_MAIN_LOOP_(pSelf);
+
+    mtx_lock(&pSelf_->mtx);
+    atomic_store(&pSelf_->stopRequested, GBL_TRUE);
+    cnd_broadcast(&pSelf_->doneCnd);
+    mtx_unlock(&pSelf_->mtx);
+
+    return GBL_RESULT_SUCCESS;
+}
+
+GBL_EXPORT GblBool GblMainLoop_isRunning(const GblMainLoop* pSelf) {
+    return atomic_load(&GBL_MAIN_LOOP_(pSelf)->running);
+}
+
+GBL_EXPORT GblMainLoop* GblMainLoop_create(size_t workerCount) {
+    return GBL_NEW(GblMainLoop,
+                   "workerCount", workerCount);
+}
+
+GBL_EXPORT GblMainLoop* GblMainLoop_ref(const GblMainLoop* pSelf) {
+    return GBL_MAIN_LOOP(GBL_REF(pSelf));
+}
+
+GBL_EXPORT GblRefCount GblMainLoop_unref(GblMainLoop* pSelf) {
+    return GBL_UNREF(pSelf);
+}
+
+GBL_EXPORT GBL_RESULT GblMainLoop_enqueue(GblMainLoop* pSelf, GblTask* pTask) {
+    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_VERIFY_POINTER(pTask);
+    GBL_VCALL(GblMainLoop, pFnEnqueueTask, pSelf, pTask);
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblMainLoop_cancel(GblMainLoop* pSelf, GblTask* pTask) {
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY_POINTER(pTask);
+
+    GBL_CTX_VERIFY(GBL_TASK_(pTask)->pLoop == pSelf,
+                   GBL_RESULT_ERROR_INVALID_ARG,
+                   "Task [%s] was not enqueued on loop [%s]!",
+                   GblObject_name(GBL_OBJECT(pTask)),
+                   GblObject_name(GBL_OBJECT(pSelf)));
+
+    GBL_VCALL(GblMainLoop, pFnCancelTask, pSelf, pTask);
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblMainLoop_waitAll(GblMainLoop* pSelf) {
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY(!GblMainLoop_worker_(pSelf),
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "Cannot wait on every task of loop [%s] from one of its own tasks!",
+                   GblObject_name(GBL_OBJECT(pSelf)));
+
+    GBL_CTX_VERIFY_CALL(GblMainLoop_help_(pSelf, NULL));
+
+    /* Let the workers which finished the last tasks return, so everything
+       gets released, unless another thread outside of the pool (or this
+       one, further up the stack) is still executing one. */
+    while((GBL_MAIN_LOOP_(pSelf)->pLimbo ||
+           atomic_load(&GBL_MAIN_LOOP_(pSelf)->pRetired)) &&
+          !atomic_load(&GBL_MAIN_LOOP_(pSelf)->helping))
+    {
+        thrd_yield();
+        GblMainLoop_reap_(pSelf);
+    }
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT size_t GblMainLoop_depth(const GblMainLoop* pSelf) {
+    return atomic_load(&GBL_MAIN_LOOP_(pSelf)->depth);
+}
+
+GBL_EXPORT size_t GblMainLoop_workerCount(const GblMainLoop* pSelf) {
+    return GBL_MAIN_LOOP_(pSelf)->workerCount;
+}
+
+static GBL_RESULT GblMainLoop_GblObject_constructed_(GblObject* pObject) {
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_VCALL_DEFAULT(GblObject, pFnConstructed, pObject);
+
+    GblMainLoop*  pSelf  = GBL_MAIN_LOOP(pObject);
+    GblMainLoop_* pSelf_ = GBL_MAIN_LOOP_(pSelf);
+
+    if(!pSelf_->workerCount)
+        GBL_CTX_DONE();
+
+    pSelf_->pWorkers     = GBL_CTX_MALLOC(sizeof(GblMainLoopWorker_) * pSelf_->workerCount);
+    pSelf_->pLimboEpochs = GBL_CTX_MALLOC(sizeof(size_t) * pSelf_->workerCount);
+
+    // every deque has to exist before any worker starts stealing
+    for(size_t w = 0; w < pSelf_->workerCount; ++w) {
+        GblMainLoopWorker_* pWorker = &pSelf_->pWorkers[w];
+
+        for(size_t l = 0; l < GBL_PRIORITY_COUNT; ++l)
+            GBL_CTX_VERIFY_CALL(GblTaskDeque_construct_(&pWorker->deques[l]));
+
+        pWorker->pLoop   = pSelf;
+        pWorker->nesting = 0;
+        pWorker->seed    = 2463534242u + (uint32_t)w * 2654435761u;
+        atomic_init(&pWorker->epoch, 0);
+    }
+
+    for(size_t w = 0; w < pSelf_->workerCount; ++w) {
+        GblMainLoopWorker_* pWorker = &pSelf_->pWorkers[w];
+
+        pWorker->pThread = GblThread_create(GblMainLoop_runWorker_, pWorker, GBL_FALSE);
+
+        GblObject_setName(GBL_OBJECT(pWorker->pThread), "GblMainLoop worker");
+
+        GBL_CTX_VERIFY_CALL(GblThread_start(pWorker->pThread));
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblMainLoop_GblObject_setProperty_(GblObject* pObject, const GblProperty* pProp, GblVariant* pValue) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblMainLoop* pSelf = GBL_MAIN_LOOP(pObject);
+
+    switch(pProp->id) {
+    case GblMainLoop_Property_Id_workerCount:
+        GBL_MAIN_LOOP_(pSelf)->workerCount = GblVariant_toSize(pValue); break;
+    default:
+        GBL_CTX_RECORD_SET(GBL_RESULT_ERROR_INVALID_PROPERTY,
+                           "Failed to set property %s for type %s",
+                           GblProperty_name(pProp), GblType_name(GBL_TYPEOF(pSelf)));
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblMainLoop_GblObject_property_(const GblObject* pObject, const GblProperty* pProp, GblVariant* pValue) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblMainLoop* pSelf = GBL_MAIN_LOOP(pObject);
+
+    switch(pProp->id) {
+    case GblMainLoop_Property_Id_workerCount:
+        GblVariant_setSize(pValue, GblMainLoop_workerCount(pSelf)); break;
+    case GblMainLoop_Property_Id_depth:
+        GblVariant_setSize(pValue, GblMainLoop_depth(pSelf)); break;
+    case GblMainLoop_Property_Id_running:
+        GblVariant_setBool(pValue, GblMainLoop_isRunning(pSelf)); break;
+    default:
+        GBL_CTX_RECORD_SET(GBL_RESULT_ERROR_INVALID_PROPERTY,
+                           "Failed to get property %s for type %s",
+                           GblProperty_name(pProp), GblType_name(GBL_TYPEOF(pSelf)));
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblMainLoop_GblBox_destructor_(GblBox* pBox) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblMainLoop*  pSelf  = GBL_MAIN_LOOP(pBox);
+    GblMainLoop_* pSelf_ = GBL_MAIN_LOOP_(pSelf);
+
+    GBL_CTX_CALL(GblMainLoop_help_(pSelf, NULL));
+
+    mtx_lock(&pSelf_->mtx);
+    atomic_store(&pSelf_->stopping, GBL_TRUE);
+    cnd_broadcast(&pSelf_->workCnd);
+    mtx_unlock(&pSelf_->mtx);
+
+    for(size_t w = 0; w < pSelf_->workerCount && pSelf_->pWorkers; ++w) {
+        GblMainLoopWorker_* pWorker = &pSelf_->pWorkers[w];
+
+        if(pWorker->pThread) {
+            GblThread_join(pWorker->pThread);
+            GBL_UNREF(pWorker->pThread);
+        }
+    }
+
+    // nothing else is running anymore
+    GblMainLoop_releaseTasks_(pSelf_->pLimbo);
+    GblMainLoop_releaseTasks_(atomic_exchange(&pSelf_->pRetired, NULL));
+
+    for(size_t w = 0; w < pSelf_->workerCount && pSelf_->pWorkers; ++w)
+        for(size_t l = 0; l < GBL_PRIORITY_COUNT; ++l)
+            GblTaskDeque_destruct_(&pSelf_->pWorkers[w].deques[l]);
+
+    GBL_CTX_FREE(pSelf_->pWorkers);
+    GBL_CTX_FREE(pSelf_->pLimboEpochs);
+
+    GblArrayList_destruct(&pSelf_->timers);
+    GblArrayList_destruct(&pSelf_->idlers);
+
+    cnd_destroy(&pSelf_->doneCnd);
+    cnd_destroy(&pSelf_->workCnd);
+    mtx_destroy(&pSelf_->reapMtx);
+    mtx_destroy(&pSelf_->mtx);
+
+    GBL_VCALL_DEFAULT(GblObject, base.pFnDestructor, pBox);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblMainLoop_initialize_(GblInstance* pInstance) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblMainLoop_* pSelf_ = GBL_MAIN_LOOP_(GBL_MAIN_LOOP(pInstance));
+
+    mtx_init(&pSelf_->mtx,     mtx_plain);
+    mtx_init(&pSelf_->reapMtx, mtx_plain);
+    cnd_init(&pSelf_->workCnd);
+    cnd_init(&pSelf_->doneCnd);
+
+    atomic_init(&pSelf_->injectMask,    0);
+    atomic_init(&pSelf_->queued,        0);
+    atomic_init(&pSelf_->depth,         0);
+    atomic_init(&pSelf_->sleepers,      0);
+    atomic_init(&pSelf_->waiters,       0);
+    atomic_init(&pSelf_->helping,       0);
+    atomic_init(&pSelf_->pRetired,      NULL);
+    atomic_init(&pSelf_->stopping,      GBL_FALSE);
+    atomic_init(&pSelf_->stopRequested, GBL_FALSE);
+    atomic_init(&pSelf_->running,       GBL_FALSE);
+
+    pSelf_->nextSourceId = 1;
+
+    GBL_CTX_VERIFY_CALL(GblArrayList_construct(&pSelf_->timers, sizeof(GblMainLoopSource_)));
+    GBL_CTX_VERIFY_CALL(GblArrayList_construct(&pSelf_->idlers, sizeof(GblMainLoopSource_)));
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblMainLoopClass_initialize_(GblClass* pClass, const void* pUd) {
+    GBL_UNUSED(pUd);
+    GBL_CTX_BEGIN(NULL);
+
+    if(!GblType_classRefCount(GBL_MAIN_LOOP_TYPE)) {
+        GBL_PROPERTIES_REGISTER(GblMainLoop);
+
+        GblSignal_install(GBL_MAIN_LOOP_TYPE,
+                          "execIdle",
+                          GblMarshal_CClosure_VOID__INSTANCE,
+                          0);
+
+        GblSignal_install(GBL_MAIN_LOOP_TYPE,
+                          "taskEnqueued",
+                          GblMarshal_CClosure_VOID__INSTANCE_POINTER,
+                          1,
+                          GBL_POINTER_TYPE);
+    }
+
+    GBL_BOX_CLASS(pClass)      ->pFnDestructor  = GblMainLoop_GblBox_destructor_;
+    GBL_OBJECT_CLASS(pClass)   ->pFnConstructed = GblMainLoop_GblObject_constructed_;
+    GBL_OBJECT_CLASS(pClass)   ->pFnProperty    = GblMainLoop_GblObject_property_;
+    GBL_OBJECT_CLASS(pClass)   ->pFnSetProperty = GblMainLoop_GblObject_setProperty_;
+    GBL_MAIN_LOOP_CLASS(pClass)->pFnEnqueueTask = GblMainLoop_enqueueTask_;
+    GBL_MAIN_LOOP_CLASS(pClass)->pFnExecTask    = GblMainLoop_execTask_;
+    GBL_MAIN_LOOP_CLASS(pClass)->pFnCancelTask  = GblMainLoop_cancelTask_;
+    GBL_MAIN_LOOP_CLASS(pClass)->pFnExecIdle    = GblMainLoop_execIdle_;
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GblType GblMainLoop_type(void) {
+    static GblType type = GBL_INVALID_TYPE;
+
+    static const GblTypeInfo info = {
+        .classSize           = sizeof(GblMainLoopClass),
+        .pFnClassInit        = GblMainLoopClass_initialize_,
+        .instanceSize        = sizeof(GblMainLoop),
+        .instancePrivateSize = sizeof(GblMainLoop_),
+        .pFnInstanceInit     = GblMainLoop_initialize_
+    };
+
+    if GBL_UNLIKELY(type == GBL_INVALID_TYPE) {
+        type = GblType_register(GblQuark_internStatic("GblMainLoop"),
+                                GBL_OBJECT_TYPE,
+                                &info,
+                                GBL_TYPE_FLAG_TYPEINFO_STATIC |
+                                GBL_TYPE_FLAG_CLASS_PINNED);
+    }
+
+    return type;
+}
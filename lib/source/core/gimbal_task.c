@@ -0,0 +1,361 @@
+#include <gimbal/core/gimbal_task.h>
+#include <gimbal/core/gimbal_main_loop.h>
+#include <gimbal/core/gimbal_tls.h>
+#include "gimbal_task_.h"
+
+#define GBL_TASK_LINK_LOCK_(self_)     while(atomic_flag_test_and_set_explicit(&(self_)->linkLock, memory_order_acquire))
+#define GBL_TASK_LINK_UNLOCK_(self_)   atomic_flag_clear_explicit(&(self_)->linkLock, memory_order_release)
+
+GBL_TLS(GblTask*, pCurTask_, NULL);
+
+GblTask* GblTask_setCurrent_(GblTask* pTask) {
+    GblTask* pPrev = *GBL_TLS_LOAD(pCurTask_);
+    *GBL_TLS_LOAD(pCurTask_) = pTask;
+    return pPrev;
+}
+
+GBL_EXPORT GblTask* GblTask_current(void) {
+    return *GBL_TLS_LOAD(pCurTask_);
+}
+
+GBL_EXPORT GblTask* (GblTask_create)(GblTaskFn pCallback, void* pUserdata) {
+    // tasks are created at a high rate, so skip the by-name property lookups
+    GblTask* pTask = GBL_NEW(GblTask);
+
+    GblTask_setCallback(pTask, pCallback);
+    GblBox_setUserdata(GBL_BOX(pTask), pUserdata);
+
+    return pTask;
+}
+
+GBL_EXPORT GblTask* GblTask_ref(const GblTask* pSelf) {
+    return GBL_TASK(GBL_REF(pSelf));
+}
+
+GBL_EXPORT GblRefCount GblTask_unref(GblTask* pSelf) {
+    return GBL_UNREF(pSelf);
+}
+
+GBL_EXPORT GblTaskFn GblTask_callback(const GblTask* pSelf) {
+    return GBL_TASK_(pSelf)->pFnCallback;
+}
+
+GBL_EXPORT void GblTask_setCallback(GblTask* pSelf, GblTaskFn pCb) {
+    GBL_TASK_(pSelf)->pFnCallback = pCb;
+}
+
+GBL_EXPORT GblPriority GblTask_priority(const GblTask* pSelf) {
+    GblPriority priority = GBL_PRIORITY_DEFAULT;
+
+    GBL_CTX_BEGIN(NULL);
+    GBL_VCALL(GblTask, pFnPriority, pSelf, &priority);
+    GBL_CTX_END_BLOCK();
+
+    return priority;
+}
+
+GBL_EXPORT void GblTask_setPriority(GblTask* pSelf, GblPriority priority) {
+    GBL_TASK_(pSelf)->priority = priority;
+}
+
+GBL_EXPORT uint32_t GblTask_timeout(const GblTask* pSelf) {
+    return GBL_TASK_(pSelf)->timeout;
+}
+
+GBL_EXPORT GBL_RESULT GblTask_setTimeout(GblTask* pSelf, uint32_t msec) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblTask_* pSelf_ = GBL_TASK_(pSelf);
+
+    // the deadline is computed when the task is enqueued
+    GBL_CTX_VERIFY(!pSelf_->pLoop,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "Cannot change the timeout of task [%s] after it has been enqueued!",
+                   GblObject_name(GBL_OBJECT(pSelf)));
+
+    pSelf_->timeout = msec;
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_TASK_STATE GblTask_state(const GblTask* pSelf) {
+    return atomic_load_explicit(&GBL_TASK_(pSelf)->state, memory_order_acquire);
+}
+
+GBL_EXPORT GBL_RESULT GblTask_result(const GblTask* pSelf) {
+    // result is published by the release store of the terminal state
+    return GblTask_state(pSelf) == GBL_TASK_STATE_FINISHED?
+               GBL_TASK_(pSelf)->result : GBL_RESULT_UNKNOWN;
+}
+
+GBL_EXPORT GblBool GblTask_isDone(const GblTask* pSelf) {
+    return GblTask_state(pSelf) >= GBL_TASK_STATE_FINISHED;
+}
+
+GBL_EXPORT GblBool GblTask_isCanceled(const GblTask* pSelf) {
+    return atomic_load_explicit(&GBL_TASK_(pSelf)->canceled, memory_order_relaxed);
+}
+
+GBL_EXPORT GBL_RESULT GblTask_then(GblTask* pSelf, GblTask* pContinuation) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblTask_* pSelf_ = GBL_TASK_(pSelf);
+    GblTask_* pNext_ = GBL_TASK_(pContinuation);
+
+    GBL_CTX_VERIFY_POINTER(pContinuation);
+
+    GBL_CTX_VERIFY(pSelf != pContinuation,
+                   GBL_RESULT_ERROR_INVALID_ARG,
+                   "Cannot chain task [%s] after itself!",
+                   GblObject_name(GBL_OBJECT(pSelf)));
+
+    GBL_CTX_VERIFY(!pNext_->pLoop,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "Cannot chain task [%s] after it has already been enqueued!",
+                   GblObject_name(GBL_OBJECT(pContinuation)));
+
+    // allocate outside of the spinlock
+    GblTaskLink_* pLink = GBL_CTX_MALLOC(sizeof(GblTaskLink_));
+
+    GBL_TASK_LINK_LOCK_(pSelf_);
+
+    if(pSelf_->linksClosed) {
+        const GblBool failed = pSelf_->failed;
+        GBL_TASK_LINK_UNLOCK_(pSelf_);
+
+        // prerequisite is already done, so there's nothing to wait on
+        GBL_CTX_FREE(pLink);
+
+        if(failed)
+            GblTask_cancel(pContinuation);
+
+    } else {
+        atomic_fetch_add_explicit(&pNext_->pending, 1, memory_order_relaxed);
+
+        pLink->pTask   = GBL_REF(pContinuation);
+        pLink->pNext   = pSelf_->pLinks;
+        pSelf_->pLinks = pLink;
+
+        GBL_TASK_LINK_UNLOCK_(pSelf_);
+    }
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblTask_cancel(GblTask* pSelf) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblTask_* pSelf_ = GBL_TASK_(pSelf);
+
+    atomic_store_explicit(&pSelf_->canceled, GBL_TRUE, memory_order_relaxed);
+
+    int state = atomic_load_explicit(&pSelf_->state, memory_order_acquire);
+
+    /* Tasks which haven't started are canceled outright, and the loop
+       completes them as soon as it comes across them. */
+    while(state <= GBL_TASK_STATE_QUEUED) {
+        if(atomic_compare_exchange_weak_explicit(&pSelf_->state,
+                                                 &state,
+                                                 GBL_TASK_STATE_CANCELED,
+                                                 memory_order_acq_rel,
+                                                 memory_order_acquire))
+            break;
+    }
+
+    GBL_CTX_VERIFY(state <= GBL_TASK_STATE_RUNNING,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "Cannot cancel task [%s] which is already done!",
+                   GblObject_name(GBL_OBJECT(pSelf)));
+
+    // a running task has only been flagged, its state is resolved once it returns
+    GBL_VCALL(GblTask, pFnCancel, pSelf);
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblTask_wait(GblTask* pSelf) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblTask_* pSelf_ = GBL_TASK_(pSelf);
+
+    GBL_CTX_VERIFY(pSelf_->pLoop,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "Cannot wait on task [%s] which was never enqueued!",
+                   GblObject_name(GBL_OBJECT(pSelf)));
+
+    GBL_CTX_VERIFY(pSelf != GblTask_current(),
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "Task [%s] cannot wait on itself!",
+                   GblObject_name(GBL_OBJECT(pSelf)));
+
+    /* A waiting thread helps by running other tasks, which suspends the
+       ones beneath them; those can't finish before the helping task does. */
+    for(GblTask* pOuter = GblTask_current(); pOuter; pOuter = GBL_TASK_(pOuter)->pOuter)
+        GBL_CTX_VERIFY(pOuter != pSelf,
+                       GBL_RESULT_ERROR_INVALID_OPERATION,
+                       "Task [%s] cannot be waited on by a task it's suspended beneath!",
+                       GblObject_name(GBL_OBJECT(pSelf)));
+
+    GBL_CTX_VERIFY_CALL(GblMainLoop_wait_(pSelf_->pLoop, pSelf));
+
+    switch(GblTask_state(pSelf)) {
+    case GBL_TASK_STATE_FINISHED:
+        GBL_CTX_RESULT() = pSelf_->result;      break;
+    case GBL_TASK_STATE_TIMED_OUT:
+        GBL_CTX_RESULT() = GBL_RESULT_TIMEOUT;  break;
+    default:
+        GBL_CTX_RESULT() = GBL_RESULT_INCOMPLETE;
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblTask_exec_(GblTask* pSelf) {
+    GblTaskFn pCallback = GblTask_callback(pSelf);
+
+    return pCallback? pCallback(pSelf) : GBL_RESULT_UNIMPLEMENTED;
+}
+
+static GBL_RESULT GblTask_cancel_(GblTask* pSelf) {
+    GBL_UNUSED(pSelf);
+    return GBL_RESULT_SUCCESS;
+}
+
+static GBL_RESULT GblTask_timeout_(GblTask* pSelf) {
+    GBL_UNUSED(pSelf);
+    return GBL_RESULT_SUCCESS;
+}
+
+static GBL_RESULT GblTask_priority_(const GblTask* pSelf, GblPriority* pPriority) {
+    *pPriority = GBL_TASK_(pSelf)->priority;
+    return GBL_RESULT_SUCCESS;
+}
+
+static GBL_RESULT GblTask_GblObject_setProperty_(GblObject* pObject, const GblProperty* pProp, GblVariant* pValue) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblTask* pSelf = GBL_TASK(pObject);
+
+    switch(pProp->id) {
+    case GblTask_Property_Id_priority:
+        GblTask_setPriority(pSelf, GblVariant_toInt16(pValue)); break;
+    case GblTask_Property_Id_timeout:
+        GBL_CTX_VERIFY_CALL(GblTask_setTimeout(pSelf, GblVariant_toUint32(pValue))); break;
+    case GblTask_Property_Id_callback:
+        GblTask_setCallback(pSelf, (GblTaskFn)GblVariant_toPointer(pValue)); break;
+    default:
+        GBL_CTX_RECORD_SET(GBL_RESULT_ERROR_INVALID_PROPERTY,
+                           "Failed to set property %s for type %s",
+                           GblProperty_name(pProp), GblType_name(GBL_TYPEOF(pSelf)));
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblTask_GblObject_property_(const GblObject* pObject, const GblProperty* pProp, GblVariant* pValue) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblTask* pSelf = GBL_TASK(pObject);
+
+    switch(pProp->id) {
+    case GblTask_Property_Id_state:
+        GblVariant_setEnum(pValue, GBL_ENUM_TYPE, GblTask_state(pSelf)); break;
+    case GblTask_Property_Id_result:
+        GblVariant_setEnum(pValue, GBL_ENUM_TYPE, GblTask_result(pSelf)); break;
+    case GblTask_Property_Id_priority:
+        GblVariant_setInt16(pValue, GblTask_priority(pSelf)); break;
+    case GblTask_Property_Id_timeout:
+        GblVariant_setUint32(pValue, GblTask_timeout(pSelf)); break;
+    case GblTask_Property_Id_callback:
+        GblVariant_setPointer(pValue, GBL_POINTER_TYPE, (void*)GblTask_callback(pSelf)); break;
+    default:
+        GBL_CTX_RECORD_SET(GBL_RESULT_ERROR_INVALID_PROPERTY,
+                           "Failed to get property %s for type %s",
+                           GblProperty_name(pProp), GblType_name(GBL_TYPEOF(pSelf)));
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblTask_GblBox_destructor_(GblBox* pBox) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblTask_*     pSelf_ = GBL_TASK_(GBL_TASK(pBox));
+    GblTaskLink_* pLink  = pSelf_->pLinks;
+
+    /* Only a task which never completed still has live links, since
+       the loop releases them along with its own reference. Nothing will
+       ever run it now, so its continuations can't either. */
+    while(pLink) {
+        GblTaskLink_* pNext = pLink->pNext;
+
+        if(!pSelf_->linksClosed) {
+            GblTask_cancel(pLink->pTask);
+            GblMainLoop_release_(pLink->pTask);
+        }
+
+        GBL_UNREF(pLink->pTask);
+        GBL_CTX_FREE(pLink);
+        pLink = pNext;
+    }
+
+    GBL_VCALL_DEFAULT(GblObject, base.pFnDestructor, pBox);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblTask_initialize_(GblInstance* pInstance) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblTask_* pSelf_ = GBL_TASK_(GBL_TASK(pInstance));
+
+    atomic_init(&pSelf_->state,    GBL_TASK_STATE_PENDING);
+    atomic_init(&pSelf_->pending,  1);
+    atomic_init(&pSelf_->canceled, GBL_FALSE);
+    atomic_flag_clear(&pSelf_->linkLock);
+
+    pSelf_->result   = GBL_RESULT_UNKNOWN;
+    pSelf_->priority = GBL_PRIORITY_DEFAULT;
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblTaskClass_initialize_(GblClass* pClass, const void* pUd) {
+    GBL_UNUSED(pUd);
+    GBL_CTX_BEGIN(NULL);
+
+    if(!GblType_classRefCount(GBL_TASK_TYPE))
+        GBL_PROPERTIES_REGISTER(GblTask);
+
+    GBL_BOX_CLASS(pClass)   ->pFnDestructor  = GblTask_GblBox_destructor_;
+    GBL_OBJECT_CLASS(pClass)->pFnProperty    = GblTask_GblObject_property_;
+    GBL_OBJECT_CLASS(pClass)->pFnSetProperty = GblTask_GblObject_setProperty_;
+    GBL_TASK_CLASS(pClass)  ->pFnExec        = GblTask_exec_;
+    GBL_TASK_CLASS(pClass)  ->pFnCancel      = GblTask_cancel_;
+    GBL_TASK_CLASS(pClass)  ->pFnTimeout     = GblTask_timeout_;
+    GBL_TASK_CLASS(pClass)  ->pFnPriority    = GblTask_priority_;
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GblType GblTask_type(void) {
+    static GblType type = GBL_INVALID_TYPE;
+
+    static const GblTypeInfo info = {
+        .classSize           = sizeof(GblTaskClass),
+        .pFnClassInit        = GblTaskClass_initialize_,
+        .instanceSize        = sizeof(GblTask),
+        .instancePrivateSize = sizeof(GblTask_),
+        .pFnInstanceInit     = GblTask_initialize_
+    };
+
+    if GBL_UNLIKELY(type == GBL_INVALID_TYPE) {
+        type = GblType_register(GblQuark_internStatic("GblTask"),
+                                GBL_OBJECT_TYPE,
+                                &info,
+                                GBL_TYPE_FLAG_TYPEINFO_STATIC |
+                                GBL_TYPE_FLAG_CLASS_PINNED);
+    }
+
+    return type;
+}
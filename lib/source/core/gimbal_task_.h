@@ -0,0 +1,50 @@
+#ifndef GIMBAL_TASK__H
+#define GIMBAL_TASK__H
+
+#include <gimbal/core/gimbal_task.h>
+#include <gimbal/core/gimbal_main_loop.h>
+
+#include <stdatomic.h>
+
+#define GBL_TASK_(self)     (GBL_PRIVATE(GblTask, self))
+
+GBL_DECLS_BEGIN
+
+// Continuation which is released once its prerequisite completes
+GBL_DECLARE_STRUCT(GblTaskLink_) {
+    GblTaskLink_* pNext;
+    GblTask*      pTask;    // holds a reference taken by GblTask_then()
+};
+
+GBL_DECLARE_STRUCT(GblTask_) {
+    GblMainLoop*  pLoop;        // set once the task has been enqueued
+    GblTask*      pNextQueued;  // injection queue or retired stack link
+    GblTaskFn     pFnCallback;
+    atomic_int    state;
+    GBL_RESULT    result;
+    /* Number of things the task is still waiting on before it can be
+       queued: 1 for not being enqueued yet, plus 1 per unfinished
+       prerequisite. Whoever brings it to 0 schedules the task. */
+    atomic_size_t pending;
+    atomic_bool   canceled;
+    atomic_flag   linkLock;
+    GblBool       linksClosed;  // set once the task is done, new continuations are resolved immediately
+    GblBool       failed;       // whether continuations were canceled when links were closed
+    GblTaskLink_* pLinks;
+    GblTask*      pOuter;       // task suspended beneath this one on the thread running it, while running
+    uint64_t      deadline;     // nsec, or 0 for none
+    uint32_t      timeout;      // msec, or 0 for none
+    GblPriority   priority;
+};
+
+// Swaps the task reported by GblTask_current() for the calling thread, returning the previous one
+extern GblTask*   GblTask_setCurrent_  (GblTask* pTask);
+
+// Drops one of the task's pending counts, scheduling it on its loop if it was the last
+extern void       GblMainLoop_release_ (GblTask* pTask);
+// Blocks until the task is done, executing other tasks in the meantime
+extern GBL_RESULT GblMainLoop_wait_    (GblMainLoop* pSelf, GblTask* pTask);
+
+GBL_DECLS_END
+
+#endif // GIMBAL_TASK__H
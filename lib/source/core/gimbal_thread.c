@@ -4,8 +4,10 @@
 #include <gimbal/containers/gimbal_linked_list.h>
 #include <gimbal/meta/signals/gimbal_marshal.h>
 #include <gimbal/core/gimbal_tls.h>
+#include "gimbal_thread_.h"
 
 #include <tinycthread.h>
+#include <stdatomic.h>
 
 #define GBL_THREAD_(self)               (GBL_PRIVATE(GblThread, self))
 #define GBL_THREAD_PUBLIC_(priv)        (GBL_PUBLIC(GblThread, priv))
@@ -22,6 +24,10 @@ GBL_DECLARE_STRUCT(GblThread_) {
     struct {
         uint8_t joined  : 1;
     };
+    // MPSC event queue: producers push onto the inbox, the owner drains it into pending
+    _Atomic(GblThreadEvent_*) pEventInbox;
+    GblThreadEvent_*          pEventHead;
+    atomic_size_t             eventCount;
 };
 
 static mtx_t        listMtx_;
@@ -199,11 +205,14 @@ static GBL_RESULT GblThread_exit_(GblThread* pSelf) {
     // inform connected slots that thread has finished
     GBL_EMIT(pSelf, "finished", pSelf->returnStatus.result);
 
+    // cache the result, since a detached thread is gone after its unref
+    const GBL_RESULT result = pSelf->returnStatus.result;
+
     // commit suicide and clean itself up if detached
     GBL_UNREF(pSelf);
 
     // return casted result code
-    return pSelf->returnStatus.result;
+    return result;
 }
 
 // Low-level thread entry point
@@ -230,6 +239,69 @@ static int GblThread_start_(void* pThread) {
     return GblThread_exit_(pSelf);
 }
 
+void GblThread_postEvent_(GblThread* pSelf, GblThreadEvent_* pEvent) {
+    GblThread_* pSelf_ = GBL_THREAD_(pSelf);
+
+    atomic_fetch_add_explicit(&pSelf_->eventCount, 1, memory_order_relaxed);
+
+    // lock-free push onto the inbox stack, which the owning thread swaps out whole
+    GblThreadEvent_* pHead = atomic_load_explicit(&pSelf_->pEventInbox, memory_order_relaxed);
+    do {
+        pEvent->pNext = pHead;
+    } while(!atomic_compare_exchange_weak_explicit(&pSelf_->pEventInbox,
+                                                   &pHead,
+                                                   pEvent,
+                                                   memory_order_release,
+                                                   memory_order_relaxed));
+}
+
+static GblThreadEvent_* GblThread_nextEvent_(GblThread_* pSelf_) {
+    // refill the pending queue with a whole batch from the inbox, restoring posting order
+    if(!pSelf_->pEventHead) {
+        GblThreadEvent_* pBatch = atomic_exchange_explicit(&pSelf_->pEventInbox,
+                                                           NULL,
+                                                           memory_order_acquire);
+
+        while(pBatch) {
+            GblThreadEvent_* pNext = pBatch->pNext;
+            pBatch->pNext          = pSelf_->pEventHead;
+            pSelf_->pEventHead     = pBatch;
+            pBatch                 = pNext;
+        }
+    }
+
+    GblThreadEvent_* pEvent = pSelf_->pEventHead;
+
+    if(pEvent) {
+        pSelf_->pEventHead = pEvent->pNext;
+        atomic_fetch_sub_explicit(&pSelf_->eventCount, 1, memory_order_relaxed);
+    }
+
+    return pEvent;
+}
+
+GBL_EXPORT size_t GblThread_processEvents(size_t maxEvents) {
+    size_t processed = 0;
+    GBL_CTX_BEGIN(NULL);
+
+    GblThread_* pSelf_ = GBL_THREAD_(GblThread_current());
+
+    GblThreadEvent_* pEvent;
+    while((!maxEvents || processed < maxEvents) &&
+          (pEvent = GblThread_nextEvent_(pSelf_)))
+    {
+        GBL_CTX_CALL(pEvent->pFnDeliver(pEvent, GBL_FALSE));
+        ++processed;
+    }
+
+    GBL_CTX_END_BLOCK();
+    return processed;
+}
+
+GBL_EXPORT size_t GblThread_pendingEvents(const GblThread* pSelf) {
+    return atomic_load_explicit(&GBL_THREAD_(pSelf)->eventCount, memory_order_relaxed);
+}
+
 GBL_EXPORT size_t GblThread_count(void) {
     call_once(&initOnce_, &GblThread_init_);
     mtx_lock(&listMtx_);
@@ -409,12 +481,14 @@ GBL_EXPORT GBL_RESULT (GblThread_exit)(GBL_RESULT  result,
     GBL_CTX_VERIFY(pSelf,
                    GBL_RESULT_ERROR_INVALID_THREAD);
 
-    GBL_CTX_RESULT() = result;
-    if(pMessage) strcpy(GBL_CTX_RECORD().message, pMessage);
-    GBL_CTX_RECORD().srcLocation.pFile = pFile;
-    GBL_CTX_RECORD().srcLocation.pFunc = pFunc;
-    GBL_CTX_RECORD().srcLocation.line  = line;
-    GblThd_setCallRecord(NULL, &GBL_CTX_RECORD());
+    GBL_CTX_RESULT()             = result;
+    GBL_CTX_SOURCE().pFile       = pFile;
+    GBL_CTX_SOURCE().pFunc       = pFunc;
+    GBL_CTX_SOURCE().line        = line;
+
+    GblCallRecord* pRecord = &GBL_CTX_RECORD();
+    if(pMessage) strcpy(pRecord->message, pMessage);
+    GblThd_setCallRecord(NULL, pRecord);
 
     GBL_CTX_VERIFY_CALL(GblThread_exit_(pSelf));
 
@@ -493,6 +567,12 @@ static GBL_RESULT GblThread_GblBox_destructor_(GblBox* pBox) {
     GblThread*  pSelf = GBL_THREAD(pBox);
     GblThread_* pSelf_  = GBL_THREAD_(pSelf);
 
+    // Nobody is left to deliver them, so just release any undelivered events
+    GblThreadEvent_* pEvent;
+    while((pEvent = GblThread_nextEvent_(pSelf_))) {
+        GBL_CTX_CALL(pEvent->pFnDeliver(pEvent, GBL_TRUE));
+    }
+
     if(!pSelf_->joined) {
         const int retVal = thrd_detach(pSelf_->nativeHandle);
         GBL_CTX_VERIFY(retVal == thrd_success,
@@ -553,6 +633,19 @@ static GBL_RESULT GblThreadClass_initialize_(GblClass* pClass, const void* pUd)
     GBL_CTX_END();
 }
 
+static GBL_RESULT GblThreadClass_finalize_(GblClass* pClass, const void* pUd) {
+    GBL_UNUSED(pClass, pUd);
+    GBL_CTX_BEGIN(NULL);
+
+    if(!GblType_classRefCount(GBL_THREAD_TYPE)) {
+        GblSignal_uninstall(GBL_THREAD_TYPE, "started");
+        GblSignal_uninstall(GBL_THREAD_TYPE, "finished");
+        GblSignal_uninstall(GBL_THREAD_TYPE, "signaled");
+    }
+
+    GBL_CTX_END();
+}
+
 GBL_EXPORT GBL_RESULT GblThread_setPriority(GblThread* pSelf,
                                             GBL_THREAD_PRIORITY priority) {
     GBL_UNUSED(pSelf, priority);
@@ -580,6 +673,7 @@ GBL_EXPORT GblType GblThread_type(void) {
     static const GblTypeInfo info = {
         .classSize           = sizeof(GblThreadClass),
         .pFnClassInit        = GblThreadClass_initialize_,
+        .pFnClassFinal       = GblThreadClass_finalize_,
         .instanceSize        = sizeof(GblThread),
         .instancePrivateSize = sizeof(GblThread_),
         .pFnInstanceInit     = GblThread_initialize_
@@ -0,0 +1,24 @@
+#ifndef GIMBAL_THREAD__H
+#define GIMBAL_THREAD__H
+
+#include <gimbal/core/gimbal_thread.h>
+
+GBL_DECLS_BEGIN
+
+/* Intrusive node for work posted to a GblThread's event queue.
+
+   Any thread may post an event, but only the owning thread delivers
+   them, from GblThread_processEvents(). The callback always takes
+   ownership of the event: it runs the work, unless discard is set
+   because the thread is being destroyed, then frees the event. */
+typedef struct GblThreadEvent_ {
+    struct GblThreadEvent_* pNext;
+    GBL_RESULT            (*pFnDeliver)(struct GblThreadEvent_* pSelf,
+                                        GblBool                 discard);
+} GblThreadEvent_;
+
+extern void GblThread_postEvent_(GblThread* pSelf, GblThreadEvent_* pEvent);
+
+GBL_DECLS_END
+
+#endif // GIMBAL_THREAD__H
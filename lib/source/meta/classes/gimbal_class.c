@@ -500,9 +500,21 @@ static GblClass* GblClass_cast_(GblClass* pClass, GblType toType, GblBool check,
                 }
             }
 
-            GblMetaClass* pMeta = GBL_CLASS_META_CLASS_(pClass);
+            GblMetaClass*  pMeta      = GBL_CLASS_META_CLASS_(pClass);
+            GblMetaClass*  pOuterMeta = pMeta;
+            uint32_t       offset     = 0;
+            const uint32_t generation = GblType_cacheGeneration_();
             GBL_ASSERT(pMeta);
 
+            /* Top-level casts from the outer class are cached as the offset to the
+               resulting class (+1). Interfaces which haven't been constructed yet
+               are still skipped, as with the search below. */
+            if(!recursing && GblType_cacheLookup_(pMeta->castCache, GBL_META_CLASS_(toType), &offset)) {
+                GblClass* pCached = GBL_PTR_OFFSET(GblClass*, pClass, offset - 1);
+                if GBL_LIKELY(GBL_CLASS_TYPEOF(pCached) != GBL_INVALID_TYPE)
+                    return pCached;
+            }
+
             // iterate from derived to base class, breadth-first searching
             do {
                 //check current class
@@ -542,6 +554,11 @@ static GblClass* GblClass_cast_(GblClass* pClass, GblType toType, GblBool check,
                 }
                 pMeta = pMeta->pParent;
             } while(!pToClass && pMeta);
+
+            if(!recursing && pToClass && (uint8_t*)pToClass >= (uint8_t*)pClass)
+                GblType_cacheStore_(pOuterMeta->castCache, GBL_META_CLASS_(toType), generation,
+                                    (uint32_t)GBL_MIN((uint8_t*)pToClass - (uint8_t*)pClass,
+                                                      GBL_TYPE_CACHE_VALUE_MAX_) + 1);
         }
     }
     if(check && !pToClass) {
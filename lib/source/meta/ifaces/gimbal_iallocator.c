@@ -31,7 +31,7 @@ static GBL_RESULT GblIAllocator_parent_(const GblIAllocator* pSelf, GblIAllocato
 
     if(GBL_TYPECHECK(GblObject, pSelf)) {
         GblObject* pObject = GBL_OBJECT(pSelf);
-        *ppParent = GBL_IALLOCATOR(GblObject_findAncestorByType(pObject, GBL_IALLOCATOR_TYPE));
+        *ppParent = GBL_AS(GblIAllocator, GblObject_findAncestorByType(pObject, GBL_IALLOCATOR_TYPE));
     }
 
     return GBL_RESULT_SUCCESS;
@@ -43,6 +43,7 @@ static GBL_RESULT GblIAllocatorClass_init_(GblIAllocatorClass* pIFace, void* pDa
     pIFace->pFnAlloc    = GblIAllocatorClass_alloc_;
     pIFace->pFnRealloc  = GblIAllocatorClass_realloc_;
     pIFace->pFnFree     = GblIAllocatorClass_free_;
+    pIFace->pFnParent   = GblIAllocator_parent_;
     GBL_CTX_END();
 }
 
@@ -8,8 +8,11 @@ static GBL_RESULT GblContext_IAllocator_alloc_(GblIAllocator* pIAllocator, const
     GblContext* pParentCtx = GblContext_parentContext((GblContext*)pIAllocator);
     GBL_CTX_BEGIN(pParentCtx);
 
+    // plugged in allocator
+    if(((GblContext*)pIAllocator)->pAllocator) {
+        GBL_CTX_VERIFY_CALL(GblIAllocator_alloc(((GblContext*)pIAllocator)->pAllocator, pFrame, size, align, pDbgStr, ppData));
     // chain up
-    if(GBL_CTX_CONTEXT() != (GblContext*)pIAllocator) {
+    } else if(GBL_CTX_CONTEXT() != (GblContext*)pIAllocator) {
         GBL_CTX_VERIFY_CALL(GblContext_memAlloc_(GBL_CTX_CONTEXT(), pFrame, size, align, pDbgStr, ppData));
     } else {
         GBL_CTX_VERIFY_ARG(size);
@@ -40,8 +43,11 @@ static GBL_RESULT GblContext_IAllocator_realloc_(GblIAllocator* pIAllocator, con
 
     GblContext* pParentCtx = GblContext_parentContext((GblContext*)pIAllocator);
     GBL_CTX_BEGIN(pParentCtx);
+    // plugged in allocator
+    if(((GblContext*)pIAllocator)->pAllocator) {
+        GBL_CTX_VERIFY_CALL(GblIAllocator_realloc(((GblContext*)pIAllocator)->pAllocator, pFrame, pData, newSize, newAlign, ppNewData));
     // chain up
-    if(GBL_CTX_CONTEXT() != (GblContext*)pIAllocator) {
+    } else if(GBL_CTX_CONTEXT() != (GblContext*)pIAllocator) {
         GBL_CTX_VERIFY_CALL(GblContext_memRealloc_(GBL_CTX_CONTEXT(), pFrame, pData, newSize, newAlign, ppNewData));
     } else {
 
@@ -73,8 +79,11 @@ static GBL_RESULT GblContext_IAllocator_free_(GblIAllocator* pIAllocator, const
 
     GblContext* pParentCtx = GblContext_parentContext((GblContext*)pIAllocator);
     GBL_CTX_BEGIN(pParentCtx);
+    // plugged in allocator
+    if(((GblContext*)pIAllocator)->pAllocator) {
+        GBL_CTX_VERIFY_CALL(GblIAllocator_free(((GblContext*)pIAllocator)->pAllocator, pFrame, pData));
     // chain up
-    if(GBL_CTX_CONTEXT() != (GblContext*)pIAllocator) {
+    } else if(GBL_CTX_CONTEXT() != (GblContext*)pIAllocator) {
         GBL_CTX_VERIFY_CALL(GblContext_memFree_(GBL_CTX_CONTEXT(), pFrame, pData));
     } else {
 
@@ -142,9 +151,9 @@ static GBL_RESULT GblContext_ILogger_write_(GblILogger* pILogger, const GblStack
 
         if((fprintf(pFile, "%s%s%s\n%s        @ %s(..): %s:%u\n",
                             tabBuff, pPrefix, buffer, tabBuff,
-                            pFrame->record.srcLocation.pFunc,
-                            pFrame->record.srcLocation.pFile,
-                            pFrame->record.srcLocation.line)
+                            pFrame->srcLocation.pFunc,
+                            pFrame->srcLocation.pFile,
+                            pFrame->srcLocation.line)
                     < 0)) result = GBL_RESULT_ERROR_FILE_WRITE;
         break;
     }
@@ -233,6 +242,14 @@ GBL_EXPORT GblContext* GblContext_parentContext(const GblContext* pSelf) GBL_NOE
     return GblObject_findContext(GblObject_parent((GblObject*)pSelf));
 }
 
+GBL_EXPORT GblIAllocator* GblContext_allocator(const GblContext* pSelf) GBL_NOEXCEPT {
+    return pSelf->pAllocator;
+}
+
+GBL_EXPORT void GblContext_setAllocator(GblContext* pSelf, GblIAllocator* pAllocator) GBL_NOEXCEPT {
+    pSelf->pAllocator = pAllocator;
+}
+
 GBL_EXPORT const GblCallRecord* GblContext_lastIssue(const GblContext* pSelf) GBL_NOEXCEPT {
     return pSelf? &pSelf->lastIssue : NULL;
 }
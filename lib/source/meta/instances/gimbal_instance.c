@@ -1,6 +1,249 @@
 #include <gimbal/meta/instances/gimbal_instance.h>
+#include <gimbal/allocators/gimbal_pool_allocator.h>
 #include "../types/gimbal_type_.h"
 
+#define GBL_INSTANCE_POOL_PAGE_ENTRIES_     64  // entries allocated per pool page
+#define GBL_INSTANCE_POOL_CACHE_SLOTS_      8   // pooled types cached per thread (power of 2)
+#define GBL_INSTANCE_POOL_CACHE_CAPACITY_   32  // free entries cached per type per thread
+
+/* Shared, per-type pool, created upon first allocation. Destroying its type
+   only retires it, releasing its pages but keeping the rest around, so thread
+   caches still pointing at it can tell their entries are gone. */
+typedef struct GblInstancePool_ {
+    GblPoolAllocator         allocator;
+    mtx_t                    mtx;
+    atomic_size_t            cachedCount;
+    GblBool                  retired;       // Guarded by mtx
+    struct GblInstancePool_* pNextRetired;
+} GblInstancePool_;
+
+// Thread-local stack of free entries for a single pool
+typedef struct GblInstancePoolCache_ {
+    GblInstancePool_*  pPool;
+    uint32_t           epoch;
+    uint32_t           count;
+    GblLinkedListNode* pHead;
+} GblInstancePoolCache_;
+
+/* Bumped when the type system is finalized and retired pools are freed,
+   after which thread caches filled beforehand are dropped without being
+   touched, as their pools are gone. */
+static atomic_uint_least32_t                 poolEpoch_       = 0;
+static GblInstancePool_*                     pRetiredPools_   = GBL_NULL;   // Guarded by typeRegMtx_
+static once_flag                             poolTssOnce_     = ONCE_FLAG_INIT;
+static tss_t                                 poolTss_;
+static GBL_THREAD_LOCAL GblBool              poolTssSet_      = GBL_FALSE;
+static GBL_THREAD_LOCAL GblInstancePoolCache_ poolCaches_[GBL_INSTANCE_POOL_CACHE_SLOTS_];
+
+// Returns up to count entries from the cache back to its pool
+static void GblInstancePoolCache_flush_(GblInstancePoolCache_* pCache, uint32_t count) {
+    if(!pCache->count)
+        return;
+
+    if(pCache->epoch == atomic_load_explicit(&poolEpoch_, memory_order_acquire)) {
+        GblInstancePool_* pPool = pCache->pPool;
+
+        mtx_lock(&pPool->mtx);
+        // A retired pool's pages are gone along with its type, taking the cached entries with them
+        if GBL_UNLIKELY(pPool->retired) {
+            pCache->pHead = NULL;
+            pCache->count = 0;
+        }
+        for(uint32_t e = 0; e < count && pCache->pHead; ++e) {
+            GblLinkedListNode* pEntry = pCache->pHead;
+            pCache->pHead = pEntry->pNext;
+            --pCache->count;
+            GblPoolAllocator_delete(&pPool->allocator, pEntry);
+            atomic_fetch_sub_explicit(&pPool->cachedCount, 1, memory_order_relaxed);
+        }
+        mtx_unlock(&pPool->mtx);
+    } else {
+        pCache->pHead = NULL;
+        pCache->count = 0;
+    }
+}
+
+static void GblInstance_poolThreadExit_(void* pData) {
+    GBL_UNUSED(pData);
+    for(size_t c = 0; c < GBL_INSTANCE_POOL_CACHE_SLOTS_; ++c)
+        GblInstancePoolCache_flush_(&poolCaches_[c], poolCaches_[c].count);
+}
+
+static void GblInstance_poolTssInit_(void) {
+    tss_create(&poolTss_, GblInstance_poolThreadExit_);
+}
+
+// Returns the calling thread's cache for the pool, evicting whichever pool held its slot
+static GblInstancePoolCache_* GblInstance_poolCache_(GblMetaClass* pMeta, GblInstancePool_* pPool) {
+    GblInstancePoolCache_* pCache = &poolCaches_[pMeta->index & (GBL_INSTANCE_POOL_CACHE_SLOTS_ - 1)];
+    const uint32_t         epoch  = atomic_load_explicit(&poolEpoch_, memory_order_acquire);
+
+    if GBL_UNLIKELY(pCache->pPool != pPool || pCache->epoch != epoch) {
+        GblInstancePoolCache_flush_(pCache, pCache->count);
+        pCache->pPool = pPool;
+        pCache->epoch = epoch;
+
+        // Register for flushing the caches back upon thread exit
+        if GBL_UNLIKELY(!poolTssSet_) {
+            call_once(&poolTssOnce_, GblInstance_poolTssInit_);
+            tss_set(poolTss_, poolCaches_);
+            poolTssSet_ = GBL_TRUE;
+        }
+    }
+
+    return pCache;
+}
+
+static GblInstancePool_* GblInstance_pool_(GblMetaClass* pMeta) {
+    GblInstancePool_* pPool = atomic_load_explicit(&pMeta->pInstancePool, memory_order_acquire);
+
+    if GBL_UNLIKELY(!pPool) {
+        GBL_CTX_BEGIN(pCtx_);
+        pPool = GBL_CTX_NEW(GblInstancePool_);
+        memset(pPool, 0, sizeof(GblInstancePool_));
+
+        GBL_CTX_VERIFY_CALL(GblPoolAllocator_construct(&pPool->allocator,
+                                                       gblAlignedAllocSizeDefault(pMeta->pInfo->instanceSize +
+                                                                                  -pMeta->instancePrivateOffset),
+                                                       GBL_INSTANCE_POOL_PAGE_ENTRIES_,
+                                                       GBL_ALIGNOF(GBL_MAX_ALIGN_T),
+                                                       GBL_NULL,
+                                                       pCtx_));
+        mtx_init(&pPool->mtx, mtx_plain);
+
+        // Another thread may have won the race to create the pool
+        GblInstancePool_* pExpected = GBL_NULL;
+        if(!atomic_compare_exchange_strong(&pMeta->pInstancePool, &pExpected, pPool)) {
+            GblPoolAllocator_destruct(&pPool->allocator);
+            mtx_destroy(&pPool->mtx);
+            GBL_CTX_FREE(pPool);
+            pPool = pExpected;
+        }
+        GBL_CTX_END_BLOCK();
+    }
+
+    return pPool;
+}
+
+static void* GblInstance_poolAlloc_(GblMetaClass* pMeta) {
+    GblInstancePool_* pPool = GblInstance_pool_(pMeta);
+    if GBL_UNLIKELY(!pPool)
+        return GBL_NULL;
+
+    GblInstancePoolCache_* pCache = GblInstance_poolCache_(pMeta, pPool);
+
+    /* Refill half of the thread cache in one trip to the shared pool,
+       without growing the pool while recycled entries are still available. */
+    if GBL_UNLIKELY(!pCache->pHead) {
+        mtx_lock(&pPool->mtx);
+        const GblBool recycle = !GblLinkedList_empty(&pPool->allocator.freeList);
+        for(size_t e = 0; e < GBL_INSTANCE_POOL_CACHE_CAPACITY_ / 2; ++e) {
+            if(recycle && GblLinkedList_empty(&pPool->allocator.freeList))
+                break;
+            GblLinkedListNode* pEntry = GblPoolAllocator_new(&pPool->allocator);
+            if(!pEntry) break;
+            pEntry->pNext = pCache->pHead;
+            pCache->pHead = pEntry;
+            ++pCache->count;
+            atomic_fetch_add_explicit(&pPool->cachedCount, 1, memory_order_relaxed);
+        }
+        mtx_unlock(&pPool->mtx);
+
+        if GBL_UNLIKELY(!pCache->pHead)
+            return GBL_NULL;
+    }
+
+    GblLinkedListNode* pEntry = pCache->pHead;
+    pCache->pHead = pEntry->pNext;
+    --pCache->count;
+    atomic_fetch_sub_explicit(&pPool->cachedCount, 1, memory_order_relaxed);
+    return pEntry;
+}
+
+static void GblInstance_poolFree_(GblMetaClass* pMeta, void* pBase) {
+    GblInstancePool_*      pPool  = atomic_load_explicit(&pMeta->pInstancePool, memory_order_acquire);
+    GblInstancePoolCache_* pCache = GblInstance_poolCache_(pMeta, pPool);
+    GblLinkedListNode*     pEntry = pBase;
+
+    pEntry->pNext = pCache->pHead;
+    pCache->pHead = pEntry;
+    ++pCache->count;
+    atomic_fetch_add_explicit(&pPool->cachedCount, 1, memory_order_relaxed);
+
+    // Give back the older half once the cache overflows
+    if GBL_UNLIKELY(pCache->count > GBL_INSTANCE_POOL_CACHE_CAPACITY_) {
+        GblLinkedListNode* pKeep = pCache->pHead;
+        for(size_t e = 1; e < GBL_INSTANCE_POOL_CACHE_CAPACITY_ / 2; ++e)
+            pKeep = pKeep->pNext;
+
+        GblInstancePoolCache_ overflow = *pCache;
+        overflow.pHead = pKeep->pNext;
+        overflow.count = pCache->count - GBL_INSTANCE_POOL_CACHE_CAPACITY_ / 2;
+        pKeep->pNext   = GBL_NULL;
+        pCache->count  = GBL_INSTANCE_POOL_CACHE_CAPACITY_ / 2;
+        GblInstancePoolCache_flush_(&overflow, overflow.count);
+    }
+}
+
+void GblInstance_poolDestroy_(GblMetaClass* pMeta) {
+    GblInstancePool_* pPool = atomic_exchange(&pMeta->pInstancePool, GBL_NULL);
+
+    if(pPool) {
+        GBL_CTX_BEGIN(pCtx_);
+        mtx_lock(&pPool->mtx);
+        pPool->retired = GBL_TRUE;
+        GBL_CTX_CALL(GblPoolAllocator_destruct(&pPool->allocator));
+        mtx_unlock(&pPool->mtx);
+        GBL_CTX_END_BLOCK();
+
+        // Only other threads' caches of this type are affected, once they next touch it
+        pPool->pNextRetired = pRetiredPools_;
+        pRetiredPools_      = pPool;
+    }
+}
+
+void GblInstance_poolFinal_(void) {
+    // No type survives finalization, so every thread cache is stale
+    atomic_fetch_add_explicit(&poolEpoch_, 1, memory_order_acq_rel);
+
+    GBL_CTX_BEGIN(pCtx_);
+    while(pRetiredPools_) {
+        GblInstancePool_* pPool = pRetiredPools_;
+        pRetiredPools_ = pPool->pNextRetired;
+        mtx_destroy(&pPool->mtx);
+        GBL_CTX_FREE(pPool);
+    }
+    GBL_CTX_END_BLOCK();
+}
+
+GBL_EXPORT GBL_RESULT GblType_poolStats(GblType type, GblTypePoolStats* pStats) {
+    GBL_CTX_BEGIN(pCtx_);
+    GBL_CTX_VERIFY_TYPE(type);
+    GBL_CTX_VERIFY_POINTER(pStats);
+    GBL_CTX_VERIFY(GblType_flags(type) & GBL_TYPE_FLAG_POOLED,
+                   GBL_RESULT_ERROR_INVALID_TYPE,
+                   "[GblType] Cannot query pool statistics of NON POOLED type: %s",
+                   GblType_name(type));
+
+    memset(pStats, 0, sizeof(GblTypePoolStats));
+
+    GblMetaClass*     pMeta = GBL_META_CLASS_(type);
+    GblInstancePool_* pPool = atomic_load_explicit(&pMeta->pInstancePool, memory_order_acquire);
+
+    if(pPool) {
+        mtx_lock(&pPool->mtx);
+        pStats->entrySize   = pPool->allocator.entrySize;
+        pStats->pageCount   = GblArenaAllocator_pageCount(&pPool->allocator.arena);
+        pStats->totalBytes  = GblArenaAllocator_totalCapacity(&pPool->allocator.arena);
+        pStats->activeCount = pPool->allocator.activeEntries;
+        pStats->freeCount   = GblPoolAllocator_freeListSize(&pPool->allocator);
+        pStats->cachedCount = atomic_load_explicit(&pPool->cachedCount, memory_order_relaxed);
+        mtx_unlock(&pPool->mtx);
+    }
+
+    GBL_CTX_END();
+}
+
 GBL_EXPORT void* GblInstance_basePtr_(const GblInstance* pInstance) {
     GblMetaClass* pMeta = GBL_META_CLASS_(GBL_TYPEOF(pInstance));
     return pMeta? (void*)((uint8_t*)pInstance + pMeta->instancePrivateOffset) : NULL;
@@ -116,10 +359,26 @@ GBL_EXPORT GblInstance* (GblInstance_create)(GblType type, size_t size, GblClass
 
     GBL_CTX_DEBUG("Allocating %zu bytes.", size + (-pMeta->instancePrivateOffset));
 
-    uint8_t* pBase =
-        GBL_CTX_MALLOC(gblAlignedAllocSizeDefault(size + (-pMeta->instancePrivateOffset)),
-                       GBL_ALIGNOF(GBL_MAX_ALIGN_T),
+    uint8_t* pBase = NULL;
+
+    if(pMeta->flags & GBL_TYPE_FLAG_POOLED) {
+        GBL_CTX_VERIFY(size == pMeta->pInfo->instanceSize,
+                       GBL_RESULT_ERROR_INVALID_ARG,
+                       "Attempt to allocate POOLED type [%s] with a custom size [given: %zu, pooled: %zu]",
+                       GblType_name(type),
+                       size,
+                       pMeta->pInfo->instanceSize);
+
+        pBase = GblInstance_poolAlloc_(pMeta);
+        GBL_CTX_VERIFY(pBase,
+                       GBL_RESULT_ERROR_MEM_ALLOC,
+                       "Failed to allocate [%s] from its instance pool",
                        GblType_name(type));
+    } else {
+        pBase = GBL_CTX_MALLOC(gblAlignedAllocSizeDefault(size + (-pMeta->instancePrivateOffset)),
+                               GBL_ALIGNOF(GBL_MAX_ALIGN_T),
+                               GblType_name(type));
+    }
 
     // initialize just the private portion here, as the public will be initialized later
     if(pMeta->instancePrivateOffset != 0)
@@ -174,10 +433,14 @@ GBL_EXPORT GblRefCount GblInstance_destroy(GblInstance* pSelf) {
        if(pSelf) {
             GBL_CTX_PUSH_VERBOSE("[GblType] Instance Destroy: %s",
                                  GblType_name(GblInstance_typeOf(pSelf)));
-            void* pBase = GblInstance_basePtr_(pSelf);
+            GblMetaClass* pMeta = GBL_META_CLASS_(GblInstance_typeOf(pSelf));
+            void*         pBase = GblInstance_basePtr_(pSelf);
             refCount = GblInstance_destruct(pSelf);
             GBL_CTX_VERIFY_LAST_RECORD();
-            GBL_CTX_FREE(pBase);
+            if(pMeta->flags & GBL_TYPE_FLAG_POOLED)
+                GblInstance_poolFree_(pMeta, pBase);
+            else
+                GBL_CTX_FREE(pBase);
             GBL_CTX_POP(1);
         }
     }
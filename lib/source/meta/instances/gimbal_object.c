@@ -390,7 +390,7 @@ GBL_EXPORT GBL_RESULT GblObject_setProperties(GblObject* pSelf, ...) {
 }
 
 GBL_EXPORT GBL_RESULT GblObject_propertyVa_(const GblObject* pSelf, const GblProperty* pProp, va_list* pList) {
-    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_BEGIN_LEAF(NULL);
     GblVariant variant;
 
     GBL_CTX_VERIFY((pProp->flags & GBL_PROPERTY_FLAG_READ),
@@ -408,11 +408,11 @@ GBL_EXPORT GBL_RESULT GblObject_propertyVa_(const GblObject* pSelf, const GblPro
 
     GBL_CTX_CALL(GblVariant_destruct(&variant));
 
-    GBL_CTX_END();
+    GBL_CTX_END_LEAF();
 }
 
 GBL_EXPORT GBL_RESULT GblObject_propertyVa(const GblObject* pSelf, const char* pName, va_list* pList) {
-    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_BEGIN_LEAF(NULL);
 
     const GblProperty* pProp = GblProperty_find(GBL_TYPEOF(pSelf), pName);
     GBL_CTX_VERIFY(pProp,
@@ -423,11 +423,11 @@ GBL_EXPORT GBL_RESULT GblObject_propertyVa(const GblObject* pSelf, const char* p
 
     GBL_CTX_CALL(GblObject_propertyVa_(pSelf, pProp, pList));
 
-    GBL_CTX_END();
+    GBL_CTX_END_LEAF();
 }
 
 GBL_EXPORT GBL_RESULT GblObject_propertyVaByQuark(const GblObject* pSelf, GblQuark name, va_list* pList) {
-    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_BEGIN_LEAF(NULL);
 
     const GblProperty* pProp = GblProperty_findQuark(GBL_TYPEOF(pSelf), name);
     GBL_CTX_VERIFY(pProp,
@@ -438,7 +438,7 @@ GBL_EXPORT GBL_RESULT GblObject_propertyVaByQuark(const GblObject* pSelf, GblQua
 
     GBL_CTX_CALL(GblObject_propertyVa_(pSelf, pProp, pList));
 
-    GBL_CTX_END();
+    GBL_CTX_END_LEAF();
 }
 
 GBL_EXPORT GBL_RESULT GblObject_property(const GblObject* pSelf, const char* pName, ...) {
@@ -462,7 +462,7 @@ GBL_EXPORT GBL_RESULT GblObject_propertyByQuark(const GblObject* pSelf, GblQuark
 }
 
 GBL_EXPORT GBL_RESULT GblObject_setPropertyVa_(GblObject* pSelf, const GblProperty* pProp, va_list* pList) {
-    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_BEGIN_LEAF(NULL);
 
     GblVariant variant;
     GBL_CTX_VERIFY(pProp->flags & GBL_PROPERTY_FLAG_WRITE,
@@ -479,12 +479,12 @@ GBL_EXPORT GBL_RESULT GblObject_setPropertyVa_(GblObject* pSelf, const GblProper
     GBL_CTX_CALL(GblObject_setPropertyVCall_(pSelf, pProp, &variant, GBL_PROPERTY_FLAG_WRITE));
     GBL_CTX_CALL(GblVariant_destruct(&variant));
 
-    GBL_CTX_END();
+    GBL_CTX_END_LEAF();
 }
 
 
 GBL_EXPORT GBL_RESULT GblObject_setPropertyVa(GblObject* pSelf, const char* pName, va_list* pList) {
-    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_BEGIN_LEAF(NULL);
 
     const GblProperty* pProp = GblProperty_find(GBL_TYPEOF(pSelf), pName);
     GBL_CTX_VERIFY(pProp && pProp->flags & GBL_PROPERTY_FLAG_WRITE,
@@ -495,11 +495,11 @@ GBL_EXPORT GBL_RESULT GblObject_setPropertyVa(GblObject* pSelf, const char* pNam
 
     GBL_CTX_VERIFY_CALL(GblObject_setPropertyVa_(pSelf, pProp, pList));
 
-    GBL_CTX_END();
+    GBL_CTX_END_LEAF();
 }
 
 GBL_EXPORT GBL_RESULT GblObject_setPropertyVaByQuark(GblObject* pSelf, GblQuark name, va_list* pList) {
-    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_BEGIN_LEAF(NULL);
 
     const GblProperty* pProp = GblProperty_findQuark(GBL_TYPEOF(pSelf), name);
     GBL_CTX_VERIFY(pProp->flags & GBL_PROPERTY_FLAG_WRITE,
@@ -508,7 +508,7 @@ GBL_EXPORT GBL_RESULT GblObject_setPropertyVaByQuark(GblObject* pSelf, GblQuark
 
     GBL_CTX_VERIFY_CALL(GblObject_setPropertyVa_(pSelf, pProp, pList));
 
-    GBL_CTX_END();
+    GBL_CTX_END_LEAF();
 }
 
 
@@ -12,7 +12,31 @@ typedef struct GblPropertyRoot_ {
     GblProperty*    pLast;
 } GblPropertyRoot_;
 
-static GblHashSet propertyRegistry_;
+// Slot within a GblPropertyTable_'s open-addressed index
+typedef struct GblPropertyTableSlot_ {
+    const GblProperty* pProperty;   // most-derived property visible with the slot's name
+    size_t             index;       // position of pProperty within the entry list
+} GblPropertyTableSlot_;
+
+/* Flattened view of every property visible on a type, built lazily upon
+   first lookup and hung off its GblMetaClass. Entries are ordered from the
+   root type's properties down to the type's own, in installation order,
+   followed by an index over them keyed by name quark.
+
+   Lookups may still be reading a table after it has been replaced, so
+   replaced tables are chained off of their successors and only freed along
+   with the type itself. */
+typedef struct GblPropertyTable_ {
+    struct GblPropertyTable_* pRetired;     // table this one replaced, kept alive for readers
+    uint32_t                  generation;   // sum of the propertyGeneration of the type and its bases
+    uint32_t                  count;        // number of entries, including inherited ones
+    uint32_t                  ownOffset;    // index of the first entry installed onto the type itself
+    uint32_t                  slotMask;     // slot count - 1
+    GblPropertyTableSlot_*    pSlots;
+    const GblProperty*        entries[];
+} GblPropertyTable_;
+
+static GblHashSet            propertyRegistry_;
 
 // ========== PROPERTY SYSTEM PRIVATE ==========
 
@@ -102,6 +126,131 @@ extern GBL_RESULT GblProperty_final_(GblContext* pCtx) {
     GBL_CTX_END();
 }
 
+GBL_INLINE size_t propertyTableHash_(GblQuark name) {
+    return (size_t)(((uint64_t)name * 0x9e3779b97f4a7c15ull) >> 32);
+}
+
+static GblPropertyTable_* propertyTableBuild_(GblType objectType, uint32_t generation) {
+    GblPropertyTable_* pTable = NULL;
+    GBL_CTX_BEGIN(pCtx_);
+
+    const uint8_t depth    = GblType_depth(objectType);
+    size_t        count    = 0;
+    size_t        capacity = 4;
+
+    for(uint8_t d = 0; d <= depth; ++d) {
+        const GblPropertyRoot_* pRoot = propertyRoot_(GblType_base(objectType, d));
+        if(pRoot) count += pRoot->count;
+    }
+
+    // Keep the index at most half full so misses terminate quickly
+    while(capacity < count * 2) capacity <<= 1;
+
+    const size_t entriesSize = gblAlignedAllocSizeDefault(sizeof(GblPropertyTable_) +
+                                                          sizeof(const GblProperty*) * count);
+
+    pTable = GBL_CTX_MALLOC(entriesSize + sizeof(GblPropertyTableSlot_) * capacity);
+    GBL_CTX_VERIFY(pTable, GBL_RESULT_ERROR_MEM_ALLOC);
+    memset(pTable, 0, entriesSize + sizeof(GblPropertyTableSlot_) * capacity);
+
+    pTable->generation = generation;
+    pTable->slotMask   = capacity - 1;
+    pTable->pSlots     = (GblPropertyTableSlot_*)((uint8_t*)pTable + entriesSize);
+
+    for(uint8_t d = 0; d <= depth; ++d) {
+        const GblPropertyRoot_* pRoot = propertyRoot_(GblType_base(objectType, d));
+        if(d == depth) pTable->ownOffset = pTable->count;
+        if(!pRoot) continue;
+
+        for(const GblProperty* pIt = GBL_PRIV(pRoot->base).pNext;
+            pIt && pTable->count < count;
+            pIt = GBL_PRIV_REF(pIt).pNext)
+        {
+            // Derived types are visited last, so their properties shadow any inherited ones
+            size_t s = propertyTableHash_(pIt->name) & pTable->slotMask;
+            while(pTable->pSlots[s].pProperty && pTable->pSlots[s].pProperty->name != pIt->name)
+                s = (s + 1) & pTable->slotMask;
+
+            pTable->pSlots[s].pProperty   = pIt;
+            pTable->pSlots[s].index       = pTable->count;
+            pTable->entries[pTable->count++] = pIt;
+        }
+    }
+
+    GBL_CTX_END_BLOCK();
+    return pTable;
+}
+
+/* Returns the generation a type's table must have been built from to be current.
+   Each install or uninstall bumps the generation of the type it happened on, so
+   only the tables of that type and of the types deriving from it go stale. */
+GBL_INLINE uint32_t propertyTableGeneration_(const GblMetaClass* pMeta) {
+    uint32_t generation = atomic_load_explicit(&pMeta->propertyGeneration, memory_order_acquire);
+
+    for(uint8_t d = 0; d < pMeta->depth; ++d)
+        generation += atomic_load_explicit(&pMeta->pBases[d]->propertyGeneration, memory_order_acquire);
+
+    return generation;
+}
+
+// Returns the up-to-date property table for the given type, rebuilding it if stale
+static const GblPropertyTable_* propertyTable_(GblType objectType) {
+    GblMetaClass* pMeta = GBL_META_CLASS_(objectType);
+    if GBL_UNLIKELY(!pMeta) return NULL;
+
+    const uint32_t     generation = propertyTableGeneration_(pMeta);
+    GblPropertyTable_* pTable     = atomic_load_explicit(&pMeta->pPropertyTable, memory_order_acquire);
+
+    if GBL_UNLIKELY(!pTable || pTable->generation != generation) {
+        GblPropertyTable_* pNew = propertyTableBuild_(objectType, generation);
+
+        if(pNew) {
+            // Whoever publishes first wins; a losing thread discards its own, never shared, copy
+            pNew->pRetired = pTable;
+            if(atomic_compare_exchange_strong(&pMeta->pPropertyTable, &pTable, pNew)) {
+                pTable = pNew;
+            } else {
+                GBL_CTX_BEGIN(pCtx_);
+                GBL_CTX_FREE(pNew);
+                GBL_CTX_END_BLOCK();
+            }
+        } else pTable = NULL; // A stale table may still point to uninstalled properties
+    }
+
+    return pTable;
+}
+
+static void propertyBump_(GblType objectType) {
+    GblMetaClass* pMeta = GBL_META_CLASS_(objectType);
+
+    if(pMeta)
+        atomic_fetch_add_explicit(&pMeta->propertyGeneration, 1, memory_order_acq_rel);
+}
+
+GBL_INLINE const GblPropertyTableSlot_* propertyTableFind_(const GblPropertyTable_* pTable, GblQuark name) {
+    size_t s = propertyTableHash_(name) & pTable->slotMask;
+
+    while(pTable->pSlots[s].pProperty) {
+        if(pTable->pSlots[s].pProperty->name == name)
+            return &pTable->pSlots[s];
+        s = (s + 1) & pTable->slotMask;
+    }
+
+    return NULL;
+}
+
+extern void GblProperty_tableDestroy_(GblMetaClass* pMeta) {
+    GblPropertyTable_* pTable = atomic_exchange(&pMeta->pPropertyTable, NULL);
+
+    GBL_CTX_BEGIN(pCtx_);
+    while(pTable) {
+        GblPropertyTable_* pRetired = pTable->pRetired;
+        GBL_CTX_FREE(pTable);
+        pTable = pRetired;
+    }
+    GBL_CTX_END_BLOCK();
+}
+
 // Returns the very first starting property for a given type.
 GBL_INLINE const GblPropertyRoot_* propertyRootBase_(GblType objectType) {
     const GblPropertyRoot_* pRoot = NULL;
@@ -172,23 +321,17 @@ GBL_EXPORT GBL_RESULT GblProperty_createOrConstruct(GblProperty** ppSelf,
 
 GBL_EXPORT const GblProperty* GblProperty_findQuark(GblType objectType, GblQuark name) {
     const GblProperty* pProperty = NULL;
-    GBL_CTX_BEGIN(GblHashSet_context(&propertyRegistry_)); {
+    GBL_CTX_BEGIN_LEAF(NULL); {
         GBL_CTX_VERIFY(name != GBL_QUARK_INVALID,
                        GBL_RESULT_ERROR_INVALID_PROPERTY);
-        GblProperty* pKey             = GBL_ALLOCA(sizeof(GblProperty));
-        pKey->name                    = name;
-        GBL_PRIV_REF(pKey).objectType = objectType;
-
-        while(GBL_PRIV_REF(pKey).objectType != GBL_INVALID_TYPE) {
-            const GblProperty** ppRet = (const GblProperty**)GblHashSet_get(&propertyRegistry_, &pKey);
-            if(ppRet) {
-                pProperty = *ppRet;
-                break;
-            }
-            GBL_PRIV_REF(pKey).objectType = GblType_parent(GBL_PRIV_REF(pKey).objectType);
+
+        const GblPropertyTable_* pTable = propertyTable_(objectType);
+        if(pTable) {
+            const GblPropertyTableSlot_* pSlot = propertyTableFind_(pTable, name);
+            if(pSlot) pProperty = pSlot->pProperty;
         }
 
-    } GBL_CTX_END_BLOCK();
+    } GBL_CTX_END_LEAF_BLOCK();
     return pProperty;
 }
 
@@ -206,11 +349,13 @@ GBL_EXPORT GblBool GblProperty_foreach(GblType           objectType,
     GBL_CTX_VERIFY_TYPE(objectType);
     GBL_CTX_VERIFY_POINTER(pFnIt);
 
-    const size_t  depth = GblType_depth(objectType);
-    for(size_t  d = 0; d <= depth; ++d) {
-        const GblType curType = GblType_base(objectType, d);
-        const GblProperty* pProp = NULL;
-        while((pProp = GblProperty_next(curType, pProp, flags))) {
+    const GblPropertyTable_* pTable = propertyTable_(objectType);
+    GBL_CTX_VERIFY_POINTER(pTable);
+
+    // Overrides are skipped in favor of the base property they redeclare
+    for(size_t e = 0; e < pTable->count; ++e) {
+        const GblProperty* pProp = pTable->entries[e];
+        if((pProp->flags & flags) && !(pProp->flags & GBL_PROPERTY_FLAG_OVERRIDE)) {
             if(pFnIt(pProp, pClosure)) {
                 result = GBL_TRUE;
                 GBL_CTX_DONE();
@@ -225,30 +370,27 @@ GBL_EXPORT GblBool GblProperty_foreach(GblType           objectType,
 GBL_EXPORT const GblProperty* GblProperty_next(GblType objectType, const GblProperty* pPrev, GblFlags mask) {
     const GblProperty* pNext = NULL;
     GBL_CTX_BEGIN(GblHashSet_context(&propertyRegistry_));
-    const GblProperty* pIt = NULL;
-
-    // We're first starting, grab the root node of the first type with a property entry
-    if(!pPrev) {
-        pIt = (GblProperty*)propertyRoot_(objectType);
-        // Skip types which don't have the flag we're looking for
-        if(!pIt || !(pIt->flags&mask))
-            GBL_CTX_DONE();
-    // We're continuing from an existing node
-    } else {
-        pIt = pPrev;
-    }
 
-    // while on unacceptable node
-    while(pIt) {
+    const GblPropertyTable_* pTable = propertyTable_(objectType);
+    if(!pTable) GBL_CTX_DONE();
 
-        // regular next node
-        if(GBL_PRIV_REF(pIt).pNext) {
-            pIt = GblProperty_findQuark(objectType, GBL_PRIV_REF(pIt).pNext->name);
-        //beginning of new type
+    // Only properties installed onto the type itself, which trail the inherited ones
+    size_t e = pTable->ownOffset;
+
+    // We're continuing from an existing node
+    if(pPrev) {
+        const GblPropertyTableSlot_* pSlot = propertyTableFind_(pTable, pPrev->name);
+
+        if(pSlot && pSlot->pProperty == pPrev) {
+            e = pSlot->index + 1;
         } else {
-            break;
+            while(e < pTable->count && pTable->entries[e] != pPrev) ++e;
+            ++e;
         }
+    }
 
+    for(; e < pTable->count; ++e) {
+        const GblProperty* pIt = pTable->entries[e];
         // Check if the mask matches and skip overrides!!
         if((pIt->flags & mask) && !(pIt->flags & GBL_PROPERTY_FLAG_OVERRIDE)) {
             pNext = pIt;
@@ -341,6 +483,8 @@ GBL_EXPORT GBL_RESULT GblProperty_install(GblType objectType, GblProperty* pProp
     GblBool isFirst = GblHashSet_insert(&propertyRegistry_, &pProperty);
     if(!isFirst) GBL_CTX_WARN("Overwrote existing property!");
 
+    propertyBump_(GBL_PRIV_REF(pProperty).objectType);
+
     GBL_CTX_END();
 }
 
@@ -390,6 +534,8 @@ GBL_EXPORT GblBool GblProperty_uninstallQuark(GblType objectType, GblQuark name)
         if(!pRoot->count) {
             success = GblHashSet_erase(&propertyRegistry_, &pRoot);
         }
+
+        propertyBump_(objectType);
     }
     GBL_CTX_END_BLOCK();
     return success;
@@ -445,15 +591,8 @@ GBL_EXPORT int GblProperty_compareValues(const GblProperty* pSelf, const GblVari
 }
 
 GBL_EXPORT size_t  GblProperty_count(GblType objectType) {
-    size_t  count = 0;
-    while(objectType != GBL_INVALID_TYPE) {
-        const GblPropertyRoot_* pRoot = propertyRoot_(objectType);
-        if(pRoot) {
-            count += pRoot->count;
-        }
-        objectType = GblType_parent(objectType);
-    }
-    return count;
+    const GblPropertyTable_* pTable = propertyTable_(objectType);
+    return pTable? pTable->count : 0;
 }
 
 GBL_EXPORT GblFlags GblProperty_combinedFlags(GblType objectType) {
@@ -106,6 +106,35 @@ GBL_EXPORT GBL_RESULT GblClosure_invoke(GblClosure* pSelf,
     GBL_CTX_END();
 }
 
+GBL_EXPORT GBL_RESULT GblClosure_invokeVa(GblClosure*    pSelf,
+                                          GblMarshalVaFn pFnVaMarshal,
+                                          GblVariant*    pRetValue,
+                                          void*          pInstance,
+                                          va_list*       pArgs,
+                                          size_t         argCount,
+                                          const GblType* pParamTypes)
+{
+    GBL_CTX_BEGIN_LEAF(NULL);
+    GBL_CTX_VERIFY_POINTER(pFnVaMarshal);
+    GBL_CTX_VERIFY_POINTER(pArgs);
+
+    GblClosure* prevActiveClosure = pCurrentClosure_;
+    pCurrentClosure_ = pSelf;
+
+    const GBL_RESULT result = pFnVaMarshal(pSelf,
+                                           pRetValue,
+                                           pInstance,
+                                           *pArgs,
+                                           NULL,
+                                           argCount,
+                                           pParamTypes);
+
+    pCurrentClosure_ = prevActiveClosure;
+
+    GBL_CTX_VERIFY_CALL(result);
+    GBL_CTX_END_LEAF();
+}
+
 GBL_EXPORT GblType GblClosure_type(void) {
     static GblType type = GBL_INVALID_TYPE;
 
@@ -5,6 +5,25 @@
 #include <gimbal/meta/signals/gimbal_signal_closure.h>
 #include <gimbal/meta/types/gimbal_variant.h>
 #include <gimbal/meta/signals/gimbal_signal.h>
+#include <gimbal/meta/classes/gimbal_enum.h>
+#include <gimbal/meta/classes/gimbal_flags.h>
+
+#define GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(paramsPostfix, paramList, argList)                  \
+    static GBL_RESULT GblMarshal_CClosureVa_VOID__##paramsPostfix##_(GblClosure*    pClosure,     \
+                                                                     GblVariant*    pRetValue,    \
+                                                                     void*          pInstance,    \
+                                                                     va_list        args,         \
+                                                                     void*          pMarshalData, \
+                                                                     size_t         argCount,     \
+                                                                     const GblType* pParamTypes)  \
+    {                                                                                             \
+        GBL_UNUSED(pRetValue, argCount, pParamTypes);                                             \
+        typedef void (*CFunction)(GBL_EVAL paramList);                                            \
+        CFunction pFnPtr = (CFunction)(pMarshalData?                                              \
+                            (GblFnPtr)pMarshalData : GBL_PRIV_REF((GblCClosure*)pClosure).pFnCallback); \
+        pFnPtr(GBL_EVAL argList);                                                                 \
+        return GBL_RESULT_SUCCESS;                                                                \
+    }
 
 GBL_EXPORT GBL_RESULT GblCClosureMarshal_VOID__VOID(GblClosure* pClosure,
                                                     GblVariant* pRetValue,
@@ -131,6 +150,178 @@ GBL_DEFINE_CCLOSURE_MARSHAL_VOID__(INSTANCE_INSTANCE_SIZE,
                                    (GblVariant_toPointer(&pArgs[0]), GblVariant_toPointer(&pArgs[1]), GblVariant_toSize(&pArgs[2])));
 
 
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE,
+                                      (GblInstance*),
+                                      (pInstance))
+
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE_BOOL,
+                                      (GblInstance*, GblBool),
+                                      (pInstance, va_arg(args, int) != 0))
+
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE_CHAR,
+                                      (GblInstance*, char),
+                                      (pInstance, (char)va_arg(args, int)))
+
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE_UINT8,
+                                      (GblInstance*, uint8_t),
+                                      (pInstance, (uint8_t)va_arg(args, int)))
+
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE_UINT16,
+                                      (GblInstance*, uint16_t),
+                                      (pInstance, (uint16_t)va_arg(args, int)))
+
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE_INT16,
+                                      (GblInstance*, int16_t),
+                                      (pInstance, (int16_t)va_arg(args, int)))
+
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE_UINT32,
+                                      (GblInstance*, uint32_t),
+                                      (pInstance, va_arg(args, uint32_t)))
+
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE_INT32,
+                                      (GblInstance*, int32_t),
+                                      (pInstance, va_arg(args, int32_t)))
+
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE_UINT64,
+                                      (GblInstance*, uint64_t),
+                                      (pInstance, va_arg(args, uint64_t)))
+
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE_INT64,
+                                      (GblInstance*, int64_t),
+                                      (pInstance, va_arg(args, int64_t)))
+
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE_SIZE,
+                                      (GblInstance*, size_t),
+                                      (pInstance, va_arg(args, size_t)))
+
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE_FLOAT,
+                                      (GblInstance*, float),
+                                      (pInstance, (float)va_arg(args, double)))
+
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE_DOUBLE,
+                                      (GblInstance*, double),
+                                      (pInstance, va_arg(args, double)))
+
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE_ENUM,
+                                      (GblInstance*, GblEnum),
+                                      (pInstance, va_arg(args, uint32_t)))
+
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE_FLAGS,
+                                      (GblInstance*, GblFlags),
+                                      (pInstance, va_arg(args, uint32_t)))
+
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE_POINTER,
+                                      (GblInstance*, void*),
+                                      (pInstance, va_arg(args, void*)))
+
+GBL_DEFINE_CCLOSURE_MARSHAL_VA_VOID__(INSTANCE_BOX,
+                                      (GblInstance*, GblBox*),
+                                      (pInstance, va_arg(args, GblBox*)))
+
+// Written out by hand, since argument evaluation order would leave multiple va_arg() reads unsequenced
+static GBL_RESULT GblMarshal_CClosureVa_VOID__INSTANCE_INSTANCE_SIZE_(GblClosure*    pClosure,
+                                                                     GblVariant*    pRetValue,
+                                                                     void*          pInstance,
+                                                                     va_list        args,
+                                                                     void*          pMarshalData,
+                                                                     size_t         argCount,
+                                                                     const GblType* pParamTypes)
+{
+    GBL_UNUSED(pRetValue, argCount, pParamTypes);
+    typedef void (*CFunction)(GblInstance*, GblInstance*, size_t);
+    CFunction pFnPtr = (CFunction)(pMarshalData?
+                        (GblFnPtr)pMarshalData : GBL_PRIV_REF((GblCClosure*)pClosure).pFnCallback);
+
+    GblInstance* pArg1 = va_arg(args, GblInstance*);
+    size_t       arg2  = va_arg(args, size_t);
+
+    pFnPtr(pInstance, pArg1, arg2);
+    return GBL_RESULT_SUCCESS;
+}
+
+// Whether a parameter type is read from a va_list as the exact C type a marshal passes on
+static GblBool GblMarshal_paramMatches_(GblType paramType, GblType expected) {
+    return paramType == expected;
+}
+
+static GblBool GblMarshal_paramDerives_(GblType paramType, GblType expected) {
+    return GblType_derives(paramType, expected);
+}
+
+GBL_EXPORT GblMarshalVaFn GblMarshal_CClosureVa(GblMarshalFn   pFnMarshal,
+                                                size_t         argCount,
+                                                const GblType* pParamTypes)
+{
+    typedef GblBool (*ParamCheckFn)(GblType paramType, GblType expected);
+
+    GblMarshalVaFn pFnVa     = NULL;
+    GblType        expected[2];
+    ParamCheckFn   pFnCheck  = GblMarshal_paramMatches_;
+    size_t         count     = 1;
+
+#define GBL_MARSHAL_VA_CASE_(postFix, type)                                 \
+    else if(pFnMarshal == GblMarshal_CClosure_VOID__##postFix) {            \
+        pFnVa       = GblMarshal_CClosureVa_VOID__##postFix##_;             \
+        expected[0] = type;                                                 \
+    }
+
+    if(pFnMarshal == GblMarshal_CClosure_VOID__INSTANCE) {
+        pFnVa = GblMarshal_CClosureVa_VOID__INSTANCE_;
+        count = 0;
+    }
+    GBL_MARSHAL_VA_CASE_(INSTANCE_BOOL,    GBL_BOOL_TYPE)
+    GBL_MARSHAL_VA_CASE_(INSTANCE_CHAR,    GBL_CHAR_TYPE)
+    GBL_MARSHAL_VA_CASE_(INSTANCE_UINT8,   GBL_UINT8_TYPE)
+    GBL_MARSHAL_VA_CASE_(INSTANCE_UINT16,  GBL_UINT16_TYPE)
+    GBL_MARSHAL_VA_CASE_(INSTANCE_INT16,   GBL_INT16_TYPE)
+    GBL_MARSHAL_VA_CASE_(INSTANCE_UINT32,  GBL_UINT32_TYPE)
+    GBL_MARSHAL_VA_CASE_(INSTANCE_INT32,   GBL_INT32_TYPE)
+    GBL_MARSHAL_VA_CASE_(INSTANCE_UINT64,  GBL_UINT64_TYPE)
+    GBL_MARSHAL_VA_CASE_(INSTANCE_INT64,   GBL_INT64_TYPE)
+    GBL_MARSHAL_VA_CASE_(INSTANCE_SIZE,    GBL_SIZE_TYPE)
+    GBL_MARSHAL_VA_CASE_(INSTANCE_FLOAT,   GBL_FLOAT_TYPE)
+    GBL_MARSHAL_VA_CASE_(INSTANCE_DOUBLE,  GBL_DOUBLE_TYPE)
+    GBL_MARSHAL_VA_CASE_(INSTANCE_POINTER, GBL_POINTER_TYPE)
+    else if(pFnMarshal == GblMarshal_CClosure_VOID__INSTANCE_INSTANCE) {
+        pFnVa       = GblMarshal_CClosureVa_VOID__INSTANCE_POINTER_;
+        expected[0] = GBL_POINTER_TYPE;
+    }
+    else if(pFnMarshal == GblMarshal_CClosure_VOID__INSTANCE_INSTANCE_SIZE) {
+        pFnVa       = GblMarshal_CClosureVa_VOID__INSTANCE_INSTANCE_SIZE_;
+        expected[0] = GBL_POINTER_TYPE;
+        expected[1] = GBL_SIZE_TYPE;
+        count       = 2;
+    }
+    // Enums, flags and boxes are stored as-is within their variants, so derived types work too
+    else if(pFnMarshal == GblMarshal_CClosure_VOID__INSTANCE_ENUM) {
+        pFnVa       = GblMarshal_CClosureVa_VOID__INSTANCE_ENUM_;
+        expected[0] = GBL_ENUM_TYPE;
+        pFnCheck    = GblMarshal_paramDerives_;
+    }
+    else if(pFnMarshal == GblMarshal_CClosure_VOID__INSTANCE_FLAGS) {
+        pFnVa       = GblMarshal_CClosureVa_VOID__INSTANCE_FLAGS_;
+        expected[0] = GBL_FLAGS_TYPE;
+        pFnCheck    = GblMarshal_paramDerives_;
+    }
+    else if(pFnMarshal == GblMarshal_CClosure_VOID__INSTANCE_BOX) {
+        pFnVa       = GblMarshal_CClosureVa_VOID__INSTANCE_BOX_;
+        expected[0] = GBL_BOX_TYPE;
+        pFnCheck    = GblMarshal_paramDerives_;
+    }
+
+#undef GBL_MARSHAL_VA_CASE_
+
+    if(pFnVa && argCount == count) {
+        for(size_t p = 0; p < count; ++p)
+            if(!pFnCheck(pParamTypes[p], expected[p]))
+                return NULL;
+
+        return pFnVa;
+    }
+
+    return NULL;
+}
+
 GBL_EXPORT GBL_RESULT GblMarshal_ClassClosureMeta(GblClosure*        pClosure,
                                                   GblVariant*        pRetValue,
                                                   size_t             argCount,
@@ -2,12 +2,13 @@
 #include <gimbal/meta/signals/gimbal_c_closure.h>
 #include <gimbal/meta/signals/gimbal_class_closure.h>
 #include <gimbal/meta/signals/gimbal_signal_closure.h>
-#include <gimbal/containers/gimbal_hash_set.h>
+#include <gimbal/containers/gimbal_concurrent_hash_set.h>
 #include <gimbal/containers/gimbal_array_map.h>
 #include <gimbal/containers/gimbal_array_list.h>
 #include <gimbal/containers/gimbal_doubly_linked_list.h>
 #include <gimbal/allocators/gimbal_pool_allocator.h>
 #include "../types/gimbal_type_.h"
+#include "../../core/gimbal_thread_.h"
 
 #define GBL_CONNECTION_POOL_ALLOCATOR_
 
@@ -25,10 +26,19 @@ typedef struct Signal_ {
     GblQuark        name;
     //GblLinkedListnNode next;
     GblMarshalFn    pFnCMarshal;
+    GblMarshalVaFn  pFnVaMarshal;   // direct va_list equivalent of pFnCMarshal, if any
     size_t          argCount;
     GblType         argTypes[];
 } Signal_;
 
+// Shared between a queued connection and its undelivered emissions, outliving whichever goes last
+typedef struct QueuedTarget_ {
+    atomic_size_t   refCount;
+    atomic_bool     connected;
+    GblThread*      pThread;
+    GblClosure*     pClosure;
+} QueuedTarget_;
+
 typedef struct Connection_ {
     GblDoublyLinkedListNode emitterList;
     GblDoublyLinkedListNode receiverList;
@@ -36,8 +46,20 @@ typedef struct Connection_ {
     GblInstance*            pReceiver;
     const Signal_*          pSignal;
     GblClosure*             pClosure;
+    GblBool                 cClosure;   // plain GblCClosure, a candidate for direct emission
+    QueuedTarget_*          pQueue;     // thread emissions get posted to, for queued connections
 } Connection_;
 
+// Argument frame of a single queued emission, posted to the target thread's event queue
+typedef struct QueuedEmission_ {
+    GblThreadEvent_ base;
+    QueuedTarget_*  pTarget;
+    GblInstance*    pEmitter;
+    GblInstance*    pReceiver;
+    size_t          argCount;
+    GblVariant      args[];
+} QueuedEmission_;
+
 typedef struct EmitterHandler_ {
     GblDoublyLinkedListNode connectionList;
     GblBool                 blocked;
@@ -50,7 +72,7 @@ typedef struct InstanceConnectionTable_ {
     GblBool                     signalsBlocked;
 } InstanceConnectionTable_;
 
-static GblHashSet       signalSet_;
+static GblConcurrentHashSet signalSet_;
 static GblHashSet       instanceConnectionTableSet_;
 #ifdef GBL_CONNECTION_POOL_ALLOCATOR_
 static GblPoolAllocator connectionAllocator_;
@@ -58,22 +80,22 @@ static GblPoolAllocator connectionAllocator_;
 
 static GBL_THREAD_LOCAL Connection_* pActiveConnection_ = NULL;
 
-static GblHash signalSetHasher_(const GblHashSet* pSet, const void* pEntry) {
+static GblHash signalSetHasher_(const GblConcurrentHashSet* pSet, const void* pEntry) {
     GBL_UNUSED(pSet);
     const Signal_* pSignal = *(const Signal_**)pEntry;
     return gblHash(pSignal, sizeof(GblType) + sizeof(GblQuark));
 }
 
-static GblBool signalSetComparator_(const GblHashSet* pSet, const void* pEntry1, const void* pEntry2) {
+static GblBool signalSetComparator_(const GblConcurrentHashSet* pSet, const void* pEntry1, const void* pEntry2) {
     GBL_UNUSED(pSet);
     const Signal_* pSignal1 = *(const Signal_**)pEntry1;
     const Signal_* pSignal2 = *(const Signal_**)pEntry2;
     return pSignal1->ownerType == pSignal2->ownerType && pSignal1->name == pSignal2->name;
 }
 
-static void signalSetDestructor_(const GblHashSet* pSet, void* pEntry) {
+static void signalSetDestructor_(const GblConcurrentHashSet* pSet, void* pEntry) {
     GBL_UNUSED(pSet);
-    GBL_CTX_BEGIN(GblHashSet_context(pSet));
+    GBL_CTX_BEGIN(GblConcurrentHashSet_context(pSet));
     GBL_CTX_FREE(*(Signal_**)pEntry);
     GBL_CTX_END_BLOCK();
 }
@@ -88,7 +110,7 @@ GBL_EXPORT GBL_RESULT GblSignal_install(GblType      ownerType,
     va_start(varArgs, argCount);
     Signal_* pSignal = NULL;
 
-    GBL_CTX_BEGIN(GblHashSet_context(&signalSet_));
+    GBL_CTX_BEGIN(GblConcurrentHashSet_context(&signalSet_));
     GBL_CTX_PUSH_VERBOSE("[GblSignal] Installing signal: [%s::%s]",
                          GblType_name(ownerType),
                          pName);
@@ -112,9 +134,12 @@ GBL_EXPORT GBL_RESULT GblSignal_install(GblType      ownerType,
         GBL_CTX_VERIFY_TYPE(pSignal->argTypes[a]);
     }
 
-    void* pExisting = GblHashSet_set(&signalSet_, &pSignal);
+    // Precompute whether emitted va_lists can be passed to GblCClosures without GblVariants
+    pSignal->pFnVaMarshal = pFnCMarshal? GblMarshal_CClosureVa(pFnCMarshal,
+                                                               argCount,
+                                                               pSignal->argTypes) : NULL;
 
-    if(pExisting) {
+    if(GblConcurrentHashSet_set(&signalSet_, &pSignal)) {
         GBL_CTX_WARN("Overwrote existing signal! [%s::%s]",
                      GblType_name(ownerType),
                      pName);
@@ -135,7 +160,7 @@ GBL_EXPORT GBL_RESULT GblSignal_install(GblType      ownerType,
 GBL_EXPORT GBL_RESULT GblSignal_uninstall(GblType     ownerType,
                                           const char* pName)
 {
-    GBL_CTX_BEGIN(GblHashSet_context(&signalSet_));
+    GBL_CTX_BEGIN(GblConcurrentHashSet_context(&signalSet_));
     GBL_CTX_PUSH_VERBOSE("[GblSignal] Uninstalling signal: [%s::%s]",
                          GblType_name(ownerType), pName);
 
@@ -143,7 +168,7 @@ GBL_EXPORT GBL_RESULT GblSignal_uninstall(GblType     ownerType,
     pKey->ownerType = ownerType;
     pKey->name      = GblQuark_fromString(pName);
 
-    GBL_CTX_VERIFY(GblHashSet_erase(&signalSet_, &pKey),
+    GBL_CTX_VERIFY(GblConcurrentHashSet_erase(&signalSet_, &pKey),
                    GBL_RESULT_ERROR_INVALID_HANDLE);
 
     GBL_CTX_POP(1);
@@ -151,7 +176,7 @@ GBL_EXPORT GBL_RESULT GblSignal_uninstall(GblType     ownerType,
 }
 
 GBL_EXPORT GBL_RESULT GblSignal_uninstallAll(GblType ownerType) {
-    GBL_CTX_BEGIN(GblHashSet_context(&signalSet_));
+    GBL_CTX_BEGIN(GblConcurrentHashSet_context(&signalSet_));
     GBL_CTX_PUSH_VERBOSE("[GblSignal] Uninstalling all signals: [%s]",
                          GblType_name(ownerType));
 
@@ -175,11 +200,8 @@ static Signal_* Signal_findByQuark_(GblType     ownerType,
         pKey->ownerType = curType;
 
         // check current type
-        Signal_** ppSignal = GblHashSet_get(&signalSet_, &pKey);
-        if(ppSignal) {
-            pSignal = *ppSignal;
+        if(GblConcurrentHashSet_get(&signalSet_, &pKey, &pSignal))
             break;
-        }
 
         // check interfaces on current type
         const GblMetaClass* pMeta = GBL_META_CLASS_(curType);
@@ -366,7 +388,8 @@ static GBL_RESULT Signal_connect_(GblInstance*   pEmitter,
                                   const char*    pName,
                                   GblQuark       name,
                                   GblInstance*   pReceiver,
-                                  GblClosure*    pClosure)
+                                  GblClosure*    pClosure,
+                                  GblThread*     pQueueThread)
 {
     GBL_CTX_BEGIN(GblHashSet_context(&instanceConnectionTableSet_));
     GBL_CTX_VERIFY_POINTER(pEmitter);
@@ -396,12 +419,24 @@ static GBL_RESULT Signal_connect_(GblInstance*   pEmitter,
     // Initialize closure
     if(!GblClosure_hasMarshal(pClosure)) GblClosure_setMarshal(pClosure, pSignal->pFnCMarshal);
 
+    // Queued connections share their closure and target thread with pending emissions
+    QueuedTarget_* pQueue = NULL;
+    if(pQueueThread) {
+        pQueue = GBL_CTX_MALLOC(sizeof(QueuedTarget_));
+        atomic_init(&pQueue->refCount, 1);
+        atomic_init(&pQueue->connected, GBL_TRUE);
+        pQueue->pThread  = GBL_THREAD(GBL_REF(pQueueThread));
+        pQueue->pClosure = GBL_CLOSURE(GBL_REF(pClosure));
+    }
+
     Connection_* pConnection = GBL_CONNECTION_NEW_();
     memset(pConnection, 0, sizeof(Connection_));
     pConnection->pEmitter   = pEmitter;
     pConnection->pReceiver  = pReceiver;
     pConnection->pSignal    = pSignal;
     pConnection->pClosure   = pClosure;
+    pConnection->cClosure   = GBL_TYPEOF(pClosure) == GBL_C_CLOSURE_TYPE;
+    pConnection->pQueue     = pQueue;
 
     // Add connection to receiver list
     GblDoublyLinkedList_pushBack(&pReceiverTable->receiverConnections,
@@ -430,7 +465,7 @@ GBL_EXPORT GBL_RESULT (GblSignal_connect)(GblInstance* pEmitter,
         return GBL_RESULT_ERROR_INVALID_POINTER;
     else {
         GblCClosure* pCClosure = GblCClosure_create(pFnCCallback, pUserdata);
-        return Signal_connect_(pEmitter, pSignalName, GBL_QUARK_INVALID, pReceiver, GBL_CLOSURE(pCClosure));
+        return Signal_connect_(pEmitter, pSignalName, GBL_QUARK_INVALID, pReceiver, GBL_CLOSURE(pCClosure), NULL);
     }
 }
 
@@ -447,7 +482,7 @@ GBL_EXPORT GBL_RESULT GblSignal_connectClass(GblInstance* pEmitter,
     GBL_CTX_VERIFY_ARG(methodOffset >= sizeof(GblClass));
 
     GblClassClosure* pCClosure = GblClassClosure_create(classType, methodOffset, pReceiver, NULL);
-    GBL_CTX_VERIFY_CALL(Signal_connect_(pEmitter, pSignalName, GBL_QUARK_INVALID, pReceiver, GBL_CLOSURE(pCClosure)));
+    GBL_CTX_VERIFY_CALL(Signal_connect_(pEmitter, pSignalName, GBL_QUARK_INVALID, pReceiver, GBL_CLOSURE(pCClosure), NULL));
 
     GBL_CTX_END();
 }
@@ -468,7 +503,7 @@ GBL_EXPORT GBL_RESULT GblSignal_connectSignal(GblInstance* pEmitter,
                    GBL_RESULT_ERROR_INVALID_HANDLE);
 
     GblSignalClosure* pSignalClosure = GblSignalClosure_create(pDstSignalName, NULL);
-    GBL_CTX_VERIFY_CALL(Signal_connect_(pEmitter, pSignalName, GBL_QUARK_INVALID, pDstEmitter, GBL_CLOSURE(pSignalClosure)));
+    GBL_CTX_VERIFY_CALL(Signal_connect_(pEmitter, pSignalName, GBL_QUARK_INVALID, pDstEmitter, GBL_CLOSURE(pSignalClosure), NULL));
 
     GBL_CTX_END();
 }
@@ -478,15 +513,120 @@ GBL_EXPORT GBL_RESULT GblSignal_connectClosure(GblInstance* pInstance,
                                                GblInstance* pReceiver,
                                                GblClosure*  pClosure)
 {
-    return pClosure? Signal_connect_(pInstance, pName, GBL_QUARK_INVALID, pReceiver, pClosure) :
+    return pClosure? Signal_connect_(pInstance, pName, GBL_QUARK_INVALID, pReceiver, pClosure, NULL) :
+                     GBL_RESULT_ERROR_INVALID_POINTER;
+}
+
+GBL_EXPORT GBL_RESULT GblSignal_connectQueued(GblInstance* pEmitter,
+                                              const char*  pSignalName,
+                                              GblInstance* pReceiver,
+                                              GblFnPtr     pFnCCallback,
+                                              void*        pUserdata,
+                                              GblThread*   pThread)
+{
+    if(!pFnCCallback)
+        return GBL_RESULT_ERROR_INVALID_POINTER;
+    else {
+        GblCClosure* pCClosure = GblCClosure_create(pFnCCallback, pUserdata);
+        return Signal_connect_(pEmitter, pSignalName, GBL_QUARK_INVALID, pReceiver, GBL_CLOSURE(pCClosure),
+                               pThread? pThread : GblThread_current());
+    }
+}
+
+GBL_EXPORT GBL_RESULT GblSignal_connectClosureQueued(GblInstance* pEmitter,
+                                                     const char*  pSignalName,
+                                                     GblInstance* pReceiver,
+                                                     GblClosure*  pClosure,
+                                                     GblThread*   pThread)
+{
+    return pClosure? Signal_connect_(pEmitter, pSignalName, GBL_QUARK_INVALID, pReceiver, pClosure,
+                                     pThread? pThread : GblThread_current()) :
                      GBL_RESULT_ERROR_INVALID_POINTER;
 }
 
+static void QueuedTarget_unref_(QueuedTarget_* pSelf) {
+    if(atomic_fetch_sub_explicit(&pSelf->refCount, 1, memory_order_acq_rel) == 1) {
+        GBL_CTX_BEGIN(GblHashSet_context(&instanceConnectionTableSet_));
+        GBL_UNREF(pSelf->pClosure);
+        GBL_CTX_FREE(pSelf);
+        GBL_CTX_END_BLOCK();
+    }
+}
+
+static GBL_RESULT QueuedEmission_deliver_(GblThreadEvent_* pEvent, GblBool discard) {
+    QueuedEmission_* pSelf   = (QueuedEmission_*)pEvent;
+    QueuedTarget_*   pTarget = pSelf->pTarget;
+
+    GBL_CTX_BEGIN(GblHashSet_context(&instanceConnectionTableSet_));
+
+    // emissions from connections which have since been disconnected are dropped
+    if(!discard && atomic_load_explicit(&pTarget->connected, memory_order_acquire)) {
+        // stand-in for the connection, so GblSignal_emitter() and GblSignal_receiver() still work
+        Connection_ active = {
+            .pEmitter  = pSelf->pEmitter,
+            .pReceiver = pSelf->pReceiver,
+            .pClosure  = pTarget->pClosure
+        };
+
+        Connection_* pOldConnection = pActiveConnection_;
+        pActiveConnection_ = &active;
+
+        GBL_CTX_CALL(GblClosure_invoke(pTarget->pClosure,
+                                       NULL,
+                                       pSelf->argCount,
+                                       pSelf->args));
+
+        pActiveConnection_ = pOldConnection;
+    }
+
+    for(size_t a = 0; a < pSelf->argCount; ++a)
+        GblVariant_destruct(&pSelf->args[a]);
+
+    QueuedTarget_unref_(pTarget);
+    GBL_CTX_FREE(pSelf);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT QueuedEmission_post_(const Connection_* pConnection,
+                                       const GblVariant*  pArgs,
+                                       size_t             argCount)
+{
+    GBL_CTX_BEGIN(GblHashSet_context(&instanceConnectionTableSet_));
+
+    QueuedEmission_* pEmission = GBL_CTX_MALLOC(sizeof(QueuedEmission_) +
+                                                sizeof(GblVariant) * argCount);
+
+    pEmission->base.pFnDeliver = QueuedEmission_deliver_;
+    pEmission->pTarget         = pConnection->pQueue;
+    pEmission->pEmitter        = pConnection->pEmitter;
+    pEmission->pReceiver       = pConnection->pReceiver;
+    pEmission->argCount        = argCount;
+
+    atomic_fetch_add_explicit(&pEmission->pTarget->refCount, 1, memory_order_relaxed);
+
+    // the frame owns copies of every argument, since the emitter's go out of scope
+    GblVariant_constructPointer(&pEmission->args[0], GBL_POINTER_TYPE, pConnection->pReceiver);
+    for(size_t a = 1; a < argCount; ++a)
+        GblVariant_constructCopy(&pEmission->args[a], &pArgs[a]);
+
+    GblThread_postEvent_(pConnection->pQueue->pThread, &pEmission->base);
+
+    GBL_CTX_END();
+}
+
 GBL_INLINE GBL_RESULT deleteConnection_(Connection_* pConnection) {
     GBL_CTX_BEGIN(GblHashSet_context(&instanceConnectionTableSet_));
 
     GblDoublyLinkedList_remove(&pConnection->emitterList);
     GblDoublyLinkedList_remove(&pConnection->receiverList);
+
+    if(pConnection->pQueue) {
+        atomic_store_explicit(&pConnection->pQueue->connected, GBL_FALSE, memory_order_release);
+        GBL_UNREF(pConnection->pQueue->pThread);
+        QueuedTarget_unref_(pConnection->pQueue);
+    }
+
     GBL_UNREF(pConnection->pClosure);
     GBL_CONNECTION_DELETE_(pConnection);
 
@@ -704,13 +844,44 @@ GBL_EXPORT size_t  GblSignal_connectionCount(GblInstance* pInstance,
     return count;
 }
 
+// Constructs the receiver followed by the emitted arguments as the variant arguments for a closure
+static GBL_RESULT Signal_constructArgs_(const Signal_* pSignal,
+                                        GblVariant*    pArgValues,
+                                        GblInstance*   pReceiver,
+                                        va_list*       pVarArgs,
+                                        GblVariant*    pVariantArgs)
+{
+    GBL_CTX_BEGIN_LEAF(NULL);
+
+    GBL_CTX_VERIFY_CALL(GblVariant_constructPointer(&pArgValues[0], GBL_POINTER_TYPE, pReceiver));
+
+    if(pVarArgs) {
+        va_list args;
+        va_copy(args, *pVarArgs);
+        for(size_t a = 1; a <= pSignal->argCount; ++a) {
+            GBL_CTX_CALL(GblVariant_constructValueCopyVa(&pArgValues[a],
+                                                         pSignal->argTypes[a-1],
+                                                         &args));
+        }
+        va_end(args);
+        GBL_CTX_VERIFY_LAST_RECORD();
+    } else if(pVariantArgs) {
+        for(size_t  a = 1; a <= pSignal->argCount; ++a) {
+            GBL_CTX_VERIFY_CALL(GblVariant_constructCopy(&pArgValues[a],
+                                                         &pVariantArgs[a-1]));
+        }
+    } else GBL_CTX_RECORD_SET(GBL_RESULT_ERROR_INVALID_OPERATION);
+
+    GBL_CTX_END_LEAF();
+}
+
 static GBL_RESULT GblSignal_emit_(GblInstance* pEmitter,
                                   const char*  pSignalName,
                                   va_list*     pVarArgs,
                                   GblVariant*  pVariantArgs)
 {
 
-    GBL_CTX_BEGIN(GblHashSet_context(&instanceConnectionTableSet_));
+    GBL_CTX_BEGIN_LEAF(NULL);
     GBL_CTX_VERIFY_POINTER(pEmitter);
     GBL_CTX_VERIFY_POINTER(pSignalName);
 
@@ -723,59 +894,80 @@ static GBL_RESULT GblSignal_emit_(GblInstance* pEmitter,
 
             // Don't bother setting up stack frame if there's no connections
             if(pNode) {
-                Connection_* pConnection = GBL_DOUBLY_LINKED_LIST_ENTRY(pNode, Connection_, emitterList);
-                const size_t argCount    = pConnection->pSignal->argCount + 1;
-                GblVariant*  pArgValues  = GBL_ALLOCA(sizeof(GblVariant) * argCount);
-
-                // initialize argument values
-                GBL_CTX_VERIFY_CALL(GblVariant_constructPointer(&pArgValues[0], GBL_POINTER_TYPE, pConnection->pReceiver));
-                if(pVarArgs) {
-                    for(size_t a = 1; a < argCount; ++a) {
-                        GBL_CTX_VERIFY_CALL(GblVariant_constructValueCopyVa(&pArgValues[a],
-                                                                            pConnection->pSignal->argTypes[a-1],
-                                                                            pVarArgs));
-                    }
-                } else if(pVariantArgs) {
-                    for(size_t  a = 1; a < argCount; ++a) {
-                        GBL_CTX_VERIFY_CALL(GblVariant_constructCopy(&pArgValues[a],
-                                                                     &pVariantArgs[a-1]));
-                    }
-                } else GBL_CTX_RECORD_SET(GBL_RESULT_ERROR_INVALID_OPERATION);
+                Connection_*   pConnection = GBL_DOUBLY_LINKED_LIST_ENTRY(pNode, Connection_, emitterList);
+                const Signal_* pSignal     = pConnection->pSignal;
+                const size_t   argCount    = pSignal->argCount + 1;
+                GblVariant*    pArgValues  = NULL;
 
                 // call closures
-                GblBool firstConnection = GBL_TRUE;
                 do {
                     pConnection = GBL_DOUBLY_LINKED_LIST_ENTRY(pNode, Connection_, emitterList);
 
-                    // update arg[0]: receiver (already set for first connection, though)
-                    if(!firstConnection)
-                        GBL_CTX_VERIFY_CALL(GblVariant_setPointer(&pArgValues[0], GBL_POINTER_TYPE, pConnection->pReceiver));
-                    else
-                        firstConnection = GBL_FALSE;
-
                     // save current active connection state
                     Connection_* pOldConnection = pActiveConnection_;
                     pActiveConnection_ = pConnection;
 
-                    // invoke closure
-                    GBL_CTX_VERIFY_CALL(GblClosure_invoke(pConnection->pClosure,
-                                                          NULL,
-                                                          argCount,
-                                                          pArgValues));
+                    if(pConnection->pQueue) {
+                        // queued connections get a copy of the arguments posted to their thread instead
+                        if(!pArgValues) {
+                            pArgValues = GBL_ALLOCA(sizeof(GblVariant) * argCount);
+                            GBL_CTX_VERIFY_CALL(Signal_constructArgs_(pSignal, pArgValues, pConnection->pReceiver,
+                                                                      pVarArgs, pVariantArgs));
+                        }
+
+                        GBL_CTX_VERIFY_CALL(QueuedEmission_post_(pConnection, pArgValues, argCount));
+
+                    /* Fast path: a plain GblCClosure still using the signal's marshal
+                       gets its arguments directly from the va_list, without GblVariants. */
+                    } else if(pVarArgs && pConnection->cClosure && pSignal->pFnVaMarshal &&
+                              GBL_PRIV_REF(pConnection->pClosure).pFnMarshal == pSignal->pFnCMarshal &&
+                              !GBL_CLOSURE_GET_CLASS(pConnection->pClosure)->pFnMetaMarshal)
+                    {
+                        va_list args;
+                        va_copy(args, *pVarArgs);
+                        const GBL_RESULT result = GblClosure_invokeVa(pConnection->pClosure,
+                                                                      pSignal->pFnVaMarshal,
+                                                                      NULL,
+                                                                      pConnection->pReceiver,
+                                                                      &args,
+                                                                      pSignal->argCount,
+                                                                      pSignal->argTypes);
+                        va_end(args);
+                        GBL_CTX_VERIFY_CALL(result);
+                    } else {
+                        // Lazily marshal arguments into variants for the first connection needing them
+                        if(!pArgValues) {
+                            pArgValues = GBL_ALLOCA(sizeof(GblVariant) * argCount);
+                            GBL_CTX_VERIFY_CALL(Signal_constructArgs_(pSignal, pArgValues, pConnection->pReceiver,
+                                                                      pVarArgs, pVariantArgs));
+                        // update arg[0]: receiver (already set upon construction, though)
+                        } else {
+                            GBL_CTX_VERIFY_CALL(GblVariant_setPointer(&pArgValues[0], GBL_POINTER_TYPE, pConnection->pReceiver));
+                        }
+
+                        // invoke closure
+                        GBL_CTX_VERIFY_CALL(GblClosure_invoke(pConnection->pClosure,
+                                                              NULL,
+                                                              argCount,
+                                                              pArgValues));
+                    }
+
                     // restore active connection state
                     pActiveConnection_ = pOldConnection;
 
                 } while((pNode = pNode->pNext) != &pHandler->connectionList);
 
                 // destruct arguments
-                for(size_t  a = 0; a < argCount; ++a) {
-                    GBL_CTX_VERIFY_CALL(GblVariant_destruct(&pArgValues[a]));
+                if(pArgValues) {
+                    for(size_t  a = 0; a < argCount; ++a) {
+                        GBL_CTX_VERIFY_CALL(GblVariant_destruct(&pArgValues[a]));
+                    }
                 }
             }
         }
     }
 
-    GBL_CTX_END();
+    GBL_CTX_END_LEAF();
 }
 
 GBL_EXPORT GBL_RESULT GblSignal_emitVariants(GblInstance* pEmitter,
@@ -816,13 +1008,13 @@ GBL_EXPORT GblInstance* GblSignal_receiver(void) {
 // GBL_EXPORT moved to declaration in gimbal_type_.h
 GBL_RESULT GblSignal_init_(GblContext* pCtx) {
     GBL_CTX_BEGIN(pCtx);
-    GBL_CTX_VERIFY_CALL(GblHashSet_construct(&signalSet_,
-                                             sizeof(Signal_*),
-                                             signalSetHasher_,
-                                             signalSetComparator_,
-                                             signalSetDestructor_,
-                                             64,
-                                             pCtx));
+    GBL_CTX_VERIFY_CALL(GblConcurrentHashSet_construct(&signalSet_,
+                                                       sizeof(Signal_*),
+                                                       signalSetHasher_,
+                                                       signalSetComparator_,
+                                                       signalSetDestructor_,
+                                                       64,
+                                                       pCtx));
 
     GBL_CTX_VERIFY_CALL(GblHashSet_construct(&instanceConnectionTableSet_,
                                              sizeof(InstanceConnectionTable_*),
@@ -833,9 +1025,14 @@ GBL_RESULT GblSignal_init_(GblContext* pCtx) {
                                              pCtx));
 
 #ifdef GBL_CONNECTION_POOL_ALLOCATOR_
+        // connections are made and broken from any thread
         GBL_CTX_VERIFY_CALL(GblPoolAllocator_construct(&connectionAllocator_,
                                                        sizeof(Connection_),
-                                                       GBL_CONNECTION_POOL_ALLOCATOR_PAGE_SIZE_));
+                                                       GBL_CONNECTION_POOL_ALLOCATOR_PAGE_SIZE_,
+                                                       0,
+                                                       GBL_NULL,
+                                                       GBL_NULL,
+                                                       GBL_POOL_ALLOCATOR_FLAG_CONCURRENT));
 #endif
 
     GBL_CTX_END();
@@ -845,7 +1042,7 @@ GBL_RESULT GblSignal_init_(GblContext* pCtx) {
 // GBL_EXPORT moved to declaration in gimbal_type_.h
 GBL_RESULT GblSignal_final_(GblContext* pCtx) {
     GBL_CTX_BEGIN(pCtx);
-    GBL_CTX_CALL(GblHashSet_destruct(&signalSet_));
+    GBL_CTX_CALL(GblConcurrentHashSet_destruct(&signalSet_));
     GBL_CTX_CALL(GblHashSet_destruct(&instanceConnectionTableSet_));
 #ifdef GBL_CONNECTION_POOL_ALLOCATOR_
     GBL_CTX_CALL(GblPoolAllocator_destruct(&connectionAllocator_));
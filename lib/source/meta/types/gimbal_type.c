@@ -16,6 +16,9 @@ GBL_THREAD_LOCAL GblBool initializing_   = GBL_FALSE;
 mtx_t                    typeRegMtx_;
 GblHashSet               typeRegistry_;
 struct TypeBuiltins_     typeBuiltins_;
+atomic_uint_least32_t    typeCacheGeneration_ = 0;
+
+static atomic_uint_least32_t typeIndexCounter_ = 0;
 
 
 GBL_MAYBE_UNUSED static int metaClassIFaceEntryComparator_(const void* pA, const void* pB) {
@@ -40,6 +43,8 @@ static void metaClassElementFree_(const GblHashSet* pMap, void* item) {
     GBL_UNUSED(pMap);
     GBL_CTX_BEGIN(pCtx_);
     GblMetaClass** ppMetaClass = (GblMetaClass**)item;
+    GblInstance_poolDestroy_(*ppMetaClass);
+    GblProperty_tableDestroy_(*ppMetaClass);
     GBL_CTX_FREE(*ppMetaClass);
     GBL_CTX_END_BLOCK();
 }
@@ -208,6 +213,8 @@ static GBL_RESULT typeValidate_(GblType parent,
     } else {
         GBL_CTX_VERIFY(pInfo->instanceSize == 0, GBL_RESULT_ERROR_INVALID_TYPE,
                        "Cannot register a NON INSTANTIABLE type with an instance size > 0!");
+        GBL_CTX_VERIFY(!(flags & GBL_TYPE_FLAG_POOLED), GBL_RESULT_ERROR_INVALID_TYPE,
+                       "Cannot POOL a NON INSTANTIABLE type!");
     }
 
     GBL_CTX_VERIFY(!(pParentMeta && (pParentMeta->flags & GBL_TYPE_FLAG_FINAL)), GBL_RESULT_ERROR_INVALID_TYPE,
@@ -408,6 +415,8 @@ static GblType typeRegister_(GblType           parent,
         pMeta->pParent = GBL_META_CLASS_(parent);
         pMeta->name    = GblQuark_fromString(pName);
         pMeta->depth   = baseCount;
+        // Dense index keying type-check caches, never reused so stale entries can't alias
+        pMeta->index   = atomic_fetch_add_explicit(&typeIndexCounter_, 1, memory_order_relaxed) + 1;
 
         // Initialize flags for this class layer.
         pMeta->flags = flags;
@@ -450,6 +459,7 @@ static GblType typeRegister_(GblType           parent,
         // Add our new metaclass to the registry
         const GblMetaClass* pOldData = GblHashSet_set(&typeRegistry_, &pMeta);
         GBL_ASSERT(!pOldData, "A previous metatype entry already existed!");
+        GblType_cacheInvalidate_();
 
         // Add type to our builtins table, if it's not a dynamic user-type.
         newType = (GblType)pMeta;
@@ -488,6 +498,8 @@ extern GBL_RESULT GblType_refresh_(GblType type) {
                 GblIPluginClass* pIPluginIFace = GBL_IPLUGIN_GET_CLASS(pPlugin);
                 pIPluginIFace->pFnTypeInfo(pPlugin, type, &info);
                 GBL_CTX_VERIFY_CALL(GblType_updateTypeInfoClassChunk_(pMeta, &info));
+                // New type info may map different interfaces
+                GblType_cacheInvalidate_();
             } else {
                 GblType_updateTypeInfoClassChunk_(pMeta, pMeta->pInfo);
             }
@@ -672,6 +684,7 @@ static void GblType_final_(void) {
     GBL_CTX_CALL(GblArrayList_clear(&typeBuiltins_.vector));
     GBL_CTX_CALL(GblArrayList_destruct(&typeBuiltins_.vector));
     GBL_CTX_CALL(GblHashSet_destruct(&typeRegistry_));
+    GblInstance_poolFinal_();
 
     GBL_CTX_POP(1);
     initialized_ = GBL_FALSE;
@@ -1040,19 +1053,56 @@ GBL_EXPORT GblBool GblType_verify(GblType type) {
     return valid;
 }
 
+GBL_DECLARE_ENUM(GBL_TYPE_IS_A_) {
+    GBL_TYPE_IS_A_CHECK_,
+    GBL_TYPE_IS_A_DERIVES_,
+    GBL_TYPE_IS_A_MAPS_
+};
+
+/* Memoizes GblType_typeIsA_() in the derived type's cache. Each query kind
+   takes two bits of an entry's value: whether it's known, and its result. */
+static GblBool GblType_typeIsACached_(GblType derived, GblType base, GBL_TYPE_IS_A_ query) {
+    static const GblBool checks[][3] = {
+        [GBL_TYPE_IS_A_CHECK_]   = { GBL_TRUE,  GBL_TRUE,  GBL_TRUE  },
+        [GBL_TYPE_IS_A_DERIVES_] = { GBL_TRUE,  GBL_FALSE, GBL_FALSE },
+        [GBL_TYPE_IS_A_MAPS_]    = { GBL_FALSE, GBL_TRUE,  GBL_FALSE }
+    };
+
+    if GBL_UNLIKELY(derived == GBL_INVALID_TYPE || base == GBL_INVALID_TYPE)
+        return GblType_typeIsA_(derived, base, checks[query][0], checks[query][1], checks[query][2]);
+
+    GblMetaClass*  pDerived   = GBL_META_CLASS_(derived);
+    GblMetaClass*  pBase      = GBL_META_CLASS_(base);
+    const uint32_t knownBit   = 1u << (query * 2);
+    const uint32_t resultBit  = 1u << (query * 2 + 1);
+    const uint32_t generation = GblType_cacheGeneration_();
+    uint32_t       value      = 0;
+
+    // On a miss, value stays 0, dropping results for whichever type held the slot
+    if GBL_LIKELY(GblType_cacheLookup_(pDerived->typeCache, pBase, &value) && (value & knownBit))
+        return !!(value & resultBit);
+
+    const GblBool result = GblType_typeIsA_(derived, base,
+                                            checks[query][0], checks[query][1], checks[query][2]);
+
+    GblType_cacheStore_(pDerived->typeCache, pBase, generation,
+                        value | knownBit | (result? resultBit : 0));
+    return result;
+}
+
 GBL_EXPORT GblBool GblType_check(GblType type, GblType other) {
-    return GblType_typeIsA_(type, other, GBL_TRUE, GBL_TRUE, GBL_TRUE);
+    return GblType_typeIsACached_(type, other, GBL_TYPE_IS_A_CHECK_);
 }
 
 // subtyping is inclusive
 GBL_EXPORT GblBool GblType_derives(GblType derived, GblType base) {
     if(derived == base) return GBL_FALSE;
-    return GblType_typeIsA_(derived, base, GBL_TRUE, GBL_FALSE, GBL_FALSE);
+    return GblType_typeIsACached_(derived, base, GBL_TYPE_IS_A_DERIVES_);
 }
 
 GBL_EXPORT GblBool GblType_maps(GblType concrete, GblType iface) {
     if(concrete == GBL_INVALID_TYPE || iface == GBL_INVALID_TYPE) return GBL_FALSE;
-    return GblType_typeIsA_(concrete, iface, GBL_FALSE, GBL_TRUE, GBL_FALSE);
+    return GblType_typeIsACached_(concrete, iface, GBL_TYPE_IS_A_MAPS_);
 }
 
 GBL_EXPORT GblBool GblType_implements(GblType type, GblType superType) {
@@ -1170,6 +1220,7 @@ GBL_EXPORT GBL_RESULT GblType_unregister(GblType type) {
 
         const GblBool success = GblHashSet_erase(&typeRegistry_, &pMeta);
         //GblHashSet_shrinkToFit(&typeRegistry_);
+        GblType_cacheInvalidate_();
         mtx_unlock(&typeRegMtx_);
         GBL_CTX_VERIFY(success, GBL_RESULT_ERROR_INVALID_TYPE, "Failed to remove the type from the registry HashSet!");
     }
@@ -31,6 +31,14 @@
 
 #define GBL_TYPE_REGISTRY_HASH_MAP_CAPACITY_DEFAULT_    32
 
+#define GBL_TYPE_CACHE_SLOTS_                           8
+#define GBL_TYPE_CACHE_INDEX_BITS_                      20
+#define GBL_TYPE_CACHE_GENERATION_BITS_                 24
+#define GBL_TYPE_CACHE_VALUE_BITS_                      20
+#define GBL_TYPE_CACHE_INDEX_MAX_                       ((1u << GBL_TYPE_CACHE_INDEX_BITS_) - 1)
+#define GBL_TYPE_CACHE_VALUE_MAX_                       ((1u << GBL_TYPE_CACHE_VALUE_BITS_) - 1)
+#define GBL_TYPE_CACHE_GENERATION_MASK_                 ((1u << GBL_TYPE_CACHE_GENERATION_BITS_) - 1)
+
 #define GBL_TYPE_ENSURE_INITIALIZED_()                  \
     GBL_STMT_START {                                    \
         if(!initializing_) {                            \
@@ -52,6 +60,8 @@ GBL_DECLARE_ENUM(GBL_CLASS_FLAGS_) {
 
 GBL_FORWARD_DECLARE_STRUCT(GblArrayMap);
 GBL_FORWARD_DECLARE_STRUCT(GblInterface);
+GBL_FORWARD_DECLARE_STRUCT(GblInstancePool_);
+GBL_FORWARD_DECLARE_STRUCT(GblPropertyTable_);
 
 typedef struct GblMetaClass {
     union {
@@ -66,8 +76,14 @@ typedef struct GblMetaClass {
     GblArrayMap*                pExtensions;
     GblClass*                   pClass;
     uint8_t                     depth;
+    uint32_t                    index;
     ptrdiff_t                   classPrivateOffset;
     ptrdiff_t                   instancePrivateOffset;
+    atomic_uint_least64_t       typeCache[GBL_TYPE_CACHE_SLOTS_];
+    atomic_uint_least64_t       castCache[GBL_TYPE_CACHE_SLOTS_];
+    _Atomic(GblInstancePool_*)  pInstancePool;
+    _Atomic(GblPropertyTable_*) pPropertyTable;
+    atomic_uint_least32_t       propertyGeneration;
     struct GblMetaClass*        pBases[];
 } GblMetaClass;
 
@@ -78,12 +94,58 @@ extern GblBool                  initialized_;
 extern GBL_THREAD_LOCAL GblBool initializing_;
 extern mtx_t                    typeRegMtx_;
 extern GblHashSet               typeRegistry_;
+extern atomic_uint_least32_t    typeCacheGeneration_;
 extern struct TypeBuiltins_ {
     GblArrayList   vector;
     uint8_t        stackBuffer[sizeof(GblType) * GBL_TYPE_BUILTIN_COUNT];
 } typeBuiltins_;
 
 
+/* Per-metaclass result caches, keyed by the dense index of the target type.
+   Each slot packs [target index | generation | value] into a single word, so
+   it can be read and written without locks. Bumping typeCacheGeneration_
+   invalidates every entry of every cache at once. */
+GBL_INLINE uint32_t GblType_cacheGeneration_(void) {
+    return atomic_load_explicit(&typeCacheGeneration_, memory_order_acquire)
+           & GBL_TYPE_CACHE_GENERATION_MASK_;
+}
+
+GBL_INLINE void GblType_cacheInvalidate_(void) {
+    atomic_fetch_add_explicit(&typeCacheGeneration_, 1, memory_order_acq_rel);
+}
+
+GBL_INLINE uint64_t GblType_cacheKey_(const GblMetaClass* pTarget, uint32_t generation) {
+    return ((uint64_t)pTarget->index << GBL_TYPE_CACHE_GENERATION_BITS_) | generation;
+}
+
+GBL_INLINE GblBool GblType_cacheLookup_(atomic_uint_least64_t* pCache,
+                                        const GblMetaClass*    pTarget,
+                                        uint32_t*              pValue)
+{
+    const uint64_t entry = atomic_load_explicit(&pCache[pTarget->index & (GBL_TYPE_CACHE_SLOTS_ - 1)],
+                                                memory_order_relaxed);
+
+    if((entry >> GBL_TYPE_CACHE_VALUE_BITS_) != GblType_cacheKey_(pTarget, GblType_cacheGeneration_()))
+        return GBL_FALSE;
+
+    *pValue = (uint32_t)(entry & GBL_TYPE_CACHE_VALUE_MAX_);
+    return GBL_TRUE;
+}
+
+// generation must be loaded before computing value, so a racing invalidation discards it
+GBL_INLINE void GblType_cacheStore_(atomic_uint_least64_t* pCache,
+                                    const GblMetaClass*    pTarget,
+                                    uint32_t               generation,
+                                    uint32_t               value)
+{
+    if(pTarget->index > GBL_TYPE_CACHE_INDEX_MAX_ || value > GBL_TYPE_CACHE_VALUE_MAX_)
+        return;
+
+    atomic_store_explicit(&pCache[pTarget->index & (GBL_TYPE_CACHE_SLOTS_ - 1)],
+                          (GblType_cacheKey_(pTarget, generation) << GBL_TYPE_CACHE_VALUE_BITS_) | value,
+                          memory_order_relaxed);
+}
+
 extern void          GblType_init_                     (void);
 extern GBL_RESULT    GblType_refresh_                  (GblType type);
 extern GblInterface* GblType_extension_                (GblType type, GblType ifaceType);
@@ -94,11 +156,15 @@ extern GblType       GblType_registerBuiltin_          (size_t               exp
                                                         const GblTypeInfo*   pTypeInfo,
                                                         GblTypeFlags         flags);
 
+extern void          GblInstance_poolDestroy_          (GblMetaClass* pMeta);
+extern void          GblInstance_poolFinal_            (void);
+
 extern GBL_RESULT    GblThread_final_                  (void);
 extern GBL_RESULT    GblModule_final_                  (void);
 
 extern GBL_RESULT    GblProperty_init_                 (GblContext* pCtx);
 extern GBL_RESULT    GblProperty_final_                (GblContext* pCtx);
+extern void          GblProperty_tableDestroy_         (GblMetaClass* pMeta);
 
 // Fix for Windows: "Redefinition with different linkage"
 // Added GBL_EXPORT to all 3 and removed in implementation file gimbal_signal.c
@@ -9,8 +9,16 @@
 #include <gimbal/strings/gimbal_string_buffer.h>
 #include <gimbal/utils/gimbal_date_time.h>
 
+// Variant methods only propagate results, so they run on leaf frames
 #define GBL_VARIANT_BEGIN_(type, classGetterSuffix)                                         \
-    GBL_CTX_BEGIN(NULL); {                                                                  \
+    GBL_VARIANT_BEGIN_FRAME_(GBL_CTX_BEGIN_LEAF, type, classGetterSuffix)
+
+// Full frames, for methods checking GBL_CTX_LAST_RESULT(), which frame pushes clear
+#define GBL_VARIANT_BEGIN_FULL_(type, classGetterSuffix)                                    \
+    GBL_VARIANT_BEGIN_FRAME_(GBL_CTX_BEGIN, type, classGetterSuffix)
+
+#define GBL_VARIANT_BEGIN_FRAME_(beginMacro, type, classGetterSuffix)                       \
+    beginMacro(NULL); {                                                                     \
         const GblType type_ = type;                                                         \
         GBL_CTX_VERIFY_POINTER(pSelf);                                                      \
         GBL_CTX_VERIFY_TYPE(type_, GBL_IVARIANT_TYPE,                                       \
@@ -25,9 +33,12 @@
                 GblType_name(type_))
 
 #define GBL_VARIANT_END_BLOCK_()                                                            \
-    } GBL_CTX_END_BLOCK()
+    } GBL_CTX_END_LEAF_BLOCK()
 
 #define GBL_VARIANT_END_()                                                                  \
+    } GBL_CTX_END_LEAF()
+
+#define GBL_VARIANT_END_FULL_()                                                             \
     } GBL_CTX_END()
 
 typedef struct ConverterEntry_ {
@@ -343,7 +354,7 @@ GBL_EXPORT GBL_RESULT GblVariant_load(GblVariant* pSelf, const GblStringBuffer*
 }
 
 GBL_EXPORT GBL_RESULT GblVariant_constructValueCopyVa(GblVariant* pSelf, GblType type, va_list* pList) {
-    GBL_VARIANT_BEGIN_(type, ref);
+    GBL_VARIANT_BEGIN_FULL_(type, ref);
     GBL_CTX_CALL(GblVariant_initDefault_(pSelf, type));
     GBL_CTX_CALL(GblIVariantClass_constructValueCopy(pIFace, pSelf, pList));
     if(GBL_RESULT_ERROR(GBL_CTX_LAST_RESULT())) {
@@ -351,11 +362,11 @@ GBL_EXPORT GBL_RESULT GblVariant_constructValueCopyVa(GblVariant* pSelf, GblType
         GblClass_unrefDefault(pClass_);
         GBL_CTX_CALL(GblVariant_initDefault_(pSelf, GBL_INVALID_TYPE));
     }
-    GBL_VARIANT_END_();
+    GBL_VARIANT_END_FULL_();
 }
 
 GBL_EXPORT GBL_RESULT GblVariant_constructValueMoveVa(GblVariant* pSelf, GblType type, va_list* pList) {
-    GBL_VARIANT_BEGIN_(type, ref);
+    GBL_VARIANT_BEGIN_FULL_(type, ref);
     GBL_CTX_CALL(GblVariant_initDefault_(pSelf, type));
     GBL_CTX_CALL(GblIVariantClass_constructValueMove(pIFace, pSelf, pList));
     if(GBL_RESULT_ERROR(GBL_CTX_LAST_RESULT())) {
@@ -363,7 +374,7 @@ GBL_EXPORT GBL_RESULT GblVariant_constructValueMoveVa(GblVariant* pSelf, GblType
         GblClass_unrefDefault(pClass_);
         GBL_CTX_CALL(GblVariant_initDefault_(pSelf, GBL_INVALID_TYPE));
     }
-    GBL_VARIANT_END_();
+    GBL_VARIANT_END_FULL_();
 }
 
 GBL_EXPORT GBL_RESULT GblVariant_constructValueCopy(GblVariant* pSelf, GblType type, ...) {
@@ -1,20 +1,284 @@
 #include <gimbal/strings/gimbal_pattern.h>
 #include <gimbal/strings/gimbal_string_view.h>
 #include <gimbal/strings/gimbal_string_buffer.h>
+#include <gimbal/algorithms/gimbal_hash.h>
 #include <gimbal/utils/gimbal_ref.h>
 #include <re.h>
 
 #include <stdatomic.h>
+#include <tinycthread.h>
+
+#include "gimbal_pattern_dfa_.h"
 
 #define GBL_PATTERN_COMPILE_BUFFER_SIZE_    1024
 #define GBL_PATTERN_STRING_BUFFER_SIZE_     128
+#define GBL_PATTERN_CACHE_SIZE_             32      // Compiled patterns kept for string-based matching
+#define GBL_PATTERN_DFA_USES_               2       // Matches against a pattern before building its DFAs
+#define GBL_PATTERN_DFA_NONE_               ((GblPatternDfa_*)&GblPattern_dfaNone_)
+
+#define GBL_PATTERN_INFO_SIZE_              gblAlignedAllocSizeDefault(sizeof(GblPatternInfo_))
+#define GBL_PATTERN_INFO_(self)             ((GblPatternInfo_*)((uint8_t*)(self) - GBL_PATTERN_INFO_SIZE_))
+#define GBL_PATTERN_CACHE_ENTRY_SIZE_       gblAlignedAllocSizeDefault(sizeof(GblPatternCacheEntry_))
+#define GBL_PATTERN_CACHE_ENTRY_(self)      ((GblPatternCacheEntry_*)((uint8_t*)GBL_PATTERN_INFO_(self) - \
+                                                                      GBL_PATTERN_CACHE_ENTRY_SIZE_))
+
+/* Precedes the backend's compiled pattern within the same allocation,
+ * which is followed by a copy of the regular expression it came from,
+ * for building DFAs from. */
+GBL_DECLARE_STRUCT(GblPatternInfo_) {
+    const char*              pRegExp;
+    atomic_uint              uses;
+    _Atomic(GblPatternDfa_*) pSearch;   // Lazily built, or GBL_PATTERN_DFA_NONE_ when unsupported
+    _Atomic(GblPatternDfa_*) pExact;
+};
+
+// Precedes the GblPatternInfo_ of patterns owned by the cache, rather than by GblRef
+GBL_DECLARE_STRUCT(GblPatternCacheEntry_) {
+    atomic_int refCount;    // The cache's reference, plus one for each match in progress
+    GblHash    hash;
+    uint64_t   lastUse;
+};
+
+static atomic_short           activePatterns_ = 0;
+static char                   GblPattern_dfaNone_;
+static once_flag              cacheOnce_      = ONCE_FLAG_INIT;
+static mtx_t                  cacheMtx_;
+static uint64_t               cacheTick_      = 0;
+static GblPatternCacheEntry_* cache_[GBL_PATTERN_CACHE_SIZE_];
+
+// Fills in a block holding the pattern info, compiled pattern, and regular expression, returning the pattern
+static GblPattern* GblPattern_init_(void*       pBlock,
+                                    const void* pCompiled,
+                                    size_t      compiledSize,
+                                    const char* pRegExp,
+                                    size_t      length)
+{
+    GblPatternInfo_* pInfo    = pBlock;
+    uint8_t*         pPattern = (uint8_t*)pBlock + GBL_PATTERN_INFO_SIZE_;
+    char*            pCopy    = (char*)pPattern + compiledSize;
+
+    memcpy(pPattern, pCompiled, compiledSize);
+    memcpy(pCopy, pRegExp, length + 1);
+
+    pInfo->pRegExp = pCopy;
+    atomic_init(&pInfo->uses, 0);
+    atomic_init(&pInfo->pSearch, NULL);
+    atomic_init(&pInfo->pExact, NULL);
+
+    return (GblPattern*)pPattern;
+}
+
+static void GblPattern_destroyDfas_(GblPatternInfo_* pInfo) {
+    GblPatternDfa_* pSearch = atomic_load(&pInfo->pSearch);
+    GblPatternDfa_* pExact  = atomic_load(&pInfo->pExact);
+
+    if(pSearch && pSearch != GBL_PATTERN_DFA_NONE_)
+        GblPatternDfa_destroy_(pSearch);
+
+    if(pExact && pExact != GBL_PATTERN_DFA_NONE_)
+        GblPatternDfa_destroy_(pExact);
+}
+
+static GBL_RESULT GblPattern_destruct_(void* pBlock) {
+    GblPattern_destroyDfas_(pBlock);
+    return GBL_RESULT_SUCCESS;
+}
+
+// Returns the DFA for searching or exactly matching the pattern, or NULL if there isn't one (yet)
+static const GblPatternDfa_* GblPattern_dfa_(const GblPattern* pSelf, GblBool search) {
+    GblPatternInfo_*          pInfo = GBL_PATTERN_INFO_(pSelf);
+    _Atomic(GblPatternDfa_*)* ppDfa = search? &pInfo->pSearch : &pInfo->pExact;
+    GblPatternDfa_*           pDfa  = atomic_load_explicit(ppDfa, memory_order_acquire);
+
+    if GBL_UNLIKELY(!pDfa) {
+        // Patterns which are only ever matched once never pay for building one
+        if(atomic_load_explicit(&pInfo->uses, memory_order_relaxed) < GBL_PATTERN_DFA_USES_) {
+            atomic_fetch_add_explicit(&pInfo->uses, 1, memory_order_relaxed);
+            return NULL;
+        }
+
+        pDfa = GblPatternDfa_create_(&pInfo->pRegExp, 1, search);
+
+        if(!pDfa)
+            pDfa = GBL_PATTERN_DFA_NONE_;
+
+        // Another thread may have won the race to build it
+        GblPatternDfa_* pExpected = NULL;
+        if(!atomic_compare_exchange_strong(ppDfa, &pExpected, pDfa)) {
+            if(pDfa != GBL_PATTERN_DFA_NONE_)
+                GblPatternDfa_destroy_(pDfa);
+            pDfa = pExpected;
+        }
+    }
+
+    return pDfa != GBL_PATTERN_DFA_NONE_? pDfa : NULL;
+}
+
+// Finds the next match with the backend, after the DFA has ruled out there not being one in linear time
+static int GblPattern_find_(const GblPattern* pSelf, const char* pString, int* pLength) {
+    const GblPatternDfa_* pDfa = GblPattern_dfa_(pSelf, GBL_TRUE);
+
+    if(pDfa && !GblPatternDfa_search_(pDfa, pString))
+        return -1;
 
-static atomic_short activePatterns_ = 0;
+    return re_matchp((re_t)pSelf, pString, pLength);
+}
+
+static void GblPattern_initCache_(void) {
+    mtx_init(&cacheMtx_, mtx_plain);
+}
+
+static GblPatternCacheEntry_* GblPattern_allocCached_(size_t size) {
+    GblPatternCacheEntry_* pEntry = NULL;
+
+    GBL_CTX_BEGIN(NULL);
+    pEntry = GBL_CTX_MALLOC(GBL_PATTERN_CACHE_ENTRY_SIZE_ + GBL_PATTERN_INFO_SIZE_ + size);
+    GBL_CTX_END_BLOCK();
+
+    return pEntry;
+}
+
+static void GblPattern_freeCached_(GblPatternCacheEntry_* pEntry) {
+    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_FREE(pEntry);
+    GBL_CTX_END_BLOCK();
+}
 
-static const GblPattern* GblPattern_compileStatic_(const char* pRegExp) {
-    if(!pRegExp) return NULL;
+static void GblPattern_releaseCached_(const GblPattern* pSelf) {
+    if(!pSelf)
+        return;
+
+    GblPatternCacheEntry_* pEntry = GBL_PATTERN_CACHE_ENTRY_(pSelf);
 
-    return (const GblPattern*)re_compile(pRegExp);
+    if(atomic_fetch_sub(&pEntry->refCount, 1) == 1) {
+        GblPattern_destroyDfas_(GBL_PATTERN_INFO_(pSelf));
+        GblPattern_freeCached_(pEntry);
+    }
+}
+
+// Returns the cached pattern for the regular expression, or NULL, taking a reference to it
+static const GblPattern* GblPattern_findCached_(const char* pRegExp, GblHash hash) {
+    for(size_t e = 0; e < GBL_PATTERN_CACHE_SIZE_; ++e) {
+        GblPatternCacheEntry_* pEntry = cache_[e];
+
+        if(pEntry && pEntry->hash == hash) {
+            const GblPattern* pPattern = (const GblPattern*)((uint8_t*)pEntry + GBL_PATTERN_CACHE_ENTRY_SIZE_ +
+                                                             GBL_PATTERN_INFO_SIZE_);
+
+            if(strcmp(GBL_PATTERN_INFO_(pPattern)->pRegExp, pRegExp) == 0) {
+                pEntry->lastUse = ++cacheTick_;
+                atomic_fetch_add(&pEntry->refCount, 1);
+                return pPattern;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+// Returns a compiled pattern from the LRU cache, compiling and caching it upon a miss
+static const GblPattern* GblPattern_acquireCached_(const char* pRegExp) {
+    const GblPattern*      pPattern = NULL;
+    GblPatternCacheEntry_* pEntry   = NULL;
+    GblPatternCacheEntry_* pEvicted = NULL;
+
+    if(!pRegExp)
+        return NULL;
+
+    call_once(&cacheOnce_, GblPattern_initCache_);
+
+    const size_t  length = strlen(pRegExp);
+    const GblHash hash   = gblHash(pRegExp, length);
+
+    mtx_lock(&cacheMtx_);
+    pPattern = GblPattern_findCached_(pRegExp, hash);
+    mtx_unlock(&cacheMtx_);
+
+    if(pPattern)
+        return pPattern;
+
+    // Compile without holding the lock
+    void*    pBuffer = GBL_ALLOCA(GBL_PATTERN_COMPILE_BUFFER_SIZE_);
+    unsigned size    = GBL_PATTERN_COMPILE_BUFFER_SIZE_;
+
+    if(!re_compile_to(pRegExp, pBuffer, &size))
+        return NULL;
+
+    pEntry = GblPattern_allocCached_(size + length + 1);
+
+    if(!pEntry)
+        return NULL;
+
+    atomic_init(&pEntry->refCount, 2);
+    pEntry->hash = hash;
+    pPattern     = GblPattern_init_((uint8_t*)pEntry + GBL_PATTERN_CACHE_ENTRY_SIZE_, pBuffer, size, pRegExp, length);
+
+    mtx_lock(&cacheMtx_);
+
+    // Another thread may have cached the same pattern in the meantime
+    const GblPattern* pExisting = GblPattern_findCached_(pRegExp, hash);
+
+    if(!pExisting) {
+        size_t slot = 0;
+
+        // Take an empty slot, or evict the least recently used pattern
+        for(size_t e = 0; e < GBL_PATTERN_CACHE_SIZE_; ++e) {
+            if(!cache_[e]) {
+                slot = e;
+                break;
+            }
+
+            if(cache_[e]->lastUse < cache_[slot]->lastUse)
+                slot = e;
+        }
+
+        pEvicted        = cache_[slot];
+        pEntry->lastUse = ++cacheTick_;
+        cache_[slot]    = pEntry;
+    }
+
+    mtx_unlock(&cacheMtx_);
+
+    if(pExisting) {
+        GblPattern_freeCached_(pEntry);
+        pPattern = pExisting;
+    }
+
+    if(pEvicted)
+        GblPattern_releaseCached_((const GblPattern*)((uint8_t*)pEvicted + GBL_PATTERN_CACHE_ENTRY_SIZE_ +
+                                                      GBL_PATTERN_INFO_SIZE_));
+
+    return pPattern;
+}
+
+GBL_EXPORT void GblPattern_clearCache(void) {
+    GblPatternCacheEntry_* entries[GBL_PATTERN_CACHE_SIZE_];
+
+    call_once(&cacheOnce_, GblPattern_initCache_);
+
+    mtx_lock(&cacheMtx_);
+    memcpy(entries, cache_, sizeof(cache_));
+    memset(cache_, 0, sizeof(cache_));
+    mtx_unlock(&cacheMtx_);
+
+    // Patterns still being matched against are freed once their matches finish
+    for(size_t e = 0; e < GBL_PATTERN_CACHE_SIZE_; ++e)
+        if(entries[e])
+            GblPattern_releaseCached_((const GblPattern*)((uint8_t*)entries[e] + GBL_PATTERN_CACHE_ENTRY_SIZE_ +
+                                                          GBL_PATTERN_INFO_SIZE_));
+}
+
+GBL_EXPORT size_t GblPattern_cacheCount(void) {
+    size_t count = 0;
+
+    call_once(&cacheOnce_, GblPattern_initCache_);
+
+    mtx_lock(&cacheMtx_);
+    for(size_t e = 0; e < GBL_PATTERN_CACHE_SIZE_; ++e)
+        if(cache_[e]) ++count;
+    mtx_unlock(&cacheMtx_);
+
+    return count;
 }
 
 GBL_EXPORT const GblPattern* GblPattern_create(const char* pRegExp) {
@@ -27,10 +291,13 @@ GBL_EXPORT const GblPattern* GblPattern_create(const char* pRegExp) {
         if(re_compile_to(pRegExp, pBuffer, &size)) {
             GBL_ASSERT(size);
 
-            pPattern = GblRef_create(size);
-            memcpy(pPattern, pBuffer, size);
+            const size_t length = strlen(pRegExp);
+            void*        pBlock = GblRef_create(GBL_PATTERN_INFO_SIZE_ + size + length + 1);
 
-            atomic_fetch_add(&activePatterns_, 1);
+            if(pBlock) {
+                pPattern = GblPattern_init_(pBlock, pBuffer, size, pRegExp, length);
+                atomic_fetch_add(&activePatterns_, 1);
+            }
         }
     }
 
@@ -38,16 +305,19 @@ GBL_EXPORT const GblPattern* GblPattern_create(const char* pRegExp) {
 }
 
 GBL_EXPORT GblRefCount GblPattern_unref(const GblPattern* pSelf) {
-    const GblRefCount refCount =  GblRef_unref((void*)pSelf);
+    if(!pSelf)
+        return 0;
+
+    const GblRefCount refCount = GblRef_unref(GBL_PATTERN_INFO_(pSelf), GblPattern_destruct_);
 
-    if(pSelf && !refCount)
+    if(!refCount)
         atomic_fetch_sub(&activePatterns_, 1);
 
     return refCount;
 }
 
 GBL_EXPORT GblRefCount GblPattern_refCount(const GblPattern* pSelf) {
-    return GblRef_refCount(pSelf);
+    return pSelf? GblRef_refCount(GBL_PATTERN_INFO_(pSelf)) : 0;
 }
 
 GBL_EXPORT GblRefCount GblPattern_totalCount(void) {
@@ -55,7 +325,10 @@ GBL_EXPORT GblRefCount GblPattern_totalCount(void) {
 }
 
 GBL_EXPORT const GblPattern* GblPattern_ref(const GblPattern* pSelf) {
-    return GblRef_ref((void*)pSelf);
+    if(pSelf)
+        GblRef_ref(GBL_PATTERN_INFO_(pSelf));
+
+    return pSelf;
 }
 
 GBL_EXPORT int GblPattern_compare(const GblPattern* pSelf, const GblPattern* pRhs) {
@@ -99,7 +372,7 @@ GBL_EXPORT GblBool (GblPattern_match)(const GblPattern* pSelf,
     // Only run if pattern + string are valid
     if(valid) {
         // Iterate over substring until no match is found
-        while((pos = re_matchp((re_t)pSelf, pString + prevPos + prevLength, &length)) != -1) {
+        while((pos = GblPattern_find_(pSelf, pString + prevPos + prevLength, &length)) != -1) {
             // Update moving window substring
             pString     += prevPos + prevLength;
             prevPos     = pos;
@@ -135,10 +408,11 @@ GBL_EXPORT GblBool (GblPattern_matchStr)(const char*    pRegExp,
                                          GblStringView* pMatch,
                                          int*           pCount)
 {
-    return GblPattern_match(GblPattern_compileStatic_(pRegExp),
-                            pString,
-                            pMatch,
-                            pCount);
+    const GblPattern* pPattern = GblPattern_acquireCached_(pRegExp);
+    const GblBool     result   = GblPattern_match(pPattern, pString, pMatch, pCount);
+
+    GblPattern_releaseCached_(pPattern);
+    return result;
 }
 
 GBL_EXPORT GblBool (GblPattern_matchNot)(const GblPattern* pSelf,
@@ -238,10 +512,11 @@ GBL_EXPORT GblBool GblPattern_matchNotStr(const char*    pRegExp,
                                           GblStringView* pMatch,
                                           int*       pCount)
 {
-    return GblPattern_matchNot(GblPattern_compileStatic_(pRegExp),
-                               pString,
-                               pMatch,
-                               pCount);
+    const GblPattern* pPattern = GblPattern_acquireCached_(pRegExp);
+    const GblBool     result   = GblPattern_matchNot(pPattern, pString, pMatch, pCount);
+
+    GblPattern_releaseCached_(pPattern);
+    return result;
 }
 
 GBL_EXPORT GblBool GblPattern_matchExact(const GblPattern* pSelf, const char* pString) {
@@ -250,6 +525,13 @@ GBL_EXPORT GblBool GblPattern_matchExact(const GblPattern* pSelf, const char* pS
     if(!pString)
         return GBL_FALSE;
 
+    /* The DFA rules out strings which can't match in a single pass, without backtracking, while
+       the backend still has the final say, so the answer doesn't change once the DFA is built */
+    const GblPatternDfa_* pDfa = GblPattern_dfa_(pSelf, GBL_FALSE);
+
+    if(pDfa && GblPatternDfa_matchExact_(pDfa, pString, strlen(pString)) < 0)
+        return GBL_FALSE;
+
     GblStringView match;
 
     if(GblPattern_match(pSelf, pString, &match, NULL)) {
@@ -263,7 +545,11 @@ GBL_EXPORT GblBool GblPattern_matchExact(const GblPattern* pSelf, const char* pS
 GBL_EXPORT GblBool GblPattern_matchExactStr(const char* pRegExp,
                                             const char* pString)
 {
-    return GblPattern_matchExact(GblPattern_compileStatic_(pRegExp), pString);
+    const GblPattern* pPattern = GblPattern_acquireCached_(pRegExp);
+    const GblBool     result   = GblPattern_matchExact(pPattern, pString);
+
+    GblPattern_releaseCached_(pPattern);
+    return result;
 }
 
 
@@ -274,7 +560,11 @@ GBL_EXPORT size_t GblPattern_matchCount(const GblPattern* pSelf, const char* pSt
 }
 
 GBL_EXPORT size_t GblPattern_matchCountStr(const char* pRegExp, const char* pString) {
-    return GblPattern_matchCount(GblPattern_compileStatic_(pRegExp), pString);
+    const GblPattern* pPattern = GblPattern_acquireCached_(pRegExp);
+    const size_t      count    = GblPattern_matchCount(pPattern, pString);
+
+    GblPattern_releaseCached_(pPattern);
+    return count;
 }
 
 GBL_EXPORT const char* GblPattern_string(const GblPattern* pSelf,
@@ -0,0 +1,744 @@
+#include "gimbal_pattern_dfa_.h"
+#include <gimbal/containers/gimbal_array_list.h>
+#include <gimbal/algorithms/gimbal_hash.h>
+#include <stdlib.h>
+
+#define GBL_PATTERN_NFA_STATES_MAX_     4096    // Bounds counted repetitions, which copy their atom
+#define GBL_PATTERN_REPEAT_MAX_         1000
+#define GBL_PATTERN_DFA_STATES_MAX_     1024    // Bounds subset construction blowing up
+#define GBL_PATTERN_DFA_DEAD_           0
+#define GBL_PATTERN_DFA_START_          1
+
+#define GBL_PATTERN_NFA_(parser, index) \
+    (((GblPatternNfaState_*)GblArrayList_data((parser)->pStates)) + (index))
+
+#define GBL_PATTERN_SET_BIT_(set, byte) \
+    ((set)[(uint8_t)(byte) >> 5] |= (1u << ((uint8_t)(byte) & 31)))
+
+#define GBL_PATTERN_TEST_BIT_(set, byte) \
+    ((set)[(uint8_t)(byte) >> 5] & (1u << ((uint8_t)(byte) & 31)))
+
+GBL_DECLARE_ENUM(GBL_PATTERN_NFA_) {
+    GBL_PATTERN_NFA_EPSILON_,
+    GBL_PATTERN_NFA_SPLIT_,
+    GBL_PATTERN_NFA_CHAR_,
+    GBL_PATTERN_NFA_MATCH_
+};
+
+GBL_DECLARE_STRUCT(GblPatternNfaState_) {
+    GBL_PATTERN_NFA_ type;
+    int              out;
+    int              out1;      // second branch of a split, or index of the expression for a match
+    GblBool          atEnd;     // match only counts at the end of the string
+    uint32_t         set[8];    // bytes accepted by a char state
+};
+
+// Partially built automaton, whose end is an epsilon state that's yet to be connected
+GBL_DECLARE_STRUCT(GblPatternFragment_) {
+    int start;
+    int end;
+};
+
+GBL_DECLARE_STRUCT(GblPatternParser_) {
+    GblArrayList* pStates;
+    const char*   pRegExp;
+    size_t        length;
+    size_t        pos;
+    size_t        depth;
+    GblBool       anchorStart;
+    GblBool       anchorEnd;
+    GblBool       alternation;  // top-level alternation, which anchors wouldn't apply to as a whole
+};
+
+GBL_DECLARE_STRUCT(GblPatternDfaState_) {
+    size_t  setOffset;
+    size_t  setCount;
+    GblHash hash;
+    int16_t accept;
+    int16_t acceptNow;
+};
+
+struct GblPatternDfa_ {
+    uint32_t  stateCount;
+    uint32_t  classCount;
+    int16_t*  pAccept;      // first expression matching once the string ends, or -1
+    int16_t*  pAcceptNow;   // first expression matching regardless of what follows, or -1
+    uint16_t* pNext;        // next state for each state and byte class
+    uint8_t   classes[256];
+};
+
+static int GblPatternNfa_add_(GblPatternParser_* pParser, GBL_PATTERN_NFA_ type, int out, int out1) {
+    if(GblArrayList_size(pParser->pStates) >= GBL_PATTERN_NFA_STATES_MAX_)
+        return -1;
+
+    GblPatternNfaState_* pState = GblArrayList_emplaceBack(pParser->pStates);
+    if(!pState)
+        return -1;
+
+    memset(pState, 0, sizeof(GblPatternNfaState_));
+    pState->type = type;
+    pState->out  = out;
+    pState->out1 = out1;
+
+    return (int)GblArrayList_size(pParser->pStates) - 1;
+}
+
+static GblBool GblPatternNfa_empty_(GblPatternParser_* pParser, GblPatternFragment_* pFrag) {
+    pFrag->start = pFrag->end = GblPatternNfa_add_(pParser, GBL_PATTERN_NFA_EPSILON_, -1, -1);
+    return pFrag->start >= 0;
+}
+
+static GblBool GblPatternNfa_set_(GblPatternParser_* pParser, const uint32_t* pSet, GblPatternFragment_* pFrag) {
+    const int end   = GblPatternNfa_add_(pParser, GBL_PATTERN_NFA_EPSILON_, -1, -1);
+    const int start = end >= 0? GblPatternNfa_add_(pParser, GBL_PATTERN_NFA_CHAR_, end, -1) : -1;
+
+    if(start < 0)
+        return GBL_FALSE;
+
+    memcpy(GBL_PATTERN_NFA_(pParser, start)->set, pSet, sizeof(uint32_t) * 8);
+    pFrag->start = start;
+    pFrag->end   = end;
+    return GBL_TRUE;
+}
+
+static void GblPatternNfa_concat_(GblPatternParser_*   pParser,
+                                  GblPatternFragment_* pFrag,
+                                  GblPatternFragment_  next)
+{
+    GBL_PATTERN_NFA_(pParser, pFrag->end)->out = next.start;
+    pFrag->end = next.end;
+}
+
+static GblBool GblPatternNfa_alternate_(GblPatternParser_*   pParser,
+                                        GblPatternFragment_* pFrag,
+                                        GblPatternFragment_  rhs)
+{
+    const int end   = GblPatternNfa_add_(pParser, GBL_PATTERN_NFA_EPSILON_, -1, -1);
+    const int start = end >= 0? GblPatternNfa_add_(pParser, GBL_PATTERN_NFA_SPLIT_, pFrag->start, rhs.start) : -1;
+
+    if(start < 0)
+        return GBL_FALSE;
+
+    GBL_PATTERN_NFA_(pParser, pFrag->end)->out = end;
+    GBL_PATTERN_NFA_(pParser, rhs.end)->out    = end;
+    pFrag->start = start;
+    pFrag->end   = end;
+    return GBL_TRUE;
+}
+
+// Wraps a fragment for '*' (loop and optional), '+' (loop), or '?' (optional)
+static GblBool GblPatternNfa_repeat_(GblPatternParser_*   pParser,
+                                     GblPatternFragment_* pFrag,
+                                     GblBool              loop,
+                                     GblBool              optional)
+{
+    const int end   = GblPatternNfa_add_(pParser, GBL_PATTERN_NFA_EPSILON_, -1, -1);
+    const int split = end >= 0? GblPatternNfa_add_(pParser, GBL_PATTERN_NFA_SPLIT_, pFrag->start, end) : -1;
+
+    if(split < 0)
+        return GBL_FALSE;
+
+    GBL_PATTERN_NFA_(pParser, pFrag->end)->out = loop? split : end;
+
+    if(optional)
+        pFrag->start = split;
+    pFrag->end = end;
+    return GBL_TRUE;
+}
+
+static char GblPatternParser_peek_(const GblPatternParser_* pParser) {
+    return pParser->pos < pParser->length? pParser->pRegExp[pParser->pos] : '\0';
+}
+
+static void GblPatternParser_range_(uint32_t* pSet, uint8_t first, uint8_t last) {
+    for(unsigned c = first; c <= last; ++c)
+        GBL_PATTERN_SET_BIT_(pSet, c);
+}
+
+static void GblPatternParser_invert_(uint32_t* pSet) {
+    for(unsigned w = 0; w < 8; ++w)
+        pSet[w] = ~pSet[w];
+}
+
+// Adds the bytes of an escape sequence to the set, only accepting escapes with unambiguous meanings
+static GblBool GblPatternParser_escape_(GblPatternParser_* pParser, uint32_t* pSet) {
+    uint32_t  set[8] = { 0 };
+    const char c     = pParser->pos + 1 < pParser->length? pParser->pRegExp[pParser->pos + 1] : '\0';
+
+    switch(c) {
+    case 'd': case 'D':
+        GblPatternParser_range_(set, '0', '9');
+        break;
+    case 'w': case 'W':
+        GblPatternParser_range_(set, 'a', 'z');
+        GblPatternParser_range_(set, 'A', 'Z');
+        GblPatternParser_range_(set, '0', '9');
+        GBL_PATTERN_SET_BIT_(set, '_');
+        break;
+    case 's': case 'S':
+        GBL_PATTERN_SET_BIT_(set, ' ');
+        GblPatternParser_range_(set, '\t', '\r');
+        break;
+    case '\0':
+        return GBL_FALSE;
+    default:
+        // Backreferences, word boundaries, and other letter escapes aren't supported
+        if((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))
+            return GBL_FALSE;
+        GBL_PATTERN_SET_BIT_(set, c);
+    }
+
+    if(c == 'D' || c == 'W' || c == 'S')
+        GblPatternParser_invert_(set);
+
+    for(unsigned w = 0; w < 8; ++w)
+        pSet[w] |= set[w];
+
+    pParser->pos += 2;
+    return GBL_TRUE;
+}
+
+static GblBool GblPatternParser_class_(GblPatternParser_* pParser, uint32_t* pSet) {
+    GblBool empty  = GBL_TRUE;
+    GblBool negate = GBL_FALSE;
+
+    if(++pParser->pos < pParser->length && pParser->pRegExp[pParser->pos] == '^') {
+        negate = GBL_TRUE;
+        ++pParser->pos;
+    }
+
+    while(GblPatternParser_peek_(pParser) != ']') {
+        const char c = GblPatternParser_peek_(pParser);
+
+        if(!c)
+            return GBL_FALSE;
+
+        empty = GBL_FALSE;
+
+        if(c == '\\') {
+            if(!GblPatternParser_escape_(pParser, pSet))
+                return GBL_FALSE;
+            continue;
+        }
+
+        ++pParser->pos;
+
+        const char dash = GblPatternParser_peek_(pParser);
+        const char last = pParser->pos + 1 < pParser->length? pParser->pRegExp[pParser->pos + 1] : '\0';
+
+        if(dash == '-' && last && last != ']') {
+            if(last == '\\' || (uint8_t)last < (uint8_t)c)
+                return GBL_FALSE;
+
+            GblPatternParser_range_(pSet, c, last);
+            pParser->pos += 2;
+        } else
+            GBL_PATTERN_SET_BIT_(pSet, c);
+    }
+
+    ++pParser->pos;
+
+    if(negate)
+        GblPatternParser_invert_(pSet);
+
+    return !empty;
+}
+
+static GblBool GblPatternParser_alternation_(GblPatternParser_* pParser, GblPatternFragment_* pFrag);
+
+static GblBool GblPatternParser_atom_(GblPatternParser_* pParser, GblPatternFragment_* pFrag) {
+    uint32_t set[8] = { 0 };
+
+    switch(GblPatternParser_peek_(pParser)) {
+    case '(':
+        ++pParser->pos;
+        ++pParser->depth;
+
+        if(!GblPatternParser_alternation_(pParser, pFrag) || GblPatternParser_peek_(pParser) != ')')
+            return GBL_FALSE;
+
+        ++pParser->pos;
+        --pParser->depth;
+        return GBL_TRUE;
+
+    case '[':
+        if(!GblPatternParser_class_(pParser, set))
+            return GBL_FALSE;
+        break;
+
+    case '\\':
+        if(!GblPatternParser_escape_(pParser, set))
+            return GBL_FALSE;
+        break;
+
+    case '.':
+        GblPatternParser_invert_(set);
+        ++pParser->pos;
+        break;
+
+    // Quantifiers without an atom, stray delimiters, and anchors within the expression
+    case '\0': case '|': case ')': case '*': case '+': case '?':
+    case '{':  case '}': case ']': case '^': case '$':
+        return GBL_FALSE;
+
+    default:
+        GBL_PATTERN_SET_BIT_(set, GblPatternParser_peek_(pParser));
+        ++pParser->pos;
+    }
+
+    return GblPatternNfa_set_(pParser, set, pFrag);
+}
+
+static GblBool GblPatternParser_count_(GblPatternParser_* pParser, size_t* pValue) {
+    const size_t start = pParser->pos;
+    *pValue = 0;
+
+    for(char c = GblPatternParser_peek_(pParser); c >= '0' && c <= '9'; c = GblPatternParser_peek_(pParser)) {
+        *pValue = *pValue * 10 + (size_t)(c - '0');
+        ++pParser->pos;
+
+        if(*pValue > GBL_PATTERN_REPEAT_MAX_)
+            return GBL_FALSE;
+    }
+
+    return pParser->pos != start;
+}
+
+// Parses "{n}", "{n,}", or "{n,m}", with max set to -1 when unbounded
+static GblBool GblPatternParser_braces_(GblPatternParser_* pParser, size_t* pMin, int* pMax) {
+    size_t max = 0;
+
+    ++pParser->pos;
+
+    if(!GblPatternParser_count_(pParser, pMin))
+        return GBL_FALSE;
+
+    if(GblPatternParser_peek_(pParser) == ',') {
+        ++pParser->pos;
+
+        if(GblPatternParser_peek_(pParser) == '}')
+            *pMax = -1;
+        else if(!GblPatternParser_count_(pParser, &max) || max < *pMin)
+            return GBL_FALSE;
+        else
+            *pMax = (int)max;
+    } else
+        *pMax = (int)*pMin;
+
+    if(GblPatternParser_peek_(pParser) != '}')
+        return GBL_FALSE;
+
+    ++pParser->pos;
+    return GBL_TRUE;
+}
+
+static GblBool GblPatternParser_repetition_(GblPatternParser_* pParser, GblPatternFragment_* pFrag) {
+    const size_t atomStart = pParser->pos;
+
+    if(!GblPatternParser_atom_(pParser, pFrag))
+        return GBL_FALSE;
+
+    const size_t atomEnd = pParser->pos;
+    GblBool      valid   = GBL_TRUE;
+
+    switch(GblPatternParser_peek_(pParser)) {
+    case '*': ++pParser->pos; valid = GblPatternNfa_repeat_(pParser, pFrag, GBL_TRUE,  GBL_TRUE);  break;
+    case '+': ++pParser->pos; valid = GblPatternNfa_repeat_(pParser, pFrag, GBL_TRUE,  GBL_FALSE); break;
+    case '?': ++pParser->pos; valid = GblPatternNfa_repeat_(pParser, pFrag, GBL_FALSE, GBL_TRUE);  break;
+    case '{': {
+        size_t              min;
+        int                 max;
+        GblPatternFragment_ result;
+
+        if(!GblPatternParser_braces_(pParser, &min, &max) || !GblPatternNfa_empty_(pParser, &result))
+            return GBL_FALSE;
+
+        const size_t quantifierEnd = pParser->pos;
+        const size_t copies        = max < 0? min + 1 : (size_t)max;
+
+        // Each copy past the first re-parses the atom, as the automaton can't share its states
+        for(size_t c = 0; c < copies; ++c) {
+            GblPatternFragment_ copy = *pFrag;
+
+            if(c) {
+                pParser->pos = atomStart;
+                if(!GblPatternParser_atom_(pParser, &copy) || pParser->pos != atomEnd)
+                    return GBL_FALSE;
+            }
+
+            if(c >= min && !GblPatternNfa_repeat_(pParser, &copy, max < 0, GBL_TRUE))
+                return GBL_FALSE;
+
+            GblPatternNfa_concat_(pParser, &result, copy);
+        }
+
+        pParser->pos = quantifierEnd;
+        *pFrag       = result;
+        break;
+    }
+    default: break;
+    }
+
+    // Stacked quantifiers, such as lazy ones, aren't supported
+    switch(GblPatternParser_peek_(pParser)) {
+    case '*': case '+': case '?': case '{':
+        return GBL_FALSE;
+    default:
+        return valid;
+    }
+}
+
+static GblBool GblPatternParser_concatenation_(GblPatternParser_* pParser, GblPatternFragment_* pFrag) {
+    if(!GblPatternNfa_empty_(pParser, pFrag))
+        return GBL_FALSE;
+
+    for(char c = GblPatternParser_peek_(pParser);
+        c && c != '|' && c != ')';
+        c = GblPatternParser_peek_(pParser))
+    {
+        // Anchors are only supported at the very beginning and end of the expression
+        if(c == '^' && pParser->pos == 0) {
+            pParser->anchorStart = GBL_TRUE;
+            ++pParser->pos;
+            continue;
+        }
+
+        if(c == '$' && pParser->pos + 1 == pParser->length && !pParser->depth) {
+            pParser->anchorEnd = GBL_TRUE;
+            ++pParser->pos;
+            continue;
+        }
+
+        GblPatternFragment_ next;
+
+        if(!GblPatternParser_repetition_(pParser, &next))
+            return GBL_FALSE;
+
+        GblPatternNfa_concat_(pParser, pFrag, next);
+    }
+
+    return GBL_TRUE;
+}
+
+static GblBool GblPatternParser_alternation_(GblPatternParser_* pParser, GblPatternFragment_* pFrag) {
+    if(!GblPatternParser_concatenation_(pParser, pFrag))
+        return GBL_FALSE;
+
+    while(GblPatternParser_peek_(pParser) == '|') {
+        GblPatternFragment_ rhs;
+
+        if(!pParser->depth)
+            pParser->alternation = GBL_TRUE;
+
+        ++pParser->pos;
+
+        if(!GblPatternParser_concatenation_(pParser, &rhs) ||
+           !GblPatternNfa_alternate_(pParser, pFrag, rhs))
+            return GBL_FALSE;
+    }
+
+    return GBL_TRUE;
+}
+
+static int GblPatternDfa_compareStates_(const void* pLhs, const void* pRhs) {
+    return *(const int*)pLhs - *(const int*)pRhs;
+}
+
+// Gathers the sorted char and match states reachable from the seeds through epsilon transitions
+static size_t GblPatternDfa_closure_(const GblPatternNfaState_* pNfa,
+                                     const int*                 pSeeds,
+                                     size_t                     seedCount,
+                                     int*                       pMarks,
+                                     int                        mark,
+                                     int*                       pStack,
+                                     int*                       pSet)
+{
+    size_t top   = 0;
+    size_t count = 0;
+
+    for(size_t s = 0; s < seedCount; ++s)
+        if(pMarks[pSeeds[s]] != mark) {
+            pMarks[pSeeds[s]] = mark;
+            pStack[top++]     = pSeeds[s];
+        }
+
+    while(top) {
+        const GblPatternNfaState_* pState = &pNfa[pStack[--top]];
+
+        switch(pState->type) {
+        case GBL_PATTERN_NFA_SPLIT_:
+            if(pMarks[pState->out1] != mark) {
+                pMarks[pState->out1] = mark;
+                pStack[top++]        = pState->out1;
+            }
+            GBL_FALLTHROUGH;
+        case GBL_PATTERN_NFA_EPSILON_:
+            if(pState->out >= 0 && pMarks[pState->out] != mark) {
+                pMarks[pState->out] = mark;
+                pStack[top++]       = pState->out;
+            }
+            break;
+        default:
+            pSet[count++] = (int)(pState - pNfa);
+        }
+    }
+
+    qsort(pSet, count, sizeof(int), GblPatternDfa_compareStates_);
+    return count;
+}
+
+// Returns the DFA state for the given set of NFA states, adding it if it's new, or -1 when there are too many
+static int GblPatternDfa_state_(GblArrayList*              pStates,
+                                GblArrayList*              pSets,
+                                GblArrayList*              pNext,
+                                size_t                     classCount,
+                                const GblPatternNfaState_* pNfa,
+                                const int*                 pSet,
+                                size_t                     count)
+{
+    const GblHash              hash    = gblHash(pSet, count * sizeof(int));
+    const GblPatternDfaState_* pStored = GblArrayList_data(pStates);
+    const size_t               states  = GblArrayList_size(pStates);
+
+    for(size_t s = 0; s < states; ++s)
+        if(pStored[s].hash == hash && pStored[s].setCount == count &&
+           !memcmp((const int*)GblArrayList_data(pSets) + pStored[s].setOffset, pSet, count * sizeof(int)))
+            return (int)s;
+
+    if(states >= GBL_PATTERN_DFA_STATES_MAX_)
+        return -1;
+
+    GblPatternDfaState_ state = {
+        .setOffset = GblArrayList_size(pSets),
+        .setCount  = count,
+        .hash      = hash,
+        .accept    = -1,
+        .acceptNow = -1
+    };
+
+    for(size_t s = 0; s < count; ++s) {
+        const GblPatternNfaState_* pState = &pNfa[pSet[s]];
+
+        if(pState->type != GBL_PATTERN_NFA_MATCH_)
+            continue;
+
+        if(state.accept < 0 || pState->out1 < state.accept)
+            state.accept = (int16_t)pState->out1;
+
+        if(!pState->atEnd && (state.acceptNow < 0 || pState->out1 < state.acceptNow))
+            state.acceptNow = (int16_t)pState->out1;
+    }
+
+    // The dead state's set is empty, and there's nothing to store for it
+    if((count && !GBL_RESULT_SUCCESS(GblArrayList_append(pSets, pSet, count))) ||
+       !GBL_RESULT_SUCCESS(GblArrayList_pushBack(pStates, &state))             ||
+       !GBL_RESULT_SUCCESS(GblArrayList_resize(pNext, (states + 1) * classCount)))
+        return -1;
+
+    // Transitions are filled in once the state is visited, but the dead state only ever leads to itself
+    memset((uint16_t*)GblArrayList_data(pNext) + states * classCount, 0, sizeof(uint16_t) * classCount);
+
+    return (int)states;
+}
+
+GblPatternDfa_* GblPatternDfa_create_(const char* const* ppRegExps, size_t count, GblBool search) {
+    GblPatternDfa_* pDfa      = NULL;
+    int*            pBuffers  = NULL;
+    GblBool         anchored  = GBL_TRUE;
+    GblBool         supported = GBL_TRUE;
+    GblArrayList    nfa, starts, states, sets, next;
+
+    GblArrayList_construct(&nfa,    sizeof(GblPatternNfaState_));
+    GblArrayList_construct(&starts, sizeof(int));
+    GblArrayList_construct(&states, sizeof(GblPatternDfaState_));
+    GblArrayList_construct(&sets,   sizeof(int));
+    GblArrayList_construct(&next,   sizeof(uint16_t));
+
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY(count && count <= INT16_MAX && (!search || count == 1),
+                   GBL_RESULT_ERROR_INVALID_ARG);
+
+    // Build a single NFA, with one accepting state for each expression
+    for(size_t r = 0; r < count && supported; ++r) {
+        GblPatternFragment_ frag;
+        GblPatternParser_   parser = {
+            .pStates = &nfa,
+            .pRegExp = ppRegExps[r],
+            .length  = strlen(ppRegExps[r])
+        };
+
+        supported = GblPatternParser_alternation_(&parser, &frag) &&
+                    parser.pos == parser.length                   &&
+                    !((parser.anchorStart || parser.anchorEnd) && parser.alternation);
+
+        const int match = supported? GblPatternNfa_add_(&parser, GBL_PATTERN_NFA_MATCH_, -1, (int)r) : -1;
+
+        if(match < 0) {
+            supported = GBL_FALSE;
+            break;
+        }
+
+        // Anchors are implied when matching the entire string
+        GBL_PATTERN_NFA_(&parser, match)->atEnd = search && parser.anchorEnd;
+        GBL_PATTERN_NFA_(&parser, frag.end)->out = match;
+
+        if(search && !parser.anchorStart)
+            anchored = GBL_FALSE;
+
+        GBL_CTX_VERIFY_CALL(GblArrayList_pushBack(&starts, &frag.start));
+    }
+
+    if(!supported)
+        GBL_CTX_DONE();
+
+    const GblPatternNfaState_* pNfa       = GblArrayList_data(&nfa);
+    const size_t               nfaCount   = GblArrayList_size(&nfa);
+    const size_t               startCount = GblArrayList_size(&starts);
+    uint8_t                    classes[256] = { 0 };
+    uint8_t                    reps[256];
+    size_t                     classCount = 1;
+
+    // Partition bytes into classes which every char state treats alike
+    for(size_t s = 0; s < nfaCount; ++s) {
+        if(pNfa[s].type != GBL_PATTERN_NFA_CHAR_)
+            continue;
+
+        int16_t remap[512];
+        size_t  refined = 0;
+
+        memset(remap, -1, sizeof(remap));
+
+        for(unsigned b = 0; b < 256; ++b) {
+            const unsigned key = classes[b] * 2u + !!GBL_PATTERN_TEST_BIT_(pNfa[s].set, b);
+
+            if(remap[key] < 0)
+                remap[key] = (int16_t)refined++;
+
+            classes[b] = (uint8_t)remap[key];
+        }
+
+        classCount = refined;
+    }
+
+    for(unsigned b = 256; b-- > 0; )
+        reps[classes[b]] = (uint8_t)b;
+
+    pBuffers = GBL_CTX_MALLOC(sizeof(int) * (nfaCount * 4 + startCount));
+
+    int* pMarks = pBuffers;
+    int* pStack = pMarks + nfaCount;
+    int* pSet   = pStack + nfaCount;
+    int* pSeeds = pSet   + nfaCount;
+    int  mark   = 0;
+
+    memset(pMarks, 0, sizeof(int) * nfaCount);
+
+    // The dead state is always first, followed by the start state
+    if(GblPatternDfa_state_(&states, &sets, &next, classCount, pNfa, pSet, 0) != GBL_PATTERN_DFA_DEAD_ ||
+       GblPatternDfa_state_(&states, &sets, &next, classCount, pNfa, pSet,
+                            GblPatternDfa_closure_(pNfa, GblArrayList_data(&starts), startCount,
+                                                   pMarks, ++mark, pStack, pSet)) != GBL_PATTERN_DFA_START_)
+        GBL_CTX_DONE();
+
+    // Discover states breadth-first, until every transition leads somewhere known
+    for(size_t s = GBL_PATTERN_DFA_START_; s < GblArrayList_size(&states); ++s) {
+        for(size_t c = 0; c < classCount; ++c) {
+            const GblPatternDfaState_* pState    = (const GblPatternDfaState_*)GblArrayList_data(&states) + s;
+            const int*                 pStateSet = (const int*)GblArrayList_data(&sets) + pState->setOffset;
+            size_t                     seedCount = 0;
+
+            for(size_t n = 0; n < pState->setCount; ++n) {
+                const GblPatternNfaState_* pNfaState = &pNfa[pStateSet[n]];
+
+                if(pNfaState->type == GBL_PATTERN_NFA_CHAR_ && GBL_PATTERN_TEST_BIT_(pNfaState->set, reps[c]))
+                    pSeeds[seedCount++] = pNfaState->out;
+            }
+
+            // Searching restarts every expression at each position, unless it's anchored to the beginning
+            if(!anchored)
+                for(size_t r = 0; r < startCount; ++r)
+                    pSeeds[seedCount++] = *(const int*)GblArrayList_at(&starts, r);
+
+            const int target = GblPatternDfa_state_(&states, &sets, &next, classCount, pNfa, pSet,
+                                                    GblPatternDfa_closure_(pNfa, pSeeds, seedCount,
+                                                                           pMarks, ++mark, pStack, pSet));
+            if(target < 0)
+                GBL_CTX_DONE();
+
+            ((uint16_t*)GblArrayList_data(&next))[s * classCount + c] = (uint16_t)target;
+        }
+    }
+
+    // Compact everything the matcher needs into a single allocation
+    const size_t stateCount = GblArrayList_size(&states);
+    const size_t acceptSize = gblAlignedAllocSizeDefault(sizeof(int16_t) * stateCount);
+
+    pDfa = GBL_CTX_MALLOC(gblAlignedAllocSizeDefault(sizeof(GblPatternDfa_)) + acceptSize * 2 +
+                          sizeof(uint16_t) * stateCount * classCount);
+
+    pDfa->stateCount = (uint32_t)stateCount;
+    pDfa->classCount = (uint32_t)classCount;
+    pDfa->pAccept    = (int16_t*)((uint8_t*)pDfa + gblAlignedAllocSizeDefault(sizeof(GblPatternDfa_)));
+    pDfa->pAcceptNow = (int16_t*)((uint8_t*)pDfa->pAccept + acceptSize);
+    pDfa->pNext      = (uint16_t*)((uint8_t*)pDfa->pAcceptNow + acceptSize);
+    memcpy(pDfa->classes, classes, sizeof(classes));
+    memcpy(pDfa->pNext, GblArrayList_data(&next), sizeof(uint16_t) * stateCount * classCount);
+
+    for(size_t s = 0; s < stateCount; ++s) {
+        const GblPatternDfaState_* pState = GblArrayList_at(&states, s);
+        pDfa->pAccept[s]    = pState->accept;
+        pDfa->pAcceptNow[s] = pState->acceptNow;
+    }
+
+    GBL_CTX_END_BLOCK();
+
+    if(pBuffers)
+        GBL_CTX_FREE(pBuffers);
+
+    GblArrayList_destruct(&next);
+    GblArrayList_destruct(&sets);
+    GblArrayList_destruct(&states);
+    GblArrayList_destruct(&starts);
+    GblArrayList_destruct(&nfa);
+
+    return pDfa;
+}
+
+void GblPatternDfa_destroy_(GblPatternDfa_* pSelf) {
+    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_FREE(pSelf);
+    GBL_CTX_END_BLOCK();
+}
+
+GblBool GblPatternDfa_search_(const GblPatternDfa_* pSelf, const char* pString) {
+    unsigned state = GBL_PATTERN_DFA_START_;
+
+    if(pSelf->pAcceptNow[state] >= 0)
+        return GBL_TRUE;
+
+    for(const uint8_t* pByte = (const uint8_t*)pString; *pByte; ++pByte) {
+        state = pSelf->pNext[state * pSelf->classCount + pSelf->classes[*pByte]];
+
+        if(pSelf->pAcceptNow[state] >= 0)
+            return GBL_TRUE;
+
+        if(state == GBL_PATTERN_DFA_DEAD_)
+            return GBL_FALSE;
+    }
+
+    return pSelf->pAccept[state] >= 0;
+}
+
+int GblPatternDfa_matchExact_(const GblPatternDfa_* pSelf, const char* pString, size_t length) {
+    unsigned state = GBL_PATTERN_DFA_START_;
+
+    for(size_t b = 0; b < length; ++b) {
+        state = pSelf->pNext[state * pSelf->classCount + pSelf->classes[(uint8_t)pString[b]]];
+
+        if(state == GBL_PATTERN_DFA_DEAD_)
+            return -1;
+    }
+
+    return pSelf->pAccept[state];
+}
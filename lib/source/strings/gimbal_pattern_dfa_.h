@@ -0,0 +1,36 @@
+#ifndef GIMBAL_PATTERN_DFA__H
+#define GIMBAL_PATTERN_DFA__H
+
+#include <gimbal/strings/gimbal_pattern.h>
+
+GBL_DECLS_BEGIN
+
+/* Deterministic automaton compiled from one or more regular expressions.
+
+   It's built from a Thompson NFA by subset construction over byte
+   equivalence classes, then never changes, so it can be shared between
+   threads. It only rules out patterns which can't match, in a single pass
+   without backtracking; GblPattern's backend still decides whether, and
+   where, a match begins and ends. Expressions using syntax it can't represent
+   exactly (backreferences, word boundaries, anchors other than a leading
+   '^' or trailing '$', etc.) yield no automaton, as do ones whose state
+   count would explode, and must be matched by the backend instead.
+
+   In search mode, a single expression is matched anywhere within the
+   string; otherwise, each expression must match the entire string. */
+typedef struct GblPatternDfa_ GblPatternDfa_;
+
+extern GblPatternDfa_* GblPatternDfa_create_     (const char* const* ppRegExps,
+                                                  size_t             count,
+                                                  GblBool            search);
+extern void            GblPatternDfa_destroy_    (GblPatternDfa_* pSelf);
+// Returns GBL_TRUE if a match exists anywhere within pString (search mode)
+extern GblBool         GblPatternDfa_search_     (const GblPatternDfa_* pSelf, const char* pString);
+// Returns the index of the first expression matching all of pString, or -1
+extern int             GblPatternDfa_matchExact_ (const GblPatternDfa_* pSelf,
+                                                  const char*           pString,
+                                                  size_t                length);
+
+GBL_DECLS_END
+
+#endif // GIMBAL_PATTERN_DFA__H
@@ -0,0 +1,100 @@
+#include <gimbal/strings/gimbal_pattern_set.h>
+#include <gimbal/utils/gimbal_ref.h>
+
+#include "gimbal_pattern_dfa_.h"
+
+struct GblPatternSet {
+    GblPatternDfa_*   pDfa;         // Combined exact-matching DFA, or NULL when unsupported
+    size_t            count;
+    const GblPattern* patterns[];
+};
+
+static GBL_RESULT GblPatternSet_destruct_(void* pSelf) {
+    GblPatternSet* pSet = pSelf;
+
+    for(size_t p = 0; p < pSet->count; ++p)
+        GblPattern_unref(pSet->patterns[p]);
+
+    if(pSet->pDfa)
+        GblPatternDfa_destroy_(pSet->pDfa);
+
+    return GBL_RESULT_SUCCESS;
+}
+
+GBL_EXPORT const GblPatternSet* GblPatternSet_create(const char* const* ppRegExps, size_t count) {
+    GblPatternSet* pSet = NULL;
+
+    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_VERIFY_POINTER(ppRegExps);
+    GBL_CTX_VERIFY_ARG(count);
+
+    pSet = GblRef_create(sizeof(GblPatternSet) + sizeof(const GblPattern*) * count);
+    GBL_CTX_VERIFY(pSet, GBL_RESULT_ERROR_MEM_ALLOC);
+
+    for(size_t p = 0; p < count; ++p) {
+        pSet->patterns[p] = GblPattern_create(ppRegExps[p]);
+        GBL_CTX_VERIFY(pSet->patterns[p],
+                       GBL_RESULT_ERROR_INVALID_ARG,
+                       "Failed to compile pattern [%zu]: %s", p, ppRegExps[p]);
+        ++pSet->count;
+    }
+
+    // All or nothing: a partial DFA couldn't honor the order of the patterns
+    pSet->pDfa = GblPatternDfa_create_(ppRegExps, count, GBL_FALSE);
+
+    GBL_CTX_END_BLOCK();
+    if(!GBL_RESULT_SUCCESS(GBL_CTX_RESULT()) && pSet) {
+        GblRef_unref(pSet, GblPatternSet_destruct_);
+        pSet = NULL;
+    }
+    return pSet;
+}
+
+GBL_EXPORT const GblPatternSet* GblPatternSet_ref(const GblPatternSet* pSelf) {
+    return pSelf? GblRef_ref(pSelf) : NULL;
+}
+
+GBL_EXPORT GblRefCount GblPatternSet_unref(const GblPatternSet* pSelf) {
+    return pSelf? GblRef_unref(pSelf, GblPatternSet_destruct_) : 0;
+}
+
+GBL_EXPORT GblRefCount GblPatternSet_refCount(const GblPatternSet* pSelf) {
+    return pSelf? GblRef_refCount(pSelf) : 0;
+}
+
+GBL_EXPORT size_t GblPatternSet_count(const GblPatternSet* pSelf) {
+    return pSelf? pSelf->count : 0;
+}
+
+GBL_EXPORT const GblPattern* GblPatternSet_pattern(const GblPatternSet* pSelf, size_t index) {
+    return pSelf && index < pSelf->count? pSelf->patterns[index] : NULL;
+}
+
+GBL_EXPORT GblBool GblPatternSet_dfa(const GblPatternSet* pSelf) {
+    return pSelf && pSelf->pDfa;
+}
+
+GBL_EXPORT int GblPatternSet_matchExact(const GblPatternSet* pSelf, const char* pString) {
+    if(!pSelf || !pString)
+        return -1;
+
+    size_t p = 0;
+
+    /* The DFA rules out every pattern in a single pass over the string, up to the first
+       which could match, then the rest are confirmed in order by the backend, just as
+       they would be without it */
+    if(pSelf->pDfa) {
+        const int first = GblPatternDfa_matchExact_(pSelf->pDfa, pString, strlen(pString));
+
+        if(first < 0)
+            return -1;
+
+        p = (size_t)first;
+    }
+
+    for(; p < pSelf->count; ++p)
+        if(GblPattern_matchExact(pSelf->patterns[p], pString))
+            return (int)p;
+
+    return -1;
+}
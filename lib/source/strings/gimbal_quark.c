@@ -1,13 +1,14 @@
 #include <gimbal/strings/gimbal_quark.h>
-#include <gimbal/containers/gimbal_hash_set.h>
 #include <gimbal/algorithms/gimbal_hash.h>
 #include <gimbal/allocators/gimbal_arena_allocator.h>
 #include <limits.h>
+#include <stdatomic.h>
 
 #include <tinycthread.h>
 
 #define GBL_QUARK_PAGE_SIZE_DEFAULT_            1024
 #define GBL_QUARK_REGISTRY_CAPACITY_DEFAULT_    64
+#define GBL_QUARK_REGISTRY_CAPACITY_MIN_        16
 #define GBL_QUARK_ENSURE_INITIALIZED_() \
     GBL_STMT_START {   \
         if(!initializing_) { \
@@ -16,6 +17,30 @@
         } \
     } GBL_STMT_END
 
+/* The registry is an open-addressed, linearly probed table whose slots
+ * are only ever written once: the hash is stored first, then the string
+ * pointer is published with release semantics. Readers never take a lock:
+ * they acquire the current table, then probe until they either find the
+ * string or hit an empty slot.
+ *
+ * Inserts are serialized by registryMtx_. Growing the table builds a new
+ * one off to the side and atomically swaps it in. The old table is kept
+ * on a retired list rather than freed, since a concurrent reader may
+ * still be probing it; retired tables are released in GblQuark_final(),
+ * when no readers can remain. Since tables double, the retired list never
+ * costs more memory than the live table.
+ */
+typedef struct GblQuarkSlot_ {
+    atomic_uintptr_t pString;
+    GblHash          hash;
+} GblQuarkSlot_;
+
+typedef struct GblQuarkTable_ {
+    struct GblQuarkTable_* pRetired;
+    size_t                 mask;
+    GblQuarkSlot_          slots[];
+} GblQuarkTable_;
+
 static struct {
     GblArenaAllocatorPage page;
     char                  staticBytes[GBL_QUARK_PAGE_SIZE_DEFAULT_-1];
@@ -26,38 +51,120 @@ static struct {
     }
 };
 
-static GblArenaAllocator arena_;
-static GblHashSet        registry_;
-static GblBool           initialized_    = GBL_FALSE;
-static GblBool           inittedOnce_    = GBL_FALSE;
-static once_flag         initOnce_       = ONCE_FLAG_INIT;
-static mtx_t             registryMtx_;
+static GblArenaAllocator        arena_;
+static _Atomic(GblQuarkTable_*) pRegistry_      = NULL;
+static atomic_size_t            registryCount_  = 0;
+static GblBool                  initialized_    = GBL_FALSE;
+static GblBool                  inittedOnce_    = GBL_FALSE;
+static once_flag                initOnce_       = ONCE_FLAG_INIT;
+static mtx_t                    registryMtx_;
 static
-GBL_THREAD_LOCAL GblBool initializing_   = GBL_FALSE;
+GBL_THREAD_LOCAL GblBool        initializing_   = GBL_FALSE;
+
+static GblContext*              pCtx_           = NULL;
+static size_t                   pageSize_       = GBL_QUARK_PAGE_SIZE_DEFAULT_;
+static size_t                   registryCap_    = GBL_QUARK_REGISTRY_CAPACITY_DEFAULT_;
+
+static GblQuarkTable_* GblQuarkTable_create_(size_t capacity) {
+    GblQuarkTable_* pTable = NULL;
+    size_t          slots  = GBL_QUARK_REGISTRY_CAPACITY_MIN_;
+
+    while(slots < capacity) slots <<= 1;
+
+    GBL_CTX_BEGIN(pCtx_);
+    pTable = GBL_CTX_MALLOC(sizeof(GblQuarkTable_) + sizeof(GblQuarkSlot_) * slots);
+    pTable->pRetired = NULL;
+    pTable->mask     = slots - 1;
+    for(size_t s = 0; s < slots; ++s) {
+        atomic_init(&pTable->slots[s].pString, 0);
+        pTable->slots[s].hash = 0;
+    }
+    GBL_CTX_END_BLOCK();
+
+    return pTable;
+}
+
+static void GblQuarkTable_destroy_(GblQuarkTable_* pTable) {
+    GBL_CTX_BEGIN(pCtx_);
+    while(pTable) {
+        GblQuarkTable_* pRetired = pTable->pRetired;
+        GBL_CTX_FREE(pTable);
+        pTable = pRetired;
+    }
+    GBL_CTX_END_BLOCK();
+}
+
+// Lock-free probe, length-bounded so sized lookups needn't copy the key
+static const char* GblQuarkTable_find_(const GblQuarkTable_* pTable,
+                                       const char*           pString,
+                                       size_t                length,
+                                       GblHash               hash)
+{
+    for(size_t s = hash & pTable->mask; ; s = (s + 1) & pTable->mask) {
+        const char* pEntry = (const char*)atomic_load_explicit(&pTable->slots[s].pString,
+                                                               memory_order_acquire);
+        if(!pEntry)
+            return NULL;
+
+        if(pTable->slots[s].hash == hash     &&
+           strncmp(pEntry, pString, length) == 0 &&
+           pEntry[length] == '\0')
+            return pEntry;
+    }
+}
+
+// Caller must hold registryMtx_ and have ensured there's a free slot
+static void GblQuarkTable_insert_(GblQuarkTable_* pTable, const char* pString, GblHash hash) {
+    size_t s = hash & pTable->mask;
+
+    while(atomic_load_explicit(&pTable->slots[s].pString, memory_order_relaxed))
+        s = (s + 1) & pTable->mask;
+
+    pTable->slots[s].hash = hash;
+    atomic_store_explicit(&pTable->slots[s].pString, (uintptr_t)pString, memory_order_release);
+}
+
+// Caller must hold registryMtx_
+static GblQuarkTable_* GblQuarkTable_reserve_(GblQuarkTable_* pTable, size_t count) {
+    // Keep the load factor at or below 1/2 so probe sequences stay short
+    if(count * 2 <= pTable->mask + 1)
+        return pTable;
+
+    GblQuarkTable_* pNew = GblQuarkTable_create_((pTable->mask + 1) * 2);
 
-static GblContext*       pCtx_           = NULL;
-static size_t            pageSize_       = GBL_QUARK_PAGE_SIZE_DEFAULT_;
-static size_t            registryCap_    = GBL_QUARK_REGISTRY_CAPACITY_DEFAULT_;
+    if(pNew) {
+        for(size_t s = 0; s <= pTable->mask; ++s) {
+            const char* pEntry = (const char*)atomic_load_explicit(&pTable->slots[s].pString,
+                                                                   memory_order_relaxed);
+            if(pEntry)
+                GblQuarkTable_insert_(pNew, pEntry, pTable->slots[s].hash);
+        }
+
+        pNew->pRetired = pTable;
+        atomic_store_explicit(&pRegistry_, pNew, memory_order_release);
+    }
 
-static int registryComparator_(const GblHashSet* pSet, const char** pA, const char** pB) {
-    GBL_UNUSED(pSet);
-    if(!pA || !*pA) return INT_MIN;
-    else if(!pB || !*pB) return INT_MAX;
-    else return (strcmp(*pA, *pB) == 0);
+    return pNew;
 }
 
-static GblHash registryHasher_(const GblHashSet* pSet, const char** pStr) {
-    GBL_UNUSED(pSet);
-    return gblHash(*pStr, strlen(*pStr));
+// Bounded strlen(), since sized strings may or may not be NULL-terminated
+static size_t quarkStringLength_(const char* pString, size_t length) {
+    if(!length) return strlen(pString);
+
+    size_t  len = 0;
+    while(len < length && pString[len] != '\0') ++len;
+    return len;
 }
 
-static const char* quarkStringAllocCopy_(const char* pString) {
+static const char* quarkStringAllocCopy_(const char* pString, size_t length) {
     char* pNewString = NULL;
     GBL_ASSERT(pString);
 
-    const size_t  size = strlen(pString) + 1;
-    pNewString = GblArenaAllocator_alloc(&arena_, size, 1);
-    if(pNewString) strcpy(pNewString, pString);
+    pNewString = GblArenaAllocator_alloc(&arena_, length + 1, 1);
+    if(pNewString) {
+        memcpy(pNewString, pString, length);
+        pNewString[length] = '\0';
+    }
 
     return pNewString;
 }
@@ -75,19 +182,18 @@ static void gblQuarkInit_(void) {
     mtx_init(&registryMtx_, mtx_recursive);
     mtx_lock(&registryMtx_);
     mtxLocked = GBL_TRUE;
-    GBL_CTX_CALL(GblHashSet_construct(&registry_,
-                                      sizeof(const char*),
-                                      (GblHashSetHashFn)registryHasher_,
-                                      (GblHashSetCmpFn)registryComparator_,
-                                      NULL,
-                                      registryCap_,
-                                      pCtx_));
+
+    GblQuarkTable_* pTable = GblQuarkTable_create_(registryCap_ * 2);
+    GBL_CTX_VERIFY_POINTER(pTable);
+    atomic_store(&registryCount_, 0);
+    atomic_store_explicit(&pRegistry_, pTable, memory_order_release);
 
     GBL_CTX_CALL(GblArenaAllocator_construct(&arena_,
                                              pageSize_,
                                              0,
                                              &pageStatic_.page,
-                                             pCtx_));
+                                             pCtx_,
+                                             0));
     initialized_ = GBL_TRUE;
     inittedOnce_ = GBL_TRUE;
     atexit(GblQuark_final_);
@@ -97,35 +203,41 @@ static void gblQuarkInit_(void) {
     if(mtxLocked) mtx_unlock(&registryMtx_);
 }
 
-static GblQuark quarkFromString_(const char* pString, GblBool alloc) {
-    GblQuark quark = 0;
+static GblQuark quarkFromString_(const char* pString, size_t length, GblBool alloc) {
+    GblQuark quark = GBL_QUARK_INVALID;
+
     if(pString) {
         GBL_QUARK_ENSURE_INITIALIZED_();
-        quark = GblQuark_tryString(pString);
+
+        const GblHash hash = gblHash(pString, length);
+
+        quark = (GblQuark)GblQuarkTable_find_(atomic_load_explicit(&pRegistry_,
+                                                                   memory_order_acquire),
+                                              pString, length, hash);
         if(!quark) {
             mtx_lock(&registryMtx_);
-            if(alloc) pString = quarkStringAllocCopy_(pString);
-            GBL_ASSERT(pString);
-            if(pString) {
-                GblBool inserted = GblHashSet_insert(&registry_, &pString);
-                mtx_unlock(&registryMtx_);
-                GBL_UNUSED(inserted);
-                //GBL_ASSERT(inserted);
+            GblQuarkTable_* pTable = atomic_load_explicit(&pRegistry_, memory_order_relaxed);
+
+            // Another thread may have won the race to insert the same string
+            quark = (GblQuark)GblQuarkTable_find_(pTable, pString, length, hash);
+
+            if(!quark) {
+                pTable = GblQuarkTable_reserve_(pTable, atomic_load(&registryCount_) + 1);
+                if(alloc) pString = quarkStringAllocCopy_(pString, length);
+                GBL_ASSERT(pString);
+                GBL_ASSERT(pTable);
+                if(pString && pTable) {
+                    GblQuarkTable_insert_(pTable, pString, hash);
+                    atomic_fetch_add(&registryCount_, 1);
+                    quark = (GblQuark)pString;
+                }
             }
-            quark = (GblQuark)pString;
+            mtx_unlock(&registryMtx_);
         }
     }
     return quark;
 }
 
-static inline GblQuark* GblQuark_tryString_(const char* pString) {
-    GblQuark* pQuark  = NULL;
-    mtx_lock(&registryMtx_);
-    pQuark = (GblQuark*)GblHashSet_get(&registry_, &pString);
-    mtx_unlock(&registryMtx_);
-    return pQuark;
-}
-
 GBL_EXPORT GBL_RESULT GblQuark_final(void) {
     GblBool hasMutex = GBL_FALSE;
     GBL_CTX_BEGIN(pCtx_);
@@ -133,7 +245,9 @@ GBL_EXPORT GBL_RESULT GblQuark_final(void) {
     GBL_CTX_VERIFY_EXPRESSION(initialized_);
     mtx_lock(&registryMtx_);
     hasMutex = GBL_TRUE;
-    GBL_CTX_VERIFY_CALL(GblHashSet_destruct(&registry_));
+
+    GblQuarkTable_destroy_(atomic_exchange(&pRegistry_, NULL));
+    atomic_store(&registryCount_, 0);
 
     GBL_CTX_VERIFY_CALL(GblArenaAllocator_destruct(&arena_));
 
@@ -224,7 +338,7 @@ GBL_EXPORT float GblQuark_utilization(void) {
 GBL_EXPORT size_t  GblQuark_count(void) {
     size_t  count = 0;
     if(initialized_) {
-        count = GblHashSet_size(&registry_);
+        count = atomic_load(&registryCount_);
     }
     return count;
 }
@@ -237,15 +351,15 @@ GBL_EXPORT GblQuark (GblQuark_tryString)(const char* pString, size_t length) {
     GblQuark quark = GBL_QUARK_INVALID;
 
     if(initialized_ && pString) {
-        if(length) {
-            char* pTempStr = GBL_ALLOCA(length + 1);
-            strncpy(pTempStr, pString, length);
-            pTempStr[length] = '\0';
-            pString = pTempStr;
-        }
-
-        GblQuark* pQuark = GblQuark_tryString_(pString);
-        if(pQuark) quark = *pQuark;
+        length = quarkStringLength_(pString, length);
+
+        const GblQuarkTable_* pTable = atomic_load_explicit(&pRegistry_,
+                                                            memory_order_acquire);
+        if(pTable)
+            quark = (GblQuark)GblQuarkTable_find_(pTable,
+                                                  pString,
+                                                  length,
+                                                  gblHash(pString, length));
     }
     return quark;
 }
@@ -254,20 +368,15 @@ GBL_EXPORT GblQuark (GblQuark_fromString)(const char* pString, size_t length) {
     GblQuark quark = GBL_QUARK_INVALID;
 
     if(pString) {
-        if(length) {
-            char* pTempStr = GBL_ALLOCA(length + 1);
-            strncpy(pTempStr, pString, length);
-            pTempStr[length] = '\0';
-            pString = pTempStr;
-        }
-
-        quark = quarkFromString_(pString, GBL_TRUE);
+        quark = quarkFromString_(pString,
+                                 quarkStringLength_(pString, length),
+                                 GBL_TRUE);
     }
     return quark;
 }
 
 GBL_EXPORT GblQuark GblQuark_fromStatic(const char* pString) {
-    return quarkFromString_(pString, GBL_FALSE);
+    return pString? quarkFromString_(pString, strlen(pString), GBL_FALSE) : GBL_QUARK_INVALID;
 }
 
 GBL_EXPORT const char* GblQuark_toString(GblQuark quark) {
@@ -5,11 +5,14 @@
 #include <gimbal/allocators/gimbal_allocation_tracker.h>
 #include <gimbal/meta/signals/gimbal_marshal.h>
 #include <time.h>
+#include <tinycthread.h>
 
 #define GBL_TEST_SCENARIO_(inst)    (GBL_PRIVATE(GblTestScenario, inst))
 
 typedef struct GblTestScenario_ {
     GblAllocationTracker*   pAllocTracker;
+    mtx_t                   allocMtx;       // allocations may come from any thread
+    GblBool                 tracking;       // set while the tracker itself is allocating
     GblTestSuite*           pCurSuite;
     size_t                  curCase;
     double                  suiteMs;
@@ -343,8 +346,16 @@ static GBL_RESULT GblTestScenarioClass_IAllocator_alloc_(GblIAllocator* pIAlloca
     GblContextClass* pCtxClass = GBL_CONTEXT_CLASS(GblClass_weakRefDefault(GBL_CONTEXT_TYPE));
     GblTestScenario* pSelf = (GblTestScenario*)pIAllocator;
     GblTestScenario_* pSelf_ = GBL_TEST_SCENARIO_(pSelf);
-    GBL_CTX_VERIFY_CALL(pCtxClass->GblIAllocatorImpl.pFnAlloc(pIAllocator, pFrame, size, align, pDbgStr, ppData));
-    GBL_CTX_VERIFY_CALL(GblAllocationTracker_allocEvent(pSelf_->pAllocTracker, *ppData, size, align, pDbgStr, pFrame->record.srcLocation));
+    // the tracker's own storage comes from the global context, which is this
+    // scenario, so its bookkeeping is passed straight through, untracked
+    mtx_lock(&pSelf_->allocMtx);
+    GBL_CTX_CALL(pCtxClass->GblIAllocatorImpl.pFnAlloc(pIAllocator, pFrame, size, align, pDbgStr, ppData));
+    if(GBL_RESULT_SUCCESS(GBL_CTX_RESULT()) && !pSelf_->tracking) {
+        pSelf_->tracking = GBL_TRUE;
+        GBL_CTX_CALL(GblAllocationTracker_allocEvent(pSelf_->pAllocTracker, *ppData, size, align, pDbgStr, pFrame->srcLocation));
+        pSelf_->tracking = GBL_FALSE;
+    }
+    mtx_unlock(&pSelf_->allocMtx);
     GBL_CTX_END();
 }
 
@@ -354,8 +365,14 @@ static GBL_RESULT GblTestScenarioClass_IAllocator_realloc_(GblIAllocator* pIAllo
     GblContextClass* pCtxClass = GBL_CONTEXT_CLASS(GblClass_weakRefDefault(GBL_CONTEXT_TYPE));
     GblTestScenario* pSelf = (GblTestScenario*)pIAllocator;
     GblTestScenario_* pSelf_ = GBL_TEST_SCENARIO_(pSelf);
-    GBL_CTX_VERIFY_CALL(pCtxClass->GblIAllocatorImpl.pFnRealloc(pIAllocator, pFrame, pData, newSize, newAlign, ppNewData));
-    GBL_CTX_VERIFY_CALL(GblAllocationTracker_reallocEvent(pSelf_->pAllocTracker, pData, *ppNewData, newSize, newAlign, pFrame->record.srcLocation));
+    mtx_lock(&pSelf_->allocMtx);
+    GBL_CTX_CALL(pCtxClass->GblIAllocatorImpl.pFnRealloc(pIAllocator, pFrame, pData, newSize, newAlign, ppNewData));
+    if(GBL_RESULT_SUCCESS(GBL_CTX_RESULT()) && !pSelf_->tracking) {
+        pSelf_->tracking = GBL_TRUE;
+        GBL_CTX_CALL(GblAllocationTracker_reallocEvent(pSelf_->pAllocTracker, pData, *ppNewData, newSize, newAlign, pFrame->srcLocation));
+        pSelf_->tracking = GBL_FALSE;
+    }
+    mtx_unlock(&pSelf_->allocMtx);
     GBL_CTX_END();
 }
 
@@ -365,8 +382,14 @@ static GBL_RESULT GblTestScenarioClass_IAllocator_free_(GblIAllocator* pIAllocat
     GblContextClass* pCtxClass = GBL_CONTEXT_CLASS(GblClass_weakRefDefault(GBL_CONTEXT_TYPE));
     GblTestScenario* pSelf = (GblTestScenario*)pIAllocator;
     GblTestScenario_* pSelf_ = GBL_TEST_SCENARIO_(pSelf);
-    GBL_CTX_VERIFY_CALL(pCtxClass->GblIAllocatorImpl.pFnFree(pIAllocator, pFrame, pData));
-    GBL_CTX_VERIFY_CALL(GblAllocationTracker_freeEvent(pSelf_->pAllocTracker, pData, pFrame->record.srcLocation));
+    mtx_lock(&pSelf_->allocMtx);
+    GBL_CTX_CALL(pCtxClass->GblIAllocatorImpl.pFnFree(pIAllocator, pFrame, pData));
+    if(GBL_RESULT_SUCCESS(GBL_CTX_RESULT()) && !pSelf_->tracking) {
+        pSelf_->tracking = GBL_TRUE;
+        GBL_CTX_CALL(GblAllocationTracker_freeEvent(pSelf_->pAllocTracker, pData, pFrame->srcLocation));
+        pSelf_->tracking = GBL_FALSE;
+    }
+    mtx_unlock(&pSelf_->allocMtx);
     GBL_CTX_END();
 }
 
@@ -381,6 +404,7 @@ static GBL_RESULT GblTestScenario_init_(GblInstance* pInstance) {
 
     GblContext* pParentCtx      = GblContext_parentContext(GBL_CONTEXT(pObject));
     pSelf_->pAllocTracker       = GblAllocationTracker_create(pParentCtx);
+    mtx_init(&pSelf_->allocMtx, mtx_recursive);
 
     GBL_CTX_END();
 }
@@ -392,6 +416,7 @@ static GBL_RESULT GblTestScenarioClass_destructor_(GblBox* pRecord) {
     GblTestScenario_*   pSelf_  = GBL_TEST_SCENARIO_(pSelf);
 
     GBL_CTX_VERIFY_CALL(GblAllocationTracker_destroy(pSelf_->pAllocTracker));
+    mtx_destroy(&pSelf_->allocMtx);
 
     GblContextClass* pCtxClass = GBL_CONTEXT_CLASS(GblClass_weakRefDefault(GBL_CONTEXT_TYPE));
     GBL_CTX_VERIFY_CALL(pCtxClass->base.base.pFnDestructor(pRecord));
@@ -1,6 +1,196 @@
 #include <gimbal/utils/gimbal_byte_array.h>
 #include <gimbal/algorithms/gimbal_hash.h>
 #include <gimbal/utils/gimbal_ref.h>
+#include <errno.h>
+
+#if defined(GBL_LINUX) || defined(GBL_ANDROID) || defined(GBL_MACOS) || defined(GBL_UNIX)
+#   define GBL_BYTE_ARRAY_MMAP_ 1
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#else
+#   include <stdio.h>
+#endif
+
+struct GblByteArrayBuffer_ {
+    uint8_t* pBase;     // start of the heap allocation or file mapping
+    size_t   size;      // size of the heap allocation or file mapping
+    GblBool  mapped;    // whether pBase is a read-only file mapping rather than a heap allocation
+};
+
+static GBL_RESULT GblByteArrayBuffer_destruct_(void* pRef) {
+    GblByteArrayBuffer_* pBuffer = (GblByteArrayBuffer_*)pRef;
+    GBL_CTX_BEGIN(GblRef_context(pBuffer));
+#ifdef GBL_BYTE_ARRAY_MMAP_
+    if(pBuffer->mapped) {
+        GBL_CTX_VERIFY(munmap(pBuffer->pBase, pBuffer->size) == 0,
+                       GBL_RESULT_ERROR_FILE_CLOSE,
+                       "Failed to unmap byte array: %s", strerror(errno));
+    } else
+#endif
+    if(pBuffer->pBase) GBL_CTX_FREE(pBuffer->pBase);
+    GBL_CTX_END();
+}
+
+static GblByteArrayBuffer_* GblByteArrayBuffer_create_(uint8_t* pBase, size_t size, GblBool mapped, GblContext* pCtx) {
+    GblByteArrayBuffer_* pBuffer = (GblByteArrayBuffer_*)GblRef_allocWithContext(sizeof(GblByteArrayBuffer_), pCtx);
+
+    if(pBuffer) {
+        pBuffer->pBase  = pBase;
+        pBuffer->size   = size;
+        pBuffer->mapped = mapped;
+    }
+
+    return pBuffer;
+}
+
+// Moves an allocation owned outright into a buffer, which can then be shared with slices and copies
+static GBL_RESULT GblByteArray_share_(GblByteArray* pSelf) {
+    GBL_CTX_BEGIN(GblByteArray_context(pSelf));
+
+    if(!GBL_PRIV_REF(pSelf).pBuffer && pSelf->pData) {
+        GblByteArrayBuffer_* pBuffer = GblByteArrayBuffer_create_(pSelf->pData,
+                                                                  pSelf->size,
+                                                                  GBL_FALSE,
+                                                                  GblByteArray_context(pSelf));
+        GBL_CTX_VERIFY(pBuffer, GBL_RESULT_ERROR_MEM_ALLOC);
+        GBL_PRIV_REF(pSelf).pBuffer = pBuffer;
+    }
+
+    GBL_CTX_END();
+}
+
+// Gives the array an allocation of its own to write to, copying its data out of a shared or mapped buffer
+static GBL_RESULT GblByteArray_own_(GblByteArray* pSelf) {
+    GblByteArrayBuffer_* pBuffer = GBL_PRIV_REF(pSelf).pBuffer;
+
+    if GBL_LIKELY(!pBuffer)
+        return GBL_RESULT_SUCCESS;
+
+    uint8_t* pData = NULL;
+
+    GBL_CTX_BEGIN(GblByteArray_context(pSelf));
+
+    // The last array holding a heap buffer from its own context simply takes the allocation back
+    if(GblRef_refCount(pBuffer) == 1                            &&
+       !pBuffer->mapped                                         &&
+       pSelf->pData == pBuffer->pBase                           &&
+       GblRef_context(pBuffer) == GblByteArray_context(pSelf))
+    {
+        pData          = pBuffer->pBase;
+        pBuffer->pBase = NULL;
+    } else if(pSelf->size) {
+        pData = (uint8_t*)GBL_CTX_MALLOC(pSelf->size);
+        GBL_CTX_VERIFY(pData, GBL_RESULT_ERROR_MEM_ALLOC);
+        memcpy(pData, pSelf->pData, pSelf->size);
+    }
+
+    GblRef_releaseWithDtor(pBuffer, GblByteArrayBuffer_destruct_);
+    GBL_PRIV_REF(pSelf).pBuffer = NULL;
+    pSelf->pData                = pData;
+
+    GBL_CTX_END();
+}
+
+// Maps the file before any array exists, so nothing needs cleaning up (clobbering the error) upon failure
+#ifdef GBL_BYTE_ARRAY_MMAP_
+static GBL_RESULT GblByteArray_map_(const char*           pPath,
+                                    GblContext*           pCtx,
+                                    uint8_t**             ppData,
+                                    size_t*               pSize,
+                                    GblByteArrayBuffer_** ppBuffer)
+{
+    int fd = -1;
+
+    GBL_CTX_BEGIN(pCtx);
+
+    fd = open(pPath, O_RDONLY);
+    GBL_CTX_VERIFY(fd >= 0,
+                   GBL_RESULT_ERROR_FILE_OPEN,
+                   "Failed to open file for mapping [%s]: %s", pPath, strerror(errno));
+
+    struct stat info;
+    GBL_CTX_VERIFY(fstat(fd, &info) == 0,
+                   GBL_RESULT_ERROR_FILE_READ,
+                   "Failed to query file for mapping [%s]: %s", pPath, strerror(errno));
+
+    // Empty files can't be mapped, so they're left as empty arrays
+    if(info.st_size > 0) {
+        const size_t size     = (size_t)info.st_size;
+        void*        pMapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        GBL_CTX_VERIFY(pMapping != MAP_FAILED,
+                       GBL_RESULT_ERROR_FILE_READ,
+                       "Failed to map file [%s]: %s", pPath, strerror(errno));
+
+        GblByteArrayBuffer_* pBuffer = GblByteArrayBuffer_create_(pMapping, size, GBL_TRUE, pCtx);
+
+        if(!pBuffer)
+            munmap(pMapping, size);
+
+        GBL_CTX_VERIFY(pBuffer, GBL_RESULT_ERROR_MEM_ALLOC);
+
+        *ppData   = (uint8_t*)pMapping;
+        *pSize    = size;
+        *ppBuffer = pBuffer;
+    }
+
+    GBL_CTX_END_BLOCK();
+    if(fd >= 0) close(fd);
+    return GBL_CTX_RESULT();
+}
+#else
+// Without mmap() the file is simply read into an allocation of the array's own
+static GBL_RESULT GblByteArray_map_(const char*           pPath,
+                                    GblContext*           pCtx,
+                                    uint8_t**             ppData,
+                                    size_t*               pSize,
+                                    GblByteArrayBuffer_** ppBuffer)
+{
+    FILE* pFile = NULL;
+
+    GBL_CTX_BEGIN(pCtx);
+
+    pFile = fopen(pPath, "rb");
+    GBL_CTX_VERIFY(pFile,
+                   GBL_RESULT_ERROR_FILE_OPEN,
+                   "Failed to open file for reading [%s]", pPath);
+
+    GBL_CTX_VERIFY(fseek(pFile, 0, SEEK_END) == 0,
+                   GBL_RESULT_ERROR_FILE_READ,
+                   "Failed to seek file [%s]", pPath);
+
+    const long size = ftell(pFile);
+    GBL_CTX_VERIFY(size >= 0,
+                   GBL_RESULT_ERROR_FILE_READ,
+                   "Failed to query file size [%s]", pPath);
+
+    rewind(pFile);
+
+    if(size) {
+        uint8_t* pData = (uint8_t*)GBL_CTX_MALLOC((size_t)size);
+        GBL_CTX_VERIFY(pData, GBL_RESULT_ERROR_MEM_ALLOC);
+
+        if(fread(pData, 1, (size_t)size, pFile) != (size_t)size) {
+            GBL_CTX_FREE(pData);
+            pData = NULL;
+        }
+
+        GBL_CTX_VERIFY(pData,
+                       GBL_RESULT_ERROR_FILE_READ,
+                       "Failed to read file [%s]", pPath);
+
+        *ppData   = pData;
+        *pSize    = (size_t)size;
+        *ppBuffer = NULL;
+    }
+
+    GBL_CTX_END_BLOCK();
+    if(pFile) fclose(pFile);
+    return GBL_CTX_RESULT();
+}
+#endif
 
 GBL_INLINE GBL_RESULT GblByteArray_destruct(void* pRef) {
     GblByteArray* pSelf = (GblByteArray*)pRef;
@@ -21,8 +211,9 @@ GBL_EXPORT GblByteArray* (GblByteArray_create)(size_t bytes, const void* pData,
 
     pSelf = (GblByteArray*)GblRef_allocWithContext(sizeof(GblByteArray), pCtx);
 
-    pSelf->size     = 0;
-    pSelf->pData    = NULL;
+    pSelf->size                 = 0;
+    pSelf->pData                = NULL;
+    GBL_PRIV_REF(pSelf).pBuffer = NULL;
     if(bytes) {
         GBL_CTX_VERIFY_CALL(GblByteArray_resize(pSelf, bytes));
         if(pData) {
@@ -33,11 +224,66 @@ GBL_EXPORT GblByteArray* (GblByteArray_create)(size_t bytes, const void* pData,
     return pSelf;
 }
 
+GBL_EXPORT GblByteArray* (GblByteArray_fromMapped)(const char* pPath, GblContext* pCtx) {
+    GblByteArray*        pSelf   = NULL;
+    uint8_t*             pData   = NULL;
+    size_t               size    = 0;
+    GblByteArrayBuffer_* pBuffer = NULL;
+
+    GBL_CTX_BEGIN(pCtx);
+    GBL_CTX_VERIFY_POINTER(pPath);
+    GBL_CTX_VERIFY_CALL(GblByteArray_map_(pPath, pCtx, &pData, &size, &pBuffer));
+
+    pSelf = (GblByteArray*)GblRef_allocWithContext(sizeof(GblByteArray), pCtx);
+
+    if(!pSelf) {
+        if(pBuffer)    GblRef_releaseWithDtor(pBuffer, GblByteArrayBuffer_destruct_);
+        else if(pData) GBL_CTX_FREE(pData);
+    }
+
+    GBL_CTX_VERIFY(pSelf, GBL_RESULT_ERROR_MEM_ALLOC);
+
+    pSelf->size                 = size;
+    pSelf->pData                = pData;
+    GBL_PRIV_REF(pSelf).pBuffer = pBuffer;
+
+    GBL_CTX_END_BLOCK();
+    return pSelf;
+}
+
+GBL_EXPORT GblByteArray* GblByteArray_slice(GblByteArray* pSelf, size_t offset, size_t bytes) {
+    GblByteArray* pSlice = NULL;
+    GBL_CTX_BEGIN(GblByteArray_context(pSelf));
+    GBL_CTX_VERIFY_POINTER(pSelf);
+    GBL_CTX_VERIFY(offset <= pSelf->size && bytes <= pSelf->size - offset,
+                   GBL_RESULT_ERROR_OUT_OF_RANGE);
+
+    GBL_CTX_VERIFY_CALL(GblByteArray_share_(pSelf));
+
+    pSlice = (GblByteArray*)GblRef_allocWithContext(sizeof(GblByteArray), GblByteArray_context(pSelf));
+    GBL_CTX_VERIFY(pSlice, GBL_RESULT_ERROR_MEM_ALLOC);
+
+    pSlice->size                 = 0;
+    pSlice->pData                = NULL;
+    GBL_PRIV_REF(pSlice).pBuffer = NULL;
+
+    if(bytes) {
+        pSlice->size                 = bytes;
+        pSlice->pData                = pSelf->pData + offset;
+        GBL_PRIV_REF(pSlice).pBuffer = (GblByteArrayBuffer_*)GblRef_acquire(GBL_PRIV_REF(pSelf).pBuffer);
+    }
+
+    GBL_CTX_END_BLOCK();
+    return pSlice;
+}
+
 GBL_EXPORT GBL_RESULT GblByteArray_resize(GblByteArray* pSelf, size_t  bytes) {
     GBL_CTX_BEGIN(GblByteArray_context(pSelf));
     GBL_CTX_VERIFY_POINTER(pSelf);
     if(!bytes) GBL_CTX_CALL(GblByteArray_clear(pSelf));
     else {
+        GBL_CTX_VERIFY_CALL(GblByteArray_own_(pSelf));
+
         if(!pSelf->pData) {
             pSelf->pData = (uint8_t*)GBL_CTX_MALLOC(bytes);
         } else {
@@ -79,6 +325,7 @@ GBL_EXPORT GBL_RESULT GblByteArray_erase(GblByteArray* pSelf, size_t  offset, si
     GBL_CTX_VERIFY_ARG(lastPos < GblByteArray_size(pSelf));
     GBL_CTX_VERIFY_ARG(offset <= lastPos);
     GBL_CTX_VERIFY_EXPRESSION(bytes > 0 && bytes <= GblByteArray_size(pSelf));
+    GBL_CTX_VERIFY_CALL(GblByteArray_own_(pSelf));
     remainderSize = GblByteArray_size(pSelf) - 1 - lastPos;
     if(remainderSize) memmove((uint8_t*)GblByteArray_data(pSelf)+offset,
                               (const uint8_t*)GblByteArray_data(pSelf)+lastPos+1,
@@ -138,6 +385,12 @@ GBL_EXPORT GblContext* GblByteArray_context(const GblByteArray* pSelf) {
     return GblRef_context(pSelf);
 }
 
+GBL_EXPORT GblBool GblByteArray_shared(const GblByteArray* pSelf) {
+    const GblByteArrayBuffer_* pBuffer = GBL_PRIV_REF(pSelf).pBuffer;
+
+    return pBuffer && (pBuffer->mapped || GblRef_refCount(pBuffer) > 1);
+}
+
 GBL_EXPORT size_t  GblByteArray_size(const GblByteArray* pSelf) {
     return pSelf->size;
 }
@@ -158,7 +411,19 @@ GBL_EXPORT GBL_RESULT GblByteArray_copy(GblByteArray* pSelf, const GblByteArray*
     GBL_CTX_BEGIN(GblByteArray_context(pSelf));
     GBL_CTX_VERIFY_POINTER(pSelf);
     GBL_CTX_VERIFY_POINTER(pOther);
-    GBL_CTX_CALL(GblByteArray_set(pSelf, GblByteArray_size(pOther), GblByteArray_data(pOther)));
+
+    if(pSelf != pOther) {
+        // Sharing only changes who owns the allocation of pOther, never its contents
+        GBL_CTX_VERIFY_CALL(GblByteArray_share_((GblByteArray*)pOther));
+        GBL_CTX_VERIFY_CALL(GblByteArray_clear(pSelf));
+
+        if(pOther->pData) {
+            pSelf->size                 = pOther->size;
+            pSelf->pData                = pOther->pData;
+            GBL_PRIV_REF(pSelf).pBuffer = (GblByteArrayBuffer_*)GblRef_acquire(GBL_PRIV_REF(pOther).pBuffer);
+        }
+    }
+
     GBL_CTX_END();
 }
 
@@ -168,10 +433,12 @@ GBL_EXPORT GBL_RESULT GblByteArray_move(GblByteArray* pSelf, GblByteArray* pOthe
     GBL_CTX_VERIFY_POINTER(pOther);
 
     GBL_CTX_CALL(GblByteArray_clear(pSelf));
-    pSelf->size     = pOther->size;
-    pSelf->pData    = pOther->pData;
-    pOther->size    = 0;
-    pOther->pData   = NULL;
+    pSelf->size                  = pOther->size;
+    pSelf->pData                 = pOther->pData;
+    GBL_PRIV_REF(pSelf).pBuffer  = GBL_PRIV_REF(pOther).pBuffer;
+    pOther->size                 = 0;
+    pOther->pData                = NULL;
+    GBL_PRIV_REF(pOther).pBuffer = NULL;
     GBL_CTX_END();
 }
 
@@ -182,7 +449,10 @@ GBL_EXPORT GblBool GblByteArray_equals(const GblByteArray* pSelf, const GblByteA
 GBL_EXPORT GBL_RESULT GblByteArray_clear(GblByteArray* pSelf) {
     GBL_CTX_BEGIN(GblByteArray_context(pSelf));
     GBL_CTX_VERIFY_POINTER(pSelf);
-    if(pSelf->pData) GBL_CTX_FREE(pSelf->pData);
+    if(GBL_PRIV_REF(pSelf).pBuffer) {
+        GblRef_releaseWithDtor(GBL_PRIV_REF(pSelf).pBuffer, GblByteArrayBuffer_destruct_);
+        GBL_PRIV_REF(pSelf).pBuffer = NULL;
+    } else if(pSelf->pData) GBL_CTX_FREE(pSelf->pData);
     pSelf->pData = NULL;
     pSelf->size = 0;
     GBL_CTX_END();
@@ -203,6 +473,7 @@ GBL_EXPORT GBL_RESULT GblByteArray_release(GblByteArray* pSelf, size_t * pSize,
     GBL_CTX_BEGIN(GblByteArray_context(pSelf));
     GBL_CTX_VERIFY_POINTER(pSize);
     GBL_CTX_VERIFY_POINTER(ppData);
+    GBL_CTX_VERIFY_CALL(GblByteArray_own_(pSelf));
     *pSize  = pSelf->size;
     *ppData = pSelf->pData;
     pSelf->size = 0;
@@ -255,6 +526,7 @@ GBL_EXPORT GBL_RESULT GblByteArray_write(GblByteArray* pSelf, size_t  offset, si
     GBL_CTX_VERIFY(offset < pSelf->size, GBL_RESULT_ERROR_OUT_OF_RANGE);
     GBL_CTX_VERIFY(offset + bytes <= pSelf->size, GBL_RESULT_ERROR_OUT_OF_RANGE);
     GBL_CTX_VERIFY_POINTER(pDataIn);
+    GBL_CTX_VERIFY_CALL(GblByteArray_own_(pSelf));
     memcpy((char*)pSelf->pData + offset, pDataIn, bytes);
     GBL_CTX_END();
 }
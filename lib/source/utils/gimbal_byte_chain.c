@@ -0,0 +1,232 @@
+#include <gimbal/utils/gimbal_byte_chain.h>
+#include <gimbal/utils/gimbal_ref.h>
+#include <errno.h>
+
+#if defined(GBL_LINUX) || defined(GBL_ANDROID) || defined(GBL_MACOS) || defined(GBL_UNIX)
+#   define GBL_BYTE_CHAIN_WRITEV_ 1
+#   include <sys/uio.h>
+#endif
+
+// Number of links handed to each writev(), staying on the stack and well below IOV_MAX
+#define GBL_BYTE_CHAIN_IOV_BATCH_   64
+
+#define GBL_BYTE_CHAIN_LINK_(self, index) \
+    (*(GblByteArray**)GblArrayList_at(&GBL_PRIV_REF(self).links, index))
+
+GBL_EXPORT GBL_RESULT (GblByteChain_construct)(GblByteChain* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+    GBL_CTX_VERIFY_POINTER(pSelf);
+
+    GBL_CTX_VERIFY_CALL(GblArrayList_construct(&GBL_PRIV_REF(pSelf).links,
+                                               sizeof(GblByteArray*),
+                                               0,
+                                               NULL,
+                                               sizeof(GblArrayList),
+                                               GBL_FALSE,
+                                               pCtx));
+    GBL_PRIV_REF(pSelf).size = 0;
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblByteChain_destruct(GblByteChain* pSelf) {
+    GBL_CTX_BEGIN(GblByteChain_context(pSelf));
+    GBL_CTX_VERIFY_CALL(GblByteChain_clear(pSelf));
+    GBL_CTX_VERIFY_CALL(GblArrayList_destruct(&GBL_PRIV_REF(pSelf).links));
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GblContext* GblByteChain_context(const GblByteChain* pSelf) {
+    return GblArrayList_context(&GBL_PRIV_REF(pSelf).links);
+}
+
+GBL_EXPORT size_t GblByteChain_size(const GblByteChain* pSelf) {
+    return GBL_PRIV_REF(pSelf).size;
+}
+
+GBL_EXPORT size_t GblByteChain_count(const GblByteChain* pSelf) {
+    return GblArrayList_size(&GBL_PRIV_REF(pSelf).links);
+}
+
+GBL_EXPORT GblBool GblByteChain_empty(const GblByteChain* pSelf) {
+    return GBL_PRIV_REF(pSelf).size == 0;
+}
+
+GBL_EXPORT GblByteArray* GblByteChain_link(const GblByteChain* pSelf, size_t index) {
+    GblByteArray** ppLink = GblArrayList_at(&GBL_PRIV_REF(pSelf).links, index);
+
+    return ppLink? *ppLink : NULL;
+}
+
+// Stores a slice of the array rather than the array itself, so later writes to it copy on write instead of changing the chain
+static GBL_RESULT GblByteChain_insert_(GblByteChain* pSelf,
+                                       GblByteArray* pArray,
+                                       size_t        offset,
+                                       size_t        bytes,
+                                       GblBool       front)
+{
+    GblByteArray* pLink = NULL;
+
+    GBL_CTX_BEGIN(GblByteChain_context(pSelf));
+    GBL_CTX_VERIFY_POINTER(pArray);
+
+    pLink = GblByteArray_slice(pArray, offset, bytes);
+    GBL_CTX_VERIFY_LAST_RECORD();
+
+    // Empty links contribute nothing, so they're never stored
+    if(pLink->size) {
+        if(front) GBL_CTX_VERIFY_CALL(GblArrayList_pushFront(&GBL_PRIV_REF(pSelf).links, &pLink));
+        else      GBL_CTX_VERIFY_CALL(GblArrayList_pushBack(&GBL_PRIV_REF(pSelf).links, &pLink));
+
+        GBL_PRIV_REF(pSelf).size += pLink->size;
+        pLink = NULL;
+    }
+
+    GBL_CTX_END_BLOCK();
+    if(pLink) GblByteArray_unref(pLink);
+    return GBL_CTX_RESULT();
+}
+
+GBL_EXPORT GBL_RESULT GblByteChain_append(GblByteChain* pSelf, GblByteArray* pArray) {
+    return GblByteChain_insert_(pSelf, pArray, 0, pArray? pArray->size : 0, GBL_FALSE);
+}
+
+GBL_EXPORT GBL_RESULT GblByteChain_prepend(GblByteChain* pSelf, GblByteArray* pArray) {
+    return GblByteChain_insert_(pSelf, pArray, 0, pArray? pArray->size : 0, GBL_TRUE);
+}
+
+GBL_EXPORT GBL_RESULT GblByteChain_appendSlice(GblByteChain* pSelf,
+                                               GblByteArray* pArray,
+                                               size_t        offset,
+                                               size_t        bytes)
+{
+    return GblByteChain_insert_(pSelf, pArray, offset, bytes, GBL_FALSE);
+}
+
+GBL_EXPORT GBL_RESULT GblByteChain_clear(GblByteChain* pSelf) {
+    GBL_CTX_BEGIN(GblByteChain_context(pSelf));
+
+    for(size_t l = 0; l < GblByteChain_count(pSelf); ++l)
+        GblByteArray_unref(GBL_BYTE_CHAIN_LINK_(pSelf, l));
+
+    GBL_CTX_VERIFY_CALL(GblArrayList_clear(&GBL_PRIV_REF(pSelf).links));
+    GBL_PRIV_REF(pSelf).size = 0;
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblByteChain_read(const GblByteChain* pSelf, size_t offset, size_t bytes, void* pOut) {
+    GBL_CTX_BEGIN(GblByteChain_context(pSelf));
+    GBL_CTX_VERIFY(offset <= GBL_PRIV_REF(pSelf).size && bytes <= GBL_PRIV_REF(pSelf).size - offset,
+                   GBL_RESULT_ERROR_OUT_OF_RANGE);
+    GBL_CTX_VERIFY_POINTER(pOut);
+
+    uint8_t* pDst = (uint8_t*)pOut;
+
+    for(size_t l = 0; bytes && l < GblByteChain_count(pSelf); ++l) {
+        const GblByteArray* pLink = GBL_BYTE_CHAIN_LINK_(pSelf, l);
+
+        // Skip over whole links preceding the offset
+        if(offset >= pLink->size) {
+            offset -= pLink->size;
+            continue;
+        }
+
+        const size_t count = GBL_MIN(pLink->size - offset, bytes);
+        memcpy(pDst, pLink->pData + offset, count);
+
+        pDst   += count;
+        bytes  -= count;
+        offset  = 0;
+    }
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GblByteArray* GblByteChain_flatten(const GblByteChain* pSelf) {
+    GblByteArray* pArray = NULL;
+    GBL_CTX_BEGIN(GblByteChain_context(pSelf));
+
+    pArray = GblByteArray_create(0, NULL, GblByteChain_context(pSelf));
+    GBL_CTX_VERIFY(pArray, GBL_RESULT_ERROR_MEM_ALLOC);
+
+    // A single link is already contiguous, so it's just shared
+    if(GblByteChain_count(pSelf) == 1) {
+        GBL_CTX_VERIFY_CALL(GblByteArray_copy(pArray, GBL_BYTE_CHAIN_LINK_(pSelf, 0)));
+    } else if(GBL_PRIV_REF(pSelf).size) {
+        GBL_CTX_VERIFY_CALL(GblByteArray_resize(pArray, GBL_PRIV_REF(pSelf).size));
+        GBL_CTX_VERIFY_CALL(GblByteChain_read(pSelf, 0, GBL_PRIV_REF(pSelf).size, pArray->pData));
+    }
+
+    GBL_CTX_END_BLOCK();
+    if(!GBL_RESULT_SUCCESS(GBL_CTX_RESULT()) && pArray) {
+        GblByteArray_unref(pArray);
+        pArray = NULL;
+    }
+    return pArray;
+}
+
+GBL_EXPORT GBL_RESULT (GblByteChain_write)(const GblByteChain* pSelf, int fd, size_t* pWritten) {
+    size_t total = 0;
+    GBL_CTX_BEGIN(GblByteChain_context(pSelf));
+
+#ifdef GBL_BYTE_CHAIN_WRITEV_
+    const size_t count      = GblByteChain_count(pSelf);
+    size_t       link       = 0;
+    size_t       linkOffset = 0;
+
+    while(link < count) {
+        struct iovec iov[GBL_BYTE_CHAIN_IOV_BATCH_];
+        int          iovCount = 0;
+
+        for(size_t l = link, o = linkOffset;
+            l < count && iovCount < GBL_BYTE_CHAIN_IOV_BATCH_;
+            ++l, o = 0)
+        {
+            const GblByteArray* pLink = GBL_BYTE_CHAIN_LINK_(pSelf, l);
+            iov[iovCount].iov_base = pLink->pData + o;
+            iov[iovCount].iov_len  = pLink->size - o;
+            ++iovCount;
+        }
+
+        ssize_t written = writev(fd, iov, iovCount);
+
+        if GBL_UNLIKELY(written < 0) {
+            if(errno == EINTR) continue;
+            GBL_CTX_VERIFY(GBL_FALSE,
+                           GBL_RESULT_ERROR_FILE_WRITE,
+                           "Failed to write byte chain: %s", strerror(errno));
+        }
+
+        // Nothing written with data left to go would otherwise spin forever
+        GBL_CTX_VERIFY(written,
+                       GBL_RESULT_ERROR_FILE_WRITE,
+                       "Failed to write byte chain: no bytes were written");
+
+        total += (size_t)written;
+
+        // Advance past everything written, resuming mid-link after a partial write
+        while(written > 0) {
+            const size_t remaining = GBL_BYTE_CHAIN_LINK_(pSelf, link)->size - linkOffset;
+
+            if((size_t)written >= remaining) {
+                written    -= (ssize_t)remaining;
+                linkOffset  = 0;
+                ++link;
+            } else {
+                linkOffset += (size_t)written;
+                written     = 0;
+            }
+        }
+    }
+#else
+    GBL_UNUSED(fd);
+    GBL_CTX_VERIFY(GBL_FALSE,
+                   GBL_RESULT_UNSUPPORTED,
+                   "Gather writes are not supported on this platform!");
+#endif
+
+    GBL_CTX_END_BLOCK();
+    if(pWritten) *pWritten = total;
+    return GBL_CTX_RESULT();
+}
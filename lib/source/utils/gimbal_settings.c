@@ -2,18 +2,36 @@
 #include <gimbal/containers/gimbal_hash_set.h>
 #include <gimbal/containers/gimbal_nary_tree.h>
 #include <gimbal/strings/gimbal_string_buffer.h>
+#include <gimbal/strings/gimbal_quark.h>
 #include <gimbal/meta/types/gimbal_variant.h>
+#include <gimbal/meta/classes/gimbal_enum.h>
+#include <gimbal/meta/classes/gimbal_flags.h>
+#include <gimbal/algorithms/gimbal_hash.h>
+#include <stdio.h>
+
+#if defined(GBL_LINUX) || defined(GBL_ANDROID) || defined(GBL_MACOS) || defined(GBL_UNIX)
+#   define GBL_SETTINGS_FSYNC_ 1
+#   include <unistd.h>
+#elif defined(GBL_WIN32)
+#   include <windows.h>
+#endif
 
 #define GBL_SETTINGS_HASHSET_SIZE_DEFAULT_  32
 #define GBL_SETTINGS_(self)                 (GBL_PRIVATE(GblSettings, self))
 
+#define GBL_SETTINGS_IMAGE_MAGIC_           0x534c4247  // "GBLS"
+#define GBL_SETTINGS_IMAGE_VERSION_         1
+#define GBL_SETTINGS_IMAGE_SLOTS_MIN_       8
+
 typedef union GblSettingsNode {
     GblNaryTreeNode treeNode;
 } GblSettingsNode;
 
 GBL_DECLARE_STRUCT(GblSettings_) {
-    GblHashSet      hashSet;
+    GblHashSet      hashSet;    // entries written since the image was loaded, nil values marking removals
     GblStringBuffer scope;
+    uint32_t        scopeHash;  // CRC-32 of the scope, continued over keys when probing the image
+    GblByteArray*   pImage;     // mapped compiled settings image, or NULL
 };
 
 GBL_DECLARE_STRUCT(GblSettingsEntry_) {
@@ -21,6 +39,74 @@ GBL_DECLARE_STRUCT(GblSettingsEntry_) {
     GblVariant      value;
 };
 
+// Kind of value stored by an image entry, decoupled from GblType, whose IDs differ between runs
+GBL_DECLARE_ENUM(GBL_SETTINGS_IMAGE_KIND_) {
+    GBL_SETTINGS_IMAGE_KIND_INVALID_,
+    GBL_SETTINGS_IMAGE_KIND_BOOL_,
+    GBL_SETTINGS_IMAGE_KIND_CHAR_,
+    GBL_SETTINGS_IMAGE_KIND_UINT8_,
+    GBL_SETTINGS_IMAGE_KIND_UINT16_,
+    GBL_SETTINGS_IMAGE_KIND_INT16_,
+    GBL_SETTINGS_IMAGE_KIND_UINT32_,
+    GBL_SETTINGS_IMAGE_KIND_INT32_,
+    GBL_SETTINGS_IMAGE_KIND_UINT64_,
+    GBL_SETTINGS_IMAGE_KIND_INT64_,
+    GBL_SETTINGS_IMAGE_KIND_FLOAT_,
+    GBL_SETTINGS_IMAGE_KIND_DOUBLE_,
+    GBL_SETTINGS_IMAGE_KIND_STRING_,    // value.string within the string pool
+    GBL_SETTINGS_IMAGE_KIND_TYPE_,      // type name as value.string within the string pool
+    GBL_SETTINGS_IMAGE_KIND_ENUM_,      // typeOffset names the enum type
+    GBL_SETTINGS_IMAGE_KIND_FLAGS_      // typeOffset names the flags type
+};
+
+/* Compiled settings image, stored in native byte order and
+ * mapped straight from disk:
+ *
+ *   header | uint32_t slots[slotCount] | entries[entryCount] | string pool
+ *
+ * Slots form an open-addressed table indexed by the CRC-32 of each
+ * fully-qualified key, holding entry index + 1, or 0 when empty.
+ * Keys and strings are NUL-terminated within the string pool.
+ */
+GBL_DECLARE_STRUCT(GblSettingsImageHeader_) {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;
+    uint32_t entryCount;
+    uint32_t slotCount;
+    uint32_t entryOffset;
+    uint32_t stringOffset;
+    uint32_t stringSize;
+};
+
+GBL_DECLARE_STRUCT(GblSettingsImageEntry_) {
+    uint32_t hash;
+    uint32_t keyOffset;
+    uint32_t keyLength;
+    uint32_t kind;
+    uint32_t typeOffset;
+    uint32_t reserved;
+    union {
+        uint64_t u64;
+        int64_t  i64;
+        double   f64;
+        struct {
+            uint32_t offset;
+            uint32_t length;
+        }        string;
+    }        value;
+};
+
+// Entry gathered for compilation, from either the current image or the written entries
+GBL_DECLARE_STRUCT(GblSettingsCompileEntry_) {
+    const char*            pKey;
+    size_t                 keyLength;
+    GblSettingsImageEntry_ image;
+    const char*            pString;
+    size_t                 stringLength;
+    const char*            pTypeName;
+};
+
 static GblHash GblSettings_hashSet_hasher_(const GblHashSet* pSet, const void* pEntry) {
     const GblSettingsEntry_* pEntry_ = pEntry;
     return gblHash(pEntry_->pKey, strlen(pEntry_->pKey));
@@ -54,6 +140,12 @@ GBL_EXPORT const char* GblSettings_scope(const GblSettings* pSelf) {
     return GblStringBuffer_cString(&GBL_SETTINGS_(pSelf)->scope);
 }
 
+static void GblSettings_hashScope_(GblSettings_* pSelf_) {
+    pSelf_->scopeHash = gblHashCrcPartial(GblStringBuffer_cString(&pSelf_->scope),
+                                          GblStringBuffer_length(&pSelf_->scope),
+                                          NULL);
+}
+
 GBL_EXPORT const char* GblSettings_pushScope(GblSettings* pSelf, const char* pKey) {
     GblSettings_* pSelf_ = GBL_SETTINGS_(pSelf);
 
@@ -62,6 +154,8 @@ GBL_EXPORT const char* GblSettings_pushScope(GblSettings* pSelf, const char* pKe
     else
         GblStringBuffer_append(&pSelf_->scope, pKey);
 
+    GblSettings_hashScope_(pSelf_);
+
     return GblStringBuffer_cString(&pSelf_->scope);
 }
 
@@ -87,38 +181,267 @@ GBL_EXPORT const char* GblSettings_pop(GblSettings* pSelf) {
     else
         GblStringBuffer_clear(&pSelf_->scope);
 
+    GblSettings_hashScope_(pSelf_);
+
     GBL_CTX_END_BLOCK();
     return GblStringBuffer_cString(&pSelf_->scope);
 }
 
-static GBL_RESULT GblSettings_read_(GblSettings* pSelf, const char* pKey, GblVariant* pValue) {
-    GBL_CTX_BEGIN(NULL);
+// Validates the layout of a compiled image once upon loading, so probes only bounds-check what they touch
+static GblBool GblSettings_validateImage_(const GblByteArray* pImage) {
+    if(pImage->size < sizeof(GblSettingsImageHeader_))
+        return GBL_FALSE;
 
-    GblBool            absolute = GBL_FALSE;
-    GblSettingsEntry_* pEntry   = NULL;
+    const GblSettingsImageHeader_* pHeader = (const GblSettingsImageHeader_*)pImage->pData;
 
-    // If not absolute path, append key to scope
-    if(pKey[0] != '/')
-        pKey = GblSettings_pushScope(pSelf, pKey);
-    else {  // else use key directly, skipping '/'
+    return pHeader->magic   == GBL_SETTINGS_IMAGE_MAGIC_                                            &&
+           pHeader->version == GBL_SETTINGS_IMAGE_VERSION_                                          &&
+           pHeader->size    == pImage->size                                                         &&
+           pHeader->slotCount && !(pHeader->slotCount & (pHeader->slotCount - 1))                   &&
+           pHeader->entryCount <= pHeader->slotCount                                                &&
+           !(pHeader->entryOffset % sizeof(uint64_t))                                               &&
+           pHeader->entryOffset >= sizeof(GblSettingsImageHeader_) +
+                                   (uint64_t)pHeader->slotCount * sizeof(uint32_t)                  &&
+           pHeader->stringOffset >= pHeader->entryOffset +
+                                    (uint64_t)pHeader->entryCount * sizeof(GblSettingsImageEntry_)  &&
+           (uint64_t)pHeader->stringOffset + pHeader->stringSize == pHeader->size                   &&
+           pHeader->stringSize && !pImage->pData[pHeader->size - 1];
+}
+
+// Probes the image for the key formed by "prefix/key" (or just key without a prefix), without building it
+static const GblSettingsImageEntry_* GblSettings_probeImage_(const GblByteArray* pImage,
+                                                             const char*         pPrefix,
+                                                             size_t              prefixLength,
+                                                             const char*         pKey,
+                                                             size_t              keyLength,
+                                                             uint32_t            hash)
+{
+    const GblSettingsImageHeader_* pHeader    = (const GblSettingsImageHeader_*)pImage->pData;
+    const uint32_t*                pSlots     = (const uint32_t*)(pImage->pData + sizeof(GblSettingsImageHeader_));
+    const GblSettingsImageEntry_*  pEntries   = (const GblSettingsImageEntry_*)(pImage->pData + pHeader->entryOffset);
+    const char*                    pStrings   = (const char*)pImage->pData + pHeader->stringOffset;
+    const size_t                   fullLength = prefixLength? prefixLength + 1 + keyLength : keyLength;
+    const uint32_t                 mask       = pHeader->slotCount - 1;
+
+    for(uint32_t s = hash & mask, p = 0; p < pHeader->slotCount; s = (s + 1) & mask, ++p) {
+        const uint32_t slot = pSlots[s];
+
+        if(!slot || GBL_UNLIKELY(slot > pHeader->entryCount))
+            break;
+
+        const GblSettingsImageEntry_* pEntry = &pEntries[slot - 1];
+
+        if(pEntry->hash != hash || pEntry->keyLength != fullLength ||
+           GBL_UNLIKELY((uint64_t)pEntry->keyOffset + fullLength >= pHeader->stringSize))
+            continue;
+
+        const char* pStored = pStrings + pEntry->keyOffset;
+
+        if(prefixLength) {
+            if(memcmp(pStored, pPrefix, prefixLength) || pStored[prefixLength] != '/')
+                continue;
+            pStored += prefixLength + 1;
+        }
+
+        if(!memcmp(pStored, pKey, keyLength))
+            return pEntry;
+    }
+
+    return NULL;
+}
+
+// Resolves a key against the current scope, unless it's absolute or already \p qualified, then probes the image
+static const GblSettingsImageEntry_* GblSettings_findImage_(const GblSettings_* pSelf_,
+                                                            const char*         pKey,
+                                                            GblBool             qualified)
+{
+    if(!pSelf_->pImage)
+        return NULL;
+
+    const char* pPrefix      = NULL;
+    size_t      prefixLength = 0;
+    uint32_t    hash         = 0;
+
+    if(pKey[0] == '/')
         ++pKey;
-        absolute = GBL_TRUE;
+    else if(!qualified && !GblStringBuffer_empty(&pSelf_->scope)) {
+        pPrefix      = GblStringBuffer_cString(&pSelf_->scope);
+        prefixLength = GblStringBuffer_length(&pSelf_->scope);
+        hash         = pSelf_->scopeHash;
+        hash         = gblHashCrcPartial("/", 1, &hash);
     }
 
-    // Grab entry
-    pEntry = GblHashSet_get(&GBL_SETTINGS_(pSelf)->hashSet, &pKey);
+    const size_t keyLength = strlen(pKey);
+    hash = gblHashCrcPartial(pKey, keyLength, pPrefix? &hash : NULL);
 
-    // Copy value if we have it, set nil otherwise
-    if(pEntry)
-        GblVariant_setCopy(pValue, &pEntry->value);
+    return GblSettings_probeImage_(pSelf_->pImage, pPrefix, prefixLength, pKey, keyLength, hash);
+}
+
+static GBL_RESULT GblSettings_decodeImage_(const GblByteArray*           pImage,
+                                           const GblSettingsImageEntry_* pEntry,
+                                           GblVariant*                   pValue)
+{
+    GBL_CTX_BEGIN(NULL);
+
+    const GblSettingsImageHeader_* pHeader  = (const GblSettingsImageHeader_*)pImage->pData;
+    const char*                    pStrings = (const char*)pImage->pData + pHeader->stringOffset;
+
+    switch(pEntry->kind) {
+    case GBL_SETTINGS_IMAGE_KIND_BOOL_:   GblVariant_setBool(pValue,   (GblBool)pEntry->value.u64);  break;
+    case GBL_SETTINGS_IMAGE_KIND_CHAR_:   GblVariant_setChar(pValue,   (char)pEntry->value.i64);     break;
+    case GBL_SETTINGS_IMAGE_KIND_UINT8_:  GblVariant_setUint8(pValue,  (uint8_t)pEntry->value.u64);  break;
+    case GBL_SETTINGS_IMAGE_KIND_UINT16_: GblVariant_setUint16(pValue, (uint16_t)pEntry->value.u64); break;
+    case GBL_SETTINGS_IMAGE_KIND_INT16_:  GblVariant_setInt16(pValue,  (int16_t)pEntry->value.i64);  break;
+    case GBL_SETTINGS_IMAGE_KIND_UINT32_: GblVariant_setUint32(pValue, (uint32_t)pEntry->value.u64); break;
+    case GBL_SETTINGS_IMAGE_KIND_INT32_:  GblVariant_setInt32(pValue,  (int32_t)pEntry->value.i64);  break;
+    case GBL_SETTINGS_IMAGE_KIND_UINT64_: GblVariant_setUint64(pValue, pEntry->value.u64);           break;
+    case GBL_SETTINGS_IMAGE_KIND_INT64_:  GblVariant_setInt64(pValue,  pEntry->value.i64);           break;
+    case GBL_SETTINGS_IMAGE_KIND_FLOAT_:  GblVariant_setFloat(pValue,  (float)pEntry->value.f64);    break;
+    case GBL_SETTINGS_IMAGE_KIND_DOUBLE_: GblVariant_setDouble(pValue, pEntry->value.f64);           break;
+
+    case GBL_SETTINGS_IMAGE_KIND_STRING_:
+    case GBL_SETTINGS_IMAGE_KIND_TYPE_:
+        GBL_CTX_VERIFY((uint64_t)pEntry->value.string.offset + pEntry->value.string.length < pHeader->stringSize,
+                       GBL_RESULT_ERROR_OUT_OF_RANGE,
+                       "Corrupt string within settings image");
+
+        if(pEntry->kind == GBL_SETTINGS_IMAGE_KIND_STRING_)
+            GblVariant_setStringView(pValue, GBL_STRV(pStrings + pEntry->value.string.offset,
+                                                      pEntry->value.string.length));
+        else
+            GblVariant_setTypeValue(pValue, GblType_find(pStrings + pEntry->value.string.offset));
+        break;
+
+    case GBL_SETTINGS_IMAGE_KIND_ENUM_:
+    case GBL_SETTINGS_IMAGE_KIND_FLAGS_: {
+        GBL_CTX_VERIFY(pEntry->typeOffset < pHeader->stringSize,
+                       GBL_RESULT_ERROR_OUT_OF_RANGE,
+                       "Corrupt type name within settings image");
+
+        // Enum and flags types must be registered before their settings can be read back
+        const GblType type = GblType_find(pStrings + pEntry->typeOffset);
+        GBL_CTX_VERIFY(type != GBL_INVALID_TYPE,
+                       GBL_RESULT_ERROR_INVALID_TYPE,
+                       "Unregistered type for setting: [%s]",
+                       pStrings + pEntry->typeOffset);
+
+        if(pEntry->kind == GBL_SETTINGS_IMAGE_KIND_ENUM_)
+            GblVariant_setEnum(pValue, type, (GblEnum)pEntry->value.u64);
+        else
+            GblVariant_setFlags(pValue, type, (GblFlags)pEntry->value.u64);
+        break;
+    }
+
+    default:
+        GBL_CTX_VERIFY(GBL_FALSE,
+                       GBL_RESULT_ERROR_INVALID_TYPE,
+                       "Unknown value kind within settings image: %u",
+                       pEntry->kind);
+    }
+
+    GBL_CTX_END();
+}
+
+// Describes the value of a written entry for compilation, returning GBL_FALSE for types which can't persist
+static GblBool GblSettings_encodeImage_(const GblVariant* pValue, GblSettingsCompileEntry_* pCompiled) {
+    const GblType type = GblVariant_typeOf(pValue);
+
+    if(type == GBL_BOOL_TYPE) {
+        pCompiled->image.kind      = GBL_SETTINGS_IMAGE_KIND_BOOL_;
+        pCompiled->image.value.u64 = pValue->boolean;
+    } else if(type == GBL_CHAR_TYPE) {
+        pCompiled->image.kind      = GBL_SETTINGS_IMAGE_KIND_CHAR_;
+        pCompiled->image.value.i64 = pValue->character;
+    } else if(type == GBL_UINT8_TYPE) {
+        pCompiled->image.kind      = GBL_SETTINGS_IMAGE_KIND_UINT8_;
+        pCompiled->image.value.u64 = pValue->u8;
+    } else if(type == GBL_UINT16_TYPE) {
+        pCompiled->image.kind      = GBL_SETTINGS_IMAGE_KIND_UINT16_;
+        pCompiled->image.value.u64 = pValue->u16;
+    } else if(type == GBL_INT16_TYPE) {
+        pCompiled->image.kind      = GBL_SETTINGS_IMAGE_KIND_INT16_;
+        pCompiled->image.value.i64 = pValue->i16;
+    } else if(type == GBL_UINT32_TYPE) {
+        pCompiled->image.kind      = GBL_SETTINGS_IMAGE_KIND_UINT32_;
+        pCompiled->image.value.u64 = pValue->u32;
+    } else if(type == GBL_INT32_TYPE) {
+        pCompiled->image.kind      = GBL_SETTINGS_IMAGE_KIND_INT32_;
+        pCompiled->image.value.i64 = pValue->i32;
+    } else if(type == GBL_UINT64_TYPE) {
+        pCompiled->image.kind      = GBL_SETTINGS_IMAGE_KIND_UINT64_;
+        pCompiled->image.value.u64 = pValue->u64;
+    } else if(type == GBL_INT64_TYPE) {
+        pCompiled->image.kind      = GBL_SETTINGS_IMAGE_KIND_INT64_;
+        pCompiled->image.value.i64 = pValue->i64;
+    } else if(type == GBL_FLOAT_TYPE) {
+        pCompiled->image.kind      = GBL_SETTINGS_IMAGE_KIND_FLOAT_;
+        pCompiled->image.value.f64 = pValue->f32;
+    } else if(type == GBL_DOUBLE_TYPE) {
+        pCompiled->image.kind      = GBL_SETTINGS_IMAGE_KIND_DOUBLE_;
+        pCompiled->image.value.f64 = pValue->f64;
+    } else if(type == GBL_STRING_TYPE) {
+        pCompiled->image.kind      = GBL_SETTINGS_IMAGE_KIND_STRING_;
+        pCompiled->pString         = pValue->pString? pValue->pString : "";
+        pCompiled->stringLength    = pValue->pString? GblStringRef_length(pValue->pString) : 0;
+    } else if(type == GBL_TYPE_TYPE) {
+        pCompiled->image.kind      = GBL_SETTINGS_IMAGE_KIND_TYPE_;
+        pCompiled->pString         = GblType_name(pValue->typeValue);
+        if(!pCompiled->pString) return GBL_FALSE;
+        pCompiled->stringLength    = strlen(pCompiled->pString);
+    } else if(GblType_derives(type, GBL_ENUM_TYPE)) {
+        pCompiled->image.kind      = GBL_SETTINGS_IMAGE_KIND_ENUM_;
+        pCompiled->image.value.u64 = pValue->enumeration;
+        pCompiled->pTypeName       = GblType_name(type);
+    } else if(GblType_derives(type, GBL_FLAGS_TYPE)) {
+        pCompiled->image.kind      = GBL_SETTINGS_IMAGE_KIND_FLAGS_;
+        pCompiled->image.value.u64 = pValue->flags;
+        pCompiled->pTypeName       = GblType_name(type);
+    } else return GBL_FALSE;
+
+    return GBL_TRUE;
+}
+
+// Returns the entry written since the image was loaded for the given key, or NULL
+static GblSettingsEntry_* GblSettings_findEntry_(GblSettings* pSelf, const char* pKey) {
+    GblSettings_* pSelf_ = GBL_SETTINGS_(pSelf);
+
+    // Only build the fully-qualified key when there's anything to look it up in
+    if(!GblHashSet_size(&pSelf_->hashSet))
+        return NULL;
+
+    const GblBool absolute = pKey[0] == '/';
+
+    if(!absolute)
+        pKey = GblSettings_pushScope(pSelf, pKey);
     else
-        GblVariant_setNil(pValue);
+        ++pKey;
 
+    GblSettingsEntry_* pEntry = GblHashSet_get(&pSelf_->hashSet, &pKey);
 
-    // Pop key from scope scope if not absolute key
     if(!absolute)
         GblSettings_pop(pSelf);
 
+    return pEntry;
+}
+
+static GBL_RESULT GblSettings_read_(GblSettings* pSelf, const char* pKey, GblVariant* pValue) {
+    GBL_CTX_BEGIN(NULL);
+
+    GblSettings_*      pSelf_ = GBL_SETTINGS_(pSelf);
+    GblSettingsEntry_* pEntry = GblSettings_findEntry_(pSelf, pKey);
+
+    // Entries written since loading take precedence over (and nil ones mask) the image
+    if(pEntry)
+        GblVariant_setCopy(pValue, &pEntry->value);
+    else {
+        const GblSettingsImageEntry_* pImageEntry = GblSettings_findImage_(pSelf_, pKey, GBL_FALSE);
+
+        if(pImageEntry)
+            GBL_CTX_VERIFY_CALL(GblSettings_decodeImage_(pSelf_->pImage, pImageEntry, pValue));
+        else
+            GblVariant_setNil(pValue);
+    }
+
     GBL_CTX_END();
 }
 
@@ -136,40 +459,75 @@ static GBL_RESULT GblSettings_write_(GblSettings* pSelf, const char* pKey, GblVa
         absolute = GBL_TRUE;
     }
 
+    // Grab entry and image entry, if they exist
+    GblSettingsEntry_*            pEntry      = GblHashSet_get(&pSelf_->hashSet, &pKey);
+    const GblSettingsImageEntry_* pImageEntry = GblSettings_findImage_(pSelf_, pKey, GBL_TRUE);
+
     // Check if we're removing an entry (setting it equal to "nil")
     if(GblVariant_isNil(pValue)) {
-        const GblBool erased = GblHashSet_erase(&pSelf_->hashSet, &pKey);
-        GBL_CTX_VERIFY(erased,
+        GBL_CTX_VERIFY(pEntry? !GblVariant_isNil(&pEntry->value) : pImageEntry != NULL,
                        GBL_RESULT_ERROR_INTERNAL,
                        "Erase failed for setting key: [%s]",
                        pKey);
 
-        // Emit erased signal
-        GBL_EMIT(pSelf, "erased", pKey);
+        // Keys within the image are masked with a nil entry until it's recompiled
+        if(pImageEntry) {
+            if(!pEntry) {
+                pEntry = GblHashSet_emplace(&pSelf_->hashSet, &pKey);
+                GBL_CTX_VERIFY(pEntry,
+                               GBL_RESULT_ERROR_INTERNAL,
+                               "Failed to find entry for key [%s]",
+                               pKey);
 
-    } else { // Setting existing or adding new entry
+                pEntry->pKey = GblStringRef_create(pKey);
+                GblVariant_constructNil(&pEntry->value);
+            } else
+                GblVariant_setNil(&pEntry->value);
+        } else
+            GblHashSet_erase(&pSelf_->hashSet, &pKey);
+
+        pSelf->dirty = GBL_TRUE;
 
-        // Grab entry, if exists
-        GblSettingsEntry_* pEntry = GblHashSet_get(&pSelf_->hashSet, &pKey);
-        GblBool added = GBL_FALSE;
+        // Emit removed signal
+        GBL_EMIT(pSelf, "removed", pKey);
+
+    } else { // Setting existing or adding new entry
 
-        // If it doesn't exist, emplace a new one
+        // If it doesn't exist, emplace a new one, unless the image already holds the same value
         if(!pEntry) {
-            pEntry = GblHashSet_emplace(&pSelf_->hashSet, &pKey);
-            GBL_CTX_VERIFY(pEntry,
-                           GBL_RESULT_ERROR_INTERNAL,
-                           "Failed to find entry for key [%s]",
-                           pKey);
+            GblBool unchanged = GBL_FALSE;
+
+            if(pImageEntry) {
+                GblVariant current;
+                GblVariant_constructNil(&current);
+
+                if(GBL_RESULT_SUCCESS(GblSettings_decodeImage_(pSelf_->pImage, pImageEntry, &current)))
+                    unchanged = GblVariant_equals(&current, pValue);
+
+                GblVariant_destruct(&current);
+            }
+
+            if(!unchanged) {
+                pEntry = GblHashSet_emplace(&pSelf_->hashSet, &pKey);
+                GBL_CTX_VERIFY(pEntry,
+                               GBL_RESULT_ERROR_INTERNAL,
+                               "Failed to find entry for key [%s]",
+                               pKey);
 
-            // Set new Entry fields
-            pEntry->pKey = GblStringRef_create(pKey);
-            GblVariant_constructMove(&pEntry->value, pValue);
-            GBL_EMIT(pSelf, "added", pKey);
+                // Set new Entry fields
+                pEntry->pKey = GblStringRef_create(pKey);
+                GblVariant_constructMove(&pEntry->value, pValue);
+                pSelf->dirty = GBL_TRUE;
+                GBL_EMIT(pSelf, pImageEntry? "changed" : "added", pKey);
+            }
 
         // If entry exists + value has changed
         } else if(!GblVariant_equals(&pEntry->value, pValue)) {
+            const GblBool added = GblVariant_isNil(&pEntry->value) && !pImageEntry;
+
             GblVariant_setMove(&pEntry->value, pValue);
-            GBL_EMIT(pSelf, "changed", pKey);
+            pSelf->dirty = GBL_TRUE;
+            GBL_EMIT(pSelf, added? "added" : "changed", pKey);
         }
     }
 
@@ -180,6 +538,506 @@ static GBL_RESULT GblSettings_write_(GblSettings* pSelf, const char* pKey, GblVa
     GBL_CTX_END();
 }
 
+static GBL_RESULT GblSettings_save_(GblSettings* pSelf) {
+    GblByteArray* pImage   = NULL;
+    FILE*         pFile    = NULL;
+    char*         pTmpPath = NULL;
+
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY(pSelf->pPath,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "Cannot save GblSettings without a path!");
+
+    pSelf->status = GBL_SETTINGS_STATUS_ERROR_FILE;
+
+    pImage = GblByteArray_create(0);
+    GBL_CTX_VERIFY_CALL(GblSettings_compile(pSelf, pImage));
+
+    const size_t pathLength = GblStringRef_length(pSelf->pPath);
+    pTmpPath = GBL_ALLOCA(pathLength + sizeof(".tmp"));
+    memcpy(pTmpPath, pSelf->pPath, pathLength);
+    memcpy(pTmpPath + pathLength, ".tmp", sizeof(".tmp"));
+
+    // Write the new image next to the old one, then swap it in, so it's never seen half-written
+    pFile = fopen(pTmpPath, "wb");
+    GBL_CTX_VERIFY(pFile,
+                   GBL_RESULT_ERROR_FILE_OPEN,
+                   "Failed to open settings file for writing: [%s]",
+                   pTmpPath);
+
+    GBL_CTX_VERIFY(fwrite(pImage->pData, 1, pImage->size, pFile) == pImage->size &&
+                   fflush(pFile) == 0,
+                   GBL_RESULT_ERROR_FILE_WRITE,
+                   "Failed to write settings file: [%s]",
+                   pTmpPath);
+#ifdef GBL_SETTINGS_FSYNC_
+    GBL_CTX_VERIFY(fsync(fileno(pFile)) == 0,
+                   GBL_RESULT_ERROR_FILE_WRITE,
+                   "Failed to flush settings file: [%s]",
+                   pTmpPath);
+#endif
+
+    const int closed = fclose(pFile);
+    pFile = NULL;
+    GBL_CTX_VERIFY(closed == 0,
+                   GBL_RESULT_ERROR_FILE_CLOSE,
+                   "Failed to close settings file: [%s]",
+                   pTmpPath);
+
+#ifdef GBL_WIN32
+    // rename() won't replace an existing file on Windows
+    const GblBool replaced = MoveFileExA(pTmpPath, pSelf->pPath, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    const GblBool replaced = rename(pTmpPath, pSelf->pPath) == 0;
+#endif
+    if GBL_UNLIKELY(!replaced)
+        remove(pTmpPath);
+
+    GBL_CTX_VERIFY(replaced,
+                   GBL_RESULT_ERROR_FILE_WRITE,
+                   "Failed to replace settings file: [%s]",
+                   pSelf->pPath);
+
+    pSelf->status = GBL_SETTINGS_STATUS_OK;
+    pSelf->dirty  = GBL_FALSE;
+
+    GBL_CTX_END_BLOCK();
+
+    if(pFile) {
+        fclose(pFile);
+        remove(pTmpPath);
+    }
+
+    if(pImage) GblByteArray_unref(pImage);
+
+    return GBL_CTX_RESULT();
+}
+
+static GBL_RESULT GblSettings_load_(GblSettings* pSelf) {
+    GblByteArray* pImage = NULL;
+
+    GBL_CTX_BEGIN(NULL);
+
+    GblSettings_* pSelf_ = GBL_SETTINGS_(pSelf);
+
+    GBL_CTX_VERIFY(pSelf->pPath,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "Cannot load GblSettings without a path!");
+
+    pSelf->status = GBL_SETTINGS_STATUS_ERROR_FILE;
+
+    pImage = GblByteArray_fromMapped(pSelf->pPath);
+    GBL_CTX_VERIFY(pImage,
+                   GBL_RESULT_ERROR_FILE_OPEN,
+                   "Failed to map settings file: [%s]",
+                   pSelf->pPath);
+
+    pSelf->status = GBL_SETTINGS_STATUS_ERROR_FORMAT;
+
+    GBL_CTX_VERIFY(GblSettings_validateImage_(pImage),
+                   GBL_RESULT_ERROR_FILE_READ,
+                   "Invalid settings image: [%s]",
+                   pSelf->pPath);
+
+    // The new image replaces every entry written since the previous one was loaded
+    GblHashSet_clear(&pSelf_->hashSet);
+
+    if(pSelf_->pImage)
+        GblByteArray_unref(pSelf_->pImage);
+
+    pSelf_->pImage = pImage;
+    pImage         = NULL;
+    pSelf->status  = GBL_SETTINGS_STATUS_OK;
+    pSelf->dirty   = GBL_FALSE;
+
+    GBL_CTX_END_BLOCK();
+
+    if(pImage) GblByteArray_unref(pImage);
+
+    return GBL_CTX_RESULT();
+}
+
+GBL_EXPORT GBL_RESULT GblSettings_compile(const GblSettings* pSelf, GblByteArray* pImage) {
+    GblArrayList entries;
+    GblArrayList_construct(&entries, sizeof(GblSettingsCompileEntry_));
+
+    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_VERIFY_POINTER(pSelf);
+    GBL_CTX_VERIFY_POINTER(pImage);
+
+    const GblSettings_* pSelf_ = GBL_SETTINGS_(pSelf);
+
+    // Gather entries of the current image which haven't been written over since it was loaded
+    if(pSelf_->pImage) {
+        const GblSettingsImageHeader_* pHeader  = (const GblSettingsImageHeader_*)pSelf_->pImage->pData;
+        const GblSettingsImageEntry_*  pEntries = (const GblSettingsImageEntry_*)(pSelf_->pImage->pData +
+                                                                                  pHeader->entryOffset);
+        const char*                    pStrings = (const char*)pSelf_->pImage->pData + pHeader->stringOffset;
+
+        for(uint32_t e = 0; e < pHeader->entryCount; ++e) {
+            const GblSettingsImageEntry_* pEntry = &pEntries[e];
+
+            GBL_CTX_VERIFY((uint64_t)pEntry->keyOffset + pEntry->keyLength < pHeader->stringSize &&
+                           pEntry->typeOffset < pHeader->stringSize,
+                           GBL_RESULT_ERROR_OUT_OF_RANGE,
+                           "Corrupt settings image entry: %u",
+                           e);
+
+            const char* pKey = pStrings + pEntry->keyOffset;
+
+            if(GblHashSet_get(&pSelf_->hashSet, &pKey))
+                continue;
+
+            GblSettingsCompileEntry_* pCompiled = GblArrayList_emplaceBack(&entries);
+            GBL_CTX_VERIFY_LAST_RECORD();
+
+            memset(pCompiled, 0, sizeof(GblSettingsCompileEntry_));
+            pCompiled->pKey      = pKey;
+            pCompiled->keyLength = pEntry->keyLength;
+            pCompiled->image     = *pEntry;
+
+            if(pEntry->kind == GBL_SETTINGS_IMAGE_KIND_STRING_ ||
+               pEntry->kind == GBL_SETTINGS_IMAGE_KIND_TYPE_)
+            {
+                GBL_CTX_VERIFY((uint64_t)pEntry->value.string.offset + pEntry->value.string.length <
+                               pHeader->stringSize,
+                               GBL_RESULT_ERROR_OUT_OF_RANGE,
+                               "Corrupt settings image entry: %u",
+                               e);
+
+                pCompiled->pString      = pStrings + pEntry->value.string.offset;
+                pCompiled->stringLength = pEntry->value.string.length;
+            } else if(pEntry->kind == GBL_SETTINGS_IMAGE_KIND_ENUM_ ||
+                      pEntry->kind == GBL_SETTINGS_IMAGE_KIND_FLAGS_)
+            {
+                pCompiled->pTypeName = pStrings + pEntry->typeOffset;
+            }
+        }
+    }
+
+    // Then gather every entry written since, skipping removals
+    for(size_t b = 0; b < GblHashSet_bucketCount(&pSelf_->hashSet); ++b) {
+        const GblSettingsEntry_* pEntry = GblHashSet_probe(&pSelf_->hashSet, b);
+
+        if(!pEntry || GblVariant_isNil(&pEntry->value))
+            continue;
+
+        GblSettingsCompileEntry_ compiled;
+        memset(&compiled, 0, sizeof(GblSettingsCompileEntry_));
+
+        if(!GblSettings_encodeImage_(&pEntry->value, &compiled)) {
+            GBL_CTX_WARN("Skipping setting [%s] of unsupported type [%s]",
+                         pEntry->pKey,
+                         GblType_name(GblVariant_typeOf(&pEntry->value)));
+            continue;
+        }
+
+        compiled.pKey      = pEntry->pKey;
+        compiled.keyLength = GblStringRef_length(pEntry->pKey);
+
+        GBL_CTX_VERIFY_CALL(GblArrayList_pushBack(&entries, &compiled));
+    }
+
+    // Lay out the index at no more than half load, and the string pool behind an empty string
+    const size_t count      = GblArrayList_size(&entries);
+    size_t       slotCount  = GBL_SETTINGS_IMAGE_SLOTS_MIN_;
+    size_t       stringSize = 1;
+
+    while(slotCount < count * 2)
+        slotCount <<= 1;
+
+    for(size_t e = 0; e < count; ++e) {
+        const GblSettingsCompileEntry_* pCompiled = GblArrayList_at(&entries, e);
+
+        stringSize += pCompiled->keyLength + 1;
+
+        if(pCompiled->pString)
+            stringSize += pCompiled->stringLength + 1;
+
+        if(pCompiled->pTypeName)
+            stringSize += strlen(pCompiled->pTypeName) + 1;
+    }
+
+    const size_t entryOffset  = gblAlignedAllocSizeDefault(sizeof(GblSettingsImageHeader_) +
+                                                           slotCount * sizeof(uint32_t));
+    const size_t stringOffset = entryOffset + count * sizeof(GblSettingsImageEntry_);
+    const size_t size         = stringOffset + stringSize;
+
+    GBL_CTX_VERIFY(size <= UINT32_MAX,
+                   GBL_RESULT_ERROR_OVERFLOW,
+                   "Settings image exceeds 4GB: %zu bytes",
+                   size);
+
+    // Clear first, so resizing zero-fills the whole image
+    GBL_CTX_VERIFY_CALL(GblByteArray_clear(pImage));
+    GBL_CTX_VERIFY_CALL(GblByteArray_resize(pImage, size));
+
+    GblSettingsImageHeader_* pHeader  = (GblSettingsImageHeader_*)pImage->pData;
+    uint32_t*                pSlots   = (uint32_t*)(pImage->pData + sizeof(GblSettingsImageHeader_));
+    GblSettingsImageEntry_*  pEntries = (GblSettingsImageEntry_*)(pImage->pData + entryOffset);
+    char*                    pStrings = (char*)pImage->pData + stringOffset;
+    uint32_t                 offset   = 1;
+
+    pHeader->magic        = GBL_SETTINGS_IMAGE_MAGIC_;
+    pHeader->version      = GBL_SETTINGS_IMAGE_VERSION_;
+    pHeader->size         = (uint32_t)size;
+    pHeader->entryCount   = (uint32_t)count;
+    pHeader->slotCount    = (uint32_t)slotCount;
+    pHeader->entryOffset  = (uint32_t)entryOffset;
+    pHeader->stringOffset = (uint32_t)stringOffset;
+    pHeader->stringSize   = (uint32_t)stringSize;
+
+    for(size_t e = 0; e < count; ++e) {
+        const GblSettingsCompileEntry_* pCompiled = GblArrayList_at(&entries, e);
+        GblSettingsImageEntry_*         pEntry    = &pEntries[e];
+
+        *pEntry           = pCompiled->image;
+        pEntry->hash      = gblHashCrcPartial(pCompiled->pKey, pCompiled->keyLength, NULL);
+        pEntry->keyOffset = offset;
+        pEntry->keyLength = (uint32_t)pCompiled->keyLength;
+        memcpy(pStrings + offset, pCompiled->pKey, pCompiled->keyLength);
+        offset += (uint32_t)pCompiled->keyLength + 1;
+
+        pEntry->typeOffset = 0;
+        if(pCompiled->pTypeName) {
+            const size_t length = strlen(pCompiled->pTypeName);
+            pEntry->typeOffset  = offset;
+            memcpy(pStrings + offset, pCompiled->pTypeName, length);
+            offset += (uint32_t)length + 1;
+        }
+
+        if(pCompiled->pString) {
+            pEntry->value.string.offset = offset;
+            pEntry->value.string.length = (uint32_t)pCompiled->stringLength;
+            memcpy(pStrings + offset, pCompiled->pString, pCompiled->stringLength);
+            offset += (uint32_t)pCompiled->stringLength + 1;
+        }
+
+        uint32_t s = pEntry->hash & (uint32_t)(slotCount - 1);
+        while(pSlots[s])
+            s = (s + 1) & (uint32_t)(slotCount - 1);
+        pSlots[s] = (uint32_t)e + 1;
+    }
+
+    GBL_CTX_END_BLOCK();
+    GblArrayList_destruct(&entries);
+    return GBL_CTX_RESULT();
+}
+
+GBL_EXPORT GBL_RESULT GblSettings_save(GblSettings* pSelf) {
+    GBL_CTX_BEGIN(NULL);
+    GBL_VCALL(GblSettings, pFnSave, pSelf);
+    GBL_CTX_END_BLOCK();
+    GBL_EMIT(pSelf, "saved", GBL_CTX_RESULT());
+    return GBL_CTX_RESULT();
+}
+
+GBL_EXPORT GBL_RESULT GblSettings_load(GblSettings* pSelf) {
+    GBL_CTX_BEGIN(NULL);
+    GBL_VCALL(GblSettings, pFnLoad, pSelf);
+    GBL_CTX_END_BLOCK();
+    GBL_EMIT(pSelf, "loaded", GBL_CTX_RESULT());
+    return GBL_CTX_RESULT();
+}
+
+GBL_EXPORT GBL_RESULT GblSettings_sync(GblSettings* pSelf) {
+    GBL_CTX_BEGIN(NULL);
+
+    if(pSelf->dirty)
+        GBL_CTX_VERIFY_CALL(GblSettings_save(pSelf));
+
+    GBL_CTX_VERIFY_CALL(GblSettings_load(pSelf));
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblSettings_variant(const GblSettings* pSelf, const char* pKey, GblVariant* pVariant) {
+    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_VERIFY_POINTER(pKey);
+    GBL_CTX_VERIFY_POINTER(pVariant);
+
+    // Reading only pushes onto the scope temporarily, leaving it as it was
+    GBL_VCALL(GblSettings, pFnRead, (GblSettings*)pSelf, pKey, pVariant);
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblSettings_toValue(const GblSettings* pSelf, const char* pKey, GblType type, ...) {
+    GblVariant variant;
+    va_list    varArgs;
+
+    GblVariant_constructNil(&variant);
+    va_start(varArgs, type);
+
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY_CALL(GblSettings_variant(pSelf, pKey, &variant));
+
+    GBL_CTX_VERIFY(!GblVariant_isNil(&variant),
+                   GBL_RESULT_ERROR_INVALID_KEY,
+                   "No setting found for key: [%s]",
+                   pKey);
+
+    GBL_CTX_VERIFY_CALL(GblVariant_asValueVa(&variant, type, &varArgs));
+
+    GBL_CTX_END_BLOCK();
+
+    va_end(varArgs);
+    GblVariant_destruct(&variant);
+
+    return GBL_CTX_RESULT();
+}
+
+GBL_EXPORT GblType GblSettings_typeOf(const GblSettings* pSelf, const char* pKey) {
+    GblVariant variant;
+    GblVariant_constructNil(&variant);
+
+    const GblType type = GBL_RESULT_SUCCESS(GblSettings_variant(pSelf, pKey, &variant))?
+                            GblVariant_typeOf(&variant) : GBL_INVALID_TYPE;
+
+    GblVariant_destruct(&variant);
+    return type;
+}
+
+GBL_EXPORT GblBool GblSettings_isNil(const GblSettings* pSelf, const char* pKey) {
+    return GblSettings_typeOf(pSelf, pKey) == GBL_NIL_TYPE;
+}
+
+#define GBL_SETTINGS_GETTER_(name, cType, variantName)                          \
+    GBL_EXPORT cType GblSettings_to##name(const GblSettings* pSelf,             \
+                                          const char*        pKey,              \
+                                          cType              defaultValue)      \
+    {                                                                           \
+        GblVariant variant;                                                     \
+        cType      value = defaultValue;                                        \
+                                                                                \
+        GblVariant_constructNil(&variant);                                      \
+                                                                                \
+        if(GBL_RESULT_SUCCESS(GblSettings_variant(pSelf, pKey, &variant)) &&    \
+           !GblVariant_isNil(&variant))                                         \
+            value = GblVariant_to##variantName(&variant);                       \
+                                                                                \
+        GblVariant_destruct(&variant);                                          \
+        return value;                                                           \
+    }
+
+GBL_SETTINGS_GETTER_(Bool,    GblBool,  Bool)
+GBL_SETTINGS_GETTER_(Char,    char,     Char)
+GBL_SETTINGS_GETTER_(Uint8,   uint8_t,  Uint8)
+GBL_SETTINGS_GETTER_(Uint16,  uint16_t, Uint16)
+GBL_SETTINGS_GETTER_(Int16,   int16_t,  Int16)
+GBL_SETTINGS_GETTER_(Uint32,  uint32_t, Uint32)
+GBL_SETTINGS_GETTER_(Int32,   int32_t,  Int32)
+GBL_SETTINGS_GETTER_(Uint64,  uint64_t, Uint64)
+GBL_SETTINGS_GETTER_(Int64,   int64_t,  Int64)
+GBL_SETTINGS_GETTER_(Size,    size_t,   Size)
+GBL_SETTINGS_GETTER_(Enum,    GblEnum,  Enum)
+GBL_SETTINGS_GETTER_(Flags,   GblFlags, Flags)
+GBL_SETTINGS_GETTER_(Float,   float,    Float)
+GBL_SETTINGS_GETTER_(Double,  double,   Double)
+GBL_SETTINGS_GETTER_(Pointer, void*,    Pointer)
+GBL_SETTINGS_GETTER_(Type,    GblType,  TypeValue)
+
+#undef GBL_SETTINGS_GETTER_
+
+GBL_EXPORT const char* GblSettings_toString(const GblSettings* pSelf, const char* pKey, const char* pDefValue) {
+    if(!pKey) return pDefValue;
+
+    GblSettings_*      pSelf_ = GBL_SETTINGS_(pSelf);
+    GblSettingsEntry_* pEntry = GblSettings_findEntry_((GblSettings*)pSelf, pKey);
+
+    // Strings are returned in place, from the written entry's reference or the image's string pool
+    if(pEntry) {
+        GblStringRef* pRef = GblVariant_typeOf(&pEntry->value) == GBL_STRING_TYPE?
+                                 GblVariant_string(&pEntry->value) : NULL;
+        return pRef? pRef : pDefValue;
+    }
+
+    const GblSettingsImageEntry_* pImageEntry = GblSettings_findImage_(pSelf_, pKey, GBL_FALSE);
+
+    if(!pImageEntry || pImageEntry->kind != GBL_SETTINGS_IMAGE_KIND_STRING_)
+        return pDefValue;
+
+    const GblSettingsImageHeader_* pHeader = (const GblSettingsImageHeader_*)pSelf_->pImage->pData;
+
+    if GBL_UNLIKELY((uint64_t)pImageEntry->value.string.offset +
+                    pImageEntry->value.string.length >= pHeader->stringSize)
+        return pDefValue;
+
+    return (const char*)pSelf_->pImage->pData + pHeader->stringOffset + pImageEntry->value.string.offset;
+}
+
+static GBL_RESULT GblSettings_setVariant_(GblSettings* pSelf, const char* pKey, GblVariant* pVariant) {
+    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_VERIFY_POINTER(pKey);
+    GBL_VCALL(GblSettings, pFnWrite, pSelf, pKey, pVariant);
+    GBL_CTX_END_BLOCK();
+    GblVariant_destruct(pVariant);
+    return GBL_CTX_RESULT();
+}
+
+#define GBL_SETTINGS_SETTER_(name, cType)                                               \
+    GBL_EXPORT GBL_RESULT GblSettings_set##name(GblSettings* pSelf,                     \
+                                                const char*  pKey,                      \
+                                                cType        value)                     \
+    {                                                                                   \
+        GblVariant variant;                                                             \
+        GblVariant_constructNil(&variant);                                              \
+        GblVariant_set##name(&variant, value);                                          \
+        return GblSettings_setVariant_(pSelf, pKey, &variant);                          \
+    }
+
+GBL_SETTINGS_SETTER_(Bool,   GblBool)
+GBL_SETTINGS_SETTER_(Char,   char)
+GBL_SETTINGS_SETTER_(Uint8,  uint8_t)
+GBL_SETTINGS_SETTER_(Uint16, uint16_t)
+GBL_SETTINGS_SETTER_(Int16,  int16_t)
+GBL_SETTINGS_SETTER_(Uint32, uint32_t)
+GBL_SETTINGS_SETTER_(Int32,  int32_t)
+GBL_SETTINGS_SETTER_(Uint64, uint64_t)
+GBL_SETTINGS_SETTER_(Int64,  int64_t)
+GBL_SETTINGS_SETTER_(Size,   size_t)
+GBL_SETTINGS_SETTER_(Float,  float)
+GBL_SETTINGS_SETTER_(Double, double)
+GBL_SETTINGS_SETTER_(String, const char*)
+
+#undef GBL_SETTINGS_SETTER_
+
+GBL_EXPORT GBL_RESULT GblSettings_setNil(GblSettings* pSelf, const char* pKey) {
+    GblVariant variant;
+    GblVariant_constructNil(&variant);
+    return GblSettings_setVariant_(pSelf, pKey, &variant);
+}
+
+GBL_EXPORT GBL_RESULT GblSettings_setEnum(GblSettings* pSelf, const char* pKey, GblType type, GblEnum value) {
+    GblVariant variant;
+    GblVariant_constructNil(&variant);
+    GblVariant_setEnum(&variant, type, value);
+    return GblSettings_setVariant_(pSelf, pKey, &variant);
+}
+
+GBL_EXPORT GBL_RESULT GblSettings_setFlags(GblSettings* pSelf, const char* pKey, GblType type, GblFlags value) {
+    GblVariant variant;
+    GblVariant_constructNil(&variant);
+    GblVariant_setFlags(&variant, type, value);
+    return GblSettings_setVariant_(pSelf, pKey, &variant);
+}
+
+GBL_EXPORT GBL_RESULT GblSettings_setPointer(GblSettings* pSelf, const char* pKey, void* pValue) {
+    GblVariant variant;
+    GblVariant_constructNil(&variant);
+    GblVariant_setPointer(&variant, GBL_POINTER_TYPE, pValue);
+    return GblSettings_setVariant_(pSelf, pKey, &variant);
+}
+
+GBL_EXPORT GBL_RESULT GblSettings_setType(GblSettings* pSelf, const char* pKey, GblType value) {
+    GblVariant variant;
+    GblVariant_constructNil(&variant);
+    GblVariant_setTypeValue(&variant, value);
+    return GblSettings_setVariant_(pSelf, pKey, &variant);
+}
+
 static GBL_RESULT GblSettings_Object_property(const GblObject* pObject, const GblProperty* pProperty, GblVariant* pValue) {
     GBL_CTX_BEGIN(NULL);
     GBL_CTX_END();
@@ -205,6 +1063,9 @@ static GBL_RESULT GblSettings_Box_destructor_(GblBox* pBox) {
     GBL_CTX_CALL(GblHashSet_destruct(&pSelf_->hashSet));
     GBL_CTX_CALL(GblStringBuffer_destruct(&pSelf_->scope));
 
+    if(pSelf_->pImage)
+        GblByteArray_unref(pSelf_->pImage);
+
     // Call parent's destructor
     GBL_VCALL_DEFAULT(GblObject, base.pFnDestructor, pBox);
 
@@ -228,6 +1089,9 @@ static GBL_RESULT GblSettings_init_(GblInstance* pInstance) {
 
     GBL_CTX_CALL(GblStringBuffer_construct(&pSelf_->scope));
 
+    GblSettings_hashScope_(pSelf_);
+    pSelf_->pImage = NULL;
+
     GBL_CTX_END();
 }
 
@@ -239,6 +1103,8 @@ static GBL_RESULT GblSettingsClass_init_(GblClass* pClass, const void* pUd) {
     GBL_OBJECT_CLASS(pClass)  ->pFnSetProperty = GblSettings_Object_setProperty;
     GBL_SETTINGS_CLASS(pClass)->pFnRead        = GblSettings_read_;
     GBL_SETTINGS_CLASS(pClass)->pFnWrite       = GblSettings_write_;
+    GBL_SETTINGS_CLASS(pClass)->pFnSave        = GblSettings_save_;
+    GBL_SETTINGS_CLASS(pClass)->pFnLoad        = GblSettings_load_;
 
     GBL_CTX_END();
 }
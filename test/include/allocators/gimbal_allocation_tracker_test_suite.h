@@ -0,0 +1,21 @@
+#ifndef GIMBAL_ALLOCATION_TRACKER_TEST_SUITE_H
+#define GIMBAL_ALLOCATION_TRACKER_TEST_SUITE_H
+
+#include <gimbal/test/gimbal_test_suite.h>
+
+#define GBL_ALLOCATION_TRACKER_TEST_SUITE_TYPE             (GBL_TYPEID(GblAllocationTrackerTestSuite))
+
+#define GBL_ALLOCATION_TRACKER_TEST_SUITE(inst)            (GBL_CAST(inst, GblAllocationTrackerTestSuite))
+#define GBL_ALLOCATION_TRACKER_TEST_SUITE_CLASS(klass)     (GBL_CLASS_CAST(klass, GblAllocationTrackerTestSuite))
+#define GBL_ALLOCATION_TRACKER_TEST_SUITE_GET_CLASS(inst)  (GBL_CLASSOF(inst, GblAllocationTrackerTestSuite))
+
+GBL_DECLS_BEGIN
+
+GBL_CLASS_DERIVE_EMPTY   (GblAllocationTrackerTestSuite, GblTestSuite)
+GBL_INSTANCE_DERIVE_EMPTY(GblAllocationTrackerTestSuite, GblTestSuite)
+
+GBL_EXPORT GblType GblAllocationTrackerTestSuite_type(void) GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#endif // GIMBAL_ALLOCATION_TRACKER_TEST_SUITE_H
@@ -0,0 +1,21 @@
+#ifndef GIMBAL_SLAB_ALLOCATOR_TEST_SUITE_H
+#define GIMBAL_SLAB_ALLOCATOR_TEST_SUITE_H
+
+#include <gimbal/test/gimbal_test_suite.h>
+
+#define GBL_SLAB_ALLOCATOR_TEST_SUITE_TYPE             (GBL_TYPEID(GblSlabAllocatorTestSuite))
+
+#define GBL_SLAB_ALLOCATOR_TEST_SUITE(inst)            (GBL_CAST(inst, GblSlabAllocatorTestSuite))
+#define GBL_SLAB_ALLOCATOR_TEST_SUITE_CLASS(klass)     (GBL_CLASS_CAST(klass, GblSlabAllocatorTestSuite))
+#define GBL_SLAB_ALLOCATOR_TEST_SUITE_GET_CLASS(inst)  (GBL_CLASSOF(inst, GblSlabAllocatorTestSuite))
+
+GBL_DECLS_BEGIN
+
+GBL_CLASS_DERIVE_EMPTY   (GblSlabAllocatorTestSuite, GblTestSuite)
+GBL_INSTANCE_DERIVE_EMPTY(GblSlabAllocatorTestSuite, GblTestSuite)
+
+GBL_EXPORT GblType GblSlabAllocatorTestSuite_type(void) GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#endif // GIMBAL_SLAB_ALLOCATOR_TEST_SUITE_H
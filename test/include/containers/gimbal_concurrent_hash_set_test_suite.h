@@ -0,0 +1,22 @@
+#ifndef GIMBAL_CONCURRENT_HASH_SET_TEST_SUITE_H
+#define GIMBAL_CONCURRENT_HASH_SET_TEST_SUITE_H
+
+#include <gimbal/test/gimbal_test_suite.h>
+
+#define GBL_CONCURRENT_HASH_SET_TEST_SUITE_TYPE             (GBL_TYPEID(GblConcurrentHashSetTestSuite))
+
+#define GBL_CONCURRENT_HASH_SET_TEST_SUITE(inst)            (GBL_CAST(inst, GBL_CONCURRENT_HASH_SET_TEST_SUITE_TYPE, GblConcurrentHashSetTestSuite))
+#define GBL_CONCURRENT_HASH_SET_TEST_SUITE_CLASS(klass)     (GBL_CLASS_CAST(klass, GBL_CONCURRENT_HASH_SET_TEST_SUITE_TYPE, GblConcurrentHashSetTestSuiteClass))
+#define GBL_CONCURRENT_HASH_SET_TEST_SUITE_GET_CLASS(inst)  (GBL_INSTANCE_GET_CLASS_CAST(inst, GBL_CONCURRENT_HASH_SET_TEST_SUITE_TYPE, GblConcurrentHashSetTestSuiteClass))
+
+GBL_DECLS_BEGIN
+
+GBL_CLASS_DERIVE_EMPTY(GblConcurrentHashSetTestSuite, GblTestSuite)
+
+GBL_INSTANCE_DERIVE_EMPTY(GblConcurrentHashSetTestSuite, GblTestSuite)
+
+GBL_EXPORT GblType GblConcurrentHashSetTestSuite_type(void) GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#endif // GIMBAL_CONCURRENT_HASH_SET_TEST_SUITE_H
@@ -0,0 +1,22 @@
+#ifndef GIMBAL_LOGGER_TEST_SUITE_H
+#define GIMBAL_LOGGER_TEST_SUITE_H
+
+#include <gimbal/test/gimbal_test_suite.h>
+
+#define GBL_LOGGER_TEST_SUITE_TYPE             (GBL_TYPEID(GblLoggerTestSuite))
+
+#define GBL_LOGGER_TEST_SUITE(inst)            (GBL_CAST(inst, GBL_LOGGER_TEST_SUITE_TYPE, GblLoggerTestSuite))
+#define GBL_LOGGER_TEST_SUITE_CLASS(klass)     (GBL_CLASS_CAST(klass, GBL_LOGGER_TEST_SUITE_TYPE, GblLoggerTestSuiteClass))
+#define GBL_LOGGER_TEST_SUITE_GET_CLASS(inst)  (GBL_INSTANCE_GET_CLASS_CAST(inst, GBL_LOGGER_TEST_SUITE_TYPE, GblLoggerTestSuiteClass))
+
+GBL_DECLS_BEGIN
+
+GBL_CLASS_DERIVE_EMPTY(GblLoggerTestSuite, GblTestSuite)
+
+GBL_INSTANCE_DERIVE_EMPTY(GblLoggerTestSuite, GblTestSuite)
+
+GBL_EXPORT GblType GblLoggerTestSuite_type(void) GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#endif // GIMBAL_LOGGER_TEST_SUITE_H
@@ -0,0 +1,21 @@
+#ifndef GIMBAL_BYTE_CHAIN_TEST_SUITE_H
+#define GIMBAL_BYTE_CHAIN_TEST_SUITE_H
+
+#include <gimbal/test/gimbal_test_suite.h>
+
+#define GBL_BYTE_CHAIN_TEST_SUITE_TYPE             (GBL_TYPEID(GblByteChainTestSuite))
+
+#define GBL_BYTE_CHAIN_TEST_SUITE(inst)            (GBL_CAST(inst, GblByteChainTestSuite))
+#define GBL_BYTE_CHAIN_TEST_SUITE_CLASS(klass)     (GBL_CLASS_CAST(klass, GblByteChainTestSuite))
+#define GBL_BYTE_CHAIN_TEST_SUITE_GET_CLASS(inst)  (GBL_CLASSOF(inst, GblByteChainTestSuite))
+
+GBL_DECLS_BEGIN
+
+GBL_CLASS_DERIVE_EMPTY   (GblByteChainTestSuite, GblTestSuite)
+GBL_INSTANCE_DERIVE_EMPTY(GblByteChainTestSuite, GblTestSuite)
+
+GBL_EXPORT GblType GblByteChainTestSuite_type(void) GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#endif // GIMBAL_BYTE_CHAIN_TEST_SUITE_H
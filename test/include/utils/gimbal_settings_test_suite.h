@@ -0,0 +1,21 @@
+#ifndef GIMBAL_SETTINGS_TEST_SUITE_H
+#define GIMBAL_SETTINGS_TEST_SUITE_H
+
+#include <gimbal/test/gimbal_test_suite.h>
+
+#define GBL_SETTINGS_TEST_SUITE_TYPE             (GBL_TYPEID(GblSettingsTestSuite))
+
+#define GBL_SETTINGS_TEST_SUITE(inst)            (GBL_CAST(inst, GblSettingsTestSuite))
+#define GBL_SETTINGS_TEST_SUITE_CLASS(klass)     (GBL_CLASS_CAST(klass, GblSettingsTestSuite))
+#define GBL_SETTINGS_TEST_SUITE_GET_CLASS(inst)  (GBL_CLASSOF(inst, GblSettingsTestSuite))
+
+GBL_DECLS_BEGIN
+
+GBL_CLASS_DERIVE_EMPTY   (GblSettingsTestSuite, GblTestSuite)
+GBL_INSTANCE_DERIVE_EMPTY(GblSettingsTestSuite, GblTestSuite)
+
+GBL_EXPORT GblType GblSettingsTestSuite_type(void) GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#endif // GIMBAL_SETTINGS_TEST_SUITE_H
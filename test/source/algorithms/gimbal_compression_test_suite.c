@@ -2,8 +2,12 @@
 #include <gimbal/test/gimbal_test_macros.h>
 #include <gimbal/algorithms/gimbal_compression.h>
 #include <gimbal/algorithms/gimbal_random.h>
+#include <gimbal/utils/gimbal_byte_array.h>
+#include <gimbal/strings/gimbal_string_buffer.h>
 
 #define RANDOM_BUFFER_SIZE_     (1024 * 4)
+#define STREAM_BUFFER_SIZE_     (1024 * 300)
+#define MESSAGE_COUNT_          64
 
 #define GBL_SELF_TYPE GblCompressionTestSuite
 
@@ -12,8 +16,81 @@ GBL_TEST_FIXTURE {
     uint8_t* pCompBuffer;
     uint8_t* pDstBuffer;
     int      compressedSize;
+    char*    pStream;
 };
 
+// Fills the buffer with log-like lines, which compress reasonably well
+static void GblCompressionTestSuite_fillLog_(char* pBuffer, size_t size) {
+    size_t offset = 0;
+
+    for(size_t line = 0; offset < size; ++line) {
+        char text[128];
+        const int length = snprintf(text, sizeof(text),
+                                    "[%08zu] GblObject[%p] property \"value\" changed to %d\n",
+                                    line, (void*)(uintptr_t)(line * 48), gblRandEquilikely(-1000, 1000));
+
+        const size_t copy = GBL_MIN((size_t)length, size - offset);
+        memcpy(pBuffer + offset, text, copy);
+        offset += copy;
+    }
+}
+
+static GBL_RESULT GblCompressionTestSuite_roundTrip_(GblContext*   pCtx,
+                                                     int           level,
+                                                     size_t        windowSize,
+                                                     const char*   pData,
+                                                     size_t        size,
+                                                     size_t*       pCompressedSize)
+{
+    GBL_CTX_BEGIN(pCtx);
+
+    GblCompressor   compressor;
+    GblDecompressor decompressor;
+    GblByteArray*   pCompressed   = GblByteArray_create(0);
+    GblByteArray*   pDecompressed = GblByteArray_create(0);
+
+    GBL_TEST_CALL(GblCompressor_construct(&compressor, level, windowSize, pCtx));
+    GBL_TEST_CALL(GblCompressor_setByteArraySink(&compressor, pCompressed));
+
+    // feed the data in irregularly-sized pieces
+    for(size_t offset = 0, piece = 1; offset < size; offset += piece, piece = piece * 3 + 7) {
+        piece = GBL_MIN(piece, size - offset);
+        GBL_TEST_CALL(GblCompressor_update(&compressor, pData + offset, piece));
+    }
+
+    GBL_TEST_COMPARE(GblCompressor_inFrame(&compressor), size != 0);
+    GBL_TEST_CALL(GblCompressor_finish(&compressor));
+    GBL_TEST_VERIFY(!GblCompressor_inFrame(&compressor));
+    GBL_TEST_COMPARE(GblCompressor_bytesIn(&compressor), size);
+    GBL_TEST_COMPARE(GblCompressor_bytesOut(&compressor), GblByteArray_size(pCompressed));
+    GBL_TEST_CALL(GblCompressor_destruct(&compressor));
+
+    GBL_TEST_CALL(GblDecompressor_construct(&decompressor, pCtx));
+    GBL_TEST_CALL(GblDecompressor_setByteArraySink(&decompressor, pDecompressed));
+
+    const uint8_t* pBytes = GblByteArray_data(pCompressed);
+    for(size_t offset = 0; offset < GblByteArray_size(pCompressed); offset += 1000) {
+        const size_t piece = GBL_MIN(1000, GblByteArray_size(pCompressed) - offset);
+        GBL_TEST_CALL(GblDecompressor_update(&decompressor, pBytes + offset, piece));
+    }
+
+    GBL_TEST_VERIFY(!GblDecompressor_inFrame(&decompressor));
+    GBL_TEST_CALL(GblDecompressor_finish(&decompressor));
+    GBL_TEST_COMPARE(GblDecompressor_bytesIn(&decompressor), GblByteArray_size(pCompressed));
+    GBL_TEST_COMPARE(GblDecompressor_bytesOut(&decompressor), size);
+    GBL_TEST_COMPARE(GblByteArray_size(pDecompressed), size);
+    GBL_TEST_VERIFY(memcmp(GblByteArray_data(pDecompressed), pData, size) == 0);
+    GBL_TEST_CALL(GblDecompressor_destruct(&decompressor));
+
+    if(pCompressedSize)
+        *pCompressedSize = GblByteArray_size(pCompressed);
+
+    GBL_CTX_END_BLOCK();
+    GblByteArray_unref(pCompressed);
+    GblByteArray_unref(pDecompressed);
+    return GBL_CTX_RESULT();
+}
+
 GBL_TEST_INIT()
     pFixture->pSrcBuffer  = GBL_CTX_MALLOC(RANDOM_BUFFER_SIZE_);
     pFixture->pDstBuffer  = GBL_CTX_MALLOC(RANDOM_BUFFER_SIZE_);
@@ -21,12 +98,15 @@ GBL_TEST_INIT()
     memset(pFixture->pSrcBuffer, 0, RANDOM_BUFFER_SIZE_);
     // Leave some nonrandom space so it has something to compress
     gblRandBuffer(pFixture->pSrcBuffer, RANDOM_BUFFER_SIZE_ - 512);
+    pFixture->pStream = GBL_CTX_MALLOC(STREAM_BUFFER_SIZE_);
+    GblCompressionTestSuite_fillLog_(pFixture->pStream, STREAM_BUFFER_SIZE_);
 GBL_TEST_CASE_END
 
 GBL_TEST_FINAL()
     GBL_CTX_FREE(pFixture->pSrcBuffer);
     GBL_CTX_FREE(pFixture->pDstBuffer);
     GBL_CTX_FREE(pFixture->pCompBuffer);
+    GBL_CTX_FREE(pFixture->pStream);
 GBL_TEST_CASE_END
 
 GBL_TEST_CASE(compress)
@@ -52,6 +132,222 @@ GBL_TEST_CASE(verify)
                          pFixture->pSrcBuffer[b]);
 GBL_TEST_CASE_END
 
+GBL_TEST_CASE(streamConstructInvalid)
+    GblCompressor compressor;
+
+    GBL_TEST_EXPECT_ERROR();
+    GBL_TEST_COMPARE(GblCompressor_construct(&compressor, GBL_COMPRESSOR_LEVEL_MAX + 1),
+                     GBL_RESULT_ERROR_INVALID_ARG);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_TEST_CALL(GblCompressor_construct(&compressor));
+    GBL_TEST_EXPECT_ERROR();
+    GBL_TEST_COMPARE(GblCompressor_update(&compressor, "data", 4),
+                     GBL_RESULT_ERROR_INVALID_OPERATION);
+    GBL_CTX_CLEAR_LAST_RECORD();
+    GBL_TEST_CALL(GblCompressor_destruct(&compressor));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(streamWindow)
+    GblCompressor compressor;
+
+    GBL_TEST_CALL(GblCompressor_construct(&compressor));
+    GBL_TEST_COMPARE(GblCompressor_level(&compressor), GBL_COMPRESSOR_LEVEL_DEFAULT);
+    GBL_TEST_COMPARE(GblCompressor_windowSize(&compressor), GBL_COMPRESSOR_WINDOW_DEFAULT);
+    GBL_TEST_CALL(GblCompressor_destruct(&compressor));
+
+    GBL_TEST_CALL(GblCompressor_construct(&compressor, 5, 100 * 1024));
+    GBL_TEST_COMPARE(GblCompressor_level(&compressor), 5);
+    GBL_TEST_COMPARE(GblCompressor_windowSize(&compressor), 256 * 1024);
+    GBL_TEST_CALL(GblCompressor_destruct(&compressor));
+
+    GBL_TEST_CALL(GblCompressor_construct(&compressor, 0, 64 * 1024 * 1024));
+    GBL_TEST_COMPARE(GblCompressor_windowSize(&compressor), 4 * 1024 * 1024);
+    GBL_TEST_CALL(GblCompressor_destruct(&compressor));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(streamFast)
+    size_t compressed = 0;
+    GBL_TEST_CALL(GblCompressionTestSuite_roundTrip_(pCtx, -4, 0,
+                                                     pFixture->pStream, STREAM_BUFFER_SIZE_,
+                                                     &compressed));
+    GBL_TEST_VERIFY(compressed < STREAM_BUFFER_SIZE_);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(streamDefault)
+    GBL_TEST_CALL(GblCompressionTestSuite_roundTrip_(pCtx, GBL_COMPRESSOR_LEVEL_DEFAULT, 1024 * 1024,
+                                                     pFixture->pStream, STREAM_BUFFER_SIZE_,
+                                                     NULL));
+    // incompressible data and an empty frame
+    GBL_TEST_CALL(GblCompressionTestSuite_roundTrip_(pCtx, GBL_COMPRESSOR_LEVEL_DEFAULT, 0,
+                                                     (const char*)pFixture->pSrcBuffer, RANDOM_BUFFER_SIZE_,
+                                                     NULL));
+    GBL_TEST_CALL(GblCompressionTestSuite_roundTrip_(pCtx, GBL_COMPRESSOR_LEVEL_DEFAULT, 0,
+                                                     pFixture->pStream, 0,
+                                                     NULL));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(streamHc)
+    size_t fast = 0, hc = 0;
+    GBL_TEST_CALL(GblCompressionTestSuite_roundTrip_(pCtx, GBL_COMPRESSOR_LEVEL_DEFAULT, 0,
+                                                     pFixture->pStream, STREAM_BUFFER_SIZE_,
+                                                     &fast));
+    GBL_TEST_CALL(GblCompressionTestSuite_roundTrip_(pCtx, GBL_COMPRESSOR_LEVEL_HC + 6, 0,
+                                                     pFixture->pStream, STREAM_BUFFER_SIZE_,
+                                                     &hc));
+    GBL_TEST_VERIFY(hc < fast);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(streamFlush)
+    GblCompressor   compressor;
+    GblDecompressor decompressor;
+    GblByteArray*   pCompressed   = GblByteArray_create(0);
+    GblByteArray*   pDecompressed = GblByteArray_create(0);
+
+    GBL_TEST_CALL(GblCompressor_construct(&compressor));
+    GBL_TEST_CALL(GblCompressor_setByteArraySink(&compressor, pCompressed));
+    GBL_TEST_CALL(GblDecompressor_construct(&decompressor));
+    GBL_TEST_CALL(GblDecompressor_setByteArraySink(&decompressor, pDecompressed));
+
+    // each flushed message must be fully decompressible before the frame ends
+    for(size_t m = 0; m < MESSAGE_COUNT_; ++m) {
+        const size_t consumed = GblByteArray_size(pCompressed);
+
+        GBL_TEST_CALL(GblCompressor_update(&compressor, pFixture->pStream + m * 100, 100));
+        GBL_TEST_CALL(GblCompressor_flush(&compressor));
+        GBL_TEST_CALL(GblDecompressor_update(&decompressor,
+                                             (const uint8_t*)GblByteArray_data(pCompressed) + consumed,
+                                             GblByteArray_size(pCompressed) - consumed));
+
+        GBL_TEST_COMPARE(GblByteArray_size(pDecompressed), (m + 1) * 100);
+        GBL_TEST_VERIFY(GblDecompressor_inFrame(&decompressor));
+    }
+
+    GBL_TEST_VERIFY(memcmp(GblByteArray_data(pDecompressed), pFixture->pStream, MESSAGE_COUNT_ * 100) == 0);
+
+    // a stream which ends in the middle of a frame is an error
+    GBL_TEST_EXPECT_ERROR();
+    GBL_TEST_COMPARE(GblDecompressor_finish(&decompressor), GBL_RESULT_ERROR_UNDERFLOW);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_TEST_CALL(GblCompressor_destruct(&compressor));
+    GBL_TEST_CALL(GblDecompressor_destruct(&decompressor));
+    GblByteArray_unref(pCompressed);
+    GblByteArray_unref(pDecompressed);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(streamDictionary)
+    GblCompressor   compressor;
+    GblDecompressor decompressor;
+    GblByteArray*   pPlain        = GblByteArray_create(0);
+    GblByteArray*   pCompressed   = GblByteArray_create(0);
+    GblByteArray*   pDecompressed = GblByteArray_create(0);
+    size_t          plainTotal    = 0;
+    size_t          dictTotal     = 0;
+
+    // use the first part of the log as the dictionary and compress later lines as small messages
+    const char*  pDict    = pFixture->pStream;
+    const size_t dictSize = 16 * 1024;
+
+    GBL_TEST_CALL(GblCompressor_construct(&compressor));
+    GBL_TEST_CALL(GblCompressor_setByteArraySink(&compressor, pPlain));
+
+    for(size_t m = 0; m < MESSAGE_COUNT_; ++m) {
+        GBL_TEST_CALL(GblCompressor_update(&compressor, pFixture->pStream + dictSize + m * 200, 200));
+        GBL_TEST_CALL(GblCompressor_finish(&compressor));
+    }
+
+    plainTotal = GblByteArray_size(pPlain);
+
+    GBL_TEST_CALL(GblCompressor_setByteArraySink(&compressor, pCompressed));
+    GBL_TEST_CALL(GblCompressor_loadDictionary(&compressor, pDict, dictSize));
+    GBL_TEST_CALL(GblDecompressor_construct(&decompressor));
+    GBL_TEST_CALL(GblDecompressor_setByteArraySink(&decompressor, pDecompressed));
+    GBL_TEST_CALL(GblDecompressor_loadDictionary(&decompressor, pDict, dictSize));
+
+    for(size_t m = 0; m < MESSAGE_COUNT_; ++m) {
+        const size_t consumed = GblByteArray_size(pCompressed);
+
+        GBL_TEST_CALL(GblCompressor_update(&compressor, pFixture->pStream + dictSize + m * 200, 200));
+        GBL_TEST_CALL(GblCompressor_finish(&compressor));
+
+        // every message is its own frame, decompressed independently
+        GBL_TEST_CALL(GblDecompressor_update(&decompressor,
+                                             (const uint8_t*)GblByteArray_data(pCompressed) + consumed,
+                                             GblByteArray_size(pCompressed) - consumed));
+        GBL_TEST_CALL(GblDecompressor_finish(&decompressor));
+    }
+
+    dictTotal = GblByteArray_size(pCompressed);
+
+    GBL_TEST_VERIFY(dictTotal < plainTotal);
+    GBL_TEST_COMPARE(GblByteArray_size(pDecompressed), MESSAGE_COUNT_ * 200);
+    GBL_TEST_VERIFY(memcmp(GblByteArray_data(pDecompressed),
+                           pFixture->pStream + dictSize,
+                           MESSAGE_COUNT_ * 200) == 0);
+
+    // without the dictionary, the frames cannot be recovered
+    GBL_TEST_CALL(GblDecompressor_loadDictionary(&decompressor, NULL, 0));
+    GBL_TEST_CALL(GblByteArray_clear(pDecompressed));
+    GBL_TEST_EXPECT_ERROR();
+    GBL_TEST_VERIFY(GBL_RESULT_ERROR(GblDecompressor_update(&decompressor,
+                                                            GblByteArray_data(pCompressed),
+                                                            GblByteArray_size(pCompressed))));
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_CTX_INFO("%u messages: %zu bytes plain, %zu bytes with dictionary",
+                 MESSAGE_COUNT_, plainTotal, dictTotal);
+
+    GBL_TEST_CALL(GblCompressor_destruct(&compressor));
+    GBL_TEST_CALL(GblDecompressor_destruct(&decompressor));
+    GblByteArray_unref(pPlain);
+    GblByteArray_unref(pCompressed);
+    GblByteArray_unref(pDecompressed);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(streamStringBuffer)
+    GblCompressor   compressor;
+    GblDecompressor decompressor;
+    GblStringBuffer compressed, decompressed;
+    const char*     pText = "GblCompressor streams straight into a GblStringBuffer. "
+                            "GblCompressor streams straight into a GblStringBuffer.";
+
+    GBL_TEST_CALL(GblStringBuffer_construct(&compressed));
+    GBL_TEST_CALL(GblStringBuffer_construct(&decompressed));
+
+    GBL_TEST_CALL(GblCompressor_construct(&compressor, GBL_COMPRESSOR_LEVEL_HC));
+    GBL_TEST_CALL(GblCompressor_setStringBufferSink(&compressor, &compressed));
+    GBL_TEST_CALL(GblCompressor_update(&compressor, pText, strlen(pText)));
+    GBL_TEST_CALL(GblCompressor_finish(&compressor));
+    // two frames in a row
+    GBL_TEST_CALL(GblCompressor_update(&compressor, pText, strlen(pText)));
+    GBL_TEST_CALL(GblCompressor_finish(&compressor));
+
+    GBL_TEST_CALL(GblDecompressor_construct(&decompressor));
+    GBL_TEST_CALL(GblDecompressor_setStringBufferSink(&decompressor, &decompressed));
+    GBL_TEST_CALL(GblDecompressor_update(&decompressor,
+                                         GblStringBuffer_data(&compressed),
+                                         GblStringBuffer_length(&compressed)));
+    GBL_TEST_CALL(GblDecompressor_finish(&decompressor));
+
+    GBL_TEST_COMPARE(GblStringBuffer_length(&decompressed), 2 * strlen(pText));
+    GBL_TEST_VERIFY(strncmp(GblStringBuffer_cString(&decompressed), pText, strlen(pText)) == 0);
+    GBL_TEST_VERIFY(strcmp(GblStringBuffer_cString(&decompressed) + strlen(pText), pText) == 0);
+
+    GBL_TEST_CALL(GblCompressor_destruct(&compressor));
+    GBL_TEST_CALL(GblDecompressor_destruct(&decompressor));
+    GBL_TEST_CALL(GblStringBuffer_destruct(&compressed));
+    GBL_TEST_CALL(GblStringBuffer_destruct(&decompressed));
+GBL_TEST_CASE_END
+
 GBL_TEST_REGISTER(compress,
                   decompress,
-                  verify)
+                  verify,
+                  streamConstructInvalid,
+                  streamWindow,
+                  streamFast,
+                  streamDefault,
+                  streamHc,
+                  streamFlush,
+                  streamDictionary,
+                  streamStringBuffer)
@@ -2,6 +2,7 @@
 #include <gimbal/algorithms/gimbal_hash.h>
 #include <gimbal/test/gimbal_test_macros.h>
 #include <gimbal/algorithms/gimbal_random.h>
+#include <gimbal/utils/gimbal_timer.h>
 
 #define GBL_HASH_TEST_SUITE_(inst)   (GBL_PRIVATE(GblHashTestSuite, inst))
 
@@ -9,6 +10,8 @@
 #define GBL_HASH_TEST_SUITE_WORD_SIZE_MAX_  50
 #define GBL_HASH_TEST_SUITE_WORD_SIZE_MIN_  20
 #define GBL_HASH_TEST_SUITE_WORD_CHARS_     NULL
+#define GBL_HASH_TEST_SUITE_BUFFER_SIZE_    4099
+#define GBL_HASH_TEST_SUITE_PROFILE_SIZE_   (64 * 1024 * 1024)
 
 typedef struct GblHashTestSuite_ {
     char   words[GBL_HASH_TEST_SUITE_WORD_COUNT_][GBL_HASH_TEST_SUITE_WORD_SIZE_MAX_+1];
@@ -197,6 +200,166 @@ static GBL_RESULT GblHashTestSuite_xx_(GblTestSuite* pSelf, GblContext* pCtx) {
     GBL_CTX_END();
 }
 
+// Bit-at-a-time reference implementation of a reflected CRC-32
+static uint32_t GblHashTestSuite_crcReference_(const uint8_t* pBytes, size_t size, uint32_t poly) {
+    uint32_t crc = 0xffffffff;
+
+    for(size_t b = 0; b < size; ++b) {
+        crc ^= pBytes[b];
+        for(size_t i = 0; i < 8; ++i)
+            crc = (crc >> 1) ^ (poly & (-(crc & 1)));
+    }
+
+    return ~crc;
+}
+
+static GBL_RESULT GblHashTestSuite_crcVectors_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    GBL_TEST_COMPARE(gblHashCrc("123456789", 9), 0xcbf43926);
+    GBL_TEST_COMPARE(gblHashCrc32c("123456789", 9), 0xe3069283);
+    GBL_TEST_COMPARE(gblHashCrc("", 0), 0);
+    GBL_TEST_COMPARE(gblHashCrc32c("", 0), 0);
+
+    uint8_t buffer[GBL_HASH_TEST_SUITE_BUFFER_SIZE_];
+    gblRandBuffer(buffer, sizeof(buffer));
+
+    // cover every tail length around the vectorized block sizes
+    for(size_t size = 0; size <= sizeof(buffer); size += (size < 200)? 1 : 97) {
+        GBL_TEST_COMPARE(gblHashCrc(buffer, size),
+                         GblHashTestSuite_crcReference_(buffer, size, 0xedb88320));
+        GBL_TEST_COMPARE(gblHashCrc32c(buffer, size),
+                         GblHashTestSuite_crcReference_(buffer, size, 0x82f63b78));
+    }
+
+    // unaligned starting addresses
+    for(size_t offset = 1; offset < 16; ++offset)
+        GBL_TEST_COMPARE(gblHashCrc(buffer + offset, sizeof(buffer) - offset),
+                         GblHashTestSuite_crcReference_(buffer + offset, sizeof(buffer) - offset, 0xedb88320));
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblHashTestSuite_crcPartial_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    static const size_t chunkSizes[] = { 1, 7, 16, 63, 64, 65, 1000, GBL_HASH_TEST_SUITE_BUFFER_SIZE_ };
+
+    uint8_t buffer[GBL_HASH_TEST_SUITE_BUFFER_SIZE_];
+    gblRandBuffer(buffer, sizeof(buffer));
+
+    const uint32_t expected = gblHashCrc(buffer, sizeof(buffer));
+    GBL_TEST_COMPARE(gblHashCrcPartial(buffer, sizeof(buffer), NULL), expected);
+
+    for(size_t c = 0; c < GBL_COUNT_OF(chunkSizes); ++c) {
+        uint32_t crc = 0;
+
+        for(size_t offset = 0; offset < sizeof(buffer); offset += chunkSizes[c]) {
+            const size_t size = GBL_MIN(chunkSizes[c], sizeof(buffer) - offset);
+            crc = gblHashCrcPartial(buffer + offset, size, &crc);
+        }
+
+        GBL_TEST_COMPARE(crc, expected);
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblHashTestSuite_xx3_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+
+    GblHashTestSuite_* pSelf_ = GBL_HASH_TEST_SUITE_(pSelf);
+
+    const uint64_t first = gblHashXx3_64(pSelf_->words[0], strlen(pSelf_->words[0]));
+    GBL_TEST_COMPARE(gblHashXx3_64(pSelf_->words[0], strlen(pSelf_->words[0])), first);
+    GBL_TEST_VERIFY(gblHashXx3_64("a", 1) != gblHashXx3_64("b", 1));
+
+    volatile uint64_t total = gblHashXx3_64(NULL, 0);
+    for(size_t  w = 0; w < GBL_HASH_TEST_SUITE_WORD_COUNT_; ++w) {
+        total += gblHashXx3_64(pSelf_->words[w],
+                               strlen(pSelf_->words[w]));
+    }
+
+    pSelf_->total = total;
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblHashTestSuite_many_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    static const GblHashFn hashers[] = { NULL, gblHashFnv1, gblHashCrc32c, gblHashMurmur, gblHashCrc };
+    static const size_t    keySizes[] = { 1, 4, 7, 8, 16, 33 };
+
+    uint8_t keys[GBL_HASH_TEST_SUITE_BUFFER_SIZE_];
+    GblHash hashes[GBL_HASH_TEST_SUITE_BUFFER_SIZE_];
+
+    gblRandBuffer(keys, sizeof(keys));
+
+    for(size_t h = 0; h < GBL_COUNT_OF(hashers); ++h) {
+        for(size_t k = 0; k < GBL_COUNT_OF(keySizes); ++k) {
+            // packed keys and keys embedded within larger entries
+            for(size_t stride = 0; stride <= keySizes[k] + 5; stride += keySizes[k] + 5) {
+                const size_t    step  = stride? stride : keySizes[k];
+                const size_t    count = sizeof(keys) / step - 3;
+                const GblHashFn pFn   = hashers[h]? hashers[h] : gblHash;
+
+                gblHashMany(hashers[h], keys, keySizes[k], stride, count, hashes);
+
+                for(size_t i = 0; i < count; ++i)
+                    GBL_TEST_COMPARE(hashes[i], pFn(keys + i * step, keySizes[k]));
+            }
+        }
+    }
+
+    gblHashMany(gblHashFnv1, keys, 8, 0, 0, hashes);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblHashTestSuite_profile_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    static const GblHashFn hashers[] = { gblHashCrc, gblHashCrc32c, gblHashFnv1, gblHashXx };
+    static const char*     names[]   = { "gblHashCrc", "gblHashCrc32c", "gblHashFnv1", "gblHashXx" };
+
+    uint8_t* pBuffer = GBL_CTX_MALLOC(GBL_HASH_TEST_SUITE_PROFILE_SIZE_);
+    GblHash* pHashes = GBL_CTX_MALLOC(sizeof(GblHash) * GBL_HASH_TEST_SUITE_PROFILE_SIZE_ / 8);
+    GblTimer timer;
+
+    gblRandBuffer(pBuffer, GBL_HASH_TEST_SUITE_PROFILE_SIZE_);
+
+    for(size_t h = 0; h < GBL_COUNT_OF(hashers); ++h) {
+        GblTimer_start(&timer);
+        volatile GblHash hash = hashers[h](pBuffer, GBL_HASH_TEST_SUITE_PROFILE_SIZE_);
+        GblTimer_stop(&timer);
+        GBL_UNUSED(hash);
+
+        GBL_CTX_INFO("%-26s: %10.3lf MB/s", names[h],
+                     (GBL_HASH_TEST_SUITE_PROFILE_SIZE_ / (1024.0 * 1024.0)) / (GblTimer_elapsedMs(&timer) / 1000.0));
+    }
+
+    GblTimer_start(&timer);
+    for(size_t k = 0; k < GBL_HASH_TEST_SUITE_PROFILE_SIZE_ / 8; ++k)
+        pHashes[k] = gblHashFnv1(pBuffer + k * 8, 8);
+    GblTimer_stop(&timer);
+    GBL_CTX_INFO("%-26s: %10.3lf ms", "gblHashFnv1 (8-byte keys)", GblTimer_elapsedMs(&timer));
+
+    GblTimer_start(&timer);
+    gblHashMany(gblHashFnv1, pBuffer, 8, 0, GBL_HASH_TEST_SUITE_PROFILE_SIZE_ / 8, pHashes);
+    GblTimer_stop(&timer);
+    GBL_CTX_INFO("%-26s: %10.3lf ms", "gblHashMany (8-byte keys)", GblTimer_elapsedMs(&timer));
+
+    GBL_CTX_FREE(pHashes);
+    GBL_CTX_FREE(pBuffer);
+
+    GBL_CTX_END();
+}
+
 
 GBL_EXPORT GblType GblHashTestSuite_type(void) {
     static GblType type = GBL_INVALID_TYPE;
@@ -212,6 +375,11 @@ GBL_EXPORT GblType GblHashTestSuite_type(void) {
         { "crc",        GblHashTestSuite_crc_          },
         { "md5",        GblHashTestSuite_md5_          },
         { "sha1",       GblHashTestSuite_sha1_         },
+        { "crcVectors", GblHashTestSuite_crcVectors_   },
+        { "crcPartial", GblHashTestSuite_crcPartial_   },
+        { "xx3",        GblHashTestSuite_xx3_          },
+        { "many",       GblHashTestSuite_many_         },
+        { "profile",    GblHashTestSuite_profile_      },
         { NULL,     NULL                               }
     };
 
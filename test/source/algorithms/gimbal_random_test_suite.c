@@ -1,14 +1,20 @@
 #include <gimbal/algorithms/gimbal_random.h>
 #include <gimbal/test/gimbal_test_macros.h>
+#include <gimbal/utils/gimbal_timer.h>
 #include "algorithms/gimbal_random_test_suite.h"
+#include <tinycthread.h>
 #include <time.h>
+#include <math.h>
 
 #define BENCHMARK_ITERATIONS_   9999
+#define BATCH_SIZE_             100003
+#define THREAD_COUNT_           4
 
 #define GBL_SELF_TYPE GblRandomTestSuite
 
 GBL_TEST_FIXTURE {
-    int randomNumbers[2][BENCHMARK_ITERATIONS_];
+    int   randomNumbers[3][BENCHMARK_ITERATIONS_];
+    float batch[BATCH_SIZE_];
 };
 
 GBL_TEST_INIT()
@@ -95,7 +101,255 @@ GBL_TEST_CASE(lehmerBenchmark)
     benchmark_(gblRandLehmer, pFixture, 1);
 GBL_TEST_CASE_END
 
+GBL_TEST_CASE(xoshiroDuplicate)
+    findDuplicates_(gblRandXoshiro);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(xoshiroBenchmark)
+    benchmark_(gblRandXoshiro, pFixture, 2);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(stateSeed)
+    GblRandState a, b, c;
+
+    GblRandState_seed(&a, 1234);
+    GblRandState_seed(&b, 1234);
+    GblRandState_seed(&c, 1235);
+
+    for(unsigned i = 0; i < 1000; ++i) {
+        const uint64_t value = GblRandState_next(&a);
+        GBL_TEST_COMPARE(value, GblRandState_next(&b));
+        GBL_TEST_VERIFY(value != GblRandState_next(&c));
+    }
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(stateReference)
+    // reference output of xoshiro256** from the state { 1, 2, 3, 4 }
+    GblRandState state = { { 1, 2, 3, 4 } };
+
+    GBL_TEST_COMPARE(GblRandState_next(&state), UINT64_C(11520));
+    GBL_TEST_COMPARE(GblRandState_next(&state), UINT64_C(0));
+    GBL_TEST_COMPARE(GblRandState_next(&state), UINT64_C(1509978240));
+    GBL_TEST_COMPARE(GblRandState_next(&state), UINT64_C(1215971899390074240));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(stateJump)
+    GblRandState base, jumped, longJumped;
+
+    GblRandState_seed(&base, 42);
+    jumped = longJumped = base;
+
+    GblRandState_jump(&jumped);
+    GblRandState_longJump(&longJumped);
+
+    GBL_TEST_VERIFY(memcmp(&base, &jumped, sizeof(GblRandState)));
+    GBL_TEST_VERIFY(memcmp(&base, &longJumped, sizeof(GblRandState)));
+    GBL_TEST_VERIFY(memcmp(&jumped, &longJumped, sizeof(GblRandState)));
+
+    // jumping is deterministic
+    GblRandState again = base;
+    GblRandState_jump(&again);
+    GBL_TEST_VERIFY(!memcmp(&again, &jumped, sizeof(GblRandState)));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(stateSplit)
+    GblRandState base, copy, streams[THREAD_COUNT_];
+
+    GblRandState_seed(&base, 7);
+    copy = base;
+
+    GblRandState_split(&base, THREAD_COUNT_, streams);
+
+    for(unsigned s = 0; s < THREAD_COUNT_; ++s) {
+        GBL_TEST_VERIFY(!memcmp(&streams[s], &copy, sizeof(GblRandState)));
+        GblRandState_jump(&copy);
+    }
+
+    GBL_TEST_VERIFY(!memcmp(&base, &copy, sizeof(GblRandState)));
+
+    uint64_t first[THREAD_COUNT_];
+    for(unsigned s = 0; s < THREAD_COUNT_; ++s) {
+        first[s] = GblRandState_next(&streams[s]);
+        for(unsigned p = 0; p < s; ++p)
+            GBL_TEST_VERIFY(first[s] != first[p]);
+    }
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(setState)
+    GblRandState state, saved = *gblRandState();
+    uint64_t     values[8];
+    uint8_t      bytes[2][77];
+
+    GblRandState_seed(&state, 99);
+
+    gblRandSetState(&state);
+    for(unsigned i = 0; i < GBL_COUNT_OF(values); ++i)
+        values[i] = gblRand64();
+    gblRandBuffer(bytes[0], sizeof(bytes[0]));
+
+    gblRandSetState(&state);
+    for(unsigned i = 0; i < GBL_COUNT_OF(values); ++i)
+        GBL_TEST_COMPARE(gblRand64(), values[i]);
+    gblRandBuffer(bytes[1], sizeof(bytes[1]));
+
+    GBL_TEST_VERIFY(!memcmp(bytes[0], bytes[1], sizeof(bytes[0])));
+    GBL_TEST_COMPARE(GblRandState_next(&state), values[0]);
+
+    gblRandSetState(&saved);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(lanesSplit)
+    enum { streamCount = 8, outputs = 64 };
+
+    GblRandState state, saved = *gblRandState();
+    GblRandState streams[streamCount];
+    uint64_t     split[streamCount][outputs];
+    uint64_t     lanes[streamCount * outputs];
+
+    GblRandState_seed(&state, 1234);
+    gblRandSetState(&state);
+    gblRandBuffer(lanes, sizeof(lanes));
+
+    // The batch lanes mustn't replay the streams split off of the same state
+    GblRandState_split(&state, streamCount, streams);
+
+    for(unsigned s = 0; s < streamCount; ++s)
+        for(unsigned o = 0; o < outputs; ++o)
+            split[s][o] = GblRandState_next(&streams[s]);
+
+    for(unsigned l = 0; l < GBL_COUNT_OF(lanes); ++l)
+        for(unsigned s = 0; s < streamCount; ++s)
+            for(unsigned o = 0; o < outputs; ++o)
+                GBL_TEST_VERIFY(lanes[l] != split[s][o]);
+
+    gblRandSetState(&saved);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(buffer)
+    uint8_t  bytes[4096 + 37];
+    unsigned histogram[256] = { 0 };
+
+    memset(bytes, 0, sizeof(bytes));
+
+    // unaligned start and a tail shorter than a block
+    gblRandBuffer(bytes + 3, sizeof(bytes) - 8);
+    GBL_TEST_COMPARE(bytes[0] | bytes[1] | bytes[2], 0);
+    GBL_TEST_COMPARE(bytes[sizeof(bytes) - 5] | bytes[sizeof(bytes) - 1], 0);
+
+    for(size_t i = 3; i < sizeof(bytes) - 5; ++i)
+        ++histogram[bytes[i]];
+
+    // each byte value should come up about 16 times
+    for(unsigned b = 0; b < 256; ++b)
+        GBL_TEST_VERIFY(histogram[b] > 0 && histogram[b] < 64);
+
+    gblRandBuffer(NULL, 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(uniformN)
+    double mean = 0.0;
+
+    gblRandUniformN(pFixture->batch, BATCH_SIZE_, -2.0f, 6.0f);
+
+    for(size_t i = 0; i < BATCH_SIZE_; ++i) {
+        GBL_TEST_VERIFY(pFixture->batch[i] >= -2.0f && pFixture->batch[i] < 6.0f);
+        mean += pFixture->batch[i];
+    }
+
+    mean /= BATCH_SIZE_;
+    GBL_TEST_VERIFY(fabs(mean - 2.0) < 0.05);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(normalN)
+    double mean = 0.0, variance = 0.0;
+
+    gblRandNormalN(pFixture->batch, BATCH_SIZE_, 10.0f, 3.0f);
+
+    for(size_t i = 0; i < BATCH_SIZE_; ++i) {
+        GBL_TEST_VERIFY(isfinite(pFixture->batch[i]));
+        mean += pFixture->batch[i];
+    }
+
+    mean /= BATCH_SIZE_;
+
+    for(size_t i = 0; i < BATCH_SIZE_; ++i)
+        variance += (pFixture->batch[i] - mean) * (pFixture->batch[i] - mean);
+
+    variance /= BATCH_SIZE_ - 1;
+
+    GBL_TEST_VERIFY(fabs(mean - 10.0) < 0.05);
+    GBL_TEST_VERIFY(fabs(sqrt(variance) - 3.0) < 0.05);
+GBL_TEST_CASE_END
+
+static int threadStream_(void* pArg) {
+    *(GblRandState*)pArg = *gblRandState();
+    return 0;
+}
+
+GBL_TEST_CASE(threadStreams)
+    thrd_t       threads[THREAD_COUNT_];
+    GblRandState states[THREAD_COUNT_ + 1];
+
+    for(unsigned t = 0; t < THREAD_COUNT_; ++t) {
+        GBL_TEST_COMPARE(thrd_create(&threads[t], threadStream_, &states[t]), thrd_success);
+        thrd_join(threads[t], NULL);
+    }
+
+    states[THREAD_COUNT_] = *gblRandState();
+
+    for(unsigned t = 0; t <= THREAD_COUNT_; ++t)
+        for(unsigned p = 0; p < t; ++p)
+            GBL_TEST_VERIFY(memcmp(&states[t], &states[p], sizeof(GblRandState)));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(bufferProfile)
+    GblTimer timer;
+    uint8_t* pBytes = (uint8_t*)pFixture->batch;
+
+    gblSetRand(gblRandLehmer);
+    GblTimer_start(&timer);
+    for(size_t i = 0; i < sizeof(pFixture->batch); ++i)
+        pBytes[i] = (uint8_t)gblRandEquilikely(0, 255);
+    GblTimer_stop(&timer);
+    GBL_CTX_INFO("%-20s: %10.3lf ms", "Lehmer bytes", GblTimer_elapsedMs(&timer));
+
+    gblSetRand(GBL_RAND_GENERATOR_DEFAULT);
+    GblTimer_start(&timer);
+    for(size_t i = 0; i < sizeof(pFixture->batch); ++i)
+        pBytes[i] = (uint8_t)gblRandEquilikely(0, 255);
+    GblTimer_stop(&timer);
+    GBL_CTX_INFO("%-20s: %10.3lf ms", "xoshiro256** bytes", GblTimer_elapsedMs(&timer));
+
+    GblTimer_start(&timer);
+    gblRandBuffer(pBytes, sizeof(pFixture->batch));
+    GblTimer_stop(&timer);
+    GBL_CTX_INFO("%-20s: %10.3lf ms", "gblRandBuffer", GblTimer_elapsedMs(&timer));
+
+    GblTimer_start(&timer);
+    gblRandUniformN(pFixture->batch, BATCH_SIZE_, 0.0f, 1.0f);
+    GblTimer_stop(&timer);
+    GBL_CTX_INFO("%-20s: %10.3lf ms", "gblRandUniformN", GblTimer_elapsedMs(&timer));
+
+    GblTimer_start(&timer);
+    gblRandNormalN(pFixture->batch, BATCH_SIZE_, 0.0f, 1.0f);
+    GblTimer_stop(&timer);
+    GBL_CTX_INFO("%-20s: %10.3lf ms", "gblRandNormalN", GblTimer_elapsedMs(&timer));
+GBL_TEST_CASE_END
+
 GBL_TEST_REGISTER(libCDuplicate,
                   lehmerDuplicate,
                   libCBenchmark,
-                  lehmerBenchmark)
+                  lehmerBenchmark,
+                  xoshiroDuplicate,
+                  xoshiroBenchmark,
+                  stateSeed,
+                  stateReference,
+                  stateJump,
+                  stateSplit,
+                  setState,
+                  lanesSplit,
+                  buffer,
+                  uniformN,
+                  normalN,
+                  threadStreams,
+                  bufferProfile)
@@ -2,6 +2,8 @@
 #include <gimbal/algorithms/gimbal_sort.h>
 #include <gimbal/test/gimbal_test_macros.h>
 #include <gimbal/algorithms/gimbal_random.h>
+#include <gimbal/core/gimbal_main_loop.h>
+#include <gimbal/utils/gimbal_timer.h>
 
 #define GBL_SORT_TEST_SUITE_(inst)          (GBL_PRIVATE(GblSortTestSuite, inst))
 
@@ -105,6 +107,318 @@ static GBL_RESULT GblSortTestSuite_heapSort_(GblTestSuite* pSelf, GblContext* pC
     GBL_CTX_END();
 }
 
+#define GBL_SORT_TEST_SUITE_PATTERN_COUNT_  50000
+#define GBL_SORT_TEST_SUITE_PROFILE_COUNT_  (1 << 18)
+
+typedef struct SortRecord12_ {
+    uint32_t key;
+    uint32_t seq;
+    uint32_t pad;
+} SortRecord12_;
+
+typedef struct SortRecord16_ {
+    uint64_t key;
+    uint64_t seq;
+} SortRecord16_;
+
+static uint64_t GblSortTestSuite_random_(uint64_t* pSeed) {
+    *pSeed ^= *pSeed << 13;
+    *pSeed ^= *pSeed >> 7;
+    *pSeed ^= *pSeed << 17;
+    return *pSeed;
+}
+
+static int GblSortTestSuite_compareU32_(const void* p1, const void* p2) {
+    const uint32_t a = *(const uint32_t*)p1, b = *(const uint32_t*)p2;
+    return (a > b) - (a < b);
+}
+
+static int GblSortTestSuite_compareU64_(const void* p1, const void* p2) {
+    const uint64_t a = *(const uint64_t*)p1, b = *(const uint64_t*)p2;
+    return (a > b) - (a < b);
+}
+
+static int GblSortTestSuite_compareI64_(const void* p1, const void* p2) {
+    const int64_t a = *(const int64_t*)p1, b = *(const int64_t*)p2;
+    return (a > b) - (a < b);
+}
+
+static int GblSortTestSuite_compareDouble_(const void* p1, const void* p2) {
+    const double a = *(const double*)p1, b = *(const double*)p2;
+    return (a > b) - (a < b);
+}
+
+static int GblSortTestSuite_compareRecord12_(const void* p1, const void* p2) {
+    return GblSortTestSuite_compareU32_(&((const SortRecord12_*)p1)->key, &((const SortRecord12_*)p2)->key);
+}
+
+static int GblSortTestSuite_compareRecord16_(const void* p1, const void* p2) {
+    return GblSortTestSuite_compareU64_(&((const SortRecord16_*)p1)->key, &((const SortRecord16_*)p2)->key);
+}
+
+static uint64_t GblSortTestSuite_keyU32_(const void* pElem) {
+    return *(const uint32_t*)pElem;
+}
+
+static uint64_t GblSortTestSuite_keyU64_(const void* pElem) {
+    return *(const uint64_t*)pElem;
+}
+
+static uint64_t GblSortTestSuite_keyI64_(const void* pElem) {
+    return gblSortRadixKeyInt(*(const int64_t*)pElem);
+}
+
+static uint64_t GblSortTestSuite_keyDouble_(const void* pElem) {
+    return gblSortRadixKeyFloat(*(const double*)pElem);
+}
+
+static uint64_t GblSortTestSuite_keyRecord12_(const void* pElem) {
+    return ((const SortRecord12_*)pElem)->key;
+}
+
+// fills values following one of several patterns known to trip up naive quicksorts
+static void GblSortTestSuite_pattern_(uint64_t* pValues, size_t count, size_t pattern, uint64_t* pSeed) {
+    for(size_t v = 0; v < count; ++v) {
+        switch(pattern) {
+        case 0: pValues[v] = GblSortTestSuite_random_(pSeed);             break; // random
+        case 1: pValues[v] = v;                                           break; // ascending
+        case 2: pValues[v] = count - v;                                   break; // descending
+        case 3: pValues[v] = 7;                                           break; // all equal
+        case 4: pValues[v] = GblSortTestSuite_random_(pSeed) % 4;         break; // few unique
+        case 5: pValues[v] = v < count / 2? v : count - v;                break; // organ pipe
+        case 6: pValues[v] = v % 64;                                      break; // sawtooth
+        case 7: pValues[v] = v == count / 2? 0 : v;                       break; // one out of place
+        case 8: pValues[v] = (v & 1)? v : count - v;                      break; // interleaved
+        }
+    }
+}
+
+static GBL_RESULT GblSortTestSuite_verifyU64_(GblTestSuite* pSelf, const uint64_t* pValues, const uint64_t* pExpected, size_t count) {
+    GBL_CTX_BEGIN(pSelf);
+    for(size_t v = 0; v < count; ++v)
+        GBL_TEST_VERIFY(pValues[v] == pExpected[v]);
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblSortTestSuite_sort_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+    GBL_CTX_VERIFY_CALL(GblSortTestSuite_testSort_(pSelf, gblSort));
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblSortTestSuite_sortPatterns_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+
+    static const size_t counts[] = { 0, 1, 2, 3, 23, 24, 25, 129, 1000, GBL_SORT_TEST_SUITE_PATTERN_COUNT_ };
+
+    uint64_t*      pValues   = GBL_CTX_MALLOC(sizeof(uint64_t) * GBL_SORT_TEST_SUITE_PATTERN_COUNT_);
+    uint64_t*      pExpected = GBL_CTX_MALLOC(sizeof(uint64_t) * GBL_SORT_TEST_SUITE_PATTERN_COUNT_);
+    uint64_t*      pSorted   = GBL_CTX_MALLOC(sizeof(uint64_t) * GBL_SORT_TEST_SUITE_PATTERN_COUNT_);
+    uint32_t*      pU32      = GBL_CTX_MALLOC(sizeof(uint32_t) * GBL_SORT_TEST_SUITE_PATTERN_COUNT_);
+    SortRecord12_* pRec12    = GBL_CTX_MALLOC(sizeof(SortRecord12_) * GBL_SORT_TEST_SUITE_PATTERN_COUNT_);
+    SortRecord16_* pRec16    = GBL_CTX_MALLOC(sizeof(SortRecord16_) * GBL_SORT_TEST_SUITE_PATTERN_COUNT_);
+    uint64_t       seed      = 0x2545F4914F6CDD1Dull;
+
+    for(size_t c = 0; c < GBL_COUNT_OF(counts); ++c) {
+        const size_t count = counts[c];
+
+        for(size_t pattern = 0; pattern < 9; ++pattern) {
+            GblSortTestSuite_pattern_(pValues, count, pattern, &seed);
+
+            // 32-bit keys keep the sorted order of the 64-bit ones as long as they're small
+            if(pattern == 0)
+                for(size_t v = 0; v < count; ++v)
+                    pValues[v] &= UINT32_MAX;
+
+            memcpy(pExpected, pValues, sizeof(uint64_t) * count);
+            qsort(pExpected, count, sizeof(uint64_t), GblSortTestSuite_compareU64_);
+
+            memcpy(pSorted, pValues, sizeof(uint64_t) * count);
+            gblSort(pSorted, count, sizeof(uint64_t), GblSortTestSuite_compareU64_);
+            GBL_CTX_VERIFY_CALL(GblSortTestSuite_verifyU64_(pSelf, pSorted, pExpected, count));
+
+            for(size_t v = 0; v < count; ++v) {
+                pU32[v]       = (uint32_t)pValues[v];
+                pRec12[v].key = (uint32_t)pValues[v];
+                pRec16[v].key = pValues[v];
+            }
+
+            gblSort(pU32, count, sizeof(uint32_t), GblSortTestSuite_compareU32_);
+            gblSort(pRec12, count, sizeof(SortRecord12_), GblSortTestSuite_compareRecord12_);
+            gblSort(pRec16, count, sizeof(SortRecord16_), GblSortTestSuite_compareRecord16_);
+
+            for(size_t v = 0; v < count; ++v) {
+                GBL_TEST_VERIFY(pU32[v]       == (uint32_t)pExpected[v]);
+                GBL_TEST_VERIFY(pRec12[v].key == (uint32_t)pExpected[v]);
+                GBL_TEST_VERIFY(pRec16[v].key == pExpected[v]);
+            }
+        }
+    }
+
+    GBL_CTX_FREE(pRec16);
+    GBL_CTX_FREE(pRec12);
+    GBL_CTX_FREE(pU32);
+    GBL_CTX_FREE(pSorted);
+    GBL_CTX_FREE(pExpected);
+    GBL_CTX_FREE(pValues);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblSortTestSuite_mergeStable_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    SortRecord12_* pRecords = GBL_CTX_MALLOC(sizeof(SortRecord12_) * GBL_SORT_TEST_SUITE_PATTERN_COUNT_);
+    SortRecord12_* pBuffer  = GBL_CTX_MALLOC(sizeof(SortRecord12_) * GBL_SORT_TEST_SUITE_PATTERN_COUNT_);
+    uint64_t       seed     = 99;
+
+    for(size_t pass = 0; pass < 3; ++pass) {
+        for(uint32_t r = 0; r < GBL_SORT_TEST_SUITE_PATTERN_COUNT_; ++r) {
+            pRecords[r].key = (uint32_t)(GblSortTestSuite_random_(&seed) % 16);
+            pRecords[r].seq = r;
+        }
+
+        switch(pass) {
+        case 0: gblSortMerge(pRecords, GBL_SORT_TEST_SUITE_PATTERN_COUNT_, sizeof(SortRecord12_), GblSortTestSuite_compareRecord12_); break;
+        case 1: gblSortMergeBuffer(pRecords, GBL_SORT_TEST_SUITE_PATTERN_COUNT_, sizeof(SortRecord12_), GblSortTestSuite_compareRecord12_, pBuffer); break;
+        case 2: GBL_CTX_VERIFY_CALL(gblSortRadix(pRecords, GBL_SORT_TEST_SUITE_PATTERN_COUNT_, sizeof(SortRecord12_), GblSortTestSuite_keyRecord12_)); break;
+        }
+
+        for(size_t r = 1; r < GBL_SORT_TEST_SUITE_PATTERN_COUNT_; ++r) {
+            GBL_TEST_VERIFY(pRecords[r - 1].key <= pRecords[r].key);
+            if(pRecords[r - 1].key == pRecords[r].key)
+                GBL_TEST_VERIFY(pRecords[r - 1].seq < pRecords[r].seq);
+        }
+    }
+
+    GBL_CTX_FREE(pBuffer);
+    GBL_CTX_FREE(pRecords);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblSortTestSuite_radix_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+
+    uint32_t* pU32      = GBL_CTX_MALLOC(sizeof(uint32_t) * GBL_SORT_TEST_SUITE_PATTERN_COUNT_);
+    int64_t*  pI64      = GBL_CTX_MALLOC(sizeof(int64_t)  * GBL_SORT_TEST_SUITE_PATTERN_COUNT_);
+    double*   pDoubles  = GBL_CTX_MALLOC(sizeof(double)   * GBL_SORT_TEST_SUITE_PATTERN_COUNT_);
+    uint64_t* pExpected = GBL_CTX_MALLOC(sizeof(uint64_t) * GBL_SORT_TEST_SUITE_PATTERN_COUNT_);
+    uint64_t  seed      = 31337;
+
+    for(size_t v = 0; v < GBL_SORT_TEST_SUITE_PATTERN_COUNT_; ++v) {
+        const uint64_t random = GblSortTestSuite_random_(&seed);
+        pU32[v]     = (uint32_t)random;
+        pI64[v]     = (int64_t)random >> (v % 48);
+        pDoubles[v] = ((int64_t)random % 2000000) / 1000.0;
+    }
+    pDoubles[0] = -0.0;
+    pDoubles[1] = 0.0;
+
+    memcpy(pExpected, pU32, sizeof(uint32_t) * GBL_SORT_TEST_SUITE_PATTERN_COUNT_);
+    qsort(pExpected, GBL_SORT_TEST_SUITE_PATTERN_COUNT_, sizeof(uint32_t), GblSortTestSuite_compareU32_);
+    GBL_CTX_VERIFY_CALL(gblSortRadix(pU32, GBL_SORT_TEST_SUITE_PATTERN_COUNT_, sizeof(uint32_t), GblSortTestSuite_keyU32_));
+    GBL_TEST_VERIFY(!memcmp(pU32, pExpected, sizeof(uint32_t) * GBL_SORT_TEST_SUITE_PATTERN_COUNT_));
+
+    memcpy(pExpected, pI64, sizeof(int64_t) * GBL_SORT_TEST_SUITE_PATTERN_COUNT_);
+    qsort(pExpected, GBL_SORT_TEST_SUITE_PATTERN_COUNT_, sizeof(int64_t), GblSortTestSuite_compareI64_);
+    GBL_CTX_VERIFY_CALL(gblSortRadix(pI64, GBL_SORT_TEST_SUITE_PATTERN_COUNT_, sizeof(int64_t), GblSortTestSuite_keyI64_));
+    GBL_TEST_VERIFY(!memcmp(pI64, pExpected, sizeof(int64_t) * GBL_SORT_TEST_SUITE_PATTERN_COUNT_));
+
+    GBL_CTX_VERIFY_CALL(gblSortRadix(pDoubles, GBL_SORT_TEST_SUITE_PATTERN_COUNT_, sizeof(double), GblSortTestSuite_keyDouble_));
+    for(size_t v = 1; v < GBL_SORT_TEST_SUITE_PATTERN_COUNT_; ++v)
+        GBL_TEST_VERIFY(GblSortTestSuite_compareDouble_(&pDoubles[v - 1], &pDoubles[v]) <= 0);
+
+    GBL_TEST_EXPECT_ERROR();
+    const GBL_RESULT result = gblSortRadix(pU32, 2, sizeof(uint32_t), NULL);
+    GBL_TEST_COMPARE(result, GBL_RESULT_ERROR_INVALID_POINTER);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_CTX_FREE(pExpected);
+    GBL_CTX_FREE(pDoubles);
+    GBL_CTX_FREE(pI64);
+    GBL_CTX_FREE(pU32);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblSortTestSuite_parallel_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+
+    static const size_t counts[] = { 10, GBL_SORT_PARALLEL_GRAIN * 2 + 1, GBL_SORT_PARALLEL_GRAIN * 7 };
+
+    GblMainLoop* pLoop     = GblMainLoop_create(3);
+    uint64_t*    pValues   = GBL_CTX_MALLOC(sizeof(uint64_t) * GBL_SORT_PARALLEL_GRAIN * 7);
+    uint64_t*    pExpected = GBL_CTX_MALLOC(sizeof(uint64_t) * GBL_SORT_PARALLEL_GRAIN * 7);
+    uint64_t     seed      = 4242;
+
+    for(size_t c = 0; c < GBL_COUNT_OF(counts); ++c) {
+        for(size_t pattern = 0; pattern < 9; ++pattern) {
+            GblSortTestSuite_pattern_(pValues, counts[c], pattern, &seed);
+
+            memcpy(pExpected, pValues, sizeof(uint64_t) * counts[c]);
+            qsort(pExpected, counts[c], sizeof(uint64_t), GblSortTestSuite_compareU64_);
+
+            GBL_CTX_VERIFY_CALL(gblSortParallel(pValues, counts[c], sizeof(uint64_t), GblSortTestSuite_compareU64_, pLoop));
+            GBL_CTX_VERIFY_CALL(GblSortTestSuite_verifyU64_(pSelf, pValues, pExpected, counts[c]));
+        }
+    }
+
+    // no loop means no threads
+    GblSortTestSuite_pattern_(pValues, counts[2], 0, &seed);
+    memcpy(pExpected, pValues, sizeof(uint64_t) * counts[2]);
+    qsort(pExpected, counts[2], sizeof(uint64_t), GblSortTestSuite_compareU64_);
+    GBL_CTX_VERIFY_CALL(gblSortParallel(pValues, counts[2], sizeof(uint64_t), GblSortTestSuite_compareU64_, NULL));
+    GBL_CTX_VERIFY_CALL(GblSortTestSuite_verifyU64_(pSelf, pValues, pExpected, counts[2]));
+
+    GBL_CTX_FREE(pExpected);
+    GBL_CTX_FREE(pValues);
+    GBL_TEST_COMPARE(GblMainLoop_unref(pLoop), 0);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblSortTestSuite_profile_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    GblMainLoop* pLoop   = GblMainLoop_create(3);
+    uint64_t*    pSource = GBL_CTX_MALLOC(sizeof(uint64_t) * GBL_SORT_TEST_SUITE_PROFILE_COUNT_);
+    uint64_t*    pValues = GBL_CTX_MALLOC(sizeof(uint64_t) * GBL_SORT_TEST_SUITE_PROFILE_COUNT_);
+    uint64_t*    pBuffer = GBL_CTX_MALLOC(sizeof(uint64_t) * GBL_SORT_TEST_SUITE_PROFILE_COUNT_);
+    uint64_t     seed    = 1;
+    GblTimer     timer;
+
+    for(size_t v = 0; v < GBL_SORT_TEST_SUITE_PROFILE_COUNT_; ++v)
+        pSource[v] = GblSortTestSuite_random_(&seed);
+
+    for(size_t engine = 0; engine < 5; ++engine) {
+        static const char* names[] = { "qsort", "gblSort", "gblSortMergeBuffer", "gblSortRadix", "gblSortParallel" };
+
+        memcpy(pValues, pSource, sizeof(uint64_t) * GBL_SORT_TEST_SUITE_PROFILE_COUNT_);
+
+        GblTimer_start(&timer);
+        switch(engine) {
+        case 0: qsort(pValues, GBL_SORT_TEST_SUITE_PROFILE_COUNT_, sizeof(uint64_t), GblSortTestSuite_compareU64_); break;
+        case 1: gblSort(pValues, GBL_SORT_TEST_SUITE_PROFILE_COUNT_, sizeof(uint64_t), GblSortTestSuite_compareU64_); break;
+        case 2: gblSortMergeBuffer(pValues, GBL_SORT_TEST_SUITE_PROFILE_COUNT_, sizeof(uint64_t), GblSortTestSuite_compareU64_, pBuffer); break;
+        case 3: GBL_CTX_VERIFY_CALL(gblSortRadix(pValues, GBL_SORT_TEST_SUITE_PROFILE_COUNT_, sizeof(uint64_t), GblSortTestSuite_keyU64_)); break;
+        case 4: GBL_CTX_VERIFY_CALL(gblSortParallel(pValues, GBL_SORT_TEST_SUITE_PROFILE_COUNT_, sizeof(uint64_t), GblSortTestSuite_compareU64_, pLoop)); break;
+        }
+        GblTimer_stop(&timer);
+
+        GBL_CTX_INFO("%-20s: %10.3lf ms", names[engine], GblTimer_elapsedMs(&timer));
+    }
+
+    GBL_CTX_FREE(pBuffer);
+    GBL_CTX_FREE(pValues);
+    GBL_CTX_FREE(pSource);
+    GblMainLoop_unref(pLoop);
+
+    GBL_CTX_END();
+}
+
 GBL_EXPORT GblType GblSortTestSuite_type(void) {
     static GblType type = GBL_INVALID_TYPE;
 
@@ -117,6 +431,12 @@ GBL_EXPORT GblType GblSortTestSuite_type(void) {
         { "combSort",           GblSortTestSuite_combSort_         },
         { "mergeSort",          GblSortTestSuite_mergeSort_        },
         { "quickSort",          GblSortTestSuite_quickSort_        },
+        { "sort",               GblSortTestSuite_sort_             },
+        { "sortPatterns",       GblSortTestSuite_sortPatterns_     },
+        { "mergeStable",        GblSortTestSuite_mergeStable_      },
+        { "radix",              GblSortTestSuite_radix_            },
+        { "parallel",           GblSortTestSuite_parallel_         },
+        { "profile",            GblSortTestSuite_profile_          },
         { NULL,                 NULL                               }
     };
 
@@ -0,0 +1,276 @@
+#include "allocators/gimbal_allocation_tracker_test_suite.h"
+#include <gimbal/test/gimbal_test_macros.h>
+#include <gimbal/allocators/gimbal_allocation_tracker.h>
+#include <gimbal/utils/gimbal_timer.h>
+
+#define GBL_SELF_TYPE GblAllocationTrackerTestSuite
+
+#define GBL_ALLOCATION_TRACKER_TEST_INTERVAL_       4096
+#define GBL_ALLOCATION_TRACKER_TEST_SMALL_COUNT_    100000
+#define GBL_ALLOCATION_TRACKER_TEST_SMALL_SIZE_     64
+#define GBL_ALLOCATION_TRACKER_TEST_LARGE_COUNT_    1000
+#define GBL_ALLOCATION_TRACKER_TEST_LARGE_SIZE_     4096
+#define GBL_ALLOCATION_TRACKER_TEST_PROFILE_OPS_    200000
+#define GBL_ALLOCATION_TRACKER_TEST_PROFILE_LIVE_   256
+
+GBL_TEST_FIXTURE_NONE
+
+static const GblSourceLocation smallSite_ = { __FILE__, "smallSite", 1 };
+static const GblSourceLocation largeSite_ = { __FILE__, "largeSite", 2 };
+
+// The tracker never dereferences them, so the events can be fed fake pointers
+#define GBL_ALLOCATION_TRACKER_TEST_PTR_(site, index) \
+    ((const void*)(uintptr_t)(((uintptr_t)(site) << 24) + ((uintptr_t)(index) + 1) * 16))
+
+GBL_TEST_INIT()
+GBL_TEST_CASE_END
+
+GBL_TEST_FINAL()
+GBL_TEST_CASE_END
+
+// Returns GBL_TRUE if the estimate is within the given percentage of the expected value
+static GblBool withinPercent_(ptrdiff_t estimate, ptrdiff_t expected, ptrdiff_t percent) {
+    const ptrdiff_t error = estimate > expected? estimate - expected : expected - estimate;
+    return error * 100 <= expected * percent;
+}
+
+static const GblAllocationSite* findSite_(const GblAllocationProfile* pProfile, const GblSourceLocation* pLoc) {
+    for(size_t s = 0; s < pProfile->siteCount; ++s)
+        if(pProfile->pSites[s].location.pFunc == pLoc->pFunc)
+            return &pProfile->pSites[s];
+    return NULL;
+}
+
+static GBL_RESULT allocSites_(GblAllocationTracker* pTracker, size_t smallCount, size_t largeCount) {
+    GBL_CTX_BEGIN(NULL);
+
+    for(size_t a = 0; a < smallCount; ++a)
+        GBL_CTX_VERIFY_CALL(GblAllocationTracker_allocEvent(pTracker,
+                                                            GBL_ALLOCATION_TRACKER_TEST_PTR_(1, a),
+                                                            GBL_ALLOCATION_TRACKER_TEST_SMALL_SIZE_,
+                                                            8,
+                                                            "small",
+                                                            smallSite_));
+    for(size_t a = 0; a < largeCount; ++a)
+        GBL_CTX_VERIFY_CALL(GblAllocationTracker_allocEvent(pTracker,
+                                                            GBL_ALLOCATION_TRACKER_TEST_PTR_(2, a),
+                                                            GBL_ALLOCATION_TRACKER_TEST_LARGE_SIZE_,
+                                                            8,
+                                                            "large",
+                                                            largeSite_));
+    GBL_CTX_END();
+}
+
+GBL_TEST_CASE(create)
+    GblAllocationTracker* pTracker = GblAllocationTracker_create(pCtx);
+    GBL_TEST_VERIFY(pTracker);
+    GBL_TEST_COMPARE(GblAllocationTracker_sampleInterval(pTracker), 0);
+    GBL_TEST_COMPARE(pTracker->counters.allocEvents, 0);
+    GBL_TEST_COMPARE(pTracker->counters.bytesActive, 0);
+    GBL_TEST_CALL(GblAllocationTracker_destroy(pTracker));
+
+    pTracker = GblAllocationTracker_create(pCtx, GBL_ALLOCATION_TRACKER_SAMPLE_INTERVAL_DEFAULT);
+    GBL_TEST_VERIFY(pTracker);
+    GBL_TEST_COMPARE(GblAllocationTracker_sampleInterval(pTracker),
+                     GBL_ALLOCATION_TRACKER_SAMPLE_INTERVAL_DEFAULT);
+    GBL_TEST_CALL(GblAllocationTracker_destroy(pTracker));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(track)
+    GblAllocationTracker* pTracker = GblAllocationTracker_create(pCtx);
+    GBL_TEST_CALL(allocSites_(pTracker, 3, 2));
+
+    GBL_TEST_COMPARE(pTracker->counters.allocEvents, 5);
+    GBL_TEST_COMPARE(pTracker->counters.allocsActive, 5);
+    GBL_TEST_COMPARE(pTracker->counters.bytesActive,
+                     3 * GBL_ALLOCATION_TRACKER_TEST_SMALL_SIZE_ + 2 * GBL_ALLOCATION_TRACKER_TEST_LARGE_SIZE_);
+    GBL_TEST_COMPARE(pTracker->maxAllocationSize, GBL_ALLOCATION_TRACKER_TEST_LARGE_SIZE_);
+    GBL_TEST_VERIFY(GblAllocationTracker_validatePointer(pTracker, GBL_ALLOCATION_TRACKER_TEST_PTR_(1, 2)));
+    GBL_TEST_VERIFY(!GblAllocationTracker_validatePointer(pTracker, GBL_ALLOCATION_TRACKER_TEST_PTR_(1, 3)));
+
+    GBL_TEST_CALL(GblAllocationTracker_reallocEvent(pTracker,
+                                                    GBL_ALLOCATION_TRACKER_TEST_PTR_(1, 0),
+                                                    GBL_ALLOCATION_TRACKER_TEST_PTR_(3, 0),
+                                                    128,
+                                                    8,
+                                                    largeSite_));
+    GBL_TEST_CALL(GblAllocationTracker_freeEvent(pTracker, GBL_ALLOCATION_TRACKER_TEST_PTR_(1, 1), smallSite_));
+
+    GblAllocationProfile profile;
+    GBL_TEST_CALL(GblAllocationTracker_captureProfile(pTracker, &profile));
+    GBL_TEST_COMPARE(profile.siteCount, 2);
+    GBL_TEST_COMPARE(profile.counters.allocsActive, 4);
+    GBL_TEST_COMPARE(profile.counters.reallocEvents, 1);
+    GBL_TEST_VERIFY(profile.pSites[0].location.pFunc == largeSite_.pFunc);
+
+    const GblAllocationSite* pSmall = findSite_(&profile, &smallSite_);
+    GBL_TEST_VERIFY(pSmall);
+    GBL_TEST_COMPARE(pSmall->counters.allocEvents, 3);
+    GBL_TEST_COMPARE(pSmall->counters.freeEvents, 1);
+    GBL_TEST_COMPARE(pSmall->counters.allocsActive, 1);
+    GBL_TEST_COMPARE(pSmall->counters.bytesActive, GBL_ALLOCATION_TRACKER_TEST_SMALL_SIZE_);
+
+    const GblAllocationSite* pLarge = findSite_(&profile, &largeSite_);
+    GBL_TEST_VERIFY(pLarge);
+    GBL_TEST_COMPARE(pLarge->counters.reallocEvents, 1);
+    GBL_TEST_COMPARE(pLarge->counters.allocsActive, 3);
+    GBL_TEST_COMPARE(pLarge->counters.bytesActive, 2 * GBL_ALLOCATION_TRACKER_TEST_LARGE_SIZE_ + 128);
+
+    GBL_TEST_CALL(GblAllocationTracker_logProfile(pTracker, &profile, 0));
+    GBL_TEST_CALL(GblAllocationTracker_releaseProfile(pTracker, &profile));
+    GBL_TEST_VERIFY(!profile.pSites);
+    GBL_TEST_CALL(GblAllocationTracker_destroy(pTracker));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(sample)
+    GblAllocationTracker* pTracker = GblAllocationTracker_create(pCtx, GBL_ALLOCATION_TRACKER_TEST_INTERVAL_);
+    GBL_TEST_CALL(allocSites_(pTracker,
+                              GBL_ALLOCATION_TRACKER_TEST_SMALL_COUNT_,
+                              GBL_ALLOCATION_TRACKER_TEST_LARGE_COUNT_));
+
+    // Event counts stay exact
+    GBL_TEST_COMPARE(pTracker->counters.allocEvents,
+                     GBL_ALLOCATION_TRACKER_TEST_SMALL_COUNT_ + GBL_ALLOCATION_TRACKER_TEST_LARGE_COUNT_);
+    GBL_TEST_COMPARE(pTracker->counters.allocsActive,
+                     GBL_ALLOCATION_TRACKER_TEST_SMALL_COUNT_ + GBL_ALLOCATION_TRACKER_TEST_LARGE_COUNT_);
+    GBL_TEST_COMPARE(pTracker->maxAllocationSize, GBL_ALLOCATION_TRACKER_TEST_LARGE_SIZE_);
+
+    // Only a small fraction of allocations should have been recorded
+    size_t sampled = 0;
+    for(size_t a = 0; a < GBL_ALLOCATION_TRACKER_TEST_SMALL_COUNT_; ++a)
+        sampled += GblAllocationTracker_validatePointer(pTracker, GBL_ALLOCATION_TRACKER_TEST_PTR_(1, a));
+    GBL_TEST_VERIFY(sampled && sampled < GBL_ALLOCATION_TRACKER_TEST_SMALL_COUNT_ / 20);
+
+    // While the byte counts are estimated from them
+    const ptrdiff_t smallBytes = GBL_ALLOCATION_TRACKER_TEST_SMALL_COUNT_ * GBL_ALLOCATION_TRACKER_TEST_SMALL_SIZE_;
+    const ptrdiff_t largeBytes = GBL_ALLOCATION_TRACKER_TEST_LARGE_COUNT_ * GBL_ALLOCATION_TRACKER_TEST_LARGE_SIZE_;
+    GBL_TEST_VERIFY(withinPercent_(pTracker->counters.bytesActive, smallBytes + largeBytes, 15));
+
+    GblAllocationProfile profile;
+    GBL_TEST_CALL(GblAllocationTracker_captureProfile(pTracker, &profile));
+    GBL_TEST_COMPARE(profile.siteCount, 2);
+
+    const GblAllocationSite* pSmall = findSite_(&profile, &smallSite_);
+    const GblAllocationSite* pLarge = findSite_(&profile, &largeSite_);
+    GBL_TEST_VERIFY(pSmall && pLarge);
+    GBL_TEST_VERIFY(withinPercent_(pSmall->counters.bytesActive, smallBytes, 15));
+    GBL_TEST_VERIFY(withinPercent_(pSmall->counters.allocsActive, GBL_ALLOCATION_TRACKER_TEST_SMALL_COUNT_, 15));
+    GBL_TEST_VERIFY(withinPercent_(pLarge->counters.bytesActive, largeBytes, 15));
+    GBL_TEST_VERIFY(withinPercent_(pLarge->counters.allocsActive, GBL_ALLOCATION_TRACKER_TEST_LARGE_COUNT_, 15));
+    GBL_TEST_CALL(GblAllocationTracker_releaseProfile(pTracker, &profile));
+
+    // Freeing everything from a site removes exactly the weight which was added
+    for(size_t a = 0; a < GBL_ALLOCATION_TRACKER_TEST_SMALL_COUNT_; ++a)
+        GBL_TEST_CALL(GblAllocationTracker_freeEvent(pTracker, GBL_ALLOCATION_TRACKER_TEST_PTR_(1, a), smallSite_));
+
+    GBL_TEST_COMPARE(pTracker->counters.freeEvents, GBL_ALLOCATION_TRACKER_TEST_SMALL_COUNT_);
+    GBL_TEST_COMPARE(pTracker->counters.allocsActive, GBL_ALLOCATION_TRACKER_TEST_LARGE_COUNT_);
+
+    GBL_TEST_CALL(GblAllocationTracker_captureProfile(pTracker, &profile));
+    pSmall = findSite_(&profile, &smallSite_);
+    pLarge = findSite_(&profile, &largeSite_);
+    GBL_TEST_COMPARE(pSmall->counters.bytesActive, 0);
+    GBL_TEST_COMPARE(pSmall->counters.allocsActive, 0);
+    GBL_TEST_COMPARE(profile.counters.bytesActive, pLarge->counters.bytesActive);
+    GBL_TEST_CALL(GblAllocationTracker_releaseProfile(pTracker, &profile));
+
+    GBL_TEST_CALL(GblAllocationTracker_destroy(pTracker));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(diffProfile)
+    GblAllocationTracker* pTracker = GblAllocationTracker_create(pCtx, GBL_ALLOCATION_TRACKER_TEST_INTERVAL_);
+    GblAllocationProfile  before, diff;
+
+    GBL_TEST_CALL(allocSites_(pTracker, GBL_ALLOCATION_TRACKER_TEST_SMALL_COUNT_, 0));
+    GBL_TEST_CALL(GblAllocationTracker_captureProfile(pTracker, &before));
+    GBL_TEST_COMPARE(before.siteCount, 1);
+
+    GBL_TEST_CALL(allocSites_(pTracker, 0, GBL_ALLOCATION_TRACKER_TEST_LARGE_COUNT_));
+    GBL_TEST_CALL(GblAllocationTracker_diffProfile(pTracker, &before, &diff));
+
+    GBL_TEST_COMPARE(diff.counters.allocEvents, GBL_ALLOCATION_TRACKER_TEST_LARGE_COUNT_);
+    GBL_TEST_COMPARE(diff.counters.allocsActive, GBL_ALLOCATION_TRACKER_TEST_LARGE_COUNT_);
+    GBL_TEST_COMPARE(diff.siteCount, 2);
+
+    // The site which grew sorts first, while the one which didn't has nothing left over
+    GBL_TEST_VERIFY(diff.pSites[0].location.pFunc == largeSite_.pFunc);
+    GBL_TEST_VERIFY(withinPercent_(diff.pSites[0].counters.bytesActive,
+                                   GBL_ALLOCATION_TRACKER_TEST_LARGE_COUNT_ * GBL_ALLOCATION_TRACKER_TEST_LARGE_SIZE_,
+                                   15));
+    GBL_TEST_VERIFY(diff.pSites[1].location.pFunc == smallSite_.pFunc);
+    GBL_TEST_COMPARE(diff.pSites[1].counters.allocEvents, 0);
+    GBL_TEST_COMPARE(diff.pSites[1].counters.bytesActive, 0);
+
+    GBL_TEST_CALL(GblAllocationTracker_logProfile(pTracker, &diff, 1));
+    GBL_TEST_CALL(GblAllocationTracker_releaseProfile(pTracker, &diff));
+    GBL_TEST_CALL(GblAllocationTracker_releaseProfile(pTracker, &before));
+    GBL_TEST_CALL(GblAllocationTracker_destroy(pTracker));
+GBL_TEST_CASE_END
+
+static GBL_RESULT profileChurn_(GblAllocationTracker* pTracker, double* pMs) {
+    GBL_CTX_BEGIN(NULL);
+
+    void*    ppLive[GBL_ALLOCATION_TRACKER_TEST_PROFILE_LIVE_] = { NULL };
+    GblTimer timer;
+
+    GblTimer_start(&timer);
+
+    for(size_t o = 0; o < GBL_ALLOCATION_TRACKER_TEST_PROFILE_OPS_; ++o) {
+        const size_t slot = (o * 7) % GBL_ALLOCATION_TRACKER_TEST_PROFILE_LIVE_;
+        const size_t size = 16 + (o % 32) * 16;
+
+        if(ppLive[slot]) {
+            if(pTracker)
+                GblAllocationTracker_freeEvent(pTracker, ppLive[slot], smallSite_);
+            free(ppLive[slot]);
+        }
+
+        ppLive[slot] = malloc(size);
+
+        if(pTracker)
+            GblAllocationTracker_allocEvent(pTracker, ppLive[slot], size, 8, NULL, smallSite_);
+    }
+
+    for(size_t s = 0; s < GBL_ALLOCATION_TRACKER_TEST_PROFILE_LIVE_; ++s) {
+        if(pTracker)
+            GblAllocationTracker_freeEvent(pTracker, ppLive[s], smallSite_);
+        free(ppLive[s]);
+    }
+
+    GblTimer_stop(&timer);
+    *pMs = GblTimer_elapsedMs(&timer);
+
+    GBL_CTX_END();
+}
+
+GBL_TEST_CASE(profile)
+    GblAllocationTracker* pTrackers[3] = {
+        NULL,
+        GblAllocationTracker_create(pCtx, GBL_ALLOCATION_TRACKER_SAMPLE_INTERVAL_DEFAULT),
+        GblAllocationTracker_create(pCtx)
+    };
+    double ms[3];
+
+    for(size_t t = 0; t < GBL_COUNT_OF(pTrackers); ++t)
+        GBL_TEST_CALL(profileChurn_(pTrackers[t], &ms[t]));
+
+    GBL_CTX_INFO("%-20s: %10.3lf ms", "Untracked", ms[0]);
+    GBL_CTX_INFO("%-20s: %10.3lf ms", "Sampled", ms[1]);
+    GBL_CTX_INFO("%-20s: %10.3lf ms", "Fully tracked", ms[2]);
+
+    // Sampled or not, every tracked allocation is balanced out by its free
+    GBL_TEST_COMPARE(pTrackers[1]->counters.allocsActive, 0);
+    GBL_TEST_COMPARE(pTrackers[2]->counters.allocsActive, 0);
+    GBL_TEST_COMPARE(pTrackers[2]->counters.bytesActive, 0);
+    GBL_TEST_COMPARE(pTrackers[2]->counters.allocEvents, GBL_ALLOCATION_TRACKER_TEST_PROFILE_OPS_);
+    GBL_TEST_COMPARE(pTrackers[2]->counters.freeEvents, GBL_ALLOCATION_TRACKER_TEST_PROFILE_OPS_);
+
+    for(size_t t = 1; t < GBL_COUNT_OF(pTrackers); ++t)
+        GBL_TEST_CALL(GblAllocationTracker_destroy(pTrackers[t]));
+GBL_TEST_CASE_END
+
+GBL_TEST_REGISTER(create,
+                  track,
+                  sample,
+                  diffProfile,
+                  profile)
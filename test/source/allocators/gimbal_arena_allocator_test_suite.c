@@ -1,6 +1,7 @@
 #include "allocators/gimbal_arena_allocator_test_suite.h"
 #include <gimbal/allocators/gimbal_arena_allocator.h>
 #include <gimbal/test/gimbal_test_macros.h>
+#include <tinycthread.h>
 
 #define GBL_ARENA_ALLOCATOR_TEST_SUITE_(inst)   (GBL_PRIVATE(GblArenaAllocatorTestSuite, inst))
 
@@ -81,16 +82,22 @@ static GBL_RESULT GblArenaAllocatorTestSuite_allocAligned_(GblTestSuite* pSelf,
     GBL_CTX_END();
 }
 
-static GBL_RESULT GblArenaAllocatorTestSuite_allocFail_(GblTestSuite* pSelf, GblContext* pCtx) {
+static GBL_RESULT GblArenaAllocatorTestSuite_allocLarge_(GblTestSuite* pSelf, GblContext* pCtx) {
     GBL_CTX_BEGIN(pCtx);
     GblArenaAllocatorTestSuite_* pSelf_ = GBL_ARENA_ALLOCATOR_TEST_SUITE_(pSelf);
 
-    GBL_TEST_EXPECT_ERROR();
+    const size_t pageCount  = GblArenaAllocator_pageCount(&pSelf_->arena);
+    const size_t bytesAvail = GblArenaAllocator_bytesAvailable(&pSelf_->arena);
 
-    void* pPtr = GblArenaAllocator_alloc(&pSelf_->arena, 256, 64);
-    GBL_TEST_VERIFY(!pPtr);
-    GBL_TEST_COMPARE(GBL_CTX_LAST_RESULT(), GBL_RESULT_ERROR_OVERFLOW);
-    GBL_CTX_CLEAR_LAST_RECORD();
+    char* pPtr = GblArenaAllocator_alloc(&pSelf_->arena, 256, 64);
+    GBL_TEST_VERIFY(pPtr);
+    GBL_TEST_VERIFY(!((uintptr_t)pPtr & 0x3f));
+    memset(pPtr, 0xaa, 256);
+
+    // given its own page, leaving the active one alone
+    GBL_TEST_COMPARE(GblArenaAllocator_largePageCount(&pSelf_->arena), 1);
+    GBL_TEST_COMPARE(GblArenaAllocator_pageCount(&pSelf_->arena), pageCount);
+    GBL_TEST_COMPARE(GblArenaAllocator_bytesAvailable(&pSelf_->arena), bytesAvail);
 
     GBL_CTX_END();
 }
@@ -143,6 +150,145 @@ static GBL_RESULT GblArenaAllocatorTestSuite_destruct_(GblTestSuite* pSelf, GblC
     GBL_CTX_END();
 }
 
+static GBL_RESULT GblArenaAllocatorTestSuite_warmPages_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+    GblArenaAllocator arena;
+
+    GBL_CTX_VERIFY_CALL(GblArenaAllocator_construct(&arena, 128, 16, GBL_NULL, pCtx, 0));
+    GBL_CTX_VERIFY_CALL(GblArenaAllocator_setWarmPages(&arena, 2));
+
+    for(size_t i = 0; i < 4; ++i)
+        GBL_TEST_VERIFY(GblArenaAllocator_alloc(&arena, 100));
+    GBL_TEST_COMPARE(GblArenaAllocator_pageCount(&arena), 4);
+
+    GBL_CTX_VERIFY_CALL(GblArenaAllocator_freeAll(&arena));
+    GBL_TEST_COMPARE(GblArenaAllocator_pageCount(&arena), 0);
+    GBL_TEST_COMPARE(GblArenaAllocator_warmPageCount(&arena), 2);
+
+    // reused rather than allocated from the context
+    GBL_TEST_VERIFY(GblArenaAllocator_alloc(&arena, 100));
+    GBL_TEST_COMPARE(GblArenaAllocator_pageCount(&arena), 1);
+    GBL_TEST_COMPARE(GblArenaAllocator_warmPageCount(&arena), 1);
+    GBL_TEST_COMPARE(GblArenaAllocator_bytesUsed(&arena), 112);
+
+    GBL_CTX_VERIFY_CALL(GblArenaAllocator_setWarmPages(&arena, 0));
+    GBL_TEST_COMPARE(GblArenaAllocator_warmPageCount(&arena), 0);
+
+    GBL_CTX_VERIFY_CALL(GblArenaAllocator_destruct(&arena));
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblArenaAllocatorTestSuite_largeLoadState_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+    GblArenaAllocator      arena;
+    GblArenaAllocatorState state;
+
+    GBL_CTX_VERIFY_CALL(GblArenaAllocator_construct(&arena, 128, 16, GBL_NULL, pCtx, 0));
+
+    GBL_TEST_VERIFY(GblArenaAllocator_alloc(&arena, 1000));
+    GblArenaAllocator_saveState(&arena, &state);
+
+    for(size_t i = 0; i < 3; ++i) {
+        GBL_TEST_VERIFY(GblArenaAllocator_alloc(&arena, 100));
+        GBL_TEST_VERIFY(GblArenaAllocator_alloc(&arena, 1000 * (i + 1)));
+    }
+    GBL_TEST_COMPARE(GblArenaAllocator_largePageCount(&arena), 4);
+
+    GBL_CTX_VERIFY_CALL(GblArenaAllocator_loadState(&arena, &state));
+    GBL_TEST_COMPARE(GblArenaAllocator_largePageCount(&arena), 1);
+    GBL_TEST_COMPARE(GblArenaAllocator_pageCount(&arena), 0);
+
+    GBL_CTX_VERIFY_CALL(GblArenaAllocator_destruct(&arena));
+    GBL_TEST_COMPARE(GblArenaAllocator_largePageCount(&arena), 0);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblArenaAllocatorTestSuite_mmap_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+    GblArenaAllocator arena;
+    const size_t      size = 4 * GBL_ARENA_ALLOCATOR_HUGE_PAGE_SIZE;
+
+    GBL_CTX_VERIFY_CALL(GblArenaAllocator_construct(&arena,
+                                                    GBL_ARENA_ALLOCATOR_MMAP_THRESHOLD,
+                                                    16,
+                                                    GBL_NULL,
+                                                    pCtx,
+                                                    GBL_ARENA_ALLOCATOR_FLAG_MMAP));
+
+    uint8_t* pSmall = GblArenaAllocator_alloc(&arena, 64);
+    uint8_t* pLarge = GblArenaAllocator_alloc(&arena, size, 4096);
+    GBL_TEST_VERIFY(pSmall && pLarge);
+    GBL_TEST_VERIFY(!((uintptr_t)pLarge & 0xfff));
+
+    pSmall[0] = pSmall[63] = 0x1;
+    pLarge[0] = pLarge[size - 1] = 0x2;
+
+    GBL_TEST_COMPARE(GblArenaAllocator_largePageCount(&arena), 1);
+    GBL_TEST_VERIFY(GblArenaAllocator_totalCapacity(&arena) >= size + GBL_ARENA_ALLOCATOR_MMAP_THRESHOLD);
+
+    GBL_CTX_VERIFY_CALL(GblArenaAllocator_destruct(&arena));
+
+    GBL_CTX_END();
+}
+
+static int GblArenaAllocatorTestSuite_threadFrames_(void* pData) {
+    GblArenaAllocator** ppArena = pData;
+
+    *ppArena = GblThreadArena_current();
+
+    for(size_t frame = 0; frame < 8; ++frame) {
+        for(size_t i = 0; i < GBL_THREAD_ARENA_WARM_PAGES * 64; ++i)
+            if(!GblThreadArena_alloc(1024))
+                return -1;
+
+        if(!GblThreadArena_alloc(GBL_THREAD_ARENA_PAGE_SIZE * 2))
+            return -1;
+
+        if(!GBL_RESULT_SUCCESS(GblThreadArena_reset()))
+            return -1;
+    }
+
+    return (int)GblArenaAllocator_warmPageCount(*ppArena);
+}
+
+static GBL_RESULT GblArenaAllocatorTestSuite_threadArena_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+    GblArenaAllocator* pThreadArena = NULL;
+    thrd_t             thread;
+    int                warmPages = 0;
+
+    GblArenaAllocator* pArena = GblThreadArena_current();
+    GBL_TEST_VERIFY(pArena);
+    GBL_TEST_COMPARE(GblThreadArena_current(), pArena);
+
+    GBL_TEST_VERIFY(GblThreadArena_alloc(100));
+    GBL_TEST_VERIFY(GblThreadArena_alloc(GBL_THREAD_ARENA_PAGE_SIZE + 1, 64));
+    GBL_TEST_COMPARE(GblArenaAllocator_pageCount(pArena), 1);
+    GBL_TEST_COMPARE(GblArenaAllocator_largePageCount(pArena), 1);
+
+    GBL_TEST_COMPARE(thrd_create(&thread, GblArenaAllocatorTestSuite_threadFrames_, &pThreadArena), thrd_success);
+    thrd_join(thread, &warmPages);
+
+    // each thread has its own, which keeps its pages warm across resets
+    GBL_TEST_VERIFY(pThreadArena && pThreadArena != pArena);
+    GBL_TEST_COMPARE(warmPages, GBL_THREAD_ARENA_WARM_PAGES);
+
+    GBL_CTX_VERIFY_CALL(GblThreadArena_reset());
+    GBL_TEST_COMPARE(GblArenaAllocator_bytesUsed(pArena), 0);
+    GBL_TEST_COMPARE(GblArenaAllocator_largePageCount(pArena), 0);
+    GBL_TEST_COMPARE(GblArenaAllocator_warmPageCount(pArena), 1);
+
+    GBL_CTX_VERIFY_CALL(GblThreadArena_release());
+
+    GBL_CTX_END();
+}
+
 GBL_EXPORT GblType GblArenaAllocatorTestSuite_type(void) {
     static GblType type = GBL_INVALID_TYPE;
 
@@ -151,10 +297,14 @@ GBL_EXPORT GblType GblArenaAllocatorTestSuite_type(void) {
         { "alloc",          GblArenaAllocatorTestSuite_alloc_        },
         { "allocNewPage",   GblArenaAllocatorTestSuite_allocNewPage_ },
         { "allocAligned",   GblArenaAllocatorTestSuite_allocAligned_ },
-        { "allocFail",      GblArenaAllocatorTestSuite_allocFail_    },
+        { "allocLarge",     GblArenaAllocatorTestSuite_allocLarge_   },
         { "saveLoadState",  GblArenaAllocatorTestSuite_saveLoadState_},
         { "freeAll",        GblArenaAllocatorTestSuite_freeAll_      },
         { "destruct",       GblArenaAllocatorTestSuite_destruct_     },
+        { "warmPages",      GblArenaAllocatorTestSuite_warmPages_    },
+        { "largeLoadState", GblArenaAllocatorTestSuite_largeLoadState_ },
+        { "mmap",           GblArenaAllocatorTestSuite_mmap_         },
+        { "threadArena",    GblArenaAllocatorTestSuite_threadArena_  },
         { NULL,             NULL                                     }
     };
 
@@ -4,6 +4,11 @@
 #include <gimbal/containers/gimbal_array_list.h>
 #include <gimbal/containers/gimbal_doubly_linked_list.h>
 #include <gimbal/algorithms/gimbal_numeric.h>
+#include <tinycthread.h>
+
+#define GBL_POOL_ALLOCATOR_TEST_THREADS_        4
+#define GBL_POOL_ALLOCATOR_TEST_THREAD_ENTRIES_ 256
+#define GBL_POOL_ALLOCATOR_TEST_THREAD_ROUNDS_  64
 
 #define GBL_POOL_ALLOCATOR_TEST_SUITE_(inst)   (GBL_PRIVATE(GblPoolAllocatorTestSuite, inst))
 
@@ -209,6 +214,167 @@ static GBL_RESULT GblPoolAllocatorTestSuite_destruct_(GblTestSuite* pSelf, GblCo
     GBL_CTX_END();
 }
 
+static GBL_RESULT GblPoolAllocatorTestSuite_bulk_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+    GblPoolAllocator pool;
+    void*            entries[20];
+
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_construct(&pool, sizeof(GblVariantList_), 8));
+
+    GBL_TEST_COMPARE(GblPoolAllocator_newN(&pool, entries, 20), 20);
+    GBL_TEST_COMPARE(GblPoolAllocator_activeCount(&pool), 20);
+    GBL_TEST_COMPARE(GblArenaAllocator_pageCount(&pool.arena), 3);
+
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_deleteN(&pool, entries, 20));
+    GBL_TEST_COMPARE(GblPoolAllocator_freeListSize(&pool), 20);
+    GBL_TEST_COMPARE(GblPoolAllocator_activeCount(&pool), 0);
+
+    // recycled rather than carved out of the arena again
+    GBL_TEST_COMPARE(GblPoolAllocator_newN(&pool, entries, 12), 12);
+    GBL_TEST_COMPARE(GblPoolAllocator_freeListSize(&pool), 8);
+    GBL_TEST_COMPARE(GblPoolAllocator_activeCount(&pool), 12);
+    GBL_TEST_COMPARE(pool.arena.allocCount, 20);
+
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_destruct(&pool));
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblPoolAllocatorTestSuite_reclaim_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+    GblPoolAllocator pool;
+    void*            entries[16];
+    size_t           pages = 0;
+
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_construct(&pool, sizeof(GblVariantList_), 4));
+
+    GBL_TEST_COMPARE(GblPoolAllocator_newN(&pool, entries, 16), 16);
+    GBL_TEST_COMPARE(GblArenaAllocator_pageCount(&pool.arena), 4);
+
+    // nothing to give back while every page still has live entries
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_delete(&pool, entries[1]));
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_delete(&pool, entries[6]));
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_reclaim(&pool, &pages));
+    GBL_TEST_COMPARE(pages, 0);
+    GBL_TEST_COMPARE(GblPoolAllocator_freeListSize(&pool), 2);
+
+    // empty the first two pages
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_deleteN(&pool, &entries[2], 4));
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_delete(&pool, entries[0]));
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_delete(&pool, entries[7]));
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_reclaim(&pool, &pages));
+    GBL_TEST_COMPARE(pages, 2);
+    GBL_TEST_COMPARE(GblArenaAllocator_pageCount(&pool.arena), 2);
+    GBL_TEST_COMPARE(GblPoolAllocator_freeListSize(&pool), 0);
+    GBL_TEST_COMPARE(GblPoolAllocator_activeCount(&pool), 8);
+    GBL_TEST_COMPARE(pool.arena.allocCount, 8);
+
+    // the active page is rewound rather than freed
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_deleteN(&pool, &entries[8], 8));
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_reclaim(&pool, &pages));
+    GBL_TEST_COMPARE(pages, 2);
+    GBL_TEST_COMPARE(GblArenaAllocator_pageCount(&pool.arena), 1);
+    GBL_TEST_COMPARE(GblArenaAllocator_bytesUsed(&pool.arena), 0);
+    GBL_TEST_COMPARE(GblPoolAllocator_freeListSize(&pool), 0);
+
+    GBL_TEST_COMPARE(GblPoolAllocator_newN(&pool, entries, 4), 4);
+    GBL_TEST_COMPARE(GblArenaAllocator_pageCount(&pool.arena), 1);
+
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_destruct(&pool));
+
+    GBL_CTX_END();
+}
+
+static int GblPoolAllocatorTestSuite_threadChurn_(void* pData) {
+    GblPoolAllocator* pPool = pData;
+    uintptr_t*        entries[GBL_POOL_ALLOCATOR_TEST_THREAD_ENTRIES_];
+    int               errors = 0;
+
+    for(size_t r = 0; r < GBL_POOL_ALLOCATOR_TEST_THREAD_ROUNDS_; ++r) {
+        const size_t half = GBL_POOL_ALLOCATOR_TEST_THREAD_ENTRIES_ / 2;
+
+        if(GblPoolAllocator_newN(pPool, (void**)entries, half) != half)
+            return -1;
+
+        for(size_t e = half; e < GBL_POOL_ALLOCATOR_TEST_THREAD_ENTRIES_; ++e)
+            if(!(entries[e] = GblPoolAllocator_new(pPool)))
+                return -1;
+
+        for(size_t e = 0; e < GBL_POOL_ALLOCATOR_TEST_THREAD_ENTRIES_; ++e)
+            entries[e][1] = (uintptr_t)&entries[e];
+
+        for(size_t e = 0; e < GBL_POOL_ALLOCATOR_TEST_THREAD_ENTRIES_; ++e)
+            if(entries[e][1] != (uintptr_t)&entries[e])
+                ++errors;
+
+        GblPoolAllocator_deleteN(pPool, (void* const*)entries, half);
+        for(size_t e = half; e < GBL_POOL_ALLOCATOR_TEST_THREAD_ENTRIES_; ++e)
+            GblPoolAllocator_delete(pPool, entries[e]);
+    }
+
+    return errors;
+}
+
+static int GblPoolAllocatorTestSuite_threadDelete_(void* pData) {
+    GblPoolAllocator* pPool   = ((void**)pData)[0];
+    void**            entries = ((void**)pData)[1];
+
+    GblPoolAllocator_deleteN(pPool, entries, GBL_POOL_ALLOCATOR_TEST_THREAD_ENTRIES_);
+    return 0;
+}
+
+static GBL_RESULT GblPoolAllocatorTestSuite_concurrent_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+    GblPoolAllocator pool;
+    thrd_t           threads[GBL_POOL_ALLOCATOR_TEST_THREADS_];
+    size_t           pages = 0;
+
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_construct(&pool,
+                                                   sizeof(GblVariantList_),
+                                                   64,
+                                                   0,
+                                                   GBL_NULL,
+                                                   pCtx,
+                                                   GBL_POOL_ALLOCATOR_FLAG_CONCURRENT));
+
+    for(size_t t = 0; t < GBL_POOL_ALLOCATOR_TEST_THREADS_; ++t)
+        GBL_TEST_COMPARE(thrd_create(&threads[t], GblPoolAllocatorTestSuite_threadChurn_, &pool),
+                         thrd_success);
+
+    for(size_t t = 0; t < GBL_POOL_ALLOCATOR_TEST_THREADS_; ++t) {
+        int errors = -1;
+        thrd_join(threads[t], &errors);
+        GBL_TEST_COMPARE(errors, 0);
+    }
+
+    // every thread's magazine was handed back as it exited
+    GBL_TEST_COMPARE(GblPoolAllocator_activeCount(&pool), 0);
+    GBL_TEST_COMPARE(GblPoolAllocator_freeListSize(&pool), pool.arena.allocCount);
+
+    // entries deleted by another thread than the one which allocated them
+    void* entries[GBL_POOL_ALLOCATOR_TEST_THREAD_ENTRIES_];
+    void* args[] = { &pool, entries };
+
+    GBL_TEST_COMPARE(GblPoolAllocator_newN(&pool, entries, GBL_POOL_ALLOCATOR_TEST_THREAD_ENTRIES_),
+                     GBL_POOL_ALLOCATOR_TEST_THREAD_ENTRIES_);
+    GBL_TEST_COMPARE(GblPoolAllocator_activeCount(&pool), GBL_POOL_ALLOCATOR_TEST_THREAD_ENTRIES_);
+    GBL_TEST_COMPARE(thrd_create(&threads[0], GblPoolAllocatorTestSuite_threadDelete_, args), thrd_success);
+    thrd_join(threads[0], NULL);
+    GBL_TEST_COMPARE(GblPoolAllocator_activeCount(&pool), 0);
+
+    const size_t pageCount = GblArenaAllocator_pageCount(&pool.arena);
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_reclaim(&pool, &pages));
+    GBL_TEST_COMPARE(pages, pageCount);
+    GBL_TEST_COMPARE(GblArenaAllocator_pageCount(&pool.arena), 1);
+    GBL_TEST_COMPARE(GblPoolAllocator_freeListSize(&pool), 0);
+
+    GBL_CTX_VERIFY_CALL(GblPoolAllocator_destruct(&pool));
+
+    GBL_CTX_END();
+}
 
 GBL_EXPORT GblType GblPoolAllocatorTestSuite_type(void) {
     static GblType type = GBL_INVALID_TYPE;
@@ -222,6 +388,9 @@ GBL_EXPORT GblType GblPoolAllocatorTestSuite_type(void) {
         { "overflowPage",      GblPoolAllocatorTestSuite_overflowPage_      },
         { "renewAllOverflow",  GblPoolAllocatorTestSuite_renewAllOverflow_  },
         { "destruct",          GblPoolAllocatorTestSuite_destruct_          },
+        { "bulk",              GblPoolAllocatorTestSuite_bulk_              },
+        { "reclaim",           GblPoolAllocatorTestSuite_reclaim_           },
+        { "concurrent",        GblPoolAllocatorTestSuite_concurrent_        },
         { NULL,             NULL                                            }
     };
 
@@ -0,0 +1,399 @@
+#include "allocators/gimbal_slab_allocator_test_suite.h"
+#include <gimbal/test/gimbal_test_macros.h>
+#include <gimbal/allocators/gimbal_slab_allocator.h>
+#include <gimbal/containers/gimbal_array_list.h>
+#include <gimbal/algorithms/gimbal_random.h>
+#include <gimbal/utils/gimbal_timer.h>
+
+#include <tinycthread.h>
+#include <stdatomic.h>
+
+#define GBL_SELF_TYPE GblSlabAllocatorTestSuite
+
+#define GBL_SLAB_ALLOCATOR_TEST_ENTRIES_        4096
+#define GBL_SLAB_ALLOCATOR_TEST_THREADS_        4
+#define GBL_SLAB_ALLOCATOR_TEST_THREAD_ALLOCS_  20000
+#define GBL_SLAB_ALLOCATOR_TEST_PROFILE_OPS_    200000
+#define GBL_SLAB_ALLOCATOR_TEST_PROFILE_LIVE_   1024
+
+GBL_TEST_FIXTURE {
+    GblSlabAllocator* pSlab;
+    GblIAllocator*    pAlloc;
+    void*             pEntries[GBL_SLAB_ALLOCATOR_TEST_ENTRIES_];
+    size_t            sizes[GBL_SLAB_ALLOCATOR_TEST_ENTRIES_];
+};
+
+// Shared by the threads of the concurrent test case
+typedef struct ThreadContext_ {
+    GblIAllocator* pAlloc;
+    atomic_int*    pErrors;
+    void**         ppSurvivors;   // left for the main thread to free
+    unsigned       seed;
+} ThreadContext_;
+
+GBL_TEST_INIT()
+    pFixture->pSlab  = GblSlabAllocator_create(GBL_SLAB_ALLOCATOR_FLAG_STATS);
+    pFixture->pAlloc = GBL_IALLOCATOR(pFixture->pSlab);
+GBL_TEST_CASE_END
+
+GBL_TEST_FINAL()
+    GBL_TEST_COMPARE(GblSlabAllocator_unref(pFixture->pSlab), 0);
+GBL_TEST_CASE_END
+
+static GblSlabAllocatorStats stats_(GblTestFixture* pFixture) {
+    GblSlabAllocatorStats stats;
+    GblSlabAllocator_stats(pFixture->pSlab, &stats);
+    return stats;
+}
+
+GBL_TEST_CASE(create)
+    GBL_TEST_VERIFY(GBL_TYPECHECK(GblIAllocator, pFixture->pSlab));
+    GBL_TEST_VERIFY(GBL_TYPECHECK(GblObject, pFixture->pSlab));
+    GBL_TEST_COMPARE(GblSlabAllocator_flags(pFixture->pSlab), GBL_SLAB_ALLOCATOR_FLAG_STATS);
+
+    const GblSlabAllocatorStats stats = stats_(pFixture);
+    GBL_TEST_COMPARE(stats.allocs, 0);
+    GBL_TEST_COMPARE(stats.slabs, 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(classSize)
+    GBL_TEST_COMPARE(GblSlabAllocator_classSize(0), 16);
+    GBL_TEST_COMPARE(GblSlabAllocator_classSize(1), 16);
+    GBL_TEST_COMPARE(GblSlabAllocator_classSize(16), 16);
+    GBL_TEST_COMPARE(GblSlabAllocator_classSize(17), 32);
+    GBL_TEST_COMPARE(GblSlabAllocator_classSize(128), 128);
+    GBL_TEST_COMPARE(GblSlabAllocator_classSize(129), 160);
+    GBL_TEST_COMPARE(GblSlabAllocator_classSize(256), 256);
+    GBL_TEST_COMPARE(GblSlabAllocator_classSize(257), 320);
+    GBL_TEST_COMPARE(GblSlabAllocator_classSize(1000), 1024);
+    GBL_TEST_COMPARE(GblSlabAllocator_classSize(GBL_SLAB_ALLOCATOR_CLASS_SIZE_MAX),
+                     GBL_SLAB_ALLOCATOR_CLASS_SIZE_MAX);
+    GBL_TEST_COMPARE(GblSlabAllocator_classSize(GBL_SLAB_ALLOCATOR_CLASS_SIZE_MAX + 1), 0);
+
+    // every size maps to the smallest class which fits it
+    size_t prev = 0;
+    for(size_t s = 1; s <= GBL_SLAB_ALLOCATOR_CLASS_SIZE_MAX; ++s) {
+        const size_t classSize = GblSlabAllocator_classSize(s);
+        GBL_TEST_VERIFY(classSize >= s);
+        GBL_TEST_VERIFY(s == 1 || prev == classSize || prev == s - 1);
+        prev = classSize;
+    }
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(allocInvalid)
+    void* pData = NULL;
+
+    GBL_TEST_EXPECT_ERROR();
+    GBL_TEST_COMPARE(GblIAllocator_alloc(pFixture->pAlloc, NULL, 0, 0, NULL, &pData),
+                     GBL_RESULT_ERROR_INVALID_ARG);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_TEST_EXPECT_ERROR();
+    GBL_TEST_COMPARE(GblIAllocator_alloc(pFixture->pAlloc, NULL, 32, 0, NULL, NULL),
+                     GBL_RESULT_ERROR_INVALID_POINTER);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_TEST_CALL(GblIAllocator_free(pFixture->pAlloc, NULL, NULL));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(allocFree)
+    for(size_t e = 0; e < GBL_SLAB_ALLOCATOR_TEST_ENTRIES_; ++e) {
+        pFixture->sizes[e] = gblRandEquilikely(1, 2048);
+        GBL_TEST_CALL(GblIAllocator_alloc(pFixture->pAlloc, NULL, pFixture->sizes[e], 0, NULL, &pFixture->pEntries[e]));
+        GBL_TEST_VERIFY(!((uintptr_t)pFixture->pEntries[e] % GBL_ALLOC_MIN_SIZE));
+        memset(pFixture->pEntries[e], (int)(e & 0xff), pFixture->sizes[e]);
+    }
+
+    GblSlabAllocatorStats stats = stats_(pFixture);
+    GBL_TEST_COMPARE(stats.allocs, GBL_SLAB_ALLOCATOR_TEST_ENTRIES_);
+    GBL_TEST_COMPARE(stats.largeAllocs, 0);
+    GBL_TEST_VERIFY(stats.slabs > 0);
+    GBL_TEST_VERIFY(stats.refills > 0);
+
+    size_t bytes = 0;
+    for(size_t e = 0; e < GBL_SLAB_ALLOCATOR_TEST_ENTRIES_; ++e)
+        bytes += GblSlabAllocator_classSize(pFixture->sizes[e]);
+    GBL_TEST_COMPARE(stats.bytesActive, bytes);
+
+    // no entry was overwritten by another
+    for(size_t e = 0; e < GBL_SLAB_ALLOCATOR_TEST_ENTRIES_; ++e) {
+        const uint8_t* pBytes = pFixture->pEntries[e];
+        for(size_t b = 0; b < pFixture->sizes[e]; ++b)
+            if(pBytes[b] != (e & 0xff)) GBL_TEST_VERIFY(GBL_FALSE);
+    }
+
+    for(size_t e = 0; e < GBL_SLAB_ALLOCATOR_TEST_ENTRIES_; ++e)
+        GBL_TEST_CALL(GblIAllocator_free(pFixture->pAlloc, NULL, pFixture->pEntries[e]));
+
+    stats = stats_(pFixture);
+    GBL_TEST_COMPARE(stats.frees, GBL_SLAB_ALLOCATOR_TEST_ENTRIES_);
+    GBL_TEST_COMPARE(stats.bytesActive, 0);
+    GBL_TEST_VERIFY(stats.flushes > 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(recycle)
+    void* pFirst  = NULL;
+    void* pSecond = NULL;
+
+    GBL_TEST_CALL(GblIAllocator_alloc(pFixture->pAlloc, NULL, 40, 0, NULL, &pFirst));
+    GBL_TEST_CALL(GblIAllocator_free(pFixture->pAlloc, NULL, pFirst));
+    GBL_TEST_CALL(GblIAllocator_alloc(pFixture->pAlloc, NULL, 48, 0, NULL, &pSecond));
+    GBL_TEST_COMPARE(pFirst, pSecond);
+    GBL_TEST_CALL(GblIAllocator_free(pFixture->pAlloc, NULL, pSecond));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(flushCache)
+    GBL_TEST_CALL(GblSlabAllocator_flushCache(pFixture->pSlab));
+
+    // everything's free, so at most one spare slab is kept per size class
+    const GblSlabAllocatorStats stats = stats_(pFixture);
+    GBL_TEST_VERIFY(stats.slabs > 0);
+    GBL_TEST_VERIFY(stats.slabs <= GBL_SLAB_ALLOCATOR_CLASS_COUNT);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(align)
+    const size_t aligns[] = { 32, 64 };
+
+    for(size_t a = 0; a < GBL_COUNT_OF(aligns); ++a) {
+        for(size_t e = 0; e < 256; ++e) {
+            GBL_TEST_CALL(GblIAllocator_alloc(pFixture->pAlloc, NULL, e + 1, aligns[a], NULL, &pFixture->pEntries[e]));
+            GBL_TEST_VERIFY(!((uintptr_t)pFixture->pEntries[e] % aligns[a]));
+        }
+
+        for(size_t e = 0; e < 256; ++e)
+            GBL_TEST_CALL(GblIAllocator_free(pFixture->pAlloc, NULL, pFixture->pEntries[e]));
+    }
+
+    GBL_TEST_COMPARE(stats_(pFixture).largeAllocs, 0);
+
+    // too strict for a size class
+    void* pData = NULL;
+    GBL_TEST_CALL(GblIAllocator_alloc(pFixture->pAlloc, NULL, 256, 256, NULL, &pData));
+    GBL_TEST_VERIFY(!((uintptr_t)pData % 256));
+    GBL_TEST_COMPARE(stats_(pFixture).largeAllocs, 1);
+    GBL_TEST_CALL(GblIAllocator_free(pFixture->pAlloc, NULL, pData));
+    GBL_TEST_COMPARE(stats_(pFixture).largeFrees, 1);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(large)
+    void* pData = NULL;
+
+    GBL_TEST_CALL(GblIAllocator_alloc(pFixture->pAlloc, NULL, 100000, 0, NULL, &pData));
+    memset(pData, 0xab, 100000);
+    GBL_TEST_COMPARE(stats_(pFixture).largeAllocs, 2);
+    GBL_TEST_CALL(GblIAllocator_free(pFixture->pAlloc, NULL, pData));
+    GBL_TEST_COMPARE(stats_(pFixture).largeFrees, 2);
+
+    // pointers which never came from the allocator go back to the system
+    pData = GBL_ALIGNED_ALLOC(GBL_ALLOC_MIN_SIZE, 64);
+    GBL_TEST_CALL(GblIAllocator_free(pFixture->pAlloc, NULL, pData));
+    GBL_TEST_COMPARE(stats_(pFixture).largeFrees, 3);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(realloc)
+    char* pData = NULL;
+    char* pNew  = NULL;
+
+    GBL_TEST_CALL(GblIAllocator_realloc(pFixture->pAlloc, NULL, NULL, 20, 0, (void**)&pData));
+    strcpy(pData, "slab allocator");
+
+    // same size class
+    GBL_TEST_CALL(GblIAllocator_realloc(pFixture->pAlloc, NULL, pData, 30, 0, (void**)&pNew));
+    GBL_TEST_COMPARE(pNew, pData);
+
+    // next size class
+    GBL_TEST_CALL(GblIAllocator_realloc(pFixture->pAlloc, NULL, pNew, 1000, 0, (void**)&pData));
+    GBL_TEST_VERIFY(pNew != pData);
+    GBL_TEST_COMPARE(pData, "slab allocator");
+
+    // into and within the system allocator
+    GBL_TEST_CALL(GblIAllocator_realloc(pFixture->pAlloc, NULL, pData, 50000, 0, (void**)&pNew));
+    GBL_TEST_COMPARE(pNew, "slab allocator");
+    GBL_TEST_CALL(GblIAllocator_realloc(pFixture->pAlloc, NULL, pNew, 100000, 0, (void**)&pData));
+    GBL_TEST_COMPARE(pData, "slab allocator");
+
+    GBL_TEST_CALL(GblIAllocator_free(pFixture->pAlloc, NULL, pData));
+GBL_TEST_CASE_END
+
+static int threadAlloc_(void* pArg) {
+    ThreadContext_* pContext = pArg;
+    void*           pLocal[64];
+    unsigned        seed     = pContext->seed;
+
+    for(size_t a = 0; a < GBL_SLAB_ALLOCATOR_TEST_THREAD_ALLOCS_; ++a) {
+        const size_t size = 1 + (seed = seed * 1103515245u + 12345u) % 512;
+        const size_t slot = a % GBL_COUNT_OF(pLocal);
+        void*        pData = NULL;
+
+        if(a >= GBL_COUNT_OF(pLocal)) {
+            if(*(size_t*)pLocal[slot] != (uintptr_t)pLocal[slot])
+                atomic_fetch_add(pContext->pErrors, 1);
+
+            GblIAllocator_free(pContext->pAlloc, NULL, pLocal[slot]);
+        }
+
+        if(!GBL_RESULT_SUCCESS(GblIAllocator_alloc(pContext->pAlloc, NULL, size < sizeof(size_t)? sizeof(size_t) : size, 0, NULL, &pData)))
+            atomic_fetch_add(pContext->pErrors, 1);
+
+        *(size_t*)pData = (uintptr_t)pData;
+        pLocal[slot]    = pData;
+    }
+
+    // hand the rest over to be freed by another thread
+    for(size_t s = 0; s < GBL_COUNT_OF(pLocal); ++s)
+        pContext->ppSurvivors[s] = pLocal[s];
+
+    return 0;
+}
+
+GBL_TEST_CASE(threads)
+    thrd_t                threads [GBL_SLAB_ALLOCATOR_TEST_THREADS_];
+    ThreadContext_        contexts[GBL_SLAB_ALLOCATOR_TEST_THREADS_];
+    atomic_int            errors = 0;
+    GblSlabAllocatorStats before = stats_(pFixture);
+
+    for(size_t t = 0; t < GBL_SLAB_ALLOCATOR_TEST_THREADS_; ++t) {
+        contexts[t] = (ThreadContext_){ pFixture->pAlloc, &errors, &pFixture->pEntries[t * 64], (unsigned)t + 1 };
+        GBL_TEST_COMPARE(thrd_create(&threads[t], threadAlloc_, &contexts[t]), thrd_success);
+    }
+
+    for(size_t t = 0; t < GBL_SLAB_ALLOCATOR_TEST_THREADS_; ++t)
+        thrd_join(threads[t], NULL);
+
+    GBL_TEST_COMPARE(atomic_load(&errors), 0);
+
+    for(size_t e = 0; e < GBL_SLAB_ALLOCATOR_TEST_THREADS_ * 64; ++e)
+        GBL_TEST_CALL(GblIAllocator_free(pFixture->pAlloc, NULL, pFixture->pEntries[e]));
+
+    // exited threads' caches have been returned, and their counters retired
+    const GblSlabAllocatorStats after = stats_(pFixture);
+    GBL_TEST_COMPARE(after.allocs - before.allocs,
+                     GBL_SLAB_ALLOCATOR_TEST_THREADS_ * GBL_SLAB_ALLOCATOR_TEST_THREAD_ALLOCS_);
+    GBL_TEST_COMPARE(after.frees - before.frees,
+                     GBL_SLAB_ALLOCATOR_TEST_THREADS_ * GBL_SLAB_ALLOCATOR_TEST_THREAD_ALLOCS_);
+    GBL_TEST_COMPARE(after.bytesActive, 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(context)
+    GblContext*  pSlabCtx = GBL_NEW(GblContext);
+    GblArrayList list;
+
+    GBL_TEST_COMPARE(GblContext_allocator(pSlabCtx), NULL);
+    GblContext_setAllocator(pSlabCtx, pFixture->pAlloc);
+    GBL_TEST_COMPARE(GblContext_allocator(pSlabCtx), pFixture->pAlloc);
+
+    const GblSlabAllocatorStats before = stats_(pFixture);
+
+    GBL_TEST_CALL(GblArrayList_construct(&list, sizeof(uint32_t), 0, NULL, sizeof(GblArrayList), GBL_FALSE, pSlabCtx));
+
+    for(uint32_t i = 0; i < 10000; ++i)
+        GBL_TEST_CALL(GblArrayList_pushBack(&list, &i));
+
+    for(uint32_t i = 0; i < 10000; ++i)
+        GBL_TEST_COMPARE(*(uint32_t*)GblArrayList_at(&list, i), i);
+
+    GBL_TEST_CALL(GblArrayList_destruct(&list));
+
+    // grew through the size classes, then spilled over to the system
+    const GblSlabAllocatorStats after = stats_(pFixture);
+    GBL_TEST_VERIFY(after.allocs > before.allocs);
+    GBL_TEST_COMPARE(after.allocs - before.allocs, after.frees - before.frees);
+    GBL_TEST_COMPARE(after.largeAllocs - before.largeAllocs, 1);
+    GBL_TEST_COMPARE(after.largeFrees - before.largeFrees, 1);
+
+    GblContext_setAllocator(pSlabCtx, NULL);
+    GBL_TEST_COMPARE(GBL_UNREF(pSlabCtx), 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(parent)
+    GblSlabAllocator*     pChild = GblSlabAllocator_create(GBL_SLAB_ALLOCATOR_FLAG_STATS);
+    GblSlabAllocatorStats stats;
+    void*                 pData  = NULL;
+
+    GblObject_setParent(GBL_OBJECT(pChild), GBL_OBJECT(pFixture->pSlab));
+    GBL_TEST_COMPARE(GblIAllocator_parent(GBL_IALLOCATOR(pChild)), pFixture->pAlloc);
+
+    const GblSlabAllocatorStats before = stats_(pFixture);
+
+    // large requests are passed up to the parent rather than the system
+    GBL_TEST_CALL(GblIAllocator_alloc(GBL_IALLOCATOR(pChild), NULL, 100000, 0, NULL, &pData));
+    GBL_TEST_COMPARE(stats_(pFixture).largeAllocs - before.largeAllocs, 1);
+
+    GBL_TEST_CALL(GblIAllocator_realloc(GBL_IALLOCATOR(pChild), NULL, pData, 200000, 0, &pData));
+    memset(pData, 0xab, 200000);
+
+    GBL_TEST_CALL(GblIAllocator_free(GBL_IALLOCATOR(pChild), NULL, pData));
+    GBL_TEST_COMPARE(stats_(pFixture).largeFrees - before.largeFrees, 1);
+
+    // so are pointers the parent handed out before, which the child never saw
+    GBL_TEST_CALL(GblIAllocator_alloc(pFixture->pAlloc, NULL, 100000, 0, NULL, &pData));
+    GBL_TEST_CALL(GblIAllocator_free(GBL_IALLOCATOR(pChild), NULL, pData));
+    GBL_TEST_COMPARE(stats_(pFixture).largeFrees - before.largeFrees, 2);
+
+    GblSlabAllocator_stats(pChild, &stats);
+    GBL_TEST_COMPARE(stats.largeAllocs, 1);
+    GBL_TEST_COMPARE(stats.largeFrees, 2);
+
+    GblObject_setParent(GBL_OBJECT(pChild), NULL);
+    GBL_TEST_COMPARE(GblSlabAllocator_unref(pChild), 0);
+GBL_TEST_CASE_END
+
+static GBL_RESULT profileChurn_(GblContext* pCtx, void** ppLive, double* pMs) {
+    GblTimer timer;
+    unsigned seed = 1;
+
+    GBL_CTX_BEGIN(pCtx);
+
+    memset(ppLive, 0, sizeof(void*) * GBL_SLAB_ALLOCATOR_TEST_PROFILE_LIVE_);
+
+    GblTimer_start(&timer);
+
+    for(size_t o = 0; o < GBL_SLAB_ALLOCATOR_TEST_PROFILE_OPS_; ++o) {
+        const size_t slot = (seed = seed * 1103515245u + 12345u) % GBL_SLAB_ALLOCATOR_TEST_PROFILE_LIVE_;
+
+        if(ppLive[slot])
+            GBL_CTX_FREE(ppLive[slot]);
+
+        ppLive[slot] = GBL_CTX_MALLOC(16 + (seed >> 8) % 240);
+    }
+
+    for(size_t s = 0; s < GBL_SLAB_ALLOCATOR_TEST_PROFILE_LIVE_; ++s)
+        GBL_CTX_FREE(ppLive[s]);
+
+    GblTimer_stop(&timer);
+    *pMs = GblTimer_elapsedMs(&timer);
+
+    GBL_CTX_END();
+}
+
+GBL_TEST_CASE(profile)
+    GblContext* pCtxs[2] = { GBL_NEW(GblContext), GBL_NEW(GblContext) };
+    double      ms[2];
+
+    GblContext_setAllocator(pCtxs[1], pFixture->pAlloc);
+
+    for(size_t c = 0; c < GBL_COUNT_OF(pCtxs); ++c)
+        GBL_TEST_CALL(profileChurn_(pCtxs[c], pFixture->pEntries, &ms[c]));
+
+    GBL_CTX_INFO("%-20s: %10.3lf ms", "Default context", ms[0]);
+    GBL_CTX_INFO("%-20s: %10.3lf ms", "Slab context", ms[1]);
+
+    GblContext_setAllocator(pCtxs[1], NULL);
+
+    for(size_t c = 0; c < GBL_COUNT_OF(pCtxs); ++c)
+        GBL_TEST_COMPARE(GBL_UNREF(pCtxs[c]), 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_REGISTER(create,
+                  classSize,
+                  allocInvalid,
+                  allocFree,
+                  recycle,
+                  flushCache,
+                  align,
+                  large,
+                  realloc,
+                  threads,
+                  context,
+                  parent,
+                  profile)
@@ -1,6 +1,7 @@
 #include "containers/gimbal_array_heap_test_suite.h"
 #include <gimbal/test/gimbal_test_macros.h>
 #include <gimbal/containers/gimbal_array_heap.h>
+#include <gimbal/utils/gimbal_timer.h>
 
 #define GBL_ARRAY_HEAP_TEST_SUITE_(inst)     (GBL_PRIVATE(GblArrayHeapTestSuite, inst))
 
@@ -248,6 +249,301 @@ static GBL_RESULT GblArrayHeapTestSuite_destroy_(GblTestSuite* pSelf, GblContext
     GBL_CTX_END();
 }
 
+typedef struct ArrayHeapEntry_ {
+    uint64_t key;
+    uint32_t id;
+} ArrayHeapEntry_;
+
+static int entryComparator_(const void* pV1, const void* pV2) {
+    const uint64_t key1 = ((const ArrayHeapEntry_*)pV1)->key;
+    const uint64_t key2 = ((const ArrayHeapEntry_*)pV2)->key;
+    return (key1 < key2) - (key1 > key2);
+}
+
+static uint64_t GblArrayHeapTestSuite_random_(uint64_t* pSeed) {
+    *pSeed ^= *pSeed << 13;
+    *pSeed ^= *pSeed >> 7;
+    *pSeed ^= *pSeed << 17;
+    return *pSeed;
+}
+
+// pops everything, verifying that keys come out lowest first
+static GBL_RESULT GblArrayHeapTestSuite_drain_(GblContext* pCtx, GblArrayHeap* pHeap, size_t expected) {
+    GBL_CTX_BEGIN(pCtx);
+
+    ArrayHeapEntry_ entry;
+    uint64_t        lastKey = 0;
+    size_t          count   = 0;
+
+    while(!GblArrayHeap_empty(pHeap)) {
+        const uint64_t peekKey = ((ArrayHeapEntry_*)GblArrayHeap_peek(pHeap))->key;
+
+        GBL_CTX_VERIFY_CALL(GblArrayHeap_pop(pHeap, &entry));
+        GBL_TEST_COMPARE(entry.key, peekKey);
+        GBL_TEST_VERIFY(entry.key >= lastKey);
+
+        lastKey = entry.key;
+        ++count;
+    }
+
+    GBL_TEST_COMPARE(count, expected);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblArrayHeapTestSuite_constructInvalid_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    GblArrayHeap heap;
+    GBL_RESULT   result;
+
+    GBL_TEST_EXPECT_ERROR();
+
+    result = GblArrayHeap_construct(&heap, sizeof(ArrayHeapEntry_), entryComparator_, sizeof(GblArrayHeap), pCtx, 1);
+    GBL_TEST_COMPARE(result, GBL_RESULT_ERROR_INVALID_ARG);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    result = GblArrayHeap_constructKeyed(&heap, sizeof(ArrayHeapEntry_), sizeof(ArrayHeapEntry_) - sizeof(uint32_t), GBL_ARRAY_HEAP_KEY_UINT64_MIN);
+    GBL_TEST_COMPARE(result, GBL_RESULT_ERROR_INVALID_ARG);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    result = GblArrayHeap_constructKeyed(&heap, sizeof(ArrayHeapEntry_), 0, GBL_ARRAY_HEAP_KEY_NONE);
+    GBL_TEST_COMPARE(result, GBL_RESULT_ERROR_INVALID_ARG);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblArrayHeapTestSuite_arity_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    static const size_t arities[] = { 0, 2, 3, 4, 8 };
+    uint64_t            seed      = 0x9e3779b97f4a7c15ull;
+
+    for(size_t a = 0; a < GBL_COUNT_OF(arities); ++a) {
+        for(size_t keyed = 0; keyed < 2; ++keyed) {
+            GblArrayHeap heap;
+
+            if(keyed)
+                GBL_CTX_VERIFY_CALL(GblArrayHeap_constructKeyed(&heap,
+                                                                sizeof(ArrayHeapEntry_),
+                                                                offsetof(ArrayHeapEntry_, key),
+                                                                GBL_ARRAY_HEAP_KEY_UINT64_MIN,
+                                                                sizeof(GblArrayHeap),
+                                                                pCtx,
+                                                                arities[a]));
+            else
+                GBL_CTX_VERIFY_CALL(GblArrayHeap_construct(&heap,
+                                                           sizeof(ArrayHeapEntry_),
+                                                           entryComparator_,
+                                                           sizeof(GblArrayHeap),
+                                                           pCtx,
+                                                           arities[a]));
+
+            GBL_TEST_COMPARE(GblArrayHeap_arity(&heap), arities[a]? arities[a] : GBL_ARRAY_HEAP_ARITY_DEFAULT);
+
+            for(uint32_t e = 0; e < GBL_ARRAY_HEAP_PROFILE_SIZE_; ++e) {
+                const ArrayHeapEntry_ entry = { GblArrayHeapTestSuite_random_(&seed) % 500, e };
+                GBL_CTX_VERIFY_CALL(GblArrayHeap_push(&heap, &entry));
+            }
+
+            // interleave pops with pushes
+            for(size_t e = 0; e < GBL_ARRAY_HEAP_PROFILE_SIZE_ / 2; ++e) {
+                const ArrayHeapEntry_ entry = { GblArrayHeapTestSuite_random_(&seed) % 500, 0 };
+                GBL_CTX_VERIFY_CALL(GblArrayHeap_pop(&heap, NULL));
+                GBL_CTX_VERIFY_CALL(GblArrayHeap_push(&heap, &entry));
+            }
+
+            GBL_CTX_VERIFY_CALL(GblArrayHeapTestSuite_drain_(pCtx, &heap, GBL_ARRAY_HEAP_PROFILE_SIZE_));
+            GBL_CTX_VERIFY_CALL(GblArrayHeap_destruct(&heap));
+        }
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblArrayHeapTestSuite_pushN_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    GblArrayHeap    heap;
+    ArrayHeapEntry_ entries[GBL_ARRAY_HEAP_PROFILE_SIZE_];
+    uint64_t        seed = 42;
+
+    for(uint32_t e = 0; e < GBL_ARRAY_HEAP_PROFILE_SIZE_; ++e) {
+        entries[e].key = GblArrayHeapTestSuite_random_(&seed) % 1000;
+        entries[e].id  = e;
+    }
+
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_construct(&heap, sizeof(ArrayHeapEntry_), entryComparator_));
+
+    // heapified
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_pushN(&heap, entries, GBL_ARRAY_HEAP_PROFILE_SIZE_ / 2));
+    GBL_TEST_COMPARE(GblArrayHeap_size(&heap), GBL_ARRAY_HEAP_PROFILE_SIZE_ / 2);
+
+    // sifted up one at a time
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_pushN(&heap, &entries[GBL_ARRAY_HEAP_PROFILE_SIZE_ / 2], 10));
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_pushN(&heap, entries, 0));
+    GBL_TEST_COMPARE(GblArrayHeap_size(&heap), GBL_ARRAY_HEAP_PROFILE_SIZE_ / 2 + 10);
+
+    GBL_CTX_VERIFY_CALL(GblArrayHeapTestSuite_drain_(pCtx, &heap, GBL_ARRAY_HEAP_PROFILE_SIZE_ / 2 + 10));
+
+    // adopting an unordered buffer
+    ArrayHeapEntry_* pData = GBL_CTX_MALLOC(sizeof(entries));
+    memcpy(pData, entries, sizeof(entries));
+
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_acquire(&heap, pData, GBL_ARRAY_HEAP_PROFILE_SIZE_, GBL_ARRAY_HEAP_PROFILE_SIZE_));
+    GBL_CTX_VERIFY_CALL(GblArrayHeapTestSuite_drain_(pCtx, &heap, GBL_ARRAY_HEAP_PROFILE_SIZE_));
+
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_destruct(&heap));
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblArrayHeapTestSuite_handles_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    GblArrayHeap       heap, heapCopy;
+    GblArrayHeapHandle handles[GBL_ARRAY_HEAP_PROFILE_SIZE_];
+    uint64_t           keys[GBL_ARRAY_HEAP_PROFILE_SIZE_];
+    GblBool            removed[GBL_ARRAY_HEAP_PROFILE_SIZE_] = { 0 };
+    uint64_t           seed = 7;
+    ArrayHeapEntry_    entry;
+
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_constructKeyed(&heap,
+                                                    sizeof(ArrayHeapEntry_),
+                                                    offsetof(ArrayHeapEntry_, key),
+                                                    GBL_ARRAY_HEAP_KEY_UINT64_MIN));
+
+    // untracked entries are given handles too, once tracking starts
+    entry.key = 500; entry.id = UINT32_MAX;
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_push(&heap, &entry));
+    GBL_TEST_VERIFY(!GblArrayHeap_tracking(&heap));
+
+    for(uint32_t e = 0; e < GBL_ARRAY_HEAP_PROFILE_SIZE_; ++e) {
+        entry.key = keys[e] = 1000 + GblArrayHeapTestSuite_random_(&seed) % 1000;
+        entry.id  = e;
+        GBL_CTX_VERIFY_CALL(GblArrayHeap_push(&heap, &entry, &handles[e]));
+    }
+    GBL_TEST_VERIFY(GblArrayHeap_tracking(&heap));
+
+    // decrease, increase, and remove
+    for(uint32_t e = 0; e < GBL_ARRAY_HEAP_PROFILE_SIZE_; ++e) {
+        ArrayHeapEntry_* pEntry = GblArrayHeap_at(&heap, handles[e]);
+        GBL_TEST_VERIFY(pEntry && pEntry->id == e && pEntry->key == keys[e]);
+
+        switch(e % 3) {
+        case 0:
+            entry.key = keys[e] = keys[e] - 1000 + 1;
+            entry.id  = e;
+            GBL_CTX_VERIFY_CALL(GblArrayHeap_update(&heap, handles[e], &entry));
+            break;
+        case 1:
+            entry.key = keys[e] = keys[e] + 1000;
+            entry.id  = e;
+            GBL_CTX_VERIFY_CALL(GblArrayHeap_update(&heap, handles[e], &entry));
+            break;
+        case 2:
+            GBL_CTX_VERIFY_CALL(GblArrayHeap_remove(&heap, handles[e], &entry));
+            GBL_TEST_COMPARE(entry.id, e);
+            removed[e] = GBL_TRUE;
+            break;
+        }
+    }
+
+    for(uint32_t e = 0; e < GBL_ARRAY_HEAP_PROFILE_SIZE_; ++e) {
+        if(removed[e]) continue;
+        const ArrayHeapEntry_* pEntry = GblArrayHeap_at(&heap, handles[e]);
+        GBL_TEST_VERIFY(pEntry && pEntry->id == e && pEntry->key == keys[e]);
+    }
+
+    // stale handles
+    GBL_TEST_EXPECT_ERROR();
+
+    GBL_TEST_COMPARE(GblArrayHeap_at(&heap, handles[2]), NULL);
+    GBL_TEST_COMPARE(GBL_CTX_LAST_RESULT(), GBL_RESULT_ERROR_INVALID_HANDLE);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    const GBL_RESULT result = GblArrayHeap_remove(&heap, GBL_ARRAY_HEAP_HANDLE_INVALID, NULL);
+    GBL_TEST_COMPARE(result, GBL_RESULT_ERROR_INVALID_HANDLE);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    // handles remain valid within a copy
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_construct(&heapCopy, sizeof(ArrayHeapEntry_), entryComparator_));
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_copy(&heapCopy, &heap));
+    GBL_TEST_COMPARE(((ArrayHeapEntry_*)GblArrayHeap_at(&heapCopy, handles[1]))->id, 1);
+
+    // freed handles get recycled
+    entry.key = 0; entry.id = 0;
+    GblArrayHeapHandle recycled;
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_push(&heap, &entry, &recycled));
+    GBL_TEST_VERIFY(recycled < GBL_ARRAY_HEAP_PROFILE_SIZE_ + 1);
+    GBL_TEST_COMPARE(GblArrayHeap_peek(&heap), GblArrayHeap_at(&heap, recycled));
+
+    const size_t size = GblArrayHeap_size(&heap);
+    GBL_CTX_VERIFY_CALL(GblArrayHeapTestSuite_drain_(pCtx, &heap, size));
+    GBL_CTX_VERIFY_CALL(GblArrayHeapTestSuite_drain_(pCtx, &heapCopy, size - 1));
+
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_destruct(&heapCopy));
+    GBL_CTX_VERIFY_CALL(GblArrayHeap_destruct(&heap));
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblArrayHeapTestSuite_profile_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    static const struct {
+        const char*        pName;
+        size_t             arity;
+        GBL_ARRAY_HEAP_KEY keyType;
+    } configs[] = {
+        { "binary, comparator", 2, GBL_ARRAY_HEAP_KEY_NONE       },
+        { "4-ary, comparator",  4, GBL_ARRAY_HEAP_KEY_NONE       },
+        { "binary, keyed",      2, GBL_ARRAY_HEAP_KEY_UINT64_MIN },
+        { "4-ary, keyed",       4, GBL_ARRAY_HEAP_KEY_UINT64_MIN }
+    };
+
+    for(size_t c = 0; c < GBL_COUNT_OF(configs); ++c) {
+        GblArrayHeap heap;
+        GblTimer     timer;
+        uint64_t     seed = 1234;
+
+        if(configs[c].keyType)
+            GBL_CTX_VERIFY_CALL(GblArrayHeap_constructKeyed(&heap,
+                                                            sizeof(ArrayHeapEntry_),
+                                                            offsetof(ArrayHeapEntry_, key),
+                                                            configs[c].keyType,
+                                                            sizeof(GblArrayHeap),
+                                                            pCtx,
+                                                            configs[c].arity));
+        else
+            GBL_CTX_VERIFY_CALL(GblArrayHeap_construct(&heap,
+                                                       sizeof(ArrayHeapEntry_),
+                                                       entryComparator_,
+                                                       sizeof(GblArrayHeap),
+                                                       pCtx,
+                                                       configs[c].arity));
+
+        GblTimer_start(&timer);
+        for(size_t e = 0; e < GBL_ARRAY_HEAP_PROFILE_SIZE_ * 64; ++e) {
+            const ArrayHeapEntry_ entry = { GblArrayHeapTestSuite_random_(&seed), 0 };
+            GBL_CTX_VERIFY_CALL(GblArrayHeap_push(&heap, &entry));
+        }
+        while(!GblArrayHeap_empty(&heap))
+            GBL_CTX_VERIFY_CALL(GblArrayHeap_pop(&heap, NULL));
+        GblTimer_stop(&timer);
+
+        GBL_CTX_INFO("%-20s: %10.3lf ms", configs[c].pName, GblTimer_elapsedMs(&timer));
+        GBL_CTX_VERIFY_CALL(GblArrayHeap_destruct(&heap));
+    }
+
+    GBL_CTX_END();
+}
 
 GBL_EXPORT GblType GblArrayHeapTestSuite_type(void) {
     static GblType type = GBL_INVALID_TYPE;
@@ -269,6 +565,11 @@ GBL_EXPORT GblType GblArrayHeapTestSuite_type(void) {
         { "clear",              GblArrayHeapTestSuite_clear_            },
         { "releaseAcquire",     GblArrayHeapTestSuite_releaseAcquire_   },
         { "destroy",            GblArrayHeapTestSuite_destroy_          },
+        { "constructInvalid",   GblArrayHeapTestSuite_constructInvalid_ },
+        { "arity",              GblArrayHeapTestSuite_arity_            },
+        { "pushN",              GblArrayHeapTestSuite_pushN_            },
+        { "handles",            GblArrayHeapTestSuite_handles_          },
+        { "profile",            GblArrayHeapTestSuite_profile_          },
         { NULL,                 NULL                                    }
     };
 
@@ -0,0 +1,374 @@
+#include "containers/gimbal_concurrent_hash_set_test_suite.h"
+#include <gimbal/test/gimbal_test_macros.h>
+#include <gimbal/containers/gimbal_concurrent_hash_set.h>
+#include <gimbal/algorithms/gimbal_hash.h>
+#include <gimbal/utils/gimbal_timer.h>
+
+#include <tinycthread.h>
+#include <stdatomic.h>
+
+#define GBL_SELF_TYPE GblConcurrentHashSetTestSuite
+
+#define GBL_CONCURRENT_HASH_SET_TEST_THREADS_           4
+#define GBL_CONCURRENT_HASH_SET_TEST_STRESS_KEYS_       4096    // keys owned by each thread
+#define GBL_CONCURRENT_HASH_SET_TEST_PROFILE_KEYS_      16384
+#define GBL_CONCURRENT_HASH_SET_TEST_PROFILE_OPS_       200000  // per thread, 1 in 10 being a write
+
+typedef struct Entry_ {
+    uintptr_t key;
+    uintptr_t value;
+} Entry_;
+
+GBL_TEST_FIXTURE {
+    GblConcurrentHashSet set;
+    size_t               dtorCount;
+    uintptr_t            dtorLastKey;
+};
+
+// Shared by the threads of a concurrent test case
+typedef struct ThreadContext_ {
+    GblConcurrentHashSet* pSet;
+    atomic_size_t*        pErrors;
+    uintptr_t             index;
+    size_t                ops;
+} ThreadContext_;
+
+static GblHash hasher_(const GblConcurrentHashSet* pSet, const void* pEntry) {
+    GBL_UNUSED(pSet);
+    return gblHash32Bit((uint32_t)((const Entry_*)pEntry)->key);
+}
+
+static GblBool comparator_(const GblConcurrentHashSet* pSet, const void* pEntry1, const void* pEntry2) {
+    GBL_UNUSED(pSet);
+    return ((const Entry_*)pEntry1)->key == ((const Entry_*)pEntry2)->key;
+}
+
+static void destructor_(const GblConcurrentHashSet* pSet, void* pEntry) {
+    GblConcurrentHashSetTestSuite_* pFixture = GblConcurrentHashSet_userdata(pSet);
+    pFixture->dtorLastKey = ((const Entry_*)pEntry)->key;
+    ++pFixture->dtorCount;
+}
+
+static GblBool increment_(const GblConcurrentHashSet* pSet, void* pEntry, void* pUdata) {
+    GBL_UNUSED(pSet);
+    ((Entry_*)pEntry)->value += (uintptr_t)pUdata;
+    return GBL_TRUE;
+}
+
+static GblBool sum_(const GblConcurrentHashSet* pSet, void* pEntry, void* pUdata) {
+    GBL_UNUSED(pSet);
+    *(uintptr_t*)pUdata += ((const Entry_*)pEntry)->value;
+    return GBL_TRUE;
+}
+
+static GblBool stopAtKey_(const GblConcurrentHashSet* pSet, void* pEntry, void* pUdata) {
+    GBL_UNUSED(pSet);
+    return ((const Entry_*)pEntry)->key != (uintptr_t)pUdata;
+}
+
+GBL_TEST_INIT_NONE
+GBL_TEST_FINAL_NONE
+
+GBL_TEST_CASE(construct)
+    GBL_TEST_CALL(GblConcurrentHashSet_construct(&pFixture->set,
+                                                 sizeof(Entry_),
+                                                 hasher_,
+                                                 comparator_,
+                                                 destructor_,
+                                                 0,
+                                                 pCtx,
+                                                 pFixture,
+                                                 3));
+
+    GBL_TEST_COMPARE(GblConcurrentHashSet_shardCount(&pFixture->set), 4);
+    GBL_TEST_COMPARE(GblConcurrentHashSet_context(&pFixture->set), pCtx);
+    GBL_TEST_COMPARE(GblConcurrentHashSet_userdata(&pFixture->set), pFixture);
+    GBL_TEST_VERIFY(GblConcurrentHashSet_empty(&pFixture->set));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(getInvalid)
+    Entry_ entry = { 1, 0 };
+
+    GBL_TEST_VERIFY(!GblConcurrentHashSet_get(&pFixture->set, &entry, &entry));
+    GBL_TEST_VERIFY(!GblConcurrentHashSet_contains(&pFixture->set, &entry));
+    GBL_TEST_COMPARE(GblConcurrentHashSet_count(&pFixture->set, &entry), 0);
+
+    GBL_TEST_EXPECT_ERROR();
+    GBL_TEST_VERIFY(!GblConcurrentHashSet_get(&pFixture->set, NULL, &entry));
+    GBL_TEST_COMPARE(GBL_CTX_LAST_RESULT(), GBL_RESULT_ERROR_INVALID_POINTER);
+    GBL_CTX_CLEAR_LAST_RECORD();
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(insert)
+    for(uintptr_t k = 0; k < 100; ++k) {
+        Entry_ entry = { k, k * 10 };
+        GBL_TEST_VERIFY(GblConcurrentHashSet_insert(&pFixture->set, &entry));
+    }
+
+    Entry_ duplicate = { 7, 0 };
+    GBL_TEST_VERIFY(!GblConcurrentHashSet_insert(&pFixture->set, &duplicate));
+
+    GBL_TEST_COMPARE(GblConcurrentHashSet_size(&pFixture->set), 100);
+
+    for(uintptr_t k = 0; k < 100; ++k) {
+        Entry_ entry = { k, 0 };
+        GBL_TEST_VERIFY(GblConcurrentHashSet_get(&pFixture->set, &entry, &entry));
+        GBL_TEST_COMPARE(entry.value, k * 10);
+        GBL_TEST_COMPARE(GblConcurrentHashSet_count(&pFixture->set, &entry), 1);
+    }
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(set)
+    Entry_ entry = { 5, 555 };
+    Entry_ prev  = { 0, 0 };
+
+    GBL_TEST_VERIFY(GblConcurrentHashSet_set(&pFixture->set, &entry, &prev));
+    GBL_TEST_COMPARE(prev.key, 5);
+    GBL_TEST_COMPARE(prev.value, 50);
+
+    entry.key = 100;
+    GBL_TEST_VERIFY(!GblConcurrentHashSet_set(&pFixture->set, &entry));
+
+    GBL_TEST_COMPARE(GblConcurrentHashSet_size(&pFixture->set), 101);
+    GBL_TEST_COMPARE(pFixture->dtorCount, 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(insertOrAssign)
+    Entry_ entry = { 5, 5 };
+
+    GblConcurrentHashSet_insertOrAssign(&pFixture->set, &entry);
+
+    GBL_TEST_COMPARE(pFixture->dtorCount, 1);
+    GBL_TEST_COMPARE(pFixture->dtorLastKey, 5);
+
+    GBL_TEST_VERIFY(GblConcurrentHashSet_get(&pFixture->set, &entry, &entry));
+    GBL_TEST_COMPARE(entry.value, 5);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(visit)
+    Entry_ entry = { 5, 0 };
+
+    GBL_TEST_VERIFY(GblConcurrentHashSet_visit(&pFixture->set, &entry, increment_, (void*)(uintptr_t)3));
+    GBL_TEST_VERIFY(GblConcurrentHashSet_get(&pFixture->set, &entry, &entry));
+    GBL_TEST_COMPARE(entry.value, 8);
+
+    entry.key = 1000;
+    GBL_TEST_VERIFY(!GblConcurrentHashSet_visit(&pFixture->set, &entry, increment_, NULL));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(extract)
+    Entry_ entry = { 100, 0 };
+
+    GBL_TEST_VERIFY(GblConcurrentHashSet_extract(&pFixture->set, &entry, &entry));
+    GBL_TEST_COMPARE(entry.value, 555);
+    GBL_TEST_VERIFY(!GblConcurrentHashSet_extract(&pFixture->set, &entry, &entry));
+
+    GBL_TEST_COMPARE(pFixture->dtorCount, 1);
+    GBL_TEST_COMPARE(GblConcurrentHashSet_size(&pFixture->set), 100);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(erase)
+    Entry_ entry = { 99, 0 };
+
+    GBL_TEST_VERIFY(GblConcurrentHashSet_erase(&pFixture->set, &entry));
+    GBL_TEST_VERIFY(!GblConcurrentHashSet_erase(&pFixture->set, &entry));
+
+    GBL_TEST_COMPARE(pFixture->dtorCount, 2);
+    GBL_TEST_COMPARE(pFixture->dtorLastKey, 99);
+    GBL_TEST_COMPARE(GblConcurrentHashSet_size(&pFixture->set), 99);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(foreach)
+    // 0..98 * 10, with key 5 now holding 8 rather than 50
+    uintptr_t sum = 0;
+    GBL_TEST_VERIFY(GblConcurrentHashSet_foreach(&pFixture->set, sum_, &sum));
+    GBL_TEST_COMPARE(sum, (uintptr_t)(98 * 99 / 2 * 10 - 50 + 8));
+
+    GBL_TEST_VERIFY(!GblConcurrentHashSet_foreach(&pFixture->set, stopAtKey_, (void*)(uintptr_t)42));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(clear)
+    GblConcurrentHashSet_clear(&pFixture->set);
+
+    GBL_TEST_VERIFY(GblConcurrentHashSet_empty(&pFixture->set));
+    GBL_TEST_COMPARE(pFixture->dtorCount, 101);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(destruct)
+    GBL_TEST_CALL(GblConcurrentHashSet_destruct(&pFixture->set));
+GBL_TEST_CASE_END
+
+/* Each thread inserts its own keys, looks up everybody else's, erases
+   half of its own, and bumps a set of counters which every thread shares. */
+static int stressThread_(void* pArg) {
+    ThreadContext_* pThread = pArg;
+    const uintptr_t first   = (pThread->index + 1) * GBL_CONCURRENT_HASH_SET_TEST_STRESS_KEYS_;
+
+    for(uintptr_t k = first; k < first + GBL_CONCURRENT_HASH_SET_TEST_STRESS_KEYS_; ++k) {
+        Entry_ entry = { k, k * 3 };
+
+        if(!GblConcurrentHashSet_insert(pThread->pSet, &entry))
+            atomic_fetch_add(pThread->pErrors, 1);
+
+        // someone else's key, which either isn't there yet or has to be intact
+        entry.key = (k + GBL_CONCURRENT_HASH_SET_TEST_STRESS_KEYS_) %
+                    ((GBL_CONCURRENT_HASH_SET_TEST_THREADS_ + 1) * GBL_CONCURRENT_HASH_SET_TEST_STRESS_KEYS_);
+
+        if(GblConcurrentHashSet_get(pThread->pSet, &entry, &entry) &&
+           entry.key >= GBL_CONCURRENT_HASH_SET_TEST_STRESS_KEYS_ && entry.value != entry.key * 3)
+            atomic_fetch_add(pThread->pErrors, 1);
+
+        entry.key = k % GBL_CONCURRENT_HASH_SET_TEST_STRESS_KEYS_;
+        if(!GblConcurrentHashSet_visit(pThread->pSet, &entry, increment_, (void*)(uintptr_t)1))
+            atomic_fetch_add(pThread->pErrors, 1);
+    }
+
+    for(uintptr_t k = first + 1; k < first + GBL_CONCURRENT_HASH_SET_TEST_STRESS_KEYS_; k += 2) {
+        Entry_ entry = { k, 0 };
+
+        if(!GblConcurrentHashSet_erase(pThread->pSet, &entry))
+            atomic_fetch_add(pThread->pErrors, 1);
+    }
+
+    return 0;
+}
+
+GBL_TEST_CASE(stress)
+    atomic_size_t  errors;
+    thrd_t         threads[GBL_CONCURRENT_HASH_SET_TEST_THREADS_];
+    ThreadContext_ contexts[GBL_CONCURRENT_HASH_SET_TEST_THREADS_];
+
+    atomic_init(&errors, 0);
+
+    // small initial capacity, so that shards keep growing while being hammered
+    GBL_TEST_CALL(GblConcurrentHashSet_construct(&pFixture->set,
+                                                 sizeof(Entry_),
+                                                 hasher_,
+                                                 comparator_,
+                                                 NULL,
+                                                 0,
+                                                 pCtx,
+                                                 pFixture,
+                                                 8));
+
+    // shared counters
+    for(uintptr_t k = 0; k < GBL_CONCURRENT_HASH_SET_TEST_STRESS_KEYS_; ++k) {
+        Entry_ entry = { k, 0 };
+        GBL_TEST_VERIFY(GblConcurrentHashSet_insert(&pFixture->set, &entry));
+    }
+
+    for(uintptr_t t = 0; t < GBL_CONCURRENT_HASH_SET_TEST_THREADS_; ++t) {
+        contexts[t] = (ThreadContext_){ &pFixture->set, &errors, t, 0 };
+        GBL_TEST_COMPARE(thrd_create(&threads[t], stressThread_, &contexts[t]), thrd_success);
+    }
+
+    for(size_t t = 0; t < GBL_CONCURRENT_HASH_SET_TEST_THREADS_; ++t)
+        thrd_join(threads[t], NULL);
+
+    GBL_TEST_COMPARE(atomic_load(&errors), 0);
+    GBL_TEST_COMPARE(GblConcurrentHashSet_size(&pFixture->set),
+                     GBL_CONCURRENT_HASH_SET_TEST_STRESS_KEYS_ +
+                     GBL_CONCURRENT_HASH_SET_TEST_THREADS_ * GBL_CONCURRENT_HASH_SET_TEST_STRESS_KEYS_ / 2);
+
+    // every thread visited every counter once
+    uintptr_t total = 0;
+    for(uintptr_t k = 0; k < GBL_CONCURRENT_HASH_SET_TEST_STRESS_KEYS_; ++k) {
+        Entry_ entry = { k, 0 };
+        GBL_TEST_VERIFY(GblConcurrentHashSet_get(&pFixture->set, &entry, &entry));
+        GBL_TEST_COMPARE(entry.value, GBL_CONCURRENT_HASH_SET_TEST_THREADS_);
+        total += entry.value;
+    }
+
+    for(uintptr_t k = GBL_CONCURRENT_HASH_SET_TEST_STRESS_KEYS_;
+        k < (GBL_CONCURRENT_HASH_SET_TEST_THREADS_ + 1) * GBL_CONCURRENT_HASH_SET_TEST_STRESS_KEYS_;
+        ++k)
+    {
+        Entry_ entry = { k, 0 };
+        const GblBool found = GblConcurrentHashSet_get(&pFixture->set, &entry, &entry);
+        GBL_TEST_VERIFY(found == (k % 2 == 0));
+        if(found) total += entry.value;
+    }
+
+    uintptr_t sum = 0;
+    GBL_TEST_VERIFY(GblConcurrentHashSet_foreach(&pFixture->set, sum_, &sum));
+    GBL_TEST_COMPARE(sum, total);
+
+    GBL_TEST_CALL(GblConcurrentHashSet_destruct(&pFixture->set));
+GBL_TEST_CASE_END
+
+static int profileThread_(void* pArg) {
+    ThreadContext_* pThread = pArg;
+    uint32_t        seed    = (uint32_t)pThread->index * 2654435761u + 1;
+
+    for(size_t o = 0; o < pThread->ops; ++o) {
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+
+        Entry_ entry = { seed % GBL_CONCURRENT_HASH_SET_TEST_PROFILE_KEYS_, o };
+
+        if(o % 10 == 0)
+            GblConcurrentHashSet_insertOrAssign(pThread->pSet, &entry);
+        else if(!GblConcurrentHashSet_get(pThread->pSet, &entry, &entry))
+            atomic_fetch_add(pThread->pErrors, 1);
+    }
+
+    return 0;
+}
+
+GBL_TEST_CASE(throughputProfile)
+    atomic_size_t  errors;
+    thrd_t         threads[GBL_CONCURRENT_HASH_SET_TEST_THREADS_];
+    ThreadContext_ contexts[GBL_CONCURRENT_HASH_SET_TEST_THREADS_];
+
+    atomic_init(&errors, 0);
+
+    GBL_TEST_CALL(GblConcurrentHashSet_construct(&pFixture->set,
+                                                 sizeof(Entry_),
+                                                 hasher_,
+                                                 comparator_,
+                                                 NULL,
+                                                 GBL_CONCURRENT_HASH_SET_TEST_PROFILE_KEYS_,
+                                                 pCtx));
+
+    for(uintptr_t k = 0; k < GBL_CONCURRENT_HASH_SET_TEST_PROFILE_KEYS_; ++k) {
+        Entry_ entry = { k, k };
+        GBL_TEST_VERIFY(GblConcurrentHashSet_insert(&pFixture->set, &entry));
+    }
+
+    for(size_t threadCount = 1; threadCount <= GBL_CONCURRENT_HASH_SET_TEST_THREADS_; threadCount *= 2) {
+        GblTimer timer;
+        GblTimer_start(&timer);
+
+        for(uintptr_t t = 0; t < threadCount; ++t) {
+            contexts[t] = (ThreadContext_){ &pFixture->set, &errors, t, GBL_CONCURRENT_HASH_SET_TEST_PROFILE_OPS_ };
+            GBL_TEST_COMPARE(thrd_create(&threads[t], profileThread_, &contexts[t]), thrd_success);
+        }
+
+        for(size_t t = 0; t < threadCount; ++t)
+            thrd_join(threads[t], NULL);
+
+        GblTimer_stop(&timer);
+
+        GBL_CTX_INFO("%zu threads: %10.0lf ops/ms",
+                     threadCount,
+                     (double)(threadCount * GBL_CONCURRENT_HASH_SET_TEST_PROFILE_OPS_) / GblTimer_elapsedMs(&timer));
+    }
+
+    GBL_TEST_COMPARE(atomic_load(&errors), 0);
+    GBL_TEST_COMPARE(GblConcurrentHashSet_size(&pFixture->set), GBL_CONCURRENT_HASH_SET_TEST_PROFILE_KEYS_);
+
+    GBL_TEST_CALL(GblConcurrentHashSet_destruct(&pFixture->set));
+GBL_TEST_CASE_END
+
+GBL_TEST_REGISTER(construct,
+                  getInvalid,
+                  insert,
+                  set,
+                  insertOrAssign,
+                  visit,
+                  extract,
+                  erase,
+                  foreach,
+                  clear,
+                  destruct,
+                  stress,
+                  throughputProfile)
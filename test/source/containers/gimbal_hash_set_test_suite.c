@@ -1,9 +1,16 @@
 #include "containers/gimbal_hash_set_test_suite.h"
 #include <gimbal/test/gimbal_test_macros.h>
 #include <gimbal/containers/gimbal_hash_set.h>
+#include <gimbal/algorithms/gimbal_hash.h>
+#include <gimbal/utils/gimbal_timer.h>
 
 #define GBL_HASH_SET_TEST_SUITE_STRESS_TEST_ENTRY_COUNT_     2047
 
+// Profiles tables of 1K entries up to this size, by powers of 10 (define as 10000000 for the full range)
+#ifndef GBL_HASH_SET_TEST_SUITE_PROFILE_SIZE_MAX_
+#   define GBL_HASH_SET_TEST_SUITE_PROFILE_SIZE_MAX_        100000
+#endif
+
 #define GBL_HASH_SET_TEST_SUITE_(inst)     (GBL_PRIVATE(GblHashSetTestSuite, inst))
 
 typedef struct GblHashSetTestSuite_ {
@@ -642,6 +649,212 @@ static GBL_RESULT GblHashSetTestSuite_collidingConstruct_(GblTestSuite* pSelf, G
     GBL_CTX_END();
 }
 
+static GBL_RESULT GblHashSetTestSuite_groupedConstruct_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+    GblHashSetTestSuite_* pSelf_ = GBL_HASH_SET_TEST_SUITE_(pSelf);
+
+    pSelf_->dtorCount = 0;
+
+    GBL_CTX_VERIFY_CALL(GblHashSet_construct(&pSelf_->hashSet,
+                                             sizeof(HashSetEntry_),
+                                             hasher_,
+                                             comparator_,
+                                             destructor_,
+                                             2,
+                                             pCtx,
+                                             pSelf_,
+                                             GBL_HASH_SET_LAYOUT_GROUPED));
+
+    GBL_TEST_COMPARE(GblHashSet_layout(&pSelf_->hashSet), GBL_HASH_SET_LAYOUT_GROUPED);
+    GBL_TEST_COMPARE(GblHashSet_bucketSize(&pSelf_->hashSet), sizeof(HashSetEntry_));
+    GBL_TEST_COMPARE(GblHashSet_context(&pSelf_->hashSet), pCtx);
+    GBL_TEST_COMPARE(GblHashSet_userdata(&pSelf_->hashSet), pSelf_);
+    GBL_TEST_VERIFY(GblHashSet_empty(&pSelf_->hashSet));
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblHashSetTestSuite_groupedCollidingConstruct_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+    GblHashSetTestSuite_* pSelf_ = GBL_HASH_SET_TEST_SUITE_(pSelf);
+
+    pSelf_->dtorCount = 0;
+
+    GBL_CTX_VERIFY_CALL(GblHashSet_construct(&pSelf_->hashSet,
+                                             sizeof(HashSetEntry_),
+                                             collidingHasher_,
+                                             comparator_,
+                                             destructor_,
+                                             2,
+                                             pCtx,
+                                             pSelf_,
+                                             GBL_HASH_SET_LAYOUT_GROUPED));
+
+    GBL_TEST_VERIFY(GblHashSet_empty(&pSelf_->hashSet));
+    GBL_CTX_END();
+}
+
+typedef struct ProfileEntry_ {
+    uintptr_t key;
+    uintptr_t value;
+} ProfileEntry_;
+
+static GblHash profileHasher_(const GblHashSet* pSet, const void* pEntry) {
+    GBL_UNUSED(pSet);
+    return gblHash32Bit((uint32_t)((const ProfileEntry_*)pEntry)->key);
+}
+
+static GblBool profileComparator_(const GblHashSet* pSet, const void* pEntryA, const void* pEntryB) {
+    GBL_UNUSED(pSet);
+    return ((const ProfileEntry_*)pEntryA)->key == ((const ProfileEntry_*)pEntryB)->key;
+}
+
+// Interleaves insertions and removals, leaving plenty of tombstones behind for the grouped layout
+static GBL_RESULT GblHashSetTestSuite_churn_(GblContext* pCtx, GBL_HASH_SET_LAYOUT layout) {
+    GBL_CTX_BEGIN(pCtx);
+    GblHashSet set;
+    const uintptr_t count = GBL_HASH_SET_TEST_SUITE_STRESS_TEST_ENTRY_COUNT_;
+
+    GBL_CTX_VERIFY_CALL(GblHashSet_construct(&set,
+                                             sizeof(ProfileEntry_),
+                                             profileHasher_,
+                                             profileComparator_,
+                                             NULL,
+                                             0,
+                                             pCtx,
+                                             NULL,
+                                             layout));
+
+    for(uintptr_t round = 0; round < 4; ++round) {
+        for(uintptr_t k = 0; k < count; ++k) {
+            ProfileEntry_ entry = { k, k + round };
+            GblHashSet_insertOrAssign(&set, &entry);
+        }
+
+        for(uintptr_t k = round % 2; k < count; k += 2) {
+            ProfileEntry_ entry = { k, 0 };
+            GBL_TEST_VERIFY(GblHashSet_erase(&set, &entry));
+        }
+
+        const size_t size = GblHashSet_size(&set);
+        GBL_TEST_COMPARE(size, (size_t)(round % 2? count / 2 + 1 : count / 2));
+
+        for(uintptr_t k = 0; k < count; ++k) {
+            ProfileEntry_  entry  = { k, 0 };
+            ProfileEntry_* pFound = GblHashSet_get(&set, &entry);
+            if(k % 2 == round % 2) {
+                GBL_TEST_COMPARE(pFound, NULL);
+            } else {
+                GBL_TEST_VERIFY(pFound);
+                GBL_TEST_COMPARE(pFound->value, k + round);
+            }
+        }
+    }
+
+    size_t visited = 0;
+    for(GblHashSetIter it = GblHashSet_next(&set, NULL);
+        GblHashSetIter_valid(&it);
+        it = GblHashSet_next(&set, &it))
+    {
+        ProfileEntry_* pEntry = GblHashSetIter_value(&it);
+        GBL_TEST_COMPARE(pEntry->key % 2, 0);
+        ++visited;
+    }
+    GBL_TEST_COMPARE(visited, GblHashSet_size(&set));
+
+    GblHashSet_clear(&set);
+    GBL_TEST_VERIFY(GblHashSet_empty(&set));
+    GBL_CTX_VERIFY_CALL(GblHashSet_shrinkToFit(&set));
+    GBL_CTX_VERIFY_CALL(GblHashSet_destruct(&set));
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblHashSetTestSuite_robinHoodChurn_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    return GblHashSetTestSuite_churn_(pCtx, GBL_HASH_SET_LAYOUT_ROBIN_HOOD);
+}
+
+static GBL_RESULT GblHashSetTestSuite_groupedChurn_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    return GblHashSetTestSuite_churn_(pCtx, GBL_HASH_SET_LAYOUT_GROUPED);
+}
+
+static GBL_RESULT GblHashSetTestSuite_profile_(GblContext* pCtx, GBL_HASH_SET_LAYOUT layout, const char* pName) {
+    GBL_CTX_BEGIN(pCtx);
+
+    for(uintptr_t count = 1000; count <= GBL_HASH_SET_TEST_SUITE_PROFILE_SIZE_MAX_; count *= 10) {
+        GblHashSet set;
+        GblTimer   timer;
+        double     nsec[4];
+        size_t     hits = 0, misses = 0, erased = 0;
+
+        GBL_CTX_VERIFY_CALL(GblHashSet_construct(&set,
+                                                 sizeof(ProfileEntry_),
+                                                 profileHasher_,
+                                                 profileComparator_,
+                                                 NULL,
+                                                 0,
+                                                 pCtx,
+                                                 NULL,
+                                                 layout));
+
+        // even keys get inserted, odd keys are guaranteed misses
+        GblTimer_start(&timer);
+        for(uintptr_t k = 0; k < count; ++k) {
+            ProfileEntry_ entry = { k * 2, k };
+            GblHashSet_insert(&set, &entry);
+        }
+        GblTimer_stop(&timer);
+        nsec[0] = GblTimer_elapsedMs(&timer) * 1000000.0 / count;
+
+        GblTimer_start(&timer);
+        for(uintptr_t k = 0; k < count; ++k) {
+            ProfileEntry_ entry = { k * 2, 0 };
+            hits += GblHashSet_get(&set, &entry) != NULL;
+        }
+        GblTimer_stop(&timer);
+        nsec[1] = GblTimer_elapsedMs(&timer) * 1000000.0 / count;
+
+        GblTimer_start(&timer);
+        for(uintptr_t k = 0; k < count; ++k) {
+            ProfileEntry_ entry = { k * 2 + 1, 0 };
+            misses += GblHashSet_get(&set, &entry) == NULL;
+        }
+        GblTimer_stop(&timer);
+        nsec[2] = GblTimer_elapsedMs(&timer) * 1000000.0 / count;
+
+        GblTimer_start(&timer);
+        for(uintptr_t k = 0; k < count; ++k) {
+            ProfileEntry_ entry = { k * 2, 0 };
+            erased += GblHashSet_erase(&set, &entry);
+        }
+        GblTimer_stop(&timer);
+        nsec[3] = GblTimer_elapsedMs(&timer) * 1000000.0 / count;
+
+        GBL_CTX_INFO("%-10s %8zu entries: insert %6.1lf, hit %6.1lf, miss %6.1lf, erase %6.1lf ns/op",
+                     pName, (size_t)count, nsec[0], nsec[1], nsec[2], nsec[3]);
+
+        GBL_TEST_COMPARE(hits, count);
+        GBL_TEST_COMPARE(misses, count);
+        GBL_TEST_COMPARE(erased, count);
+        GBL_TEST_VERIFY(GblHashSet_empty(&set));
+
+        GBL_CTX_VERIFY_CALL(GblHashSet_destruct(&set));
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblHashSetTestSuite_robinHoodProfile_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    return GblHashSetTestSuite_profile_(pCtx, GBL_HASH_SET_LAYOUT_ROBIN_HOOD, "robinHood");
+}
+
+static GBL_RESULT GblHashSetTestSuite_groupedProfile_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    return GblHashSetTestSuite_profile_(pCtx, GBL_HASH_SET_LAYOUT_GROUPED, "grouped");
+}
+
 GBL_EXPORT GblType GblHashSetTestSuite_type(void) {
     static GblType type = GBL_INVALID_TYPE;
 
@@ -679,6 +892,43 @@ GBL_EXPORT GblType GblHashSetTestSuite_type(void) {
         { "collidingErase",                  GblHashSetTestSuite_erase_                     },
         { "collidingExtract",                GblHashSetTestSuite_extract_                   },
         { "collidingDestruct",               GblHashSetTestSuite_destruct_                  },
+        { "groupedConstruct",                GblHashSetTestSuite_groupedConstruct_          },
+        { "groupedGetInvalid",               GblHashSetTestSuite_getInvalid_                },
+        { "groupedAtInvalid",                GblHashSetTestSuite_atInvalid_                 },
+        { "groupedContainsInvalid",          GblHashSetTestSuite_containsInvalid_           },
+        { "groupedFindInvalid",              GblHashSetTestSuite_findInvalid_               },
+        { "groupedSetInsert",                GblHashSetTestSuite_setInsert_                 },
+        { "groupedSetOverride",              GblHashSetTestSuite_setOverride_               },
+        { "groupedInsertInvalid",            GblHashSetTestSuite_insertInvalid_             },
+        { "groupedInsert",                   GblHashSetTestSuite_insert_                    },
+        { "groupedInsertOrAssignInsert",     GblHashSetTestSuite_insertOrAssignInsert_      },
+        { "groupedInsertOrAssignAssign",     GblHashSetTestSuite_insertOrAssignAssign_      },
+        { "groupedEmplaceOverExisting",      GblHashSetTestSuite_emplaceOverExisting_       },
+        { "groupedEmplaceInsert",            GblHashSetTestSuite_emplaceInsert_             },
+        { "groupedTryEmplaceInvalid",        GblHashSetTestSuite_tryEmplaceInvalid_         },
+        { "groupedTryEmplace",               GblHashSetTestSuite_tryEmplace_                },
+        { "groupedEraseInvalid",             GblHashSetTestSuite_eraseInvalid_              },
+        { "groupedErase",                    GblHashSetTestSuite_erase_                     },
+        { "groupedExtractInvalid",           GblHashSetTestSuite_extractInvalid_            },
+        { "groupedExtract",                  GblHashSetTestSuite_extract_                   },
+        { "groupedClear",                    GblHashSetTestSuite_clear_                     },
+        { "groupedDestruct",                 GblHashSetTestSuite_destruct_                  },
+        { "groupedCollidingConstruct",       GblHashSetTestSuite_groupedCollidingConstruct_ },
+        { "groupedCollidingSetInsert",       GblHashSetTestSuite_setInsert_                 },
+        { "groupedCollidingSetOverride",     GblHashSetTestSuite_setOverride_               },
+        { "groupedCollidingInsert",          GblHashSetTestSuite_insert_                    },
+        { "groupedCollidingInsertOrAssignInsert", GblHashSetTestSuite_insertOrAssignInsert_ },
+        { "groupedCollidingInsertOrAssignAssign", GblHashSetTestSuite_insertOrAssignAssign_ },
+        { "groupedCollidingEmplaceOverExisting",  GblHashSetTestSuite_emplaceOverExisting_  },
+        { "groupedCollidingEmplaceInsert",   GblHashSetTestSuite_emplaceInsert_             },
+        { "groupedCollidingTryEmplace",      GblHashSetTestSuite_tryEmplace_                },
+        { "groupedCollidingErase",           GblHashSetTestSuite_erase_                     },
+        { "groupedCollidingExtract",         GblHashSetTestSuite_extract_                   },
+        { "groupedCollidingDestruct",        GblHashSetTestSuite_destruct_                  },
+        { "robinHoodChurn",                  GblHashSetTestSuite_robinHoodChurn_            },
+        { "groupedChurn",                    GblHashSetTestSuite_groupedChurn_              },
+        { "robinHoodProfile",                GblHashSetTestSuite_robinHoodProfile_          },
+        { "groupedProfile",                  GblHashSetTestSuite_groupedProfile_            },
         { NULL,                              NULL                                           }
     };
 
@@ -2,6 +2,9 @@
 #include <gimbal/test/gimbal_test_macros.h>
 #include <gimbal/core/gimbal_ctx.h>
 #include <gimbal/containers/gimbal_ring_buffer.h>
+#include <gimbal/utils/gimbal_timer.h>
+
+#include <tinycthread.h>
 
 #define GBL_RING_BUFFER_TEST_SUITE_(inst)     (GBL_PRIVATE(GblRingBufferTestSuite, inst))
 
@@ -312,6 +315,349 @@ static GBL_RESULT GblRingBufferTestSuite_clear_(GblTestSuite* pSelf, GblContext*
     GBL_CTX_END();
 }
 
+static GBL_RESULT GblRingBufferTestSuite_pushBackNPopFrontN_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    GblRingBuffer buffer;
+    const char*   out[GBL_COUNT_OF(stringLiterals_)];
+    size_t        count;
+
+    GBL_CTX_VERIFY_CALL(GblRingBuffer_construct(&buffer, sizeof(const char*), 5, 0, NULL, pCtx));
+
+    count = GblRingBuffer_pushBackN(&buffer, stringLiterals_, 3);
+
+    GBL_TEST_COMPARE(count, 3);
+    count = GblRingBuffer_popFrontN(&buffer, out, 2);
+    GBL_TEST_COMPARE(count, 2);
+    GBL_TEST_COMPARE(out[0], stringLiterals_[0]);
+    GBL_TEST_COMPARE(out[1], stringLiterals_[1]);
+
+    // wraps around the end of the buffer
+    count = GblRingBuffer_pushBackN(&buffer, &stringLiterals_[3], 4);
+    GBL_TEST_COMPARE(count, 4);
+    GBL_CTX_VERIFY_CALL(GblRingBufferTestSuite_verify_(pCtx, &buffer, "c", "d", "e", "f", "g", NULL));
+
+    // overwrites the oldest values, like pushBack()
+    count = GblRingBuffer_pushBackN(&buffer, &stringLiterals_[7], 2);
+    GBL_TEST_COMPARE(count, 2);
+    GBL_CTX_VERIFY_CALL(GblRingBufferTestSuite_verify_(pCtx, &buffer, "e", "f", "g", "h", "i", NULL));
+
+    count = GblRingBuffer_pushBackN(&buffer, stringLiterals_, 12);
+
+    GBL_TEST_COMPARE(count, 12);
+    GBL_CTX_VERIFY_CALL(GblRingBufferTestSuite_verify_(pCtx, &buffer, "h", "i", "j", "k", "l", NULL));
+
+    count = GblRingBuffer_popFrontN(&buffer, out, 10);
+
+    GBL_TEST_COMPARE(count, 5);
+    GBL_TEST_COMPARE(out[0], stringLiterals_[7]);
+    GBL_TEST_COMPARE(out[4], stringLiterals_[11]);
+    count = GblRingBuffer_popFrontN(&buffer, out, 1);
+    GBL_TEST_COMPARE(count, 0);
+
+    GBL_TEST_VERIFY(GblRingBuffer_tryPushBack(&buffer, &stringLiterals_[0]));
+    count = GblRingBuffer_pushBackN(&buffer, &stringLiterals_[1], 4);
+    GBL_TEST_COMPARE(count, 4);
+    GBL_TEST_VERIFY(!GblRingBuffer_tryPushBack(&buffer, &stringLiterals_[5]));
+    GBL_TEST_VERIFY(GblRingBuffer_tryPopFront(&buffer, out));
+    GBL_TEST_COMPARE(out[0], stringLiterals_[0]);
+    GBL_TEST_VERIFY(GblRingBuffer_tryPopFront(&buffer, NULL));
+    GBL_CTX_VERIFY_CALL(GblRingBufferTestSuite_verify_(pCtx, &buffer, "c", "d", "e", NULL));
+
+    GBL_CTX_VERIFY_CALL(GblRingBuffer_destruct(&buffer));
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblRingBufferTestSuite_verifyConcurrent_(GblContext*          pCtx,
+                                                           GBL_RING_BUFFER_MODE mode)
+{
+    GBL_CTX_BEGIN(pCtx);
+
+    GblRingBuffer buffer;
+    const char*   out[GBL_COUNT_OF(stringLiterals_)];
+    size_t        count;
+
+    GBL_CTX_VERIFY_CALL(GblRingBuffer_construct(&buffer, sizeof(const char*), 5, 2, stringLiterals_, pCtx, mode));
+    GBL_TEST_COMPARE(GblRingBuffer_capacity(&buffer), 8);
+    GBL_TEST_COMPARE(GblRingBuffer_mode(&buffer), mode);
+    GBL_TEST_COMPARE(GblRingBuffer_size(&buffer), 2);
+
+    // rejects what doesn't fit rather than overwriting
+    count = GblRingBuffer_pushBackN(&buffer, &stringLiterals_[2], 10);
+    GBL_TEST_COMPARE(count, 6);
+    GBL_TEST_VERIFY(GblRingBuffer_full(&buffer));
+    GBL_TEST_VERIFY(!GblRingBuffer_tryPushBack(&buffer, &stringLiterals_[8]));
+
+    GBL_TEST_EXPECT_ERROR();
+    GBL_TEST_VERIFY(GblRingBuffer_pushBack(&buffer, &stringLiterals_[8]) == GBL_RESULT_ERROR_OVERFLOW);
+    GBL_TEST_COMPARE(GBL_CTX_LAST_RESULT(), GBL_RESULT_ERROR_OVERFLOW);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_TEST_COMPARE(GblRingBuffer_popFront(&buffer), NULL);
+    GBL_TEST_COMPARE(GBL_CTX_LAST_RESULT(), GBL_RESULT_ERROR_INVALID_OPERATION);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    count = GblRingBuffer_popFrontN(&buffer, out, 3);
+
+    GBL_TEST_COMPARE(count, 3);
+    GBL_TEST_COMPARE(out[0], stringLiterals_[0]);
+    GBL_TEST_COMPARE(out[2], stringLiterals_[2]);
+
+    // wraps around the end of the buffer
+    count = GblRingBuffer_pushBackN(&buffer, &stringLiterals_[8], 3);
+    GBL_TEST_COMPARE(count, 3);
+    GBL_TEST_COMPARE(GblRingBuffer_size(&buffer), 8);
+
+    if(mode == GBL_RING_BUFFER_MODE_SPSC) {
+        const char** ppFront = GblRingBuffer_front(&buffer);
+        const char** ppBack  = GblRingBuffer_back(&buffer);
+        GBL_TEST_VERIFY(ppFront && ppBack);
+        GBL_TEST_COMPARE(*ppFront, stringLiterals_[3]);
+        GBL_TEST_COMPARE(*ppBack, stringLiterals_[10]);
+    }
+
+    count = GblRingBuffer_popFrontN(&buffer, out, 10);
+
+    GBL_TEST_COMPARE(count, 8);
+    for(size_t  i = 0; i < 8; ++i)
+        GBL_TEST_COMPARE(out[i], stringLiterals_[i + 3]);
+
+    GBL_TEST_VERIFY(!GblRingBuffer_tryPopFront(&buffer, out));
+    GBL_TEST_VERIFY(GblRingBuffer_tryPushBack(&buffer, &stringLiterals_[0]));
+    GblRingBuffer_clear(&buffer);
+    GBL_TEST_VERIFY(GblRingBuffer_empty(&buffer));
+
+    GBL_CTX_VERIFY_CALL(GblRingBuffer_destruct(&buffer));
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblRingBufferTestSuite_spsc_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    return GblRingBufferTestSuite_verifyConcurrent_(pCtx, GBL_RING_BUFFER_MODE_SPSC);
+}
+
+static GBL_RESULT GblRingBufferTestSuite_mpmc_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    return GblRingBufferTestSuite_verifyConcurrent_(pCtx, GBL_RING_BUFFER_MODE_MPMC);
+}
+
+static GBL_RESULT GblRingBufferTestSuite_modeInvalid_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    GblRingBuffer buffer;
+
+    GBL_TEST_EXPECT_ERROR();
+
+    GBL_TEST_COMPARE(GblRingBuffer_construct(&buffer, sizeof(int), 4, 0, NULL, pCtx,
+                                             GBL_RING_BUFFER_MODE_BLOCKING),
+                     GBL_RESULT_ERROR_INVALID_ARG);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_CTX_END();
+}
+
+#define GBL_RING_BUFFER_TEST_SUITE_STRESS_COUNT_    20000
+#define GBL_RING_BUFFER_TEST_SUITE_PROFILE_COUNT_   200000
+#define GBL_RING_BUFFER_TEST_SUITE_BULK_SIZE_       32
+
+typedef struct RingThread_ {
+    GblRingBuffer* pBuffer;
+    mtx_t*         pMtx;        // only for the mutex-guarded default mode
+    size_t         count;
+    size_t         bulk;
+    size_t         sum;
+    GblBool        ordered;
+} RingThread_;
+
+static int GblRingBufferTestSuite_producer_(void* pArg) {
+    RingThread_* pThread = pArg;
+    size_t       values[GBL_RING_BUFFER_TEST_SUITE_BULK_SIZE_];
+
+    for(size_t v = 0; v < pThread->count; ) {
+        if(pThread->pMtx) {
+            mtx_lock(pThread->pMtx);
+            const GblBool pushed = GblRingBuffer_tryPushBack(pThread->pBuffer, &v);
+            mtx_unlock(pThread->pMtx);
+            if(pushed) ++v;
+            else thrd_yield();
+        } else if(pThread->bulk) {
+            const size_t n = GBL_MIN(pThread->bulk, pThread->count - v);
+            for(size_t i = 0; i < n; ++i) values[i] = v + i;
+
+            const size_t pushed = GblRingBuffer_pushBackN(pThread->pBuffer, values, n);
+            if(pushed) v += pushed;
+            else thrd_yield();
+        } else {
+            GblRingBuffer_waitPushBack(pThread->pBuffer, &v);
+            ++v;
+        }
+    }
+
+    return 0;
+}
+
+static int GblRingBufferTestSuite_consumer_(void* pArg) {
+    RingThread_* pThread = pArg;
+    size_t       values[GBL_RING_BUFFER_TEST_SUITE_BULK_SIZE_];
+    size_t       expected = 0;
+
+    pThread->ordered = GBL_TRUE;
+
+    for(size_t c = 0; c < pThread->count; ) {
+        size_t popped = 0;
+
+        if(pThread->pMtx) {
+            mtx_lock(pThread->pMtx);
+            popped = GblRingBuffer_tryPopFront(pThread->pBuffer, values);
+            mtx_unlock(pThread->pMtx);
+        } else if(pThread->bulk) {
+            popped = GblRingBuffer_popFrontN(pThread->pBuffer, values, pThread->bulk);
+        } else {
+            GblRingBuffer_waitPopFront(pThread->pBuffer, values);
+            popped = 1;
+        }
+
+        if(!popped) {
+            thrd_yield();
+            continue;
+        }
+
+        for(size_t i = 0; i < popped; ++i) {
+            if(values[i] != expected++) pThread->ordered = GBL_FALSE;
+            pThread->sum += values[i];
+        }
+
+        c += popped;
+    }
+
+    return 0;
+}
+
+static GBL_RESULT GblRingBufferTestSuite_runThreads_(GblContext*    pCtx,
+                                                     GblRingBuffer* pBuffer,
+                                                     mtx_t*         pMtx,
+                                                     size_t         threadPairs,
+                                                     size_t         count,
+                                                     size_t         bulk,
+                                                     double*        pOpsPerMs)
+{
+    GBL_CTX_BEGIN(pCtx);
+
+    thrd_t      threads[4];
+    RingThread_ contexts[4];
+    size_t      sum = 0;
+    GblTimer    timer;
+
+    GBL_CTX_VERIFY_ARG(threadPairs <= 2);
+
+    GblTimer_start(&timer);
+
+    for(size_t t = 0; t < threadPairs * 2; ++t) {
+        contexts[t] = (RingThread_){ pBuffer, pMtx, count, bulk, 0, GBL_TRUE };
+        GBL_TEST_COMPARE(thrd_create(&threads[t],
+                                     t % 2? GblRingBufferTestSuite_consumer_ :
+                                            GblRingBufferTestSuite_producer_,
+                                     &contexts[t]),
+                         thrd_success);
+    }
+
+    for(size_t t = 0; t < threadPairs * 2; ++t)
+        thrd_join(threads[t], NULL);
+
+    GblTimer_stop(&timer);
+
+    for(size_t t = 1; t < threadPairs * 2; t += 2) {
+        sum += contexts[t].sum;
+        // values from a single producer arrive in order
+        if(threadPairs == 1) GBL_TEST_VERIFY(contexts[t].ordered);
+    }
+
+    GBL_TEST_COMPARE(sum, threadPairs * (count * (count - 1) / 2));
+    GBL_TEST_VERIFY(GblRingBuffer_empty(pBuffer));
+
+    if(pOpsPerMs)
+        *pOpsPerMs = (double)(threadPairs * count) / GblTimer_elapsedMs(&timer);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblRingBufferTestSuite_stress_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    static const GBL_RING_BUFFER_MODE modes[] = {
+        GBL_RING_BUFFER_MODE_SPSC,
+        GBL_RING_BUFFER_MODE_SPSC | GBL_RING_BUFFER_MODE_BLOCKING,
+        GBL_RING_BUFFER_MODE_MPMC,
+        GBL_RING_BUFFER_MODE_MPMC | GBL_RING_BUFFER_MODE_BLOCKING
+    };
+
+    for(size_t m = 0; m < GBL_COUNT_OF(modes); ++m) {
+        const size_t pairs = (modes[m] & GBL_RING_BUFFER_MODE_MPMC)? 2 : 1;
+        GblRingBuffer buffer;
+
+        GBL_CTX_VERIFY_CALL(GblRingBuffer_construct(&buffer, sizeof(size_t), 64, 0, NULL, pCtx, modes[m]));
+
+        GBL_CTX_VERIFY_CALL(GblRingBufferTestSuite_runThreads_(pCtx, &buffer, NULL, pairs,
+                                                               GBL_RING_BUFFER_TEST_SUITE_STRESS_COUNT_,
+                                                               0, NULL));
+        GBL_CTX_VERIFY_CALL(GblRingBufferTestSuite_runThreads_(pCtx, &buffer, NULL, pairs,
+                                                               GBL_RING_BUFFER_TEST_SUITE_STRESS_COUNT_,
+                                                               GBL_RING_BUFFER_TEST_SUITE_BULK_SIZE_, NULL));
+
+        GBL_CTX_VERIFY_CALL(GblRingBuffer_destruct(&buffer));
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblRingBufferTestSuite_throughputProfile_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    static const struct {
+        const char*          pName;
+        GBL_RING_BUFFER_MODE mode;
+        size_t               bulk;
+    } runs[] = {
+        { "mutex + default", GBL_RING_BUFFER_MODE_DEFAULT,                                0                                     },
+        { "SPSC",            GBL_RING_BUFFER_MODE_SPSC,                                   0                                     },
+        { "SPSC bulk",       GBL_RING_BUFFER_MODE_SPSC,                                   GBL_RING_BUFFER_TEST_SUITE_BULK_SIZE_ },
+        { "MPMC",            GBL_RING_BUFFER_MODE_MPMC,                                   0                                     },
+        { "MPMC bulk",       GBL_RING_BUFFER_MODE_MPMC,                                   GBL_RING_BUFFER_TEST_SUITE_BULK_SIZE_ }
+    };
+
+    mtx_t mtx;
+    mtx_init(&mtx, mtx_plain);
+
+    for(size_t r = 0; r < GBL_COUNT_OF(runs); ++r) {
+        GblRingBuffer buffer;
+        double        opsPerMs = 0.0;
+
+        GBL_CTX_VERIFY_CALL(GblRingBuffer_construct(&buffer, sizeof(size_t), 1024, 0, NULL, pCtx, runs[r].mode));
+
+        GBL_CTX_VERIFY_CALL(GblRingBufferTestSuite_runThreads_(pCtx,
+                                                               &buffer,
+                                                               runs[r].mode? NULL : &mtx,
+                                                               1,
+                                                               GBL_RING_BUFFER_TEST_SUITE_PROFILE_COUNT_,
+                                                               runs[r].bulk,
+                                                               &opsPerMs));
+
+        GBL_CTX_INFO("%-16s: %10.0lf ops/ms", runs[r].pName, opsPerMs);
+
+        GBL_CTX_VERIFY_CALL(GblRingBuffer_destruct(&buffer));
+    }
+
+    mtx_destroy(&mtx);
+
+    GBL_CTX_END();
+}
+
 static GBL_RESULT GblRingBufferTestSuite_destruct_(GblTestSuite* pSelf, GblContext* pCtx) {
     GBL_CTX_BEGIN(pCtx);
     GblRingBufferTestSuite_* pSelf_ = GBL_RING_BUFFER_TEST_SUITE_(pSelf);
@@ -342,6 +688,12 @@ GBL_EXPORT GblType GblRingBufferTestSuite_type(void) {
         { "popFront",            GblRingBufferTestSuite_popFront_            },
         { "popFrontInvalid",     GblRingBufferTestSuite_popFrontInvalid_     },
         { "clear",               GblRingBufferTestSuite_clear_               },
+        { "pushBackNPopFrontN",  GblRingBufferTestSuite_pushBackNPopFrontN_  },
+        { "spsc",                GblRingBufferTestSuite_spsc_                },
+        { "mpmc",                GblRingBufferTestSuite_mpmc_                },
+        { "modeInvalid",         GblRingBufferTestSuite_modeInvalid_         },
+        { "stress",              GblRingBufferTestSuite_stress_              },
+        { "throughputProfile",   GblRingBufferTestSuite_throughputProfile_   },
         { "destruct",            GblRingBufferTestSuite_destruct_            },
         { NULL,                  NULL                                        }
     };
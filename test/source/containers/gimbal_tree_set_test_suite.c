@@ -2,6 +2,7 @@
 #include <gimbal/core/gimbal_ctx.h>
 #include <gimbal/test/gimbal_test_macros.h>
 #include <gimbal/containers/gimbal_tree_set.h>
+#include <gimbal/utils/gimbal_timer.h>
 
 // Do stress test
 #define GBL_TREE_SET_TEST_SUITE_(inst)  (GBL_PRIVATE(GblTreeSetTestSuite, inst))
@@ -198,6 +199,392 @@ static GBL_RESULT GblTreeSetTestSuite_clear_(GblTestSuite* pSelf, GblContext* pC
 }
 
 
+#define GBL_TREE_SET_TEST_SUITE_KEYS_           5000
+#define GBL_TREE_SET_TEST_SUITE_PROFILE_KEYS_   200000
+
+static int GblTreeSetTestSuite_intComparator_(const GblTreeSet* pSet, const void* pEntry1, const void* pEntry2) {
+    GBL_UNUSED(pSet);
+    const uintptr_t a = *(const uintptr_t*)pEntry1;
+    const uintptr_t b = *(const uintptr_t*)pEntry2;
+    return (a > b) - (a < b);
+}
+
+static size_t intDtorCount_ = 0;
+
+static void GblTreeSetTestSuite_intDestructor_(const GblTreeSet* pSet, void* pEntry) {
+    GBL_UNUSED(pSet, pEntry);
+    ++intDtorCount_;
+}
+
+// walks the whole set with both select() and a cursor, comparing against what should be present
+static GBL_RESULT GblTreeSetTestSuite_verifyOrder_(GblContext* pCtx, const GblTreeSet* pSet, const GblBool* pPresent, size_t keys) {
+    GBL_CTX_BEGIN(pCtx);
+
+    GblTreeSetCursor cursor;
+    uintptr_t*       pEntry = GblTreeSet_range(pSet, &cursor, NULL, NULL);
+    size_t           index  = 0;
+
+    for(uintptr_t k = 0; k < keys; ++k) {
+        const size_t rank = GblTreeSet_rank(pSet, &k);
+        GBL_TEST_COMPARE(rank, index);
+
+        if(!pPresent[k]) continue;
+
+        const uintptr_t* pSelected = GblTreeSet_select(pSet, index);
+        GBL_TEST_VERIFY(pSelected && *pSelected == k);
+        GBL_TEST_VERIFY(pEntry && *pEntry == k);
+
+        pEntry = GblTreeSetCursor_next(&cursor);
+        ++index;
+    }
+
+    GBL_TEST_VERIFY(!pEntry);
+    GBL_TEST_VERIFY(!GblTreeSetCursor_valid(&cursor));
+    GBL_TEST_COMPARE(GblTreeSet_size(pSet), index);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblTreeSetTestSuite_loadInvalid_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    GblTreeSet      set;
+    const uintptr_t entries[] = { 1, 2, 2, 3 };
+
+    GBL_CTX_VERIFY_CALL(GblTreeSet_construct(&set, sizeof(uintptr_t), GblTreeSetTestSuite_intComparator_));
+
+    GBL_TEST_EXPECT_ERROR();
+    GBL_TEST_COMPARE(GblTreeSet_load(&set, entries, GBL_COUNT_OF(entries)), GBL_RESULT_ERROR_INVALID_ARG);
+    GBL_TEST_COMPARE(GBL_CTX_LAST_RESULT(), GBL_RESULT_ERROR_INVALID_ARG);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_TEST_COMPARE(GblTreeSet_select(&set, 0), NULL);
+    GBL_TEST_COMPARE(GBL_CTX_LAST_RESULT(), GBL_RESULT_ERROR_OUT_OF_RANGE);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_TEST_VERIFY(GblTreeSet_empty(&set));
+    GBL_TEST_COMPARE(GblTreeSet_min(&set), NULL);
+    GBL_TEST_COMPARE(GblTreeSet_max(&set), NULL);
+
+    GBL_CTX_VERIFY_CALL(GblTreeSet_destruct(&set));
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblTreeSetTestSuite_load_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    static const size_t maxEntries[] = { 4, 6, 16, 0 };
+    static const size_t counts[]     = { 1, 2, 3, 7, 100, GBL_TREE_SET_TEST_SUITE_KEYS_ };
+
+    uintptr_t* pEntries = GBL_CTX_MALLOC(sizeof(uintptr_t) * GBL_TREE_SET_TEST_SUITE_KEYS_ * 2);
+    GblBool*   pPresent = GBL_CTX_MALLOC(sizeof(GblBool) * GBL_TREE_SET_TEST_SUITE_KEYS_ * 2);
+
+    for(size_t m = 0; m < GBL_COUNT_OF(maxEntries); ++m) {
+        for(size_t c = 0; c < GBL_COUNT_OF(counts); ++c) {
+            GblTreeSet set;
+
+            GBL_CTX_VERIFY_CALL(GblTreeSet_construct(&set,
+                                                     sizeof(uintptr_t),
+                                                     GblTreeSetTestSuite_intComparator_,
+                                                     NULL,
+                                                     maxEntries[m]));
+
+            // every other key, so that the gaps can be filled in afterwards
+            memset(pPresent, 0, sizeof(GblBool) * counts[c] * 2);
+            for(size_t e = 0; e < counts[c]; ++e) {
+                pEntries[e]           = e * 2;
+                pPresent[pEntries[e]] = GBL_TRUE;
+            }
+
+            GBL_CTX_VERIFY_CALL(GblTreeSet_load(&set, pEntries, counts[c]));
+            GBL_TEST_COMPARE(GblTreeSet_size(&set), counts[c]);
+            GBL_TEST_COMPARE(*(uintptr_t*)GblTreeSet_min(&set), 0);
+            GBL_TEST_COMPARE(*(uintptr_t*)GblTreeSet_max(&set), (counts[c] - 1) * 2);
+            GBL_CTX_VERIFY_CALL(GblTreeSetTestSuite_verifyOrder_(pCtx, &set, pPresent, counts[c] * 2));
+
+            // a loaded tree must still take inserts and deletes
+            for(uintptr_t k = 1; k < counts[c] * 2; k += 2) {
+                GBL_TEST_COMPARE(GblTreeSet_set(&set, &k), NULL);
+                pPresent[k] = GBL_TRUE;
+            }
+            for(uintptr_t k = 0; k < counts[c] * 2; k += 3) {
+                GBL_TEST_VERIFY(GblTreeSet_erase(&set, &k));
+                pPresent[k] = GBL_FALSE;
+            }
+            GBL_CTX_VERIFY_CALL(GblTreeSetTestSuite_verifyOrder_(pCtx, &set, pPresent, counts[c] * 2));
+
+            GBL_CTX_VERIFY_CALL(GblTreeSet_destruct(&set));
+        }
+    }
+
+    GBL_CTX_FREE(pPresent);
+    GBL_CTX_FREE(pEntries);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblTreeSetTestSuite_rankSelect_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    GblTreeSet set;
+    GblBool    present[GBL_TREE_SET_TEST_SUITE_KEYS_] = { 0 };
+    uint32_t   seed = 12345;
+
+    // smallest nodes, to exercise every split, merge and rotation
+    GBL_CTX_VERIFY_CALL(GblTreeSet_construct(&set,
+                                             sizeof(uintptr_t),
+                                             GblTreeSetTestSuite_intComparator_,
+                                             NULL,
+                                             4));
+
+    for(size_t o = 0; o < GBL_TREE_SET_TEST_SUITE_KEYS_ * 4; ++o) {
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+        const uintptr_t k = seed % GBL_TREE_SET_TEST_SUITE_KEYS_;
+
+        if(seed & 0x100000) {
+            GblTreeSet_set(&set, &k);
+            present[k] = GBL_TRUE;
+        } else {
+            const GblBool erased = GblTreeSet_erase(&set, &k);
+            GBL_TEST_COMPARE(erased, present[k]);
+            present[k] = GBL_FALSE;
+        }
+    }
+
+    GBL_CTX_VERIFY_CALL(GblTreeSetTestSuite_verifyOrder_(pCtx, &set, present, GBL_TREE_SET_TEST_SUITE_KEYS_));
+
+    while(!GblTreeSet_empty(&set)) {
+        const uintptr_t min = *(uintptr_t*)GblTreeSet_min(&set);
+        const uintptr_t max = *(uintptr_t*)GblTreeSet_max(&set);
+
+        GBL_TEST_COMPARE(*(uintptr_t*)GblTreeSet_popMin(&set), min);
+        present[min] = GBL_FALSE;
+
+        if(min != max) {
+            GBL_TEST_COMPARE(*(uintptr_t*)GblTreeSet_popMax(&set), max);
+            present[max] = GBL_FALSE;
+        }
+    }
+
+    GBL_CTX_VERIFY_CALL(GblTreeSetTestSuite_verifyOrder_(pCtx, &set, present, GBL_TREE_SET_TEST_SUITE_KEYS_));
+    GBL_CTX_VERIFY_CALL(GblTreeSet_destruct(&set));
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblTreeSetTestSuite_range_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    GblTreeSet       set;
+    GblTreeSetCursor cursor;
+    uintptr_t        entries[1000];
+
+    for(size_t e = 0; e < GBL_COUNT_OF(entries); ++e)
+        entries[e] = e * 10;
+
+    GBL_CTX_VERIFY_CALL(GblTreeSet_construct(&set,
+                                             sizeof(uintptr_t),
+                                             GblTreeSetTestSuite_intComparator_,
+                                             NULL,
+                                             8));
+    GBL_CTX_VERIFY_CALL(GblTreeSet_load(&set, entries, GBL_COUNT_OF(entries)));
+
+    static const struct {
+        uintptr_t lower;
+        uintptr_t upper;
+        size_t    first;
+        size_t    count;
+    } ranges[] = {
+        { 0,    9990,  0,   1000 },
+        { 5,    95,    1,   9    },
+        { 100,  100,   10,  1    },
+        { 101,  109,   0,   0    },
+        { 2500, 7490,  250, 500  },
+        { 9990, 20000, 999, 1    },
+        { 20,   10,    0,   0    }
+    };
+
+    for(size_t r = 0; r < GBL_COUNT_OF(ranges); ++r) {
+        size_t count = GblTreeSet_countRange(&set, &ranges[r].lower, &ranges[r].upper);
+        GBL_TEST_COMPARE(count, ranges[r].count);
+
+        // one entry at a time
+        count = 0;
+        for(uintptr_t* pEntry = GblTreeSet_range(&set, &cursor, &ranges[r].lower, &ranges[r].upper);
+            pEntry;
+            pEntry = GblTreeSetCursor_next(&cursor))
+        {
+            GBL_TEST_COMPARE(*pEntry, entries[ranges[r].first + count]);
+            ++count;
+        }
+        GBL_TEST_COMPARE(count, ranges[r].count);
+
+        // one contiguous span at a time
+        count = 0;
+        GblTreeSet_range(&set, &cursor, &ranges[r].lower, &ranges[r].upper);
+        while(GblTreeSetCursor_valid(&cursor)) {
+            size_t     spanCount = 0;
+            uintptr_t* pSpan     = GblTreeSetCursor_span(&cursor, &spanCount);
+
+            GBL_TEST_VERIFY(spanCount);
+            for(size_t s = 0; s < spanCount; ++s)
+                GBL_TEST_COMPARE(pSpan[s], entries[ranges[r].first + count++]);
+        }
+        GBL_TEST_COMPARE(count, ranges[r].count);
+    }
+
+    // unbounded on either side
+    GBL_TEST_COMPARE(*(uintptr_t*)GblTreeSet_range(&set, &cursor, NULL, &entries[0]), 0);
+    GBL_TEST_COMPARE(GblTreeSetCursor_next(&cursor), NULL);
+    GBL_TEST_COMPARE(*(uintptr_t*)GblTreeSet_range(&set, &cursor, &entries[999], NULL), 9990);
+    GBL_TEST_COMPARE(GblTreeSetCursor_next(&cursor), NULL);
+    GBL_TEST_COMPARE(GblTreeSet_countRange(&set, NULL, NULL), 1000);
+
+    GBL_CTX_VERIFY_CALL(GblTreeSet_destruct(&set));
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblTreeSetTestSuite_eraseRange_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    GblTreeSet set;
+    GblBool    present[GBL_TREE_SET_TEST_SUITE_KEYS_];
+    uintptr_t* pEntries = GBL_CTX_MALLOC(sizeof(uintptr_t) * GBL_TREE_SET_TEST_SUITE_KEYS_);
+
+    for(size_t e = 0; e < GBL_TREE_SET_TEST_SUITE_KEYS_; ++e) {
+        pEntries[e] = e;
+        present[e]  = GBL_TRUE;
+    }
+
+    GBL_CTX_VERIFY_CALL(GblTreeSet_construct(&set,
+                                             sizeof(uintptr_t),
+                                             GblTreeSetTestSuite_intComparator_,
+                                             GblTreeSetTestSuite_intDestructor_,
+                                             6));
+    GBL_CTX_VERIFY_CALL(GblTreeSet_load(&set, pEntries, GBL_TREE_SET_TEST_SUITE_KEYS_));
+
+    static const struct {
+        uintptr_t lower;
+        uintptr_t upper;
+    } ranges[] = {
+        { 100,  119  },     // a few, one at a time
+        { 2000, 3999 },     // many, by rebuilding
+        { 0,    0    },
+        { 4990, 9999 },
+        { 50,   60   }
+    };
+
+    intDtorCount_ = 0;
+
+    for(size_t r = 0; r < GBL_COUNT_OF(ranges); ++r) {
+        size_t expected = 0;
+
+        for(uintptr_t k = ranges[r].lower; k <= ranges[r].upper && k < GBL_TREE_SET_TEST_SUITE_KEYS_; ++k) {
+            if(present[k]) ++expected;
+            present[k] = GBL_FALSE;
+        }
+
+        const size_t dtorCount = intDtorCount_;
+        const size_t erased    = GblTreeSet_eraseRange(&set, &ranges[r].lower, &ranges[r].upper);
+
+        GBL_TEST_COMPARE(erased, expected);
+        GBL_TEST_COMPARE(intDtorCount_ - dtorCount, expected);
+        GBL_CTX_VERIFY_CALL(GblTreeSetTestSuite_verifyOrder_(pCtx, &set, present, GBL_TREE_SET_TEST_SUITE_KEYS_));
+    }
+
+    // whatever is left
+    const size_t remaining = GblTreeSet_size(&set);
+    const size_t erased    = GblTreeSet_eraseRange(&set, NULL, NULL);
+    GBL_TEST_COMPARE(erased, remaining);
+    GBL_TEST_VERIFY(GblTreeSet_empty(&set));
+
+    GBL_CTX_VERIFY_CALL(GblTreeSet_destruct(&set));
+    GBL_CTX_FREE(pEntries);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblTreeSetTestSuite_windowProfile_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    GblTreeSet set;
+    GblTimer   timer;
+    uintptr_t* pEntries = GBL_CTX_MALLOC(sizeof(uintptr_t) * GBL_TREE_SET_TEST_SUITE_PROFILE_KEYS_);
+    size_t     total    = 0;
+
+    for(size_t e = 0; e < GBL_TREE_SET_TEST_SUITE_PROFILE_KEYS_; ++e)
+        pEntries[e] = e;
+
+    GBL_CTX_VERIFY_CALL(GblTreeSet_construct(&set, sizeof(uintptr_t), GblTreeSetTestSuite_intComparator_));
+
+    GblTimer_start(&timer);
+    for(size_t e = 0; e < GBL_TREE_SET_TEST_SUITE_PROFILE_KEYS_; ++e)
+        GblTreeSet_set(&set, &pEntries[e]);
+    GblTimer_stop(&timer);
+    GBL_CTX_INFO("%-24s: %10.3lf ms", "per-key set", GblTimer_elapsedMs(&timer));
+
+    GblTimer_start(&timer);
+    GBL_CTX_VERIFY_CALL(GblTreeSet_load(&set, pEntries, GBL_TREE_SET_TEST_SUITE_PROFILE_KEYS_));
+    GblTimer_stop(&timer);
+    GBL_CTX_INFO("%-24s: %10.3lf ms", "bulk load", GblTimer_elapsedMs(&timer));
+
+    // windows of 1000 keys, sliding by 100
+    GblTimer_start(&timer);
+    for(uintptr_t lower = 0; lower + 1000 < GBL_TREE_SET_TEST_SUITE_PROFILE_KEYS_; lower += 100) {
+        const uintptr_t upper = lower + 999;
+        for(uintptr_t k = lower; k <= upper; ++k)
+            total += GblTreeSet_get(&set, &k) != NULL;
+    }
+    GblTimer_stop(&timer);
+    GBL_CTX_INFO("%-24s: %10.3lf ms", "per-key window scan", GblTimer_elapsedMs(&timer));
+
+    GblTimer_start(&timer);
+    for(uintptr_t lower = 0; lower + 1000 < GBL_TREE_SET_TEST_SUITE_PROFILE_KEYS_; lower += 100) {
+        const uintptr_t  upper = lower + 999;
+        GblTreeSetCursor cursor;
+
+        GblTreeSet_range(&set, &cursor, &lower, &upper);
+        while(GblTreeSetCursor_valid(&cursor)) {
+            size_t spanCount;
+            GblTreeSetCursor_span(&cursor, &spanCount);
+            total -= spanCount;
+        }
+    }
+    GblTimer_stop(&timer);
+    GBL_CTX_INFO("%-24s: %10.3lf ms", "cursor window scan", GblTimer_elapsedMs(&timer));
+    GBL_TEST_COMPARE(total, 0);
+
+    GblTimer_start(&timer);
+    for(uintptr_t lower = 0; lower + 1000 < GBL_TREE_SET_TEST_SUITE_PROFILE_KEYS_; lower += 100) {
+        const uintptr_t upper = lower + 999;
+        total += GblTreeSet_countRange(&set, &lower, &upper);
+    }
+    GblTimer_stop(&timer);
+    GBL_CTX_INFO("%-24s: %10.3lf ms", "countRange window", GblTimer_elapsedMs(&timer));
+
+    GblTimer_start(&timer);
+    for(uintptr_t lower = 0; lower < GBL_TREE_SET_TEST_SUITE_PROFILE_KEYS_; lower += 1000) {
+        const uintptr_t upper = lower + 99;
+        total -= GblTreeSet_eraseRange(&set, &lower, &upper);
+    }
+    GblTimer_stop(&timer);
+    GBL_CTX_INFO("%-24s: %10.3lf ms", "eraseRange x200", GblTimer_elapsedMs(&timer));
+    GBL_TEST_COMPARE(GblTreeSet_size(&set), GBL_TREE_SET_TEST_SUITE_PROFILE_KEYS_ * 9 / 10);
+
+    GBL_CTX_VERIFY_CALL(GblTreeSet_destruct(&set));
+    GBL_CTX_FREE(pEntries);
+
+    GBL_CTX_END();
+}
+
 static GBL_RESULT GblTreeSetTestSuite_destruct_(GblTestSuite* pSelf, GblContext* pCtx) {
     GBL_CTX_BEGIN(pCtx);
     GblTreeSetTestSuite_* pSelf_ = GBL_TREE_SET_TEST_SUITE_(pSelf);
@@ -218,6 +605,12 @@ GBL_EXPORT GblType GblTreeSetTestSuite_type(void) {
         { "erase",              GblTreeSetTestSuite_erase_              },
         { "clear",              GblTreeSetTestSuite_clear_              },
         { "destruct",           GblTreeSetTestSuite_destruct_           },
+        { "loadInvalid",        GblTreeSetTestSuite_loadInvalid_        },
+        { "load",               GblTreeSetTestSuite_load_               },
+        { "rankSelect",         GblTreeSetTestSuite_rankSelect_         },
+        { "range",              GblTreeSetTestSuite_range_              },
+        { "eraseRange",         GblTreeSetTestSuite_eraseRange_         },
+        { "windowProfile",      GblTreeSetTestSuite_windowProfile_      },
         { NULL,                 NULL                                    }
     };
 
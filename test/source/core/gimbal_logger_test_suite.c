@@ -0,0 +1,310 @@
+#include <gimbal/test/gimbal_test_macros.h>
+#include <gimbal/core/gimbal_logger.h>
+#include <gimbal/core/gimbal_thread.h>
+#include <gimbal/utils/gimbal_timer.h>
+#include "core/gimbal_logger_test_suite.h"
+
+#define LOG_DOMAIN_             "AsyncLog"
+#define THREAD_COUNT_           2
+#define THREAD_MESSAGES_        1000
+#define OVERFLOW_MESSAGES_      2000
+#define PROFILE_MESSAGES_       20000
+
+#define GBL_SELF_TYPE GblLoggerTestSuite
+
+GBL_TEST_FIXTURE {
+    GblLogger* pLogger;
+    GblType    loggerType;
+};
+
+// Only ever touched from within dispatch, which is serialized
+static struct {
+    size_t count;
+    size_t outOfOrder;
+    size_t pushes;
+    size_t pops;
+    size_t lastDepth;
+    size_t next[THREAD_COUNT_ + 1];
+    char   last[64];
+} capture_;
+
+static GBL_RESULT GblLoggerTestSuite_write_(GblLogger*    pSelf,
+                                            const char*   pFile,
+                                            const char*   pFunction,
+                                            size_t        line,
+                                            GblThd*       pThread,
+                                            time_t        timeStamp,
+                                            const char*   pDomain,
+                                            GBL_LOG_FLAGS flags,
+                                            const char*   pFmt,
+                                            va_list       varArgs) {
+    GBL_UNUSED(pSelf, pFile, pFunction, line, pThread, timeStamp, flags);
+
+    if(!pDomain || strcmp(pDomain, LOG_DOMAIN_) != 0)
+        return GBL_RESULT_SUCCESS;
+
+    vsnprintf(capture_.last, sizeof(capture_.last), pFmt, varArgs);
+
+    // Messages are "<source> <sequence>", which must never arrive out of order
+    unsigned source   = 0;
+    size_t   sequence = 0;
+    if(sscanf(capture_.last, "%u %zu", &source, &sequence) == 2 &&
+       source <= THREAD_COUNT_) {
+        if(sequence < capture_.next[source])
+            ++capture_.outOfOrder;
+        capture_.next[source] = sequence + 1;
+    }
+
+    capture_.lastDepth = GblLogger_depth();
+    ++capture_.count;
+
+    return GBL_RESULT_SUCCESS;
+}
+
+static GBL_RESULT GblLoggerTestSuite_push_(GblLogger* pSelf, GblThd* pThread) {
+    GBL_UNUSED(pSelf, pThread);
+    ++capture_.pushes;
+    return GBL_RESULT_SUCCESS;
+}
+
+static GBL_RESULT GblLoggerTestSuite_pop_(GblLogger* pSelf, GblThd* pThread, size_t count) {
+    GBL_UNUSED(pSelf, pThread);
+    capture_.pops += count;
+    return GBL_RESULT_SUCCESS;
+}
+
+static GBL_RESULT GblLoggerTestSuite_loggerClassInit_(GblClass* pClass, const void* pUd) {
+    GBL_UNUSED(pUd);
+
+    GBL_LOGGER_CLASS(pClass)->pFnWrite = GblLoggerTestSuite_write_;
+    GBL_LOGGER_CLASS(pClass)->pFnPush  = GblLoggerTestSuite_push_;
+    GBL_LOGGER_CLASS(pClass)->pFnPop   = GblLoggerTestSuite_pop_;
+
+    return GBL_RESULT_SUCCESS;
+}
+
+static void GblLoggerTestSuite_reset_(void) {
+    memset(&capture_, 0, sizeof(capture_));
+}
+
+static GBL_RESULT GblLoggerTestSuite_writeThread_(GblThread* pThread) {
+    const unsigned source = (unsigned)(uintptr_t)GblBox_userdata(GBL_BOX(pThread));
+
+    for(size_t m = 0; m < THREAD_MESSAGES_; ++m)
+        GblLogger_write(__FILE__, __func__, __LINE__,
+                        LOG_DOMAIN_, GBL_LOG_INFO,
+                        "%u %zu", source, m);
+
+    return GBL_RESULT_SUCCESS;
+}
+
+static GBL_RESULT GblLoggerTestSuite_writeOverflow_(GblTestFixture* pFixture,
+                                                    GblContext*     pCtx,
+                                                    GBL_LOG_OVERFLOW overflow) {
+    GBL_UNUSED(pFixture);
+    GBL_CTX_BEGIN(pCtx);
+
+    const GblLoggerAsyncConfig config = {
+        .bufferSize = 1024,
+        .overflow   = overflow
+    };
+
+    GBL_TEST_CALL(GblLogger_startAsync(&config));
+
+    GblLoggerTestSuite_reset_();
+    const size_t dropped = GblLogger_asyncDropped();
+
+    // Write from a new thread, which gets a ring of the new size
+    GblThread* pThread = GblThread_create(GblLoggerTestSuite_writeThread_,
+                                          (void*)(uintptr_t)1);
+    GBL_TEST_VERIFY(pThread);
+    GblThread_join(pThread);
+    GblThread_unref(pThread);
+
+    GBL_TEST_CALL(GblLogger_flush());
+
+    const size_t lost = GblLogger_asyncDropped() - dropped;
+    GBL_TEST_COMPARE(capture_.count + lost, THREAD_MESSAGES_);
+
+    if(overflow == GBL_LOG_OVERFLOW_BLOCK) {
+        GBL_TEST_COMPARE(lost, 0);
+        GBL_TEST_COMPARE(capture_.outOfOrder, 0);
+    }
+
+    GBL_CTX_END();
+}
+
+GBL_TEST_INIT()
+    static const GblTypeInfo info = {
+        .classSize    = sizeof(GblLoggerClass),
+        .pFnClassInit = GblLoggerTestSuite_loggerClassInit_,
+        .instanceSize = sizeof(GblLogger)
+    };
+
+    pFixture->loggerType = GblType_register(GblQuark_internStatic("GblLoggerTestLogger"),
+                                            GBL_LOGGER_TYPE,
+                                            &info,
+                                            GBL_TYPE_FLAG_TYPEINFO_STATIC);
+    GBL_TEST_VERIFY(pFixture->loggerType != GBL_INVALID_TYPE);
+
+    pFixture->pLogger = GBL_LOGGER(GblObject_create(pFixture->loggerType, NULL));
+    GBL_TEST_VERIFY(pFixture->pLogger);
+
+    GBL_TEST_CALL(GblLogger_register(pFixture->pLogger));
+    GblLoggerTestSuite_reset_();
+GBL_TEST_CASE_END
+
+GBL_TEST_FINAL()
+    GBL_TEST_CALL(GblLogger_stopAsync());
+    GBL_TEST_CALL(GblLogger_unregister(pFixture->pLogger));
+    GBL_TEST_COMPARE(GblLogger_unref(pFixture->pLogger), 0);
+    GBL_TEST_CALL(GblType_unregister(pFixture->loggerType));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(writeSync)
+    GBL_TEST_VERIFY(!GblLogger_isAsync());
+
+    GblLogger_write(__FILE__, __func__, __LINE__,
+                    LOG_DOMAIN_, GBL_LOG_INFO,
+                    "%u %zu", 0, (size_t)0);
+
+    GBL_TEST_COMPARE(capture_.count, 1);
+    GBL_TEST_COMPARE(capture_.last, "0 0");
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(startAsync)
+    GBL_TEST_CALL(GblLogger_startAsync(NULL));
+    GBL_TEST_VERIFY(GblLogger_isAsync());
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(writeAsync)
+    GblLoggerTestSuite_reset_();
+
+    for(size_t m = 0; m < 3; ++m)
+        GblLogger_write(__FILE__, __func__, __LINE__,
+                        LOG_DOMAIN_, GBL_LOG_INFO,
+                        "%u %zu", 0, m);
+
+    GBL_TEST_CALL(GblLogger_push());
+
+    GblLogger_write(__FILE__, __func__, __LINE__,
+                    LOG_DOMAIN_, GBL_LOG_INFO,
+                    "%u %zu", 0, (size_t)3);
+
+    GBL_TEST_CALL(GblLogger_pop(1));
+    GBL_TEST_CALL(GblLogger_flush());
+
+    GBL_TEST_COMPARE(capture_.count, 4);
+    GBL_TEST_COMPARE(capture_.outOfOrder, 0);
+    GBL_TEST_COMPARE(capture_.last, "0 3");
+    GBL_TEST_COMPARE(capture_.lastDepth, 1);
+    GBL_TEST_COMPARE(capture_.pushes, 1);
+    GBL_TEST_COMPARE(capture_.pops, 1);
+    GBL_TEST_COMPARE(GblLogger_depth(), 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(writeAsyncThreads)
+    const GblLoggerAsyncConfig config = {
+        .flushMs  = 1,
+        .overflow = GBL_LOG_OVERFLOW_BLOCK
+    };
+
+    GblThread* pThreads[THREAD_COUNT_];
+
+    GBL_TEST_CALL(GblLogger_startAsync(&config));
+    GblLoggerTestSuite_reset_();
+
+    for(size_t t = 0; t < THREAD_COUNT_; ++t) {
+        pThreads[t] = GblThread_create(GblLoggerTestSuite_writeThread_,
+                                       (void*)(uintptr_t)(t + 1));
+        GBL_TEST_VERIFY(pThreads[t]);
+    }
+
+    for(size_t t = 0; t < THREAD_COUNT_; ++t) {
+        GblThread_join(pThreads[t]);
+        GblThread_unref(pThreads[t]);
+    }
+
+    // Threads have exited, but their buffers are still drained
+    GBL_TEST_CALL(GblLogger_flush());
+
+    GBL_TEST_COMPARE(capture_.count, THREAD_COUNT_ * THREAD_MESSAGES_);
+    GBL_TEST_COMPARE(capture_.outOfOrder, 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(overflowDrop)
+    GBL_TEST_CALL(GblLoggerTestSuite_writeOverflow_(pFixture,
+                                                    pCtx,
+                                                    GBL_LOG_OVERFLOW_DROP));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(overflowBlock)
+    GBL_TEST_CALL(GblLoggerTestSuite_writeOverflow_(pFixture,
+                                                    pCtx,
+                                                    GBL_LOG_OVERFLOW_BLOCK));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(stopAsync)
+    const GblLoggerAsyncConfig config = {
+        .bufferSize = 4096,
+        .overflow   = GBL_LOG_OVERFLOW_BLOCK
+    };
+
+    GBL_TEST_CALL(GblLogger_startAsync(&config));
+    GblLoggerTestSuite_reset_();
+
+    for(size_t m = 0; m < 10; ++m)
+        GblLogger_write(__FILE__, __func__, __LINE__,
+                        LOG_DOMAIN_, GBL_LOG_INFO,
+                        "%u %zu", 0, m);
+
+    // Stopping drains whatever's still buffered
+    GBL_TEST_CALL(GblLogger_stopAsync());
+    GBL_TEST_VERIFY(!GblLogger_isAsync());
+    GBL_TEST_COMPARE(capture_.count, 10);
+
+    GblLogger_write(__FILE__, __func__, __LINE__,
+                    LOG_DOMAIN_, GBL_LOG_INFO,
+                    "%u %zu", 0, (size_t)10);
+
+    GBL_TEST_COMPARE(capture_.count, 11);
+    GBL_TEST_COMPARE(capture_.outOfOrder, 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(writeProfile)
+    const GblLoggerAsyncConfig config = {
+        .bufferSize = 65536,
+        .flushMs    = 10,
+        .overflow   = GBL_LOG_OVERFLOW_BLOCK
+    };
+
+    for(size_t async = 0; async <= 1; ++async) {
+        GblTimer timer;
+
+        if(async) GBL_TEST_CALL(GblLogger_startAsync(&config));
+
+        GblTimer_start(&timer);
+
+        for(size_t m = 0; m < PROFILE_MESSAGES_; ++m)
+            GblLogger_write(__FILE__, __func__, __LINE__,
+                            LOG_DOMAIN_, GBL_LOG_INFO,
+                            "Profiling message %zu", m);
+
+        GblTimer_stop(&timer);
+
+        GBL_TEST_CALL(GblLogger_stopAsync());
+
+        GBL_CTX_INFO("%5s: %10.0lf writes/ms",
+                     async? "async" : "sync",
+                     PROFILE_MESSAGES_ / GblTimer_elapsedMs(&timer));
+    }
+GBL_TEST_CASE_END
+
+GBL_TEST_REGISTER(writeSync,
+                  startAsync,
+                  writeAsync,
+                  writeAsyncThreads,
+                  overflowDrop,
+                  overflowBlock,
+                  stopAsync,
+                  writeProfile)
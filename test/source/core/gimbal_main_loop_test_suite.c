@@ -0,0 +1,448 @@
+#include "core/gimbal_main_loop_test_suite.h"
+#include <gimbal/test/gimbal_test_macros.h>
+#include <gimbal/core/gimbal_main_loop.h>
+#include <gimbal/core/gimbal_thread.h>
+#include <gimbal/utils/gimbal_ref.h>
+#include <gimbal/utils/gimbal_timer.h>
+
+#include <tinycthread.h>
+#include <stdatomic.h>
+
+#define GBL_SELF_TYPE GblMainLoopTestSuite
+
+#define GBL_MAIN_LOOP_TEST_WORKERS_         4
+#define GBL_MAIN_LOOP_TEST_SPAWN_DEPTH_     14
+#define GBL_MAIN_LOOP_TEST_TIMER_FIRES_     3
+#define GBL_MAIN_LOOP_TEST_IDLE_FIRES_      5
+
+GBL_TEST_FIXTURE {
+    size_t       refCount;
+    size_t       taskCount;
+    GblMainLoop* pPool;
+    GblMainLoop* pLoop;
+    char         order[16];
+    atomic_size_t orderCount;
+    size_t       timerFires;
+    size_t       idleFires;
+    size_t       idleSignals;
+};
+
+static GblMainLoop*  pSpawnLoop_  = NULL;
+static atomic_size_t spawnCount_;
+
+GBL_TEST_INIT()
+    pFixture->refCount  = GblRef_activeCount();
+    pFixture->taskCount = GblType_instanceCount(GBL_TASK_TYPE);
+GBL_TEST_CASE_END
+
+GBL_TEST_FINAL()
+    GBL_TEST_COMPARE(GblRef_activeCount(), pFixture->refCount);
+    GBL_TEST_COMPARE(GblType_instanceCount(GBL_TASK_TYPE), pFixture->taskCount);
+GBL_TEST_CASE_END
+
+// Appends the first letter of the task's name, to check the order tasks ran in
+static GBL_RESULT record_(GblTask* pSelf) {
+    GblMainLoopTestSuite_* pFixture = GblBox_userdata(GBL_BOX(pSelf));
+
+    const size_t index = atomic_fetch_add(&pFixture->orderCount, 1);
+
+    if(index < sizeof(pFixture->order) - 1)
+        pFixture->order[index] = GblObject_name(GBL_OBJECT(pSelf))[0];
+
+    return GBL_RESULT_SUCCESS;
+}
+
+static GBL_RESULT fail_(GblTask* pSelf) {
+    record_(pSelf);
+    return GBL_RESULT_ERROR_INVALID_OPERATION;
+}
+
+static GBL_RESULT spinUntilCanceled_(GblTask* pSelf) {
+    while(!GblTask_isCanceled(pSelf))
+        thrd_yield();
+
+    return GBL_RESULT_SUCCESS;
+}
+
+static GblTask* newTask_(GblMainLoopTestSuite_* pFixture, const char* pName, GblTaskFn pFn) {
+    return GBL_NEW(GblTask,
+                   "name",     pName,
+                   "callback", pFn,
+                   "userdata", pFixture);
+}
+
+static void resetOrder_(GblMainLoopTestSuite_* pFixture) {
+    memset(pFixture->order, 0, sizeof(pFixture->order));
+    atomic_store(&pFixture->orderCount, 0);
+}
+
+GBL_TEST_CASE(create)
+    pFixture->pPool = GblMainLoop_create(GBL_MAIN_LOOP_TEST_WORKERS_);
+    pFixture->pLoop = GblMainLoop_create(0);
+
+    GBL_TEST_VERIFY(pFixture->pPool);
+    GBL_TEST_VERIFY(pFixture->pLoop);
+
+    GBL_TEST_COMPARE(GblMainLoop_workerCount(pFixture->pPool), GBL_MAIN_LOOP_TEST_WORKERS_);
+    GBL_TEST_COMPARE(GblMainLoop_workerCount(pFixture->pLoop), 0);
+
+    size_t workerCount = 0;
+    GBL_TEST_CALL(GblObject_property(GBL_OBJECT(pFixture->pPool), "workerCount", &workerCount));
+    GBL_TEST_COMPARE(workerCount, GBL_MAIN_LOOP_TEST_WORKERS_);
+
+    GBL_TEST_COMPARE(GblMainLoop_depth(pFixture->pPool), 0);
+    GBL_TEST_VERIFY(!GblMainLoop_isRunning(pFixture->pPool));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(enqueueWait)
+    resetOrder_(pFixture);
+
+    GblTask* pTask = newTask_(pFixture, "a", record_);
+
+    GBL_TEST_COMPARE(GblTask_state(pTask), GBL_TASK_STATE_PENDING);
+    GBL_TEST_COMPARE(GblTask_result(pTask), GBL_RESULT_UNKNOWN);
+
+    GBL_TEST_CALL(GblMainLoop_enqueue(pFixture->pPool, pTask));
+    GBL_TEST_CALL(GblTask_wait(pTask));
+
+    GBL_TEST_COMPARE(GblTask_state(pTask), GBL_TASK_STATE_FINISHED);
+    GBL_TEST_COMPARE(GblTask_result(pTask), GBL_RESULT_SUCCESS);
+    GBL_TEST_VERIFY(GblTask_isDone(pTask));
+    GBL_TEST_COMPARE(pFixture->order, "a");
+
+    // can only be scheduled once
+    GBL_TEST_EXPECT_ERROR();
+    GblMainLoop_enqueue(pFixture->pPool, pTask);
+    GBL_TEST_COMPARE(GBL_CTX_LAST_RESULT(), GBL_RESULT_ERROR_INVALID_OPERATION);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GblTask_unref(pTask);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(waitWithoutWorkers)
+    resetOrder_(pFixture);
+
+    GblTask* pTask = newTask_(pFixture, "a", record_);
+
+    GBL_TEST_CALL(GblMainLoop_enqueue(pFixture->pLoop, pTask));
+    GBL_TEST_COMPARE(GblTask_state(pTask), GBL_TASK_STATE_QUEUED);
+    GBL_TEST_COMPARE(GblMainLoop_depth(pFixture->pLoop), 1);
+
+    // the waiting thread runs it itself
+    GBL_TEST_CALL(GblTask_wait(pTask));
+    GBL_TEST_COMPARE(pFixture->order, "a");
+    GBL_TEST_COMPARE(GblMainLoop_depth(pFixture->pLoop), 0);
+
+    GblTask_unref(pTask);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(priorities)
+    resetOrder_(pFixture);
+
+    GblTask* pTasks[] = {
+        newTask_(pFixture, "i", record_),
+        newTask_(pFixture, "l", record_),
+        newTask_(pFixture, "d", record_),
+        newTask_(pFixture, "h", record_)
+    };
+
+    GblTask_setPriority(pTasks[0], GBL_PRIORITY_IDLE);
+    GblTask_setPriority(pTasks[1], GBL_PRIORITY_LOW);
+    GBL_TEST_CALL(GblObject_setProperty(GBL_OBJECT(pTasks[3]), "priority", GBL_PRIORITY_HIGH));
+
+    GBL_TEST_COMPARE((int)GblTask_priority(pTasks[2]), (int)GBL_PRIORITY_DEFAULT);
+    GBL_TEST_COMPARE((int)GblTask_priority(pTasks[3]), (int)GBL_PRIORITY_HIGH);
+
+    for(size_t t = 0; t < GBL_COUNT_OF(pTasks); ++t)
+        GBL_TEST_CALL(GblMainLoop_enqueue(pFixture->pLoop, pTasks[t]));
+
+    GBL_TEST_CALL(GblMainLoop_iteration(pFixture->pLoop));
+
+    GBL_TEST_COMPARE(pFixture->order, "hdli");
+
+    for(size_t t = 0; t < GBL_COUNT_OF(pTasks); ++t)
+        GblTask_unref(pTasks[t]);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(continuations)
+    resetOrder_(pFixture);
+
+    GblTask* pA = newTask_(pFixture, "a", record_);
+    GblTask* pB = newTask_(pFixture, "b", record_);
+    GblTask* pC = newTask_(pFixture, "c", record_);
+
+    GBL_TEST_CALL(GblTask_then(pA, pB));
+    GBL_TEST_CALL(GblTask_then(pB, pC));
+
+    // enqueued backwards, but still has to run in order
+    GBL_TEST_CALL(GblMainLoop_enqueue(pFixture->pPool, pC));
+    GBL_TEST_CALL(GblMainLoop_enqueue(pFixture->pPool, pB));
+
+    GBL_TEST_COMPARE(GblTask_state(pC), GBL_TASK_STATE_PENDING);
+    GBL_TEST_COMPARE(GblTask_state(pB), GBL_TASK_STATE_PENDING);
+
+    GBL_TEST_CALL(GblMainLoop_enqueue(pFixture->pPool, pA));
+    GBL_TEST_CALL(GblTask_wait(pC));
+
+    GBL_TEST_COMPARE(pFixture->order, "abc");
+
+    GblTask_unref(pA);
+    GblTask_unref(pB);
+    GblTask_unref(pC);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(continuationsCanceled)
+    resetOrder_(pFixture);
+
+    GblTask* pA = newTask_(pFixture, "a", fail_);
+    GblTask* pB = newTask_(pFixture, "b", record_);
+    GblTask* pC = newTask_(pFixture, "c", record_);
+
+    GBL_TEST_CALL(GblTask_then(pA, pB));
+    GBL_TEST_CALL(GblTask_then(pB, pC));
+
+    GBL_TEST_CALL(GblMainLoop_enqueue(pFixture->pPool, pA));
+    GBL_TEST_CALL(GblMainLoop_enqueue(pFixture->pPool, pB));
+    GBL_TEST_CALL(GblMainLoop_enqueue(pFixture->pPool, pC));
+
+    GBL_TEST_EXPECT_ERROR();
+    GBL_RESULT result = GblTask_wait(pA);
+    GBL_TEST_COMPARE(result, GBL_RESULT_ERROR_INVALID_OPERATION);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    result = GblTask_wait(pC);
+    GBL_TEST_COMPARE(result, GBL_RESULT_INCOMPLETE);
+
+    GBL_TEST_COMPARE(GblTask_state(pA), GBL_TASK_STATE_FINISHED);
+    GBL_TEST_COMPARE(GblTask_state(pB), GBL_TASK_STATE_CANCELED);
+    GBL_TEST_COMPARE(GblTask_state(pC), GBL_TASK_STATE_CANCELED);
+    GBL_TEST_COMPARE(pFixture->order, "a");
+
+    // chaining onto a failed task cancels right away
+    GblTask* pD = newTask_(pFixture, "d", record_);
+    GBL_TEST_CALL(GblTask_then(pA, pD));
+    GBL_TEST_COMPARE(GblTask_state(pD), GBL_TASK_STATE_CANCELED);
+
+    GblTask_unref(pA);
+    GblTask_unref(pB);
+    GblTask_unref(pC);
+    GblTask_unref(pD);
+GBL_TEST_CASE_END
+
+static GblTask* pWaitOuter_ = NULL;
+
+static GBL_RESULT waitOuter_(GblTask* pSelf) {
+    record_(pSelf);
+    return GblTask_wait(pWaitOuter_);
+}
+
+static GBL_RESULT waitInner_(GblTask* pSelf) {
+    GblMainLoopTestSuite_* pFixture = GblBox_userdata(GBL_BOX(pSelf));
+    GblTask*               pInner   = newTask_(pFixture, "i", waitOuter_);
+
+    record_(pSelf);
+    GblMainLoop_enqueue(pFixture->pLoop, pInner);
+
+    const GBL_RESULT result = GblTask_wait(pInner);
+
+    GblTask_unref(pInner);
+    return result;
+}
+
+GBL_TEST_CASE(waitSuspended)
+    resetOrder_(pFixture);
+
+    pWaitOuter_ = newTask_(pFixture, "o", waitInner_);
+    GBL_TEST_CALL(GblMainLoop_enqueue(pFixture->pLoop, pWaitOuter_));
+
+    // The inner task runs while helping the outer one wait, so it can't wait on it in turn
+    GBL_TEST_EXPECT_ERROR();
+    GBL_TEST_COMPARE(GblTask_wait(pWaitOuter_), GBL_RESULT_ERROR_INVALID_OPERATION);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_TEST_COMPARE(pFixture->order, "oi");
+    GBL_TEST_COMPARE(GblTask_state(pWaitOuter_), GBL_TASK_STATE_FINISHED);
+
+    GblTask_unref(pWaitOuter_);
+    pWaitOuter_ = NULL;
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(cancelQueued)
+    resetOrder_(pFixture);
+
+    GblTask* pTask = newTask_(pFixture, "a", record_);
+
+    GBL_TEST_CALL(GblMainLoop_enqueue(pFixture->pLoop, pTask));
+    GBL_TEST_CALL(GblMainLoop_cancel(pFixture->pLoop, pTask));
+
+    GBL_TEST_COMPARE(GblTask_state(pTask), GBL_TASK_STATE_CANCELED);
+    GBL_TEST_VERIFY(GblTask_isCanceled(pTask));
+
+    GBL_TEST_CALL(GblMainLoop_iteration(pFixture->pLoop));
+
+    GBL_TEST_COMPARE(GblMainLoop_depth(pFixture->pLoop), 0);
+    GBL_TEST_COMPARE(pFixture->order, "");
+
+    GBL_TEST_EXPECT_ERROR();
+    GblTask_cancel(pTask);
+    GBL_TEST_COMPARE(GBL_CTX_LAST_RESULT(), GBL_RESULT_ERROR_INVALID_OPERATION);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GblTask_unref(pTask);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(cancelRunning)
+    GblTask* pTask = newTask_(pFixture, "a", spinUntilCanceled_);
+
+    GBL_TEST_CALL(GblMainLoop_enqueue(pFixture->pPool, pTask));
+
+    while(GblTask_state(pTask) != GBL_TASK_STATE_RUNNING)
+        thrd_yield();
+
+    GBL_TEST_CALL(GblTask_cancel(pTask));
+
+    const GBL_RESULT result = GblTask_wait(pTask);
+    GBL_TEST_COMPARE(result, GBL_RESULT_INCOMPLETE);
+    GBL_TEST_COMPARE(GblTask_state(pTask), GBL_TASK_STATE_CANCELED);
+
+    GblTask_unref(pTask);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(timeout)
+    resetOrder_(pFixture);
+
+    GblTask* pTask = newTask_(pFixture, "a", record_);
+
+    GBL_TEST_CALL(GblTask_setTimeout(pTask, 1));
+    GBL_TEST_COMPARE(GblTask_timeout(pTask), 1);
+
+    GBL_TEST_CALL(GblMainLoop_enqueue(pFixture->pLoop, pTask));
+
+    GBL_TEST_EXPECT_ERROR();
+    GblTask_setTimeout(pTask, 2);
+    GBL_TEST_COMPARE(GBL_CTX_LAST_RESULT(), GBL_RESULT_ERROR_INVALID_OPERATION);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    // nobody picks it up before its deadline
+    GblThread_nanoSleep(5000000);
+
+    const GBL_RESULT result = GblTask_wait(pTask);
+    GBL_TEST_COMPARE(result, GBL_RESULT_TIMEOUT);
+    GBL_TEST_COMPARE(GblTask_state(pTask), GBL_TASK_STATE_TIMED_OUT);
+    GBL_TEST_COMPARE(pFixture->order, "");
+
+    GblTask_unref(pTask);
+GBL_TEST_CASE_END
+
+static GblBool onTimer_(GblMainLoop* pLoop, void* pUserdata) {
+    GblMainLoopTestSuite_* pFixture = pUserdata;
+
+    if(++pFixture->timerFires < GBL_MAIN_LOOP_TEST_TIMER_FIRES_)
+        return GBL_TRUE;
+
+    GblMainLoop_stop(pLoop);
+    return GBL_FALSE;
+}
+
+static GblBool onIdle_(GblMainLoop* pLoop, void* pUserdata) {
+    GBL_UNUSED(pLoop);
+    GblMainLoopTestSuite_* pFixture = pUserdata;
+
+    return ++pFixture->idleFires < GBL_MAIN_LOOP_TEST_IDLE_FIRES_;
+}
+
+static void onExecIdle_(GblMainLoop* pLoop) {
+    GblMainLoopTestSuite_* pFixture = GblClosure_currentUserdata();
+    GBL_UNUSED(pLoop);
+    ++pFixture->idleSignals;
+}
+
+GBL_TEST_CASE(timersAndIdle)
+    const size_t timerId = GblMainLoop_addTimer(pFixture->pLoop, 1, onTimer_, pFixture);
+    const size_t idleId  = GblMainLoop_addIdle(pFixture->pLoop, onIdle_, pFixture);
+
+    GBL_TEST_VERIFY(timerId);
+    GBL_TEST_VERIFY(idleId);
+    GBL_TEST_VERIFY(timerId != idleId);
+
+    GBL_CONNECT(pFixture->pLoop, "execIdle", pFixture->pLoop, onExecIdle_, pFixture);
+
+    GBL_TEST_CALL(GblMainLoop_exec(pFixture->pLoop));
+
+    GBL_TEST_VERIFY(!GblMainLoop_isRunning(pFixture->pLoop));
+    GBL_TEST_COMPARE(pFixture->timerFires, GBL_MAIN_LOOP_TEST_TIMER_FIRES_);
+    GBL_TEST_COMPARE(pFixture->idleFires, GBL_MAIN_LOOP_TEST_IDLE_FIRES_);
+    GBL_TEST_VERIFY(pFixture->idleSignals);
+
+    // both sources removed themselves
+    GBL_TEST_VERIFY(!GblMainLoop_removeSource(pFixture->pLoop, timerId));
+    GBL_TEST_VERIFY(!GblMainLoop_removeSource(pFixture->pLoop, idleId));
+
+    const size_t id = GblMainLoop_addIdle(pFixture->pLoop, onIdle_, pFixture);
+    GBL_TEST_VERIFY(GblMainLoop_removeSource(pFixture->pLoop, id));
+    GBL_TEST_VERIFY(!GblMainLoop_removeSource(pFixture->pLoop, id));
+
+    GblSignal_disconnect(GBL_INSTANCE(pFixture->pLoop), "execIdle", NULL, NULL);
+GBL_TEST_CASE_END
+
+// Recursively fans out into two children per level, enqueued from the worker running it
+static GBL_RESULT spawn_(GblTask* pSelf) {
+    const uintptr_t depth = (uintptr_t)GblBox_userdata(GBL_BOX(pSelf));
+
+    atomic_fetch_add_explicit(&spawnCount_, 1, memory_order_relaxed);
+
+    if(depth) {
+        for(size_t c = 0; c < 2; ++c) {
+            GblTask* pChild = GblTask_create(spawn_, (void*)(depth - 1));
+            GblMainLoop_enqueue(pSpawnLoop_, pChild);
+            GblTask_unref(pChild);
+        }
+    }
+
+    return GBL_RESULT_SUCCESS;
+}
+
+GBL_TEST_CASE(workStealingProfile)
+    const size_t total = (2u << GBL_MAIN_LOOP_TEST_SPAWN_DEPTH_) - 1;
+
+    pSpawnLoop_ = pFixture->pPool;
+    atomic_store(&spawnCount_, 0);
+
+    GblTask* pRoot = GblTask_create(spawn_, (void*)(uintptr_t)GBL_MAIN_LOOP_TEST_SPAWN_DEPTH_);
+
+    GblTimer timer;
+    GblTimer_start(&timer);
+
+    GBL_TEST_CALL(GblMainLoop_enqueue(pFixture->pPool, pRoot));
+    GBL_TEST_CALL(GblMainLoop_waitAll(pFixture->pPool));
+
+    GblTimer_stop(&timer);
+
+    GBL_CTX_INFO("%zu workers: %10.0lf tasks/ms",
+                 (size_t)GBL_MAIN_LOOP_TEST_WORKERS_,
+                 (double)total / GblTimer_elapsedMs(&timer));
+
+    GBL_TEST_COMPARE(atomic_load(&spawnCount_), total);
+    GBL_TEST_COMPARE(GblMainLoop_depth(pFixture->pPool), 0);
+
+    GblTask_unref(pRoot);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(unref)
+    GBL_TEST_COMPARE(GblMainLoop_unref(pFixture->pPool), 0u);
+    GBL_TEST_COMPARE(GblMainLoop_unref(pFixture->pLoop), 0u);
+GBL_TEST_CASE_END
+
+GBL_TEST_REGISTER(create,
+                  enqueueWait,
+                  waitWithoutWorkers,
+                  priorities,
+                  continuations,
+                  continuationsCanceled,
+                  waitSuspended,
+                  cancelQueued,
+                  cancelRunning,
+                  timeout,
+                  timersAndIdle,
+                  workStealingProfile,
+                  unref)
@@ -2,6 +2,7 @@
 #include <gimbal/test/gimbal_test_macros.h>
 #include <gimbal/core/gimbal_thread.h>
 #include <gimbal/utils/gimbal_ref.h>
+#include <gimbal/utils/gimbal_timer.h>
 
 #include <tinycthread.h>
 #include <stdatomic.h>
@@ -15,6 +16,9 @@
 
 #define GBL_TEST_THREAD_TLS_THREAD_COUNT_       5
 #define GBL_TEST_THREAD_TLS_WRITE_ITERATIONS_   10
+#define GBL_TEST_THREAD_QUEUED_EMISSIONS_       100
+#define GBL_TEST_THREAD_QUEUED_PRODUCERS_       4
+#define GBL_TEST_THREAD_QUEUED_PROFILE_EMITS_   10000
 
 GBL_CLASS_DERIVE(GblTestThread, GblThread)
     atomic_short runningCount;
@@ -58,6 +62,15 @@ GBL_TEST_FIXTURE {
 
     GblTestThread*   pTestThreads[GBL_TEST_THREAD_TLS_THREAD_COUNT_];
     volatile GblBool testThreadRan[GBL_TEST_THREAD_TLS_THREAD_COUNT_];
+
+    GblObject*       pQueuedReceiver;
+    GblThread*       pQueuedEmitter;
+    size_t           queuedCount;
+    size_t           queuedNext;
+    GblBool          queuedInOrder;
+    GblThread*       pQueuedThread;
+    GblInstance*     pQueuedEmitterSeen;
+    GblInstance*     pQueuedReceiverSeen;
 };
 
 static GblType GblTestThread_type(void);
@@ -395,6 +408,179 @@ GBL_TEST_CASE(tlsJoinThreads)
     }
 GBL_TEST_CASE_END
 
+static void queuedOnProgress_(GblInstance* pReceiver, size_t value) {
+    GblTestFixture* pFixture = GblClosure_currentUserdata();
+
+    if(value != pFixture->queuedNext++)
+        pFixture->queuedInOrder = GBL_FALSE;
+
+    ++pFixture->queuedCount;
+    pFixture->pQueuedThread       = GblThread_current();
+    pFixture->pQueuedEmitterSeen  = GblSignal_emitter();
+    pFixture->pQueuedReceiverSeen = pReceiver;
+}
+
+static GBL_RESULT queuedEmit_(GblThread* pSelf) {
+    const size_t count = (size_t)GblBox_userdata(GBL_BOX(pSelf));
+
+    for(size_t e = 0; e < count; ++e)
+        GBL_EMIT(pSelf, "progress", e);
+
+    return GBL_RESULT_SUCCESS;
+}
+
+GBL_TEST_CASE(queuedConnect)
+    GBL_TEST_CALL(GblSignal_install(GBL_THREAD_TYPE,
+                                    "progress",
+                                    GblMarshal_CClosure_VOID__INSTANCE_SIZE,
+                                    1,
+                                    GBL_SIZE_TYPE));
+
+    pFixture->pQueuedReceiver = GBL_NEW(GblObject, "name", "QueuedReceiver");
+    pFixture->pQueuedEmitter  = GblThread_create(queuedEmit_,
+                                                 (void*)(uintptr_t)GBL_TEST_THREAD_QUEUED_EMISSIONS_,
+                                                 GBL_FALSE);
+    pFixture->queuedInOrder   = GBL_TRUE;
+
+    // deliver to the thread making the connection: the main thread
+    GBL_TEST_CALL(GblSignal_connectQueued(GBL_INSTANCE(pFixture->pQueuedEmitter),
+                                          "progress",
+                                          GBL_INSTANCE(pFixture->pQueuedReceiver),
+                                          GBL_CALLBACK(queuedOnProgress_),
+                                          pFixture,
+                                          NULL));
+
+    GBL_TEST_COMPARE(GblSignal_connectionCount(GBL_INSTANCE(pFixture->pQueuedEmitter), "progress"), 1);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(queuedEmitCrossThread)
+    GBL_TEST_CALL(GblThread_start(pFixture->pQueuedEmitter));
+    // joining returns the thread's own exit code, so just check it joined
+    GblThread_join(pFixture->pQueuedEmitter);
+    GBL_TEST_VERIFY(GblThread_isJoined(pFixture->pQueuedEmitter));
+
+    // nothing runs until the receiving thread asks for it
+    GBL_TEST_COMPARE(pFixture->queuedCount, 0);
+    GBL_TEST_COMPARE(GblThread_pendingEvents(pFixture->pThreadMain),
+                     GBL_TEST_THREAD_QUEUED_EMISSIONS_);
+
+    // drain in batches
+    size_t processed = GblThread_processEvents(10);
+    GBL_TEST_COMPARE(processed, 10);
+    GBL_TEST_COMPARE(pFixture->queuedCount, 10);
+    GBL_TEST_COMPARE(GblThread_pendingEvents(pFixture->pThreadMain),
+                     GBL_TEST_THREAD_QUEUED_EMISSIONS_ - 10);
+
+    processed = GblThread_processEvents(0);
+    GBL_TEST_COMPARE(processed, GBL_TEST_THREAD_QUEUED_EMISSIONS_ - 10);
+    GBL_TEST_COMPARE(pFixture->queuedCount, GBL_TEST_THREAD_QUEUED_EMISSIONS_);
+    GBL_TEST_COMPARE(GblThread_pendingEvents(pFixture->pThreadMain), 0);
+
+    // delivered in emission order, on the receiver's thread, with the original emitter
+    GBL_TEST_VERIFY(pFixture->queuedInOrder);
+    GBL_TEST_COMPARE(pFixture->pQueuedThread, pFixture->pThreadMain);
+    GBL_TEST_COMPARE(pFixture->pQueuedEmitterSeen, GBL_INSTANCE(pFixture->pQueuedEmitter));
+    GBL_TEST_COMPARE(pFixture->pQueuedReceiverSeen, GBL_INSTANCE(pFixture->pQueuedReceiver));
+    GBL_TEST_COMPARE(GblSignal_emitter(), NULL);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(queuedEmitSameThread)
+    pFixture->queuedCount = 0;
+    pFixture->queuedNext  = 0;
+
+    // queued emissions are deferred even when emitted from the receiving thread
+    GBL_TEST_CALL(GBL_EMIT(pFixture->pQueuedEmitter, "progress", (size_t)0));
+    GBL_TEST_COMPARE(pFixture->queuedCount, 0);
+
+    const size_t processed = GblThread_processEvents(0);
+    GBL_TEST_COMPARE(processed, 1);
+    GBL_TEST_COMPARE(pFixture->queuedCount, 1);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(queuedDisconnect)
+    GBL_TEST_CALL(GBL_EMIT(pFixture->pQueuedEmitter, "progress", (size_t)1));
+    GBL_TEST_CALL(GBL_EMIT(pFixture->pQueuedEmitter, "progress", (size_t)2));
+
+    const size_t disconnected = GblSignal_disconnect(GBL_INSTANCE(pFixture->pQueuedEmitter),
+                                                     "progress",
+                                                     NULL,
+                                                     NULL);
+    GBL_TEST_COMPARE(disconnected, 1);
+
+    // pending emissions of disconnected connections are dropped
+    const size_t processed = GblThread_processEvents(0);
+    GBL_TEST_COMPARE(processed, 2);
+    GBL_TEST_COMPARE(pFixture->queuedCount, 1);
+    GBL_TEST_COMPARE(GblThread_pendingEvents(pFixture->pThreadMain), 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(queuedDestroyReceiver)
+    GBL_TEST_CALL(GblSignal_connectQueued(GBL_INSTANCE(pFixture->pQueuedEmitter),
+                                          "progress",
+                                          GBL_INSTANCE(pFixture->pQueuedReceiver),
+                                          GBL_CALLBACK(queuedOnProgress_),
+                                          pFixture,
+                                          NULL));
+
+    GBL_TEST_CALL(GBL_EMIT(pFixture->pQueuedEmitter, "progress", (size_t)1));
+
+    // destroying the receiver disconnects it, dropping what it hasn't received yet
+    GBL_UNREF(pFixture->pQueuedReceiver);
+    const size_t processed = GblThread_processEvents(0);
+    GBL_TEST_COMPARE(processed, 1);
+    GBL_TEST_COMPARE(pFixture->queuedCount, 1);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(queuedProfile)
+    GblThread* pProducers[GBL_TEST_THREAD_QUEUED_PRODUCERS_];
+    const size_t total = GBL_TEST_THREAD_QUEUED_PRODUCERS_ * GBL_TEST_THREAD_QUEUED_PROFILE_EMITS_;
+
+    pFixture->pQueuedReceiver = GBL_NEW(GblObject, "name", "QueuedReceiver");
+    pFixture->queuedCount     = 0;
+
+    for(size_t p = 0; p < GBL_TEST_THREAD_QUEUED_PRODUCERS_; ++p) {
+        pProducers[p] = GblThread_create(queuedEmit_,
+                                         (void*)(uintptr_t)GBL_TEST_THREAD_QUEUED_PROFILE_EMITS_,
+                                         GBL_FALSE);
+
+        GBL_TEST_CALL(GblSignal_connectQueued(GBL_INSTANCE(pProducers[p]),
+                                              "progress",
+                                              GBL_INSTANCE(pFixture->pQueuedReceiver),
+                                              GBL_CALLBACK(queuedOnProgress_),
+                                              pFixture,
+                                              NULL));
+    }
+
+    GblTimer timer;
+    GblTimer_start(&timer);
+
+    for(size_t p = 0; p < GBL_TEST_THREAD_QUEUED_PRODUCERS_; ++p)
+        GBL_TEST_CALL(GblThread_start(pProducers[p]));
+
+    // drain concurrently with the producers still posting
+    while(pFixture->queuedCount < total)
+        GblThread_processEvents(0);
+
+    GblTimer_stop(&timer);
+
+    GBL_CTX_INFO("%zu producers: %10.0lf queued emissions/ms",
+                 (size_t)GBL_TEST_THREAD_QUEUED_PRODUCERS_,
+                 (double)total / GblTimer_elapsedMs(&timer));
+
+    // every producer has to be done before any of them is destroyed and disconnected
+    for(size_t p = 0; p < GBL_TEST_THREAD_QUEUED_PRODUCERS_; ++p)
+        GblThread_join(pProducers[p]);
+
+    for(size_t p = 0; p < GBL_TEST_THREAD_QUEUED_PRODUCERS_; ++p)
+        GBL_UNREF(pProducers[p]);
+
+    GBL_TEST_COMPARE(pFixture->queuedCount, total);
+
+    GBL_UNREF(pFixture->pQueuedReceiver);
+    GBL_UNREF(pFixture->pQueuedEmitter);
+    GBL_TEST_CALL(GblSignal_uninstall(GBL_THREAD_TYPE, "progress"));
+GBL_TEST_CASE_END
+
 // Destroying a thread
 GBL_TEST_CASE(unref)
     // Allow runtime to reclaim thread's resources
@@ -416,4 +602,10 @@ GBL_TEST_REGISTER(new,
                   tlsInitAlignment,
                   tlsReadWrite,
                   tlsJoinThreads,
+                  queuedConnect,
+                  queuedEmitCrossThread,
+                  queuedEmitSameThread,
+                  queuedDisconnect,
+                  queuedDestroyReceiver,
+                  queuedProfile,
                   unref)
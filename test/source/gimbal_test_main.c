@@ -12,19 +12,25 @@
 #include "containers/gimbal_array_map_test_suite.h"
 #include "containers/gimbal_tree_set_test_suite.h"
 #include "containers/gimbal_hash_set_test_suite.h"
+#include "containers/gimbal_concurrent_hash_set_test_suite.h"
 #include "containers/gimbal_array_deque_test_suite.h"
 #include "containers/gimbal_array_heap_test_suite.h"
+#include "allocators/gimbal_allocation_tracker_test_suite.h"
 #include "allocators/gimbal_arena_allocator_test_suite.h"
 #include "allocators/gimbal_pool_allocator_test_suite.h"
 #include "allocators/gimbal_scope_allocator_test_suite.h"
+#include "allocators/gimbal_slab_allocator_test_suite.h"
 #include "utils/gimbal_ref_test_suite.h"
 #include "utils/gimbal_byte_array_test_suite.h"
+#include "utils/gimbal_byte_chain_test_suite.h"
+#include "utils/gimbal_settings_test_suite.h"
 #include "strings/gimbal_quark_test_suite.h"
 #include "strings/gimbal_string_view_test_suite.h"
 #include "strings/gimbal_string_ref_test_suite.h"
 #include "strings/gimbal_string_buffer_test_suite.h"
 #include "strings/gimbal_string_list_test_suite.h"
 #include "strings/gimbal_pattern_test_suite.h"
+#include "strings/gimbal_pattern_set_test_suite.h"
 #include "meta/types/gimbal_type_test_suite.h"
 #include "meta/classes/gimbal_class_test_suite.h"
 #include "meta/ifaces/gimbal_interface_test_suite.h"
@@ -45,8 +51,10 @@
 #include "utils/gimbal_cmd_parser_test_suite.h"
 #include "utils/gimbal_date_time_test_suite.h"
 #include "utils/gimbal_bit_view_test_suite.h"
+#include "core/gimbal_logger_test_suite.h"
 #include "core/gimbal_module_test_suite.h"
 #include "core/gimbal_thread_test_suite.h"
+#include "core/gimbal_main_loop_test_suite.h"
 #include "utils/gimbal_scanner_test_suite.h"
 #include "algorithms/gimbal_random_test_suite.h"
 #include "algorithms/gimbal_compression_test_suite.h"
@@ -170,20 +178,30 @@ int main(int argc, const char* pArgv[]) {
                                  GblTestSuite_create(GBL_TREE_SET_TEST_SUITE_TYPE));
     GblTestScenario_enqueueSuite(pScenario,
                                  GblTestSuite_create(GBL_HASH_SET_TEST_SUITE_TYPE));
+    GblTestScenario_enqueueSuite(pScenario,
+                                 GblTestSuite_create(GBL_CONCURRENT_HASH_SET_TEST_SUITE_TYPE));
     GblTestScenario_enqueueSuite(pScenario,
                                  GblTestSuite_create(GBL_ARRAY_DEQUE_TEST_SUITE_TYPE));
     GblTestScenario_enqueueSuite(pScenario,
                                  GblTestSuite_create(GBL_ARRAY_HEAP_TEST_SUITE_TYPE));
+    GblTestScenario_enqueueSuite(pScenario,
+                                 GblTestSuite_create(GBL_ALLOCATION_TRACKER_TEST_SUITE_TYPE));
     GblTestScenario_enqueueSuite(pScenario,
                                  GblTestSuite_create(GBL_ARENA_ALLOCATOR_TEST_SUITE_TYPE));
     GblTestScenario_enqueueSuite(pScenario,
                                  GblTestSuite_create(GBL_POOL_ALLOCATOR_TEST_SUITE_TYPE));
     GblTestScenario_enqueueSuite(pScenario,
                                  GblTestSuite_create(GBL_SCOPE_ALLOCATOR_TEST_SUITE_TYPE));
+    GblTestScenario_enqueueSuite(pScenario,
+                                 GblTestSuite_create(GBL_SLAB_ALLOCATOR_TEST_SUITE_TYPE));
     GblTestScenario_enqueueSuite(pScenario,
                                  GblTestSuite_create(GBL_REF_TEST_SUITE_TYPE));
     GblTestScenario_enqueueSuite(pScenario,
                                  GblTestSuite_create(GBL_BYTE_ARRAY_TEST_SUITE_TYPE));
+    GblTestScenario_enqueueSuite(pScenario,
+                                 GblTestSuite_create(GBL_BYTE_CHAIN_TEST_SUITE_TYPE));
+    GblTestScenario_enqueueSuite(pScenario,
+                                 GblTestSuite_create(GBL_SETTINGS_TEST_SUITE_TYPE));
     GblTestScenario_enqueueSuite(pScenario,
                                  GblTestSuite_create(GBL_UUID_TEST_SUITE_TYPE));
     GblTestScenario_enqueueSuite(pScenario,
@@ -196,6 +214,8 @@ int main(int argc, const char* pArgv[]) {
                                  GblTestSuite_create(GBL_STRING_BUFFER_TEST_SUITE_TYPE));
     GblTestScenario_enqueueSuite(pScenario,
                                  GblTestSuite_create(GBL_PATTERN_TEST_SUITE_TYPE));
+    GblTestScenario_enqueueSuite(pScenario,
+                                 GblTestSuite_create(GBL_PATTERN_SET_TEST_SUITE_TYPE));
     GblTestScenario_enqueueSuite(pScenario,
                                  GblTestSuite_create(GBL_STRING_LIST_TEST_SUITE_TYPE));
     GblTestScenario_enqueueSuite(pScenario,
@@ -242,6 +262,10 @@ int main(int argc, const char* pArgv[]) {
                                  GblTestSuite_create(GBL_MODULE_TEST_SUITE_TYPE));
     GblTestScenario_enqueueSuite(pScenario,
                                  GblTestSuite_create(GBL_THREAD_TEST_SUITE_TYPE));
+    GblTestScenario_enqueueSuite(pScenario,
+                                 GblTestSuite_create(GBL_MAIN_LOOP_TEST_SUITE_TYPE));
+    GblTestScenario_enqueueSuite(pScenario,
+                                 GblTestSuite_create(GBL_LOGGER_TEST_SUITE_TYPE));
 #ifdef GBL_ENABLE_CPP
     GblTestScenario_enqueueSuite(pScenario,
                                  GblTestSuite_create(GBL_QUARK_TEST_SUITE_CPP_TYPE));
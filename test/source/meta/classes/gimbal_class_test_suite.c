@@ -2,6 +2,13 @@
 #include <gimbal/test/gimbal_test_macros.h>
 #include <gimbal/core/gimbal_ctx.h>
 #include <gimbal/meta/classes/gimbal_class.h>
+#include <gimbal/meta/instances/gimbal_object.h>
+#include <gimbal/meta/ifaces/gimbal_itable_variant.h>
+#include <gimbal/meta/ifaces/gimbal_ievent_receiver.h>
+#include <gimbal/meta/classes/gimbal_enum.h>
+#include <gimbal/utils/gimbal_timer.h>
+
+#define GBL_CLASS_TEST_SUITE_DEEP_DEPTH_    8
 
 #define GBL_CLASS_TEST_SUITE_(inst)     (GBL_PRIVATE(GblClassTestSuite, inst))
 
@@ -9,6 +16,7 @@ typedef struct GblClassTestSuite_ {
     size_t      initialStaticClassRefCount;
     GblClass*   pClassRef;
     GblClass*   pClassRef2;
+    GblType     deepTypes[GBL_CLASS_TEST_SUITE_DEEP_DEPTH_];
 } GblClassTestSuite_;
 
 static GBL_RESULT GblClassTestSuite_init_(GblTestSuite* pSelf, GblContext* pCtx) {
@@ -22,6 +30,10 @@ static GBL_RESULT GblClassTestSuite_init_(GblTestSuite* pSelf, GblContext* pCtx)
 static GBL_RESULT GblClassTestSuite_final_(GblTestSuite* pSelf, GblContext* pCtx) {
     GBL_CTX_BEGIN(pCtx);
     GblClassTestSuite_* pSelf_ = GBL_CLASS_TEST_SUITE_(pSelf);
+    for(int t = GBL_CLASS_TEST_SUITE_DEEP_DEPTH_ - 1; t >= 0; --t) {
+        if(pSelf_->deepTypes[t] != GBL_INVALID_TYPE)
+            GBL_CTX_VERIFY_CALL(GblType_unregister(pSelf_->deepTypes[t]));
+    }
     GBL_TEST_COMPARE(GblType_classRefCount(GBL_STATIC_CLASS_TYPE), pSelf_->initialStaticClassRefCount);
     GBL_CTX_END();
 }
@@ -432,6 +444,112 @@ static GBL_RESULT GblClassTestSuite_destructFloating_(GblTestSuite* pSelf, GblCo
     GBL_CTX_END();
 }
 
+static GBL_RESULT GblClassTestSuite_castCache_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+    GblClassTestSuite_* pSelf_ = GBL_CLASS_TEST_SUITE_(pSelf);
+
+    static const GblTypeInfo info = {
+        .classSize    = sizeof(GblObjectClass),
+        .instanceSize = sizeof(GblObject)
+    };
+
+    // Chain of object types, with the interfaces all implemented at the bottom
+    GblType parent = GBL_OBJECT_TYPE;
+    for(size_t t = 0; t < GBL_CLASS_TEST_SUITE_DEEP_DEPTH_; ++t) {
+        char name[32];
+        snprintf(name, sizeof(name), "DeepObject%zu", t);
+        pSelf_->deepTypes[t] = parent = GblType_register(name, parent, &info, GBL_TYPE_FLAGS_NONE);
+        GBL_CTX_VERIFY_LAST_RECORD();
+    }
+
+    GblClass* pClass = GblClass_refDefault(parent);
+
+    // Repeated queries must agree with the first, uncached ones
+    for(size_t r = 0; r < 2; ++r) {
+        GBL_TEST_VERIFY(GblType_check(parent, GBL_OBJECT_TYPE));
+        GBL_TEST_VERIFY(GblType_check(parent, GBL_IVARIANT_TYPE));
+        GBL_TEST_VERIFY(!GblType_check(GBL_OBJECT_TYPE, parent));
+        GBL_TEST_VERIFY(GblType_derives(parent, GBL_BOX_TYPE));
+        GBL_TEST_VERIFY(!GblType_derives(parent, GBL_IEVENT_RECEIVER_TYPE));
+        GBL_TEST_VERIFY(GblType_maps(parent, GBL_IEVENT_RECEIVER_TYPE));
+        GBL_TEST_VERIFY(!GblType_maps(parent, GBL_BOX_TYPE));
+
+        GBL_TEST_COMPARE(GblClass_cast(pClass, GBL_OBJECT_TYPE), pClass);
+        GblClass* pIVariant = GblClass_cast(pClass, GBL_IVARIANT_TYPE);
+        GBL_TEST_VERIFY(pIVariant);
+        GBL_TEST_COMPARE(GblClass_typeOf(pIVariant), GBL_IVARIANT_TYPE);
+        GBL_TEST_COMPARE(GblClass_cast(pIVariant, parent), pClass);
+        GBL_TEST_COMPARE(GblClass_cast(pIVariant, GBL_IEVENT_RECEIVER_TYPE),
+                         GblClass_cast(pClass, GBL_IEVENT_RECEIVER_TYPE));
+        GBL_TEST_COMPARE(GblClass_as(pClass, GBL_ENUM_TYPE), NULL);
+    }
+
+    GblClass_unrefDefault(pClass);
+
+    // Re-registering the leaf type under another parent must not see stale results
+    GBL_CTX_VERIFY_CALL(GblType_unregister(parent));
+    pSelf_->deepTypes[GBL_CLASS_TEST_SUITE_DEEP_DEPTH_ - 1] = GBL_INVALID_TYPE;
+
+    static const GblTypeInfo boxInfo = {
+        .classSize    = sizeof(GblBoxClass),
+        .instanceSize = sizeof(GblBox)
+    };
+
+    const GblType boxed = GblType_register("DeepObjectBoxed", GBL_BOX_TYPE, &boxInfo, GBL_TYPE_FLAGS_NONE);
+    GBL_CTX_VERIFY_LAST_RECORD();
+    GBL_TEST_VERIFY(!GblType_check(boxed, GBL_OBJECT_TYPE));
+    GBL_TEST_VERIFY(!GblType_maps(boxed, GBL_IEVENT_RECEIVER_TYPE));
+    GBL_TEST_VERIFY(GblType_derives(boxed, GBL_BOX_TYPE));
+    GBL_CTX_VERIFY_CALL(GblType_unregister(boxed));
+
+    pSelf_->deepTypes[GBL_CLASS_TEST_SUITE_DEEP_DEPTH_ - 1] =
+        GblType_register("DeepObjectLeaf",
+                         pSelf_->deepTypes[GBL_CLASS_TEST_SUITE_DEEP_DEPTH_ - 2],
+                         &info,
+                         GBL_TYPE_FLAGS_NONE);
+    GBL_CTX_VERIFY_LAST_RECORD();
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblClassTestSuite_castProfile_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+    GblClassTestSuite_* pSelf_ = GBL_CLASS_TEST_SUITE_(pSelf);
+
+    enum { iterations = 100000 };
+
+    const GblType type   = pSelf_->deepTypes[GBL_CLASS_TEST_SUITE_DEEP_DEPTH_ - 1];
+    GblClass*     pClass = GblClass_refDefault(type);
+    size_t        hits   = 0;
+    GblTimer      timer;
+
+    GblTimer_start(&timer);
+    for(size_t i = 0; i < iterations; ++i) {
+        hits += GblType_check(type, GBL_BOX_TYPE);
+        hits += !!GblClass_cast(pClass, GBL_OBJECT_TYPE);
+    }
+    GblTimer_stop(&timer);
+
+    GBL_TEST_COMPARE(hits, iterations * 2);
+    GBL_CTX_INFO("classes   : %10.0lf check+casts/ms",
+                 iterations / GblTimer_elapsedMs(&timer));
+
+    hits = 0;
+    GblTimer_start(&timer);
+    for(size_t i = 0; i < iterations; ++i) {
+        hits += GblType_check(type, GBL_IVARIANT_TYPE);
+        hits += !!GblClass_cast(pClass, GBL_IEVENT_RECEIVER_TYPE);
+    }
+    GblTimer_stop(&timer);
+
+    GBL_TEST_COMPARE(hits, iterations * 2);
+    GBL_CTX_INFO("interfaces: %10.0lf check+casts/ms",
+                 iterations / GblTimer_elapsedMs(&timer));
+
+    GblClass_unrefDefault(pClass);
+    GBL_CTX_END();
+}
+
 GBL_EXPORT GblType GblClassTestSuite_type(void) {
     static GblType type = GBL_INVALID_TYPE;
 
@@ -468,6 +586,8 @@ GBL_EXPORT GblType GblClassTestSuite_type(void) {
         { "constructFloating",          GblClassTestSuite_constructFloating_        },
         { "destroyFloatingInvalid",     GblClassTestSuite_destroyFloatingInvalid_   },
         { "destructFloating",           GblClassTestSuite_destructFloating_         },
+        { "castCache",                  GblClassTestSuite_castCache_                },
+        { "castProfile",                GblClassTestSuite_castProfile_              },
         { NULL,                         NULL                                        }
     };
 
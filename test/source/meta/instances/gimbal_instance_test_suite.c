@@ -1,9 +1,15 @@
 #include "meta/instances/gimbal_instance_test_suite.h"
 #include <gimbal/test/gimbal_test_macros.h>
 #include <gimbal/meta/instances/gimbal_instance.h>
+#include <gimbal/core/gimbal_thread.h>
+#include <gimbal/utils/gimbal_timer.h>
 
 #define GBL_INSTANCE_TEST_SUITE_(inst)      (GBL_PRIVATE(GblInstanceTestSuite, inst))
 
+#define GBL_INSTANCE_TEST_SUITE_POOL_BATCH_         256
+#define GBL_INSTANCE_TEST_SUITE_POOL_ITERATIONS_    200
+#define GBL_INSTANCE_TEST_SUITE_POOL_THREADS_       4
+
 // instantiate from: 1) non instantiable
 //                   2) type with private data
 // swizzling incompatible class
@@ -15,8 +21,15 @@ typedef struct GblInstanceTestSuite_ {
     size_t          instanceStartInstanceRefCount;
     size_t          instanceStartClassRefCount;
     GblInstance*    pInstance;
+    GblType         pooledType;
+    GblType         unpooledType;
 } GblInstanceTestSuite_;
 
+typedef struct PooledInstance_ {
+    GblInstance base;
+    uint64_t    payload[4];
+} PooledInstance_;
+
 GBL_EXPORT GBL_RESULT GblInstanceTestSuite_init_(GblTestSuite* pSelf, GblContext* pCtx) {
     GBL_CTX_BEGIN(pCtx);
 
@@ -247,10 +260,227 @@ GBL_EXPORT GBL_RESULT GblInstanceTestSuite_floatClassInvalid(GblTestSuite* pSelf
     GBL_CTX_END();
 }
 
+GBL_EXPORT GBL_RESULT GblInstanceTestSuite_poolInvalid(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    GBL_TEST_EXPECT_ERROR();
+
+    GBL_TEST_COMPARE(GblType_register(GblQuark_internStatic("PooledNonInstantiable"),
+                                      GBL_INTERFACE_TYPE,
+                                      &(const GblTypeInfo) {
+                                          .classSize = sizeof(GblInterface)
+                                      },
+                                      GBL_TYPE_FLAG_POOLED),
+                     GBL_INVALID_TYPE);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GblTypePoolStats stats;
+    GBL_TEST_COMPARE(GblType_poolStats(GBL_INSTANCE_TYPE, &stats),
+                     GBL_RESULT_ERROR_INVALID_TYPE);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblInstanceTestSuite_poolCreateDestroy(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+
+    GblInstanceTestSuite_* pSelf_ = GBL_INSTANCE_TEST_SUITE_(pSelf);
+
+    const GblTypeInfo info = {
+        .classSize           = sizeof(GblClass),
+        .instanceSize        = sizeof(PooledInstance_),
+        .instancePrivateSize = sizeof(uint64_t) * 2
+    };
+
+    pSelf_->pooledType = GblType_register(GblQuark_internStatic("PooledInstance"),
+                                          GBL_INSTANCE_TYPE,
+                                          &info,
+                                          GBL_TYPE_FLAG_POOLED);
+    GBL_CTX_VERIFY_LAST_RECORD();
+
+    pSelf_->unpooledType = GblType_register(GblQuark_internStatic("UnpooledInstance"),
+                                            GBL_INSTANCE_TYPE,
+                                            &info,
+                                            GBL_TYPE_FLAGS_NONE);
+    GBL_CTX_VERIFY_LAST_RECORD();
+
+    // Pool is created lazily
+    GblTypePoolStats stats;
+    GBL_TEST_CALL(GblType_poolStats(pSelf_->pooledType, &stats));
+    GBL_TEST_COMPARE(stats.pageCount, 0);
+    GBL_TEST_COMPARE(stats.activeCount, 0);
+
+    GblInstance* pInstances[GBL_INSTANCE_TEST_SUITE_POOL_BATCH_];
+
+    for(size_t i = 0; i < GBL_INSTANCE_TEST_SUITE_POOL_BATCH_; ++i) {
+        pInstances[i] = GblInstance_create(pSelf_->pooledType);
+        GBL_TEST_VERIFY(pInstances[i]);
+        GBL_TEST_COMPARE(GblInstance_typeOf(pInstances[i]), pSelf_->pooledType);
+        GBL_TEST_COMPARE(GblInstance_privateSize(pInstances[i]), sizeof(uint64_t) * 2);
+        // Private data must be zeroed, even when recycled
+        GBL_TEST_COMPARE(*(uint64_t*)GblInstance_private(pInstances[i], pSelf_->pooledType), 0);
+        *(uint64_t*)GblInstance_private(pInstances[i], pSelf_->pooledType) = i + 1;
+    }
+
+    GBL_TEST_COMPARE(GblType_instanceCount(pSelf_->pooledType), GBL_INSTANCE_TEST_SUITE_POOL_BATCH_);
+
+    GBL_TEST_CALL(GblType_poolStats(pSelf_->pooledType, &stats));
+    GBL_TEST_VERIFY(stats.entrySize >= sizeof(PooledInstance_) + sizeof(uint64_t) * 2);
+    GBL_TEST_VERIFY(stats.pageCount >= 1);
+    GBL_TEST_VERIFY(stats.totalBytes >= stats.entrySize * GBL_INSTANCE_TEST_SUITE_POOL_BATCH_);
+    GBL_TEST_VERIFY(stats.activeCount >= GBL_INSTANCE_TEST_SUITE_POOL_BATCH_);
+
+    const size_t pageCount = stats.pageCount;
+
+    // Recycled instances come back out of the same pages
+    for(size_t i = 0; i < GBL_INSTANCE_TEST_SUITE_POOL_BATCH_; ++i)
+        GblInstance_destroy(pInstances[i]);
+
+    GBL_TEST_COMPARE(GblType_instanceCount(pSelf_->pooledType), 0);
+
+    for(size_t i = 0; i < GBL_INSTANCE_TEST_SUITE_POOL_BATCH_; ++i) {
+        pInstances[i] = GblInstance_create(pSelf_->pooledType);
+        GBL_TEST_VERIFY(pInstances[i]);
+        GBL_TEST_COMPARE(*(uint64_t*)GblInstance_private(pInstances[i], pSelf_->pooledType), 0);
+    }
+
+    GBL_TEST_CALL(GblType_poolStats(pSelf_->pooledType, &stats));
+    GBL_TEST_COMPARE(stats.pageCount, pageCount);
+
+    for(size_t i = 0; i < GBL_INSTANCE_TEST_SUITE_POOL_BATCH_; ++i)
+        GblInstance_destroy(pInstances[i]);
+
+    GBL_TEST_CALL(GblType_poolStats(pSelf_->pooledType, &stats));
+    GBL_TEST_COMPARE(stats.activeCount, stats.cachedCount);
+    GBL_TEST_VERIFY(stats.cachedCount <= 32);
+
+    // Pooled types can't be allocated with a custom size
+    GBL_TEST_EXPECT_ERROR();
+    GBL_TEST_COMPARE(GblInstance_create(pSelf_->pooledType, sizeof(PooledInstance_) * 2), NULL);
+    GBL_TEST_COMPARE(GBL_CTX_LAST_RESULT(), GBL_RESULT_ERROR_INVALID_ARG);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblInstanceTestSuite_poolThread_(GblThread* pThread) {
+    GblType*     pType = GblBox_userdata(GBL_BOX(pThread));
+    GblInstance* pInstances[GBL_INSTANCE_TEST_SUITE_POOL_BATCH_];
+
+    for(size_t it = 0; it < GBL_INSTANCE_TEST_SUITE_POOL_ITERATIONS_; ++it) {
+        for(size_t i = 0; i < GBL_INSTANCE_TEST_SUITE_POOL_BATCH_; ++i)
+            pInstances[i] = GblInstance_create(*pType);
+
+        // Interleave destruction order to churn the free lists
+        for(size_t i = 0; i < GBL_INSTANCE_TEST_SUITE_POOL_BATCH_; i += 2)
+            GblInstance_destroy(pInstances[i]);
+        for(size_t i = 1; i < GBL_INSTANCE_TEST_SUITE_POOL_BATCH_; i += 2)
+            GblInstance_destroy(pInstances[i]);
+    }
+
+    return GBL_RESULT_SUCCESS;
+}
+
+GBL_EXPORT GBL_RESULT GblInstanceTestSuite_poolThreaded(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+
+    GblInstanceTestSuite_* pSelf_ = GBL_INSTANCE_TEST_SUITE_(pSelf);
+    GblThread*             pThreads[GBL_INSTANCE_TEST_SUITE_POOL_THREADS_];
+
+    for(size_t t = 0; t < GBL_INSTANCE_TEST_SUITE_POOL_THREADS_; ++t) {
+        pThreads[t] = GblThread_create(GblInstanceTestSuite_poolThread_, &pSelf_->pooledType);
+        GBL_TEST_VERIFY(pThreads[t]);
+    }
+
+    for(size_t t = 0; t < GBL_INSTANCE_TEST_SUITE_POOL_THREADS_; ++t) {
+        GblThread_join(pThreads[t]);
+        GblThread_unref(pThreads[t]);
+    }
+
+    GBL_TEST_COMPARE(GblType_instanceCount(pSelf_->pooledType), 0);
+
+    // Exiting threads flush their caches back to the pool
+    GblTypePoolStats stats;
+    GBL_TEST_CALL(GblType_poolStats(pSelf_->pooledType, &stats));
+    GBL_TEST_COMPARE(stats.activeCount, stats.cachedCount);
+    GBL_TEST_VERIFY(stats.totalBytes >= stats.entrySize * stats.freeCount);
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblInstanceTestSuite_poolRetire(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+
+    GblInstanceTestSuite_* pSelf_ = GBL_INSTANCE_TEST_SUITE_(pSelf);
+    GblTypePoolStats       before, after;
+
+    // Leave freed entries within this thread's cache for the pooled type
+    GblInstance* pCached = GblInstance_create(pSelf_->pooledType);
+    GblInstance_destroy(pCached);
+    GBL_TEST_CALL(GblType_poolStats(pSelf_->pooledType, &before));
+    GBL_TEST_VERIFY(before.cachedCount);
+
+    const GblTypeInfo info = {
+        .classSize    = sizeof(GblClass),
+        .instanceSize = sizeof(PooledInstance_)
+    };
+
+    const GblType retiredType = GblType_register(GblQuark_internStatic("RetiredPooledInstance"),
+                                                 GBL_INSTANCE_TYPE,
+                                                 &info,
+                                                 GBL_TYPE_FLAG_POOLED);
+    GblInstance_destroy(GblInstance_create(retiredType));
+    GBL_TEST_CALL(GblType_unregister(retiredType));
+
+    // Destroying another type's pool leaves this type's cached entries in use
+    GblInstance* pInstance = GblInstance_create(pSelf_->pooledType);
+    GBL_TEST_COMPARE(pInstance, pCached);
+    GblInstance_destroy(pInstance);
+
+    GBL_TEST_CALL(GblType_poolStats(pSelf_->pooledType, &after));
+    GBL_TEST_COMPARE(after.pageCount, before.pageCount);
+    GBL_TEST_COMPARE(after.activeCount, after.cachedCount);
+
+    GBL_CTX_END();
+}
+
+GBL_EXPORT GBL_RESULT GblInstanceTestSuite_poolProfile(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+
+    GblInstanceTestSuite_* pSelf_ = GBL_INSTANCE_TEST_SUITE_(pSelf);
+    const GblType          types[] = { pSelf_->unpooledType, pSelf_->pooledType };
+    GblInstance*           pInstances[GBL_INSTANCE_TEST_SUITE_POOL_BATCH_];
+
+    for(size_t t = 0; t < GBL_COUNT_OF(types); ++t) {
+        GblTimer timer;
+        GblTimer_start(&timer);
+
+        for(size_t it = 0; it < GBL_INSTANCE_TEST_SUITE_POOL_ITERATIONS_; ++it) {
+            for(size_t i = 0; i < GBL_INSTANCE_TEST_SUITE_POOL_BATCH_; ++i)
+                pInstances[i] = GblInstance_create(types[t]);
+            for(size_t i = 0; i < GBL_INSTANCE_TEST_SUITE_POOL_BATCH_; ++i)
+                GblInstance_destroy(pInstances[i]);
+        }
+
+        GblTimer_stop(&timer);
+
+        GBL_CTX_INFO("%-16s: %10.0lf create+destroys/ms",
+                     GblType_name(types[t]),
+                     (GBL_INSTANCE_TEST_SUITE_POOL_ITERATIONS_ * GBL_INSTANCE_TEST_SUITE_POOL_BATCH_) /
+                         GblTimer_elapsedMs(&timer));
+    }
+
+    GBL_CTX_END();
+}
+
 GBL_EXPORT GBL_RESULT GblInstanceTestSuite_final_(GblTestSuite* pSelf, GblContext* pCtx) {
     GBL_CTX_BEGIN(pCtx);
 
     GblInstanceTestSuite_* pSelf_ = GBL_INSTANCE_TEST_SUITE_(pSelf);
+    GBL_TEST_CALL(GblType_unregister(pSelf_->pooledType));
+    GBL_TEST_CALL(GblType_unregister(pSelf_->unpooledType));
     GBL_TEST_COMPARE(GblType_instanceCount(GBL_INSTANCE_TYPE),   pSelf_->instanceStartInstanceRefCount);
     GBL_TEST_COMPARE(GblType_classRefCount(GBL_INSTANCE_TYPE),      pSelf_->instanceStartClassRefCount);
 
@@ -280,6 +510,11 @@ GBL_EXPORT GblType GblInstanceTestSuite_type(void) {
         { "swizzleClassInvalid",        GblInstanceTestSuite_swizzleClassInvalid        },
         { "sinkClassInvalid",           GblInstanceTestSuite_sinkClassInvalid           },
         { "floatClassInvalid",          GblInstanceTestSuite_floatClassInvalid          },
+        { "poolInvalid",                GblInstanceTestSuite_poolInvalid                },
+        { "poolCreateDestroy",          GblInstanceTestSuite_poolCreateDestroy          },
+        { "poolThreaded",               GblInstanceTestSuite_poolThreaded               },
+        { "poolRetire",                 GblInstanceTestSuite_poolRetire                 },
+        { "poolProfile",                GblInstanceTestSuite_poolProfile                },
         { NULL,                         NULL                                            }
     };
 
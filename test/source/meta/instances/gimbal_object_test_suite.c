@@ -5,6 +5,7 @@
 #include <gimbal/meta/types/gimbal_variant.h>
 #include <gimbal/test/gimbal_test_macros.h>
 #include <gimbal/utils/gimbal_ref.h>
+#include <gimbal/utils/gimbal_timer.h>
 #include <math.h>
 
 #define GBL_SELF_TYPE GblObjectTestSuite
@@ -427,6 +428,172 @@ GBL_TEST_CASE(propertySet)
     GBL_TEST_COMPARE(GblBox_unref(GBL_BOX(pObj)), 0);
 GBL_TEST_CASE_END
 
+GBL_TEST_CASE(propertyProfile)
+    enum { iterations = 100000 };
+
+    GblObject* pObj    = GBL_OBJECT(GBL_NEW(TestObject));
+    float      floater = 0.0f;
+    GblTimer   timer;
+
+    GblTimer_start(&timer);
+    for(size_t i = 0; i < iterations; ++i) {
+        GBL_TEST_CALL(GblObject_setProperty(pObj, "floater", (double)i));
+        GBL_TEST_CALL(GblObject_property(pObj, "floater", &floater));
+    }
+    GblTimer_stop(&timer);
+
+    GBL_TEST_COMPARE(floater, (float)(iterations - 1));
+    GBL_CTX_INFO("set+get: %10.0lf properties/ms",
+                 iterations / GblTimer_elapsedMs(&timer));
+
+    // Inherited properties are the deepest lookups
+    const GblQuark names[] = {
+        GblQuark_fromStatic("floater"),
+        GblQuark_fromStatic("name"),
+        GblQuark_fromStatic("userdata")
+    };
+
+    GblTimer_start(&timer);
+    for(size_t i = 0; i < iterations; ++i) {
+        GBL_TEST_VERIFY(GblProperty_findQuark(TEST_OBJECT_TYPE, names[i % GBL_COUNT_OF(names)]));
+    }
+    GblTimer_stop(&timer);
+
+    GBL_CTX_INFO("find:    %10.0lf properties/ms",
+                 iterations / GblTimer_elapsedMs(&timer));
+
+    GBL_TEST_COMPARE(GblBox_unref(GBL_BOX(pObj)), 0);
+GBL_TEST_CASE_END
+
+static GblBool propertyTableCollect_(const GblProperty* pProp, void* pClosure) {
+    const GblProperty** ppProps = pClosure;
+    while(*ppProps) ++ppProps;
+    *ppProps = pProp;
+    return GBL_FALSE;
+}
+
+GBL_TEST_CASE(propertyTable)
+    // Properties are installed by the class, so keep it alive with an instance
+    TestObject* pObj = GBL_NEW(TestObject);
+
+    const size_t objectCount = GblProperty_count(GBL_OBJECT_TYPE);
+    GBL_TEST_COMPARE(GblProperty_count(TEST_OBJECT_TYPE), objectCount + TestObject_Property_Id_count);
+
+    // Inherited properties come first, followed by the type's own in installation order
+    const GblProperty* props[32] = { NULL };
+    GBL_TEST_VERIFY(!GblProperty_foreach(TEST_OBJECT_TYPE, GBL_PROPERTY_FLAG_READ, propertyTableCollect_, props));
+    GBL_TEST_COMPARE(GblProperty_objectType(props[0]), GBL_OBJECT_TYPE);
+    GBL_TEST_COMPARE(GblProperty_objectType(props[objectCount]), TEST_OBJECT_TYPE);
+    GBL_TEST_COMPARE(GblProperty_name(props[objectCount]), "floater");
+
+    GBL_TEST_COMPARE(GblProperty_next(TEST_OBJECT_TYPE, NULL, GBL_PROPERTY_FLAG_WRITE),
+                     props[objectCount]);
+    GBL_TEST_COMPARE(GblProperty_next(TEST_OBJECT_TYPE, props[objectCount], GBL_PROPERTY_FLAG_WRITE),
+                     props[objectCount + 1]);
+    GBL_TEST_COMPARE(GblProperty_next(TEST_OBJECT_TYPE, props[objectCount + 1], GBL_PROPERTY_FLAG_WRITE),
+                     NULL);
+
+    GBL_TEST_COMPARE(GblProperty_find(TEST_OBJECT_TYPE, "name"), GblProperty_find(GBL_OBJECT_TYPE, "name"));
+    GBL_TEST_COMPARE(GblProperty_find(GBL_OBJECT_TYPE, "floater"), NULL);
+
+    // Overriding a property on a derived type shadows the inherited one there only
+    const GblType derivedType = GblType_register(GblQuark_internStatic("TestObjectDerived"),
+                                                 TEST_OBJECT_TYPE,
+                                                 &(const GblTypeInfo) {
+                                                     .classSize    = sizeof(TestObjectClass),
+                                                     .instanceSize = sizeof(TestObject)
+                                                 },
+                                                 GBL_TYPE_FLAGS_NONE);
+    GBL_TEST_VERIFY(derivedType != GBL_INVALID_TYPE);
+
+    const GblProperty* pBase = GblProperty_find(TEST_OBJECT_TYPE, "floater");
+    GBL_TEST_COMPARE(GblProperty_find(derivedType, "floater"), pBase);
+
+    GblProperty* pOverride = GblProperty_create(GBL_PROPERTY_TYPE,
+                                                "floater",
+                                                TestObject_Property_Id_floater,
+                                                GBL_PROPERTY_FLAG_READ |
+                                                GBL_PROPERTY_FLAG_WRITE |
+                                                GBL_PROPERTY_FLAG_OVERRIDE,
+                                                1,
+                                                GBL_FLOAT_TYPE);
+    GBL_TEST_CALL(GblProperty_install(derivedType, pOverride));
+
+    GBL_TEST_COMPARE(GblProperty_find(derivedType, "floater"), pOverride);
+    GBL_TEST_COMPARE(GblProperty_find(TEST_OBJECT_TYPE, "floater"), pBase);
+    GBL_TEST_COMPARE(GblProperty_count(derivedType), GblProperty_count(TEST_OBJECT_TYPE) + 1);
+    GBL_TEST_COMPARE(GblProperty_next(derivedType, NULL, GBL_PROPERTY_FLAG_READ), NULL);
+
+    memset(props, 0, sizeof(props));
+    GblProperty_foreach(derivedType, GBL_PROPERTY_FLAG_READ, propertyTableCollect_, props);
+    GBL_TEST_COMPARE(props[objectCount], pBase);
+    GBL_TEST_COMPARE(props[objectCount + TestObject_Property_Id_count], NULL);
+
+    // Uninstalling invalidates the flattened table
+    GBL_TEST_VERIFY(GblProperty_uninstall(derivedType, "floater"));
+    GBL_TEST_COMPARE(GblProperty_find(derivedType, "floater"), pBase);
+    GBL_TEST_COMPARE(GblProperty_count(derivedType), GblProperty_count(TEST_OBJECT_TYPE));
+
+    GBL_TEST_CALL(GblType_unregister(derivedType));
+    GBL_TEST_COMPARE(GBL_UNREF(pObj), 0);
+GBL_TEST_CASE_END
+
+typedef struct PropertyTableRetireClosure_ {
+    GblType derivedType;
+    size_t  visited;
+} PropertyTableRetireClosure_;
+
+static GblBool propertyTableRetireIter_(const GblProperty* pProp, void* pClosure) {
+    GBL_UNUSED(pProp);
+    PropertyTableRetireClosure_* pRetire = pClosure;
+
+    // Replace the table being iterated over, which must stay alive until the iteration finishes
+    if(!pRetire->visited++) {
+        GblProperty_install(pRetire->derivedType,
+                            GblProperty_create(GBL_PROPERTY_TYPE,
+                                               "retirer",
+                                               TestObject_Property_Id_count,
+                                               GBL_PROPERTY_FLAG_READ,
+                                               1,
+                                               GBL_INT32_TYPE));
+        GblProperty_find(pRetire->derivedType, "retirer");
+    }
+
+    return GBL_FALSE;
+}
+
+GBL_TEST_CASE(propertyTableRetire)
+    TestObject* pObj = GBL_NEW(TestObject);
+
+    PropertyTableRetireClosure_ closure = {
+        .derivedType = GblType_register(GblQuark_internStatic("TestObjectRetired"),
+                                        TEST_OBJECT_TYPE,
+                                        &(const GblTypeInfo) {
+                                            .classSize    = sizeof(TestObjectClass),
+                                            .instanceSize = sizeof(TestObject)
+                                        },
+                                        GBL_TYPE_FLAGS_NONE)
+    };
+    GBL_TEST_VERIFY(closure.derivedType != GBL_INVALID_TYPE);
+
+    const size_t count = GblProperty_count(closure.derivedType);
+
+    GBL_TEST_VERIFY(!GblProperty_foreach(closure.derivedType,
+                                         GBL_PROPERTY_FLAG_READ,
+                                         propertyTableRetireIter_,
+                                         &closure));
+    GBL_TEST_COMPARE(closure.visited, count);
+    GBL_TEST_COMPARE(GblProperty_count(closure.derivedType), count + 1);
+
+    // Installing onto the derived type leaves its base's properties alone
+    GBL_TEST_COMPARE(GblProperty_count(TEST_OBJECT_TYPE), count);
+    GBL_TEST_COMPARE(GblProperty_find(TEST_OBJECT_TYPE, "retirer"), NULL);
+
+    GBL_TEST_VERIFY(GblProperty_uninstallAll(closure.derivedType));
+    GBL_TEST_CALL(GblType_unregister(closure.derivedType));
+    GBL_TEST_COMPARE(GBL_UNREF(pObj), 0);
+GBL_TEST_CASE_END
+
 static void GblObject_onPropertyChange_(TestObject* pSelf, GblProperty* pProp) {
     ++pSelf->propertyChangedCounter;
 
@@ -1435,6 +1602,9 @@ GBL_TEST_REGISTER(newDefault,
                   newInPlaceVariantsWithClass,
                   propertyGet,
                   propertySet,
+                  propertyProfile,
+                  propertyTable,
+                  propertyTableRetire,
                   propertyChange,
                   parenting,
                   classSwizzle,
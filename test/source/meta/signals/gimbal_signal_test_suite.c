@@ -3,6 +3,8 @@
 #include <gimbal/meta/signals/gimbal_signal.h>
 #include <gimbal/meta/signals/gimbal_closure.h>
 #include <gimbal/meta/signals/gimbal_c_closure.h>
+#include <gimbal/meta/signals/gimbal_marshal.h>
+#include <gimbal/utils/gimbal_timer.h>
 
 #define GBL_SIGNAL_TEST_SUITE_(inst)    (GBL_PRIVATE(GblSignalTestSuite, inst))
 
@@ -963,6 +965,198 @@ static GBL_RESULT GblSignalTestSuite_disconnect_(GblTestSuite* pSelf, GblContext
     GBL_CTX_END();
 }
 
+typedef struct DirectEmission_ {
+    size_t          count;
+    GblInstance*    pReceiver;
+    GblInstance*    pEmitter;
+    void*           pUserdata;
+    int32_t         arg;
+    size_t          sizeArg;
+} DirectEmission_;
+
+static void directSlot_(GblInstance* pReceiver, int32_t arg) {
+    DirectEmission_* pEmission = GblClosure_currentUserdata();
+    ++pEmission->count;
+    pEmission->pReceiver = pReceiver;
+    pEmission->pEmitter  = GblSignal_emitter();
+    pEmission->pUserdata = pEmission;
+    pEmission->arg       = arg;
+}
+
+static void directSizeSlot_(GblInstance* pReceiver, GblInstance* pInstance, size_t arg) {
+    DirectEmission_* pEmission = GblClosure_currentUserdata();
+    ++pEmission->count;
+    pEmission->pReceiver = pReceiver;
+    pEmission->pEmitter  = pInstance;
+    pEmission->sizeArg   = arg;
+}
+
+static GBL_RESULT directMarshal_(GblClosure*       pClosure,
+                                 GblVariant*       pRetValue,
+                                 size_t            argCount,
+                                 GblVariant*       pArgs,
+                                 GblPtr            pMarshalData)
+{
+    return GblMarshal_CClosure_VOID__INSTANCE_INT32(pClosure, pRetValue, argCount, pArgs, pMarshalData);
+}
+
+static GBL_RESULT GblSignalTestSuite_emitDirect_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+
+    GblSignalTestSuite_* pSelf_ = GBL_SIGNAL_TEST_SUITE_(pSelf);
+    GblInstance* pEmitter  = GBL_INSTANCE(pSelf_->pInstances[INSTANCE_2_]);
+    GblInstance* pReceiver = GBL_INSTANCE(pSelf_->pInstances[INSTANCE_3_]);
+
+    DirectEmission_ emission  = { 0 };
+    DirectEmission_ emission2 = { 0 };
+
+    GBL_CTX_VERIFY_CALL(GblSignal_install(pSelf_->types[TYPE_C_B_],
+                                          "S_Direct",
+                                          GblMarshal_CClosure_VOID__INSTANCE_INT32,
+                                          1,
+                                          GBL_INT32_TYPE));
+
+    GBL_CTX_VERIFY_CALL(GblSignal_install(pSelf_->types[TYPE_C_B_],
+                                          "S_DirectSize",
+                                          GblMarshal_CClosure_VOID__INSTANCE_INSTANCE_SIZE,
+                                          2,
+                                          GBL_POINTER_TYPE,
+                                          GBL_SIZE_TYPE));
+
+    GBL_CTX_VERIFY_CALL(GblSignal_connect(pEmitter,
+                                          "S_Direct",
+                                          pReceiver,
+                                          GBL_CALLBACK(directSlot_),
+                                          &emission));
+
+    GBL_CTX_VERIFY_CALL(GblSignal_connect(pEmitter,
+                                          "S_DirectSize",
+                                          pReceiver,
+                                          GBL_CALLBACK(directSizeSlot_),
+                                          &emission2));
+
+    GBL_CTX_VERIFY_CALL(GblSignal_emit(pEmitter, "S_Direct", -73));
+    GBL_TEST_COMPARE(emission.count, 1);
+    GBL_TEST_COMPARE(emission.arg, -73);
+    GBL_TEST_COMPARE(emission.pReceiver, pReceiver);
+    GBL_TEST_COMPARE(emission.pEmitter, pEmitter);
+    GBL_TEST_COMPARE(emission.pUserdata, &emission);
+    GBL_TEST_COMPARE(GblSignal_emitter(), NULL);
+    GBL_TEST_COMPARE(GblClosure_current(), NULL);
+
+    GBL_CTX_VERIFY_CALL(GblSignal_emit(pEmitter, "S_DirectSize", pEmitter, (size_t)12345678));
+    GBL_TEST_COMPARE(emission2.count, 1);
+    GBL_TEST_COMPARE(emission2.pReceiver, pReceiver);
+    GBL_TEST_COMPARE(emission2.pEmitter, pEmitter);
+    GBL_TEST_COMPARE(emission2.sizeArg, 12345678);
+
+    // Variant emission must still reach the same C closure through the generic marshal
+    GblVariant arg;
+    GblVariant_constructInt32(&arg, 42);
+    GBL_CTX_VERIFY_CALL(GblSignal_emitVariants(pEmitter, "S_Direct", &arg));
+    GBL_TEST_COMPARE(emission.count, 2);
+    GBL_TEST_COMPARE(emission.arg, 42);
+    GBL_TEST_COMPARE(emission.pReceiver, pReceiver);
+    GblVariant_destruct(&arg);
+
+    const size_t disconnected = GblSignal_disconnect(pEmitter, "S_Direct", pReceiver, NULL);
+    GBL_TEST_COMPARE(disconnected, 1);
+    GBL_CTX_VERIFY_CALL(GblSignal_uninstall(pSelf_->types[TYPE_C_B_], "S_DirectSize"));
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblSignalTestSuite_emitDirectMixed_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+
+    GblSignalTestSuite_* pSelf_ = GBL_SIGNAL_TEST_SUITE_(pSelf);
+    GblInstance* pEmitter  = GBL_INSTANCE(pSelf_->pInstances[INSTANCE_2_]);
+    GblInstance* pReceiver = GBL_INSTANCE(pSelf_->pInstances[INSTANCE_5_]);
+
+    DirectEmission_ fast = { 0 };
+    DirectEmission_ slow = { 0 };
+
+    // A C closure with an overridden marshal cannot take the direct path
+    GblCClosure* pClosure = GblCClosure_create(GBL_CALLBACK(directSlot_), &slow);
+    GblClosure_setMarshal(GBL_CLOSURE(pClosure), directMarshal_);
+
+    GBL_CTX_VERIFY_CALL(GblSignal_connectClosure(pEmitter,
+                                                 "S_Direct",
+                                                 pReceiver,
+                                                 GBL_CLOSURE(pClosure)));
+
+    GBL_CTX_VERIFY_CALL(GblSignal_connect(pEmitter,
+                                          "S_Direct",
+                                          pReceiver,
+                                          GBL_CALLBACK(directSlot_),
+                                          &fast));
+
+    GBL_CTX_VERIFY_CALL(GblSignal_emit(pEmitter, "S_Direct", 1234));
+
+    GBL_TEST_COMPARE(fast.count, 1);
+    GBL_TEST_COMPARE(fast.arg, 1234);
+    GBL_TEST_COMPARE(fast.pReceiver, pReceiver);
+    GBL_TEST_COMPARE(fast.pEmitter, pEmitter);
+
+    GBL_TEST_COMPARE(slow.count, 1);
+    GBL_TEST_COMPARE(slow.arg, 1234);
+    GBL_TEST_COMPARE(slow.pReceiver, pReceiver);
+    GBL_TEST_COMPARE(slow.pEmitter, pEmitter);
+
+    const size_t disconnected = GblSignal_disconnect(pEmitter, "S_Direct", pReceiver, NULL);
+    GBL_TEST_COMPARE(disconnected, 2);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblSignalTestSuite_emitProfile_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+
+    GblSignalTestSuite_* pSelf_ = GBL_SIGNAL_TEST_SUITE_(pSelf);
+    GblInstance* pEmitter  = GBL_INSTANCE(pSelf_->pInstances[INSTANCE_5_]);
+    GblInstance* pReceiver = GBL_INSTANCE(pSelf_->pInstances[INSTANCE_3_]);
+
+    const size_t    connections[] = { 1, 10, 100 };
+    const size_t    emits         = 10000;
+    size_t          connected     = 0;
+    DirectEmission_ emission      = { 0 };
+
+    for(size_t c = 0; c < GBL_COUNT_OF(connections); ++c) {
+        while(connected < connections[c]) {
+            GBL_CTX_VERIFY_CALL(GblSignal_connect(pEmitter,
+                                                  "S_Direct",
+                                                  pReceiver,
+                                                  GBL_CALLBACK(directSlot_),
+                                                  &emission));
+            ++connected;
+        }
+
+        const size_t iterations = emits / connections[c];
+        emission.count = 0;
+
+        GblTimer timer;
+        GblTimer_start(&timer);
+
+        for(size_t e = 0; e < iterations; ++e)
+            GBL_CTX_VERIFY_CALL(GblSignal_emit(pEmitter, "S_Direct", (int32_t)e));
+
+        GblTimer_stop(&timer);
+
+        GBL_TEST_COMPARE(emission.count, iterations * connections[c]);
+        GBL_TEST_COMPARE(emission.arg, (int32_t)(iterations - 1));
+
+        GBL_CTX_INFO("%3zu connections: %10.0lf emits/ms",
+                     connections[c],
+                     (double)iterations / GblTimer_elapsedMs(&timer));
+    }
+
+    const size_t disconnected = GblSignal_disconnect(pEmitter, "S_Direct", NULL, NULL);
+    GBL_TEST_COMPARE(disconnected, connected);
+    GBL_CTX_VERIFY_CALL(GblSignal_uninstall(pSelf_->types[TYPE_C_B_], "S_Direct"));
+
+    GBL_CTX_END();
+}
+
 static GBL_RESULT GblSignalTestSuite_uninstallInvalid_(GblTestSuite* pSelf, GblContext* pCtx) {
     GBL_UNUSED(pSelf);
     GBL_CTX_BEGIN(pCtx);
@@ -1047,6 +1241,9 @@ GBL_EXPORT GblType GblSignalTestSuite_type(void) {
         { "blockAllBeforeConnecting",   GblSignalTestSuite_blockAllBeforeConnecting_},
         { "disconnectInvalid",          GblSignalTestSuite_disconnectInvalid_       },
         { "disconnect",                 GblSignalTestSuite_disconnect_              },
+        { "emitDirect",                 GblSignalTestSuite_emitDirect_              },
+        { "emitDirectMixed",            GblSignalTestSuite_emitDirectMixed_         },
+        { "emitProfile",                GblSignalTestSuite_emitProfile_             },
         { "uninstallInvalid",           GblSignalTestSuite_uninstallInvalid_        },
         { "uninstall",                  GblSignalTestSuite_uninstall_               },
         { NULL,                         NULL                                        }
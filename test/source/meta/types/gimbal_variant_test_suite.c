@@ -3,6 +3,7 @@
 #include <gimbal/core/gimbal_ctx.h>
 #include <gimbal/meta/types/gimbal_variant.h>
 #include <gimbal/utils/gimbal_date_time.h>
+#include <gimbal/utils/gimbal_timer.h>
 #include <string.h>
 
 static GBL_RESULT GblVariantTestSuite_checkTypeCompatible_(GblTestSuite* pSelf, GblContext* pCtx) {
@@ -2494,6 +2495,33 @@ static GBL_RESULT GblVariantTestSuite_as_(GblTestSuite* pSuite, GblContext* pCtx
     GBL_CTX_END();
 }
 
+static GBL_RESULT GblVariantTestSuite_profile_(GblTestSuite* pSuite, GblContext* pCtx) {
+    GBL_UNUSED(pSuite);
+    GBL_CTX_BEGIN(pCtx);
+
+    enum { iterations = 100000 };
+
+    GblVariant v;
+    int32_t    value = 0;
+    GblTimer   timer;
+
+    GBL_CTX_VERIFY_CALL(GblVariant_constructValueCopy(&v, GBL_INT32_TYPE, 0));
+
+    GblTimer_start(&timer);
+    for(int32_t i = 0; i < iterations; ++i) {
+        GBL_CTX_VERIFY_CALL(GblVariant_setValueCopy(&v, GBL_INT32_TYPE, i));
+        GBL_CTX_VERIFY_CALL(GblVariant_valueCopy(&v, &value));
+    }
+    GblTimer_stop(&timer);
+
+    GBL_TEST_COMPARE(value, iterations - 1);
+    GBL_CTX_INFO("set+get: %10.0lf values/ms",
+                 iterations / GblTimer_elapsedMs(&timer));
+
+    GBL_CTX_VERIFY_CALL(GblVariant_destruct(&v));
+    GBL_CTX_END();
+}
+
 GBL_EXPORT GblType GblVariantTestSuite_type(void) {
     static GblType type = GBL_INVALID_TYPE;
 
@@ -2537,6 +2565,7 @@ GBL_EXPORT GblType GblVariantTestSuite_type(void) {
         { "toInvalid",              GblVariantTestSuite_to_invalid_                 },
         { "to",                     GblVariantTestSuite_to_                         },
         { "as",                     GblVariantTestSuite_as_                         },
+        { "profile",                GblVariantTestSuite_profile_                    },
         { NULL,                     NULL                                            }
     };
 
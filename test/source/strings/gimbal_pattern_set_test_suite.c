@@ -0,0 +1,161 @@
+#include "strings/gimbal_pattern_set_test_suite.h"
+#include <gimbal/test/gimbal_test_macros.h>
+#include <gimbal/strings/gimbal_pattern_set.h>
+#include <gimbal/utils/gimbal_ref.h>
+
+#define GBL_SELF_TYPE GblPatternSetTestSuite
+
+enum {
+    GBL_PATTERN_SET_TEST_KEYWORD_,
+    GBL_PATTERN_SET_TEST_HEX_,
+    GBL_PATTERN_SET_TEST_NUMBER_,
+    GBL_PATTERN_SET_TEST_IDENTIFIER_,
+    GBL_PATTERN_SET_TEST_STRING_,
+    GBL_PATTERN_SET_TEST_OPERATOR_,
+    GBL_PATTERN_SET_TEST_COUNT_
+};
+
+GBL_TEST_FIXTURE {
+    size_t               refActiveCount;
+    GblRefCount          totalCount;
+    const GblPatternSet* pTokens;
+};
+
+GBL_TEST_INIT()
+    pFixture->refActiveCount = GblRef_activeCount();
+    pFixture->totalCount     = GblPattern_totalCount();
+GBL_TEST_CASE_END
+
+GBL_TEST_FINAL()
+    GBL_TEST_COMPARE(GblPatternSet_unref(pFixture->pTokens), 0);
+    GBL_TEST_COMPARE(GblPattern_totalCount(), pFixture->totalCount);
+    GBL_TEST_COMPARE(GblRef_activeCount(), pFixture->refActiveCount);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(createInvalid)
+    const char* pRegExp = "abc";
+
+    GBL_TEST_EXPECT_ERROR();
+
+    GBL_TEST_COMPARE(GblPatternSet_create(NULL, 1), NULL);
+    GBL_TEST_COMPARE(GblPatternSet_create(&pRegExp, 0), NULL);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_TEST_COMPARE(GblPattern_totalCount(), pFixture->totalCount);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(create)
+    const char* regExps[GBL_PATTERN_SET_TEST_COUNT_] = {
+        [GBL_PATTERN_SET_TEST_KEYWORD_]    = "if|else|while",
+        [GBL_PATTERN_SET_TEST_HEX_]        = "0x[0-9a-fA-F]{1,8}",
+        [GBL_PATTERN_SET_TEST_NUMBER_]     = "\\d+(\\.\\d+)?",
+        [GBL_PATTERN_SET_TEST_IDENTIFIER_] = "[A-Za-z_]\\w*",
+        [GBL_PATTERN_SET_TEST_STRING_]     = "\"[^\"]*\"",
+        [GBL_PATTERN_SET_TEST_OPERATOR_]   = "[-+*/=<>]=?"
+    };
+
+    pFixture->pTokens = GblPatternSet_create(regExps, GBL_PATTERN_SET_TEST_COUNT_);
+
+    GBL_TEST_VERIFY(pFixture->pTokens);
+    GBL_TEST_VERIFY(GblPatternSet_dfa(pFixture->pTokens));
+    GBL_TEST_COMPARE(GblPatternSet_count(pFixture->pTokens), GBL_PATTERN_SET_TEST_COUNT_);
+    GBL_TEST_COMPARE(GblPatternSet_refCount(pFixture->pTokens), 1);
+    GBL_TEST_COMPARE(GblPattern_totalCount(), pFixture->totalCount + GBL_PATTERN_SET_TEST_COUNT_);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(ref)
+    const GblPatternSet* pRef = GblPatternSet_ref(pFixture->pTokens);
+
+    GBL_TEST_COMPARE(pRef, pFixture->pTokens);
+    GBL_TEST_COMPARE(GblPatternSet_refCount(pRef), 2);
+    GBL_TEST_COMPARE(GblPatternSet_unref(pRef), 1);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(pattern)
+    GBL_TEST_VERIFY(GblPatternSet_pattern(pFixture->pTokens, 0));
+    GBL_TEST_VERIFY(GblPatternSet_pattern(pFixture->pTokens, GBL_PATTERN_SET_TEST_COUNT_ - 1));
+    GBL_TEST_COMPARE(GblPatternSet_pattern(pFixture->pTokens, GBL_PATTERN_SET_TEST_COUNT_), NULL);
+GBL_TEST_CASE_END
+
+// Tries each pattern of the set in order, which the set's DFA must always agree with
+static int matchEach_(const GblPatternSet* pSet, const char* pString) {
+    for(size_t p = 0; p < GblPatternSet_count(pSet); ++p)
+        if(GblPattern_matchExact(GblPatternSet_pattern(pSet, p), pString))
+            return (int)p;
+
+    return -1;
+}
+
+GBL_TEST_CASE(matchExact)
+    const char* strings[] = {
+        "while", "0xBEEF", "42", "3.14", "whiley", "_tmp0", "\"a b\"", "\"\"", "<=", "-"
+    };
+
+    for(size_t s = 0; s < GBL_COUNT_OF(strings); ++s)
+        GBL_TEST_COMPARE(GblPatternSet_matchExact(pFixture->pTokens, strings[s]),
+                         matchEach_(pFixture->pTokens, strings[s]));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(matchExactPriority)
+    // When more than one pattern matches, the earliest one wins
+    const char*          regExps[] = { "else", "while", "if", "while" };
+    const GblPatternSet* pSet      = GblPatternSet_create(regExps, 4);
+
+    GBL_TEST_VERIFY(GblPatternSet_dfa(pSet));
+    GBL_TEST_COMPARE(GblPatternSet_matchExact(pSet, "while"),  1);
+    GBL_TEST_COMPARE(GblPatternSet_matchExact(pSet, "if"),     2);
+    GBL_TEST_COMPARE(GblPatternSet_matchExact(pSet, "whil"),   -1);
+    GBL_TEST_COMPARE(GblPatternSet_matchExact(pSet, "whiley"), -1);
+
+    GBL_TEST_COMPARE(GblPatternSet_unref(pSet), 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(matchExactDfa)
+    // The backend's leftmost match can stop short of an alternative or a repetition
+    // the DFA would accept, so the set must agree with trying each pattern in turn
+    const char*          regExps[] = { "a|ab+", "b*" };
+    const GblPatternSet* pSet      = GblPatternSet_create(regExps, 2);
+    const char*          strings[] = { "a", "ab", "abb", "b", "bb", "aab", "" };
+
+    GBL_TEST_VERIFY(GblPatternSet_dfa(pSet));
+
+    for(size_t s = 0; s < GBL_COUNT_OF(strings); ++s)
+        GBL_TEST_COMPARE(GblPatternSet_matchExact(pSet, strings[s]), matchEach_(pSet, strings[s]));
+
+    GBL_TEST_COMPARE(GblPatternSet_unref(pSet), 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(matchExactNone)
+    GBL_TEST_COMPARE(GblPatternSet_matchExact(pFixture->pTokens, ""),           -1);
+    GBL_TEST_COMPARE(GblPatternSet_matchExact(pFixture->pTokens, "0x"),         -1);
+    GBL_TEST_COMPARE(GblPatternSet_matchExact(pFixture->pTokens, "0x123456789"), -1);
+    GBL_TEST_COMPARE(GblPatternSet_matchExact(pFixture->pTokens, "3."),         -1);
+    GBL_TEST_COMPARE(GblPatternSet_matchExact(pFixture->pTokens, "9lives"),     -1);
+    GBL_TEST_COMPARE(GblPatternSet_matchExact(pFixture->pTokens, "\"a\"b\""),   -1);
+    GBL_TEST_COMPARE(GblPatternSet_matchExact(pFixture->pTokens, "=>="),        -1);
+    GBL_TEST_COMPARE(GblPatternSet_matchExact(pFixture->pTokens, NULL),         -1);
+    GBL_TEST_COMPARE(GblPatternSet_matchExact(NULL, "while"),                   -1);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(matchExactFallback)
+    // Word boundaries can't be represented by the DFA, so each pattern is tried in turn
+    const char*          regExps[] = { "\\bword", "plain" };
+    const GblPatternSet* pSet      = GblPatternSet_create(regExps, 2);
+
+    GBL_TEST_VERIFY(pSet);
+    GBL_TEST_VERIFY(!GblPatternSet_dfa(pSet));
+    GBL_TEST_COMPARE(GblPatternSet_matchExact(pSet, "plain"),   1);
+    GBL_TEST_COMPARE(GblPatternSet_matchExact(pSet, "nothing"), -1);
+
+    GBL_TEST_COMPARE(GblPatternSet_unref(pSet), 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_REGISTER(createInvalid,
+                  create,
+                  ref,
+                  pattern,
+                  matchExact,
+                  matchExactPriority,
+                  matchExactDfa,
+                  matchExactNone,
+                  matchExactFallback)
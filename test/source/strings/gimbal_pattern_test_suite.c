@@ -73,6 +73,69 @@ GBL_TEST_CASE(compare)
                                        pFixture->pPattern));
 GBL_TEST_CASE_END
 
+GBL_TEST_CASE(matchExactRepeated)
+    const GblPattern* pPattern = GblPattern_create("hello");
+
+    // Later matches are decided by the pattern's lazily-built DFA, and must agree
+    for(size_t i = 0; i < 4; ++i) {
+        GBL_TEST_VERIFY(GblPattern_matchExact(pPattern, "hello"));
+        GBL_TEST_VERIFY(!GblPattern_matchExact(pPattern, "hello!"));
+        GBL_TEST_VERIFY(!GblPattern_matchExact(pPattern, "hell"));
+        GBL_TEST_VERIFY(!GblPattern_matchExact(pPattern, ""));
+    }
+
+    GBL_TEST_COMPARE(GblPattern_unref(pPattern), 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(matchExactDfa)
+    // The backend's leftmost match can stop short of an alternative or a repetition the DFA
+    // would accept, so the answer must come out the same before and after the DFA is built
+    const char* strings[] = { "a", "ab", "abb", "b", "aab", "" };
+
+    for(size_t s = 0; s < GBL_COUNT_OF(strings); ++s) {
+        const GblPattern* pPattern = GblPattern_create("a|ab+");
+        const GblBool     before   = GblPattern_matchExact(pPattern, strings[s]);
+
+        for(size_t i = 0; i < 4; ++i)
+            GBL_TEST_COMPARE(GblPattern_matchExact(pPattern, strings[s]), before);
+
+        GBL_TEST_COMPARE(GblPattern_unref(pPattern), 0);
+    }
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(cacheStr)
+    GblPattern_clearCache();
+    GBL_TEST_COMPARE(GblPattern_cacheCount(), 0);
+
+    GBL_TEST_VERIFY(GblPattern_matchExactStr("hello", "hello"));
+    GBL_TEST_COMPARE(GblPattern_cacheCount(), 1);
+
+    // Matching with the same expression reuses its cached pattern
+    for(size_t i = 0; i < 4; ++i) {
+        GBL_TEST_VERIFY(GblPattern_matchStr("ell", "hello"));
+        GBL_TEST_VERIFY(!GblPattern_matchExactStr("hello", "hello world"));
+    }
+
+    GBL_TEST_COMPARE(GblPattern_cacheCount(), 2);
+    GBL_TEST_COMPARE(GblPattern_totalCount(), pFixture->totalCount + 2);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(cacheEviction)
+    char regExps[40][8];
+
+    // Filling the cache past capacity evicts the least recently used patterns
+    for(size_t r = 0; r < 40; ++r) {
+        snprintf(regExps[r], sizeof(regExps[r]), "re%zu", r);
+        GBL_TEST_VERIFY(GblPattern_matchStr(regExps[r], regExps[r]));
+    }
+
+    GBL_TEST_VERIFY(GblPattern_cacheCount() < 40);
+    GBL_TEST_VERIFY(GblPattern_matchStr("re39", "re39"));
+
+    GblPattern_clearCache();
+    GBL_TEST_COMPARE(GblPattern_cacheCount(), 0);
+GBL_TEST_CASE_END
+
 GBL_TEST_CASE(matchInvalid)
     GBL_TEST_EXPECT_ERROR();
 
@@ -417,6 +480,10 @@ GBL_TEST_REGISTER(createInvalid,
                   bytes,
                   compareSelf,
                   compare,
+                  matchExactRepeated,
+                  matchExactDfa,
+                  cacheStr,
+                  cacheEviction,
                   matchInvalid,
                   matchNone,
                   matchDefaultMatchDefaultCount,
@@ -2,6 +2,12 @@
 #include <gimbal/test/gimbal_test_macros.h>
 #include <gimbal/core/gimbal_ctx.h>
 #include <gimbal/strings/gimbal_quark.h>
+#include <gimbal/core/gimbal_thread.h>
+#include <gimbal/utils/gimbal_timer.h>
+
+#define GBL_QUARK_TEST_SUITE_PROFILE_KEYS_          256
+#define GBL_QUARK_TEST_SUITE_PROFILE_ITERATIONS_    100000
+#define GBL_QUARK_TEST_SUITE_PROFILE_THREADS_MAX_   8
 
 #define GBL_QUARK_TEST_SUITE_(inst)     (GBL_PRIVATE(GblQuarkTestSuite, inst))
 
@@ -202,6 +208,71 @@ static GBL_RESULT GblQuarkTestSuite_internStringStatic_(GblTestSuite* pSelf, Gbl
     GBL_CTX_END();
 }
 
+static const char* profileKeys_[GBL_QUARK_TEST_SUITE_PROFILE_KEYS_];
+
+static GBL_RESULT GblQuarkTestSuite_profileThread_(GblThread* pThread) {
+    volatile GblBool* pPassed = GblBox_userdata(GBL_BOX(pThread));
+    GblBool           passed  = GBL_TRUE;
+
+    for(size_t i = 0; i < GBL_QUARK_TEST_SUITE_PROFILE_ITERATIONS_; ++i) {
+        const char* pKey = profileKeys_[i % GBL_QUARK_TEST_SUITE_PROFILE_KEYS_];
+        if(GblQuark_toString(GblQuark_tryString(pKey)) != pKey)
+            passed = GBL_FALSE;
+    }
+
+    *pPassed = passed;
+    return GBL_RESULT_SUCCESS;
+}
+
+static GBL_RESULT GblQuarkTestSuite_tryStringProfile_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    // Keep the thread class alive so it isn't reinitialized per batch
+    GblClass* pThreadClass = GblClass_refDefault(GBL_THREAD_TYPE);
+
+    for(size_t k = 0; k < GBL_QUARK_TEST_SUITE_PROFILE_KEYS_; ++k) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "ProfileKey%zu", k);
+        profileKeys_[k] = GblQuark_internString(buffer);
+        GBL_TEST_VERIFY(profileKeys_[k]);
+    }
+
+    for(size_t threads = 1;
+        threads <= GBL_QUARK_TEST_SUITE_PROFILE_THREADS_MAX_;
+        threads *= 2)
+    {
+        GblThread*       pThreads[GBL_QUARK_TEST_SUITE_PROFILE_THREADS_MAX_];
+        volatile GblBool passed[GBL_QUARK_TEST_SUITE_PROFILE_THREADS_MAX_] = { 0 };
+        GblTimer         timer;
+
+        GblTimer_start(&timer);
+
+        for(size_t t = 0; t < threads; ++t) {
+            pThreads[t] = GblThread_create(GblQuarkTestSuite_profileThread_,
+                                           (void*)&passed[t]);
+            GBL_TEST_VERIFY(pThreads[t]);
+        }
+
+        for(size_t t = 0; t < threads; ++t) {
+            GblThread_join(pThreads[t]);
+            GblThread_unref(pThreads[t]);
+            GBL_TEST_VERIFY(passed[t]);
+        }
+
+        GblTimer_stop(&timer);
+
+        GBL_CTX_INFO("%2zu thread(s): %10.0lf lookups/ms",
+                     threads,
+                     (threads * GBL_QUARK_TEST_SUITE_PROFILE_ITERATIONS_) /
+                         GblTimer_elapsedMs(&timer));
+    }
+
+    GblClass_unrefDefault(pThreadClass);
+
+    GBL_CTX_END();
+}
+
 GBL_EXPORT GblType GblQuarkTestSuite_type(void) {
     static GblType type = GBL_INVALID_TYPE;
 
@@ -216,6 +287,7 @@ GBL_EXPORT GblType GblQuarkTestSuite_type(void) {
         { "internString",       GblQuarkTestSuite_internString_         },
         { "internStringSized",  GblQuarkTestSuite_internStringSized_    },
         { "internStringStatic", GblQuarkTestSuite_internStringStatic_   },
+        { "tryStringProfile",   GblQuarkTestSuite_tryStringProfile_     },
         { NULL,                 NULL                                    }
     };
 
@@ -3,6 +3,9 @@
 #include <gimbal/core/gimbal_ctx.h>
 #include <gimbal/utils/gimbal_byte_array.h>
 #include <gimbal/utils/gimbal_ref.h>
+#include <stdio.h>
+
+#define GBL_BYTE_ARRAY_TEST_SUITE_MAPPED_FILE_  "gimbal_byte_array_test_mapped.bin"
 
 #define GBL_BYTE_ARRAY_TEST_SUITE_(inst)    (GBL_PRIVATE(GblByteArrayTestSuite, inst))
 
@@ -321,6 +324,145 @@ static GBL_RESULT GblByteArrayTestSuite_clear_(GblTestSuite* pSelf, GblContext*
     GBL_CTX_END();
 }
 
+static GBL_RESULT GblByteArrayTestSuite_slice_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+    GblByteArrayTestSuite_* pSelf_ = GBL_BYTE_ARRAY_TEST_SUITE_(pSelf);
+
+    GBL_TEST_EXPECT_ERROR();
+    GBL_TEST_COMPARE(GblByteArray_slice(pSelf_->pByteArray1, 0, 1), NULL);
+    GBL_TEST_COMPARE(GBL_CTX_LAST_RESULT(), GBL_RESULT_ERROR_OUT_OF_RANGE);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GblByteArray* pParent = GblByteArray_create(11, "HelloWorld", pCtx);
+    GBL_TEST_VERIFY(!GblByteArray_shared(pParent));
+
+    GblByteArray* pSlice = GblByteArray_slice(pParent, 5, 6);
+    GBL_CTX_VERIFY_LAST_RECORD();
+    GBL_CTX_VERIFY_CALL(GblByteArray_verify_(pCtx, pSlice, "World", 1));
+    GBL_TEST_COMPARE(GblByteArray_data(pSlice), (uint8_t*)GblByteArray_data(pParent) + 5);
+    GBL_TEST_VERIFY(GblByteArray_shared(pParent));
+    GBL_TEST_VERIFY(GblByteArray_shared(pSlice));
+
+    GblByteArray* pEmpty = GblByteArray_slice(pParent, 11, 0);
+    GBL_CTX_VERIFY_LAST_RECORD();
+    GBL_CTX_VERIFY_CALL(GblByteArray_verify_(pCtx, pEmpty, NULL, 1));
+    GBL_TEST_COMPARE(GblByteArray_unref(pEmpty), 0);
+
+    // Dropping the parent leaves the slice as the only owner of the buffer
+    GBL_TEST_COMPARE(GblByteArray_unref(pParent), 0);
+    GBL_CTX_VERIFY_CALL(GblByteArray_verify_(pCtx, pSlice, "World", 1));
+    GBL_TEST_VERIFY(!GblByteArray_shared(pSlice));
+    GBL_TEST_COMPARE(GblByteArray_unref(pSlice), 0);
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblByteArrayTestSuite_copy_on_write_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+    GblByteArray* pParent = GblByteArray_create(11, "HelloWorld", pCtx);
+    GblByteArray* pSlice  = GblByteArray_slice(pParent, 0, 5);
+    GBL_CTX_VERIFY_LAST_RECORD();
+
+    // Writing to the slice gives it its own copy
+    GBL_CTX_VERIFY_CALL(GblByteArray_append(pSlice, 1, ""));
+    GBL_CTX_VERIFY_CALL(GblByteArray_write(pSlice, 0, 1, "J"));
+    GBL_CTX_VERIFY_CALL(GblByteArray_verify_(pCtx, pSlice, "Jello", 1));
+    GBL_CTX_VERIFY_CALL(GblByteArray_verify_(pCtx, pParent, "HelloWorld", 1));
+    GBL_TEST_VERIFY(!GblByteArray_shared(pSlice));
+    GBL_TEST_VERIFY(!GblByteArray_shared(pParent));
+
+    // The last array holding the buffer takes it back without copying
+    const void* pData = GblByteArray_data(pParent);
+    GBL_CTX_VERIFY_CALL(GblByteArray_write(pParent, 0, 1, "Y"));
+    GBL_TEST_COMPARE(GblByteArray_data(pParent), pData);
+    GBL_CTX_VERIFY_CALL(GblByteArray_verify_(pCtx, pParent, "YelloWorld", 1));
+
+    // Writing to the parent leaves its slices untouched
+    GblByteArray* pSlice2 = GblByteArray_slice(pParent, 5, 6);
+    GBL_CTX_VERIFY_CALL(GblByteArray_erase(pParent, 0, 5));
+    GBL_CTX_VERIFY_CALL(GblByteArray_prepend(pParent, 5, "Hello"));
+    GBL_CTX_VERIFY_CALL(GblByteArray_write(pParent, 5, 1, "w"));
+    GBL_CTX_VERIFY_CALL(GblByteArray_verify_(pCtx, pParent, "Helloworld", 1));
+    GBL_CTX_VERIFY_CALL(GblByteArray_verify_(pCtx, pSlice2, "World", 1));
+
+    GBL_TEST_COMPARE(GblByteArray_unref(pSlice2), 0);
+    GBL_TEST_COMPARE(GblByteArray_unref(pSlice), 0);
+    GBL_TEST_COMPARE(GblByteArray_unref(pParent), 0);
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblByteArrayTestSuite_copy_shared_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+    GblByteArray* pSource = GblByteArray_create(6, "Gimbal", pCtx);
+    GblByteArray* pCopy   = GblByteArray_create(0, NULL, pCtx);
+
+    GBL_CTX_VERIFY_CALL(GblByteArray_copy(pCopy, pSource));
+    GBL_TEST_COMPARE(GblByteArray_data(pCopy), GblByteArray_data(pSource));
+    GBL_TEST_VERIFY(GblByteArray_shared(pCopy));
+
+    GBL_CTX_VERIFY_CALL(GblByteArray_append(pCopy, 1, ""));
+    GBL_TEST_VERIFY(GblByteArray_data(pCopy) != GblByteArray_data(pSource));
+    GBL_CTX_VERIFY_CALL(GblByteArray_verify_(pCtx, pCopy, "Gimbal", 1));
+    GBL_TEST_COMPARE(GblByteArray_size(pSource), 6);
+    GBL_TEST_COMPARE(memcmp(GblByteArray_data(pSource), "Gimbal", 6), 0);
+
+    // Releasing shared data hands out a copy the caller owns
+    GblByteArray* pCopy2 = GblByteArray_create(0, NULL, pCtx);
+    GBL_CTX_VERIFY_CALL(GblByteArray_copy(pCopy2, pCopy));
+
+    size_t size  = 0;
+    void*  pData = NULL;
+    GBL_CTX_VERIFY_CALL(GblByteArray_release(pCopy2, &size, &pData));
+    GBL_TEST_COMPARE(size, 7);
+    GBL_TEST_VERIFY(pData != GblByteArray_data(pCopy));
+    GBL_TEST_COMPARE(strcmp(pData, "Gimbal"), 0);
+    GBL_CTX_FREE(pData);
+
+    GBL_TEST_COMPARE(GblByteArray_unref(pCopy2), 0);
+    GBL_TEST_COMPARE(GblByteArray_unref(pCopy), 0);
+    GBL_TEST_COMPARE(GblByteArray_unref(pSource), 0);
+    GBL_CTX_END();
+}
+
+static GBL_RESULT GblByteArrayTestSuite_from_mapped_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_UNUSED(pSelf);
+    GBL_CTX_BEGIN(pCtx);
+
+    FILE* pFile = fopen(GBL_BYTE_ARRAY_TEST_SUITE_MAPPED_FILE_, "wb");
+    GBL_TEST_VERIFY(pFile);
+    GBL_TEST_COMPARE(fwrite("MappedFile", 1, 11, pFile), 11);
+    fclose(pFile);
+
+    GblByteArray* pMapped = GblByteArray_fromMapped(GBL_BYTE_ARRAY_TEST_SUITE_MAPPED_FILE_, pCtx);
+    GBL_CTX_VERIFY_LAST_RECORD();
+    GBL_CTX_VERIFY_CALL(GblByteArray_verify_(pCtx, pMapped, "MappedFile", 1));
+
+    GblByteArray* pSlice = GblByteArray_slice(pMapped, 6, 5);
+    GBL_CTX_VERIFY_CALL(GblByteArray_verify_(pCtx, pSlice, "File", 1));
+
+    // Writing copies the data out of the mapping, leaving the file untouched
+    GBL_CTX_VERIFY_CALL(GblByteArray_write(pMapped, 0, 1, "Z"));
+    GBL_CTX_VERIFY_CALL(GblByteArray_verify_(pCtx, pMapped, "ZappedFile", 1));
+    GBL_TEST_VERIFY(!GblByteArray_shared(pMapped));
+    GBL_TEST_COMPARE(GblByteArray_unref(pMapped), 0);
+
+    GBL_CTX_VERIFY_CALL(GblByteArray_verify_(pCtx, pSlice, "File", 1));
+    GBL_TEST_COMPARE(GblByteArray_unref(pSlice), 0);
+
+    pMapped = GblByteArray_fromMapped(GBL_BYTE_ARRAY_TEST_SUITE_MAPPED_FILE_, pCtx);
+    GBL_CTX_VERIFY_CALL(GblByteArray_verify_(pCtx, pMapped, "MappedFile", 1));
+    GBL_TEST_COMPARE(GblByteArray_unref(pMapped), 0);
+
+    GBL_TEST_COMPARE(remove(GBL_BYTE_ARRAY_TEST_SUITE_MAPPED_FILE_), 0);
+
+    GBL_TEST_EXPECT_ERROR();
+    GBL_TEST_COMPARE(GblByteArray_fromMapped(GBL_BYTE_ARRAY_TEST_SUITE_MAPPED_FILE_, pCtx), NULL);
+    GBL_TEST_COMPARE(GBL_CTX_LAST_RESULT(), GBL_RESULT_ERROR_FILE_OPEN);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_CTX_END();
+}
 
 GBL_EXPORT GblType GblByteArrayTestSuite_type(void) {
     static GblType type = GBL_INVALID_TYPE;
@@ -344,6 +486,10 @@ GBL_EXPORT GblType GblByteArrayTestSuite_type(void) {
         { "append",             GblByteArrayTestSuite_append_               },
         { "prepend",            GblByteArrayTestSuite_prepend_              },
         { "clear",              GblByteArrayTestSuite_clear_                },
+        { "slice",              GblByteArrayTestSuite_slice_                },
+        { "copyOnWrite",        GblByteArrayTestSuite_copy_on_write_        },
+        { "copyShared",         GblByteArrayTestSuite_copy_shared_          },
+        { "fromMapped",         GblByteArrayTestSuite_from_mapped_          },
         { NULL,                 NULL                                        }
     };
 
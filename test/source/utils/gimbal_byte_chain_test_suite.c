@@ -0,0 +1,160 @@
+#include "utils/gimbal_byte_chain_test_suite.h"
+#include <gimbal/test/gimbal_test_macros.h>
+#include <gimbal/utils/gimbal_byte_chain.h>
+#include <gimbal/utils/gimbal_ref.h>
+
+#if defined(GBL_LINUX) || defined(GBL_ANDROID) || defined(GBL_MACOS) || defined(GBL_UNIX)
+#   define GBL_BYTE_CHAIN_TEST_PIPE_ 1
+#   include <unistd.h>
+#endif
+
+#define GBL_SELF_TYPE GblByteChainTestSuite
+
+// More links than a single gather write is handed at once
+#define GBL_BYTE_CHAIN_TEST_LINKS_  100
+
+GBL_TEST_FIXTURE {
+    size_t        refActiveCount;
+    GblByteArray* pHeader;
+    GblByteArray* pPayload;
+    GblByteChain  chain;
+};
+
+GBL_TEST_INIT()
+    pFixture->refActiveCount = GblRef_activeCount();
+    pFixture->pHeader        = GblByteArray_create(4, "HDR:", pCtx);
+    pFixture->pPayload       = GblByteArray_create(12, "Hello World!", pCtx);
+    GBL_TEST_CALL(GblByteChain_construct(&pFixture->chain, pCtx));
+GBL_TEST_CASE_END
+
+GBL_TEST_FINAL()
+    GBL_TEST_CALL(GblByteChain_destruct(&pFixture->chain));
+    GBL_TEST_COMPARE(GblByteArray_unref(pFixture->pPayload), 0);
+    GBL_TEST_COMPARE(GblByteArray_unref(pFixture->pHeader), 0);
+    GBL_TEST_COMPARE(GblRef_activeCount(), pFixture->refActiveCount);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(construct)
+    GBL_TEST_COMPARE(GblByteChain_context(&pFixture->chain), pCtx);
+    GBL_TEST_VERIFY(GblByteChain_empty(&pFixture->chain));
+    GBL_TEST_COMPARE(GblByteChain_size(&pFixture->chain), 0);
+    GBL_TEST_COMPARE(GblByteChain_count(&pFixture->chain), 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(appendSlice)
+    GBL_TEST_CALL(GblByteChain_appendSlice(&pFixture->chain, pFixture->pPayload, 0, 6));
+    GBL_TEST_CALL(GblByteChain_appendSlice(&pFixture->chain, pFixture->pPayload, 6, 0));
+
+    GBL_TEST_COMPARE(GblByteChain_count(&pFixture->chain), 1);
+    GBL_TEST_COMPARE(GblByteChain_size(&pFixture->chain), 6);
+    GBL_TEST_COMPARE(GblByteChain_link(&pFixture->chain, 0)->pData, pFixture->pPayload->pData);
+    GBL_TEST_COMPARE(GblByteArray_refCount(GblByteChain_link(&pFixture->chain, 0)), 1);
+    GBL_TEST_VERIFY(GblByteArray_shared(pFixture->pPayload));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(prepend)
+    GBL_TEST_CALL(GblByteChain_prepend(&pFixture->chain, pFixture->pHeader));
+
+    GBL_TEST_COMPARE(GblByteChain_count(&pFixture->chain), 2);
+    GBL_TEST_COMPARE(GblByteChain_size(&pFixture->chain), 10);
+    GBL_TEST_COMPARE(GblByteChain_link(&pFixture->chain, 0)->pData, pFixture->pHeader->pData);
+    GBL_TEST_COMPARE(GblByteArray_refCount(pFixture->pHeader), 1);
+    GBL_TEST_VERIFY(GblByteArray_shared(pFixture->pHeader));
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(append)
+    GBL_TEST_CALL(GblByteChain_appendSlice(&pFixture->chain, pFixture->pPayload, 6, 6));
+
+    GBL_TEST_COMPARE(GblByteChain_count(&pFixture->chain), 3);
+    GBL_TEST_COMPARE(GblByteChain_size(&pFixture->chain), 16);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(read)
+    char buffer[17] = { 0 };
+
+    GBL_TEST_CALL(GblByteChain_read(&pFixture->chain, 0, 16, buffer));
+    GBL_TEST_COMPARE(buffer, "HDR:Hello World!");
+
+    memset(buffer, 0, sizeof(buffer));
+    GBL_TEST_CALL(GblByteChain_read(&pFixture->chain, 2, 10, buffer));
+    GBL_TEST_COMPARE(buffer, "R:Hello Wo");
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(readInvalid)
+    char buffer[17];
+
+    GBL_TEST_EXPECT_ERROR();
+    GBL_TEST_COMPARE(GblByteChain_read(&pFixture->chain, 10, 7, buffer),
+                     GBL_RESULT_ERROR_OUT_OF_RANGE);
+    GBL_CTX_CLEAR_LAST_RECORD();
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(flatten)
+    GblByteArray* pFlat = GblByteChain_flatten(&pFixture->chain);
+    GBL_TEST_CALL(GblByteArray_append(pFlat, 1, ""));
+    GBL_TEST_COMPARE(GblByteArray_cString(pFlat), "HDR:Hello World!");
+    GBL_TEST_COMPARE(GblByteArray_unref(pFlat), 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(copyOnWrite)
+    // Links are slices, so writing to their source leaves the chain untouched
+    GBL_TEST_CALL(GblByteArray_write(pFixture->pPayload, 0, 5, "Jello"));
+    GBL_TEST_CALL(GblByteArray_write(pFixture->pHeader, 0, 4, "hdr:"));
+
+    char buffer[17] = { 0 };
+    GBL_TEST_CALL(GblByteChain_read(&pFixture->chain, 0, 16, buffer));
+    GBL_TEST_COMPARE(buffer, "HDR:Hello World!");
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(write)
+#ifdef GBL_BYTE_CHAIN_TEST_PIPE_
+    GblByteChain chain;
+    char         expected[GBL_BYTE_CHAIN_TEST_LINKS_ * 16 + 1] = { 0 };
+    char         buffer[sizeof(expected)]                       = { 0 };
+    int          fds[2];
+    size_t       written = 0;
+
+    GBL_TEST_COMPARE(pipe(fds), 0);
+    GBL_TEST_CALL(GblByteChain_construct(&chain, pCtx));
+
+    for(size_t l = 0; l < GBL_BYTE_CHAIN_TEST_LINKS_; ++l) {
+        GblByteArray* pLink = GblByteChain_link(&pFixture->chain, l % 3);
+        GBL_TEST_CALL(GblByteChain_append(&chain, pLink));
+        strncat(expected, (const char*)pLink->pData, pLink->size);
+    }
+
+    GBL_TEST_CALL(GblByteChain_write(&chain, fds[1], &written));
+    GBL_TEST_COMPARE(written, GblByteChain_size(&chain));
+    GBL_TEST_COMPARE(written, strlen(expected));
+
+    GBL_TEST_COMPARE(read(fds[0], buffer, written), (ssize_t)written);
+    GBL_TEST_COMPARE(buffer, expected);
+
+    GBL_TEST_CALL(GblByteChain_destruct(&chain));
+    close(fds[0]);
+    close(fds[1]);
+#else
+    GBL_TEST_SKIP("Gather writes are unsupported on this platform.");
+#endif
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(clear)
+    GBL_TEST_CALL(GblByteChain_clear(&pFixture->chain));
+
+    GBL_TEST_VERIFY(GblByteChain_empty(&pFixture->chain));
+    GBL_TEST_COMPARE(GblByteChain_count(&pFixture->chain), 0);
+    GBL_TEST_COMPARE(GblByteArray_refCount(pFixture->pHeader), 1);
+    GBL_TEST_VERIFY(!GblByteArray_shared(pFixture->pHeader));
+    GBL_TEST_VERIFY(!GblByteArray_shared(pFixture->pPayload));
+GBL_TEST_CASE_END
+
+GBL_TEST_REGISTER(construct,
+                  appendSlice,
+                  prepend,
+                  append,
+                  read,
+                  readInvalid,
+                  flatten,
+                  copyOnWrite,
+                  write,
+                  clear)
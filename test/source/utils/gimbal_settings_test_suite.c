@@ -0,0 +1,174 @@
+#include "utils/gimbal_settings_test_suite.h"
+#include <gimbal/test/gimbal_test_macros.h>
+#include <gimbal/utils/gimbal_settings.h>
+#include <gimbal/utils/gimbal_ref.h>
+#include <gimbal/meta/types/gimbal_variant.h>
+#include <stdio.h>
+
+#define GBL_SELF_TYPE GblSettingsTestSuite
+
+#define GBL_SETTINGS_TEST_SUITE_FILE_   "gimbal_settings_test.bin"
+
+GBL_TEST_FIXTURE {
+    size_t        refActiveCount;
+    GblSettings*  pSettings;
+};
+
+GBL_TEST_INIT()
+    pFixture->refActiveCount = GblRef_activeCount();
+    pFixture->pSettings      = GblSettings_create();
+GBL_TEST_CASE_END
+
+GBL_TEST_FINAL()
+    GBL_TEST_COMPARE(GblSettings_unref(pFixture->pSettings), 0);
+    remove(GBL_SETTINGS_TEST_SUITE_FILE_);
+    GBL_TEST_COMPARE(GblRef_activeCount(), pFixture->refActiveCount);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(setValues)
+    GblSettings* pSettings = pFixture->pSettings;
+
+    GBL_TEST_CALL(GblSettings_setBool(pSettings, "fullscreen", GBL_TRUE));
+    GBL_TEST_CALL(GblSettings_setInt64(pSettings, "seed", -1234567890123ll));
+    GBL_TEST_CALL(GblSettings_setDouble(pSettings, "gamma", 2.2));
+    GBL_TEST_CALL(GblSettings_setType(pSettings, "type", GBL_STRING_TYPE));
+
+    GblSettings_pushScope(pSettings, "audio");
+    GBL_TEST_CALL(GblSettings_setUint32(pSettings, "volume", 80));
+    GBL_TEST_CALL(GblSettings_setString(pSettings, "device", "default"));
+    GblSettings_pop(pSettings);
+
+    GBL_TEST_VERIFY(pSettings->dirty);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(toValues)
+    GblSettings* pSettings = pFixture->pSettings;
+
+    GBL_TEST_COMPARE(GblSettings_toBool(pSettings, "fullscreen", GBL_FALSE), GBL_TRUE);
+    GBL_TEST_COMPARE(GblSettings_toInt64(pSettings, "seed", 0), -1234567890123ll);
+    GBL_TEST_COMPARE(GblSettings_toDouble(pSettings, "gamma", 0.0), 2.2);
+    GBL_TEST_COMPARE(GblSettings_toType(pSettings, "type", GBL_INVALID_TYPE), GBL_STRING_TYPE);
+    GBL_TEST_COMPARE(GblSettings_toUint32(pSettings, "/audio/volume", 0), 80);
+    GBL_TEST_COMPARE(GblSettings_toString(pSettings, "/audio/device", NULL), "default");
+    GBL_TEST_COMPARE(GblSettings_toString(pSettings, "gamma", "none"), "none");
+    GBL_TEST_COMPARE(GblSettings_toInt32(pSettings, "missing", 7), 7);
+    GBL_TEST_VERIFY(GblSettings_isNil(pSettings, "missing"));
+
+    uint32_t volume = 0;
+    GblSettings_pushScope(pSettings, "audio");
+    GBL_TEST_CALL(GblSettings_toValue(pSettings, "volume", GBL_UINT32_TYPE, &volume));
+    GBL_TEST_COMPARE(GblSettings_typeOf(pSettings, "device"), GBL_STRING_TYPE);
+    GblSettings_pop(pSettings);
+    GBL_TEST_COMPARE(volume, 80);
+    GBL_TEST_COMPARE(GblSettings_scope(pSettings), "");
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(compile)
+    GblByteArray* pImage = GblByteArray_create(0);
+
+    GBL_TEST_CALL(GblSettings_compile(pFixture->pSettings, pImage));
+    GBL_TEST_VERIFY(pImage->size > 0);
+    GBL_TEST_COMPARE(memcmp(pImage->pData, "GBLS", 4), 0);
+
+    GBL_TEST_COMPARE(GblByteArray_unref(pImage), 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(saveInvalid)
+    GBL_TEST_EXPECT_ERROR();
+
+    GBL_TEST_COMPARE(GblSettings_save(pFixture->pSettings), GBL_RESULT_ERROR_INVALID_OPERATION);
+    GBL_CTX_CLEAR_LAST_RECORD();
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(save)
+    GblSettings* pSettings = pFixture->pSettings;
+
+    pSettings->pPath = GblStringRef_create(GBL_SETTINGS_TEST_SUITE_FILE_);
+
+    GBL_TEST_CALL(GblSettings_save(pSettings));
+    GBL_TEST_VERIFY(!pSettings->dirty);
+    GBL_TEST_COMPARE(pSettings->status, GBL_SETTINGS_STATUS_OK);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(load)
+    GblSettings* pSettings = GblSettings_create();
+    pSettings->pPath = GblStringRef_create(GBL_SETTINGS_TEST_SUITE_FILE_);
+
+    GBL_TEST_CALL(GblSettings_load(pSettings));
+    GBL_TEST_COMPARE(pSettings->status, GBL_SETTINGS_STATUS_OK);
+    GBL_TEST_VERIFY(!pSettings->dirty);
+
+    // Every value is read straight out of the mapped image
+    GBL_TEST_COMPARE(GblSettings_toBool(pSettings, "fullscreen", GBL_FALSE), GBL_TRUE);
+    GBL_TEST_COMPARE(GblSettings_toInt64(pSettings, "seed", 0), -1234567890123ll);
+    GBL_TEST_COMPARE(GblSettings_toDouble(pSettings, "gamma", 0.0), 2.2);
+    GBL_TEST_COMPARE(GblSettings_toType(pSettings, "type", GBL_INVALID_TYPE), GBL_STRING_TYPE);
+    GBL_TEST_COMPARE(GblSettings_toString(pSettings, "/audio/device", NULL), "default");
+
+    // Strings point into the image rather than being copied out of it
+    GBL_TEST_VERIFY(GblSettings_toString(pSettings, "/audio/device", NULL) ==
+                    GblSettings_toString(pSettings, "/audio/device", NULL));
+
+    GblSettings_pushScope(pSettings, "audio");
+    GBL_TEST_COMPARE(GblSettings_toUint32(pSettings, "volume", 0), 80);
+    GBL_TEST_COMPARE(GblSettings_toUint32(pSettings, "device/volume", 0), 0);
+    GblSettings_pop(pSettings);
+
+    GBL_TEST_COMPARE(GblSettings_unref(pSettings), 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(overlay)
+    GblSettings* pSettings = GblSettings_create();
+    pSettings->pPath = GblStringRef_create(GBL_SETTINGS_TEST_SUITE_FILE_);
+
+    GBL_TEST_CALL(GblSettings_load(pSettings));
+
+    // Writing what the image already holds changes nothing
+    GBL_TEST_CALL(GblSettings_setDouble(pSettings, "gamma", 2.2));
+    GBL_TEST_VERIFY(!pSettings->dirty);
+
+    GBL_TEST_CALL(GblSettings_setUint32(pSettings, "/audio/volume", 50));
+    GBL_TEST_CALL(GblSettings_setNil(pSettings, "seed"));
+    GBL_TEST_CALL(GblSettings_setChar(pSettings, "grade", 'A'));
+    GBL_TEST_VERIFY(pSettings->dirty);
+
+    GBL_TEST_COMPARE(GblSettings_toUint32(pSettings, "/audio/volume", 0), 50);
+    GBL_TEST_VERIFY(GblSettings_isNil(pSettings, "seed"));
+    GBL_TEST_COMPARE(GblSettings_toChar(pSettings, "grade", '\0'), 'A');
+
+    // Saves the overlay and remaps the recompiled image
+    GBL_TEST_CALL(GblSettings_sync(pSettings));
+    GBL_TEST_VERIFY(!pSettings->dirty);
+
+    GBL_TEST_COMPARE(GblSettings_toUint32(pSettings, "/audio/volume", 0), 50);
+    GBL_TEST_VERIFY(GblSettings_isNil(pSettings, "seed"));
+    GBL_TEST_COMPARE(GblSettings_toChar(pSettings, "grade", '\0'), 'A');
+    GBL_TEST_COMPARE(GblSettings_toString(pSettings, "/audio/device", NULL), "default");
+
+    GBL_TEST_COMPARE(GblSettings_unref(pSettings), 0);
+GBL_TEST_CASE_END
+
+GBL_TEST_CASE(loadInvalid)
+    GBL_TEST_EXPECT_ERROR();
+
+    FILE* pFile = fopen(GBL_SETTINGS_TEST_SUITE_FILE_, "wb");
+    GBL_TEST_VERIFY(pFile);
+    GBL_TEST_COMPARE(fwrite("NOT A SETTINGS IMAGE", 1, 20, pFile), 20);
+    GBL_TEST_COMPARE(fclose(pFile), 0);
+
+    GBL_TEST_COMPARE(GblSettings_load(pFixture->pSettings), GBL_RESULT_ERROR_FILE_READ);
+    GBL_TEST_COMPARE(pFixture->pSettings->status, GBL_SETTINGS_STATUS_ERROR_FORMAT);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    // The previous values are kept
+    GBL_TEST_COMPARE(GblSettings_toUint32(pFixture->pSettings, "/audio/volume", 0), 80);
+GBL_TEST_CASE_END
+
+GBL_TEST_REGISTER(setValues,
+                  toValues,
+                  compile,
+                  saveInvalid,
+                  save,
+                  load,
+                  overlay,
+                  loadInvalid)